@@ -0,0 +1,231 @@
+//============================================================================
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//============================================================================
+
+// Benchmarks of sort-last image compositing. Compositing is a collective operation, so this is
+// meant to be launched on several ranks, e.g. `mpiexec -n 4 BenchmarkCompositing`. Every rank
+// runs the same fixed number of iterations, and only rank 0 reports.
+
+#include "Benchmarker.h"
+
+#include <vtkm/cont/EnvironmentTracker.h>
+#include <vtkm/cont/Initialize.h>
+#include <vtkm/cont/Timer.h>
+
+#include <vtkm/rendering/Canvas.h>
+#include <vtkm/rendering/compositing/Compositor.h>
+
+#include <vtkm/thirdparty/diy/diy.h>
+#include <vtkm/thirdparty/diy/environment.h>
+
+#include <iostream>
+#include <vector>
+
+namespace
+{
+
+// Hold configuration state (e.g. active device)
+vtkm::cont::InitializeResult Config;
+
+const vtkm::Id Width = 1920;
+const vtkm::Id Height = 1080;
+const vtkm::Id NumberOfIterations = 10;
+
+// The disc rank `rank` renders: the ranks' discs are spread along the diagonal of the frame and
+// overlap their neighbors, like the projections of the blocks of a decomposed data set.
+struct Disc
+{
+  vtkm::Float32 CenterX;
+  vtkm::Float32 CenterY;
+  vtkm::Float32 Radius;
+
+  explicit Disc(int rank)
+  {
+    const int numberOfRanks = vtkm::cont::EnvironmentTracker::GetCommunicator().size();
+    const vtkm::Float32 t = (static_cast<vtkm::Float32>(rank) + 0.5f) / numberOfRanks;
+    this->CenterX = t * Width;
+    this->CenterY = t * Height;
+    this->Radius = 0.6f * Height / vtkm::Sqrt(static_cast<vtkm::Float32>(numberOfRanks));
+  }
+
+  // Depth of the sphere with this disc as outline, or a negative value outside the disc.
+  vtkm::Float32 Depth(vtkm::Id x, vtkm::Id y) const
+  {
+    const vtkm::Float32 dx = (static_cast<vtkm::Float32>(x) - this->CenterX) / this->Radius;
+    const vtkm::Float32 dy = (static_cast<vtkm::Float32>(y) - this->CenterY) / this->Radius;
+    const vtkm::Float32 r2 = dx * dx + dy * dy;
+    return r2 < 1.f ? 0.5f - 0.25f * vtkm::Sqrt(1.f - r2) : -1.f;
+  }
+};
+
+vtkm::Vec4f_32 DiscColor(int rank, vtkm::Float32 alpha)
+{
+  const vtkm::Float32 value = static_cast<vtkm::Float32>(rank % 8) / 8.f;
+  return vtkm::Vec4f_32(value * alpha, (1.f - value) * alpha, 0.5f * alpha, alpha);
+}
+
+vtkm::rendering::Canvas RenderDisc(vtkm::Float32 alpha)
+{
+  const int rank = vtkm::cont::EnvironmentTracker::GetCommunicator().rank();
+  const Disc disc(rank);
+  vtkm::rendering::Canvas canvas(Width, Height);
+  canvas.Clear();
+  auto colorPortal = canvas.GetColorBuffer().WritePortal();
+  auto depthPortal = canvas.GetDepthBuffer().WritePortal();
+  for (vtkm::Id y = 0; y < Height; ++y)
+  {
+    for (vtkm::Id x = 0; x < Width; ++x)
+    {
+      const vtkm::Float32 depth = disc.Depth(x, y);
+      if (depth >= 0.f)
+      {
+        colorPortal.Set(y * Width + x, DiscColor(rank, alpha));
+        depthPortal.Set(y * Width + x, depth);
+      }
+    }
+  }
+  return canvas;
+}
+
+void BenchZBuffer(::benchmark::State& state)
+{
+  const vtkm::IdComponent radix = static_cast<vtkm::IdComponent>(state.range(0));
+  const vtkm::rendering::Canvas canvas = RenderDisc(1.f);
+
+  vtkm::rendering::compositing::Compositor compositor;
+  compositor.SetRadix(radix);
+
+  vtkm::cont::Timer timer{ Config.Device };
+  for (auto _ : state)
+  {
+    (void)_;
+    timer.Start();
+    compositor.AddImage(canvas);
+    vtkm::rendering::compositing::Image result = compositor.Composite();
+    timer.Stop();
+
+    state.SetIterationTime(timer.GetElapsedTime());
+  }
+}
+
+VTKM_BENCHMARK_OPTS(BenchZBuffer,
+                      ->ArgName("Radix")
+                      ->Arg(2)
+                      ->Arg(4)
+                      ->Arg(8)
+                      ->Iterations(NumberOfIterations));
+
+void BenchVisibilityOrder(::benchmark::State& state)
+{
+  const int rank = vtkm::cont::EnvironmentTracker::GetCommunicator().rank();
+  const vtkm::rendering::Canvas canvas = RenderDisc(0.5f);
+
+  using Compositor = vtkm::rendering::compositing::Compositor;
+  Compositor compositor;
+  compositor.SetCompositeMode(Compositor::CompositeMode::VisibilityOrder);
+
+  vtkm::cont::Timer timer{ Config.Device };
+  for (auto _ : state)
+  {
+    (void)_;
+    timer.Start();
+    compositor.AddImage(canvas, rank);
+    vtkm::rendering::compositing::Image result = compositor.Composite();
+    timer.Stop();
+
+    state.SetIterationTime(timer.GetElapsedTime());
+  }
+}
+
+VTKM_BENCHMARK_OPTS(BenchVisibilityOrder, ->Iterations(NumberOfIterations));
+
+void BenchPartialComposite(::benchmark::State& state)
+{
+  const int rank = vtkm::cont::EnvironmentTracker::GetCommunicator().rank();
+  const Disc disc(rank);
+
+  // One partial composite per pixel covered by the disc, as traced through a block of a volume.
+  std::vector<vtkm::Id> pixelIds;
+  std::vector<vtkm::Float32> distances;
+  std::vector<vtkm::Float32> colors;
+  const vtkm::Vec4f_32 color = DiscColor(rank, 0.3f);
+  for (vtkm::Id y = 0; y < Height; ++y)
+  {
+    for (vtkm::Id x = 0; x < Width; ++x)
+    {
+      const vtkm::Float32 depth = disc.Depth(x, y);
+      if (depth >= 0.f)
+      {
+        pixelIds.push_back(y * Width + x);
+        distances.push_back(depth + static_cast<vtkm::Float32>(rank));
+        colors.insert(colors.end(), { color[0], color[1], color[2], color[3] });
+      }
+    }
+  }
+  vtkm::rendering::raytracing::PartialComposite<vtkm::Float32> partial;
+  partial.PixelIds = vtkm::cont::make_ArrayHandle(pixelIds, vtkm::CopyFlag::On);
+  partial.Distances = vtkm::cont::make_ArrayHandle(distances, vtkm::CopyFlag::On);
+  partial.Buffer = vtkm::rendering::raytracing::ChannelBuffer<vtkm::Float32>(
+    4, partial.PixelIds.GetNumberOfValues());
+  partial.Buffer.Buffer = vtkm::cont::make_ArrayHandle(colors, vtkm::CopyFlag::On);
+  const std::vector<vtkm::rendering::raytracing::PartialComposite<vtkm::Float32>> partials{
+    partial
+  };
+
+  vtkm::rendering::compositing::PartialCompositor compositor;
+  vtkm::cont::Timer timer{ Config.Device };
+  for (auto _ : state)
+  {
+    (void)_;
+    timer.Start();
+    auto result = compositor.Composite(partials, Width * Height);
+    timer.Stop();
+
+    state.SetIterationTime(timer.GetElapsedTime());
+  }
+}
+
+VTKM_BENCHMARK_OPTS(BenchPartialComposite, ->Iterations(NumberOfIterations));
+
+} // end anon namespace
+
+int main(int argc, char* argv[])
+{
+  vtkmdiy::mpi::environment env(argc, argv);
+  vtkmdiy::mpi::communicator comm;
+  vtkm::cont::EnvironmentTracker::SetCommunicator(comm);
+
+  auto opts = vtkm::cont::InitializeOptions::RequireDevice;
+
+  std::vector<char*> args(argv, argv + argc);
+  vtkm::bench::detail::InitializeArgs(&argc, args, opts);
+
+  // Parse VTK-m options:
+  Config = vtkm::cont::Initialize(argc, args.data(), opts);
+
+  // This occurs when it is help
+  if (opts == vtkm::cont::InitializeOptions::None)
+  {
+    std::cout << Config.Usage << std::endl;
+  }
+  else
+  {
+    vtkm::cont::GetRuntimeDeviceTracker().ForceDevice(Config.Device);
+  }
+
+  // Only rank 0 reports.
+  if (comm.rank() != 0)
+  {
+    std::cout.rdbuf(nullptr);
+    std::cerr.rdbuf(nullptr);
+  }
+
+  // handle benchmarking related args and run benchmarks:
+  VTKM_EXECUTE_BENCHMARKS(argc, args.data());
+}
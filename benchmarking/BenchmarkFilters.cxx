@@ -15,7 +15,9 @@
 #include <vtkm/VecTraits.h>
 #include <vtkm/VectorAnalysis.h>
 
+#include <vtkm/cont/ArrayCopy.h>
 #include <vtkm/cont/ArrayHandle.h>
+#include <vtkm/cont/ArrayHandleCartesianProduct.h>
 #include <vtkm/cont/ArrayHandleUniformPointCoordinates.h>
 #include <vtkm/cont/CellSetExplicit.h>
 #include <vtkm/cont/CellSetSingleType.h>
@@ -30,6 +32,8 @@
 
 #include <vtkm/filter/FieldSelection.h>
 #include <vtkm/filter/PolicyBase.h>
+#include <vtkm/filter/clean_grid/CleanGrid.h>
+#include <vtkm/filter/contour/ClipWithField.h>
 #include <vtkm/filter/contour/Contour.h>
 #include <vtkm/filter/entity_extraction/ExternalFaces.h>
 #include <vtkm/filter/entity_extraction/Threshold.h>
@@ -87,6 +91,10 @@ vtkm::cont::InitializeResult Config;
 // The input dataset we'll use on the filters:
 vtkm::cont::DataSet* InputDataSet;
 vtkm::cont::DataSet* UnstructuredInputDataSet;
+// Copies of a uniform 3D InputDataSet with rectilinear and explicit point coordinates. These
+// are null for other inputs.
+vtkm::cont::DataSet* RectilinearInputDataSet = nullptr;
+vtkm::cont::DataSet* CurvilinearInputDataSet = nullptr;
 vtkm::cont::DataSet& GetInputDataSet()
 {
   return *InputDataSet;
@@ -194,6 +202,7 @@ VTKM_PRIVATE_GRADIENT_BENCHMARK(All,
 void BenchThreshold(::benchmark::State& state)
 {
   const vtkm::cont::DeviceAdapterId device = Config.Device;
+  const bool lazyPermutation = static_cast<bool>(state.range(0));
 
   // Lookup the point scalar range
   const auto range = []() -> vtkm::Range {
@@ -210,6 +219,7 @@ void BenchThreshold(::benchmark::State& state)
   filter.SetActiveField(PointScalarsName, vtkm::cont::Field::Association::Points);
   filter.SetLowerThreshold(mid - quarter);
   filter.SetUpperThreshold(mid + quarter);
+  filter.SetLazyPermutation(lazyPermutation);
 
   vtkm::cont::Timer timer{ device };
   for (auto _ : state)
@@ -223,7 +233,7 @@ void BenchThreshold(::benchmark::State& state)
     state.SetIterationTime(timer.GetElapsedTime());
   }
 }
-VTKM_BENCHMARK(BenchThreshold);
+VTKM_BENCHMARK_OPTS(BenchThreshold, ->ArgName("LazyPerm")->DenseRange(0, 1));
 
 void BenchThresholdPoints(::benchmark::State& state)
 {
@@ -348,13 +358,22 @@ void BenchWarpVector(::benchmark::State& state)
 }
 VTKM_BENCHMARK(BenchWarpVector);
 
+enum ContourInputType : int
+{
+  ContourUnstructured = 0,
+  ContourUniform = 1,
+  ContourRectilinear = 2,
+  ContourCurvilinear = 3
+};
+
 void BenchContour(::benchmark::State& state)
 {
   const vtkm::cont::DeviceAdapterId device = Config.Device;
 
-  const bool isStructured = static_cast<vtkm::Id>(state.range(0));
+  const auto inputType = static_cast<ContourInputType>(state.range(0));
   const vtkm::Id numIsoVals = static_cast<vtkm::Id>(state.range(1));
-  const bool mergePoints = static_cast<bool>(state.range(2));
+  // 0: no merging, 1: merge by sorting the edges, 2: merge with a hash table
+  const vtkm::Id mergePoints = static_cast<vtkm::Id>(state.range(2));
   const bool normals = static_cast<bool>(state.range(3));
   const bool fastNormals = static_cast<bool>(state.range(4));
 
@@ -377,14 +396,37 @@ void BenchContour(::benchmark::State& state)
     filter.SetIsoValue(i, minIsoVal + (step * static_cast<vtkm::Float64>(i)));
   }
 
-  filter.SetMergeDuplicatePoints(mergePoints);
+  filter.SetMergeDuplicatePoints(mergePoints != 0);
+  filter.SetMergeDuplicatePointsWithHashTable(mergePoints == 2);
   filter.SetGenerateNormals(normals);
   filter.SetComputeFastNormalsForStructured(fastNormals);
   filter.SetComputeFastNormalsForUnstructured(fastNormals);
 
   vtkm::cont::Timer timer{ device };
 
-  vtkm::cont::DataSet input = isStructured ? GetInputDataSet() : GetUnstructuredInputDataSet();
+  vtkm::cont::DataSet input;
+  switch (inputType)
+  {
+    case ContourUnstructured:
+      input = GetUnstructuredInputDataSet();
+      break;
+    case ContourUniform:
+      input = GetInputDataSet();
+      break;
+    case ContourRectilinear:
+    case ContourCurvilinear:
+    {
+      const vtkm::cont::DataSet* copy =
+        inputType == ContourRectilinear ? RectilinearInputDataSet : CurvilinearInputDataSet;
+      if (copy == nullptr)
+      {
+        state.SkipWithError("Rectilinear and curvilinear inputs require a uniform 3D dataset.");
+        return;
+      }
+      input = *copy;
+      break;
+    }
+  }
 
   for (auto _ : state)
   {
@@ -400,17 +442,18 @@ void BenchContour(::benchmark::State& state)
 
 void BenchContourGenerator(::benchmark::internal::Benchmark* bm)
 {
-  bm->ArgNames({ "IsStructuredDataSet", "NIsoVals", "MergePts", "GenNormals", "FastNormals" });
+  bm->ArgNames({ "InputType", "NIsoVals", "MergePts", "GenNormals", "FastNormals" });
 
   auto helper = [&](const vtkm::Id numIsoVals) {
-    bm->Args({ 0, numIsoVals, 0, 0, 0 });
-    bm->Args({ 0, numIsoVals, 1, 0, 0 });
-    bm->Args({ 0, numIsoVals, 0, 1, 0 });
-    bm->Args({ 0, numIsoVals, 0, 1, 1 });
-    bm->Args({ 1, numIsoVals, 0, 0, 0 });
-    bm->Args({ 1, numIsoVals, 1, 0, 0 });
-    bm->Args({ 1, numIsoVals, 0, 1, 0 });
-    bm->Args({ 1, numIsoVals, 0, 1, 1 });
+    for (vtkm::Id inputType = ContourUnstructured; inputType <= ContourCurvilinear; ++inputType)
+    {
+      bm->Args({ inputType, numIsoVals, 0, 0, 0 });
+      bm->Args({ inputType, numIsoVals, 1, 0, 0 });
+      bm->Args({ inputType, numIsoVals, 0, 1, 0 });
+      bm->Args({ inputType, numIsoVals, 0, 1, 1 });
+    }
+    // Only marching cells merges points, flying edges generates them merged.
+    bm->Args({ ContourUnstructured, numIsoVals, 2, 0, 0 });
   };
 
   helper(1);
@@ -421,6 +464,36 @@ void BenchContourGenerator(::benchmark::internal::Benchmark* bm)
 // :TODO: Disabled until SIGSEGV in Countour when passings field is resolved
 VTKM_BENCHMARK_APPLY(BenchContour, BenchContourGenerator);
 
+void BenchClipWithField(::benchmark::State& state)
+{
+  const vtkm::cont::DeviceAdapterId device = Config.Device;
+  const bool hashMerge = static_cast<bool>(state.range(0));
+
+  const vtkm::Range range = []() -> vtkm::Range {
+    auto ptScalarField =
+      GetInputDataSet().GetField(PointScalarsName, vtkm::cont::Field::Association::Points);
+    return ptScalarField.GetRange().ReadPortal().Get(0);
+  }();
+
+  vtkm::filter::contour::ClipWithField filter;
+  filter.SetActiveField(PointScalarsName, vtkm::cont::Field::Association::Points);
+  filter.SetClipValue(range.Center());
+  filter.SetMergeDuplicatePointsWithHashTable(hashMerge);
+
+  vtkm::cont::Timer timer{ device };
+  for (auto _ : state)
+  {
+    (void)_;
+    timer.Start();
+    auto result = filter.Execute(GetInputDataSet());
+    ::benchmark::DoNotOptimize(result);
+    timer.Stop();
+
+    state.SetIterationTime(timer.GetElapsedTime());
+  }
+}
+VTKM_BENCHMARK_OPTS(BenchClipWithField, ->ArgName("HashMerge")->DenseRange(0, 1));
+
 void BenchExternalFaces(::benchmark::State& state)
 {
   const vtkm::cont::DeviceAdapterId device = Config.Device;
@@ -443,6 +516,66 @@ void BenchExternalFaces(::benchmark::State& state)
 }
 VTKM_BENCHMARK_OPTS(BenchExternalFaces, ->ArgName("Compact")->DenseRange(0, 1));
 
+void BenchExternalFacesUnstructured(::benchmark::State& state)
+{
+  const vtkm::cont::DeviceAdapterId device = Config.Device;
+  const bool hashTable = static_cast<bool>(state.range(0));
+
+  vtkm::filter::entity_extraction::ExternalFaces filter;
+  filter.SetMatchFacesWithHashTable(hashTable);
+
+  vtkm::cont::DataSet input = GetUnstructuredInputDataSet();
+  vtkm::cont::Timer timer{ device };
+  for (auto _ : state)
+  {
+    (void)_;
+    timer.Start();
+    auto result = filter.Execute(input);
+    ::benchmark::DoNotOptimize(result);
+    timer.Stop();
+
+    state.SetIterationTime(timer.GetElapsedTime());
+  }
+}
+VTKM_BENCHMARK_OPTS(BenchExternalFacesUnstructured, ->ArgName("HashTable")->DenseRange(0, 1));
+
+void BenchCleanGrid(::benchmark::State& state)
+{
+  const vtkm::cont::DeviceAdapterId device = Config.Device;
+  const bool fastMerge = static_cast<bool>(state.range(0));
+  const bool hashGrid = static_cast<bool>(state.range(1));
+
+  // A triangle soup, where every triangle has its own copy of its points, to weld back.
+  static const vtkm::cont::DataSet input = []() {
+    vtkm::filter::contour::Contour contour;
+    contour.SetActiveField(PointScalarsName, vtkm::cont::Field::Association::Points);
+    contour.SetMergeDuplicatePoints(false);
+    const vtkm::cont::DataSet& unstructured = GetUnstructuredInputDataSet();
+    auto field = unstructured.GetField(PointScalarsName, vtkm::cont::Field::Association::Points);
+    contour.SetIsoValue(field.GetRange().ReadPortal().Get(0).Center());
+    return contour.Execute(unstructured);
+  }();
+
+  vtkm::filter::clean_grid::CleanGrid filter;
+  filter.SetFastMerge(fastMerge);
+  filter.SetMergePointsWithHashGrid(hashGrid);
+
+  vtkm::cont::Timer timer{ device };
+  for (auto _ : state)
+  {
+    (void)_;
+    timer.Start();
+    auto result = filter.Execute(input);
+    ::benchmark::DoNotOptimize(result);
+    timer.Stop();
+
+    state.SetIterationTime(timer.GetElapsedTime());
+  }
+}
+VTKM_BENCHMARK_OPTS(BenchCleanGrid,
+                      ->ArgNames({ "FastMerge", "HashGrid" })
+                      ->Ranges({ { 0, 1 }, { 0, 1 } }));
+
 void BenchTetrahedralize(::benchmark::State& state)
 {
   const vtkm::cont::DeviceAdapterId device = Config.Device;
@@ -747,6 +880,45 @@ void CreateMissingFields()
   }
 }
 
+// Copy the uniform 3D InputDataSet, storing its point coordinates as per-axis arrays
+// (rectilinear) and as an explicit array of points (curvilinear). The geometry is unchanged.
+void CreateStructuredCopies(vtkm::cont::DataSet& rectilinear, vtkm::cont::DataSet& curvilinear)
+{
+  const vtkm::cont::DataSet& input = GetInputDataSet();
+  const vtkm::cont::CoordinateSystem& coords = input.GetCoordinateSystem();
+  auto uniformPortal =
+    coords.GetData().AsArrayHandle<vtkm::cont::ArrayHandleUniformPointCoordinates>().ReadPortal();
+  const vtkm::Id3 dims = uniformPortal.GetDimensions();
+  const vtkm::Vec3f origin = uniformPortal.GetOrigin();
+  const vtkm::Vec3f spacing = uniformPortal.GetSpacing();
+
+  vtkm::cont::ArrayHandle<vtkm::FloatDefault> axes[3];
+  for (vtkm::IdComponent d = 0; d < 3; ++d)
+  {
+    axes[d].Allocate(dims[d]);
+    auto axisPortal = axes[d].WritePortal();
+    for (vtkm::Id i = 0; i < dims[d]; ++i)
+    {
+      axisPortal.Set(i, origin[d] + spacing[d] * static_cast<vtkm::FloatDefault>(i));
+    }
+  }
+
+  vtkm::cont::ArrayHandle<vtkm::Vec3f> points;
+  vtkm::cont::ArrayCopy(coords.GetData(), points);
+
+  for (vtkm::cont::DataSet* copy : { &rectilinear, &curvilinear })
+  {
+    copy->SetCellSet(input.GetCellSet());
+    for (vtkm::IdComponent i = 0; i < input.GetNumberOfFields(); ++i)
+    {
+      copy->AddField(input.GetField(i));
+    }
+  }
+  rectilinear.AddCoordinateSystem(vtkm::cont::CoordinateSystem(
+    coords.GetName(), vtkm::cont::make_ArrayHandleCartesianProduct(axes[0], axes[1], axes[2])));
+  curvilinear.AddCoordinateSystem(vtkm::cont::CoordinateSystem(coords.GetName(), points));
+}
+
 struct Arg : vtkm::cont::internal::option::Arg
 {
   static vtkm::cont::internal::option::ArgStatus Number(
@@ -988,6 +1160,18 @@ void InitDataSet(int& argc, char** argv)
   UnstructuredInputDataSet = new vtkm::cont::DataSet;
   *UnstructuredInputDataSet = tet.Execute(GetInputDataSet());
 
+  if (GetInputDataSet().GetCellSet().IsType<vtkm::cont::CellSetStructured<3>>() &&
+      GetInputDataSet()
+        .GetCoordinateSystem()
+        .GetData()
+        .IsType<vtkm::cont::ArrayHandleUniformPointCoordinates>())
+  {
+    std::cerr << "[InitDataSet] Create rectilinear and curvilinear copies of InputDataSet...\n";
+    RectilinearInputDataSet = new vtkm::cont::DataSet;
+    CurvilinearInputDataSet = new vtkm::cont::DataSet;
+    CreateStructuredCopies(*RectilinearInputDataSet, *CurvilinearInputDataSet);
+  }
+
   if (tetra)
   {
     GetInputDataSet() = GetUnstructuredInputDataSet();
@@ -1028,4 +1212,6 @@ int main(int argc, char* argv[])
   VTKM_EXECUTE_BENCHMARKS_PREAMBLE(argc, args.data(), dataSetSummary);
   delete InputDataSet;
   delete UnstructuredInputDataSet;
+  delete RectilinearInputDataSet;
+  delete CurvilinearInputDataSet;
 }
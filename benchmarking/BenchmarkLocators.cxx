@@ -0,0 +1,294 @@
+//============================================================================
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//============================================================================
+
+#include "Benchmarker.h"
+
+#include <vtkm/cont/ArrayHandle.h>
+#include <vtkm/cont/CellLocatorBoundingIntervalHierarchy.h>
+#include <vtkm/cont/CellLocatorTwoLevel.h>
+#include <vtkm/cont/CoordinateSystem.h>
+#include <vtkm/cont/DataSetBuilderUniform.h>
+#include <vtkm/cont/Invoker.h>
+#include <vtkm/cont/PointLocatorSparseGrid.h>
+#include <vtkm/cont/Timer.h>
+
+#include <vtkm/filter/geometry_refinement/Tetrahedralize.h>
+
+#include <vtkm/worklet/KdTree3D.h>
+#include <vtkm/worklet/WorkletMapField.h>
+
+#include <cmath>
+#include <random>
+#include <vector>
+
+namespace
+{
+
+// Hold configuration state (e.g. active device)
+vtkm::cont::InitializeResult Config;
+
+enum PointLocatorType
+{
+  SPARSE_GRID = 0,
+  KD_TREE = 1
+};
+
+vtkm::cont::ArrayHandle<vtkm::Vec3f> MakeRandomPoints(vtkm::Id numPoints, unsigned int seed)
+{
+  std::mt19937 rng(seed);
+  std::uniform_real_distribution<vtkm::FloatDefault> dist(0, 1);
+  std::vector<vtkm::Vec3f> points;
+  points.reserve(static_cast<std::size_t>(numPoints));
+  for (vtkm::Id i = 0; i < numPoints; i++)
+    points.push_back(vtkm::Vec3f(dist(rng), dist(rng), dist(rng)));
+  return vtkm::cont::make_ArrayHandle(points, vtkm::CopyFlag::On);
+}
+
+// Aim for about 8 points per bin.
+vtkm::Id3 SparseGridBins(vtkm::Id numPoints)
+{
+  vtkm::Id dim =
+    vtkm::Max(vtkm::Id(1), static_cast<vtkm::Id>(std::cbrt(static_cast<double>(numPoints) / 8)));
+  return vtkm::Id3(dim, dim, dim);
+}
+
+struct PointLocators
+{
+  vtkm::cont::ArrayHandle<vtkm::Vec3f> Points;
+  vtkm::cont::PointLocatorSparseGrid SparseGrid;
+  VTKM_DEPRECATED_SUPPRESS_BEGIN
+  vtkm::worklet::KdTree3D KdTree;
+  VTKM_DEPRECATED_SUPPRESS_END
+
+  PointLocators(vtkm::Id numPoints, PointLocatorType type)
+    : Points(MakeRandomPoints(numPoints, 0))
+  {
+    if (type == SPARSE_GRID)
+    {
+      this->SparseGrid.SetCoordinates(vtkm::cont::CoordinateSystem("coords", this->Points));
+      this->SparseGrid.SetRange({ { 0.0, 1.0 } });
+      this->SparseGrid.SetNumberOfBins(SparseGridBins(numPoints));
+      this->SparseGrid.Update();
+    }
+    else
+    {
+      this->KdTree.Build(this->Points);
+    }
+  }
+};
+
+void BenchPointLocatorKNearestNeighbors(::benchmark::State& state)
+{
+  const vtkm::cont::DeviceAdapterId device = Config.Device;
+  const auto type = static_cast<PointLocatorType>(state.range(0));
+  const vtkm::Id numPoints = static_cast<vtkm::Id>(state.range(1));
+  const vtkm::Id k = static_cast<vtkm::Id>(state.range(2));
+  const vtkm::Id numQueries = 1 << 16;
+
+  PointLocators locators(numPoints, type);
+  auto queries = MakeRandomPoints(numQueries, 1);
+
+  vtkm::cont::ArrayHandle<vtkm::Id> neighborIds;
+  vtkm::cont::ArrayHandle<vtkm::FloatDefault> distances2;
+  vtkm::cont::Timer timer{ device };
+  for (auto _ : state)
+  {
+    (void)_;
+    timer.Start();
+    if (type == SPARSE_GRID)
+      locators.SparseGrid.FindKNearestNeighbors(queries, k, neighborIds, distances2);
+    else
+      locators.KdTree.RunKNearestNeighbors(locators.Points, queries, k, neighborIds, distances2);
+    timer.Stop();
+
+    state.SetIterationTime(timer.GetElapsedTime());
+  }
+  state.SetItemsProcessed(static_cast<int64_t>(numQueries) *
+                          static_cast<int64_t>(state.iterations()));
+}
+VTKM_BENCHMARK_OPTS(BenchPointLocatorKNearestNeighbors,
+                      ->ArgNames({ "Locator", "Points", "K" })
+                      ->ArgsProduct({ { SPARSE_GRID, KD_TREE },
+                                      { 1 << 16, 1 << 20 },
+                                      { 1, 8, 32 } }));
+
+void BenchPointLocatorRadius(::benchmark::State& state)
+{
+  const vtkm::cont::DeviceAdapterId device = Config.Device;
+  const auto type = static_cast<PointLocatorType>(state.range(0));
+  const vtkm::Id numPoints = static_cast<vtkm::Id>(state.range(1));
+  const vtkm::Id numQueries = 1 << 16;
+
+  PointLocators locators(numPoints, type);
+  auto queries = MakeRandomPoints(numQueries, 1);
+
+  // About 16 neighbors per query on average.
+  const vtkm::FloatDefault radius =
+    static_cast<vtkm::FloatDefault>(std::cbrt(16.0 / (4.18879 * static_cast<double>(numPoints))));
+
+  vtkm::cont::ArrayHandle<vtkm::Id> offsets, neighborIds;
+  vtkm::cont::Timer timer{ device };
+  for (auto _ : state)
+  {
+    (void)_;
+    timer.Start();
+    if (type == SPARSE_GRID)
+      locators.SparseGrid.FindPointsWithinRadius(queries, radius, offsets, neighborIds);
+    else
+      locators.KdTree.RunPointsWithinRadius(locators.Points, queries, radius, offsets, neighborIds);
+    timer.Stop();
+
+    state.SetIterationTime(timer.GetElapsedTime());
+  }
+  state.SetItemsProcessed(static_cast<int64_t>(numQueries) *
+                          static_cast<int64_t>(state.iterations()));
+}
+VTKM_BENCHMARK_OPTS(BenchPointLocatorRadius,
+                      ->ArgNames({ "Locator", "Points" })
+                      ->ArgsProduct({ { SPARSE_GRID, KD_TREE }, { 1 << 16, 1 << 20 } }));
+
+// CellLocatorUniformBins is a deprecated alias of CellLocatorTwoLevel, so it is covered by
+// the TWO_LEVEL case.
+enum CellLocatorType
+{
+  TWO_LEVEL = 0,
+  BIH_SPLIT_PLANES = 1,
+  BIH_MORTON_CODE = 2
+};
+
+// Tetrahedral mesh of the unit cube with 5 * (dim - 1)^3 cells.
+vtkm::cont::DataSet MakeTetMesh(vtkm::Id dim)
+{
+  vtkm::FloatDefault spacing = 1.0f / static_cast<vtkm::FloatDefault>(dim - 1);
+  vtkm::cont::DataSet uniform = vtkm::cont::DataSetBuilderUniform::Create(
+    vtkm::Id3(dim), vtkm::Vec3f(0.0f), vtkm::Vec3f(spacing));
+  vtkm::filter::geometry_refinement::Tetrahedralize tetrahedralize;
+  return tetrahedralize.Execute(uniform);
+}
+
+struct FindCellWorklet : public vtkm::worklet::WorkletMapField
+{
+  using ControlSignature = void(FieldIn point, ExecObject locator, FieldOut cellId);
+  using ExecutionSignature = void(_1, _2, _3);
+
+  template <typename LocatorType>
+  VTKM_EXEC void operator()(const vtkm::Vec3f& point,
+                            const LocatorType& locator,
+                            vtkm::Id& cellId) const
+  {
+    vtkm::Vec3f parametric;
+    locator.FindCell(point, cellId, parametric);
+  }
+};
+
+template <typename Functor>
+void CastAndCallCellLocator(CellLocatorType type, const vtkm::cont::DataSet& data, Functor&& f)
+{
+  switch (type)
+  {
+    case TWO_LEVEL:
+    {
+      vtkm::cont::CellLocatorTwoLevel locator;
+      locator.SetCellSet(data.GetCellSet());
+      locator.SetCoordinates(data.GetCoordinateSystem());
+      f(locator);
+      break;
+    }
+    case BIH_SPLIT_PLANES:
+    case BIH_MORTON_CODE:
+    {
+      vtkm::cont::CellLocatorBoundingIntervalHierarchy locator;
+      locator.SetBuildMethod(
+        type == BIH_SPLIT_PLANES
+          ? vtkm::cont::CellLocatorBoundingIntervalHierarchy::BuildMethod::SplitPlanes
+          : vtkm::cont::CellLocatorBoundingIntervalHierarchy::BuildMethod::MortonCode);
+      locator.SetCellSet(data.GetCellSet());
+      locator.SetCoordinates(data.GetCoordinateSystem());
+      f(locator);
+      break;
+    }
+  }
+}
+
+void BenchCellLocatorBuild(::benchmark::State& state)
+{
+  const vtkm::cont::DeviceAdapterId device = Config.Device;
+  const auto type = static_cast<CellLocatorType>(state.range(0));
+  const vtkm::Id dim = static_cast<vtkm::Id>(state.range(1));
+
+  vtkm::cont::DataSet data = MakeTetMesh(dim);
+
+  vtkm::cont::Timer timer{ device };
+  for (auto _ : state)
+  {
+    (void)_;
+    CastAndCallCellLocator(type, data, [&](auto& locator) {
+      timer.Start();
+      locator.Update();
+      timer.Stop();
+    });
+
+    state.SetIterationTime(timer.GetElapsedTime());
+  }
+  state.SetItemsProcessed(static_cast<int64_t>(data.GetNumberOfCells()) *
+                          static_cast<int64_t>(state.iterations()));
+}
+VTKM_BENCHMARK_OPTS(BenchCellLocatorBuild,
+                      ->ArgNames({ "Locator", "Dim" })
+                      ->ArgsProduct({ { TWO_LEVEL, BIH_SPLIT_PLANES, BIH_MORTON_CODE },
+                                      { 32, 64 } }));
+
+void BenchCellLocatorFindCell(::benchmark::State& state)
+{
+  const vtkm::cont::DeviceAdapterId device = Config.Device;
+  const auto type = static_cast<CellLocatorType>(state.range(0));
+  const vtkm::Id dim = static_cast<vtkm::Id>(state.range(1));
+  const vtkm::Id numQueries = 1 << 18;
+
+  vtkm::cont::DataSet data = MakeTetMesh(dim);
+  auto queries = MakeRandomPoints(numQueries, 1);
+
+  vtkm::cont::Invoker invoke;
+  vtkm::cont::ArrayHandle<vtkm::Id> cellIds;
+  vtkm::cont::Timer timer{ device };
+  CastAndCallCellLocator(type, data, [&](auto& locator) {
+    locator.Update();
+    for (auto _ : state)
+    {
+      (void)_;
+      timer.Start();
+      invoke(FindCellWorklet{}, queries, locator, cellIds);
+      timer.Stop();
+
+      state.SetIterationTime(timer.GetElapsedTime());
+    }
+  });
+  state.SetItemsProcessed(static_cast<int64_t>(numQueries) *
+                          static_cast<int64_t>(state.iterations()));
+}
+VTKM_BENCHMARK_OPTS(BenchCellLocatorFindCell,
+                      ->ArgNames({ "Locator", "Dim" })
+                      ->ArgsProduct({ { TWO_LEVEL, BIH_SPLIT_PLANES, BIH_MORTON_CODE },
+                                      { 32, 64 } }));
+
+} // end anon namespace
+
+int main(int argc, char* argv[])
+{
+  auto opts = vtkm::cont::InitializeOptions::DefaultAnyDevice;
+  std::vector<char*> args(argv, argv + argc);
+  vtkm::bench::detail::InitializeArgs(&argc, args, opts);
+  Config = vtkm::cont::Initialize(argc, args.data(), opts);
+  if (opts != vtkm::cont::InitializeOptions::None)
+  {
+    vtkm::cont::GetRuntimeDeviceTracker().ForceDevice(Config.Device);
+  }
+  VTKM_EXECUTE_BENCHMARKS(argc, args.data());
+}
@@ -11,6 +11,7 @@
 #include "Benchmarker.h"
 
 #include <vtkm/Particle.h>
+#include <vtkm/cont/ArrayCopy.h>
 #include <vtkm/cont/DataSet.h>
 #include <vtkm/cont/DataSetBuilderUniform.h>
 #include <vtkm/cont/Logging.h>
@@ -18,6 +19,12 @@
 #include <vtkm/cont/Timer.h>
 #include <vtkm/cont/internal/OptionParser.h>
 #include <vtkm/filter/flow/ParticleAdvection.h>
+#include <vtkm/filter/flow/worklet/GridEvaluators.h>
+#include <vtkm/filter/flow/worklet/ParticleAdvection.h>
+#include <vtkm/filter/flow/worklet/RK4Integrator.h>
+#include <vtkm/filter/flow/worklet/Stepper.h>
+
+#include <random>
 
 namespace
 {
@@ -72,6 +79,74 @@ VTKM_BENCHMARK_OPTS(BenchParticleAdvection,
                       ->ArgName("Steps")
                       ->Complexity());
 
+// Advect randomly placed seeds through a swirling field, either in the order they
+// were generated or reordered by the Morton code of their position.
+void BenchParticleAdvectionSeedOrdering(::benchmark::State& state)
+{
+  using FieldHandle = vtkm::cont::ArrayHandle<vtkm::Vec3f>;
+  using FieldType = vtkm::worklet::flow::VelocityField<FieldHandle>;
+  using GridEvalType = vtkm::worklet::flow::GridEvaluator<FieldType>;
+  using RK4Type = vtkm::worklet::flow::RK4Integrator<GridEvalType>;
+  using Stepper = vtkm::worklet::flow::Stepper<RK4Type, GridEvalType>;
+
+  const vtkm::cont::DeviceAdapterId device = Config.Device;
+  const bool spatialOrdering = static_cast<bool>(state.range(0));
+  const vtkm::Id numSeeds = static_cast<vtkm::Id>(state.range(1));
+  const vtkm::Id maxSteps = 100;
+  const vtkm::Id dim = 128;
+  const vtkm::Id3 dims(dim, dim, dim);
+
+  vtkm::cont::DataSetBuilderUniform dataSetBuilder;
+  vtkm::cont::DataSet ds = dataSetBuilder.Create(dims);
+
+  const vtkm::FloatDefault center = static_cast<vtkm::FloatDefault>(dim - 1) / 2;
+  std::vector<vtkm::Vec3f> vectorField(static_cast<std::size_t>(dim * dim * dim));
+  std::size_t idx = 0;
+  for (vtkm::Id k = 0; k < dim; k++)
+    for (vtkm::Id j = 0; j < dim; j++)
+      for (vtkm::Id i = 0; i < dim; i++)
+      {
+        vtkm::FloatDefault x = static_cast<vtkm::FloatDefault>(i) - center;
+        vtkm::FloatDefault y = static_cast<vtkm::FloatDefault>(j) - center;
+        vectorField[idx++] = vtkm::Vec3f(-y, x, 0.1f * center) / center;
+      }
+  FieldType velocities(vtkm::cont::make_ArrayHandle(vectorField, vtkm::CopyFlag::Off));
+
+  std::mt19937 rng;
+  std::uniform_real_distribution<vtkm::FloatDefault> dist(
+    1, static_cast<vtkm::FloatDefault>(dim - 2));
+  std::vector<vtkm::Particle> seeds;
+  seeds.reserve(static_cast<std::size_t>(numSeeds));
+  for (vtkm::Id i = 0; i < numSeeds; i++)
+    seeds.push_back(vtkm::Particle(vtkm::Vec3f(dist(rng), dist(rng), dist(rng)), i));
+  auto seedArray = vtkm::cont::make_ArrayHandle(seeds, vtkm::CopyFlag::Off);
+
+  GridEvalType eval(ds, velocities);
+  Stepper rk4(eval, 0.1f);
+
+  vtkm::worklet::flow::ParticleAdvection pa;
+  pa.SetUseSpatialOrdering(spatialOrdering);
+
+  vtkm::cont::ArrayHandle<vtkm::Particle> particles;
+  vtkm::cont::Timer timer{ device };
+  for (auto _ : state)
+  {
+    (void)_;
+    vtkm::cont::ArrayCopy(seedArray, particles);
+    timer.Start();
+    auto result = pa.Run(rk4, particles, maxSteps);
+    ::benchmark::DoNotOptimize(result);
+    timer.Stop();
+
+    state.SetIterationTime(timer.GetElapsedTime());
+  }
+  state.SetItemsProcessed(static_cast<int64_t>(numSeeds) * maxSteps *
+                          static_cast<int64_t>(state.iterations()));
+}
+VTKM_BENCHMARK_OPTS(BenchParticleAdvectionSeedOrdering,
+                      ->ArgNames({ "SpatialOrdering", "Seeds" })
+                      ->ArgsProduct({ { 0, 1 }, { 1 << 14, 1 << 18 } }));
+
 } // end anon namespace
 
 int main(int argc, char* argv[])
@@ -20,10 +20,13 @@
 #include <vtkm/source/Tangle.h>
 
 #include <vtkm/rendering/Camera.h>
+#include <vtkm/rendering/CanvasRayTracer.h>
+#include <vtkm/rendering/MapperWireframer.h>
 #include <vtkm/rendering/raytracing/Ray.h>
 #include <vtkm/rendering/raytracing/RayTracer.h>
 #include <vtkm/rendering/raytracing/SphereIntersector.h>
 #include <vtkm/rendering/raytracing/TriangleExtractor.h>
+#include <vtkm/rendering/raytracing/VolumeRendererStructured.h>
 
 #include <vtkm/exec/FunctorBase.h>
 
@@ -107,10 +110,130 @@ void BenchRayTracing(::benchmark::State& state)
 
     state.SetIterationTime(timer.GetElapsedTime());
   }
+
+  // Reported as items (primary rays) per second.
+  const int64_t iterations = static_cast<int64_t>(state.iterations());
+  state.SetItemsProcessed(static_cast<int64_t>(rays.NumRays) * iterations);
 }
 
 VTKM_BENCHMARK(BenchRayTracing);
 
+// Volume renders a tangle field. The transfer function is only visible over the top
+// state.range(0) percent of the scalar range, which leaves the rest of the volume empty.
+// Rays stop once their opacity reaches state.range(1) percent.
+void BenchVolumeRendering(::benchmark::State& state)
+{
+  const vtkm::Id3 dims(128, 128, 128);
+  const vtkm::Float32 visibleFraction = static_cast<vtkm::Float32>(state.range(0)) / 100.f;
+  const vtkm::Float32 terminationOpacity = static_cast<vtkm::Float32>(state.range(1)) / 100.f;
+
+  vtkm::source::Tangle maker(dims);
+  vtkm::cont::DataSet dataset = maker.Execute();
+  vtkm::cont::CoordinateSystem coords = dataset.GetCoordinateSystem();
+
+  vtkm::rendering::Camera camera;
+  camera.ResetToBounds(coords.GetBounds());
+  camera.Azimuth(30.f);
+  camera.Elevation(20.f);
+
+  vtkm::rendering::raytracing::Camera rayCamera;
+  rayCamera.SetParameters(camera, 1024, 1024);
+  vtkm::rendering::raytracing::Ray<vtkm::Float32> rays;
+
+  constexpr vtkm::Id numColors = 256;
+  vtkm::cont::ArrayHandle<vtkm::Vec4f_32> colors;
+  colors.Allocate(numColors);
+  {
+    auto portal = colors.WritePortal();
+    for (vtkm::Id i = 0; i < numColors; ++i)
+    {
+      const vtkm::Float32 t = static_cast<vtkm::Float32>(i) / static_cast<vtkm::Float32>(numColors);
+      const vtkm::Float32 alpha = (t >= 1.f - visibleFraction) ? 0.05f : 0.f;
+      portal.Set(i, vtkm::Vec4f_32(t, 0.5f, 1.f - t, alpha));
+    }
+  }
+
+  vtkm::cont::Field field = dataset.GetField("tangle");
+  vtkm::Range range = field.GetRange().ReadPortal().Get(0);
+  vtkm::cont::CellSetStructured<3> cellset;
+  dataset.GetCellSet().AsCellSet(cellset);
+
+  vtkm::rendering::raytracing::VolumeRendererStructured renderer;
+  renderer.SetColorMap(colors);
+  renderer.SetData(coords, field, cellset, range);
+  renderer.SetEarlyRayTerminationOpacity(terminationOpacity);
+
+  vtkm::cont::Timer timer{ Config.Device };
+  for (auto _ : state)
+  {
+    (void)_;
+    timer.Start();
+    rayCamera.CreateRays(rays, coords.GetBounds());
+    rays.Buffers.at(0).InitConst(0.f);
+    renderer.Render(rays);
+    timer.Stop();
+
+    state.SetIterationTime(timer.GetElapsedTime());
+  }
+
+  // Reported as frame time, plus items (primary rays) per second.
+  const int64_t iterations = static_cast<int64_t>(state.iterations());
+  state.SetItemsProcessed(static_cast<int64_t>(rays.NumRays) * iterations);
+}
+
+VTKM_BENCHMARK_OPTS(BenchVolumeRendering,
+                      ->Args({ 10, 100 })
+                      ->Args({ 10, 99 })
+                      ->Args({ 100, 100 })
+                      ->Args({ 100, 99 })
+                      ->ArgNames({ "VisiblePercent", "TerminationOpacityPercent" }));
+
+// Draws every edge of a tangle mesh, including internal ones, so that many edges compete for
+// the same pixels. state.range(0) is the tile size of the tiled rasterizer, 0 draws all edges
+// concurrently with atomic depth tests.
+void BenchWireframe(::benchmark::State& state)
+{
+  const vtkm::Id3 dims(48, 48, 48);
+  const vtkm::Id tileSize = static_cast<vtkm::Id>(state.range(0));
+
+  vtkm::source::Tangle maker(dims);
+  vtkm::cont::DataSet dataset = maker.Execute();
+  vtkm::cont::CoordinateSystem coords = dataset.GetCoordinateSystem();
+  vtkm::cont::Field field = dataset.GetField("tangle");
+  vtkm::Range range = field.GetRange().ReadPortal().Get(0);
+
+  vtkm::rendering::Camera camera;
+  camera.ResetToBounds(coords.GetBounds());
+  camera.Azimuth(30.f);
+  camera.Elevation(20.f);
+
+  vtkm::cont::ColorTable table(vtkm::cont::ColorTable::Preset::CoolToWarm);
+  vtkm::rendering::CanvasRayTracer canvas(1024, 1024);
+  vtkm::rendering::MapperWireframer mapper;
+  mapper.SetCanvas(&canvas);
+  mapper.SetShowInternalZones(true);
+  mapper.SetActiveColorTable(table);
+  if (tileSize > 0)
+  {
+    mapper.SetUseTiledRasterizer(true);
+    mapper.SetRasterizerTileSize(tileSize);
+  }
+
+  vtkm::cont::Timer timer{ Config.Device };
+  for (auto _ : state)
+  {
+    (void)_;
+    canvas.Clear();
+    timer.Start();
+    mapper.RenderCells(dataset.GetCellSet(), coords, field, table, camera, range);
+    timer.Stop();
+
+    state.SetIterationTime(timer.GetElapsedTime());
+  }
+}
+
+VTKM_BENCHMARK_OPTS(BenchWireframe, ->Arg(0)->Arg(16)->Arg(32)->Arg(64)->ArgName("TileSize"));
+
 } // end namespace vtkm::benchmarking
 
 int main(int argc, char* argv[])
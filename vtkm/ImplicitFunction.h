@@ -853,6 +853,15 @@ public:
   {
     return this->Variant.CastAndCall(detail::ImplicitFunctionGradientFunctor{}, point);
   }
+
+  /// \brief The variant holding the concrete implicit function.
+  ///
+  /// Use `IsType` and `Get` on the variant to specialize code for a type of function.
+  ///
+  VTKM_EXEC_CONT const vtkm::exec::internal::Variant<ImplicitFunctionTypes...>& GetVariant() const
+  {
+    return this->Variant;
+  }
 };
 
 //============================================================================
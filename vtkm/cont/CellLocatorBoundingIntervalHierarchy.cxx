@@ -19,6 +19,7 @@
 #include <vtkm/cont/ArrayHandlePermutation.h>
 #include <vtkm/cont/ArrayHandleReverse.h>
 #include <vtkm/cont/ArrayHandleTransform.h>
+#include <vtkm/cont/ArrayRangeCompute.h>
 #include <vtkm/cont/DeviceAdapterAlgorithm.h>
 #include <vtkm/cont/ErrorBadDevice.h>
 #include <vtkm/exec/CellLocatorBoundingIntervalHierarchy.h>
@@ -29,6 +30,8 @@
 
 #include <vtkm/worklet/spatialstructure/BoundingIntervalHierarchy.h>
 
+#include <vector>
+
 namespace vtkm
 {
 namespace cont
@@ -231,6 +234,150 @@ void CellLocatorBoundingIntervalHierarchy::Build()
 {
   VTKM_LOG_SCOPE(vtkm::cont::LogLevel::Perf, "CellLocatorBoundingIntervalHierarchy::Build");
 
+  // Start from an empty tree.
+  this->Nodes = vtkm::cont::ArrayHandle<vtkm::exec::CellLocatorBoundingIntervalHierarchyNode>{};
+  this->ProcessedCellIds = IdArrayHandle{};
+
+  switch (this->Method)
+  {
+    case BuildMethod::SplitPlanes:
+      this->BuildSplitPlanes();
+      break;
+    case BuildMethod::MortonCode:
+      this->BuildMortonCode();
+      break;
+  }
+}
+
+void CellLocatorBoundingIntervalHierarchy::BuildMortonCode()
+{
+  vtkm::cont::Invoker invoker;
+
+  vtkm::cont::UnknownCellSet cellSet = this->GetCellSet();
+  vtkm::Id numCells = cellSet.GetNumberOfCells();
+  auto points = this->GetCoordinates().GetDataAsMultiplexer();
+
+  CoordsArrayHandle centerXs, centerYs, centerZs;
+  RangeArrayHandle xRanges, yRanges, zRanges;
+  invoker(vtkm::worklet::spatialstructure::CellRangesExtracter{},
+          cellSet,
+          points,
+          xRanges,
+          yRanges,
+          zRanges,
+          centerXs,
+          centerYs,
+          centerZs);
+
+  // Sort the cells along a Z-order curve through their centers.
+  vtkm::Vec3f minPoint, inverseExtent;
+  const CoordsArrayHandle* centers[3] = { &centerXs, &centerYs, &centerZs };
+  for (vtkm::IdComponent dim = 0; dim < 3; ++dim)
+  {
+    vtkm::Range range = vtkm::cont::ArrayRangeCompute(*centers[dim]).ReadPortal().Get(0);
+    minPoint[dim] = static_cast<vtkm::FloatDefault>(range.Min);
+    inverseExtent[dim] = (range.Length() > 0)
+      ? static_cast<vtkm::FloatDefault>(1.0 / range.Length())
+      : vtkm::FloatDefault(0);
+  }
+  vtkm::cont::ArrayHandle<vtkm::UInt32> mortonCodes;
+  invoker(vtkm::worklet::spatialstructure::CellMortonCodeCalculator{ minPoint, inverseExtent },
+          centerXs,
+          centerYs,
+          centerZs,
+          mortonCodes);
+  centerXs.ReleaseResources();
+  centerYs.ReleaseResources();
+  centerZs.ReleaseResources();
+
+  vtkm::cont::Algorithm::Copy(CountingIdArrayHandle(0, 1, numCells), this->ProcessedCellIds);
+  vtkm::cont::Algorithm::SortByKey(mortonCodes, this->ProcessedCellIds);
+
+  // Build the tree top down, one level at a time. Each level only processes its segments,
+  // never all the cells.
+  using NodeArrayHandle =
+    vtkm::cont::ArrayHandle<vtkm::exec::CellLocatorBoundingIntervalHierarchyNode>;
+  std::vector<NodeArrayHandle> levelNodes;
+  IdArrayHandle segmentStarts, segmentSizes, parentIndices;
+  vtkm::cont::Algorithm::Copy(vtkm::cont::ArrayHandleConstant<vtkm::Id>(0, 1), segmentStarts);
+  vtkm::cont::Algorithm::Copy(vtkm::cont::ArrayHandleConstant<vtkm::Id>(numCells, 1),
+                              segmentSizes);
+  vtkm::cont::Algorithm::Copy(vtkm::cont::ArrayHandleConstant<vtkm::Id>(-1, 1), parentIndices);
+  vtkm::Id numSegments = 1;
+  vtkm::Id nodesIndexOffset = 0;
+  while (numSegments > 0)
+  {
+    IdArrayHandle leftSizes, splitFlags;
+    invoker(vtkm::worklet::spatialstructure::MortonSegmentSplitter{ this->MaxLeafSize },
+            segmentStarts,
+            segmentSizes,
+            mortonCodes,
+            leftSizes,
+            splitFlags);
+    IdArrayHandle runningSplitSegmentCounts;
+    vtkm::Id numNewSegments =
+      vtkm::cont::Algorithm::ScanExclusive(splitFlags, runningSplitSegmentCounts);
+
+    NodeArrayHandle nodes;
+    IdArrayHandle nextSegmentStarts, nextSegmentSizes, nextParentIndices;
+    nextSegmentStarts.Allocate(2 * numNewSegments);
+    nextSegmentSizes.Allocate(2 * numNewSegments);
+    nextParentIndices.Allocate(2 * numNewSegments);
+    invoker(vtkm::worklet::spatialstructure::MortonTreeLevelAdder{ nodesIndexOffset +
+                                                                   numSegments },
+            CountingIdArrayHandle(nodesIndexOffset, 1, numSegments),
+            segmentStarts,
+            segmentSizes,
+            parentIndices,
+            leftSizes,
+            splitFlags,
+            runningSplitSegmentCounts,
+            nodes,
+            nextSegmentStarts,
+            nextSegmentSizes,
+            nextParentIndices);
+    levelNodes.push_back(nodes);
+
+    nodesIndexOffset += numSegments;
+    numSegments = 2 * numNewSegments;
+    segmentStarts = nextSegmentStarts;
+    segmentSizes = nextSegmentSizes;
+    parentIndices = nextParentIndices;
+  }
+  mortonCodes.ReleaseResources();
+
+  this->Nodes.Allocate(nodesIndexOffset);
+  std::vector<vtkm::Id> levelOffsets;
+  vtkm::Id offset = 0;
+  for (const auto& nodes : levelNodes)
+  {
+    levelOffsets.push_back(offset);
+    vtkm::cont::Algorithm::CopySubRange(nodes, 0, nodes.GetNumberOfValues(), this->Nodes, offset);
+    offset += nodes.GetNumberOfValues();
+  }
+
+  // Compute the bounds of the leaves, then of the internal nodes from the deepest level up.
+  vtkm::cont::ArrayHandle<vtkm::Bounds> nodeBounds;
+  invoker(vtkm::worklet::spatialstructure::MortonLeafBoundsCalculator{},
+          this->Nodes,
+          this->ProcessedCellIds,
+          xRanges,
+          yRanges,
+          zRanges,
+          nodeBounds);
+  for (std::size_t level = levelNodes.size(); level-- > 0;)
+  {
+    invoker(vtkm::worklet::spatialstructure::MortonNodeBoundsCalculator{},
+            CountingIdArrayHandle(levelOffsets[level], 1, levelNodes[level].GetNumberOfValues()),
+            this->Nodes,
+            nodeBounds);
+  }
+
+  invoker(vtkm::worklet::spatialstructure::MortonSplitPlaneSelector{}, this->Nodes, nodeBounds);
+}
+
+void CellLocatorBoundingIntervalHierarchy::BuildSplitPlanes()
+{
   vtkm::cont::Invoker invoker;
 
   vtkm::cont::UnknownCellSet cellSet = this->GetCellSet();
@@ -41,11 +41,29 @@ public:
   using ExecObjType = vtkm::ListApply<CellLocatorExecList, vtkm::exec::CellLocatorMultiplexer>;
   using LastCell = typename ExecObjType::LastCell;
 
+  /// \brief Algorithm used to build the hierarchy.
+  ///
+  /// \c SplitPlanes evaluates \c NumberOfSplittingPlanes candidate planes per dimension at
+  /// every level of the tree and picks the cheapest one. It gives the best trees, but every
+  /// level requires many passes over all the cells.
+  ///
+  /// \c MortonCode sorts the cells once by the Morton code of their centers and splits each
+  /// range of sorted cells where the highest differing bit of the codes flips, like a linear
+  /// BVH. Each level of the tree only processes its nodes, never all the cells, and the bounding
+  /// intervals are computed bottom up once the tree is known. This builds much faster for
+  /// large meshes, usually with similar query performance.
+  enum struct BuildMethod
+  {
+    SplitPlanes,
+    MortonCode
+  };
+
   VTKM_CONT
   CellLocatorBoundingIntervalHierarchy(vtkm::IdComponent numPlanes = 4,
                                        vtkm::IdComponent maxLeafSize = 5)
     : NumPlanes(numPlanes)
     , MaxLeafSize(maxLeafSize)
+    , Method(BuildMethod::SplitPlanes)
     , Nodes()
     , ProcessedCellIds()
   {
@@ -71,17 +89,30 @@ public:
   VTKM_CONT
   vtkm::Id GetMaxLeafSize() { return this->MaxLeafSize; }
 
+  VTKM_CONT
+  void SetBuildMethod(BuildMethod method)
+  {
+    this->Method = method;
+    this->SetModified();
+  }
+
+  VTKM_CONT
+  BuildMethod GetBuildMethod() const { return this->Method; }
+
   VTKM_CONT ExecObjType PrepareForExecution(vtkm::cont::DeviceAdapterId device,
                                             vtkm::cont::Token& token) const;
 
 private:
   vtkm::IdComponent NumPlanes;
   vtkm::IdComponent MaxLeafSize;
+  BuildMethod Method;
   vtkm::cont::ArrayHandle<vtkm::exec::CellLocatorBoundingIntervalHierarchyNode> Nodes;
   vtkm::cont::ArrayHandle<vtkm::Id> ProcessedCellIds;
 
   friend Superclass;
   VTKM_CONT void Build();
+  VTKM_CONT void BuildSplitPlanes();
+  VTKM_CONT void BuildMortonCode();
 
   struct MakeExecObject;
 };
@@ -0,0 +1,189 @@
+//============================================================================
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//============================================================================
+#include <vtkm/cont/CellLocatorCache.h>
+
+#include <vtkm/cont/internal/MeshKey.h>
+
+#include <list>
+#include <mutex>
+
+namespace
+{
+
+struct LocatorKey
+{
+  std::type_index LocatorType;
+  vtkm::cont::internal::MeshKey Mesh;
+
+  LocatorKey(const std::type_index& type,
+             const vtkm::cont::UnknownCellSet& cellSet,
+             const vtkm::cont::CoordinateSystem& coords)
+    : LocatorType(type)
+    , Mesh(cellSet, coords)
+  {
+  }
+
+  // True if both keys refer to the same arrays, regardless of whether they were modified.
+  bool SameMesh(const LocatorKey& other) const
+  {
+    return (this->LocatorType == other.LocatorType) && this->Mesh.SameArrays(other.Mesh);
+  }
+
+  bool Matches(const LocatorKey& other) const
+  {
+    return (this->LocatorType == other.LocatorType) && this->Mesh.Matches(other.Mesh);
+  }
+};
+
+} // anonymous namespace
+
+namespace vtkm
+{
+namespace cont
+{
+
+struct CellLocatorCache::InternalsStruct
+{
+  struct Entry
+  {
+    LocatorKey Key;
+    std::shared_ptr<void> Locator;
+  };
+
+  std::mutex Mutex;
+  // Most recently used entries are at the front.
+  std::list<Entry> Entries;
+  vtkm::Id Capacity = 4;
+  vtkm::Id NumberOfHits = 0;
+
+  void Trim()
+  {
+    while (static_cast<vtkm::Id>(this->Entries.size()) > this->Capacity)
+    {
+      this->Entries.pop_back();
+    }
+  }
+};
+
+CellLocatorCache::CellLocatorCache()
+  : Internals(new InternalsStruct)
+{
+}
+
+CellLocatorCache::CellLocatorCache(vtkm::Id capacity)
+  : Internals(new InternalsStruct)
+{
+  this->Internals->Capacity = vtkm::Max(capacity, vtkm::Id(0));
+}
+
+CellLocatorCache::~CellLocatorCache() = default;
+
+std::shared_ptr<void> CellLocatorCache::Find(const std::type_index& type,
+                                             const vtkm::cont::UnknownCellSet& cellSet,
+                                             const vtkm::cont::CoordinateSystem& coords)
+{
+  LocatorKey key(type, cellSet, coords);
+  if (!key.Mesh.IsValid())
+  {
+    return nullptr;
+  }
+
+  std::lock_guard<std::mutex> lock(this->Internals->Mutex);
+  auto& entries = this->Internals->Entries;
+  auto iter = entries.begin();
+  while (iter != entries.end())
+  {
+    if (iter->Key.Matches(key))
+    {
+      entries.splice(entries.begin(), entries, iter);
+      ++this->Internals->NumberOfHits;
+      return entries.front().Locator;
+    }
+    if (iter->Key.SameMesh(key))
+    {
+      // Same mesh, but it has been modified since the locator was built.
+      iter = entries.erase(iter);
+    }
+    else
+    {
+      ++iter;
+    }
+  }
+  return nullptr;
+}
+
+void CellLocatorCache::Insert(const std::type_index& type,
+                              const vtkm::cont::UnknownCellSet& cellSet,
+                              const vtkm::cont::CoordinateSystem& coords,
+                              const std::shared_ptr<void>& locator)
+{
+  LocatorKey key(type, cellSet, coords);
+  if (!key.Mesh.IsValid())
+  {
+    return;
+  }
+
+  std::lock_guard<std::mutex> lock(this->Internals->Mutex);
+  if (this->Internals->Capacity < 1)
+  {
+    return;
+  }
+  auto& entries = this->Internals->Entries;
+  for (const auto& entry : entries)
+  {
+    if (entry.Key.Matches(key))
+    {
+      // Another thread built the same locator concurrently.
+      return;
+    }
+  }
+  entries.push_front({ key, locator });
+  this->Internals->Trim();
+}
+
+void CellLocatorCache::Clear()
+{
+  std::lock_guard<std::mutex> lock(this->Internals->Mutex);
+  this->Internals->Entries.clear();
+}
+
+void CellLocatorCache::SetCapacity(vtkm::Id capacity)
+{
+  std::lock_guard<std::mutex> lock(this->Internals->Mutex);
+  this->Internals->Capacity = vtkm::Max(capacity, vtkm::Id(0));
+  this->Internals->Trim();
+}
+
+vtkm::Id CellLocatorCache::GetCapacity() const
+{
+  std::lock_guard<std::mutex> lock(this->Internals->Mutex);
+  return this->Internals->Capacity;
+}
+
+vtkm::Id CellLocatorCache::GetNumberOfEntries() const
+{
+  std::lock_guard<std::mutex> lock(this->Internals->Mutex);
+  return static_cast<vtkm::Id>(this->Internals->Entries.size());
+}
+
+vtkm::Id CellLocatorCache::GetNumberOfHits() const
+{
+  std::lock_guard<std::mutex> lock(this->Internals->Mutex);
+  return this->Internals->NumberOfHits;
+}
+
+vtkm::cont::CellLocatorCache& GetGlobalCellLocatorCache()
+{
+  static vtkm::cont::CellLocatorCache cache(0);
+  return cache;
+}
+
+}
+} // namespace vtkm::cont
@@ -0,0 +1,124 @@
+//============================================================================
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//============================================================================
+#ifndef vtk_m_cont_CellLocatorCache_h
+#define vtk_m_cont_CellLocatorCache_h
+
+#include <vtkm/cont/CoordinateSystem.h>
+#include <vtkm/cont/Logging.h>
+#include <vtkm/cont/UnknownCellSet.h>
+#include <vtkm/cont/vtkm_cont_export.h>
+
+#include <memory>
+#include <typeindex>
+
+namespace vtkm
+{
+namespace cont
+{
+
+/// \brief Keeps built cell locators around so that they can be reused.
+///
+/// Building a cell locator can be as expensive as the search it enables. Filters that are
+/// executed repeatedly on the same mesh (for example a `Probe` applied to many time steps or
+/// the particle advection filters called once per time slice) can use `CellLocatorCache` to
+/// skip the rebuild.
+///
+/// Locators are keyed on the identity of the arrays of the cell set and of the coordinate
+/// system, not on their contents, so a mesh shared between data sets (or between the time
+/// steps of a series) is recognized. An entry is invalidated when any of these arrays is
+/// modified (see `vtkm::cont::internal::Buffer::GetModifiedCount`). Cell sets other than
+/// `CellSetExplicit`, `CellSetSingleType` and `CellSetStructured` are matched on the cell set
+/// object itself.
+///
+/// The cache holds a reference to the arrays of every cached mesh. It only keeps the
+/// `GetCapacity()` most recently used locators. Setting the capacity to 0 disables caching.
+///
+class VTKM_CONT_EXPORT CellLocatorCache
+{
+public:
+  /// \brief Creates a cache holding up to 4 locators, or up to \c capacity locators.
+  VTKM_CONT CellLocatorCache();
+  VTKM_CONT explicit CellLocatorCache(vtkm::Id capacity);
+  VTKM_CONT ~CellLocatorCache();
+
+  CellLocatorCache(const CellLocatorCache&) = delete;
+  CellLocatorCache& operator=(const CellLocatorCache&) = delete;
+
+  /// \brief Returns a built locator of type \c LocatorType for the given mesh.
+  ///
+  /// If a matching locator is in the cache, a shallow copy of it is returned. Otherwise a
+  /// new locator is built and added to the cache. The returned locator shares its search
+  /// structure with the cache, so it should not be modified.
+  ///
+  template <typename LocatorType>
+  VTKM_CONT LocatorType Get(const vtkm::cont::UnknownCellSet& cellSet,
+                            const vtkm::cont::CoordinateSystem& coords)
+  {
+    const std::type_index type(typeid(LocatorType));
+    std::shared_ptr<void> found = this->Find(type, cellSet, coords);
+    if (found)
+    {
+      return *static_cast<LocatorType*>(found.get());
+    }
+
+    VTKM_LOG_S(vtkm::cont::LogLevel::Perf,
+               "CellLocatorCache building " << vtkm::cont::TypeToString<LocatorType>());
+    auto locator = std::make_shared<LocatorType>();
+    locator->SetCellSet(cellSet);
+    locator->SetCoordinates(coords);
+    locator->Update();
+    this->Insert(type, cellSet, coords, locator);
+    return *locator;
+  }
+
+  /// \brief Removes all locators from the cache.
+  VTKM_CONT void Clear();
+
+  /// \brief The maximum number of locators held by the cache.
+  ///
+  /// When the cache is full, the least recently used locator is dropped. Reducing the
+  /// capacity drops locators immediately. A capacity of 0 disables caching.
+  ///
+  VTKM_CONT void SetCapacity(vtkm::Id capacity);
+  VTKM_CONT vtkm::Id GetCapacity() const;
+
+  /// \brief The number of locators currently held by the cache.
+  VTKM_CONT vtkm::Id GetNumberOfEntries() const;
+
+  /// \brief The number of calls to `Get` that were served from the cache.
+  VTKM_CONT vtkm::Id GetNumberOfHits() const;
+
+private:
+  VTKM_CONT std::shared_ptr<void> Find(const std::type_index& type,
+                                       const vtkm::cont::UnknownCellSet& cellSet,
+                                       const vtkm::cont::CoordinateSystem& coords);
+  VTKM_CONT void Insert(const std::type_index& type,
+                        const vtkm::cont::UnknownCellSet& cellSet,
+                        const vtkm::cont::CoordinateSystem& coords,
+                        const std::shared_ptr<void>& locator);
+
+  struct InternalsStruct;
+  std::unique_ptr<InternalsStruct> Internals;
+};
+
+/// \brief Returns the `CellLocatorCache` shared by the filters.
+///
+/// The global cache is disabled by default: its capacity is 0, so filters build a new
+/// locator every time. Cached locators keep their meshes, and the device memory of their
+/// search structures, alive after the data sets are released. Applications that execute
+/// filters repeatedly on the same meshes can opt in with `SetCapacity`, and call `Clear`
+/// when they are done with those meshes.
+///
+VTKM_CONT_EXPORT VTKM_CONT vtkm::cont::CellLocatorCache& GetGlobalCellLocatorCache();
+
+}
+} // namespace vtkm::cont
+
+#endif //vtk_m_cont_CellLocatorCache_h
@@ -11,6 +11,7 @@
 #define vtk_m_cont_CellLocatorChooser_h
 
 #include <vtkm/cont/CastAndCall.h>
+#include <vtkm/cont/CellLocatorCache.h>
 #include <vtkm/cont/CellLocatorRectilinearGrid.h>
 #include <vtkm/cont/CellLocatorTwoLevel.h>
 #include <vtkm/cont/CellLocatorUniformGrid.h>
@@ -74,9 +75,8 @@ struct CastAndCallCellLocatorChooserFunctor
                               Functor&& functor,
                               Args&&... args) const
   {
-    CellLocatorType locator;
-    locator.SetCellSet(cellSet);
-    locator.SetCoordinates(coordinateSystem);
+    CellLocatorType locator =
+      vtkm::cont::GetGlobalCellLocatorCache().Get<CellLocatorType>(cellSet, coordinateSystem);
 
     functor(locator, std::forward<Args>(args)...);
   }
@@ -122,7 +122,9 @@ struct CastAndCallCellLocatorChooserFunctor
 ///
 /// Given a cell set and a coordinate system of unknown types, calls a functor with an appropriate
 /// CellLocator of the given type. The CellLocator is populated with the provided cell set and
-/// coordinate system.
+/// coordinate system and is already built. It is taken from `GetGlobalCellLocatorCache()`, so
+/// when that cache is enabled, repeated calls with the same mesh reuse the same search
+/// structure.
 ///
 /// Any additional args are passed to the functor.
 ///
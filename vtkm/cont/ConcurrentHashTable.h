@@ -0,0 +1,86 @@
+//============================================================================
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//============================================================================
+#ifndef vtk_m_cont_ConcurrentHashTable_h
+#define vtk_m_cont_ConcurrentHashTable_h
+
+#include <vtkm/cont/ArrayHandle.h>
+#include <vtkm/cont/ExecutionObjectBase.h>
+#include <vtkm/exec/ConcurrentHashTable.h>
+
+namespace vtkm
+{
+namespace cont
+{
+
+/// \brief A set of 64-bit keys that can be filled concurrently in the execution environment.
+///
+/// `ConcurrentHashTable` is an open-addressing hash table with linear probing. It is passed
+/// to a worklet as an `ExecObject`, where `InsertOrGet` adds a key and returns the index of
+/// the slot holding it. Inserting a key that is already present returns the same slot, so
+/// the slot index identifies the key. All keys except `EmptyKey()` (all bits set) are valid.
+///
+/// The table does not grow. `Reset` sizes it for a given number of keys with a load factor
+/// of at most 1/2. `vtkm::worklet::MergeDuplicateKeys` uses the table to find the distinct
+/// values of an array of keys.
+///
+class ConcurrentHashTable : public vtkm::cont::ExecutionObjectBase
+{
+public:
+  VTKM_CONT ConcurrentHashTable() = default;
+
+  VTKM_CONT explicit ConcurrentHashTable(vtkm::Id numberOfKeys) { this->Reset(numberOfKeys); }
+
+  /// \brief Removes all keys and makes room for `numberOfKeys` keys.
+  VTKM_CONT void Reset(vtkm::Id numberOfKeys)
+  {
+    vtkm::Id capacity = 1;
+    while (capacity < 2 * numberOfKeys)
+    {
+      capacity *= 2;
+    }
+    this->Slots.AllocateAndFill(capacity, vtkm::exec::ConcurrentHashTable::EmptyKey());
+  }
+
+  VTKM_CONT vtkm::Id GetCapacity() const { return this->Slots.GetNumberOfValues(); }
+
+  /// \brief The slots of the table. Unused slots hold `EmptyKey()`.
+  VTKM_CONT const vtkm::cont::ArrayHandle<vtkm::UInt64>& GetSlots() const { return this->Slots; }
+
+  VTKM_CONT static constexpr vtkm::UInt64 EmptyKey()
+  {
+    return vtkm::exec::ConcurrentHashTable::EmptyKey();
+  }
+
+  /// \brief The number of bits needed to pack an id in [0, `numberOfIds`) into a key.
+  VTKM_CONT static vtkm::IdComponent GetNumberOfBitsForIds(vtkm::Id numberOfIds)
+  {
+    vtkm::IdComponent bits = 1;
+    while ((bits < 63) && ((vtkm::Id(1) << bits) < numberOfIds))
+    {
+      ++bits;
+    }
+    return bits;
+  }
+
+  VTKM_CONT vtkm::exec::ConcurrentHashTable PrepareForExecution(
+    vtkm::cont::DeviceAdapterId device,
+    vtkm::cont::Token& token) const
+  {
+    return vtkm::exec::ConcurrentHashTable(this->Slots, device, token);
+  }
+
+private:
+  vtkm::cont::ArrayHandle<vtkm::UInt64> Slots;
+};
+
+}
+} // namespace vtkm::cont
+
+#endif //vtk_m_cont_ConcurrentHashTable_h
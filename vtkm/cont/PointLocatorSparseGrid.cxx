@@ -22,7 +22,11 @@
 #include <vtkm/cont/Algorithm.h>
 #include <vtkm/cont/ArrayCopy.h>
 #include <vtkm/cont/ArrayHandleIndex.h>
+#include <vtkm/cont/ArrayHandleView.h>
+#include <vtkm/cont/ConvertNumComponentsToOffsets.h>
 #include <vtkm/cont/Invoker.h>
+
+#include <vtkm/VecFromPortal.h>
 #include <vtkm/worklet/WorkletMapField.h>
 
 namespace vtkm
@@ -63,6 +67,99 @@ private:
   vtkm::Vec3f Dxdydz;
 };
 
+class KNearestNeighborsWorklet : public vtkm::worklet::WorkletMapField
+{
+public:
+  using ControlSignature = void(FieldIn query,
+                                ExecObject locator,
+                                WholeArrayOut neighborIds,
+                                WholeArrayOut distances2);
+  using ExecutionSignature = void(_1, _2, _3, _4, WorkIndex);
+
+  VTKM_CONT
+  KNearestNeighborsWorklet(vtkm::Id k)
+    : K(k)
+  {
+  }
+
+  template <typename Locator, typename IdPortal, typename DistancePortal>
+  VTKM_EXEC void operator()(const vtkm::Vec3f& query,
+                            const Locator& locator,
+                            const IdPortal& neighborIds,
+                            const DistancePortal& distances2,
+                            vtkm::Id workIndex) const
+  {
+    vtkm::Id offset = workIndex * this->K;
+    const vtkm::IdComponent numComponents = static_cast<vtkm::IdComponent>(this->K);
+    vtkm::VecFromPortal<IdPortal> ids(neighborIds, numComponents, offset);
+    vtkm::VecFromPortal<DistancePortal> dists(distances2, numComponents, offset);
+    vtkm::Id numFound = locator.FindKNearestNeighbors(query, this->K, ids, dists);
+    for (vtkm::Id i = numFound; i < this->K; ++i)
+    {
+      neighborIds.Set(offset + i, -1);
+      distances2.Set(offset + i, vtkm::Infinity<vtkm::FloatDefault>());
+    }
+  }
+
+private:
+  vtkm::Id K;
+};
+
+class CountPointsWithinRadiusWorklet : public vtkm::worklet::WorkletMapField
+{
+public:
+  using ControlSignature = void(FieldIn query, ExecObject locator, FieldOut count);
+  using ExecutionSignature = void(_1, _2, _3);
+
+  VTKM_CONT
+  CountPointsWithinRadiusWorklet(vtkm::FloatDefault radius)
+    : Radius(radius)
+  {
+  }
+
+  template <typename Locator>
+  VTKM_EXEC void operator()(const vtkm::Vec3f& query,
+                            const Locator& locator,
+                            vtkm::IdComponent& count) const
+  {
+    count = static_cast<vtkm::IdComponent>(locator.CountPointsWithinRadius(query, this->Radius));
+  }
+
+private:
+  vtkm::FloatDefault Radius;
+};
+
+class FindPointsWithinRadiusWorklet : public vtkm::worklet::WorkletMapField
+{
+public:
+  using ControlSignature = void(FieldIn query,
+                                FieldIn count,
+                                FieldIn offset,
+                                ExecObject locator,
+                                WholeArrayOut neighborIds);
+  using ExecutionSignature = void(_1, _2, _3, _4, _5);
+
+  VTKM_CONT
+  FindPointsWithinRadiusWorklet(vtkm::FloatDefault radius)
+    : Radius(radius)
+  {
+  }
+
+  template <typename Locator, typename IdPortal>
+  VTKM_EXEC void operator()(const vtkm::Vec3f& query,
+                            vtkm::IdComponent count,
+                            vtkm::Id offset,
+                            const Locator& locator,
+                            const IdPortal& neighborIds) const
+  {
+    vtkm::VecFromPortal<IdPortal> ids(neighborIds, count, offset);
+    locator.FindPointsWithinRadius(query, this->Radius, ids);
+  }
+
+private:
+  vtkm::FloatDefault Radius;
+};
+
 } // vtkm::cont::internal
 
 void PointLocatorSparseGrid::Build()
@@ -103,6 +200,51 @@ void PointLocatorSparseGrid::Build()
   vtkm::cont::Algorithm::LowerBounds(cellIds, cell_ids_counting, this->CellLower);
 }
 
+void PointLocatorSparseGrid::FindKNearestNeighbors(
+  const vtkm::cont::ArrayHandle<vtkm::Vec3f>& queryPoints,
+  vtkm::Id k,
+  vtkm::cont::ArrayHandle<vtkm::Id>& neighborIds,
+  vtkm::cont::ArrayHandle<vtkm::FloatDefault>& distances2)
+{
+  VTKM_LOG_SCOPE(vtkm::cont::LogLevel::Perf, "PointLocatorSparseGrid::FindKNearestNeighbors");
+
+  this->Update();
+
+  vtkm::Id numValues = queryPoints.GetNumberOfValues() * k;
+  neighborIds.Allocate(numValues);
+  distances2.Allocate(numValues);
+
+  vtkm::cont::Invoker invoke;
+  invoke(internal::KNearestNeighborsWorklet{ k }, queryPoints, *this, neighborIds, distances2);
+}
+
+void PointLocatorSparseGrid::FindPointsWithinRadius(
+  const vtkm::cont::ArrayHandle<vtkm::Vec3f>& queryPoints,
+  vtkm::FloatDefault radius,
+  vtkm::cont::ArrayHandle<vtkm::Id>& offsets,
+  vtkm::cont::ArrayHandle<vtkm::Id>& neighborIds)
+{
+  VTKM_LOG_SCOPE(vtkm::cont::LogLevel::Perf, "PointLocatorSparseGrid::FindPointsWithinRadius");
+
+  this->Update();
+
+  vtkm::cont::Invoker invoke;
+  vtkm::cont::ArrayHandle<vtkm::IdComponent> counts;
+  invoke(internal::CountPointsWithinRadiusWorklet{ radius }, queryPoints, *this, counts);
+
+  vtkm::Id numNeighbors;
+  vtkm::cont::ConvertNumComponentsToOffsets(counts, offsets, numNeighbors);
+  neighborIds.Allocate(numNeighbors);
+
+  auto starts = vtkm::cont::make_ArrayHandleView(offsets, 0, queryPoints.GetNumberOfValues());
+  invoke(internal::FindPointsWithinRadiusWorklet{ radius },
+         queryPoints,
+         counts,
+         starts,
+         *this,
+         neighborIds);
+}
+
 vtkm::exec::PointLocatorSparseGrid PointLocatorSparseGrid::PrepareForExecution(
   vtkm::cont::DeviceAdapterId device,
   vtkm::cont::Token& token) const
@@ -71,6 +71,27 @@ public:
 
   const vtkm::Id3& GetNumberOfBins() const { return this->Dims; }
 
+  /// \brief Find the \c k nearest neighbors of each query point.
+  ///
+  /// The ids and squared distances of the neighbors of query point \c i are stored at indices
+  /// `[i * k, (i + 1) * k)` of \c neighborIds and \c distances2, sorted by increasing distance.
+  /// If the locator holds fewer than \c k points, the remaining entries are -1 and infinity.
+  VTKM_CONT void FindKNearestNeighbors(const vtkm::cont::ArrayHandle<vtkm::Vec3f>& queryPoints,
+                                       vtkm::Id k,
+                                       vtkm::cont::ArrayHandle<vtkm::Id>& neighborIds,
+                                       vtkm::cont::ArrayHandle<vtkm::FloatDefault>& distances2);
+
+  /// \brief Find all points within \c radius of each query point.
+  ///
+  /// The result is returned in compressed sparse row form: the neighbors of query point \c i
+  /// are `neighborIds[offsets[i]]` through `neighborIds[offsets[i + 1] - 1]`. The neighbors are
+  /// counted in a first pass so that \c neighborIds can be allocated exactly and filled in a
+  /// second pass.
+  VTKM_CONT void FindPointsWithinRadius(const vtkm::cont::ArrayHandle<vtkm::Vec3f>& queryPoints,
+                                        vtkm::FloatDefault radius,
+                                        vtkm::cont::ArrayHandle<vtkm::Id>& offsets,
+                                        vtkm::cont::ArrayHandle<vtkm::Id>& neighborIds);
+
   VTKM_CONT
   vtkm::exec::PointLocatorSparseGrid PrepareForExecution(vtkm::cont::DeviceAdapterId device,
                                                          vtkm::cont::Token& token) const;
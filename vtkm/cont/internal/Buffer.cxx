@@ -277,6 +277,9 @@ private:
   // data preserved.
   vtkm::BufferSizeType NumberOfBytes = 0;
 
+  // Incremented every time write access is granted so that clients can detect changes.
+  vtkm::UInt64 ModifiedCount = 0;
+
   DeviceBufferMap DeviceBuffers;
   BufferState HostBuffer;
 
@@ -327,6 +330,17 @@ public:
     this->CheckLock(lock);
     this->NumberOfBytes = numberOfBytes;
   }
+
+  VTKM_CONT vtkm::UInt64 GetModifiedCount(const LockType& lock)
+  {
+    this->CheckLock(lock);
+    return this->ModifiedCount;
+  }
+  VTKM_CONT void Modified(const LockType& lock)
+  {
+    this->CheckLock(lock);
+    ++this->ModifiedCount;
+  }
 };
 
 namespace detail
@@ -443,6 +457,7 @@ struct VTKM_NEVER_EXPORT BufferHelper
       lock, [&lock, &token, internals] { return CanWrite(internals, lock, token); });
 
     token.Attach(internals, internals->GetWriteCount(lock), lock, &internals->ConditionVariable);
+    internals->Modified(lock);
 
     // We successfully attached the token. Pop it off the queue.
     auto& queue = internals->GetQueue(lock);
@@ -769,6 +784,12 @@ vtkm::BufferSizeType Buffer::GetNumberOfBytes() const
   return this->Internals->GetNumberOfBytes(lock);
 }
 
+vtkm::UInt64 Buffer::GetModifiedCount() const
+{
+  LockType lock = this->Internals->GetLock();
+  return this->Internals->GetModifiedCount(lock);
+}
+
 void Buffer::SetNumberOfBytes(vtkm::BufferSizeType numberOfBytes,
                               vtkm::CopyFlag preserve,
                               vtkm::cont::Token& token) const
@@ -1007,6 +1028,7 @@ void Buffer::DeepCopyFrom(const vtkm::cont::internal::Buffer& src,
 void Buffer::Reset(const vtkm::cont::internal::BufferInfo& bufferInfo)
 {
   LockType lock = this->Internals->GetLock();
+  this->Internals->Modified(lock);
 
   // Clear out any old buffers. Because we are resetting the object, we will also get rid of
   // pinned memory.
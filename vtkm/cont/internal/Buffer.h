@@ -125,6 +125,14 @@ public:
                                   vtkm::CopyFlag preserve,
                                   vtkm::cont::Token& token) const;
 
+  /// \brief Returns a counter that changes every time the buffer is modified.
+  ///
+  /// The counter is incremented whenever write access to the buffer is granted (for example
+  /// when getting a write pointer or resizing) or the buffer is reset. It can be used to detect
+  /// whether the contents of a buffer might have changed since it was last observed.
+  ///
+  VTKM_CONT vtkm::UInt64 GetModifiedCount() const;
+
 private:
   VTKM_CONT bool MetaDataIsType(const std::string& type) const;
   VTKM_CONT void SetMetaData(void* data,
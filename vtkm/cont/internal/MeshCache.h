@@ -0,0 +1,124 @@
+//============================================================================
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//============================================================================
+#ifndef vtk_m_cont_internal_MeshCache_h
+#define vtk_m_cont_internal_MeshCache_h
+
+#include <vtkm/Math.h>
+#include <vtkm/Types.h>
+#include <vtkm/cont/internal/MeshKey.h>
+
+#include <list>
+
+namespace vtkm
+{
+namespace cont
+{
+namespace internal
+{
+
+/// \brief Holds the most recently used values derived from meshes.
+///
+/// Each value is stored with the `MeshKey` of the mesh it was derived from. Callers decide
+/// which entries match a query, since that usually depends on more than the key (a locator
+/// type, a radius or a level of detail). The cache keeps the `GetCapacity()` most recently
+/// used entries, and the arrays of their meshes. It is not thread safe.
+///
+template <typename ValueType>
+class MeshCache
+{
+public:
+  struct Entry
+  {
+    vtkm::cont::internal::MeshKey Mesh;
+    ValueType Value;
+  };
+
+  explicit MeshCache(vtkm::Id capacity)
+    : Capacity(vtkm::Max(capacity, vtkm::Id(0)))
+  {
+  }
+
+  /// \brief Returns the most recently used entry `match` accepts, or null if there is none.
+  ///
+  /// The entry found becomes the most recently used one, and counts as a hit.
+  ///
+  template <typename MatchFunctor>
+  Entry* Find(MatchFunctor&& match)
+  {
+    for (auto iter = this->Entries.begin(); iter != this->Entries.end(); ++iter)
+    {
+      if (match(static_cast<const Entry&>(*iter)))
+      {
+        this->Entries.splice(this->Entries.begin(), this->Entries, iter);
+        ++this->NumberOfHits;
+        return &this->Entries.front();
+      }
+    }
+    return nullptr;
+  }
+
+  /// \brief Adds a value as the most recently used one, after dropping the entries `stale`
+  /// accepts.
+  ///
+  /// Nothing is added if the mesh could not be identified or if the capacity is 0.
+  ///
+  template <typename StaleFunctor>
+  void Insert(const vtkm::cont::internal::MeshKey& mesh,
+              const ValueType& value,
+              StaleFunctor&& stale)
+  {
+    if (!mesh.IsValid() || (this->Capacity < 1))
+    {
+      return;
+    }
+    this->Entries.remove_if([&](const Entry& entry) { return stale(entry); });
+    this->Entries.push_front({ mesh, value });
+    this->Trim();
+  }
+
+  /// \brief The maximum number of entries held. Reducing it drops the least recently used
+  /// entries immediately, and 0 disables caching.
+  void SetCapacity(vtkm::Id capacity)
+  {
+    this->Capacity = vtkm::Max(capacity, vtkm::Id(0));
+    this->Trim();
+  }
+  vtkm::Id GetCapacity() const { return this->Capacity; }
+
+  vtkm::Id GetNumberOfEntries() const { return static_cast<vtkm::Id>(this->Entries.size()); }
+
+  /// \brief The number of calls to `Find` that found an entry.
+  vtkm::Id GetNumberOfHits() const { return this->NumberOfHits; }
+
+  /// \brief The entries, most recently used first.
+  const std::list<Entry>& GetEntries() const { return this->Entries; }
+
+  void Clear() { this->Entries.clear(); }
+
+private:
+  void Trim()
+  {
+    while (static_cast<vtkm::Id>(this->Entries.size()) > this->Capacity)
+    {
+      this->Entries.pop_back();
+    }
+  }
+
+  // Most recently used entries are at the front.
+  std::list<Entry> Entries;
+  vtkm::Id Capacity;
+  vtkm::Id NumberOfHits = 0;
+};
+
+}
+}
+} // namespace vtkm::cont::internal
+
+#endif //vtk_m_cont_internal_MeshCache_h
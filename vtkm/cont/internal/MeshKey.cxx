@@ -0,0 +1,164 @@
+//============================================================================
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//============================================================================
+#include <vtkm/cont/internal/MeshKey.h>
+
+#include <vtkm/cont/CellSetExplicit.h>
+#include <vtkm/cont/CellSetSingleType.h>
+#include <vtkm/cont/CellSetStructured.h>
+#include <vtkm/cont/ErrorBadType.h>
+
+namespace
+{
+
+struct AddBuffersFunctor
+{
+  template <typename ArrayType, typename StampsType>
+  void operator()(const ArrayType& array, StampsType& stamps) const
+  {
+    for (const auto& buffer : array.GetBuffers())
+    {
+      stamps.push_back({ buffer, buffer.GetModifiedCount() });
+    }
+  }
+};
+
+} // anonymous namespace
+
+namespace vtkm
+{
+namespace cont
+{
+namespace internal
+{
+
+template <typename CellSetType>
+bool MeshKey::AddExplicitCellSet(const vtkm::cont::UnknownCellSet& cellSet)
+{
+  if (!cellSet.IsType<CellSetType>())
+  {
+    return false;
+  }
+  const auto& cells = cellSet.AsCellSet<CellSetType>();
+  vtkm::TopologyElementTagCell visit;
+  vtkm::TopologyElementTagPoint incident;
+  AddBuffersFunctor addBuffers;
+  addBuffers(cells.GetShapesArray(visit, incident), this->CellSetBuffers);
+  addBuffers(cells.GetConnectivityArray(visit, incident), this->CellSetBuffers);
+  addBuffers(cells.GetOffsetsArray(visit, incident), this->CellSetBuffers);
+  this->Structure.push_back(cells.GetNumberOfPoints());
+  return true;
+}
+
+template <vtkm::IdComponent Dimension>
+bool MeshKey::AddStructuredCellSet(const vtkm::cont::UnknownCellSet& cellSet)
+{
+  using CellSetType = vtkm::cont::CellSetStructured<Dimension>;
+  if (!cellSet.IsType<CellSetType>())
+  {
+    return false;
+  }
+  vtkm::Vec<vtkm::Id, Dimension> pointDims(cellSet.AsCellSet<CellSetType>().GetPointDimensions());
+  for (vtkm::IdComponent i = 0; i < Dimension; ++i)
+  {
+    this->Structure.push_back(pointDims[i]);
+  }
+  this->Structured = true;
+  return true;
+}
+
+MeshKey::MeshKey(const vtkm::cont::UnknownCellSet& cellSet,
+                 const vtkm::cont::CoordinateSystem& coords)
+{
+  if (!cellSet.IsValid())
+  {
+    return;
+  }
+  const vtkm::cont::CellSet* cellSetBase = cellSet.GetCellSetBase();
+  this->CellSet = cellSet;
+  this->CellSetTypeIndex = typeid(*cellSetBase);
+  this->Structure.push_back(cellSet.GetNumberOfCells());
+  if (!(this->AddExplicitCellSet<vtkm::cont::CellSetExplicit<>>(cellSet) ||
+        this->AddExplicitCellSet<vtkm::cont::CellSetSingleType<>>(cellSet) ||
+        this->AddStructuredCellSet<1>(cellSet) || this->AddStructuredCellSet<2>(cellSet) ||
+        this->AddStructuredCellSet<3>(cellSet)))
+  {
+    this->CellSetPointer = cellSetBase;
+  }
+
+  try
+  {
+    coords.GetData().CastAndCall(AddBuffersFunctor{}, this->CoordinateBuffers);
+  }
+  catch (vtkm::cont::ErrorBadType&)
+  {
+    // Coordinates of a type we cannot look into. The mesh cannot be identified.
+    return;
+  }
+  this->Valid = true;
+}
+
+bool MeshKey::SameBuffers(const std::vector<BufferStamp>& a, const std::vector<BufferStamp>& b)
+{
+  if (a.size() != b.size())
+  {
+    return false;
+  }
+  for (std::size_t i = 0; i < a.size(); ++i)
+  {
+    if (!(a[i].Buffer == b[i].Buffer))
+    {
+      return false;
+    }
+  }
+  return true;
+}
+
+bool MeshKey::SameModifiedCounts(const std::vector<BufferStamp>& a,
+                                 const std::vector<BufferStamp>& b)
+{
+  for (std::size_t i = 0; i < a.size(); ++i)
+  {
+    if (a[i].ModifiedCount != b[i].ModifiedCount)
+    {
+      return false;
+    }
+  }
+  return true;
+}
+
+bool MeshKey::SameArrays(const MeshKey& other) const
+{
+  return this->Valid && other.Valid && (this->CellSetTypeIndex == other.CellSetTypeIndex) &&
+    (this->CellSetPointer == other.CellSetPointer) &&
+    SameBuffers(this->CellSetBuffers, other.CellSetBuffers) &&
+    SameBuffers(this->CoordinateBuffers, other.CoordinateBuffers);
+}
+
+bool MeshKey::CellSetMatches(const MeshKey& other) const
+{
+  // A structured cell set holds no arrays, only its dimensions, which all blocks of the same size
+  // share. Its points are told apart by the coordinate arrays instead.
+  return this->Valid && other.Valid && (this->CellSetTypeIndex == other.CellSetTypeIndex) &&
+    (this->CellSetPointer == other.CellSetPointer) && (this->Structure == other.Structure) &&
+    SameBuffers(this->CellSetBuffers, other.CellSetBuffers) &&
+    SameModifiedCounts(this->CellSetBuffers, other.CellSetBuffers) &&
+    (!this->Structured || SameBuffers(this->CoordinateBuffers, other.CoordinateBuffers));
+}
+
+bool MeshKey::CoordinatesMatch(const MeshKey& other) const
+{
+  return this->Valid && other.Valid &&
+    SameBuffers(this->CoordinateBuffers, other.CoordinateBuffers) &&
+    SameModifiedCounts(this->CoordinateBuffers, other.CoordinateBuffers);
+}
+
+}
+}
+} // namespace vtkm::cont::internal
@@ -0,0 +1,102 @@
+//============================================================================
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//============================================================================
+#ifndef vtk_m_cont_internal_MeshKey_h
+#define vtk_m_cont_internal_MeshKey_h
+
+#include <vtkm/cont/CoordinateSystem.h>
+#include <vtkm/cont/UnknownCellSet.h>
+#include <vtkm/cont/internal/Buffer.h>
+#include <vtkm/cont/vtkm_cont_export.h>
+
+#include <typeindex>
+#include <vector>
+
+namespace vtkm
+{
+namespace cont
+{
+namespace internal
+{
+
+/// \brief Identifies the arrays of a mesh and the state they are in.
+///
+/// A `MeshKey` records which arrays a cell set and a coordinate system hold, along with the
+/// modified count of each (see `Buffer::GetModifiedCount`). It is used to cache structures
+/// derived from a mesh, such as cell locators or bounding volume hierarchies, and to tell
+/// whether the mesh changed since they were built. Arrays are identified by identity, not by
+/// contents, so a mesh shared between data sets is recognized.
+///
+/// `CellSetStructured` is identified by its dimensions and by the coordinate arrays, since
+/// blocks of the same size have nothing else to tell them apart. Other cell sets than
+/// `CellSetExplicit`, `CellSetSingleType` and `CellSetStructured` are identified by the cell set
+/// object itself. The key holds references to the arrays, which keeps them alive.
+///
+class VTKM_CONT_EXPORT MeshKey
+{
+public:
+  VTKM_CONT MeshKey() = default;
+  VTKM_CONT MeshKey(const vtkm::cont::UnknownCellSet& cellSet,
+                    const vtkm::cont::CoordinateSystem& coords);
+
+  /// \brief False if the mesh could not be identified, in which case it should not be cached.
+  VTKM_CONT bool IsValid() const { return this->Valid; }
+
+  /// \brief True if both keys refer to the same arrays, whether or not they were modified.
+  VTKM_CONT bool SameArrays(const MeshKey& other) const;
+
+  /// \brief True if both keys refer to the same cell set, unmodified.
+  ///
+  /// Structured cell sets must also refer to the same coordinate arrays, modified or not.
+  ///
+  VTKM_CONT bool CellSetMatches(const MeshKey& other) const;
+
+  /// \brief True if both keys refer to the same coordinate arrays, unmodified.
+  VTKM_CONT bool CoordinatesMatch(const MeshKey& other) const;
+
+  /// \brief True if both keys refer to the same arrays and none of them was modified.
+  VTKM_CONT bool Matches(const MeshKey& other) const
+  {
+    return this->CellSetMatches(other) && this->CoordinatesMatch(other);
+  }
+
+private:
+  struct BufferStamp
+  {
+    vtkm::cont::internal::Buffer Buffer;
+    vtkm::UInt64 ModifiedCount;
+  };
+
+  template <typename CellSetType>
+  VTKM_CONT bool AddExplicitCellSet(const vtkm::cont::UnknownCellSet& cellSet);
+  template <vtkm::IdComponent Dimension>
+  VTKM_CONT bool AddStructuredCellSet(const vtkm::cont::UnknownCellSet& cellSet);
+
+  VTKM_CONT static bool SameBuffers(const std::vector<BufferStamp>& a,
+                                    const std::vector<BufferStamp>& b);
+  VTKM_CONT static bool SameModifiedCounts(const std::vector<BufferStamp>& a,
+                                           const std::vector<BufferStamp>& b);
+
+  bool Valid = false;
+  bool Structured = false;
+  std::type_index CellSetTypeIndex = typeid(void);
+  // Cell sets whose arrays we cannot look into are identified by their address. Holding the
+  // cell set keeps that address from being reused by another object.
+  vtkm::cont::UnknownCellSet CellSet;
+  const vtkm::cont::CellSet* CellSetPointer = nullptr;
+  std::vector<vtkm::Id> Structure;
+  std::vector<BufferStamp> CellSetBuffers;
+  std::vector<BufferStamp> CoordinateBuffers;
+};
+
+}
+}
+} // namespace vtkm::cont::internal
+
+#endif //vtk_m_cont_internal_MeshKey_h
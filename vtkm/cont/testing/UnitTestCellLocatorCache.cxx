@@ -0,0 +1,188 @@
+//============================================================================
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//============================================================================
+#include <vtkm/cont/CellLocatorCache.h>
+
+#include <vtkm/cont/ArrayCopy.h>
+#include <vtkm/cont/ArrayHandleUniformPointCoordinates.h>
+#include <vtkm/cont/CellLocatorGeneral.h>
+#include <vtkm/cont/CellLocatorTwoLevel.h>
+#include <vtkm/cont/CellSetStructured.h>
+#include <vtkm/cont/DataSet.h>
+#include <vtkm/cont/Invoker.h>
+#include <vtkm/cont/testing/Testing.h>
+#include <vtkm/worklet/WorkletMapField.h>
+
+namespace
+{
+
+struct FindCellWorklet : public vtkm::worklet::WorkletMapField
+{
+  using ControlSignature = void(FieldIn point, ExecObject locator, FieldOut cellId);
+  using ExecutionSignature = void(_1, _2, _3);
+
+  template <typename LocatorType>
+  VTKM_EXEC void operator()(const vtkm::Vec3f& point,
+                            const LocatorType& locator,
+                            vtkm::Id& cellId) const
+  {
+    vtkm::Vec3f parametric;
+    locator.FindCell(point, cellId, parametric);
+  }
+};
+
+// A unit cube with 4x4x4 cells and explicit point coordinates.
+vtkm::cont::DataSet MakeDataSet()
+{
+  const vtkm::Id3 dims(5, 5, 5);
+  vtkm::cont::CellSetStructured<3> cellSet;
+  cellSet.SetPointDimensions(dims);
+
+  vtkm::cont::ArrayHandle<vtkm::Vec3f> coords;
+  vtkm::cont::ArrayCopy(vtkm::cont::ArrayHandleUniformPointCoordinates(
+                          dims, vtkm::Vec3f(0.0f), vtkm::Vec3f(0.25f)),
+                        coords);
+
+  vtkm::cont::DataSet dataSet;
+  dataSet.SetCellSet(cellSet);
+  dataSet.AddCoordinateSystem(vtkm::cont::CoordinateSystem("coords", coords));
+  return dataSet;
+}
+
+vtkm::Id FindCell(const vtkm::cont::CellLocatorTwoLevel& locator, const vtkm::Vec3f& point)
+{
+  vtkm::cont::ArrayHandle<vtkm::Id> cellIds;
+  vtkm::cont::Invoker invoke;
+  invoke(FindCellWorklet{}, vtkm::cont::make_ArrayHandle({ point }), locator, cellIds);
+  return cellIds.ReadPortal().Get(0);
+}
+
+void TestReuse()
+{
+  std::cout << "Test locator reuse" << std::endl;
+  vtkm::cont::CellLocatorCache cache;
+  vtkm::cont::DataSet dataSet = MakeDataSet();
+
+  auto locator1 =
+    cache.Get<vtkm::cont::CellLocatorTwoLevel>(dataSet.GetCellSet(), dataSet.GetCoordinateSystem());
+  VTKM_TEST_ASSERT(cache.GetNumberOfEntries() == 1, "Locator not cached");
+  VTKM_TEST_ASSERT(cache.GetNumberOfHits() == 0, "Unexpected cache hit");
+  VTKM_TEST_ASSERT(FindCell(locator1, vtkm::Vec3f(0.1f, 0.1f, 0.1f)) == 0, "Wrong cell");
+
+  auto locator2 =
+    cache.Get<vtkm::cont::CellLocatorTwoLevel>(dataSet.GetCellSet(), dataSet.GetCoordinateSystem());
+  VTKM_TEST_ASSERT(cache.GetNumberOfEntries() == 1, "Locator cached twice");
+  VTKM_TEST_ASSERT(cache.GetNumberOfHits() == 1, "Locator not reused");
+  VTKM_TEST_ASSERT(FindCell(locator2, vtkm::Vec3f(0.9f, 0.9f, 0.9f)) == 63, "Wrong cell");
+
+  // A different data set with the same structure and coordinate array is the same mesh.
+  vtkm::cont::CellSetStructured<3> otherCellSet;
+  otherCellSet.SetPointDimensions(vtkm::Id3(5, 5, 5));
+  vtkm::cont::DataSet other;
+  other.SetCellSet(otherCellSet);
+  other.AddCoordinateSystem(dataSet.GetCoordinateSystem());
+  cache.Get<vtkm::cont::CellLocatorTwoLevel>(other.GetCellSet(), other.GetCoordinateSystem());
+  VTKM_TEST_ASSERT(cache.GetNumberOfHits() == 2, "Locator not reused for shared mesh");
+
+  // A different locator type is a different entry.
+  cache.Get<vtkm::cont::CellLocatorGeneral>(dataSet.GetCellSet(), dataSet.GetCoordinateSystem());
+  VTKM_TEST_ASSERT(cache.GetNumberOfEntries() == 2, "Locator types not distinguished");
+  VTKM_TEST_ASSERT(cache.GetNumberOfHits() == 2, "Unexpected cache hit");
+}
+
+void TestInvalidation()
+{
+  std::cout << "Test invalidation when coordinates change" << std::endl;
+  vtkm::cont::CellLocatorCache cache;
+  vtkm::cont::DataSet dataSet = MakeDataSet();
+
+  auto locator =
+    cache.Get<vtkm::cont::CellLocatorTwoLevel>(dataSet.GetCellSet(), dataSet.GetCoordinateSystem());
+  VTKM_TEST_ASSERT(FindCell(locator, vtkm::Vec3f(0.1f, 0.1f, 0.1f)) == 0, "Wrong cell");
+
+  // Move the mesh by 10 along x.
+  vtkm::cont::ArrayHandle<vtkm::Vec3f> coords;
+  dataSet.GetCoordinateSystem().GetData().AsArrayHandle(coords);
+  {
+    auto portal = coords.WritePortal();
+    for (vtkm::Id i = 0; i < portal.GetNumberOfValues(); ++i)
+    {
+      portal.Set(i, portal.Get(i) + vtkm::Vec3f(10.0f, 0.0f, 0.0f));
+    }
+  }
+
+  locator =
+    cache.Get<vtkm::cont::CellLocatorTwoLevel>(dataSet.GetCellSet(), dataSet.GetCoordinateSystem());
+  VTKM_TEST_ASSERT(cache.GetNumberOfHits() == 0, "Stale locator reused");
+  VTKM_TEST_ASSERT(cache.GetNumberOfEntries() == 1, "Stale locator not dropped");
+  VTKM_TEST_ASSERT(FindCell(locator, vtkm::Vec3f(10.1f, 0.1f, 0.1f)) == 0, "Wrong cell");
+  VTKM_TEST_ASSERT(FindCell(locator, vtkm::Vec3f(0.1f, 0.1f, 0.1f)) == -1, "Wrong cell");
+}
+
+void TestCapacity()
+{
+  std::cout << "Test capacity" << std::endl;
+  vtkm::cont::CellLocatorCache cache;
+  cache.SetCapacity(2);
+
+  vtkm::cont::DataSet dataSets[3] = { MakeDataSet(), MakeDataSet(), MakeDataSet() };
+  for (const auto& dataSet : dataSets)
+  {
+    cache.Get<vtkm::cont::CellLocatorTwoLevel>(dataSet.GetCellSet(),
+                                               dataSet.GetCoordinateSystem());
+  }
+  VTKM_TEST_ASSERT(cache.GetNumberOfEntries() == 2, "Capacity not respected");
+
+  // The first data set was the least recently used and must have been evicted.
+  cache.Get<vtkm::cont::CellLocatorTwoLevel>(dataSets[2].GetCellSet(),
+                                             dataSets[2].GetCoordinateSystem());
+  VTKM_TEST_ASSERT(cache.GetNumberOfHits() == 1, "Most recent locator evicted");
+  cache.Get<vtkm::cont::CellLocatorTwoLevel>(dataSets[0].GetCellSet(),
+                                             dataSets[0].GetCoordinateSystem());
+  VTKM_TEST_ASSERT(cache.GetNumberOfHits() == 1, "Least recent locator not evicted");
+
+  cache.SetCapacity(0);
+  VTKM_TEST_ASSERT(cache.GetNumberOfEntries() == 0, "Cache not emptied");
+  cache.Get<vtkm::cont::CellLocatorTwoLevel>(dataSets[0].GetCellSet(),
+                                             dataSets[0].GetCoordinateSystem());
+  VTKM_TEST_ASSERT(cache.GetNumberOfEntries() == 0, "Disabled cache stored a locator");
+}
+
+void TestGlobalCache()
+{
+  std::cout << "Test global cache" << std::endl;
+  vtkm::cont::CellLocatorCache& cache = vtkm::cont::GetGlobalCellLocatorCache();
+  VTKM_TEST_ASSERT(cache.GetCapacity() == 0, "Global cache is enabled by default");
+
+  vtkm::cont::DataSet dataSet = MakeDataSet();
+  cache.Get<vtkm::cont::CellLocatorTwoLevel>(dataSet.GetCellSet(), dataSet.GetCoordinateSystem());
+  VTKM_TEST_ASSERT(cache.GetNumberOfEntries() == 0, "Disabled global cache stored a locator");
+
+  cache.SetCapacity(1);
+  cache.Get<vtkm::cont::CellLocatorTwoLevel>(dataSet.GetCellSet(), dataSet.GetCoordinateSystem());
+  cache.Get<vtkm::cont::CellLocatorTwoLevel>(dataSet.GetCellSet(), dataSet.GetCoordinateSystem());
+  VTKM_TEST_ASSERT(cache.GetNumberOfHits() == 1, "Enabled global cache not reused");
+  cache.SetCapacity(0);
+  VTKM_TEST_ASSERT(cache.GetNumberOfEntries() == 0, "Global cache not emptied");
+}
+
+void TestAll()
+{
+  TestReuse();
+  TestInvalidation();
+  TestCapacity();
+  TestGlobalCache();
+}
+
+} // anonymous namespace
+
+int UnitTestCellLocatorCache(int argc, char* argv[])
+{
+  return vtkm::cont::testing::Testing::Run(TestAll, argc, argv);
+}
@@ -0,0 +1,137 @@
+//============================================================================
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//============================================================================
+#include <vtkm/cont/ConcurrentHashTable.h>
+
+#include <vtkm/cont/Invoker.h>
+#include <vtkm/cont/testing/Testing.h>
+#include <vtkm/worklet/WorkletMapField.h>
+
+#include <map>
+#include <vector>
+
+namespace
+{
+
+struct InsertWorklet : public vtkm::worklet::WorkletMapField
+{
+  using ControlSignature = void(FieldIn key, ExecObject table, FieldOut slot);
+  using ExecutionSignature = void(_1, _2, _3);
+
+  VTKM_EXEC void operator()(vtkm::UInt64 key,
+                            const vtkm::exec::ConcurrentHashTable& table,
+                            vtkm::Id& slot) const
+  {
+    slot = table.InsertOrGet(key);
+  }
+};
+
+struct FindWorklet : public vtkm::worklet::WorkletMapField
+{
+  using ControlSignature = void(FieldIn key, ExecObject table, FieldOut slot);
+  using ExecutionSignature = void(_1, _2, _3);
+
+  VTKM_EXEC void operator()(vtkm::UInt64 key,
+                            const vtkm::exec::ConcurrentHashTable& table,
+                            vtkm::Id& slot) const
+  {
+    slot = table.Find(key);
+  }
+};
+
+// Keys where every value appears several times, in a scrambled order. Keys that differ only
+// in their high bits are included to exercise the hash function.
+std::vector<vtkm::UInt64> MakeKeys(vtkm::Id numberOfKeys, vtkm::UInt64 numberOfDistinct)
+{
+  std::vector<vtkm::UInt64> keys;
+  for (vtkm::Id i = 0; i < numberOfKeys; ++i)
+  {
+    const vtkm::UInt64 value = (static_cast<vtkm::UInt64>(i) * 7919) % numberOfDistinct;
+    keys.push_back((value << 40) | (value & 0xff));
+  }
+  return keys;
+}
+
+void TestInsertAndFind()
+{
+  std::cout << "Testing InsertOrGet and Find" << std::endl;
+  std::vector<vtkm::UInt64> keys = MakeKeys(1000, 100);
+  vtkm::cont::ArrayHandle<vtkm::UInt64> keyArray =
+    vtkm::cont::make_ArrayHandle(keys, vtkm::CopyFlag::Off);
+
+  vtkm::cont::ConcurrentHashTable table(keyArray.GetNumberOfValues());
+  VTKM_TEST_ASSERT(table.GetCapacity() == 2048, "Unexpected capacity");
+
+  vtkm::cont::Invoker invoke;
+  vtkm::cont::ArrayHandle<vtkm::Id> slots;
+  invoke(InsertWorklet{}, keyArray, table, slots);
+
+  // Equal keys share a slot, and different keys do not.
+  std::map<vtkm::UInt64, vtkm::Id> keyToSlot;
+  std::map<vtkm::Id, vtkm::UInt64> slotToKey;
+  auto slotPortal = slots.ReadPortal();
+  auto tablePortal = table.GetSlots().ReadPortal();
+  for (std::size_t i = 0; i < keys.size(); ++i)
+  {
+    const vtkm::Id slot = slotPortal.Get(static_cast<vtkm::Id>(i));
+    VTKM_TEST_ASSERT(slot >= 0, "Key was not inserted");
+    VTKM_TEST_ASSERT(tablePortal.Get(slot) == keys[i], "Slot does not hold its key");
+    auto inserted = keyToSlot.insert({ keys[i], slot });
+    VTKM_TEST_ASSERT(inserted.first->second == slot, "Equal keys in different slots");
+    auto reverse = slotToKey.insert({ slot, keys[i] });
+    VTKM_TEST_ASSERT(reverse.first->second == keys[i], "Different keys in the same slot");
+  }
+  VTKM_TEST_ASSERT(keyToSlot.size() == 100, "Wrong number of distinct keys");
+
+  vtkm::Id numberOfUsedSlots = 0;
+  for (vtkm::Id i = 0; i < table.GetCapacity(); ++i)
+  {
+    if (tablePortal.Get(i) != vtkm::cont::ConcurrentHashTable::EmptyKey())
+    {
+      ++numberOfUsedSlots;
+    }
+  }
+  VTKM_TEST_ASSERT(numberOfUsedSlots == 100, "Wrong number of used slots");
+
+  vtkm::cont::ArrayHandle<vtkm::UInt64> queries =
+    vtkm::cont::make_ArrayHandle<vtkm::UInt64>({ keys[0], keys[1], 12345, keys[0] + 1 });
+  vtkm::cont::ArrayHandle<vtkm::Id> found;
+  invoke(FindWorklet{}, queries, table, found);
+  auto foundPortal = found.ReadPortal();
+  VTKM_TEST_ASSERT(foundPortal.Get(0) == keyToSlot[keys[0]], "Find returned the wrong slot");
+  VTKM_TEST_ASSERT(foundPortal.Get(1) == keyToSlot[keys[1]], "Find returned the wrong slot");
+  VTKM_TEST_ASSERT(foundPortal.Get(2) == -1, "Find returned a missing key");
+  VTKM_TEST_ASSERT(foundPortal.Get(3) == -1, "Find returned a missing key");
+
+  table.Reset(10);
+  VTKM_TEST_ASSERT(table.GetCapacity() == 32, "Unexpected capacity after reset");
+  invoke(FindWorklet{}, queries, table, found);
+  VTKM_TEST_ASSERT(found.ReadPortal().Get(0) == -1, "Reset did not clear the table");
+}
+
+void TestNumberOfBitsForIds()
+{
+  std::cout << "Testing GetNumberOfBitsForIds" << std::endl;
+  VTKM_TEST_ASSERT(vtkm::cont::ConcurrentHashTable::GetNumberOfBitsForIds(1) == 1);
+  VTKM_TEST_ASSERT(vtkm::cont::ConcurrentHashTable::GetNumberOfBitsForIds(256) == 8);
+  VTKM_TEST_ASSERT(vtkm::cont::ConcurrentHashTable::GetNumberOfBitsForIds(257) == 9);
+}
+
+void Run()
+{
+  TestInsertAndFind();
+  TestNumberOfBitsForIds();
+}
+
+} // anonymous namespace
+
+int UnitTestConcurrentHashTable(int argc, char* argv[])
+{
+  return vtkm::cont::testing::Testing::Run(Run, argc, argv);
+}
@@ -16,6 +16,7 @@
 
 #include <vtkm/worklet/WorkletMapField.h>
 
+#include <algorithm>
 #include <random>
 
 namespace
@@ -181,9 +182,108 @@ void TestTest()
   VTKM_TEST_ASSERT(passTest, "Uniform Grid NN search result incorrect.");
 }
 
+void TestKNearestAndRadius()
+{
+  std::cout << "Testing k nearest neighbors and radius searches" << std::endl;
+
+  std::default_random_engine dre;
+  std::uniform_real_distribution<vtkm::FloatDefault> dr(0.0f, 10.0f);
+
+  std::vector<vtkm::Vec3f> coordi;
+  for (vtkm::Int32 i = 0; i < 500; i++)
+  {
+    coordi.push_back(vtkm::make_Vec(dr(dre), dr(dre), dr(dre)));
+  }
+  auto coordi_Handle = vtkm::cont::make_ArrayHandle(coordi, vtkm::CopyFlag::Off);
+
+  vtkm::cont::PointLocatorSparseGrid locator;
+  locator.SetCoordinates(vtkm::cont::CoordinateSystem("points", coordi_Handle));
+  locator.SetRange({ { 0.0, 10.0 } });
+  locator.SetNumberOfBins({ 8, 8, 8 });
+
+  // Include a query point outside of the locator range.
+  std::vector<vtkm::Vec3f> qcVec;
+  for (vtkm::Int32 i = 0; i < 50; i++)
+  {
+    qcVec.push_back(vtkm::make_Vec(dr(dre), dr(dre), dr(dre)));
+  }
+  qcVec.push_back(vtkm::make_Vec(12.0f, -1.0f, 5.0f));
+  auto qc_Handle = vtkm::cont::make_ArrayHandle(qcVec, vtkm::CopyFlag::Off);
+
+  const vtkm::Id k = 7;
+  vtkm::cont::ArrayHandle<vtkm::Id> knnIds;
+  vtkm::cont::ArrayHandle<vtkm::FloatDefault> knnDist2;
+  locator.FindKNearestNeighbors(qc_Handle, k, knnIds, knnDist2);
+
+  const vtkm::FloatDefault radius = 1.5f;
+  vtkm::cont::ArrayHandle<vtkm::Id> offsets, radiusIds;
+  locator.FindPointsWithinRadius(qc_Handle, radius, offsets, radiusIds);
+
+  VTKM_TEST_ASSERT(knnIds.GetNumberOfValues() == k * qc_Handle.GetNumberOfValues());
+  VTKM_TEST_ASSERT(offsets.GetNumberOfValues() == qc_Handle.GetNumberOfValues() + 1);
+
+  auto knnIdPortal = knnIds.ReadPortal();
+  auto knnDist2Portal = knnDist2.ReadPortal();
+  auto offsetsPortal = offsets.ReadPortal();
+  auto radiusIdPortal = radiusIds.ReadPortal();
+  for (std::size_t q = 0; q < qcVec.size(); q++)
+  {
+    // brute force
+    std::vector<std::pair<vtkm::FloatDefault, vtkm::Id>> all;
+    for (std::size_t i = 0; i < coordi.size(); i++)
+    {
+      all.emplace_back(vtkm::MagnitudeSquared(coordi[i] - qcVec[q]), static_cast<vtkm::Id>(i));
+    }
+    std::sort(all.begin(), all.end());
+
+    vtkm::Id qIdx = static_cast<vtkm::Id>(q);
+    for (vtkm::Id i = 0; i < k; i++)
+    {
+      vtkm::Id idx = qIdx * k + i;
+      VTKM_TEST_ASSERT(test_equal(knnDist2Portal.Get(idx), all[static_cast<std::size_t>(i)].first),
+                       "Wrong k nearest neighbor distance");
+      VTKM_TEST_ASSERT(knnIdPortal.Get(idx) == all[static_cast<std::size_t>(i)].second,
+                       "Wrong k nearest neighbor id");
+    }
+
+    std::vector<vtkm::Id> expected;
+    for (const auto& p : all)
+    {
+      if (p.first <= radius * radius)
+      {
+        expected.push_back(p.second);
+      }
+    }
+    std::vector<vtkm::Id> found;
+    for (vtkm::Id i = offsetsPortal.Get(qIdx); i < offsetsPortal.Get(qIdx + 1); i++)
+    {
+      found.push_back(radiusIdPortal.Get(i));
+    }
+    std::sort(expected.begin(), expected.end());
+    std::sort(found.begin(), found.end());
+    VTKM_TEST_ASSERT(found == expected, "Wrong points within radius");
+  }
+
+  // Asking for more neighbors than there are points pads the result.
+  vtkm::cont::ArrayHandle<vtkm::Id> padIds;
+  vtkm::cont::ArrayHandle<vtkm::FloatDefault> padDist2;
+  const vtkm::Id bigK = static_cast<vtkm::Id>(coordi.size()) + 2;
+  locator.FindKNearestNeighbors(qc_Handle, bigK, padIds, padDist2);
+  auto padIdPortal = padIds.ReadPortal();
+  VTKM_TEST_ASSERT(padIdPortal.Get(bigK - 3) != -1, "Missing neighbor");
+  VTKM_TEST_ASSERT(padIdPortal.Get(bigK - 2) == -1, "Missing padding");
+  VTKM_TEST_ASSERT(padIdPortal.Get(bigK - 1) == -1, "Missing padding");
+}
+
+void TestAll()
+{
+  TestTest();
+  TestKNearestAndRadius();
+}
+
 } // anonymous namespace
 
 int UnitTestPointLocatorSparseGrid(int argc, char* argv[])
 {
-  return vtkm::cont::testing::Testing::Run(TestTest, argc, argv);
+  return vtkm::cont::testing::Testing::Run(TestAll, argc, argv);
 }
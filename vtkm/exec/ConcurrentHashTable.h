@@ -0,0 +1,105 @@
+//============================================================================
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//============================================================================
+#ifndef vtk_m_exec_ConcurrentHashTable_h
+#define vtk_m_exec_ConcurrentHashTable_h
+
+#include <vtkm/Types.h>
+#include <vtkm/exec/AtomicArrayExecutionObject.h>
+
+namespace vtkm
+{
+namespace exec
+{
+
+/// \brief Execution side of `vtkm::cont::ConcurrentHashTable`.
+///
+/// Keys are inserted with an atomic compare-exchange into an open-addressing table with
+/// linear probing, so any number of threads can insert concurrently. A key lives in the
+/// same slot for the lifetime of the table, which makes the slot index a handle to the key.
+///
+class ConcurrentHashTable
+{
+public:
+  /// The value marking an unused slot. It cannot be inserted as a key.
+  VTKM_EXEC_CONT static constexpr vtkm::UInt64 EmptyKey() { return ~vtkm::UInt64(0); }
+
+  ConcurrentHashTable() = default;
+
+  VTKM_CONT ConcurrentHashTable(const vtkm::cont::ArrayHandle<vtkm::UInt64>& slots,
+                                vtkm::cont::DeviceAdapterId device,
+                                vtkm::cont::Token& token)
+    : Slots(slots, device, token)
+    , Mask(slots.GetNumberOfValues() - 1)
+  {
+  }
+
+  /// \brief Inserts `key` if it is not in the table yet.
+  ///
+  /// Returns the slot holding `key`, whether it was inserted by this call or before.
+  /// Returns -1 if the table is full.
+  ///
+  VTKM_EXEC vtkm::Id InsertOrGet(vtkm::UInt64 key) const
+  {
+    vtkm::Id slot = static_cast<vtkm::Id>(Hash(key)) & this->Mask;
+    for (vtkm::Id probe = 0; probe <= this->Mask; ++probe)
+    {
+      vtkm::UInt64 current = EmptyKey();
+      if (this->Slots.CompareExchange(slot, &current, key) || (current == key))
+      {
+        return slot;
+      }
+      slot = (slot + 1) & this->Mask;
+    }
+    return -1;
+  }
+
+  /// \brief Returns the slot holding `key`, or -1 if `key` is not in the table.
+  VTKM_EXEC vtkm::Id Find(vtkm::UInt64 key) const
+  {
+    vtkm::Id slot = static_cast<vtkm::Id>(Hash(key)) & this->Mask;
+    for (vtkm::Id probe = 0; probe <= this->Mask; ++probe)
+    {
+      const vtkm::UInt64 current = this->Slots.Get(slot);
+      if (current == key)
+      {
+        return slot;
+      }
+      if (current == EmptyKey())
+      {
+        return -1;
+      }
+      slot = (slot + 1) & this->Mask;
+    }
+    return -1;
+  }
+
+  VTKM_EXEC_CONT vtkm::Id GetCapacity() const { return this->Mask + 1; }
+
+private:
+  // Finalizer of MurmurHash3. Packed keys have most of their entropy in the low bits of
+  // each field, so the bits need to be mixed before masking.
+  VTKM_EXEC_CONT static vtkm::UInt64 Hash(vtkm::UInt64 key)
+  {
+    key ^= key >> 33;
+    key *= 0xff51afd7ed558ccdULL;
+    key ^= key >> 33;
+    key *= 0xc4ceb9fe1a85ec53ULL;
+    key ^= key >> 33;
+    return key;
+  }
+
+  vtkm::exec::AtomicArrayExecutionObject<vtkm::UInt64> Slots;
+  vtkm::Id Mask = -1;
+};
+
+}
+} // namespace vtkm::exec
+
+#endif //vtk_m_exec_ConcurrentHashTable_h
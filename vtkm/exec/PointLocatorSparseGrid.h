@@ -83,6 +83,91 @@ public:
     this->FindInBox(queryPoint, ijk, level, nearestNeighborId, distance2);
   }
 
+  /// \brief k nearest neighbor search using a Uniform Grid
+  ///
+  /// Finds the \c k points closest to \c queryPoint. \c neighborIds and \c distances2 must be
+  /// indexable with at least \c k entries; on return they hold the ids and squared distances of
+  /// the neighbors sorted by increasing distance. Unlike `FindNearestNeighbor`, the search only
+  /// stops once no bin left unvisited can contain a closer point, so the result is exact.
+  ///
+  /// \returns The number of neighbors found. This is less than \c k only when the locator
+  ///          holds fewer than \c k points.
+  template <typename IdVecType, typename DistanceVecType>
+  VTKM_EXEC vtkm::Id FindKNearestNeighbors(const vtkm::Vec3f& queryPoint,
+                                           vtkm::Id k,
+                                           IdVecType& neighborIds,
+                                           DistanceVecType& distances2) const
+  {
+    vtkm::Id numFound = 0;
+    if (k <= 0)
+    {
+      return numFound;
+    }
+
+    vtkm::Id3 center = this->FindBin(queryPoint);
+    vtkm::Id maxLevel = vtkm::Max(vtkm::Max(this->Dims[0], this->Dims[1]), this->Dims[2]);
+    for (vtkm::Id level = 0; level < maxLevel; ++level)
+    {
+      KNearestVisitor<IdVecType, DistanceVecType> visitor(k, numFound, neighborIds, distances2);
+      this->VisitShell(center, level, queryPoint, visitor);
+
+      if (numFound == k)
+      {
+        // Every point not visited yet lies outside the box of bins within `level` of the
+        // center, so it is at least as far away as the closest interior face of that box.
+        vtkm::FloatDefault margin = vtkm::Infinity<vtkm::FloatDefault>();
+        for (vtkm::IdComponent dim = 0; dim < 3; ++dim)
+        {
+          if ((center[dim] - level) > 0)
+          {
+            vtkm::FloatDefault lower = this->Min[dim] +
+              static_cast<vtkm::FloatDefault>(center[dim] - level) * this->Dxdydz[dim];
+            margin = vtkm::Min(margin, queryPoint[dim] - lower);
+          }
+          if ((center[dim] + level) < (this->Dims[dim] - 1))
+          {
+            vtkm::FloatDefault upper = this->Min[dim] +
+              static_cast<vtkm::FloatDefault>(center[dim] + level + 1) * this->Dxdydz[dim];
+            margin = vtkm::Min(margin, upper - queryPoint[dim]);
+          }
+        }
+        if ((margin >= vtkm::Infinity<vtkm::FloatDefault>()) ||
+            ((margin * margin) >= distances2[static_cast<vtkm::IdComponent>(k - 1)]))
+        {
+          break;
+        }
+      }
+    }
+    return numFound;
+  }
+
+  /// \brief Count the points within \c radius of \c queryPoint.
+  ///
+  /// Used together with `FindPointsWithinRadius` to size the output of a radius search.
+  VTKM_EXEC vtkm::Id CountPointsWithinRadius(const vtkm::Vec3f& queryPoint,
+                                             vtkm::FloatDefault radius) const
+  {
+    RadiusCountVisitor visitor;
+    this->VisitBinsWithinRadius(queryPoint, radius, visitor);
+    return visitor.Count;
+  }
+
+  /// \brief Find the points within \c radius of \c queryPoint.
+  ///
+  /// The ids of the points are written to \c neighborIds, which must be indexable with as many
+  /// entries as returned by `CountPointsWithinRadius`. The points are not sorted by distance.
+  ///
+  /// \returns The number of points found.
+  template <typename IdVecType>
+  VTKM_EXEC vtkm::Id FindPointsWithinRadius(const vtkm::Vec3f& queryPoint,
+                                            vtkm::FloatDefault radius,
+                                            IdVecType& neighborIds) const
+  {
+    RadiusFillVisitor<IdVecType> visitor(neighborIds);
+    this->VisitBinsWithinRadius(queryPoint, radius, visitor);
+    return visitor.Count;
+  }
+
   VTKM_DEPRECATED(1.6, "Locators are no longer pointers. Use . operator.")
   VTKM_EXEC PointLocatorSparseGrid* operator->() { return this; }
   VTKM_DEPRECATED(1.6, "Locators are no longer pointers. Use . operator.")
@@ -99,6 +184,164 @@ private:
   IdPortalType CellLower;
   IdPortalType CellUpper;
 
+  template <typename IdVecType, typename DistanceVecType>
+  struct KNearestVisitor
+  {
+    vtkm::Id K;
+    vtkm::Id& NumFound;
+    IdVecType& Ids;
+    DistanceVecType& Distances2;
+
+    VTKM_EXEC KNearestVisitor(vtkm::Id k,
+                              vtkm::Id& numFound,
+                              IdVecType& ids,
+                              DistanceVecType& distances2)
+      : K(k)
+      , NumFound(numFound)
+      , Ids(ids)
+      , Distances2(distances2)
+    {
+    }
+
+    VTKM_EXEC void operator()(vtkm::Id pointId, vtkm::FloatDefault distance2)
+    {
+      // The neighbors are held in Vecs, which are indexed with IdComponent.
+      const vtkm::IdComponent last = static_cast<vtkm::IdComponent>(this->K - 1);
+      if ((this->NumFound == this->K) && (distance2 >= this->Distances2[last]))
+      {
+        return;
+      }
+
+      // Insertion into the list sorted by increasing distance.
+      vtkm::IdComponent pos =
+        (this->NumFound < this->K) ? static_cast<vtkm::IdComponent>(this->NumFound++) : last;
+      while ((pos > 0) && (this->Distances2[pos - 1] > distance2))
+      {
+        vtkm::Id prevId = this->Ids[pos - 1];
+        vtkm::FloatDefault prevDistance2 = this->Distances2[pos - 1];
+        this->Ids[pos] = prevId;
+        this->Distances2[pos] = prevDistance2;
+        --pos;
+      }
+      this->Ids[pos] = pointId;
+      this->Distances2[pos] = distance2;
+    }
+  };
+
+  struct RadiusCountVisitor
+  {
+    vtkm::Id Count = 0;
+
+    VTKM_EXEC void operator()(vtkm::Id) { ++this->Count; }
+  };
+
+  template <typename IdVecType>
+  struct RadiusFillVisitor
+  {
+    IdVecType& Ids;
+    vtkm::Id Count = 0;
+
+    VTKM_EXEC RadiusFillVisitor(IdVecType& ids)
+      : Ids(ids)
+    {
+    }
+
+    VTKM_EXEC void operator()(vtkm::Id pointId)
+    {
+      this->Ids[static_cast<vtkm::IdComponent>(this->Count)] = pointId;
+      ++this->Count;
+    }
+  };
+
+  VTKM_EXEC vtkm::Id3 FindBin(const vtkm::Vec3f& point) const
+  {
+    // Clamp before converting so that points far outside the grid do not overflow.
+    vtkm::Vec3f bin = (point - this->Min) / this->Dxdydz;
+    vtkm::Id3 ijk;
+    for (vtkm::IdComponent dim = 0; dim < 3; ++dim)
+    {
+      vtkm::FloatDefault maxBin = static_cast<vtkm::FloatDefault>(this->Dims[dim] - 1);
+      ijk[dim] =
+        static_cast<vtkm::Id>(vtkm::Min(vtkm::Max(bin[dim], vtkm::FloatDefault(0)), maxBin));
+    }
+    return ijk;
+  }
+
+  template <typename Visitor>
+  VTKM_EXEC void VisitPointsInCell(const vtkm::Vec3f& queryPoint,
+                                   const vtkm::Id3& ijk,
+                                   Visitor& visitor) const
+  {
+    vtkm::Id cellId = ijk[0] + (ijk[1] * this->Dims[0]) + (ijk[2] * this->Dims[0] * this->Dims[1]);
+    vtkm::Id lower = this->CellLower.Get(cellId);
+    vtkm::Id upper = this->CellUpper.Get(cellId);
+    for (vtkm::Id index = lower; index < upper; index++)
+    {
+      vtkm::Id pointid = this->PointIds.Get(index);
+      vtkm::Vec3f point = this->Coords.Get(pointid);
+      visitor(pointid, vtkm::MagnitudeSquared(point - queryPoint));
+    }
+  }
+
+  // Visit the bins whose Chebyshev distance to `center` is exactly `level`.
+  template <typename Visitor>
+  VTKM_EXEC void VisitShell(const vtkm::Id3& center,
+                            vtkm::Id level,
+                            const vtkm::Vec3f& queryPoint,
+                            Visitor& visitor) const
+  {
+    vtkm::Id3 lower = vtkm::Max(center - vtkm::Id3(level), vtkm::Id3(0));
+    vtkm::Id3 upper = vtkm::Min(center + vtkm::Id3(level), this->Dims - vtkm::Id3(1));
+    for (vtkm::Id k = lower[2]; k <= upper[2]; ++k)
+    {
+      bool kOnShell = (vtkm::Abs(k - center[2]) == level);
+      for (vtkm::Id j = lower[1]; j <= upper[1]; ++j)
+      {
+        bool jOnShell = kOnShell || (vtkm::Abs(j - center[1]) == level);
+        // Off the y/z faces of the shell only the two x faces need to be visited.
+        vtkm::Id iStep = (jOnShell || (level == 0)) ? 1 : 2 * level;
+        for (vtkm::Id i = center[0] - level; i <= center[0] + level; i += iStep)
+        {
+          if ((i >= 0) && (i < this->Dims[0]))
+          {
+            this->VisitPointsInCell(queryPoint, vtkm::Id3(i, j, k), visitor);
+          }
+        }
+      }
+    }
+  }
+
+  template <typename Visitor>
+  VTKM_EXEC void VisitBinsWithinRadius(const vtkm::Vec3f& queryPoint,
+                                       vtkm::FloatDefault radius,
+                                       Visitor& visitor) const
+  {
+    vtkm::FloatDefault radius2 = radius * radius;
+    vtkm::Id3 lower = this->FindBin(queryPoint - vtkm::Vec3f(radius));
+    vtkm::Id3 upper = this->FindBin(queryPoint + vtkm::Vec3f(radius));
+    for (vtkm::Id k = lower[2]; k <= upper[2]; ++k)
+    {
+      for (vtkm::Id j = lower[1]; j <= upper[1]; ++j)
+      {
+        for (vtkm::Id i = lower[0]; i <= upper[0]; ++i)
+        {
+          vtkm::Id cellId = i + (j * this->Dims[0]) + (k * this->Dims[0] * this->Dims[1]);
+          vtkm::Id cellLower = this->CellLower.Get(cellId);
+          vtkm::Id cellUpper = this->CellUpper.Get(cellId);
+          for (vtkm::Id index = cellLower; index < cellUpper; index++)
+          {
+            vtkm::Id pointid = this->PointIds.Get(index);
+            vtkm::Vec3f point = this->Coords.Get(pointid);
+            if (vtkm::MagnitudeSquared(point - queryPoint) <= radius2)
+            {
+              visitor(pointid);
+            }
+          }
+        }
+      }
+    }
+  }
+
   VTKM_EXEC void FindInCell(const vtkm::Vec3f& queryPoint,
                             const vtkm::Id3& ijk,
                             vtkm::Id& nearestNeighborId,
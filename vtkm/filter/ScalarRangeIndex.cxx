@@ -0,0 +1,592 @@
+//============================================================================
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//============================================================================
+
+#include <vtkm/filter/ScalarRangeIndex.h>
+
+#include <vtkm/TypeList.h>
+#include <vtkm/cont/Algorithm.h>
+#include <vtkm/cont/ArrayCopy.h>
+#include <vtkm/cont/ArrayCopyDevice.h>
+#include <vtkm/cont/ArrayGetValues.h>
+#include <vtkm/cont/ArrayHandleCounting.h>
+#include <vtkm/cont/ArrayHandleIndex.h>
+#include <vtkm/cont/ArrayHandlePermutation.h>
+#include <vtkm/cont/DefaultTypes.h>
+#include <vtkm/cont/ErrorBadType.h>
+#include <vtkm/cont/ErrorBadValue.h>
+#include <vtkm/cont/Invoker.h>
+#include <vtkm/cont/Logging.h>
+#include <vtkm/worklet/WorkletMapField.h>
+#include <vtkm/worklet/WorkletMapTopology.h>
+
+namespace
+{
+
+struct CellRangeFromPoints : vtkm::worklet::WorkletVisitCellsWithPoints
+{
+  using ControlSignature = void(CellSetIn cellSet, FieldInPoint values, FieldOutCell range);
+  using ExecutionSignature = void(_2, _3);
+
+  template <typename ValuesVecType>
+  VTKM_EXEC void operator()(const ValuesVecType& values, vtkm::Range& range) const
+  {
+    range = vtkm::Range{};
+    for (vtkm::IdComponent i = 0; i < values.GetNumberOfComponents(); ++i)
+    {
+      range.Include(values[i]);
+    }
+  }
+};
+
+// Reduces the values (or ranges) of the cells of each brick.
+struct BrickRange : vtkm::worklet::WorkletMapField
+{
+  using ControlSignature = void(FieldIn brick, WholeArrayIn cellValues, FieldOut range);
+  using ExecutionSignature = void(_1, _2, _3);
+
+  VTKM_CONT explicit BrickRange(vtkm::Id brickSize)
+    : BrickSize(brickSize)
+  {
+  }
+
+  template <typename PortalType>
+  VTKM_EXEC void operator()(vtkm::Id brick,
+                            const PortalType& cellValues,
+                            vtkm::Range& range) const
+  {
+    range = vtkm::Range{};
+    const vtkm::Id end = vtkm::Min((brick + 1) * this->BrickSize, cellValues.GetNumberOfValues());
+    for (vtkm::Id cell = brick * this->BrickSize; cell < end; ++cell)
+    {
+      range.Include(cellValues.Get(cell));
+    }
+  }
+
+  vtkm::Id BrickSize;
+};
+
+struct BrickIntersects : vtkm::worklet::WorkletMapField
+{
+  using ControlSignature = void(FieldIn range, WholeArrayIn queries, FieldOut intersects);
+  using ExecutionSignature = void(_1, _2, _3);
+
+  template <typename PortalType>
+  VTKM_EXEC void operator()(const vtkm::Range& range,
+                            const PortalType& queries,
+                            bool& intersects) const
+  {
+    intersects = false;
+    for (vtkm::Id i = 0; !intersects && (i < queries.GetNumberOfValues()); ++i)
+    {
+      intersects = range.Intersection(queries.Get(i)).IsNonEmpty();
+    }
+  }
+};
+
+// Lists the cells of the selected bricks. All bricks but the last one are full.
+struct ExpandBricks : vtkm::worklet::WorkletMapField
+{
+  using ControlSignature = void(FieldIn index, WholeArrayIn bricks, FieldOut cell);
+  using ExecutionSignature = void(_1, _2, _3);
+
+  VTKM_CONT explicit ExpandBricks(vtkm::Id brickSize)
+    : BrickSize(brickSize)
+  {
+  }
+
+  template <typename PortalType>
+  VTKM_EXEC void operator()(vtkm::Id index, const PortalType& bricks, vtkm::Id& cell) const
+  {
+    cell = bricks.Get(index / this->BrickSize) * this->BrickSize + index % this->BrickSize;
+  }
+
+  vtkm::Id BrickSize;
+};
+
+struct ValueToRange : vtkm::worklet::WorkletMapField
+{
+  using ControlSignature = void(FieldIn value, FieldOut range);
+  using ExecutionSignature = void(_1, _2);
+
+  template <typename T>
+  VTKM_EXEC void operator()(const T& value, vtkm::Range& range) const
+  {
+    range = vtkm::Range{};
+    range.Include(value);
+  }
+};
+
+// Maps a value to one of `Resolution` bins that evenly split the range of the field.
+struct SpanSpaceBinning
+{
+  vtkm::Float64 Min = 0;
+  vtkm::Float64 Scale = 0;
+  vtkm::Id Resolution = 1;
+
+  VTKM_EXEC_CONT vtkm::Id Bin(vtkm::Float64 value) const
+  {
+    const vtkm::Float64 bin = (value - this->Min) * this->Scale;
+    if (!(bin >= 1))
+    {
+      return 0;
+    }
+    if (bin >= static_cast<vtkm::Float64>(this->Resolution - 1))
+    {
+      return this->Resolution - 1;
+    }
+    return static_cast<vtkm::Id>(bin);
+  }
+};
+
+SpanSpaceBinning MakeBinning(const vtkm::Range& fieldRange, vtkm::Id resolution)
+{
+  SpanSpaceBinning binning;
+  binning.Resolution = resolution;
+  if (fieldRange.IsNonEmpty())
+  {
+    binning.Min = fieldRange.Min;
+    if (fieldRange.Length() > 0)
+    {
+      binning.Scale = static_cast<vtkm::Float64>(resolution) / fieldRange.Length();
+    }
+  }
+  return binning;
+}
+
+// Bins are ordered by minimum, then maximum. Cells with an empty range go past the last bin.
+struct SpanSpaceKey : vtkm::worklet::WorkletMapField
+{
+  using ControlSignature = void(FieldIn range, FieldOut key);
+  using ExecutionSignature = void(_1, _2);
+
+  VTKM_CONT explicit SpanSpaceKey(const SpanSpaceBinning& binning)
+    : Binning(binning)
+  {
+  }
+
+  VTKM_EXEC void operator()(const vtkm::Range& range, vtkm::Id& key) const
+  {
+    const vtkm::Id resolution = this->Binning.Resolution;
+    key = range.IsNonEmpty()
+      ? this->Binning.Bin(range.Min) * resolution + this->Binning.Bin(range.Max)
+      : resolution * resolution;
+  }
+
+  SpanSpaceBinning Binning;
+};
+
+// Tests the cells of the bins selected by a query. The bins are given as segments of the
+// sorted cells, and `segmentOutputStarts` is where each segment starts in the output.
+struct SpanSpaceCandidates : vtkm::worklet::WorkletMapField
+{
+  using ControlSignature = void(FieldIn index,
+                                WholeArrayIn segmentOutputStarts,
+                                WholeArrayIn segmentStarts,
+                                WholeArrayIn cellIds,
+                                WholeArrayIn cellRanges,
+                                WholeArrayIn queries,
+                                FieldOut cellId,
+                                FieldOut intersects);
+  using ExecutionSignature = void(_1, _2, _3, _4, _5, _6, _7, _8);
+
+  template <typename IdPortal, typename RangePortal>
+  VTKM_EXEC void operator()(vtkm::Id index,
+                            const IdPortal& segmentOutputStarts,
+                            const IdPortal& segmentStarts,
+                            const IdPortal& cellIds,
+                            const RangePortal& cellRanges,
+                            const RangePortal& queries,
+                            vtkm::Id& cellId,
+                            bool& intersects) const
+  {
+    // Last segment starting at or before index.
+    vtkm::Id low = 0;
+    vtkm::Id high = segmentOutputStarts.GetNumberOfValues() - 1;
+    while (low < high)
+    {
+      const vtkm::Id mid = (low + high + 1) / 2;
+      if (segmentOutputStarts.Get(mid) <= index)
+      {
+        low = mid;
+      }
+      else
+      {
+        high = mid - 1;
+      }
+    }
+    const vtkm::Id sorted = segmentStarts.Get(low) + index - segmentOutputStarts.Get(low);
+
+    cellId = cellIds.Get(sorted);
+    const vtkm::Range range = cellRanges.Get(sorted);
+    intersects = false;
+    for (vtkm::Id i = 0; !intersects && (i < queries.GetNumberOfValues()); ++i)
+    {
+      intersects = range.Intersection(queries.Get(i)).IsNonEmpty();
+    }
+  }
+};
+
+// Returns false if the arrays of the field cannot be identified, in which case the index is
+// rebuilt every time.
+bool GetFieldBuffers(const vtkm::cont::Field& field,
+                     std::vector<vtkm::cont::internal::Buffer>& buffers)
+{
+  buffers.clear();
+  try
+  {
+    field.GetData().CastAndCallForTypes<vtkm::TypeListScalarAll, VTKM_DEFAULT_STORAGE_LIST>(
+      [&](const auto& array) { buffers = array.GetBuffers(); });
+  }
+  catch (vtkm::cont::ErrorBadType&)
+  {
+    return false;
+  }
+  return true;
+}
+
+} // anonymous namespace
+
+namespace vtkm
+{
+namespace filter
+{
+
+struct ScalarRangeIndex::StampType
+{
+  // Holding the cell set keeps its address from being reused by another object.
+  vtkm::cont::UnknownCellSet CellSet;
+  std::string FieldName;
+  vtkm::cont::Field::Association FieldAssociation;
+  std::vector<vtkm::cont::internal::Buffer> Buffers;
+  std::vector<vtkm::UInt64> ModifiedCounts;
+};
+
+ScalarRangeIndex::ScalarRangeIndex() = default;
+
+ScalarRangeIndex::~ScalarRangeIndex() = default;
+
+void ScalarRangeIndex::SetBrickSize(vtkm::Id size)
+{
+  if (size < 1)
+  {
+    throw vtkm::cont::ErrorBadValue("The brick size of a ScalarRangeIndex must be positive.");
+  }
+  if (size != this->BrickSize)
+  {
+    this->BrickSize = size;
+    this->Clear();
+  }
+}
+
+void ScalarRangeIndex::SetMethod(Method method)
+{
+  if (method != this->IndexMethod)
+  {
+    this->IndexMethod = method;
+    this->Clear();
+  }
+}
+
+void ScalarRangeIndex::SetSpanSpaceResolution(vtkm::Id resolution)
+{
+  if (resolution < 1)
+  {
+    throw vtkm::cont::ErrorBadValue("The span space resolution must be positive.");
+  }
+  if (resolution != this->SpanSpaceResolution)
+  {
+    this->SpanSpaceResolution = resolution;
+    this->Clear();
+  }
+}
+
+void ScalarRangeIndex::Clear()
+{
+  this->NumberOfCells = 0;
+  this->BrickRanges.ReleaseResources();
+  this->FieldRange = vtkm::Range{};
+  this->SpanCellIds.ReleaseResources();
+  this->SpanCellRanges.ReleaseResources();
+  this->SpanBinOffsets.ReleaseResources();
+  this->Stamp.reset();
+}
+
+void ScalarRangeIndex::Build(const vtkm::cont::UnknownCellSet& cellSet,
+                             const vtkm::cont::Field& field)
+{
+  VTKM_LOG_SCOPE(vtkm::cont::LogLevel::Perf, "ScalarRangeIndex::Build %s", field.GetName().c_str());
+  this->Clear();
+
+  const vtkm::Id numberOfCells = cellSet.GetNumberOfCells();
+  const vtkm::Id numberOfBricks = (numberOfCells + this->BrickSize - 1) / this->BrickSize;
+  vtkm::cont::Invoker invoke;
+  vtkm::cont::ArrayHandle<vtkm::Range> cellRanges;
+
+  if (field.IsFieldPoint())
+  {
+    if (field.GetNumberOfValues() != cellSet.GetNumberOfPoints())
+    {
+      throw vtkm::cont::ErrorBadValue("Point field " + field.GetName() +
+                                      " does not match the cell set.");
+    }
+    auto resolveType = [&](const auto& values) {
+      cellSet.CastAndCallForTypes<VTKM_DEFAULT_CELL_SET_LIST>(
+        [&](const auto& cells) { invoke(CellRangeFromPoints{}, cells, values, cellRanges); });
+    };
+    field.GetData()
+      .CastAndCallForTypesWithFloatFallback<vtkm::TypeListFieldScalar, VTKM_DEFAULT_STORAGE_LIST>(
+        resolveType);
+  }
+  else if (field.IsFieldCell())
+  {
+    if (field.GetNumberOfValues() != numberOfCells)
+    {
+      throw vtkm::cont::ErrorBadValue("Cell field " + field.GetName() +
+                                      " does not match the cell set.");
+    }
+    auto resolveType = [&](const auto& values) {
+      if (this->IndexMethod == Method::Bricks)
+      {
+        // Go straight from the values to the bricks.
+        invoke(BrickRange(this->BrickSize),
+               vtkm::cont::ArrayHandleIndex(numberOfBricks),
+               values,
+               this->BrickRanges);
+      }
+      else
+      {
+        invoke(ValueToRange{}, values, cellRanges);
+      }
+    };
+    field.GetData()
+      .CastAndCallForTypesWithFloatFallback<vtkm::TypeListFieldScalar, VTKM_DEFAULT_STORAGE_LIST>(
+        resolveType);
+  }
+  else
+  {
+    throw vtkm::cont::ErrorBadValue("ScalarRangeIndex expects a point or cell field.");
+  }
+  this->NumberOfCells = numberOfCells;
+
+  if (this->IndexMethod == Method::SpanSpace)
+  {
+    this->BuildSpanSpace(cellRanges);
+  }
+  else if (field.IsFieldPoint())
+  {
+    invoke(BrickRange(this->BrickSize),
+           vtkm::cont::ArrayHandleIndex(numberOfBricks),
+           cellRanges,
+           this->BrickRanges);
+  }
+
+  std::unique_ptr<StampType> stamp(new StampType);
+  if (GetFieldBuffers(field, stamp->Buffers))
+  {
+    stamp->CellSet = cellSet;
+    stamp->FieldName = field.GetName();
+    stamp->FieldAssociation = field.GetAssociation();
+    for (const auto& buffer : stamp->Buffers)
+    {
+      stamp->ModifiedCounts.push_back(buffer.GetModifiedCount());
+    }
+    this->Stamp = std::move(stamp);
+  }
+}
+
+void ScalarRangeIndex::BuildSpanSpace(const vtkm::cont::ArrayHandle<vtkm::Range>& cellRanges)
+{
+  const vtkm::Id resolution = this->SpanSpaceResolution;
+  this->FieldRange = vtkm::cont::Algorithm::Reduce(cellRanges, vtkm::Range{});
+  vtkm::cont::Invoker invoke;
+
+  vtkm::cont::ArrayHandle<vtkm::Id> keys;
+  invoke(SpanSpaceKey(MakeBinning(this->FieldRange, resolution)), cellRanges, keys);
+  vtkm::cont::ArrayCopy(vtkm::cont::ArrayHandleIndex(this->NumberOfCells), this->SpanCellIds);
+  vtkm::cont::Algorithm::SortByKey(keys, this->SpanCellIds);
+  vtkm::cont::ArrayCopyDevice(
+    vtkm::cont::make_ArrayHandlePermutation(this->SpanCellIds, cellRanges), this->SpanCellRanges);
+  vtkm::cont::Algorithm::LowerBounds(
+    keys,
+    vtkm::cont::ArrayHandleCounting<vtkm::Id>(0, 1, resolution * resolution + 1),
+    this->SpanBinOffsets);
+}
+
+bool ScalarRangeIndex::Update(const vtkm::cont::UnknownCellSet& cellSet,
+                              const vtkm::cont::Field& field)
+{
+  if (this->IsBuiltFor(cellSet, field))
+  {
+    return false;
+  }
+  this->Build(cellSet, field);
+  return true;
+}
+
+bool ScalarRangeIndex::IsBuiltFor(const vtkm::cont::UnknownCellSet& cellSet,
+                                  const vtkm::cont::Field& field) const
+{
+  if (!this->Stamp || !cellSet.IsValid() ||
+      (cellSet.GetCellSetBase() != this->Stamp->CellSet.GetCellSetBase()) ||
+      (cellSet.GetNumberOfCells() != this->NumberOfCells) ||
+      (field.GetName() != this->Stamp->FieldName) ||
+      (field.GetAssociation() != this->Stamp->FieldAssociation))
+  {
+    return false;
+  }
+  std::vector<vtkm::cont::internal::Buffer> buffers;
+  if (!GetFieldBuffers(field, buffers) || (buffers.size() != this->Stamp->Buffers.size()))
+  {
+    return false;
+  }
+  for (std::size_t i = 0; i < buffers.size(); ++i)
+  {
+    if (!(buffers[i] == this->Stamp->Buffers[i]) ||
+        (buffers[i].GetModifiedCount() != this->Stamp->ModifiedCounts[i]))
+    {
+      return false;
+    }
+  }
+  return true;
+}
+
+vtkm::cont::ArrayHandle<vtkm::Id> ScalarRangeIndex::GetCellsInRange(vtkm::Float64 lower,
+                                                                    vtkm::Float64 upper) const
+{
+  return this->GetCells({ vtkm::Range(lower, upper) });
+}
+
+vtkm::cont::ArrayHandle<vtkm::Id> ScalarRangeIndex::GetCellsContaining(
+  const std::vector<vtkm::Float64>& values) const
+{
+  std::vector<vtkm::Range> queries;
+  for (vtkm::Float64 value : values)
+  {
+    queries.emplace_back(value, value);
+  }
+  return this->GetCells(queries);
+}
+
+vtkm::cont::ArrayHandle<vtkm::Id> ScalarRangeIndex::GetCells(
+  const std::vector<vtkm::Range>& queries) const
+{
+  return (this->IndexMethod == Method::SpanSpace) ? this->GetSpanSpaceCells(queries)
+                                                  : this->GetBrickCells(queries);
+}
+
+vtkm::cont::ArrayHandle<vtkm::Id> ScalarRangeIndex::GetBrickCells(
+  const std::vector<vtkm::Range>& queries) const
+{
+  const vtkm::Id numberOfBricks = this->GetNumberOfBricks();
+  vtkm::cont::Invoker invoke;
+
+  vtkm::cont::ArrayHandle<bool> intersects;
+  invoke(BrickIntersects{},
+         this->BrickRanges,
+         vtkm::cont::make_ArrayHandle(queries, vtkm::CopyFlag::Off),
+         intersects);
+  vtkm::cont::ArrayHandle<vtkm::Id> bricks;
+  vtkm::cont::Algorithm::CopyIf(vtkm::cont::ArrayHandleIndex(numberOfBricks), intersects, bricks);
+
+  vtkm::cont::ArrayHandle<vtkm::Id> cells;
+  const vtkm::Id numberOfSelected = bricks.GetNumberOfValues();
+  if (numberOfSelected < 1)
+  {
+    return cells;
+  }
+  vtkm::Id numberOfCells = numberOfSelected * this->BrickSize;
+  if (vtkm::cont::ArrayGetValue(numberOfSelected - 1, bricks) == numberOfBricks - 1)
+  {
+    // The last brick of the mesh can be partial.
+    numberOfCells -= numberOfBricks * this->BrickSize - this->NumberOfCells;
+  }
+  invoke(
+    ExpandBricks(this->BrickSize), vtkm::cont::ArrayHandleIndex(numberOfCells), bricks, cells);
+
+  VTKM_LOG_S(vtkm::cont::LogLevel::Perf,
+             "ScalarRangeIndex selected " << numberOfSelected << " of " << numberOfBricks
+                                          << " bricks");
+  return cells;
+}
+
+vtkm::cont::ArrayHandle<vtkm::Id> ScalarRangeIndex::GetSpanSpaceCells(
+  const std::vector<vtkm::Range>& queries) const
+{
+  vtkm::cont::ArrayHandle<vtkm::Id> cells;
+  if (this->NumberOfCells < 1)
+  {
+    return cells;
+  }
+
+  // A cell intersects [lower, upper] if its minimum is at most upper and its maximum is at
+  // least lower. In the span space, these are the bins of the rows up to the bin of upper,
+  // from the column of the bin of lower on. Each row of bins is a contiguous segment of the
+  // sorted cells. Only the cells of the bins holding lower or upper can fail the test.
+  const vtkm::Id resolution = this->SpanSpaceResolution;
+  const SpanSpaceBinning binning = MakeBinning(this->FieldRange, resolution);
+  auto offsets = this->SpanBinOffsets.ReadPortal();
+  std::vector<vtkm::Id> segmentStarts;
+  std::vector<vtkm::Id> segmentOutputStarts;
+  vtkm::Id numberOfCandidates = 0;
+  for (const vtkm::Range& query : queries)
+  {
+    if (!this->FieldRange.Intersection(query).IsNonEmpty())
+    {
+      continue;
+    }
+    const vtkm::Id lowerBin = binning.Bin(query.Min);
+    const vtkm::Id upperBin = binning.Bin(query.Max);
+    for (vtkm::Id minBin = 0; minBin <= upperBin; ++minBin)
+    {
+      const vtkm::Id rowStart = minBin * resolution;
+      const vtkm::Id start = offsets.Get(rowStart + vtkm::Max(minBin, lowerBin));
+      const vtkm::Id end = offsets.Get(rowStart + resolution);
+      if (end > start)
+      {
+        segmentStarts.push_back(start);
+        segmentOutputStarts.push_back(numberOfCandidates);
+        numberOfCandidates += end - start;
+      }
+    }
+  }
+  if (numberOfCandidates < 1)
+  {
+    return cells;
+  }
+
+  vtkm::cont::Invoker invoke;
+  vtkm::cont::ArrayHandle<vtkm::Id> candidates;
+  vtkm::cont::ArrayHandle<bool> intersects;
+  invoke(SpanSpaceCandidates{},
+         vtkm::cont::ArrayHandleIndex(numberOfCandidates),
+         vtkm::cont::make_ArrayHandle(segmentOutputStarts, vtkm::CopyFlag::Off),
+         vtkm::cont::make_ArrayHandle(segmentStarts, vtkm::CopyFlag::Off),
+         this->SpanCellIds,
+         this->SpanCellRanges,
+         vtkm::cont::make_ArrayHandle(queries, vtkm::CopyFlag::Off),
+         candidates,
+         intersects);
+  vtkm::cont::Algorithm::CopyIf(candidates, intersects, cells);
+  vtkm::cont::Algorithm::Sort(cells);
+  if (queries.size() > 1)
+  {
+    // The bins of different queries can overlap.
+    vtkm::cont::Algorithm::Unique(cells);
+  }
+
+  VTKM_LOG_S(vtkm::cont::LogLevel::Perf,
+             "ScalarRangeIndex tested " << numberOfCandidates << " and selected "
+                                        << cells.GetNumberOfValues() << " of "
+                                        << this->NumberOfCells << " cells");
+  return cells;
+}
+
+}
+} // namespace vtkm::filter
@@ -0,0 +1,170 @@
+//============================================================================
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//============================================================================
+
+#ifndef vtk_m_filter_ScalarRangeIndex_h
+#define vtk_m_filter_ScalarRangeIndex_h
+
+#include <vtkm/Range.h>
+#include <vtkm/cont/ArrayHandle.h>
+#include <vtkm/cont/Field.h>
+#include <vtkm/cont/UnknownCellSet.h>
+
+#include <vtkm/filter/vtkm_filter_core_export.h>
+
+#include <memory>
+#include <vector>
+
+namespace vtkm
+{
+namespace filter
+{
+
+/// \brief Index of the range of a scalar field over the cells of a data set.
+///
+/// The cells of a data set are split into bricks of `GetBrickSize()` consecutive cell ids, and
+/// the index records the range of a scalar field over each brick. A query for a value (or a
+/// range of values) returns the cells of the bricks whose range contains it, so a filter that
+/// only produces output for such cells (a `Threshold` or a `Contour`) can skip the rest of the
+/// mesh. Building the index visits every cell once; a query only touches the bricks and the
+/// cells it returns.
+///
+/// The index is meant to be shared between filters and reused across executions, for example
+/// while interactively changing an iso-value or a threshold. `Update` only rebuilds the index
+/// when it is given a different cell set or field, or when the arrays of the field have been
+/// modified since the last build.
+///
+/// Point and cell fields are supported. For a point field, the range of a cell is the range of
+/// the values of its incident points.
+///
+/// With the `Method::SpanSpace` method, the index is instead a span space: the range of every
+/// cell is kept, and the cells are sorted into a grid of bins over (minimum, maximum). A query
+/// then only reads the bins on one side of the queried value and tests the cells they hold, so
+/// it returns exactly the cells whose range contains the value. This costs more memory and a
+/// sort to build, but it scales with the number of selected cells rather than the number of
+/// bricks, and it is not affected by how the cells are numbered. It is the better choice for
+/// large unstructured meshes.
+///
+class VTKM_FILTER_CORE_EXPORT ScalarRangeIndex
+{
+public:
+  /// The structure used to find the cells that contain a value.
+  enum class Method
+  {
+    /// Ranges of bricks of consecutive cells. Small, and tight when the cell ids follow space.
+    Bricks,
+    /// Ranges of all cells, sorted into a grid over (minimum, maximum).
+    SpanSpace
+  };
+
+  VTKM_CONT ScalarRangeIndex();
+  VTKM_CONT ~ScalarRangeIndex();
+
+  ScalarRangeIndex(const ScalarRangeIndex&) = delete;
+  ScalarRangeIndex& operator=(const ScalarRangeIndex&) = delete;
+
+  /// \brief The number of consecutive cells summarized by each brick.
+  ///
+  /// Smaller bricks give tighter queries but a larger index. Changing the brick size
+  /// invalidates the index. The default is 512.
+  ///
+  VTKM_CONT void SetBrickSize(vtkm::Id size);
+  VTKM_CONT vtkm::Id GetBrickSize() const { return this->BrickSize; }
+
+  /// \brief The structure of the index.
+  ///
+  /// Changing the method invalidates the index. The default is `Method::Bricks`.
+  ///
+  VTKM_CONT void SetMethod(Method method);
+  VTKM_CONT Method GetMethod() const { return this->IndexMethod; }
+
+  /// \brief The number of bins along each axis of the span space.
+  ///
+  /// Only used by `Method::SpanSpace`. More bins make the cells tested by a query closer to
+  /// the cells returned, at the cost of reading more bin offsets. Changing the resolution
+  /// invalidates the index. The default is 64.
+  ///
+  VTKM_CONT void SetSpanSpaceResolution(vtkm::Id resolution);
+  VTKM_CONT vtkm::Id GetSpanSpaceResolution() const { return this->SpanSpaceResolution; }
+
+  /// \brief Builds the index for `field` over the cells of `cellSet`.
+  VTKM_CONT void Build(const vtkm::cont::UnknownCellSet& cellSet, const vtkm::cont::Field& field);
+
+  /// \brief Builds the index unless it is already up to date for `field` over `cellSet`.
+  ///
+  /// Returns true if the index had to be (re)built.
+  ///
+  VTKM_CONT bool Update(const vtkm::cont::UnknownCellSet& cellSet, const vtkm::cont::Field& field);
+
+  /// \brief Returns true if the index was built for these arrays and they were not modified.
+  VTKM_CONT bool IsBuiltFor(const vtkm::cont::UnknownCellSet& cellSet,
+                            const vtkm::cont::Field& field) const;
+
+  /// \brief Removes the index and the references it holds to the data.
+  VTKM_CONT void Clear();
+
+  VTKM_CONT vtkm::Id GetNumberOfCells() const { return this->NumberOfCells; }
+  VTKM_CONT vtkm::Id GetNumberOfBricks() const { return this->BrickRanges.GetNumberOfValues(); }
+
+  /// \brief The range of the field over each brick.
+  ///
+  /// Empty unless the method is `Method::Bricks`.
+  ///
+  VTKM_CONT const vtkm::cont::ArrayHandle<vtkm::Range>& GetBrickRanges() const
+  {
+    return this->BrickRanges;
+  }
+
+  /// \brief The cells whose range may intersect [`lower`, `upper`].
+  ///
+  /// Every cell with a field value (or, for a point field, an incident point value) in the
+  /// closed interval is returned. With `Method::Bricks`, the other cells of its brick are
+  /// returned as well. The ids are sorted.
+  ///
+  VTKM_CONT vtkm::cont::ArrayHandle<vtkm::Id> GetCellsInRange(vtkm::Float64 lower,
+                                                              vtkm::Float64 upper) const;
+
+  /// \brief The cells whose range may contain any of `values`.
+  ///
+  /// This is a superset of the cells an isosurface through any of `values` passes through.
+  /// With `Method::SpanSpace`, only the cells whose range contains a value are returned. The
+  /// ids are sorted.
+  ///
+  VTKM_CONT vtkm::cont::ArrayHandle<vtkm::Id> GetCellsContaining(
+    const std::vector<vtkm::Float64>& values) const;
+
+private:
+  VTKM_CONT vtkm::cont::ArrayHandle<vtkm::Id> GetCells(
+    const std::vector<vtkm::Range>& queries) const;
+  VTKM_CONT vtkm::cont::ArrayHandle<vtkm::Id> GetBrickCells(
+    const std::vector<vtkm::Range>& queries) const;
+  VTKM_CONT vtkm::cont::ArrayHandle<vtkm::Id> GetSpanSpaceCells(
+    const std::vector<vtkm::Range>& queries) const;
+  VTKM_CONT void BuildSpanSpace(const vtkm::cont::ArrayHandle<vtkm::Range>& cellRanges);
+
+  struct StampType;
+
+  vtkm::Id BrickSize = 512;
+  Method IndexMethod = Method::Bricks;
+  vtkm::Id SpanSpaceResolution = 64;
+  vtkm::Id NumberOfCells = 0;
+  vtkm::cont::ArrayHandle<vtkm::Range> BrickRanges;
+
+  // Span space: the cells sorted by bin, their ranges and the start of each bin.
+  vtkm::Range FieldRange;
+  vtkm::cont::ArrayHandle<vtkm::Id> SpanCellIds;
+  vtkm::cont::ArrayHandle<vtkm::Range> SpanCellRanges;
+  vtkm::cont::ArrayHandle<vtkm::Id> SpanBinOffsets;
+  std::unique_ptr<StampType> Stamp;
+};
+
+}
+} // namespace vtkm::filter
+
+#endif //vtk_m_filter_ScalarRangeIndex_h
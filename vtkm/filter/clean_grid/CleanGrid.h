@@ -80,6 +80,16 @@ public:
   VTKM_CONT bool GetFastMerge() const { return this->FastMerge; }
   VTKM_CONT void SetFastMerge(bool flag) { this->FastMerge = flag; }
 
+  /// When MergePointsWithHashGrid is true, coincident points are found with a single pass over
+  /// a hash grid of the points and a parallel union-find instead of sorting the points by bin.
+  /// When FastMerge is false, this also replaces the 8 passes over shifted bins with a search
+  /// of the neighboring bins, and the tolerance is strictly followed: points are merged when
+  /// they are within the tolerance of each other or are connected through such points. Off by
+  /// default.
+  ///
+  VTKM_CONT bool GetMergePointsWithHashGrid() const { return this->MergePointsWithHashGrid; }
+  VTKM_CONT void SetMergePointsWithHashGrid(bool flag) { this->MergePointsWithHashGrid = flag; }
+
 private:
   VTKM_CONT
   vtkm::cont::DataSet DoExecute(const vtkm::cont::DataSet& inData) override;
@@ -94,6 +104,7 @@ private:
   bool ToleranceIsAbsolute = false;
   bool RemoveDegenerateCells = true;
   bool FastMerge = true;
+  bool MergePointsWithHashGrid = false;
 };
 } // namespace clean_grid
 
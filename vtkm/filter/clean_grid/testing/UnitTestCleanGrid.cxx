@@ -10,11 +10,15 @@
 
 #include <vtkm/filter/clean_grid/CleanGrid.h>
 
+#include <vtkm/VectorAnalysis.h>
 #include <vtkm/cont/ArrayCopy.h>
 #include <vtkm/cont/testing/MakeTestDataSet.h>
 #include <vtkm/cont/testing/Testing.h>
 #include <vtkm/filter/contour/Contour.h>
 
+#include <map>
+#include <set>
+
 namespace
 {
 
@@ -67,7 +71,8 @@ void TestUniformGrid(vtkm::filter::clean_grid::CleanGrid clean)
                    outCellField.ReadPortal().Get(0));
 }
 
-void TestPointMerging()
+// A triangle soup where each triangle has its own copy of its points.
+vtkm::cont::DataSet MakePointMergingInput()
 {
   vtkm::cont::testing::MakeTestDataSet makeDataSet;
   vtkm::cont::DataSet baseData = makeDataSet.Make3DUniformDataSet3(vtkm::Id3(4, 4, 4));
@@ -82,7 +87,12 @@ void TestPointMerging()
   marchingCubes.SetIsoValue(0.05);
   marchingCubes.SetMergeDuplicatePoints(false);
   marchingCubes.SetActiveField("pointvar");
-  vtkm::cont::DataSet inData = marchingCubes.Execute(baseData);
+  return marchingCubes.Execute(baseData);
+}
+
+void TestPointMerging()
+{
+  vtkm::cont::DataSet inData = MakePointMergingInput();
   constexpr vtkm::Id originalNumPoints = 228;
   constexpr vtkm::Id originalNumCells = 76;
   VTKM_TEST_ASSERT(inData.GetCellSet().GetNumberOfPoints() == originalNumPoints);
@@ -156,6 +166,105 @@ void TestPointMerging()
                    numNonDegenerateCells);
 }
 
+// Checks that the points merged within the tolerance are the connected components of the graph
+// joining the points closer than the tolerance.
+void CheckToleranceMerge(const vtkm::cont::DataSet& inData,
+                         const vtkm::cont::DataSet& outData,
+                         vtkm::Float64 delta)
+{
+  vtkm::cont::ArrayHandle<vtkm::Vec3f> coords;
+  vtkm::cont::ArrayCopy(inData.GetCoordinateSystem().GetData(), coords);
+  auto coordsPortal = coords.ReadPortal();
+  const vtkm::Id numPoints = coords.GetNumberOfValues();
+
+  std::vector<vtkm::Id> component(static_cast<std::size_t>(numPoints));
+  for (vtkm::Id i = 0; i < numPoints; ++i)
+  {
+    component[static_cast<std::size_t>(i)] = i;
+  }
+  auto findRoot = [&](vtkm::Id i) {
+    while (component[static_cast<std::size_t>(i)] != i)
+    {
+      i = component[static_cast<std::size_t>(i)];
+    }
+    return i;
+  };
+  for (vtkm::Id i = 0; i < numPoints; ++i)
+  {
+    for (vtkm::Id j = i + 1; j < numPoints; ++j)
+    {
+      if (vtkm::MagnitudeSquared(coordsPortal.Get(i) - coordsPortal.Get(j)) <= delta * delta)
+      {
+        component[static_cast<std::size_t>(vtkm::Max(findRoot(i), findRoot(j)))] =
+          vtkm::Min(findRoot(i), findRoot(j));
+      }
+    }
+  }
+  std::set<vtkm::Id> roots;
+  for (vtkm::Id i = 0; i < numPoints; ++i)
+  {
+    roots.insert(findRoot(i));
+  }
+  VTKM_TEST_ASSERT(outData.GetNumberOfPoints() == static_cast<vtkm::Id>(roots.size()),
+                   "Wrong number of merged points: ",
+                   outData.GetNumberOfPoints());
+
+  // Every corner of a cell refers to its own input point, so the connectivity of the output
+  // gives the merged point of each input point.
+  vtkm::cont::CellSetSingleType<> inCellSet;
+  inData.GetCellSet().AsCellSet(inCellSet);
+  vtkm::cont::CellSetExplicit<> outCellSet;
+  outData.GetCellSet().AsCellSet(outCellSet);
+  auto inConnectivity = inCellSet.GetConnectivityArray(vtkm::TopologyElementTagCell{},
+                                                       vtkm::TopologyElementTagPoint{})
+                          .ReadPortal();
+  auto outConnectivity = outCellSet.GetConnectivityArray(vtkm::TopologyElementTagCell{},
+                                                         vtkm::TopologyElementTagPoint{})
+                           .ReadPortal();
+  VTKM_TEST_ASSERT(inConnectivity.GetNumberOfValues() == outConnectivity.GetNumberOfValues());
+  std::map<vtkm::Id, vtkm::Id> rootToOutput;
+  for (vtkm::Id index = 0; index < inConnectivity.GetNumberOfValues(); ++index)
+  {
+    auto inserted =
+      rootToOutput.insert({ findRoot(inConnectivity.Get(index)), outConnectivity.Get(index) });
+    VTKM_TEST_ASSERT(inserted.first->second == outConnectivity.Get(index),
+                     "Points within the tolerance were not merged");
+  }
+}
+
+void TestPointMergingWithHashGrid()
+{
+  vtkm::cont::DataSet inData = MakePointMergingInput();
+  const vtkm::Bounds bounds = inData.GetCoordinateSystem().GetBounds();
+  const vtkm::Float64 diagonal =
+    vtkm::Magnitude(vtkm::make_Vec(bounds.X.Length(), bounds.Y.Length(), bounds.Z.Length()));
+
+  vtkm::filter::clean_grid::CleanGrid cleanGrid;
+  cleanGrid.SetCompactPointFields(false);
+  cleanGrid.SetRemoveDegenerateCells(false);
+
+  for (vtkm::Float64 tolerance : { 1.0e-6, 0.1 })
+  {
+    std::cout << "Clean grid with a hash grid and tolerance " << tolerance << std::endl;
+    cleanGrid.SetTolerance(tolerance);
+
+    // Fast merging merges the points in the same bin, whichever way the bins are found.
+    cleanGrid.SetFastMerge(true);
+    cleanGrid.SetMergePointsWithHashGrid(false);
+    vtkm::cont::DataSet sortMerge = cleanGrid.Execute(inData);
+    cleanGrid.SetMergePointsWithHashGrid(true);
+    vtkm::cont::DataSet hashMerge = cleanGrid.Execute(inData);
+    VTKM_TEST_ASSERT(hashMerge.GetNumberOfPoints() == sortMerge.GetNumberOfPoints(),
+                     "Wrong number of points with fast merge: ",
+                     hashMerge.GetNumberOfPoints());
+    VTKM_TEST_ASSERT(hashMerge.GetField("pointvar").GetNumberOfValues() ==
+                     hashMerge.GetNumberOfPoints());
+
+    cleanGrid.SetFastMerge(false);
+    CheckToleranceMerge(inData, cleanGrid.Execute(inData), tolerance * diagonal);
+  }
+}
+
 void RunTest()
 {
   vtkm::filter::clean_grid::CleanGrid clean;
@@ -182,6 +291,7 @@ void RunTest()
 
   std::cout << "*** Test point merging" << std::endl;
   TestPointMerging();
+  TestPointMergingWithHashGrid();
 }
 
 } // anonymous namespace
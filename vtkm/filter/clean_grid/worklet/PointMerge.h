@@ -11,6 +11,7 @@
 #define vtk_m_worklet_PointMerge_h
 
 #include <vtkm/filter/clean_grid/worklet/RemoveUnusedPoints.h>
+#include <vtkm/filter/connected_components/worklet/UnionFind.h>
 #include <vtkm/worklet/AverageByKey.h>
 #include <vtkm/worklet/DispatcherMapField.h>
 #include <vtkm/worklet/DispatcherReduceByKey.h>
@@ -22,6 +23,7 @@
 #include <vtkm/cont/ArrayHandleIndex.h>
 #include <vtkm/cont/ArrayHandlePermutation.h>
 #include <vtkm/cont/CellSetExplicit.h>
+#include <vtkm/cont/ConcurrentHashTable.h>
 #include <vtkm/cont/ExecutionAndControlObjectBase.h>
 #include <vtkm/cont/Invoker.h>
 #include <vtkm/cont/UnknownArrayHandle.h>
@@ -39,6 +41,13 @@ namespace worklet
 class PointMerge
 {
 public:
+  /// When on, `Run` finds the points to merge with a hash grid and a union-find instead of
+  /// sorting the bins of the points. This takes a single pass over the points, also when
+  /// fastCheck is off, and merges exactly the points within delta of each other (and,
+  /// transitively, their neighbors). Off by default.
+  VTKM_CONT void SetUseHashGrid(bool flag) { this->UseHashGrid = flag; }
+  VTKM_CONT bool GetUseHashGrid() const { return this->UseHashGrid; }
+
   // This class can take point worldCoords as inputs and return the bin index of the enclosing bin.
   class BinLocator : public vtkm::cont::ExecutionAndControlObjectBase
   {
@@ -325,6 +334,137 @@ public:
     }
   };
 
+  // Converts a bin to a key of the hash grid. Different bins can map to the same key, so the
+  // points found through a key have to be checked. The top bit is cleared so that a key is
+  // never vtkm::cont::ConcurrentHashTable::EmptyKey().
+  VTKM_EXEC_CONT static vtkm::UInt64 BinToKey(const vtkm::Id3& bin)
+  {
+    const vtkm::UInt64 key = (static_cast<vtkm::UInt64>(bin[0]) * 0x9E3779B97F4A7C15ULL) ^
+      (static_cast<vtkm::UInt64>(bin[1]) * 0xC2B2AE3D27D4EB4FULL) ^
+      (static_cast<vtkm::UInt64>(bin[2]) * 0x165667B19E3779F9ULL);
+    return key >> 1;
+  }
+
+  // Adds the bin of each point to the hash grid and counts the points in each bin.
+  struct InsertIntoHashGrid : public vtkm::worklet::WorkletMapField
+  {
+    using ControlSignature = void(FieldIn pointCoordinates,
+                                  ExecObject binLocator,
+                                  ExecObject binTable,
+                                  AtomicArrayInOut binCounts,
+                                  FieldOut binSlots);
+    using ExecutionSignature = void(_1, _2, _3, _4, _5);
+
+    template <typename T, typename CountPortalType>
+    VTKM_EXEC void operator()(const vtkm::Vec<T, 3>& coordinates,
+                              const BinLocator& binLocator,
+                              const vtkm::exec::ConcurrentHashTable& binTable,
+                              const CountPortalType& binCounts,
+                              vtkm::Id& binSlot) const
+    {
+      binSlot = binTable.InsertOrGet(BinToKey(binLocator.FindBin(coordinates)));
+      VTKM_ASSERT(binSlot >= 0);
+      binCounts.Add(binSlot, 1);
+    }
+  };
+
+  // Lists the points of each bin contiguously, starting at binStarts[slot]. The counts are
+  // decremented to find a free position, so they are all 0 afterwards.
+  struct FillHashGridBins : public vtkm::worklet::WorkletMapField
+  {
+    using ControlSignature = void(FieldIn binSlots,
+                                  WholeArrayIn binStarts,
+                                  AtomicArrayInOut binCounts,
+                                  WholeArrayOut binPoints);
+    using ExecutionSignature = void(_1, _2, _3, _4, WorkIndex);
+
+    template <typename StartPortalType, typename CountPortalType, typename PointPortalType>
+    VTKM_EXEC void operator()(vtkm::Id binSlot,
+                              const StartPortalType& binStarts,
+                              const CountPortalType& binCounts,
+                              const PointPortalType& binPoints,
+                              vtkm::Id pointIndex) const
+    {
+      const vtkm::Id position = binStarts.Get(binSlot) + binCounts.Add(binSlot, -1) - 1;
+      binPoints.Set(position, pointIndex);
+    }
+  };
+
+  // Joins each point with the points it should be merged with in the union-find forest. With
+  // fast checking, those are the points in the same bin. Otherwise, they are the points within
+  // delta, which are in the same bin or in one of its 26 neighbors.
+  class UniteNeighborsInHashGrid : public vtkm::worklet::WorkletMapField
+  {
+    vtkm::Float64 DeltaSquared;
+    bool FastCheck;
+
+  public:
+    VTKM_CONT
+    UniteNeighborsInHashGrid(bool fastCheck, vtkm::Float64 delta)
+      : DeltaSquared(delta * delta)
+      , FastCheck(fastCheck)
+    {
+    }
+
+    using ControlSignature = void(FieldIn pointCoordinates,
+                                  WholeArrayIn allPointCoordinates,
+                                  ExecObject binLocator,
+                                  ExecObject binTable,
+                                  WholeArrayIn binStarts,
+                                  WholeArrayIn binPoints,
+                                  AtomicArrayInOut parents);
+    using ExecutionSignature = void(_1, _2, _3, _4, _5, _6, _7, WorkIndex);
+
+    template <typename T,
+              typename CoordinatePortalType,
+              typename StartPortalType,
+              typename PointPortalType,
+              typename ParentPortalType>
+    VTKM_EXEC void operator()(const vtkm::Vec<T, 3>& p0,
+                              const CoordinatePortalType& allPointCoordinates,
+                              const BinLocator& binLocator,
+                              const vtkm::exec::ConcurrentHashTable& binTable,
+                              const StartPortalType& binStarts,
+                              const PointPortalType& binPoints,
+                              ParentPortalType& parents,
+                              vtkm::Id pointIndex) const
+    {
+      const vtkm::Id3 bin0 = binLocator.FindBin(p0);
+      const vtkm::Id reach = this->FastCheck ? 0 : 1;
+      for (vtkm::Id k = -reach; k <= reach; ++k)
+      {
+        for (vtkm::Id j = -reach; j <= reach; ++j)
+        {
+          for (vtkm::Id i = -reach; i <= reach; ++i)
+          {
+            const vtkm::Id slot = binTable.Find(BinToKey(bin0 + vtkm::Id3(i, j, k)));
+            if (slot < 0)
+            {
+              continue;
+            }
+            for (vtkm::Id index = binStarts.Get(slot); index < binStarts.Get(slot + 1); ++index)
+            {
+              // Each pair is joined by the point with the smaller index.
+              const vtkm::Id otherIndex = binPoints.Get(index);
+              if (otherIndex <= pointIndex)
+              {
+                continue;
+              }
+              const vtkm::Vec<T, 3> p1 = allPointCoordinates.Get(otherIndex);
+              // With fast checking, the bins have to match exactly since another bin can share
+              // the key. Otherwise, the distance is all that matters.
+              if (this->FastCheck ? (binLocator.FindBin(p1) == bin0)
+                                  : (this->DeltaSquared >= vtkm::MagnitudeSquared(p0 - p1)))
+              {
+                vtkm::worklet::connectivity::UnionFind::Unite(parents, pointIndex, otherIndex);
+              }
+            }
+          }
+        }
+      }
+    }
+  };
+
 private:
   template <typename T>
   VTKM_CONT static void RunOneIteration(
@@ -349,6 +489,47 @@ private:
       FindNeighbors(fastCheck, delta), keys, indexNeighborMap, points, binLocator, neighborIndices);
   }
 
+  // Finds the groups of points to merge with a single binning pass. The points are listed by
+  // bin with a ConcurrentHashTable of the bins and a count of their points, and the groups are
+  // built with a concurrent union-find. Each point of a group ends up mapped to the point of
+  // the group with the smallest index.
+  template <typename T>
+  VTKM_CONT static void FindGroupsWithHashGrid(
+    vtkm::Float64 delta,
+    bool fastCheck,
+    const BinLocator& binLocator,
+    const vtkm::cont::ArrayHandle<vtkm::Vec<T, 3>>& points,
+    vtkm::cont::ArrayHandle<vtkm::Id>& indexNeighborMap)
+  {
+    vtkm::cont::Invoker invoker;
+    const vtkm::Id numberOfPoints = points.GetNumberOfValues();
+
+    vtkm::cont::ConcurrentHashTable binTable(numberOfPoints);
+    vtkm::cont::ArrayHandle<vtkm::Id> binCounts;
+    binCounts.AllocateAndFill(binTable.GetCapacity(), 0);
+    vtkm::cont::ArrayHandle<vtkm::Id> binSlots;
+    invoker(InsertIntoHashGrid{}, points, binLocator, binTable, binCounts, binSlots);
+
+    vtkm::cont::ArrayHandle<vtkm::Id> binStarts;
+    vtkm::cont::Algorithm::ScanExtended(binCounts, binStarts);
+    vtkm::cont::ArrayHandle<vtkm::Id> binPoints;
+    binPoints.Allocate(numberOfPoints);
+    invoker(FillHashGridBins{}, binSlots, binStarts, binCounts, binPoints);
+    binSlots.ReleaseResources();
+    binCounts.ReleaseResources();
+
+    vtkm::cont::ArrayCopy(vtkm::cont::ArrayHandleIndex(numberOfPoints), indexNeighborMap);
+    invoker(UniteNeighborsInHashGrid(fastCheck, delta),
+            points,
+            points,
+            binLocator,
+            binTable,
+            binStarts,
+            binPoints,
+            indexNeighborMap);
+    invoker(vtkm::worklet::connectivity::PointerJumping{}, indexNeighborMap);
+  }
+
 public:
   template <typename T>
   VTKM_CONT void Run(
@@ -362,12 +543,18 @@ public:
     BinLocator binLocator(bounds, delta);
 
     vtkm::cont::ArrayHandle<vtkm::Id> indexNeighborMap;
-    vtkm::cont::ArrayCopy(vtkm::cont::ArrayHandleIndex(points.GetNumberOfValues()),
-                          indexNeighborMap);
-
-    this->RunOneIteration(delta, fastCheck, binLocator, points, indexNeighborMap);
+    if (this->UseHashGrid)
+    {
+      this->FindGroupsWithHashGrid(delta, fastCheck, binLocator, points, indexNeighborMap);
+    }
+    else
+    {
+      vtkm::cont::ArrayCopy(vtkm::cont::ArrayHandleIndex(points.GetNumberOfValues()),
+                            indexNeighborMap);
+      this->RunOneIteration(delta, fastCheck, binLocator, points, indexNeighborMap);
+    }
 
-    if (!fastCheck)
+    if (!fastCheck && !this->UseHashGrid)
     {
       // Run the algorithm again after shifting the bins to capture nearby points that straddled
       // the previous bins.
@@ -414,9 +601,17 @@ public:
 
     // Need to pull out the unique point coordiantes
     vtkm::cont::ArrayHandle<vtkm::Vec<T, 3>> uniquePointCoordinates;
-    vtkm::cont::ArrayCopy(
-      vtkm::cont::make_ArrayHandlePermutation(this->MergeKeys.GetUniqueKeys(), points),
-      uniquePointCoordinates);
+    if (this->UseHashGrid)
+    {
+      // The hash grid does not move the points, so average each group here.
+      vtkm::worklet::AverageByKey::Run(this->MergeKeys, points, uniquePointCoordinates);
+    }
+    else
+    {
+      vtkm::cont::ArrayCopy(
+        vtkm::cont::make_ArrayHandlePermutation(this->MergeKeys.GetUniqueKeys(), points),
+        uniquePointCoordinates);
+    }
     points = uniquePointCoordinates;
   }
 
@@ -507,6 +702,7 @@ public:
 private:
   vtkm::worklet::Keys<vtkm::Id> MergeKeys;
   vtkm::cont::ArrayHandle<vtkm::Id> PointInputToOutputMap;
+  bool UseHashGrid = false;
 };
 }
 } // namespace vtkm::worklet
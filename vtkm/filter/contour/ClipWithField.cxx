@@ -84,6 +84,7 @@ vtkm::cont::DataSet ClipWithField::DoExecute(const vtkm::cont::DataSet& input)
   }
 
   vtkm::worklet::Clip worklet;
+  worklet.SetMergeDuplicatePointsWithHashTable(this->MergeDuplicatePointsWithHashTable);
 
   const vtkm::cont::UnknownCellSet& inputCellSet = input.GetCellSet();
   vtkm::cont::CellSetExplicit<> outputCellSet;
@@ -82,6 +82,7 @@ vtkm::cont::DataSet ClipWithImplicitFunction::DoExecute(const vtkm::cont::DataSe
     input.GetCoordinateSystem(this->GetActiveCoordinateSystemIndex());
 
   vtkm::worklet::Clip worklet;
+  worklet.SetMergeDuplicatePointsWithHashTable(this->MergeDuplicatePointsWithHashTable);
 
   vtkm::cont::CellSetExplicit<> outputCellSet =
     worklet.Run(inputCellSet, this->Function, inputCoords, this->Invert);
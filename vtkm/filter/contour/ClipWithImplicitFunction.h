@@ -35,11 +35,26 @@ public:
 
   const vtkm::ImplicitFunctionGeneral& GetImplicitFunction() const { return this->Function; }
 
+  /// Set/Get whether the points generated on the edges of the input are merged with a hash
+  /// table of their edges instead of by sorting the edges. The merged points are then ordered
+  /// by when they are generated rather than by edge. Off by default.
+  VTKM_CONT
+  void SetMergeDuplicatePointsWithHashTable(bool on)
+  {
+    this->MergeDuplicatePointsWithHashTable = on;
+  }
+  VTKM_CONT
+  bool GetMergeDuplicatePointsWithHashTable() const
+  {
+    return this->MergeDuplicatePointsWithHashTable;
+  }
+
 private:
   vtkm::cont::DataSet DoExecute(const vtkm::cont::DataSet& input) override;
 
   vtkm::ImplicitFunctionGeneral Function;
   bool Invert = false;
+  bool MergeDuplicatePointsWithHashTable = false;
 };
 } // namespace contour
 class VTKM_DEPRECATED(1.8, "Use vtkm::filter::contour::ClipWithImplicitFunction.")
@@ -7,7 +7,11 @@
 //  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
 //  PURPOSE.  See the above copyright notice for more information.
 //============================================================================
+#include <vtkm/cont/ArrayCopyDevice.h>
 #include <vtkm/cont/ArrayHandleIndex.h>
+#include <vtkm/cont/ArrayHandlePermutation.h>
+#include <vtkm/cont/CellSetExplicit.h>
+#include <vtkm/cont/CellSetPermutation.h>
 #include <vtkm/cont/CellSetSingleType.h>
 #include <vtkm/cont/CellSetStructured.h>
 #include <vtkm/cont/ErrorFilterExecution.h>
@@ -17,6 +21,7 @@
 #include <vtkm/filter/contour/Contour.h>
 #include <vtkm/filter/contour/worklet/Contour.h>
 #include <vtkm/filter/vector_analysis/SurfaceNormals.h>
+#include <vtkm/worklet/CellDeepCopy.h>
 
 namespace vtkm
 {
@@ -41,7 +46,8 @@ inline bool IsCellSetStructured(const vtkm::cont::UnknownCellSet& cellset)
 
 VTKM_CONT bool DoMapField(vtkm::cont::DataSet& result,
                           const vtkm::cont::Field& field,
-                          vtkm::worklet::Contour& worklet)
+                          vtkm::worklet::Contour& worklet,
+                          const vtkm::cont::ArrayHandle<vtkm::Id>& cellIdMap)
 {
   if (field.IsFieldPoint())
   {
@@ -57,8 +63,7 @@ VTKM_CONT bool DoMapField(vtkm::cont::DataSet& result,
   else if (field.IsFieldCell())
   {
     // Use the precompiled field permutation function.
-    vtkm::cont::ArrayHandle<vtkm::Id> permutation = worklet.GetCellIdMap();
-    return vtkm::filter::MapFieldPermutation(field, permutation, result);
+    return vtkm::filter::MapFieldPermutation(field, cellIdMap, result);
   }
   else if (field.IsFieldGlobal())
   {
@@ -92,6 +97,7 @@ vtkm::cont::DataSet Contour::DoExecute(const vtkm::cont::DataSet& inDataSet)
 {
   vtkm::worklet::Contour worklet;
   worklet.SetMergeDuplicatePoints(this->GetMergeDuplicatePoints());
+  worklet.SetMergeDuplicatePointsWithHashTable(this->GetMergeDuplicatePointsWithHashTable());
 
   if (!this->GetFieldFromDataSet(inDataSet).IsFieldPoint())
   {
@@ -118,6 +124,16 @@ vtkm::cont::DataSet Contour::DoExecute(const vtkm::cont::DataSet& inDataSet)
     ? !this->ComputeFastNormalsForStructured
     : !this->ComputeFastNormalsForUnstructured;
 
+  // High quality normals are computed from the cells around each point, so they need the whole
+  // mesh. Otherwise the contour is extracted from the cells that the index selects.
+  const bool useRangeIndex =
+    this->RangeIndex && !(this->GenerateNormals && generateHighQualityNormals);
+  if (useRangeIndex)
+  {
+    this->RangeIndex->Update(inputCells, this->GetFieldFromDataSet(inDataSet));
+  }
+  vtkm::cont::ArrayHandle<vtkm::Id> candidateCellIds;
+
   auto resolveFieldType = [&](const auto& concrete) {
     // use std::decay to remove const ref from the decltype of concrete.
     using T = typename std::decay_t<decltype(concrete)>::ValueType;
@@ -132,6 +148,22 @@ vtkm::cont::DataSet Contour::DoExecute(const vtkm::cont::DataSet& inDataSet)
       outputCells =
         worklet.Run(ivalues, inputCells, inputCoords.GetData(), concrete, vertices, normals);
     }
+    else if (useRangeIndex)
+    {
+      // Query with the iso-values converted to the field type, as the worklet sees them.
+      std::vector<vtkm::Float64> queries(ivalues.begin(), ivalues.end());
+      candidateCellIds = this->RangeIndex->GetCellsContaining(queries);
+      vtkm::cont::CellSetExplicit<> candidateCells;
+      inputCells.CastAndCallForTypes<VTKM_DEFAULT_CELL_SET_LIST>([&](const auto& cells) {
+        candidateCells = vtkm::worklet::CellDeepCopy::Run(
+          vtkm::cont::make_CellSetPermutation(candidateCellIds, cells));
+      });
+      outputCells = worklet.Run(ivalues,
+                                vtkm::cont::UnknownCellSet(candidateCells),
+                                inputCoords.GetData(),
+                                concrete,
+                                vertices);
+    }
     else
     {
       outputCells = worklet.Run(ivalues, inputCells, inputCoords.GetData(), concrete, vertices);
@@ -143,7 +175,17 @@ vtkm::cont::DataSet Contour::DoExecute(const vtkm::cont::DataSet& inDataSet)
     .CastAndCallForTypesWithFloatFallback<SupportedTypes, VTKM_DEFAULT_STORAGE_LIST>(
       resolveFieldType);
 
-  auto mapper = [&](auto& result, const auto& f) { DoMapField(result, f, worklet); };
+  // The worklet numbers the cells of the candidate subset. Map them back to the input cells.
+  vtkm::cont::ArrayHandle<vtkm::Id> cellIdMap = worklet.GetCellIdMap();
+  if (useRangeIndex)
+  {
+    vtkm::cont::ArrayHandle<vtkm::Id> inputCellIds;
+    vtkm::cont::ArrayCopyDevice(
+      vtkm::cont::make_ArrayHandlePermutation(cellIdMap, candidateCellIds), inputCellIds);
+    cellIdMap = inputCellIds;
+  }
+
+  auto mapper = [&](auto& result, const auto& f) { DoMapField(result, f, worklet, cellIdMap); };
   vtkm::cont::DataSet output = this->CreateResult(
     inDataSet, outputCells, vtkm::cont::CoordinateSystem{ "coordinates", vertices }, mapper);
 
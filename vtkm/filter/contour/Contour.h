@@ -12,6 +12,7 @@
 #define vtk_m_filter_contour_Contour_h
 
 #include <vtkm/filter/NewFilterField.h>
+#include <vtkm/filter/ScalarRangeIndex.h>
 #include <vtkm/filter/contour/vtkm_filter_contour_export.h>
 
 namespace vtkm
@@ -69,6 +70,22 @@ public:
   VTKM_CONT
   bool GetMergeDuplicatePoints() const;
 
+  /// Set/Get whether duplicate points are identified with a hash table of their edges
+  /// instead of by sorting the edges. Hashing takes linear time, but the merged points are
+  /// ordered by when they are generated rather than by edge. Only used by the Marching
+  /// Cells path when `MergeDuplicatePoints` is on. Off by default.
+  ///
+  VTKM_CONT
+  void SetMergeDuplicatePointsWithHashTable(bool on)
+  {
+    this->MergeDuplicatePointsWithHashTable = on;
+  }
+  VTKM_CONT
+  bool GetMergeDuplicatePointsWithHashTable() const
+  {
+    return this->MergeDuplicatePointsWithHashTable;
+  }
+
   /// Set/Get whether normals should be generated. Off by default. If enabled,
   /// the default behaviour is to generate high quality normals for structured
   /// datasets, using gradients, and generate fast normals for unstructured
@@ -111,6 +128,29 @@ public:
   VTKM_CONT
   const std::string& GetNormalArrayName() const { return this->NormalArrayName; }
 
+  /// \brief Use a `ScalarRangeIndex` to only visit the cells that can hold the isosurface.
+  ///
+  /// The index is (re)built for the active field on the first execution and reused as long as
+  /// the cell set and the field are unchanged. The contour is then extracted from a copy of the
+  /// cells of the bricks whose range contains an iso-value, which makes changing the iso-values
+  /// much cheaper than contouring the whole mesh. The same index can be shared with a
+  /// `vtkm::filter::entity_extraction::Threshold` that uses the same field.
+  ///
+  /// The index is not used when high quality normals are generated, as these are computed from
+  /// all the cells around each point.
+  ///
+  VTKM_CONT
+  void SetScalarRangeIndex(const std::shared_ptr<vtkm::filter::ScalarRangeIndex>& index)
+  {
+    this->RangeIndex = index;
+  }
+
+  VTKM_CONT
+  const std::shared_ptr<vtkm::filter::ScalarRangeIndex>& GetScalarRangeIndex() const
+  {
+    return this->RangeIndex;
+  }
+
 private:
   VTKM_CONT
 
@@ -120,8 +160,10 @@ private:
   bool ComputeFastNormalsForStructured = false;
   bool ComputeFastNormalsForUnstructured = true;
   bool MergeDuplicatedPoints = true;
+  bool MergeDuplicatePointsWithHashTable = false;
   std::string NormalArrayName = "normals";
   std::string InterpolationEdgeIdsArrayName = "edgeIds";
+  std::shared_ptr<vtkm::filter::ScalarRangeIndex> RangeIndex;
 
 protected:
   // Needed by the subclass Slice
@@ -8,8 +8,10 @@
 //  PURPOSE.  See the above copyright notice for more information.
 //============================================================================
 
+#include <vtkm/VectorAnalysis.h>
 #include <vtkm/cont/ArrayCopyDevice.h>
 #include <vtkm/cont/ArrayHandleTransform.h>
+#include <vtkm/cont/ErrorBadType.h>
 #include <vtkm/filter/contour/Slice.h>
 
 namespace vtkm
@@ -23,19 +25,90 @@ vtkm::cont::DataSet Slice::DoExecute(const vtkm::cont::DataSet& input)
   const auto& coords = input.GetCoordinateSystem(this->GetActiveCoordinateSystemIndex());
 
   vtkm::cont::DataSet result;
-  auto impFuncEval =
-    vtkm::ImplicitFunctionValueFunctor<vtkm::ImplicitFunctionGeneral>(this->Function);
-  auto coordTransform =
-    vtkm::cont::make_ArrayHandleTransform(coords.GetDataAsMultiplexer(), impFuncEval);
   vtkm::cont::ArrayHandle<vtkm::FloatDefault> sliceScalars;
-  vtkm::cont::ArrayCopyDevice(coordTransform, sliceScalars);
+  vtkm::Float64 isoValue = 0.0;
+  const auto& function = this->Function.GetVariant();
+  if (this->GetScalarRangeIndex() && function.IsType<vtkm::Plane>())
+  {
+    // The plane is the contour of the distance along its normal at the distance of its origin.
+    const vtkm::Plane& plane = function.Get<vtkm::Plane>();
+    std::vector<vtkm::cont::internal::Buffer> buffers;
+    bool reusable = true;
+    try
+    {
+      coords.GetData().CastAndCall([&](const auto& array) { buffers = array.GetBuffers(); });
+    }
+    catch (vtkm::cont::ErrorBadType&)
+    {
+      // Coordinates of a type we cannot look into. Compute the distances every time.
+      reusable = false;
+    }
+    std::vector<vtkm::UInt64> modifiedCounts;
+    for (const auto& buffer : buffers)
+    {
+      modifiedCounts.push_back(buffer.GetModifiedCount());
+    }
+    if (!reusable || (plane.GetNormal() != this->PlaneNormal) ||
+        (buffers != this->PlaneCoordinateBuffers) ||
+        (modifiedCounts != this->PlaneCoordinateModifiedCounts))
+    {
+      vtkm::ImplicitFunctionValueFunctor<vtkm::Plane> distance(vtkm::Plane(plane.GetNormal()));
+      vtkm::cont::ArrayCopyDevice(
+        vtkm::cont::make_ArrayHandleTransform(coords.GetDataAsMultiplexer(), distance),
+        this->PlaneDistances);
+      this->PlaneNormal = plane.GetNormal();
+      this->PlaneCoordinateBuffers = buffers;
+      this->PlaneCoordinateModifiedCounts = modifiedCounts;
+    }
+    sliceScalars = this->PlaneDistances;
+    isoValue = static_cast<vtkm::Float64>(vtkm::Dot(plane.GetOrigin(), plane.GetNormal()));
+  }
+  else
+  {
+    auto impFuncEval =
+      vtkm::ImplicitFunctionValueFunctor<vtkm::ImplicitFunctionGeneral>(this->Function);
+    auto coordTransform =
+      vtkm::cont::make_ArrayHandleTransform(coords.GetDataAsMultiplexer(), impFuncEval);
+    vtkm::cont::ArrayCopyDevice(coordTransform, sliceScalars);
+  }
   // input is a const, we can not AddField to it.
   vtkm::cont::DataSet clone = input;
   clone.AddField(vtkm::cont::make_FieldPoint("sliceScalars", sliceScalars));
 
-  this->Contour::SetIsoValue(0.0);
+  this->Contour::SetIsoValue(isoValue);
   this->Contour::SetActiveField("sliceScalars");
-  result = this->Contour::DoExecute(clone);
+
+  // The field of any other function is new at every execution, so an index would be built for
+  // each of them and never queried again. Skip it for this execution.
+  const std::shared_ptr<vtkm::filter::ScalarRangeIndex> rangeIndex = this->GetScalarRangeIndex();
+  if (!function.IsType<vtkm::Plane>())
+  {
+    this->SetScalarRangeIndex(nullptr);
+  }
+  try
+  {
+    result = this->Contour::DoExecute(clone);
+  }
+  catch (...)
+  {
+    this->SetScalarRangeIndex(rangeIndex);
+    throw;
+  }
+  this->SetScalarRangeIndex(rangeIndex);
+
+  // The contour of a plane was extracted from the distances along its normal, offset by the
+  // distance of its origin. Output the value of the plane function instead, as for any other
+  // function.
+  if ((isoValue != 0.0) && result.HasPointField("sliceScalars"))
+  {
+    vtkm::ImplicitFunctionValueFunctor<vtkm::Plane> planeValue(function.Get<vtkm::Plane>());
+    vtkm::cont::ArrayHandle<vtkm::FloatDefault> planeValues;
+    vtkm::cont::ArrayCopyDevice(
+      vtkm::cont::make_ArrayHandleTransform(result.GetCoordinateSystem().GetDataAsMultiplexer(),
+                                            planeValue),
+      planeValues);
+    result.AddField(vtkm::cont::make_FieldPoint("sliceScalars", planeValues));
+  }
 
   return result;
 }
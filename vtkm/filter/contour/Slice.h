@@ -15,12 +15,23 @@
 
 #include <vtkm/ImplicitFunction.h>
 
+#include <vector>
+
 namespace vtkm
 {
 namespace filter
 {
 namespace contour
 {
+/// \brief Intersect a mesh with an implicit function.
+///
+/// The slice is the contour at 0 of the implicit function evaluated at the points. A
+/// `ScalarRangeIndex` given with `SetScalarRangeIndex` is only used when the implicit function
+/// is a `vtkm::Plane`. The slice is then extracted from the distance along the normal of the
+/// plane, which does not depend on its origin. That field is kept between executions, so the
+/// index is reused while the plane moves along its normal. Either way, the `sliceScalars` field
+/// of the output holds the value of the implicit function, about 0 on the slice.
+///
 class VTKM_FILTER_CONTOUR_EXPORT Slice : public vtkm::filter::contour::Contour
 {
 public:
@@ -35,6 +46,12 @@ private:
   VTKM_CONT vtkm::cont::DataSet DoExecute(const vtkm::cont::DataSet& input) override;
 
   vtkm::ImplicitFunctionGeneral Function;
+
+  // Distance of the points along PlaneNormal, and the coordinate arrays it was computed from.
+  vtkm::cont::ArrayHandle<vtkm::FloatDefault> PlaneDistances;
+  vtkm::Vec3f PlaneNormal{ 0, 0, 0 };
+  std::vector<vtkm::cont::internal::Buffer> PlaneCoordinateBuffers;
+  std::vector<vtkm::UInt64> PlaneCoordinateModifiedCounts;
 };
 } // namespace contour
 class VTKM_DEPRECATED(1.8, "Use vtkm::filter::contour::Slice.") Slice
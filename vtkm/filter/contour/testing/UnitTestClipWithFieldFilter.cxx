@@ -8,11 +8,17 @@
 //  PURPOSE.  See the above copyright notice for more information.
 //============================================================================
 
+#include <vtkm/cont/Algorithm.h>
+#include <vtkm/cont/ArrayCopy.h>
+#include <vtkm/cont/ArrayHandlePermutation.h>
 #include <vtkm/cont/DataSetBuilderExplicit.h>
 #include <vtkm/cont/testing/MakeTestDataSet.h>
 #include <vtkm/cont/testing/Testing.h>
 #include <vtkm/filter/contour/ClipWithField.h>
 
+#include <utility>
+#include <vector>
+
 namespace
 {
 
@@ -98,11 +104,63 @@ void TestClipVolume()
   const vtkm::cont::DataSet outputData = clip.Execute(ds);
 }
 
+// The coordinates of the points of every cell, in connectivity order.
+vtkm::cont::ArrayHandle<vtkm::Vec3f> CellPointCoordinates(const vtkm::cont::DataSet& data)
+{
+  vtkm::cont::ArrayHandle<vtkm::Vec3f> coords;
+  vtkm::cont::ArrayCopy(data.GetCoordinateSystem().GetData(), coords);
+  auto connectivity =
+    data.GetCellSet().AsCellSet<vtkm::cont::CellSetExplicit<>>().GetConnectivityArray(
+      vtkm::TopologyElementTagCell(), vtkm::TopologyElementTagPoint());
+  vtkm::cont::ArrayHandle<vtkm::Vec3f> cellPoints;
+  vtkm::cont::ArrayCopy(vtkm::cont::make_ArrayHandlePermutation(connectivity, coords), cellPoints);
+  return cellPoints;
+}
+
+void TestClipWithHashTable()
+{
+  std::cout << "Testing Clip Filter merging points with a hash table" << std::endl;
+
+  vtkm::cont::testing::MakeTestDataSet maker;
+  std::vector<std::pair<vtkm::cont::DataSet, vtkm::Float64>> inputs = {
+    { maker.Make3DUniformDataSet3(vtkm::Id3(10, 10, 10)), 0.0 },
+    { maker.Make3DExplicitDataSet5(), 30.0 }
+  };
+  for (const auto& input : inputs)
+  {
+    const vtkm::cont::DataSet& ds = input.first;
+    vtkm::filter::contour::ClipWithField clip;
+    clip.SetClipValue(input.second);
+    clip.SetActiveField("pointvar");
+    clip.SetFieldsToPass("pointvar", vtkm::cont::Field::Association::Points);
+
+    const vtkm::cont::DataSet expected = clip.Execute(ds);
+    clip.SetMergeDuplicatePointsWithHashTable(true);
+    const vtkm::cont::DataSet result = clip.Execute(ds);
+
+    VTKM_TEST_ASSERT(result.GetNumberOfCells() == expected.GetNumberOfCells(),
+                     "Wrong number of cells");
+    VTKM_TEST_ASSERT(result.GetNumberOfPoints() == expected.GetNumberOfPoints(),
+                     "Wrong number of points");
+    // The new points are numbered differently, but the cells must be the same.
+    VTKM_TEST_ASSERT(
+      test_equal_ArrayHandles(CellPointCoordinates(result), CellPointCoordinates(expected)));
+
+    vtkm::cont::ArrayHandle<vtkm::Float64> expectedField, resultField;
+    vtkm::cont::ArrayCopy(expected.GetField("pointvar").GetData(), expectedField);
+    vtkm::cont::ArrayCopy(result.GetField("pointvar").GetData(), resultField);
+    VTKM_TEST_ASSERT(test_equal(vtkm::cont::Algorithm::Reduce(resultField, vtkm::Float64(0)),
+                                vtkm::cont::Algorithm::Reduce(expectedField, vtkm::Float64(0))),
+                     "Wrong point field");
+  }
+}
+
 void TestClip()
 {
   //todo: add more clip tests
   TestClipExplicit();
   TestClipVolume();
+  TestClipWithHashTable();
 }
 }
 
@@ -9,12 +9,19 @@
 //============================================================================
 
 #include <vtkm/Math.h>
+#include <vtkm/VectorAnalysis.h>
 #include <vtkm/cont/Algorithm.h>
+#include <vtkm/cont/ArrayCopy.h>
+#include <vtkm/cont/ArrayHandlePermutation.h>
+#include <vtkm/cont/CellSetSingleType.h>
 #include <vtkm/cont/DataSet.h>
+#include <vtkm/cont/DataSetBuilderRectilinear.h>
 #include <vtkm/cont/testing/MakeTestDataSet.h>
 #include <vtkm/cont/testing/Testing.h>
 
+#include <vtkm/filter/clean_grid/CleanGrid.h>
 #include <vtkm/filter/contour/Contour.h>
+#include <vtkm/filter/contour/Slice.h>
 #include <vtkm/filter/field_transform/GenerateIds.h>
 
 #include <vtkm/io/VTKDataSetReader.h>
@@ -167,11 +174,355 @@ public:
     VTKM_TEST_ASSERT(result.GetNumberOfCells() == 52);
   }
 
+  // A sphere on a stretched rectilinear grid.
+  static vtkm::cont::DataSet MakeRectilinearSphere()
+  {
+    std::vector<vtkm::FloatDefault> axis;
+    for (vtkm::Id i = -10; i <= 10; ++i)
+    {
+      auto x = static_cast<vtkm::FloatDefault>(i) / 10.0f;
+      axis.push_back(x * (0.5f + 0.5f * x * x));
+    }
+    vtkm::cont::DataSet dataSet = vtkm::cont::DataSetBuilderRectilinear::Create(axis, axis, axis);
+
+    auto coords = dataSet.GetCoordinateSystem().GetDataAsMultiplexer();
+    vtkm::cont::ArrayHandle<vtkm::FloatDefault> radius2;
+    radius2.Allocate(coords.GetNumberOfValues());
+    auto coordsPortal = coords.ReadPortal();
+    auto radiusPortal = radius2.WritePortal();
+    for (vtkm::Id i = 0; i < coordsPortal.GetNumberOfValues(); ++i)
+    {
+      radiusPortal.Set(i, vtkm::MagnitudeSquared(coordsPortal.Get(i)));
+    }
+    dataSet.AddPointField("radius2", radius2);
+    return dataSet;
+  }
+
+  void TestContourStructuredGrids() const
+  {
+    std::cout << "Testing Contour filter on rectilinear and curvilinear grids" << std::endl;
+
+    vtkm::cont::DataSet rectilinear = MakeRectilinearSphere();
+
+    vtkm::cont::DataSet curvilinear;
+    curvilinear.SetCellSet(rectilinear.GetCellSet());
+    vtkm::cont::ArrayHandle<vtkm::Vec3f> points;
+    vtkm::cont::ArrayCopy(rectilinear.GetCoordinateSystem().GetData(), points);
+    curvilinear.AddCoordinateSystem(vtkm::cont::CoordinateSystem("coords", points));
+    curvilinear.AddField(rectilinear.GetField("radius2"));
+
+    // The unstructured copy goes through marching cells and is used as reference.
+    vtkm::filter::clean_grid::CleanGrid makeUnstructured;
+    makeUnstructured.SetCompactPointFields(false);
+    makeUnstructured.SetMergePoints(false);
+    vtkm::cont::DataSet unstructured = makeUnstructured.Execute(rectilinear);
+
+    const vtkm::FloatDefault isovalue = 0.25f;
+    vtkm::filter::contour::Contour filter;
+    filter.SetGenerateNormals(true);
+    filter.SetMergeDuplicatePoints(true);
+    filter.SetIsoValue(isovalue);
+    filter.SetActiveField("radius2");
+
+    auto pointSum = [](const vtkm::cont::DataSet& dataSet) {
+      vtkm::cont::ArrayHandle<vtkm::Vec3f> coords;
+      vtkm::cont::ArrayCopy(dataSet.GetCoordinateSystem().GetData(), coords);
+      return vtkm::cont::Algorithm::Reduce(coords, vtkm::Vec3f(0.0f));
+    };
+
+    vtkm::cont::DataSet expected = filter.Execute(unstructured);
+    const vtkm::Vec3f expectedSum = pointSum(expected);
+    for (const auto& input : { rectilinear, curvilinear })
+    {
+      vtkm::cont::DataSet result = filter.Execute(input);
+      VTKM_TEST_ASSERT(result.GetNumberOfCells() == expected.GetNumberOfCells(),
+                       "Wrong number of cells");
+      VTKM_TEST_ASSERT(result.GetNumberOfPoints() == expected.GetNumberOfPoints(),
+                       "Wrong number of points");
+      VTKM_TEST_ASSERT(test_equal(pointSum(result), expectedSum, 0.001), "Wrong points");
+
+      // The normals of a sphere point away from its center.
+      vtkm::cont::ArrayHandle<vtkm::Vec3f> coords, normals;
+      vtkm::cont::ArrayCopy(result.GetCoordinateSystem().GetData(), coords);
+      result.GetField("normals").GetData().AsArrayHandle(normals);
+      auto coordsPortal = coords.ReadPortal();
+      auto normalsPortal = normals.ReadPortal();
+      for (vtkm::Id i = 0; i < coordsPortal.GetNumberOfValues(); ++i)
+      {
+        VTKM_TEST_ASSERT(test_equal(normalsPortal.Get(i), vtkm::Normal(coordsPortal.Get(i)), 0.05),
+                         "Wrong normal ",
+                         normalsPortal.Get(i),
+                         " at ",
+                         coordsPortal.Get(i));
+      }
+    }
+  }
+
+  // The coordinates of the points of every cell, in connectivity order.
+  static vtkm::cont::ArrayHandle<vtkm::Vec3f> CellPointCoordinates(const vtkm::cont::DataSet& data)
+  {
+    vtkm::cont::ArrayHandle<vtkm::Vec3f> coords;
+    vtkm::cont::ArrayCopy(data.GetCoordinateSystem().GetData(), coords);
+    vtkm::cont::CellSetSingleType<> cells;
+    data.GetCellSet().AsCellSet(cells);
+    auto connectivity = cells.GetConnectivityArray(vtkm::TopologyElementTagCell(),
+                                                   vtkm::TopologyElementTagPoint());
+    vtkm::cont::ArrayHandle<vtkm::Vec3f> cellPoints;
+    vtkm::cont::ArrayCopy(vtkm::cont::make_ArrayHandlePermutation(connectivity, coords),
+                          cellPoints);
+    return cellPoints;
+  }
+
+  void TestMergeWithHashTable() const
+  {
+    std::cout << "Testing Contour filter merging points with a hash table" << std::endl;
+
+    vtkm::filter::clean_grid::CleanGrid makeUnstructured;
+    makeUnstructured.SetCompactPointFields(false);
+    makeUnstructured.SetMergePoints(false);
+    vtkm::cont::DataSet input = makeUnstructured.Execute(MakeRectilinearSphere());
+
+    vtkm::filter::contour::Contour filter;
+    filter.SetMergeDuplicatePoints(true);
+    filter.SetActiveField("radius2");
+
+    for (const auto& isovalues : { std::vector<vtkm::Float64>{ 0.25 },
+                                   std::vector<vtkm::Float64>{ 0.1, 0.25, 0.5 } })
+    {
+      filter.SetIsoValues(isovalues);
+      filter.SetMergeDuplicatePointsWithHashTable(false);
+      vtkm::cont::DataSet expected = filter.Execute(input);
+      filter.SetMergeDuplicatePointsWithHashTable(true);
+      vtkm::cont::DataSet result = filter.Execute(input);
+
+      VTKM_TEST_ASSERT(result.GetNumberOfCells() == expected.GetNumberOfCells(),
+                       "Wrong number of cells");
+      VTKM_TEST_ASSERT(result.GetNumberOfPoints() == expected.GetNumberOfPoints(),
+                       "Wrong number of points");
+      VTKM_TEST_ASSERT(result.GetNumberOfPoints() < 3 * result.GetNumberOfCells(),
+                       "Points were not merged");
+      // The points are numbered differently, but the triangles must be the same.
+      VTKM_TEST_ASSERT(
+        test_equal_ArrayHandles(CellPointCoordinates(result), CellPointCoordinates(expected)));
+    }
+  }
+
+  void TestManyIsoValues() const
+  {
+    std::cout << "Testing Contour filter merging points of more than 256 iso-values" << std::endl;
+
+    // A single hexahedron with a field that varies along x, so that every iso-value cuts
+    // the same 4 edges of the cell.
+    const vtkm::Id numberOfIsoValues = 300;
+    const std::vector<vtkm::FloatDefault> axis = { 0, 1 };
+    vtkm::cont::DataSet input = vtkm::cont::DataSetBuilderRectilinear::Create(axis, axis, axis);
+    std::vector<vtkm::Float32> field;
+    for (vtkm::Id i = 0; i < input.GetNumberOfPoints(); ++i)
+    {
+      field.push_back(static_cast<vtkm::Float32>(numberOfIsoValues * (i % 2)));
+    }
+    input.AddPointField("ramp", field);
+
+    std::vector<vtkm::Float64> isovalues;
+    for (vtkm::Id i = 0; i < numberOfIsoValues; ++i)
+    {
+      isovalues.push_back(static_cast<vtkm::Float64>(i) + 0.5);
+    }
+
+    vtkm::filter::contour::Contour filter;
+    filter.SetMergeDuplicatePoints(true);
+    filter.SetActiveField("ramp");
+    filter.SetIsoValues(isovalues);
+    for (bool useHashTable : { false, true })
+    {
+      filter.SetMergeDuplicatePointsWithHashTable(useHashTable);
+      vtkm::cont::DataSet result = filter.Execute(input);
+
+      // Points of different iso-values must not be merged together.
+      VTKM_TEST_ASSERT(result.GetNumberOfCells() == 2 * numberOfIsoValues,
+                       "Wrong number of cells");
+      VTKM_TEST_ASSERT(result.GetNumberOfPoints() == 4 * numberOfIsoValues,
+                       "Wrong number of points");
+      // Iso-value i + 0.5 cuts the x edges at (i + 0.5) / numberOfIsoValues.
+      const auto scale = static_cast<vtkm::FloatDefault>(numberOfIsoValues);
+      std::vector<vtkm::Id> pointsPerIsoValue(static_cast<std::size_t>(numberOfIsoValues), 0);
+      auto coords = result.GetCoordinateSystem().GetDataAsMultiplexer().ReadPortal();
+      for (vtkm::Id i = 0; i < coords.GetNumberOfValues(); ++i)
+      {
+        const auto isoIndex = static_cast<vtkm::Id>(vtkm::Floor(coords.Get(i)[0] * scale));
+        VTKM_TEST_ASSERT(isoIndex >= 0 && isoIndex < numberOfIsoValues, "Bad point");
+        ++pointsPerIsoValue[static_cast<std::size_t>(isoIndex)];
+      }
+      for (vtkm::Id count : pointsPerIsoValue)
+      {
+        VTKM_TEST_ASSERT(count == 4, "Wrong number of points for an iso-value");
+      }
+    }
+  }
+
+  static void CheckMultipleIsoValuesStructured(const vtkm::Id3& dims,
+                                               const std::vector<vtkm::Float64>& isovalues)
+  {
+    vtkm::source::Tangle tangle(dims);
+    vtkm::cont::DataSet input = tangle.Execute();
+
+    vtkm::filter::contour::Contour filter;
+    filter.SetGenerateNormals(true);
+    filter.SetActiveField("tangle");
+
+    // The iso-values are contoured in sweeps over batches of iso-values. The result must
+    // match the concatenation of the surfaces extracted one iso-value at a time.
+    filter.SetIsoValues(isovalues);
+    vtkm::cont::DataSet result = filter.Execute(input);
+
+    std::vector<vtkm::Vec3f> expectedCellPoints;
+    std::vector<vtkm::Vec3f> expectedNormals;
+    vtkm::Id expectedNumberOfPoints = 0;
+    for (vtkm::Float64 isovalue : isovalues)
+    {
+      filter.SetIsoValues({ isovalue });
+      vtkm::cont::DataSet single = filter.Execute(input);
+      expectedNumberOfPoints += single.GetNumberOfPoints();
+      vtkm::cont::ArrayHandle<vtkm::Vec3f> cellPoints = CellPointCoordinates(single);
+      auto cellPointsPortal = cellPoints.ReadPortal();
+      for (vtkm::Id i = 0; i < cellPointsPortal.GetNumberOfValues(); ++i)
+      {
+        expectedCellPoints.push_back(cellPointsPortal.Get(i));
+      }
+      vtkm::cont::ArrayHandle<vtkm::Vec3f> normals;
+      single.GetField("normals").GetData().AsArrayHandle(normals);
+      auto normalsPortal = normals.ReadPortal();
+      for (vtkm::Id i = 0; i < normalsPortal.GetNumberOfValues(); ++i)
+      {
+        expectedNormals.push_back(normalsPortal.Get(i));
+      }
+    }
+
+    VTKM_TEST_ASSERT(!expectedCellPoints.empty(), "Test should generate triangles");
+    VTKM_TEST_ASSERT(result.GetNumberOfPoints() == expectedNumberOfPoints,
+                     "Wrong number of points");
+    VTKM_TEST_ASSERT(test_equal_ArrayHandles(
+      CellPointCoordinates(result),
+      vtkm::cont::make_ArrayHandle(expectedCellPoints, vtkm::CopyFlag::Off)));
+    vtkm::cont::ArrayHandle<vtkm::Vec3f> normals;
+    result.GetField("normals").GetData().AsArrayHandle(normals);
+    VTKM_TEST_ASSERT(test_equal_ArrayHandles(
+      normals, vtkm::cont::make_ArrayHandle(expectedNormals, vtkm::CopyFlag::Off)));
+  }
+
+  void TestMultipleIsoValuesStructured() const
+  {
+    std::cout << "Testing Contour filter with several iso-values on a uniform grid" << std::endl;
+    CheckMultipleIsoValuesStructured(vtkm::Id3(24, 24, 24), { 0.2, 0.5, 0.8, 1000.0 });
+
+    // Enough iso-values for the edge cases of 64^3 points to be split in several batches.
+    std::vector<vtkm::Float64> isovalues;
+    for (int i = 0; i < 70; ++i)
+    {
+      isovalues.push_back(0.1 * i);
+    }
+    CheckMultipleIsoValuesStructured(vtkm::Id3(64, 64, 64), isovalues);
+  }
+
+  void TestScalarRangeIndex() const
+  {
+    std::cout << "Testing Contour filter with a ScalarRangeIndex" << std::endl;
+
+    vtkm::filter::clean_grid::CleanGrid makeUnstructured;
+    makeUnstructured.SetCompactPointFields(false);
+    makeUnstructured.SetMergePoints(false);
+    vtkm::filter::field_transform::GenerateIds genIds;
+    genIds.SetUseFloat(true);
+    genIds.SetGeneratePointIds(false);
+    genIds.SetCellFieldName("cellvar");
+    vtkm::cont::DataSet input = genIds.Execute(makeUnstructured.Execute(MakeRectilinearSphere()));
+
+    auto index = std::make_shared<vtkm::filter::ScalarRangeIndex>();
+    index->SetBrickSize(64);
+
+    vtkm::filter::contour::Contour filter;
+    filter.SetActiveField("radius2");
+    filter.SetGenerateNormals(true);
+    using Method = vtkm::filter::ScalarRangeIndex::Method;
+    for (Method method : { Method::Bricks, Method::SpanSpace })
+    {
+      index->SetMethod(method);
+      for (const auto& isovalues : { std::vector<vtkm::Float64>{ 0.25 },
+                                     std::vector<vtkm::Float64>{ 0.1, 0.5 },
+                                     std::vector<vtkm::Float64>{ 10.0 } })
+      {
+        filter.SetIsoValues(isovalues);
+        filter.SetScalarRangeIndex(nullptr);
+        vtkm::cont::DataSet expected = filter.Execute(input);
+        filter.SetScalarRangeIndex(index);
+        vtkm::cont::DataSet result = filter.Execute(input);
+
+        VTKM_TEST_ASSERT(index->IsBuiltFor(input.GetCellSet(), input.GetField("radius2")),
+                         "Index was not built for the input");
+        VTKM_TEST_ASSERT(result.GetNumberOfCells() == expected.GetNumberOfCells(),
+                         "Wrong number of cells");
+        VTKM_TEST_ASSERT(result.GetNumberOfPoints() == expected.GetNumberOfPoints(),
+                         "Wrong number of points");
+        VTKM_TEST_ASSERT(
+          test_equal_ArrayHandles(CellPointCoordinates(result), CellPointCoordinates(expected)));
+        VTKM_TEST_ASSERT(test_equal_ArrayHandles(result.GetCellField("cellvar").GetData(),
+                                                 expected.GetCellField("cellvar").GetData()));
+        VTKM_TEST_ASSERT(test_equal_ArrayHandles(result.GetPointField("normals").GetData(),
+                                                 expected.GetPointField("normals").GetData()));
+      }
+    }
+
+    // Slicing with a plane reuses the index while the plane moves along its normal.
+    const vtkm::Vec3f normal = vtkm::Normal(vtkm::Vec3f(0.3f, 0.5f, 0.8f));
+    vtkm::filter::contour::Slice slice;
+    vtkm::filter::contour::Slice indexedSlice;
+    indexedSlice.SetScalarRangeIndex(index);
+    for (vtkm::FloatDefault offset : { -0.31f, 0.05f, 0.43f })
+    {
+      const vtkm::Plane plane(offset * normal, normal);
+      slice.SetImplicitFunction(plane);
+      indexedSlice.SetImplicitFunction(plane);
+      vtkm::cont::DataSet expected = slice.Execute(input);
+      vtkm::cont::DataSet result = indexedSlice.Execute(input);
+      VTKM_TEST_ASSERT(result.GetNumberOfCells() > 0, "Slice should generate triangles");
+      VTKM_TEST_ASSERT(result.GetNumberOfCells() == expected.GetNumberOfCells(),
+                       "Wrong number of slice cells");
+      VTKM_TEST_ASSERT(
+        test_equal_ArrayHandles(CellPointCoordinates(result), CellPointCoordinates(expected)));
+      // Either way, the output field holds the value of the plane function, about 0.
+      auto sliceScalars = result.GetPointField("sliceScalars")
+                            .GetData()
+                            .AsArrayHandle<vtkm::cont::ArrayHandle<vtkm::FloatDefault>>()
+                            .ReadPortal();
+      for (vtkm::Id i = 0; i < sliceScalars.GetNumberOfValues(); ++i)
+      {
+        VTKM_TEST_ASSERT(test_equal(sliceScalars.Get(i), 0.f), "Wrong slice scalars");
+      }
+    }
+
+    // Other functions make a new field at each execution, so the index is left alone.
+    filter.Execute(input);
+    const vtkm::Sphere sphere(vtkm::Vec3f(0.f), 0.3f);
+    slice.SetImplicitFunction(sphere);
+    indexedSlice.SetImplicitFunction(sphere);
+    VTKM_TEST_ASSERT(indexedSlice.Execute(input).GetNumberOfCells() ==
+                       slice.Execute(input).GetNumberOfCells(),
+                     "Wrong number of sphere slice cells");
+    VTKM_TEST_ASSERT(index->IsBuiltFor(input.GetCellSet(), input.GetField("radius2")),
+                     "Index was rebuilt for a sphere slice");
+    VTKM_TEST_ASSERT(indexedSlice.GetScalarRangeIndex() == index, "Slice lost its index");
+  }
+
   void operator()() const
   {
     this->Test3DUniformDataSet0();
     this->TestContourUniformGrid();
     this->TestContourWedges();
+    this->TestContourStructuredGrids();
+    this->TestMergeWithHashTable();
+    this->TestManyIsoValues();
+    this->TestMultipleIsoValuesStructured();
+    this->TestScalarRangeIndex();
   }
 
 }; // class TestContourFilter
@@ -15,15 +15,19 @@
 #include <vtkm/worklet/DispatcherMapTopology.h>
 #include <vtkm/worklet/DispatcherReduceByKey.h>
 #include <vtkm/worklet/Keys.h>
+#include <vtkm/worklet/MergeDuplicateKeys.h>
 #include <vtkm/worklet/WorkletMapField.h>
 #include <vtkm/worklet/WorkletMapTopology.h>
 #include <vtkm/worklet/WorkletReduceByKey.h>
 
 #include <vtkm/cont/Algorithm.h>
 #include <vtkm/cont/ArrayCopy.h>
+#include <vtkm/cont/ArrayCopyDevice.h>
+#include <vtkm/cont/ArrayHandleConcatenate.h>
 #include <vtkm/cont/ArrayHandlePermutation.h>
 #include <vtkm/cont/ArrayHandleView.h>
 #include <vtkm/cont/CellSetExplicit.h>
+#include <vtkm/cont/ConcurrentHashTable.h>
 #include <vtkm/cont/ConvertNumComponentsToOffsets.h>
 #include <vtkm/cont/CoordinateSystem.h>
 #include <vtkm/cont/Timer.h>
@@ -545,6 +549,29 @@ public:
     vtkm::Id EdgePointOffset;
   };
 
+  class PackEdgeInterpolation : public vtkm::worklet::WorkletMapField
+  {
+  public:
+    VTKM_CONT
+    PackEdgeInterpolation(vtkm::IdComponent pointIdBits)
+      : PointIdBits(static_cast<vtkm::UInt64>(pointIdBits))
+    {
+    }
+
+    using ControlSignature = void(FieldIn edgeInterpolation, FieldOut key);
+
+    using ExecutionSignature = void(_1, _2);
+
+    VTKM_EXEC void operator()(const EdgeInterpolation& edge, vtkm::UInt64& key) const
+    {
+      key = (static_cast<vtkm::UInt64>(edge.Vertex1) << this->PointIdBits) |
+        static_cast<vtkm::UInt64>(edge.Vertex2);
+    }
+
+  private:
+    vtkm::UInt64 PointIdBits;
+  };
+
   class ScatterInCellConnectivity : public vtkm::worklet::WorkletMapField
   {
   public:
@@ -583,6 +610,18 @@ public:
   {
   }
 
+  /// Set/Get whether the duplicate edge points are identified with a hash table instead of
+  /// by sorting the edges. The merged points are then ordered by when they are generated
+  /// rather than by edge. Off by default.
+  void SetMergeDuplicatePointsWithHashTable(bool on)
+  {
+    this->MergeDuplicatePointsWithHashTable = on;
+  }
+  bool GetMergeDuplicatePointsWithHashTable() const
+  {
+    return this->MergeDuplicatePointsWithHashTable;
+  }
+
   template <typename CellSetType, typename ScalarsArrayHandle>
   vtkm::cont::CellSetExplicit<> Run(const CellSetType& cellSet,
                                     const ScalarsArrayHandle& scalars,
@@ -646,25 +685,58 @@ public:
                              this->InCellInterpolationInfo,
                              this->CellMapOutputToInput);
 
-    // Get unique EdgeInterpolation : unique edge points.
-    // LowerBound for edgeInterpolation : get index into new edge points array.
-    // LowerBound for cellPointEdgeInterpolation : get index into new edge points array.
-    vtkm::cont::Algorithm::SortByKey(
-      edgeInterpolation, edgePointReverseConnectivity, EdgeInterpolation::LessThanOp());
-    vtkm::cont::Algorithm::Copy(edgeInterpolation, this->EdgePointsInterpolation);
-    vtkm::cont::Algorithm::Unique(this->EdgePointsInterpolation, EdgeInterpolation::EqualToOp());
-
     vtkm::cont::ArrayHandle<vtkm::Id> edgeInterpolationIndexToUnique;
-    vtkm::cont::Algorithm::LowerBounds(this->EdgePointsInterpolation,
-                                       edgeInterpolation,
-                                       edgeInterpolationIndexToUnique,
-                                       EdgeInterpolation::LessThanOp());
-
     vtkm::cont::ArrayHandle<vtkm::Id> cellInterpolationIndexToUnique;
-    vtkm::cont::Algorithm::LowerBounds(this->EdgePointsInterpolation,
-                                       cellPointEdgeInterpolation,
-                                       cellInterpolationIndexToUnique,
-                                       EdgeInterpolation::LessThanOp());
+    const vtkm::IdComponent pointIdBits =
+      vtkm::cont::ConcurrentHashTable::GetNumberOfBitsForIds(scalars.GetNumberOfValues());
+    if (this->MergeDuplicatePointsWithHashTable && (2 * pointIdBits <= 63))
+    {
+      // Merge the edges of the in-cell points along with the edge points, so that both
+      // get their index into the unique edge points from the same hash table.
+      auto allEdges =
+        vtkm::cont::make_ArrayHandleConcatenate(edgeInterpolation, cellPointEdgeInterpolation);
+      vtkm::cont::ArrayHandle<vtkm::Id> allIndexToUnique;
+      vtkm::cont::ArrayHandle<vtkm::Id> uniqueToInput;
+      {
+        vtkm::cont::ArrayHandle<vtkm::UInt64> keys;
+        vtkm::worklet::DispatcherMapField<PackEdgeInterpolation> packDispatcher(
+          PackEdgeInterpolation{ pointIdBits });
+        packDispatcher.Invoke(allEdges, keys);
+        vtkm::worklet::MergeDuplicateKeys(keys, allIndexToUnique, uniqueToInput);
+      }
+      vtkm::cont::ArrayCopyDevice(
+        vtkm::cont::make_ArrayHandlePermutation(uniqueToInput, allEdges),
+        this->EdgePointsInterpolation);
+
+      const vtkm::Id numberOfEdgeIndices = edgeInterpolation.GetNumberOfValues();
+      vtkm::cont::Algorithm::CopySubRange(
+        allIndexToUnique, 0, numberOfEdgeIndices, edgeInterpolationIndexToUnique);
+      vtkm::cont::Algorithm::CopySubRange(allIndexToUnique,
+                                          numberOfEdgeIndices,
+                                          cellPointEdgeInterpolation.GetNumberOfValues(),
+                                          cellInterpolationIndexToUnique);
+    }
+    else
+    {
+      // Get unique EdgeInterpolation : unique edge points.
+      // LowerBound for edgeInterpolation : get index into new edge points array.
+      // LowerBound for cellPointEdgeInterpolation : get index into new edge points array.
+      vtkm::cont::Algorithm::SortByKey(
+        edgeInterpolation, edgePointReverseConnectivity, EdgeInterpolation::LessThanOp());
+      vtkm::cont::Algorithm::Copy(edgeInterpolation, this->EdgePointsInterpolation);
+      vtkm::cont::Algorithm::Unique(this->EdgePointsInterpolation,
+                                    EdgeInterpolation::EqualToOp());
+
+      vtkm::cont::Algorithm::LowerBounds(this->EdgePointsInterpolation,
+                                         edgeInterpolation,
+                                         edgeInterpolationIndexToUnique,
+                                         EdgeInterpolation::LessThanOp());
+
+      vtkm::cont::Algorithm::LowerBounds(this->EdgePointsInterpolation,
+                                         cellPointEdgeInterpolation,
+                                         cellInterpolationIndexToUnique,
+                                         EdgeInterpolation::LessThanOp());
+    }
 
     this->EdgePointsOffset = scalars.GetNumberOfValues();
     this->InCellPointsOffset =
@@ -899,6 +971,7 @@ private:
   vtkm::cont::ArrayHandle<vtkm::Id> CellMapOutputToInput;
   vtkm::Id EdgePointsOffset;
   vtkm::Id InCellPointsOffset;
+  bool MergeDuplicatePointsWithHashTable = false;
 };
 }
 } // namespace vtkm::worklet
@@ -40,14 +40,38 @@ struct DeduceCoordType
     result = marching_cells::execute(cells, coords, std::forward<Args>(args)...);
   }
 
-  template <typename... Args>
+  // Flying edges handles uniform, rectilinear and curvilinear 3D structured grids. It always
+  // merges duplicate points, which has always been the case on uniform grids. On other grids,
+  // marching cells is used when duplicate points should not be merged.
+  template <typename CoordsComponentType,
+            typename StorageTagCoords,
+            typename ValueType,
+            typename StorageTagField,
+            typename CoordinateType,
+            typename StorageTagVertices,
+            typename NormalType,
+            typename StorageTagNormals>
   void operator()(
-    const vtkm::cont::ArrayHandle<vtkm::Vec3f, vtkm::cont::StorageTagUniformPoints>& coords,
+    const vtkm::cont::ArrayHandle<vtkm::Vec<CoordsComponentType, 3>, StorageTagCoords>& coords,
     const vtkm::cont::CellSetStructured<3>& cells,
     vtkm::cont::CellSetSingleType<>& result,
-    Args&&... args) const
+    const std::vector<ValueType>& isovalues,
+    const vtkm::cont::ArrayHandle<ValueType, StorageTagField>& input,
+    vtkm::cont::ArrayHandle<vtkm::Vec<CoordinateType, 3>, StorageTagVertices>& vertices,
+    vtkm::cont::ArrayHandle<vtkm::Vec<NormalType, 3>, StorageTagNormals>& normals,
+    vtkm::worklet::contour::CommonState& sharedState) const
   {
-    result = flying_edges::execute(cells, coords, std::forward<Args>(args)...);
+    if (sharedState.MergeDuplicatePoints ||
+        std::is_same<StorageTagCoords, vtkm::cont::StorageTagUniformPoints>::value)
+    {
+      result =
+        flying_edges::execute(cells, coords, isovalues, input, vertices, normals, sharedState);
+    }
+    else
+    {
+      result =
+        marching_cells::execute(cells, coords, isovalues, input, vertices, normals, sharedState);
+    }
   }
 };
 
@@ -85,6 +109,18 @@ public:
   //----------------------------------------------------------------------------
   bool GetMergeDuplicatePoints() const { return this->SharedState.MergeDuplicatePoints; }
 
+  //----------------------------------------------------------------------------
+  void SetMergeDuplicatePointsWithHashTable(bool on)
+  {
+    this->SharedState.MergeDuplicatePointsWithHashTable = on;
+  }
+
+  //----------------------------------------------------------------------------
+  bool GetMergeDuplicatePointsWithHashTable() const
+  {
+    return this->SharedState.MergeDuplicatePointsWithHashTable;
+  }
+
   //----------------------------------------------------------------------------
   vtkm::cont::ArrayHandle<vtkm::Id> GetCellIdMap() const { return this->SharedState.CellIdMap; }
 
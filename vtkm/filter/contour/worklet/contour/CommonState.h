@@ -29,6 +29,7 @@ struct CommonState
   }
 
   bool MergeDuplicatePoints = true;
+  bool MergeDuplicatePointsWithHashTable = false;
   bool GenerateNormals = false;
   vtkm::cont::ArrayHandle<vtkm::FloatDefault> InterpolationWeights;
   vtkm::cont::ArrayHandle<vtkm::Id2> InterpolationEdgeIds;
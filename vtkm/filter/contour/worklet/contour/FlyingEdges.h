@@ -28,6 +28,9 @@ namespace worklet
 namespace flying_edges
 {
 
+// The largest number of edge cases, one byte each, that are kept at once.
+constexpr vtkm::Id MaxEdgeCasesPerBatch = vtkm::Id(1) << 24;
+
 namespace detail
 {
 template <typename T, typename S>
@@ -54,11 +57,14 @@ template <typename ValueType,
           typename StorageTagField,
           typename StorageTagVertices,
           typename StorageTagNormals,
+          typename CoordsComponentType,
+          typename StorageTagCoords,
           typename CoordinateType,
           typename NormalType>
 vtkm::cont::CellSetSingleType<> execute(
   const vtkm::cont::CellSetStructured<3>& cells,
-  const vtkm::cont::ArrayHandleUniformPointCoordinates& coordinateSystem,
+  const vtkm::cont::ArrayHandle<vtkm::Vec<CoordsComponentType, 3>, StorageTagCoords>&
+    coordinateSystem,
   const std::vector<ValueType>& isovalues,
   const vtkm::cont::ArrayHandle<ValueType, StorageTagField>& inputField,
   vtkm::cont::ArrayHandle<vtkm::Vec<CoordinateType, 3>, StorageTagVertices>& points,
@@ -67,19 +73,25 @@ vtkm::cont::CellSetSingleType<> execute(
 {
   vtkm::cont::Invoker invoke;
 
-  vtkm::Vec3f origin, spacing;
-  { //extract out the origin and spacing as these are needed for Pass4 to properly
-    //interpolate the new points
-    auto portal = coordinateSystem.ReadPortal();
-    origin = portal.GetOrigin();
-    spacing = portal.GetSpacing();
-  }
   auto pdims = cells.GetPointDimensions();
+  const vtkm::Id numPoints = coordinateSystem.GetNumberOfValues();
+  const vtkm::Id numIsoValues = static_cast<vtkm::Id>(isovalues.size());
+
+  // The iso-values of a batch are processed together. The edge cases and the meta data of
+  // each iso-value are stacked one after the other, so the field is swept once per batch
+  // and a single scan computes the output offsets of every surface of the batch. This costs
+  // one edge case byte per point and per iso-value, so the batches are limited to
+  // MaxEdgeCasesPerBatch edge cases, or to a single iso-value on larger fields. An empty
+  // field takes all of them in one batch.
+  const vtkm::Id batchSize = vtkm::Max(
+    vtkm::Id(1),
+    vtkm::Min(numIsoValues, MaxEdgeCasesPerBatch / vtkm::Max(numPoints, vtkm::Id(1))));
 
   vtkm::cont::ArrayHandle<vtkm::UInt8> edgeCases;
-  edgeCases.Allocate(coordinateSystem.GetNumberOfValues());
+  edgeCases.Allocate(batchSize * numPoints);
 
   vtkm::cont::CellSetStructured<2> metaDataMesh2D;
+  // The following hold one entry per point (or cell) of metaDataMesh and per iso-value.
   vtkm::cont::ArrayHandle<vtkm::Id> metaDataLinearSums; //per point of metaDataMesh
   vtkm::cont::ArrayHandle<vtkm::Id> metaDataMin;        //per point of metaDataMesh
   vtkm::cont::ArrayHandle<vtkm::Id> metaDataMax;        //per point of metaDataMesh
@@ -95,11 +107,14 @@ vtkm::cont::CellSetSingleType<> execute(
   sharedState.CellIdMap.ReleaseResources();
 
   vtkm::cont::ArrayHandle<vtkm::Id> triangle_topology;
-  for (std::size_t i = 0; i < isovalues.size(); ++i)
+  for (vtkm::Id batchStart = 0; batchStart < numIsoValues; batchStart += batchSize)
   {
     auto multiContourCellOffset = sharedState.CellIdMap.GetNumberOfValues();
     auto multiContourPointOffset = sharedState.InterpolationWeights.GetNumberOfValues();
-    ValueType isoval = isovalues[i];
+    const vtkm::Id batchEnd = vtkm::Min(batchStart + batchSize, numIsoValues);
+    const std::vector<ValueType> batch(isovalues.begin() + static_cast<std::ptrdiff_t>(batchStart),
+                                       isovalues.begin() + static_cast<std::ptrdiff_t>(batchEnd));
+    const vtkm::Id numBatchIsoValues = static_cast<vtkm::Id>(batch.size());
 
     //----------------------------------------------------------------------------
     // PASS 1: Process all of the voxel edges that compose each row. Determine the
@@ -117,11 +132,12 @@ vtkm::cont::CellSetSingleType<> execute(
       // Additionally GPU's does significantly better when you do an initial fill
       // and write only non-below values
       //
-      ComputePass1<ValueType> worklet1(isoval, pdims);
+      ComputePass1<ValueType> worklet1(pdims);
       vtkm::cont::TryExecuteOnDevice(invoke.GetDevice(),
                                      launchComputePass1{},
                                      worklet1,
                                      inputField,
+                                     vtkm::cont::make_ArrayHandle(batch, vtkm::CopyFlag::Off),
                                      edgeCases,
                                      metaDataMesh2D,
                                      metaDataSums,
@@ -136,7 +152,8 @@ vtkm::cont::CellSetSingleType<> execute(
     // row. Use computational trimming to reduce work.
     {
       VTKM_LOG_SCOPE(vtkm::cont::LogLevel::Perf, "FlyingEdges Pass2");
-      ComputePass2 worklet2(pdims);
+      metaDataNumTris.Allocate(metaDataMesh2D.GetNumberOfCells() * numBatchIsoValues);
+      ComputePass2 worklet2(pdims, numBatchIsoValues);
       invoke(worklet2,
              metaDataMesh2D,
              metaDataSums,
@@ -157,7 +174,6 @@ vtkm::cont::CellSetSingleType<> execute(
       detail::extend_by(triangle_topology, 3 * sumTris);
       detail::extend_by(sharedState.CellIdMap, sumTris);
 
-
       vtkm::Id newPointSize =
         vtkm::cont::Algorithm::ScanExclusive(metaDataLinearSums, metaDataLinearSums);
       detail::extend_by(sharedState.InterpolationEdgeIds, newPointSize);
@@ -168,8 +184,7 @@ vtkm::cont::CellSetSingleType<> execute(
       {
         VTKM_LOG_SCOPE(vtkm::cont::LogLevel::Perf, "FlyingEdges Pass4");
 
-        launchComputePass4 pass4(
-          pdims, origin, spacing, multiContourCellOffset, multiContourPointOffset);
+        launchComputePass4 pass4(pdims, multiContourCellOffset, multiContourPointOffset);
 
         detail::extend_by(points, newPointSize);
         if (sharedState.GenerateNormals)
@@ -180,7 +195,7 @@ vtkm::cont::CellSetSingleType<> execute(
         vtkm::cont::TryExecuteOnDevice(invoke.GetDevice(),
                                        pass4,
                                        newPointSize,
-                                       isoval,
+                                       batch,
                                        inputField,
                                        edgeCases,
                                        metaDataMesh2D,
@@ -191,7 +206,8 @@ vtkm::cont::CellSetSingleType<> execute(
                                        sharedState,
                                        triangle_topology,
                                        points,
-                                       normals);
+                                       normals,
+                                       coordinateSystem);
       }
     }
   }
@@ -70,32 +70,38 @@ template <typename T>
 struct ComputePass1 : public vtkm::worklet::WorkletVisitPointsWithCells
 {
   vtkm::Id3 PointDims;
-  T IsoValue;
 
   ComputePass1() {}
-  ComputePass1(T value, const vtkm::Id3& pdims)
+  explicit ComputePass1(const vtkm::Id3& pdims)
     : PointDims(pdims)
-    , IsoValue(value)
   {
   }
 
+  // The edge cases and the row meta data of all iso-values are stacked: the
+  // entries of iso-value k start at k * (number of points) in edgeData and at
+  // k * (number of rows) in the axis arrays.
   using ControlSignature = void(CellSetIn,
-                                FieldOut axis_sum,
-                                FieldOut axis_min,
-                                FieldOut axis_max,
+                                WholeArrayIn isovalues,
+                                WholeArrayOut axis_sum,
+                                WholeArrayOut axis_min,
+                                WholeArrayOut axis_max,
                                 WholeArrayInOut edgeData,
                                 WholeArrayIn data);
-  using ExecutionSignature = void(ThreadIndices, _2, _3, _4, _5, _6, Device);
+  using ExecutionSignature = void(ThreadIndices, _2, _3, _4, _5, _6, _7, Device);
   using InputDomain = _1;
 
   template <typename ThreadIndices,
+            typename WholeIsoValueField,
+            typename WholeSumField,
+            typename WholeAxisField,
             typename WholeEdgeField,
             typename WholeDataField,
             typename Device>
   VTKM_EXEC void operator()(const ThreadIndices& threadIndices,
-                            vtkm::Id3& axis_sum,
-                            vtkm::Id& axis_min,
-                            vtkm::Id& axis_max,
+                            const WholeIsoValueField& isovalues,
+                            const WholeSumField& axis_sums,
+                            const WholeAxisField& axis_mins,
+                            const WholeAxisField& axis_maxs,
                             WholeEdgeField& edges,
                             const WholeDataField& field,
                             Device device) const
@@ -107,58 +113,98 @@ struct ComputePass1 : public vtkm::worklet::WorkletVisitPointsWithCells
     const vtkm::Id startPos = compute_start(AxisToSum{}, ijk, dims);
     const vtkm::Id offset = compute_inc(AxisToSum{}, dims);
 
-    const T value = this->IsoValue;
-    axis_min = this->PointDims[AxisToSum::xindex];
-    axis_max = 0;
-    T s1 = field.Get(startPos);
-    T s0 = s1;
-    axis_sum = { 0, 0, 0 };
+    const vtkm::Id numPoints = dims[0] * dims[1] * dims[2];
+    const vtkm::Id numRows = dims[AxisToSum::yindex] * dims[AxisToSum::zindex];
+    const vtkm::Id row = threadIndices.GetInputIndex();
     const vtkm::Id end = this->PointDims[AxisToSum::xindex] - 1;
-    for (vtkm::Id i = 0; i < end; ++i)
-    {
-      s0 = s1;
-      s1 = field.Get(startPos + (offset * (i + 1)));
 
-      vtkm::UInt8 edgeCase = FlyingEdges3D::Below;
-      if (s0 >= value)
-      {
-        edgeCase = FlyingEdges3D::LeftAbove;
-      }
-      if (s1 >= value)
+    // Classify the row against one iso-value at a time. After the first
+    // iso-value the row is in cache, so the field is only read once from memory.
+    for (vtkm::Id k = 0; k < isovalues.GetNumberOfValues(); ++k)
+    {
+      const T value = isovalues.Get(k);
+      const vtkm::Id edgeStart = startPos + (k * numPoints);
+      vtkm::Id axis_min = this->PointDims[AxisToSum::xindex];
+      vtkm::Id axis_max = 0;
+      vtkm::Id3 axis_sum = { 0, 0, 0 };
+      T s1 = field.Get(startPos);
+      T s0 = s1;
+      for (vtkm::Id i = 0; i < end; ++i)
       {
-        edgeCase |= FlyingEdges3D::RightAbove;
-      }
+        s0 = s1;
+        s1 = field.Get(startPos + (offset * (i + 1)));
 
-      write_edge(device, startPos + (offset * i), edges, edgeCase);
+        vtkm::UInt8 edgeCase = FlyingEdges3D::Below;
+        if (s0 >= value)
+        {
+          edgeCase = FlyingEdges3D::LeftAbove;
+        }
+        if (s1 >= value)
+        {
+          edgeCase |= FlyingEdges3D::RightAbove;
+        }
 
-      if (edgeCase == FlyingEdges3D::LeftAbove || edgeCase == FlyingEdges3D::RightAbove)
-      {
-        axis_sum[AxisToSum::xindex] += 1; // increment number of intersections along axis
-        axis_max = i + 1;
-        if (axis_min == (end + 1))
+        write_edge(device, edgeStart + (offset * i), edges, edgeCase);
+
+        if (edgeCase == FlyingEdges3D::LeftAbove || edgeCase == FlyingEdges3D::RightAbove)
         {
-          axis_min = i;
+          axis_sum[AxisToSum::xindex] += 1; // increment number of intersections along axis
+          axis_max = i + 1;
+          if (axis_min == (end + 1))
+          {
+            axis_min = i;
+          }
         }
       }
+      write_edge(device, edgeStart + (offset * end), edges, FlyingEdges3D::Below);
+
+      axis_sums.Set(row + (k * numRows), axis_sum);
+      axis_mins.Set(row + (k * numRows), axis_min);
+      axis_maxs.Set(row + (k * numRows), axis_max);
     }
-    write_edge(device, startPos + (offset * end), edges, FlyingEdges3D::Below);
   }
 };
 
 struct launchComputePass1
 {
-  template <typename DeviceAdapterTag, typename T, typename StorageTagField, typename... Args>
-  VTKM_CONT bool LaunchXAxis(DeviceAdapterTag device,
-                             const ComputePass1<T>& worklet,
-                             const vtkm::cont::ArrayHandle<T, StorageTagField>& inputField,
-                             vtkm::cont::ArrayHandle<vtkm::UInt8>& edgeCases,
-                             vtkm::cont::CellSetStructured<2>& metaDataMesh2D,
-                             Args&&... args) const
+  template <typename AxisToSum,
+            typename DeviceAdapterTag,
+            typename T,
+            typename StorageTagField,
+            typename MeshSums>
+  VTKM_CONT void Launch(AxisToSum,
+                        DeviceAdapterTag device,
+                        const ComputePass1<T>& worklet,
+                        const vtkm::cont::ArrayHandle<T, StorageTagField>& inputField,
+                        const vtkm::cont::ArrayHandle<T>& isovalues,
+                        vtkm::cont::ArrayHandle<vtkm::UInt8>& edgeCases,
+                        vtkm::cont::CellSetStructured<2>& metaDataMesh2D,
+                        MeshSums& metaDataSums,
+                        vtkm::cont::ArrayHandle<vtkm::Id>& metaDataMin,
+                        vtkm::cont::ArrayHandle<vtkm::Id>& metaDataMax) const
   {
     vtkm::cont::Invoker invoke(device);
-    metaDataMesh2D = make_metaDataMesh2D(SumXAxis{}, worklet.PointDims);
+    metaDataMesh2D = make_metaDataMesh2D(AxisToSum{}, worklet.PointDims);
+
+    const vtkm::Id numRows = metaDataMesh2D.GetNumberOfPoints() * isovalues.GetNumberOfValues();
+    metaDataSums.Allocate(numRows);
+    metaDataMin.Allocate(numRows);
+    metaDataMax.Allocate(numRows);
+
+    invoke(worklet,
+           metaDataMesh2D,
+           isovalues,
+           metaDataSums,
+           metaDataMin,
+           metaDataMax,
+           edgeCases,
+           inputField);
+  }
 
-    invoke(worklet, metaDataMesh2D, std::forward<Args>(args)..., edgeCases, inputField);
+  template <typename DeviceAdapterTag, typename... Args>
+  VTKM_CONT bool LaunchXAxis(DeviceAdapterTag device, Args&&... args) const
+  {
+    this->Launch(SumXAxis{}, device, std::forward<Args>(args)...);
     return true;
   }
 
@@ -166,15 +212,13 @@ struct launchComputePass1
   VTKM_CONT bool LaunchYAxis(DeviceAdapterTag device,
                              const ComputePass1<T>& worklet,
                              const vtkm::cont::ArrayHandle<T, StorageTagField>& inputField,
+                             const vtkm::cont::ArrayHandle<T>& isovalues,
                              vtkm::cont::ArrayHandle<vtkm::UInt8>& edgeCases,
-                             vtkm::cont::CellSetStructured<2>& metaDataMesh2D,
                              Args&&... args) const
   {
-    vtkm::cont::Invoker invoke(device);
-    metaDataMesh2D = make_metaDataMesh2D(SumYAxis{}, worklet.PointDims);
-
     edgeCases.Fill(static_cast<vtkm::UInt8>(FlyingEdges3D::Below));
-    invoke(worklet, metaDataMesh2D, std::forward<Args>(args)..., edgeCases, inputField);
+    this->Launch(
+      SumYAxis{}, device, worklet, inputField, isovalues, edgeCases, std::forward<Args>(args)...);
     return true;
   }
 
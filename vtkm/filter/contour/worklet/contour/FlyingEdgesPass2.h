@@ -26,32 +26,37 @@ namespace flying_edges
 struct ComputePass2 : public vtkm::worklet::WorkletVisitCellsWithPoints
 {
   vtkm::Id3 PointDims;
+  vtkm::Id NumberOfIsoValues = 1;
 
   ComputePass2() {}
-  explicit ComputePass2(const vtkm::Id3& pdims)
+  explicit ComputePass2(const vtkm::Id3& pdims, vtkm::Id numberOfIsoValues = 1)
     : PointDims(pdims)
+    , NumberOfIsoValues(numberOfIsoValues)
   {
   }
 
+  // See ComputePass1 for the layout of the per iso-value arrays. The triangle
+  // counts of iso-value k start at k * (number of cells).
   using ControlSignature = void(CellSetIn,
                                 WholeArrayInOut axis_sums,
-                                FieldInPoint axis_mins,
-                                FieldInPoint axis_maxs,
-                                FieldOutCell cell_tri_count,
+                                WholeArrayIn axis_mins,
+                                WholeArrayIn axis_maxs,
+                                WholeArrayOut cell_tri_count,
                                 WholeArrayIn edgeData);
   using ExecutionSignature = void(ThreadIndices, _2, _3, _4, _5, _6, Device);
   using InputDomain = _1;
 
   template <typename ThreadIndices,
             typename WholeSumField,
-            typename FieldInPointId,
+            typename WholeAxisField,
+            typename WholeTriField,
             typename WholeEdgeField,
             typename Device>
   VTKM_EXEC void operator()(const ThreadIndices& threadIndices,
                             const WholeSumField& axis_sums,
-                            const FieldInPointId& axis_mins,
-                            const FieldInPointId& axis_maxs,
-                            vtkm::Int32& cell_tri_count,
+                            const WholeAxisField& axis_mins,
+                            const WholeAxisField& axis_maxs,
+                            const WholeTriField& cell_tri_counts,
                             const WholeEdgeField& edges,
                             Device) const
   {
@@ -62,9 +67,62 @@ struct ComputePass2 : public vtkm::worklet::WorkletVisitCellsWithPoints
     const vtkm::Id3 ijk = compute_ijk(AxisToSum{}, threadIndices.GetInputIndex3D());
     const vtkm::Id3 pdims = this->PointDims;
 
-    const vtkm::Id4 startPos = compute_neighbor_starts(AxisToSum{}, ijk, pdims);
+    const vtkm::Id4 rowStartPos = compute_neighbor_starts(AxisToSum{}, ijk, pdims);
     const vtkm::Id axis_inc = compute_inc(AxisToSum{}, pdims);
 
+    const vtkm::Id numPoints = pdims[0] * pdims[1] * pdims[2];
+    const vtkm::Id numRows = pdims[AxisToSum::yindex] * pdims[AxisToSum::zindex];
+    const vtkm::Id numCells = (pdims[AxisToSum::yindex] - 1) * (pdims[AxisToSum::zindex] - 1);
+    const auto rows = threadIndices.GetIndicesIncident();
+
+    for (vtkm::Id k = 0; k < this->NumberOfIsoValues; ++k)
+    {
+      const vtkm::Id rowOffset = k * numRows;
+      const vtkm::Id4 startPos = rowStartPos + vtkm::Id4(k * numPoints);
+      const vtkm::Id4 mins(axis_mins.Get(rows[0] + rowOffset),
+                           axis_mins.Get(rows[1] + rowOffset),
+                           axis_mins.Get(rows[2] + rowOffset),
+                           axis_mins.Get(rows[3] + rowOffset));
+      const vtkm::Id4 maxs(axis_maxs.Get(rows[0] + rowOffset),
+                           axis_maxs.Get(rows[1] + rowOffset),
+                           axis_maxs.Get(rows[2] + rowOffset),
+                           axis_maxs.Get(rows[3] + rowOffset));
+      vtkm::Int32 cell_tri_count = 0;
+      this->CountRow(AxisToSum{},
+                     ijk,
+                     rows[0] + rowOffset,
+                     rows[1] + rowOffset,
+                     rows[3] + rowOffset,
+                     axis_sums,
+                     mins,
+                     maxs,
+                     cell_tri_count,
+                     edges,
+                     startPos,
+                     axis_inc);
+      cell_tri_counts.Set(threadIndices.GetInputIndex() + (k * numCells), cell_tri_count);
+    }
+  }
+
+  //----------------------------------------------------------------------------
+  // Count the triangles and the y- and z-axis intersections of one voxel row
+  // for a single iso-value.
+  template <typename AxisToSum, typename WholeSumField, typename WholeEdgeField>
+  VTKM_EXEC inline void CountRow(AxisToSum,
+                                 const vtkm::Id3& ijk,
+                                 vtkm::Id row,
+                                 vtkm::Id adjRow,
+                                 vtkm::Id adjCol,
+                                 const WholeSumField& axis_sums,
+                                 const vtkm::Id4& axis_mins,
+                                 const vtkm::Id4& axis_maxs,
+                                 vtkm::Int32& cell_tri_count,
+                                 const WholeEdgeField& edges,
+                                 const vtkm::Id4& startPos,
+                                 vtkm::Id axis_inc) const
+  {
+    const vtkm::Id3 pdims = this->PointDims;
+
     // Compute the subset (start and end) of the row that we need
     // to iterate to generate triangles for the iso-surface
     vtkm::Id left, right;
@@ -79,17 +137,16 @@ struct ComputePass2 : public vtkm::worklet::WorkletVisitCellsWithPoints
     onBoundary[AxisToSum::yindex] = (ijk[AxisToSum::yindex] >= (pdims[AxisToSum::yindex] - 2));
     onBoundary[AxisToSum::zindex] = (ijk[AxisToSum::zindex] >= (pdims[AxisToSum::zindex] - 2));
 
-    cell_tri_count = 0;
-    vtkm::Id3 sums = axis_sums.Get(threadIndices.GetIndicesIncident()[0]);
+    vtkm::Id3 sums = axis_sums.Get(row);
     vtkm::Id3 adj_row_sum(0, 0, 0);
     vtkm::Id3 adj_col_sum(0, 0, 0);
     if (onBoundary[AxisToSum::yindex])
     {
-      adj_row_sum = axis_sums.Get(threadIndices.GetIndicesIncident()[1]);
+      adj_row_sum = axis_sums.Get(adjRow);
     }
     if (onBoundary[AxisToSum::zindex])
     {
-      adj_col_sum = axis_sums.Get(threadIndices.GetIndicesIncident()[3]);
+      adj_col_sum = axis_sums.Get(adjCol);
     }
 
     for (vtkm::Id i = left; i < right; ++i) // run along the trimmed voxels
@@ -118,14 +175,14 @@ struct ComputePass2 : public vtkm::worklet::WorkletVisitCellsWithPoints
       }
     }
 
-    axis_sums.Set(threadIndices.GetIndicesIncident()[0], sums);
+    axis_sums.Set(row, sums);
     if (onBoundary[AxisToSum::yindex])
     {
-      axis_sums.Set(threadIndices.GetIndicesIncident()[1], adj_row_sum);
+      axis_sums.Set(adjRow, adj_row_sum);
     }
     if (onBoundary[AxisToSum::zindex])
     {
-      axis_sums.Set(threadIndices.GetIndicesIncident()[3], adj_col_sum);
+      axis_sums.Set(adjCol, adj_col_sum);
     }
   }
 
@@ -18,6 +18,11 @@
 #include <vtkm/filter/contour/worklet/contour/FlyingEdgesPass4XWithNormals.h>
 #include <vtkm/filter/contour/worklet/contour/FlyingEdgesPass4Y.h>
 
+#include <vtkm/cont/ArrayGetValues.h>
+#include <vtkm/cont/ArrayHandleView.h>
+
+#include <vector>
+
 namespace vtkm
 {
 namespace worklet
@@ -28,37 +33,75 @@ namespace flying_edges
 struct launchComputePass4
 {
   vtkm::Id3 PointDims;
-  vtkm::Vec3f Origin;
-  vtkm::Vec3f Spacing;
 
   vtkm::Id CellWriteOffset;
   vtkm::Id PointWriteOffset;
 
   launchComputePass4(const vtkm::Id3& pdims,
-                     const vtkm::Vec3f& origin,
-                     const vtkm::Vec3f& spacing,
                      vtkm::Id multiContourCellOffset,
                      vtkm::Id multiContourPointOffset)
     : PointDims(pdims)
-    , Origin(origin)
-    , Spacing(spacing)
     , CellWriteOffset(multiContourCellOffset)
     , PointWriteOffset(multiContourPointOffset)
   {
   }
 
+  // The meta data of the iso-values of a batch is stacked (see ComputePass1) and was
+  // scanned as a single array, so the offsets stored in it already account for the output
+  // of the previous iso-values of the batch. Call `functor` with the slice of every
+  // iso-value that generates triangles.
+  template <typename T, typename MeshSums, typename Functor>
+  VTKM_CONT void ForEachIsoValue(const std::vector<T>& isovalues,
+                                 const vtkm::cont::ArrayHandle<vtkm::UInt8>& edgeCases,
+                                 const vtkm::cont::CellSetStructured<2>& metaDataMesh2D,
+                                 const MeshSums& metaDataSums,
+                                 const vtkm::cont::ArrayHandle<vtkm::Id>& metaDataMin,
+                                 const vtkm::cont::ArrayHandle<vtkm::Id>& metaDataMax,
+                                 const vtkm::cont::ArrayHandle<vtkm::Int32>& metaDataNumTris,
+                                 Functor&& functor) const
+  {
+    const vtkm::Id numIsoValues = static_cast<vtkm::Id>(isovalues.size());
+    const vtkm::Id numPoints = this->PointDims[0] * this->PointDims[1] * this->PointDims[2];
+    const vtkm::Id numRows = metaDataMesh2D.GetNumberOfPoints();
+    const vtkm::Id numCells = metaDataMesh2D.GetNumberOfCells();
+
+    std::vector<vtkm::Id> starts(isovalues.size() + 1);
+    for (vtkm::Id k = 0; k <= numIsoValues; ++k)
+    {
+      starts[static_cast<std::size_t>(k)] = k * numCells;
+    }
+    std::vector<vtkm::Int32> triOffsets = vtkm::cont::ArrayGetValues(
+      vtkm::cont::make_ArrayHandle(starts, vtkm::CopyFlag::Off), metaDataNumTris);
+
+    for (vtkm::Id k = 0; k < numIsoValues; ++k)
+    {
+      const std::size_t index = static_cast<std::size_t>(k);
+      if (triOffsets[index] == triOffsets[index + 1])
+      {
+        continue;
+      }
+      functor(isovalues[index],
+              vtkm::cont::make_ArrayHandleView(edgeCases, k * numPoints, numPoints),
+              vtkm::cont::make_ArrayHandleView(metaDataSums, k * numRows, numRows),
+              vtkm::cont::make_ArrayHandleView(metaDataMin, k * numRows, numRows),
+              vtkm::cont::make_ArrayHandleView(metaDataMax, k * numRows, numRows),
+              vtkm::cont::make_ArrayHandleView(metaDataNumTris, k * numCells, numCells + 1));
+    }
+  }
+
   template <typename DeviceAdapterTag,
             typename T,
             typename StorageTagField,
             typename MeshSums,
             typename PointType,
-            typename NormalType>
+            typename NormalType,
+            typename CoordsType>
   VTKM_CONT bool LaunchXAxis(DeviceAdapterTag device,
                              vtkm::Id vtkmNotUsed(newPointSize),
-                             T isoval,
+                             const std::vector<T>& isovalues,
                              const vtkm::cont::ArrayHandle<T, StorageTagField>& inputField,
-                             vtkm::cont::ArrayHandle<vtkm::UInt8> edgeCases,
-                             vtkm::cont::CellSetStructured<2>& metaDataMesh2D,
+                             const vtkm::cont::ArrayHandle<vtkm::UInt8>& edgeCases,
+                             const vtkm::cont::CellSetStructured<2>& metaDataMesh2D,
                              const MeshSums& metaDataSums,
                              const vtkm::cont::ArrayHandle<vtkm::Id>& metaDataMin,
                              const vtkm::cont::ArrayHandle<vtkm::Id>& metaDataMax,
@@ -66,54 +109,64 @@ struct launchComputePass4
                              vtkm::worklet::contour::CommonState& sharedState,
                              vtkm::cont::ArrayHandle<vtkm::Id>& triangle_topology,
                              PointType& points,
-                             NormalType& normals) const
+                             NormalType& normals,
+                             const CoordsType& coords) const
   {
     vtkm::cont::Invoker invoke(device);
-    if (sharedState.GenerateNormals)
-    {
-      ComputePass4XWithNormals<T> worklet4(isoval,
-                                           this->PointDims,
-                                           this->Origin,
-                                           this->Spacing,
-                                           this->CellWriteOffset,
-                                           this->PointWriteOffset);
-      invoke(worklet4,
-             metaDataMesh2D,
-             metaDataSums,
-             metaDataMin,
-             metaDataMax,
-             metaDataNumTris,
-             edgeCases,
-             inputField,
-             triangle_topology,
-             sharedState.InterpolationEdgeIds,
-             sharedState.InterpolationWeights,
-             sharedState.CellIdMap,
-             points,
-             normals);
-    }
-    else
-    {
-      ComputePass4X<T> worklet4(isoval,
-                                this->PointDims,
-                                this->Origin,
-                                this->Spacing,
-                                this->CellWriteOffset,
-                                this->PointWriteOffset);
-      invoke(worklet4,
-             metaDataMesh2D,
-             metaDataSums,
-             metaDataMin,
-             metaDataMax,
-             metaDataNumTris,
-             edgeCases,
-             inputField,
-             triangle_topology,
-             sharedState.InterpolationEdgeIds,
-             sharedState.InterpolationWeights,
-             sharedState.CellIdMap,
-             points);
-    }
+    auto pass4 = [&](T isoval,
+                     const auto& layerEdgeCases,
+                     const auto& layerSums,
+                     const auto& layerMin,
+                     const auto& layerMax,
+                     const auto& layerNumTris) {
+      if (sharedState.GenerateNormals)
+      {
+        ComputePass4XWithNormals<T> worklet4(
+          isoval, this->PointDims, this->CellWriteOffset, this->PointWriteOffset);
+        invoke(worklet4,
+               metaDataMesh2D,
+               layerSums,
+               layerMin,
+               layerMax,
+               layerNumTris,
+               layerEdgeCases,
+               inputField,
+               triangle_topology,
+               sharedState.InterpolationEdgeIds,
+               sharedState.InterpolationWeights,
+               sharedState.CellIdMap,
+               points,
+               normals,
+               coords);
+      }
+      else
+      {
+        ComputePass4X<T> worklet4(
+          isoval, this->PointDims, this->CellWriteOffset, this->PointWriteOffset);
+        invoke(worklet4,
+               metaDataMesh2D,
+               layerSums,
+               layerMin,
+               layerMax,
+               layerNumTris,
+               layerEdgeCases,
+               inputField,
+               triangle_topology,
+               sharedState.InterpolationEdgeIds,
+               sharedState.InterpolationWeights,
+               sharedState.CellIdMap,
+               points,
+               coords);
+      }
+    };
+    this->ForEachIsoValue(isovalues,
+                          edgeCases,
+                          metaDataMesh2D,
+                          metaDataSums,
+                          metaDataMin,
+                          metaDataMax,
+                          metaDataNumTris,
+                          pass4);
 
     return true;
   }
@@ -123,13 +176,14 @@ struct launchComputePass4
             typename StorageTagField,
             typename MeshSums,
             typename PointType,
-            typename NormalType>
+            typename NormalType,
+            typename CoordsType>
   VTKM_CONT bool LaunchYAxis(DeviceAdapterTag device,
                              vtkm::Id newPointSize,
-                             T isoval,
+                             const std::vector<T>& isovalues,
                              const vtkm::cont::ArrayHandle<T, StorageTagField>& inputField,
-                             vtkm::cont::ArrayHandle<vtkm::UInt8> edgeCases,
-                             vtkm::cont::CellSetStructured<2>& metaDataMesh2D,
+                             const vtkm::cont::ArrayHandle<vtkm::UInt8>& edgeCases,
+                             const vtkm::cont::CellSetStructured<2>& metaDataMesh2D,
                              const MeshSums& metaDataSums,
                              const vtkm::cont::ArrayHandle<vtkm::Id>& metaDataMin,
                              const vtkm::cont::ArrayHandle<vtkm::Id>& metaDataMax,
@@ -137,31 +191,42 @@ struct launchComputePass4
                              vtkm::worklet::contour::CommonState& sharedState,
                              vtkm::cont::ArrayHandle<vtkm::Id>& triangle_topology,
                              PointType& points,
-                             NormalType& normals) const
+                             NormalType& normals,
+                             const CoordsType& coords) const
   {
     vtkm::cont::Invoker invoke(device);
+    auto pass4 = [&](T isoval,
+                     const auto& layerEdgeCases,
+                     const auto& layerSums,
+                     const auto& layerMin,
+                     const auto& layerMax,
+                     const auto& layerNumTris) {
+      ComputePass4Y<T> worklet4(
+        isoval, this->PointDims, this->CellWriteOffset, this->PointWriteOffset);
+      invoke(worklet4,
+             metaDataMesh2D,
+             layerSums,
+             layerMin,
+             layerMax,
+             layerNumTris,
+             layerEdgeCases,
+             inputField,
+             triangle_topology,
+             sharedState.InterpolationEdgeIds,
+             sharedState.InterpolationWeights,
+             sharedState.CellIdMap);
+    };
+    this->ForEachIsoValue(isovalues,
+                          edgeCases,
+                          metaDataMesh2D,
+                          metaDataSums,
+                          metaDataMin,
+                          metaDataMax,
+                          metaDataNumTris,
+                          pass4);
 
-    ComputePass4Y<T> worklet4(
-      isoval, this->PointDims, this->CellWriteOffset, this->PointWriteOffset);
-    invoke(worklet4,
-           metaDataMesh2D,
-           metaDataSums,
-           metaDataMin,
-           metaDataMax,
-           metaDataNumTris,
-           edgeCases,
-           inputField,
-           triangle_topology,
-           sharedState.InterpolationEdgeIds,
-           sharedState.InterpolationWeights,
-           sharedState.CellIdMap);
-
-    //This needs to be done on array handle view ( start = this->PointWriteOffset, len = newPointSize)
-    ComputePass5Y<T> worklet5(this->PointDims,
-                              this->Origin,
-                              this->Spacing,
-                              this->PointWriteOffset,
-                              sharedState.GenerateNormals);
+    // The points of all iso-values of the batch are interpolated at once.
+    ComputePass5Y<T> worklet5(this->PointDims, this->PointWriteOffset, sharedState.GenerateNormals);
     invoke(worklet5,
            vtkm::cont::make_ArrayHandleView(
              sharedState.InterpolationEdgeIds, this->PointWriteOffset, newPointSize),
@@ -169,7 +234,8 @@ struct launchComputePass4
              sharedState.InterpolationWeights, this->PointWriteOffset, newPointSize),
            vtkm::cont::make_ArrayHandleView(points, this->PointWriteOffset, newPointSize),
            inputField,
-           normals);
+           normals,
+           coords);
 
     return true;
   }
@@ -13,6 +13,9 @@
 #ifndef vtk_m_worklet_contour_flyingedges_pass4_common_h
 #define vtk_m_worklet_contour_flyingedges_pass4_common_h
 
+#include <vtkm/VectorAnalysis.h>
+#include <vtkm/cont/ArrayHandleCartesianProduct.h>
+#include <vtkm/cont/ArrayHandleUniformPointCoordinates.h>
 #include <vtkm/filter/contour/worklet/contour/FlyingEdgesHelpers.h>
 #include <vtkm/filter/contour/worklet/contour/FlyingEdgesTables.h>
 
@@ -28,6 +31,67 @@ VTKM_EXEC inline vtkm::Id3 compute_incs3d(const vtkm::Id3& dims)
   return vtkm::Id3{ 1, dims[0], (dims[0] * dims[1]) };
 }
 
+// Helper functions to compute the coordinate of the point at parameter t on the edge
+// between the points ijk0 and ijk1.
+//----------------------------------------------------------------------------
+template <typename WholeCoordsField>
+VTKM_EXEC inline vtkm::Vec3f interpolate_coordinate(const WholeCoordsField& coords,
+                                                    const vtkm::Id3& pdims,
+                                                    vtkm::FloatDefault t,
+                                                    const vtkm::Id3& ijk0,
+                                                    const vtkm::Id3& ijk1)
+{
+  const vtkm::Id3 incs = compute_incs3d(pdims);
+  const vtkm::Vec3f p0(coords.Get(vtkm::Dot(ijk0, incs)));
+  const vtkm::Vec3f p1(coords.Get(vtkm::Dot(ijk1, incs)));
+  return vtkm::Lerp(p0, p1, t);
+}
+
+VTKM_EXEC inline vtkm::Vec3f interpolate_coordinate(
+  const vtkm::internal::ArrayPortalUniformPointCoordinates& coords,
+  const vtkm::Id3& vtkmNotUsed(pdims),
+  vtkm::FloatDefault t,
+  const vtkm::Id3& ijk0,
+  const vtkm::Id3& ijk1)
+{
+  const vtkm::Vec3f origin = coords.GetOrigin();
+  const vtkm::Vec3f spacing = coords.GetSpacing();
+  return vtkm::Vec3f(
+    origin[0] +
+      spacing[0] *
+        (static_cast<vtkm::FloatDefault>(ijk0[0]) +
+         t * static_cast<vtkm::FloatDefault>(ijk1[0] - ijk0[0])),
+    origin[1] +
+      spacing[1] *
+        (static_cast<vtkm::FloatDefault>(ijk0[1]) +
+         t * static_cast<vtkm::FloatDefault>(ijk1[1] - ijk0[1])),
+    origin[2] +
+      spacing[2] *
+        (static_cast<vtkm::FloatDefault>(ijk0[2]) +
+         t * static_cast<vtkm::FloatDefault>(ijk1[2] - ijk0[2])));
+}
+
+// Rectilinear grids only need to look up one value per axis.
+template <typename ValueType, typename PortalX, typename PortalY, typename PortalZ>
+VTKM_EXEC inline vtkm::Vec3f interpolate_coordinate(
+  const vtkm::internal::ArrayPortalCartesianProduct<ValueType, PortalX, PortalY, PortalZ>& coords,
+  const vtkm::Id3& vtkmNotUsed(pdims),
+  vtkm::FloatDefault t,
+  const vtkm::Id3& ijk0,
+  const vtkm::Id3& ijk1)
+{
+  const auto& x = coords.GetFirstPortal();
+  const auto& y = coords.GetSecondPortal();
+  const auto& z = coords.GetThirdPortal();
+  return vtkm::Lerp(vtkm::Vec3f(static_cast<vtkm::FloatDefault>(x.Get(ijk0[0])),
+                                static_cast<vtkm::FloatDefault>(y.Get(ijk0[1])),
+                                static_cast<vtkm::FloatDefault>(z.Get(ijk0[2]))),
+                    vtkm::Vec3f(static_cast<vtkm::FloatDefault>(x.Get(ijk1[0])),
+                                static_cast<vtkm::FloatDefault>(y.Get(ijk1[1])),
+                                static_cast<vtkm::FloatDefault>(z.Get(ijk1[2]))),
+                    t);
+}
+
 VTKM_EXEC inline constexpr vtkm::Id increment_cellId(SumXAxis, vtkm::Id cellId, vtkm::Id)
 {
   return cellId + 1;
@@ -15,6 +15,7 @@
 
 
 #include <vtkm/filter/contour/worklet/contour/FlyingEdgesHelpers.h>
+#include <vtkm/filter/contour/worklet/contour/FlyingEdgesPass4Common.h>
 #include <vtkm/filter/contour/worklet/contour/FlyingEdgesTables.h>
 
 namespace vtkm
@@ -29,8 +30,6 @@ struct ComputePass4X : public vtkm::worklet::WorkletVisitCellsWithPoints
 {
 
   vtkm::Id3 PointDims;
-  vtkm::Vec3f Origin;
-  vtkm::Vec3f Spacing;
 
   T IsoValue;
 
@@ -40,13 +39,9 @@ struct ComputePass4X : public vtkm::worklet::WorkletVisitCellsWithPoints
   ComputePass4X() {}
   ComputePass4X(T value,
                 const vtkm::Id3& pdims,
-                const vtkm::Vec3f& origin,
-                const vtkm::Vec3f& spacing,
                 vtkm::Id multiContourCellOffset,
                 vtkm::Id multiContourPointOffset)
     : PointDims(pdims)
-    , Origin(origin)
-    , Spacing(spacing)
     , IsoValue(value)
     , CellWriteOffset(multiContourCellOffset)
     , PointWriteOffset(multiContourPointOffset)
@@ -64,9 +59,10 @@ struct ComputePass4X : public vtkm::worklet::WorkletVisitCellsWithPoints
                                 WholeArrayOut edgeIds,
                                 WholeArrayOut weights,
                                 WholeArrayOut inputCellIds,
-                                WholeArrayOut points);
+                                WholeArrayOut points,
+                                WholeArrayIn coords);
   using ExecutionSignature =
-    void(ThreadIndices, _2, _3, _4, _5, _6, _7, _8, _9, _10, _11, _12, WorkIndex);
+    void(ThreadIndices, _2, _3, _4, _5, _6, _7, _8, _9, _10, _11, _12, _13, WorkIndex);
 
   template <typename ThreadIndices,
             typename FieldInPointId3,
@@ -78,7 +74,8 @@ struct ComputePass4X : public vtkm::worklet::WorkletVisitCellsWithPoints
             typename WholeEdgeIdField,
             typename WholeWeightField,
             typename WholeCellIdField,
-            typename WholePointField>
+            typename WholePointField,
+            typename WholeCoordsField>
   VTKM_EXEC void operator()(const ThreadIndices& threadIndices,
                             const FieldInPointId3& axis_sums,
                             const FieldInPointId& axis_mins,
@@ -91,6 +88,7 @@ struct ComputePass4X : public vtkm::worklet::WorkletVisitCellsWithPoints
                             const WholeWeightField& weights,
                             const WholeCellIdField& inputCellIds,
                             const WholePointField& points,
+                            const WholeCoordsField& coords,
                             vtkm::Id oidx) const
   {
     using AxisToSum = SumXAxis;
@@ -139,6 +137,7 @@ struct ComputePass4X : public vtkm::worklet::WorkletVisitCellsWithPoints
                          interpolatedEdgeIds,
                          weights,
                          points,
+                         coords,
                          state.startPos,
                          increments,
                          (state.axis_inc * i),
@@ -155,13 +154,15 @@ struct ComputePass4X : public vtkm::worklet::WorkletVisitCellsWithPoints
   template <typename WholeDataField,
             typename WholeIEdgeField,
             typename WholeWeightField,
-            typename WholePointField>
+            typename WholePointField,
+            typename WholeCoordsField>
   VTKM_EXEC inline void Generate(const vtkm::Vec<vtkm::UInt8, 3>& boundaryStatus,
                                  const vtkm::Id3& ijk,
                                  const WholeDataField& field,
                                  const WholeIEdgeField& interpolatedEdgeIds,
                                  const WholeWeightField& weights,
                                  const WholePointField& points,
+                                 const WholeCoordsField& coords,
                                  const vtkm::Id4& startPos,
                                  const vtkm::Id3& incs,
                                  vtkm::Id offset,
@@ -185,7 +186,7 @@ struct ComputePass4X : public vtkm::worklet::WorkletVisitCellsWithPoints
         interpolatedEdgeIds.Set(writeIndex, pos);
         weights.Set(writeIndex, static_cast<vtkm::FloatDefault>(t));
 
-        auto coord = this->InterpolateCoordinate(t, ijk, ijk + vtkm::Id3{ 1, 0, 0 });
+        auto coord = this->InterpolateCoordinate(coords, t, ijk, ijk + vtkm::Id3{ 1, 0, 0 });
         points.Set(writeIndex, coord);
       }
       if (edgeUses[4])
@@ -198,7 +199,7 @@ struct ComputePass4X : public vtkm::worklet::WorkletVisitCellsWithPoints
         interpolatedEdgeIds.Set(writeIndex, pos);
         weights.Set(writeIndex, static_cast<vtkm::FloatDefault>(t));
 
-        auto coord = this->InterpolateCoordinate(t, ijk, ijk + vtkm::Id3{ 0, 1, 0 });
+        auto coord = this->InterpolateCoordinate(coords, t, ijk, ijk + vtkm::Id3{ 0, 1, 0 });
         points.Set(writeIndex, coord);
       }
       if (edgeUses[8])
@@ -211,7 +212,7 @@ struct ComputePass4X : public vtkm::worklet::WorkletVisitCellsWithPoints
         interpolatedEdgeIds.Set(writeIndex, pos);
         weights.Set(writeIndex, static_cast<vtkm::FloatDefault>(t));
 
-        auto coord = this->InterpolateCoordinate(t, ijk, ijk + vtkm::Id3{ 0, 0, 1 });
+        auto coord = this->InterpolateCoordinate(coords, t, ijk, ijk + vtkm::Id3{ 0, 0, 1 });
         points.Set(writeIndex, coord);
       }
     }
@@ -228,30 +229,30 @@ struct ComputePass4X : public vtkm::worklet::WorkletVisitCellsWithPoints
     const bool onZ = boundaryStatus[AxisToSum::zindex] & FlyingEdges3D::MaxBoundary;
     if (onX) //+x boundary
     {
-      this->InterpolateEdge(ijk, pos[0], incs, 5, edgeUses, edgeIds, field, interpolatedEdgeIds, weights, points);
-      this->InterpolateEdge(ijk, pos[0], incs, 9, edgeUses, edgeIds, field, interpolatedEdgeIds, weights, points);
+      this->InterpolateEdge(ijk, pos[0], incs, 5, edgeUses, edgeIds, field, interpolatedEdgeIds, weights, points, coords);
+      this->InterpolateEdge(ijk, pos[0], incs, 9, edgeUses, edgeIds, field, interpolatedEdgeIds, weights, points, coords);
       if (onY) //+x +y
       {
-        this->InterpolateEdge(ijk, pos[0], incs, 11, edgeUses, edgeIds, field, interpolatedEdgeIds, weights, points);
+        this->InterpolateEdge(ijk, pos[0], incs, 11, edgeUses, edgeIds, field, interpolatedEdgeIds, weights, points, coords);
       }
       if (onZ) //+x +z
       {
-        this->InterpolateEdge(ijk, pos[0], incs, 7, edgeUses, edgeIds, field, interpolatedEdgeIds, weights, points);
+        this->InterpolateEdge(ijk, pos[0], incs, 7, edgeUses, edgeIds, field, interpolatedEdgeIds, weights, points, coords);
       }
     }
     if (onY) //+y boundary
     {
-      this->InterpolateEdge(ijk, pos[0], incs, 1, edgeUses, edgeIds, field, interpolatedEdgeIds, weights, points);
-      this->InterpolateEdge(ijk, pos[0], incs, 10, edgeUses, edgeIds, field, interpolatedEdgeIds, weights, points);
+      this->InterpolateEdge(ijk, pos[0], incs, 1, edgeUses, edgeIds, field, interpolatedEdgeIds, weights, points, coords);
+      this->InterpolateEdge(ijk, pos[0], incs, 10, edgeUses, edgeIds, field, interpolatedEdgeIds, weights, points, coords);
       if (onZ) //+y +z boundary
       {
-        this->InterpolateEdge(ijk, pos[0], incs, 3, edgeUses, edgeIds, field, interpolatedEdgeIds, weights, points);
+        this->InterpolateEdge(ijk, pos[0], incs, 3, edgeUses, edgeIds, field, interpolatedEdgeIds, weights, points, coords);
       }
     }
     if (onZ) //+z boundary
     {
-      this->InterpolateEdge(ijk, pos[0], incs, 2, edgeUses, edgeIds, field, interpolatedEdgeIds, weights, points);
-      this->InterpolateEdge(ijk, pos[0], incs, 6, edgeUses, edgeIds, field, interpolatedEdgeIds, weights, points);
+      this->InterpolateEdge(ijk, pos[0], incs, 2, edgeUses, edgeIds, field, interpolatedEdgeIds, weights, points, coords);
+      this->InterpolateEdge(ijk, pos[0], incs, 6, edgeUses, edgeIds, field, interpolatedEdgeIds, weights, points, coords);
     }
     // clang-format on
   }
@@ -261,7 +262,8 @@ struct ComputePass4X : public vtkm::worklet::WorkletVisitCellsWithPoints
   template <typename WholeField,
             typename WholeIEdgeField,
             typename WholeWeightField,
-            typename WholePointField>
+            typename WholePointField,
+            typename WholeCoordsField>
   VTKM_EXEC inline void InterpolateEdge(const vtkm::Id3& ijk,
                                         vtkm::Id currentIdx,
                                         const vtkm::Id3& incs,
@@ -271,7 +273,8 @@ struct ComputePass4X : public vtkm::worklet::WorkletVisitCellsWithPoints
                                         const WholeField& field,
                                         const WholeIEdgeField& interpolatedEdgeIds,
                                         const WholeWeightField& weights,
-                                        const WholePointField& points) const
+                                        const WholePointField& points,
+                                        const WholeCoordsField& coords) const
   {
     using AxisToSum = SumXAxis;
 
@@ -297,29 +300,19 @@ struct ComputePass4X : public vtkm::worklet::WorkletVisitCellsWithPoints
     T t = static_cast<T>((this->IsoValue - s0) / (s1 - s0));
     weights.Set(writeIndex, static_cast<vtkm::FloatDefault>(t));
 
-    auto coord = this->InterpolateCoordinate(t, ijk + offsets1, ijk + offsets2);
+    auto coord = this->InterpolateCoordinate(coords, t, ijk + offsets1, ijk + offsets2);
     points.Set(writeIndex, coord);
   }
 
   //----------------------------------------------------------------------------
-  inline VTKM_EXEC vtkm::Vec3f InterpolateCoordinate(T t,
+  template <typename WholeCoordsField>
+  inline VTKM_EXEC vtkm::Vec3f InterpolateCoordinate(const WholeCoordsField& coords,
+                                                     T t,
                                                      const vtkm::Id3& ijk0,
                                                      const vtkm::Id3& ijk1) const
   {
-    return vtkm::Vec3f(
-      this->Origin[0] +
-        this->Spacing[0] *
-          (static_cast<vtkm::FloatDefault>(ijk0[0]) +
-           static_cast<vtkm::FloatDefault>(t) * static_cast<vtkm::FloatDefault>(ijk1[0] - ijk0[0])),
-      this->Origin[1] +
-        this->Spacing[1] *
-          (static_cast<vtkm::FloatDefault>(ijk0[1]) +
-           static_cast<vtkm::FloatDefault>(t) * static_cast<vtkm::FloatDefault>(ijk1[1] - ijk0[1])),
-      this->Origin[2] +
-        this->Spacing[2] *
-          (static_cast<vtkm::FloatDefault>(ijk0[2]) +
-           static_cast<vtkm::FloatDefault>(t) *
-             static_cast<vtkm::FloatDefault>(ijk1[2] - ijk0[2])));
+    return interpolate_coordinate(
+      coords, this->PointDims, static_cast<vtkm::FloatDefault>(t), ijk0, ijk1);
   }
 };
 }
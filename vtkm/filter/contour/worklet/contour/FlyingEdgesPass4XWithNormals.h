@@ -15,9 +15,10 @@
 
 
 #include <vtkm/filter/contour/worklet/contour/FlyingEdgesHelpers.h>
+#include <vtkm/filter/contour/worklet/contour/FlyingEdgesPass4Common.h>
 #include <vtkm/filter/contour/worklet/contour/FlyingEdgesTables.h>
 
-#include <vtkm/filter/contour/worklet/contour/FlyingEdgesPass4.h>
+#include <vtkm/filter/vector_analysis/worklet/gradient/StructuredPointGradient.h>
 
 namespace vtkm
 {
@@ -31,8 +32,6 @@ struct ComputePass4XWithNormals : public vtkm::worklet::WorkletVisitCellsWithPoi
 {
 
   vtkm::Id3 PointDims;
-  vtkm::Vec3f Origin;
-  vtkm::Vec3f Spacing;
 
   T IsoValue;
 
@@ -42,13 +41,9 @@ struct ComputePass4XWithNormals : public vtkm::worklet::WorkletVisitCellsWithPoi
   ComputePass4XWithNormals() {}
   ComputePass4XWithNormals(T value,
                            const vtkm::Id3& pdims,
-                           const vtkm::Vec3f& origin,
-                           const vtkm::Vec3f& spacing,
                            vtkm::Id multiContourCellOffset,
                            vtkm::Id multiContourPointOffset)
     : PointDims(pdims)
-    , Origin(origin)
-    , Spacing(spacing)
     , IsoValue(value)
     , CellWriteOffset(multiContourCellOffset)
     , PointWriteOffset(multiContourPointOffset)
@@ -67,9 +62,10 @@ struct ComputePass4XWithNormals : public vtkm::worklet::WorkletVisitCellsWithPoi
                                 WholeArrayOut weights,
                                 WholeArrayOut inputCellIds,
                                 WholeArrayOut points,
-                                WholeArrayOut normals);
+                                WholeArrayOut normals,
+                                WholeArrayIn coords);
   using ExecutionSignature =
-    void(ThreadIndices, _2, _3, _4, _5, _6, _7, _8, _9, _10, _11, _12, _13, WorkIndex);
+    void(ThreadIndices, _2, _3, _4, _5, _6, _7, _8, _9, _10, _11, _12, _13, _14, WorkIndex);
 
   template <typename ThreadIndices,
             typename FieldInPointId3,
@@ -82,7 +78,8 @@ struct ComputePass4XWithNormals : public vtkm::worklet::WorkletVisitCellsWithPoi
             typename WholeWeightField,
             typename WholeCellIdField,
             typename WholePointField,
-            typename WholeNormalsField>
+            typename WholeNormalsField,
+            typename WholeCoordsField>
   VTKM_EXEC void operator()(const ThreadIndices& threadIndices,
                             const FieldInPointId3& axis_sums,
                             const FieldInPointId& axis_mins,
@@ -96,6 +93,7 @@ struct ComputePass4XWithNormals : public vtkm::worklet::WorkletVisitCellsWithPoi
                             const WholeCellIdField& inputCellIds,
                             const WholePointField& points,
                             const WholeNormalsField& normals,
+                            const WholeCoordsField& coords,
                             vtkm::Id oidx) const
   {
     using AxisToSum = SumXAxis;
@@ -146,6 +144,7 @@ struct ComputePass4XWithNormals : public vtkm::worklet::WorkletVisitCellsWithPoi
                          weights,
                          points,
                          normals,
+                         coords,
                          state.startPos,
                          increments,
                          (state.axis_inc * i),
@@ -163,7 +162,8 @@ struct ComputePass4XWithNormals : public vtkm::worklet::WorkletVisitCellsWithPoi
             typename WholeIEdgeField,
             typename WholeWeightField,
             typename WholePointField,
-            typename WholeNormalField>
+            typename WholeNormalField,
+            typename WholeCoordsField>
   VTKM_EXEC inline void Generate(const vtkm::Vec<vtkm::UInt8, 3>& boundaryStatus,
                                  const vtkm::Id3& ijk,
                                  const WholeDataField& field,
@@ -171,6 +171,7 @@ struct ComputePass4XWithNormals : public vtkm::worklet::WorkletVisitCellsWithPoi
                                  const WholeWeightField& weights,
                                  const WholePointField& points,
                                  const WholeNormalField& normals,
+                                 const WholeCoordsField& coords,
                                  const vtkm::Id4& startPos,
                                  const vtkm::Id3& incs,
                                  vtkm::Id offset,
@@ -183,7 +184,7 @@ struct ComputePass4XWithNormals : public vtkm::worklet::WorkletVisitCellsWithPoi
     vtkm::Id2 pos(startPos[0] + offset, 0);
     {
       auto s0 = field.Get(pos[0]);
-      auto g0 = this->ComputeGradient(fullyInterior, ijk, incs, pos[0], field);
+      auto g0 = this->ComputeGradient(fullyInterior, ijk, incs, pos[0], field, coords);
 
       //EdgesUses 0,4,8 work for Y axis
       if (edgeUses[0])
@@ -197,11 +198,11 @@ struct ComputePass4XWithNormals : public vtkm::worklet::WorkletVisitCellsWithPoi
         weights.Set(writeIndex, static_cast<vtkm::FloatDefault>(t));
 
         auto ijk1 = ijk + vtkm::Id3{ 1, 0, 0 };
-        auto coord = this->InterpolateCoordinate(t, ijk, ijk1);
+        auto coord = this->InterpolateCoordinate(coords, t, ijk, ijk1);
         points.Set(writeIndex, coord);
 
         //gradient generation
-        auto g1 = this->ComputeGradient(fullyInterior, ijk1, incs, pos[1], field);
+        auto g1 = this->ComputeGradient(fullyInterior, ijk1, incs, pos[1], field, coords);
         g1 = g0 + (t * (g1 - g0));
         normals.Set(writeIndex, vtkm::Normal(g1));
       }
@@ -216,11 +217,11 @@ struct ComputePass4XWithNormals : public vtkm::worklet::WorkletVisitCellsWithPoi
         weights.Set(writeIndex, static_cast<vtkm::FloatDefault>(t));
 
         auto ijk1 = ijk + vtkm::Id3{ 0, 1, 0 };
-        auto coord = this->InterpolateCoordinate(t, ijk, ijk1);
+        auto coord = this->InterpolateCoordinate(coords, t, ijk, ijk1);
         points.Set(writeIndex, coord);
 
         //gradient generation
-        auto g1 = this->ComputeGradient(fullyInterior, ijk1, incs, pos[1], field);
+        auto g1 = this->ComputeGradient(fullyInterior, ijk1, incs, pos[1], field, coords);
         g1 = g0 + (t * (g1 - g0));
         normals.Set(writeIndex, vtkm::Normal(g1));
       }
@@ -235,11 +236,11 @@ struct ComputePass4XWithNormals : public vtkm::worklet::WorkletVisitCellsWithPoi
         weights.Set(writeIndex, static_cast<vtkm::FloatDefault>(t));
 
         auto ijk1 = ijk + vtkm::Id3{ 0, 0, 1 };
-        auto coord = this->InterpolateCoordinate(t, ijk, ijk1);
+        auto coord = this->InterpolateCoordinate(coords, t, ijk, ijk1);
         points.Set(writeIndex, coord);
 
         //gradient generation
-        auto g1 = this->ComputeGradient(fullyInterior, ijk1, incs, pos[1], field);
+        auto g1 = this->ComputeGradient(fullyInterior, ijk1, incs, pos[1], field, coords);
         g1 = g0 + (t * (g1 - g0));
         normals.Set(writeIndex, vtkm::Normal(g1));
       }
@@ -258,38 +259,38 @@ struct ComputePass4XWithNormals : public vtkm::worklet::WorkletVisitCellsWithPoi
     if (onX) //+x boundary
     {
       this->InterpolateEdge(
-          fullyInterior, ijk, pos[0], incs, 5, edgeUses, edgeIds, field, interpolatedEdgeIds, weights, points, normals);
+          fullyInterior, ijk, pos[0], incs, 5, edgeUses, edgeIds, field, interpolatedEdgeIds, weights, points, normals, coords);
       this->InterpolateEdge(
-          fullyInterior, ijk, pos[0], incs, 9, edgeUses, edgeIds, field, interpolatedEdgeIds, weights, points, normals);
+          fullyInterior, ijk, pos[0], incs, 9, edgeUses, edgeIds, field, interpolatedEdgeIds, weights, points, normals, coords);
       if (onY) //+x +y
       {
         this->InterpolateEdge(
-          fullyInterior, ijk, pos[0], incs, 11, edgeUses, edgeIds, field, interpolatedEdgeIds, weights, points, normals);
+          fullyInterior, ijk, pos[0], incs, 11, edgeUses, edgeIds, field, interpolatedEdgeIds, weights, points, normals, coords);
       }
       if (onZ) //+x +z
       {
         this->InterpolateEdge(
-          fullyInterior, ijk, pos[0], incs, 7, edgeUses, edgeIds, field, interpolatedEdgeIds, weights, points, normals);
+          fullyInterior, ijk, pos[0], incs, 7, edgeUses, edgeIds, field, interpolatedEdgeIds, weights, points, normals, coords);
       }
     }
     if (onY) //+y boundary
     {
       this->InterpolateEdge(
-        fullyInterior, ijk, pos[0], incs, 1, edgeUses, edgeIds, field, interpolatedEdgeIds, weights, points, normals);
+        fullyInterior, ijk, pos[0], incs, 1, edgeUses, edgeIds, field, interpolatedEdgeIds, weights, points, normals, coords);
       this->InterpolateEdge(
-        fullyInterior, ijk, pos[0], incs, 10, edgeUses, edgeIds, field, interpolatedEdgeIds, weights, points, normals);
+        fullyInterior, ijk, pos[0], incs, 10, edgeUses, edgeIds, field, interpolatedEdgeIds, weights, points, normals, coords);
       if (onZ) //+y +z boundary
       {
         this->InterpolateEdge(
-          fullyInterior, ijk, pos[0], incs, 3, edgeUses, edgeIds, field, interpolatedEdgeIds, weights, points, normals);
+          fullyInterior, ijk, pos[0], incs, 3, edgeUses, edgeIds, field, interpolatedEdgeIds, weights, points, normals, coords);
       }
     }
     if (onZ) //+z boundary
     {
       this->InterpolateEdge(
-        fullyInterior, ijk, pos[0], incs, 2, edgeUses, edgeIds, field, interpolatedEdgeIds, weights, points, normals);
+        fullyInterior, ijk, pos[0], incs, 2, edgeUses, edgeIds, field, interpolatedEdgeIds, weights, points, normals, coords);
       this->InterpolateEdge(
-        fullyInterior, ijk, pos[0], incs, 6, edgeUses, edgeIds, field, interpolatedEdgeIds, weights, points, normals);
+        fullyInterior, ijk, pos[0], incs, 6, edgeUses, edgeIds, field, interpolatedEdgeIds, weights, points, normals, coords);
     }
     // clang-format on
   }
@@ -300,7 +301,8 @@ struct ComputePass4XWithNormals : public vtkm::worklet::WorkletVisitCellsWithPoi
             typename WholeIEdgeField,
             typename WholeWeightField,
             typename WholePointField,
-            typename WholeNormalField>
+            typename WholeNormalField,
+            typename WholeCoordsField>
   VTKM_EXEC inline void InterpolateEdge(bool fullyInterior,
                                         const vtkm::Id3& ijk,
                                         vtkm::Id currentIdx,
@@ -312,7 +314,8 @@ struct ComputePass4XWithNormals : public vtkm::worklet::WorkletVisitCellsWithPoi
                                         const WholeIEdgeField& interpolatedEdgeIds,
                                         const WholeWeightField& weights,
                                         const WholePointField& points,
-                                        const WholeNormalField& normals) const
+                                        const WholeNormalField& normals,
+                                        const WholeCoordsField& coords) const
   {
     using AxisToSum = SumXAxis;
 
@@ -338,43 +341,36 @@ struct ComputePass4XWithNormals : public vtkm::worklet::WorkletVisitCellsWithPoi
     T t = static_cast<T>((this->IsoValue - s0) / (s1 - s0));
     weights.Set(writeIndex, static_cast<vtkm::FloatDefault>(t));
 
-    auto coord = this->InterpolateCoordinate(t, ijk + offsets1, ijk + offsets2);
+    auto coord = this->InterpolateCoordinate(coords, t, ijk + offsets1, ijk + offsets2);
     points.Set(writeIndex, coord);
 
-    auto g0 = this->ComputeGradient(fullyInterior, ijk + offsets1, incs, iEdge[0], field);
-    auto g1 = this->ComputeGradient(fullyInterior, ijk + offsets2, incs, iEdge[1], field);
+    auto g0 = this->ComputeGradient(fullyInterior, ijk + offsets1, incs, iEdge[0], field, coords);
+    auto g1 = this->ComputeGradient(fullyInterior, ijk + offsets2, incs, iEdge[1], field, coords);
     g1 = g0 + (t * (g1 - g0));
     normals.Set(writeIndex, vtkm::Normal(g1));
   }
 
   //----------------------------------------------------------------------------
-  inline VTKM_EXEC vtkm::Vec3f InterpolateCoordinate(T t,
+  template <typename WholeCoordsField>
+  inline VTKM_EXEC vtkm::Vec3f InterpolateCoordinate(const WholeCoordsField& coords,
+                                                     T t,
                                                      const vtkm::Id3& ijk0,
                                                      const vtkm::Id3& ijk1) const
   {
-    return vtkm::Vec3f(
-      this->Origin[0] +
-        this->Spacing[0] *
-          (static_cast<vtkm::FloatDefault>(ijk0[0]) +
-           static_cast<vtkm::FloatDefault>(t) * static_cast<vtkm::FloatDefault>(ijk1[0] - ijk0[0])),
-      this->Origin[1] +
-        this->Spacing[1] *
-          (static_cast<vtkm::FloatDefault>(ijk0[1]) +
-           static_cast<vtkm::FloatDefault>(t) * static_cast<vtkm::FloatDefault>(ijk1[1] - ijk0[1])),
-      this->Origin[2] +
-        this->Spacing[2] *
-          (static_cast<vtkm::FloatDefault>(ijk0[2]) +
-           static_cast<vtkm::FloatDefault>(t) *
-             static_cast<vtkm::FloatDefault>(ijk1[2] - ijk0[2])));
+    return interpolate_coordinate(
+      coords, this->PointDims, static_cast<vtkm::FloatDefault>(t), ijk0, ijk1);
   }
 
   //----------------------------------------------------------------------------
+  // Uniform grids: central differences in index space.
   template <typename WholeDataField>
-  VTKM_EXEC vtkm::Vec3f ComputeGradient(bool fullyInterior,
-                                        const vtkm::Id3& ijk,
-                                        const vtkm::Id3& incs,
-                                        vtkm::Id pos,
-                                        const WholeDataField& field) const
+  VTKM_EXEC vtkm::Vec3f ComputeGradient(
+    bool fullyInterior,
+    const vtkm::Id3& ijk,
+    const vtkm::Id3& incs,
+    vtkm::Id pos,
+    const WholeDataField& field,
+    const vtkm::internal::ArrayPortalUniformPointCoordinates& vtkmNotUsed(coords)) const
   {
     if (fullyInterior)
     {
@@ -409,6 +405,25 @@ struct ComputePass4XWithNormals : public vtkm::worklet::WorkletVisitCellsWithPoi
 
     return g;
   }
+
+  // Rectilinear and curvilinear grids: use the grid metrics to get the physical gradient.
+  template <typename WholeDataField, typename WholeCoordsField>
+  VTKM_EXEC vtkm::Vec3f ComputeGradient(bool vtkmNotUsed(fullyInterior),
+                                        const vtkm::Id3& ijk,
+                                        const vtkm::Id3& vtkmNotUsed(incs),
+                                        vtkm::Id vtkmNotUsed(pos),
+                                        const WholeDataField& field,
+                                        const WholeCoordsField& coords) const
+  {
+    vtkm::exec::BoundaryState boundary(ijk, this->PointDims);
+    vtkm::exec::FieldNeighborhood<WholeCoordsField> coordNeighborhood(coords, boundary);
+    vtkm::exec::FieldNeighborhood<WholeDataField> fieldNeighborhood(field, boundary);
+
+    vtkm::Vec3f g;
+    vtkm::worklet::gradient::StructuredPointGradient gradient;
+    gradient(boundary, coordNeighborhood, fieldNeighborhood, g);
+    return g;
+  }
 };
 }
 }
@@ -277,16 +277,12 @@ template <typename T>
 struct ComputePass5Y : public vtkm::worklet::WorkletMapField
 {
 
-  vtkm::internal::ArrayPortalUniformPointCoordinates Coordinates;
+  vtkm::Id3 PointDims;
   vtkm::Id NormalWriteOffset;
 
   ComputePass5Y() {}
-  ComputePass5Y(const vtkm::Id3& pdims,
-                const vtkm::Vec3f& origin,
-                const vtkm::Vec3f& spacing,
-                vtkm::Id normalWriteOffset,
-                bool generateNormals)
-    : Coordinates(pdims, origin, spacing)
+  ComputePass5Y(const vtkm::Id3& pdims, vtkm::Id normalWriteOffset, bool generateNormals)
+    : PointDims(pdims)
     , NormalWriteOffset(normalWriteOffset)
   {
     if (!generateNormals)
@@ -299,20 +295,25 @@ struct ComputePass5Y : public vtkm::worklet::WorkletMapField
                                 FieldIn interpWeight,
                                 FieldOut points,
                                 WholeArrayIn field,
-                                WholeArrayOut normals);
-  using ExecutionSignature = void(_1, _2, _3, _4, _5, WorkIndex);
-
-  template <typename PT, typename WholeInputField, typename WholeNormalField>
+                                WholeArrayOut normals,
+                                WholeArrayIn coords);
+  using ExecutionSignature = void(_1, _2, _3, _4, _5, _6, WorkIndex);
+
+  template <typename PT,
+            typename WholeInputField,
+            typename WholeNormalField,
+            typename WholeCoordsField>
   VTKM_EXEC void operator()(const vtkm::Id2& interpEdgeIds,
                             vtkm::FloatDefault weight,
                             vtkm::Vec<PT, 3>& outPoint,
                             const WholeInputField& field,
                             WholeNormalField& normals,
+                            const WholeCoordsField& coords,
                             vtkm::Id oidx) const
   {
     {
-      vtkm::Vec3f point1 = this->Coordinates.Get(interpEdgeIds[0]);
-      vtkm::Vec3f point2 = this->Coordinates.Get(interpEdgeIds[1]);
+      vtkm::Vec3f point1(coords.Get(interpEdgeIds[0]));
+      vtkm::Vec3f point2(coords.Get(interpEdgeIds[1]));
       outPoint = vtkm::Lerp(point1, point2, weight);
     }
 
@@ -320,15 +321,14 @@ struct ComputePass5Y : public vtkm::worklet::WorkletMapField
     if (this->NormalWriteOffset >= 0)
     {
       vtkm::Vec<T, 3> g0, g1;
-      const vtkm::Id3& dims = this->Coordinates.GetDimensions();
+      const vtkm::Id3& dims = this->PointDims;
       vtkm::Id3 ijk{ interpEdgeIds[0] % dims[0],
                      (interpEdgeIds[0] / dims[0]) % dims[1],
                      interpEdgeIds[0] / (dims[0] * dims[1]) };
 
       vtkm::worklet::gradient::StructuredPointGradient gradient;
       vtkm::exec::BoundaryState boundary(ijk, dims);
-      vtkm::exec::FieldNeighborhood<vtkm::internal::ArrayPortalUniformPointCoordinates>
-        coord_neighborhood(this->Coordinates, boundary);
+      vtkm::exec::FieldNeighborhood<WholeCoordsField> coord_neighborhood(coords, boundary);
 
       vtkm::exec::FieldNeighborhood<WholeInputField> field_neighborhood(field, boundary);
 
@@ -21,11 +21,14 @@
 #include <vtkm/cont/ArrayCopyDevice.h>
 #include <vtkm/cont/ArrayHandle.h>
 #include <vtkm/cont/ArrayHandleIndex.h>
+#include <vtkm/cont/ArrayHandlePermutation.h>
 #include <vtkm/cont/ArrayHandleTransform.h>
 #include <vtkm/cont/ArrayHandleZip.h>
+#include <vtkm/cont/ConcurrentHashTable.h>
 #include <vtkm/cont/Invoker.h>
 
 #include <vtkm/worklet/Keys.h>
+#include <vtkm/worklet/MergeDuplicateKeys.h>
 #include <vtkm/worklet/ScatterCounting.h>
 #include <vtkm/worklet/ScatterPermutation.h>
 
@@ -135,7 +138,7 @@ public:
                vtkm::cont::ArrayHandle<vtkm::FloatDefault>& interpWeights,
                vtkm::cont::ArrayHandle<vtkm::Id2>& interpIds,
                vtkm::cont::ArrayHandle<vtkm::Id>& interpCellIds,
-               vtkm::cont::ArrayHandle<vtkm::UInt8>& interpContourId,
+               vtkm::cont::ArrayHandle<vtkm::IdComponent>& interpContourId,
                vtkm::cont::DeviceAdapterId device,
                vtkm::cont::Token& token)
       : InterpWeightsPortal(interpWeights.PrepareForOutput(3 * size, device, token))
@@ -149,7 +152,7 @@ public:
     WritePortalType<vtkm::FloatDefault> InterpWeightsPortal;
     WritePortalType<vtkm::Id2> InterpIdPortal;
     WritePortalType<vtkm::Id> InterpCellIdPortal;
-    WritePortalType<vtkm::UInt8> InterpContourPortal;
+    WritePortalType<vtkm::IdComponent> InterpContourPortal;
   };
 
   VTKM_CONT
@@ -157,7 +160,7 @@ public:
                              vtkm::cont::ArrayHandle<vtkm::FloatDefault>& interpWeights,
                              vtkm::cont::ArrayHandle<vtkm::Id2>& interpIds,
                              vtkm::cont::ArrayHandle<vtkm::Id>& interpCellIds,
-                             vtkm::cont::ArrayHandle<vtkm::UInt8>& interpContourId)
+                             vtkm::cont::ArrayHandle<vtkm::IdComponent>& interpContourId)
     : Size(size)
     , InterpWeights(interpWeights)
     , InterpIds(interpIds)
@@ -183,7 +186,7 @@ private:
   vtkm::cont::ArrayHandle<vtkm::FloatDefault> InterpWeights;
   vtkm::cont::ArrayHandle<vtkm::Id2> InterpIds;
   vtkm::cont::ArrayHandle<vtkm::Id> InterpCellIds;
-  vtkm::cont::ArrayHandle<vtkm::UInt8> InterpContourId;
+  vtkm::cont::ArrayHandle<vtkm::IdComponent> InterpContourId;
 };
 
 /// \brief Compute the weights for each edge that is used to generate
@@ -269,7 +272,7 @@ public:
       // in a subsequent call, after we have merged duplicate points
       metaData.InterpCellIdPortal.Set(outputPointId + triVertex, inputCellId);
 
-      metaData.InterpContourPortal.Set(outputPointId + triVertex, static_cast<vtkm::UInt8>(i));
+      metaData.InterpContourPortal.Set(outputPointId + triVertex, i);
 
       metaData.InterpIdPortal.Set(
         outputPointId + triVertex,
@@ -382,6 +385,76 @@ void MergeDuplicates(const vtkm::cont::Invoker& invoker,
   invoker(CopyEdgeIds{}, uniqueKeys, edgeIds);
 }
 
+// ---------------------------------------------------------------------------
+// Packs the edge (and contour id) keys used by MergeDuplicates into a single 64 bit
+// key for MergeDuplicatesWithHashTable.
+struct PackEdgeKey : vtkm::worklet::WorkletMapField
+{
+  using ControlSignature = void(FieldIn, FieldOut);
+  using ExecutionSignature = void(_1, _2);
+  using InputDomain = _1;
+
+  VTKM_CONT
+  explicit PackEdgeKey(vtkm::IdComponent pointIdBits)
+    : PointIdBits(static_cast<vtkm::UInt64>(pointIdBits))
+  {
+  }
+
+  VTKM_EXEC
+  void operator()(const vtkm::Id2& edge, vtkm::UInt64& key) const
+  {
+    key = (static_cast<vtkm::UInt64>(edge[0]) << this->PointIdBits) |
+      static_cast<vtkm::UInt64>(edge[1]);
+  }
+
+  template <typename T>
+  VTKM_EXEC void operator()(const vtkm::Pair<T, vtkm::Id2>& input, vtkm::UInt64& key) const
+  {
+    this->operator()(input.second, key);
+    key |= static_cast<vtkm::UInt64>(input.first) << (2 * this->PointIdBits);
+  }
+
+private:
+  vtkm::UInt64 PointIdBits;
+};
+
+// ---------------------------------------------------------------------------
+// Same as MergeDuplicates, but identifies the duplicate edges with a hash table
+// instead of sorting them. The merged points are in the order they are first
+// generated instead of in the order of their edges. The caller has to make sure
+// the packed keys fit in 63 bits.
+template <typename KeyType, typename KeyStorage>
+void MergeDuplicatesWithHashTable(const vtkm::cont::Invoker& invoker,
+                                  const vtkm::cont::ArrayHandle<KeyType, KeyStorage>& original_keys,
+                                  vtkm::IdComponent pointIdBits,
+                                  vtkm::cont::ArrayHandle<vtkm::FloatDefault>& weights,
+                                  vtkm::cont::ArrayHandle<vtkm::Id2>& edgeIds,
+                                  vtkm::cont::ArrayHandle<vtkm::Id>& cellids,
+                                  vtkm::cont::ArrayHandle<vtkm::Id>& connectivity)
+{
+  vtkm::cont::ArrayHandle<vtkm::Id> uniqueToInput;
+  {
+    vtkm::cont::ArrayHandle<vtkm::UInt64> packedKeys;
+    invoker(PackEdgeKey{ pointIdBits }, original_keys, packedKeys);
+    vtkm::worklet::MergeDuplicateKeys(packedKeys, connectivity, uniqueToInput);
+  }
+
+  vtkm::cont::ArrayHandle<vtkm::FloatDefault> writeWeights;
+  vtkm::cont::ArrayCopyDevice(vtkm::cont::make_ArrayHandlePermutation(uniqueToInput, weights),
+                              writeWeights);
+  weights = writeWeights;
+
+  vtkm::cont::ArrayHandle<vtkm::Id> writeCells;
+  vtkm::cont::ArrayCopyDevice(vtkm::cont::make_ArrayHandlePermutation(uniqueToInput, cellids),
+                              writeCells);
+  cellids = writeCells;
+
+  vtkm::cont::ArrayHandle<vtkm::Id2> writeEdges;
+  vtkm::cont::ArrayCopyDevice(vtkm::cont::make_ArrayHandlePermutation(uniqueToInput, edgeIds),
+                              writeEdges);
+  edgeIds = writeEdges;
+}
+
 // -----------------------------------------------------------------------------
 template <vtkm::IdComponent Comp>
 struct EdgeVertex
@@ -634,7 +707,7 @@ vtkm::cont::CellSetSingleType<> execute(
   }
 
   //Pass 2 Generate the edges
-  vtkm::cont::ArrayHandle<vtkm::UInt8> contourIds;
+  vtkm::cont::ArrayHandle<vtkm::IdComponent> contourIds;
   vtkm::cont::ArrayHandle<vtkm::Id> originalCellIdsForPoints;
   {
     auto scatter = EdgeWeightGenerate<ValueType>::MakeScatter(numOutputTrisPerCell);
@@ -672,24 +745,45 @@ vtkm::cont::CellSetSingleType<> execute(
     // are updated. That is because MergeDuplicates will internally update
     // the InterpolationWeights and InterpolationOriginCellIds arrays to be the correct for the
     // output. But for InterpolationEdgeIds we need to do it manually once done
+    const vtkm::IdComponent pointIdBits =
+      vtkm::cont::ConcurrentHashTable::GetNumberOfBitsForIds(inputField.GetNumberOfValues());
+    const vtkm::IdComponent contourIdBits = (isovalues.size() == 1)
+      ? 0
+      : vtkm::cont::ConcurrentHashTable::GetNumberOfBitsForIds(
+          static_cast<vtkm::Id>(isovalues.size()));
+    // The packed keys must fit in 63 bits so that none of them is the empty key of the
+    // hash table. Otherwise, the duplicates are merged by sorting.
+    const bool useHashTable =
+      sharedState.MergeDuplicatePointsWithHashTable && (2 * pointIdBits + contourIdBits <= 63);
+    auto merge = [&](const auto& keys) {
+      if (useHashTable)
+      {
+        marching_cells::MergeDuplicatesWithHashTable(invoker,
+                                                     keys,
+                                                     pointIdBits,
+                                                     sharedState.InterpolationWeights,
+                                                     sharedState.InterpolationEdgeIds,
+                                                     originalCellIdsForPoints,
+                                                     connectivity);
+      }
+      else
+      {
+        marching_cells::MergeDuplicates(invoker,
+                                        keys,
+                                        sharedState.InterpolationWeights, //values
+                                        sharedState.InterpolationEdgeIds, //values
+                                        originalCellIdsForPoints,         //values
+                                        connectivity); // computed using lower bounds
+      }
+    };
+
     if (isovalues.size() == 1)
     {
-      marching_cells::MergeDuplicates(invoker,
-                                      sharedState.InterpolationEdgeIds, //keys
-                                      sharedState.InterpolationWeights, //values
-                                      sharedState.InterpolationEdgeIds, //values
-                                      originalCellIdsForPoints,         //values
-                                      connectivity); // computed using lower bounds
+      merge(sharedState.InterpolationEdgeIds);
     }
     else
     {
-      marching_cells::MergeDuplicates(
-        invoker,
-        vtkm::cont::make_ArrayHandleZip(contourIds, sharedState.InterpolationEdgeIds), //keys
-        sharedState.InterpolationWeights,                                              //values
-        sharedState.InterpolationEdgeIds,                                              //values
-        originalCellIdsForPoints,                                                      //values
-        connectivity); // computed using lower bounds
+      merge(vtkm::cont::make_ArrayHandleZip(contourIds, sharedState.InterpolationEdgeIds));
     }
   }
   else
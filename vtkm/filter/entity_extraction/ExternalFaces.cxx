@@ -36,6 +36,12 @@ void ExternalFaces::SetPassPolyData(bool value)
   this->Worklet->SetPassPolyData(value);
 }
 
+void ExternalFaces::SetMatchFacesWithHashTable(bool value)
+{
+  this->MatchFacesWithHashTable = value;
+  this->Worklet->SetMatchFacesWithHashTable(value);
+}
+
 //-----------------------------------------------------------------------------
 vtkm::cont::DataSet ExternalFaces::GenerateOutput(const vtkm::cont::DataSet& input,
                                                   vtkm::cont::CellSetExplicit<>& outCellSet)
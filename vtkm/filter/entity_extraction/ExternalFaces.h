@@ -57,6 +57,16 @@ public:
   VTKM_CONT
   void SetPassPolyData(bool value);
 
+  // When MatchFacesWithHashTable is set, the faces of unstructured cells are matched by
+  // counting them in a concurrent hash table instead of sorting a hash of every face. This
+  // takes linear time and does not store all the faces, but the external faces are output in
+  // cell order rather than in hash order. Data sets with too many points to pack 3 point ids
+  // in 64 bits fall back to sorting. Off by default.
+  VTKM_CONT
+  bool GetMatchFacesWithHashTable() const { return this->MatchFacesWithHashTable; }
+  VTKM_CONT
+  void SetMatchFacesWithHashTable(bool value);
+
 private:
   VTKM_CONT vtkm::cont::DataSet DoExecute(const vtkm::cont::DataSet& input) override;
 
@@ -67,6 +77,7 @@ private:
 
   bool CompactPoints = false;
   bool PassPolyData = true;
+  bool MatchFacesWithHashTable = false;
 
   // Note: This shared state as a data member requires us to explicitly implement the
   // constructor and destructor in the .cxx file, after the compiler actually have
@@ -80,9 +80,25 @@ vtkm::cont::DataSet Threshold::DoExecute(const vtkm::cont::DataSet& input)
 
   ThresholdRange predicate(this->GetLowerThreshold(), this->GetUpperThreshold());
   vtkm::worklet::Threshold worklet;
+  worklet.SetOutputCellSet(this->GetLazyPermutation()
+                             ? vtkm::worklet::Threshold::OutputCellSetType::Permutation
+                             : vtkm::worklet::Threshold::OutputCellSetType::Compact);
+  if (this->RangeIndex)
+  {
+    this->RangeIndex->Update(cells, field);
+  }
   vtkm::cont::UnknownCellSet cellOut;
 
   auto resolveArrayType = [&](const auto& concrete) {
+    if (this->RangeIndex)
+    {
+      // Query with the thresholds as the predicate sees them after conversion to the field
+      // type, so that no passing cell is missed.
+      using T = typename std::decay_t<decltype(concrete)>::ValueType;
+      worklet.SetCandidateCellIds(this->RangeIndex->GetCellsInRange(
+        static_cast<vtkm::Float64>(static_cast<T>(this->GetLowerThreshold())),
+        static_cast<vtkm::Float64>(static_cast<T>(this->GetUpperThreshold()))));
+    }
     // Note: there are two overloads of .Run, the first one taking an UncertainCellSet, which is
     // the desired entry point in the following call. The other is a function template on the input
     // CellSet. Without the call to .ResetCellSetList to turn an UnknownCellSet to an UncertainCellSet,
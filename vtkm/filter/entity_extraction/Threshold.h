@@ -12,6 +12,7 @@
 #define vtk_m_filter_entity_extraction_Threshold_h
 
 #include <vtkm/filter/NewFilterField.h>
+#include <vtkm/filter/ScalarRangeIndex.h>
 #include <vtkm/filter/entity_extraction/vtkm_filter_entity_extraction_export.h>
 
 namespace vtkm
@@ -26,7 +27,8 @@ namespace entity_extraction
 /// satisfy a threshold criterion. A cell satisfies the criterion if the
 /// scalar value of every point or cell satisfies the criterion. The
 /// criterion takes the form of between two values. The output of this
-/// filter is an permutation of the input dataset.
+/// filter is a compact copy of the selected cells, or optionally a
+/// permutation of the input dataset (see `SetLazyPermutation`).
 ///
 /// You can threshold either on point or cell fields
 class VTKM_FILTER_ENTITY_EXTRACTION_EXPORT Threshold : public vtkm::filter::NewFilterField
@@ -51,6 +53,40 @@ public:
   VTKM_CONT
   bool GetAllInRange() const { return this->ReturnAllInRange; }
 
+  /// \brief Keep the output cells as a permutation of the input cells.
+  ///
+  /// By default the selected cells are copied to a compact cell set. A `CellSetSingleType` is
+  /// produced when all input cells have the same shape (for example for structured input), and
+  /// a `CellSetExplicit` otherwise. When this flag is on, the output is instead a
+  /// `vtkm::cont::CellSetPermutation` that references the input cell set and only stores the
+  /// ids of the selected cells. This uses much less memory, but the permutation is not part of
+  /// `VTKM_DEFAULT_CELL_SET_LIST`, so it is not accepted by every filter downstream.
+  ///
+  VTKM_CONT
+  void SetLazyPermutation(bool value) { this->LazyPermutation = value; }
+
+  VTKM_CONT
+  bool GetLazyPermutation() const { return this->LazyPermutation; }
+
+  /// \brief Use a `ScalarRangeIndex` to skip the cells that cannot pass the threshold.
+  ///
+  /// The index is (re)built for the active field on the first execution and reused as long as
+  /// the cell set and the field are unchanged, so only the bricks of cells whose range meets
+  /// [lower, upper] are visited when the thresholds change. The same index can be shared with
+  /// a `vtkm::filter::contour::Contour` that uses the same field.
+  ///
+  VTKM_CONT
+  void SetScalarRangeIndex(const std::shared_ptr<vtkm::filter::ScalarRangeIndex>& index)
+  {
+    this->RangeIndex = index;
+  }
+
+  VTKM_CONT
+  const std::shared_ptr<vtkm::filter::ScalarRangeIndex>& GetScalarRangeIndex() const
+  {
+    return this->RangeIndex;
+  }
+
 private:
   VTKM_CONT
   vtkm::cont::DataSet DoExecute(const vtkm::cont::DataSet& input) override;
@@ -58,6 +94,8 @@ private:
   double LowerValue = 0;
   double UpperValue = 0;
   bool ReturnAllInRange = false;
+  bool LazyPermutation = false;
+  std::shared_ptr<vtkm::filter::ScalarRangeIndex> RangeIndex;
 };
 } // namespace entity_extraction
 class VTKM_DEPRECATED(1.8, "Use vtkm::filter::entity_extraction::Threshold.") Threshold
@@ -8,12 +8,16 @@
 //  PURPOSE.  See the above copyright notice for more information.
 //============================================================================
 
+#include <vtkm/cont/DataSetBuilderExplicit.h>
 #include <vtkm/cont/testing/MakeTestDataSet.h>
 #include <vtkm/cont/testing/Testing.h>
 
 #include <vtkm/filter/clean_grid/CleanGrid.h>
 #include <vtkm/filter/entity_extraction/ExternalFaces.h>
 
+#include <algorithm>
+#include <vector>
+
 using vtkm::cont::testing::MakeTestDataSet;
 
 namespace
@@ -135,6 +139,82 @@ void TestWithMixed2Dand3DMesh()
   TestExternalFacesExplicitGrid(ds, true, 6, 5, false);
 }
 
+// The faces of the output, each as its sorted point ids followed by the mapped cell value,
+// in sorted order so that outputs listing the faces in different orders can be compared.
+std::vector<std::vector<vtkm::Float64>> GetSortedFaces(const vtkm::cont::DataSet& ds)
+{
+  vtkm::cont::CellSetExplicit<> cellSet =
+    ds.GetCellSet().AsCellSet<vtkm::cont::CellSetExplicit<>>();
+  vtkm::cont::ArrayHandle<vtkm::FloatDefault> cellvar;
+  ds.GetCellField("cellvar").GetDataAsDefaultFloat().AsArrayHandle(cellvar);
+  auto cellvarPortal = cellvar.ReadPortal();
+
+  std::vector<std::vector<vtkm::Float64>> faces;
+  for (vtkm::Id cellId = 0; cellId < cellSet.GetNumberOfCells(); ++cellId)
+  {
+    std::vector<vtkm::Id> pointIds(
+      static_cast<std::size_t>(cellSet.GetNumberOfPointsInCell(cellId)));
+    cellSet.GetCellPointIds(cellId, pointIds.data());
+    std::sort(pointIds.begin(), pointIds.end());
+    std::vector<vtkm::Float64> face(pointIds.begin(), pointIds.end());
+    face.push_back(static_cast<vtkm::Float64>(cellvarPortal.Get(cellId)));
+    faces.push_back(face);
+  }
+  std::sort(faces.begin(), faces.end());
+  return faces;
+}
+
+// Tetrahedra that share no point, so that all of their faces are external.
+vtkm::cont::DataSet MakeDisjointTetrahedra(vtkm::Id numberOfTetrahedra)
+{
+  vtkm::cont::DataSetBuilderExplicitIterative builder;
+  for (vtkm::Id i = 0; i < numberOfTetrahedra; ++i)
+  {
+    const auto x = static_cast<vtkm::FloatDefault>(2 * i);
+    builder.AddPoint(x, 0, 0);
+    builder.AddPoint(x + 1, 0, 0);
+    builder.AddPoint(x, 1, 0);
+    builder.AddPoint(x, 0, 1);
+    builder.AddCell(vtkm::CELL_SHAPE_TETRA);
+    for (vtkm::Id j = 0; j < 4; ++j)
+    {
+      builder.AddCellPoint(4 * i + j);
+    }
+  }
+  vtkm::cont::DataSet ds = builder.Create();
+
+  std::vector<vtkm::FloatDefault> cellvar;
+  for (vtkm::Id i = 0; i < numberOfTetrahedra; ++i)
+  {
+    cellvar.push_back(static_cast<vtkm::FloatDefault>(i));
+  }
+  ds.AddCellField("cellvar", cellvar);
+  return ds;
+}
+
+void TestMatchFacesWithHashTable(const vtkm::cont::DataSet& ds, bool passPolyData = true)
+{
+  vtkm::filter::entity_extraction::ExternalFaces externalFaces;
+  externalFaces.SetPassPolyData(passPolyData);
+  const auto expected = GetSortedFaces(externalFaces.Execute(ds));
+
+  externalFaces.SetMatchFacesWithHashTable(true);
+  const auto faces = GetSortedFaces(externalFaces.Execute(ds));
+  VTKM_TEST_ASSERT(faces == expected, "Hash table matching gives different faces");
+}
+
+void TestWithHashTable()
+{
+  std::cout << "Testing face matching with a hash table\n";
+  TestMatchFacesWithHashTable(MakeDataTestSet1());
+  TestMatchFacesWithHashTable(MakeDataTestSet2());
+  TestMatchFacesWithHashTable(MakeDataTestSet5());
+  TestMatchFacesWithHashTable(MakeDataTestSet5(), false);
+  TestMatchFacesWithHashTable(MakeTestDataSet().Make3DExplicitDataSetZoo());
+  TestMatchFacesWithHashTable(MakeDisjointTetrahedra(4));
+  TestMatchFacesWithHashTable(MakeDisjointTetrahedra(100));
+}
+
 void TestExternalFacesFilter()
 {
   TestWithHeterogeneousMesh();
@@ -142,6 +222,7 @@ void TestExternalFacesFilter()
   TestWithUniformMesh();
   TestWithRectilinearMesh();
   TestWithMixed2Dand3DMesh();
+  TestWithHashTable();
 }
 
 } // anonymous namespace
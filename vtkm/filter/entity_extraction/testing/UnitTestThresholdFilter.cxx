@@ -8,6 +8,8 @@
 //  PURPOSE.  See the above copyright notice for more information.
 //============================================================================
 
+#include <vtkm/cont/CellSetPermutation.h>
+#include <vtkm/cont/DataSetBuilderUniform.h>
 #include <vtkm/cont/testing/MakeTestDataSet.h>
 #include <vtkm/cont/testing/Testing.h>
 #include <vtkm/filter/clean_grid/CleanGrid.h>
@@ -193,6 +195,129 @@ public:
     clean.Execute(output);
   }
 
+  static void TestOutputCellSets()
+  {
+    std::cout << "Testing threshold output cell sets" << std::endl;
+    vtkm::cont::DataSet dataset = MakeTestDataSet().Make3DUniformDataSet0();
+    vtkm::cont::CellSetStructured<3> inputCells;
+    dataset.GetCellSet().AsCellSet(inputCells);
+
+    vtkm::filter::entity_extraction::Threshold threshold;
+    threshold.SetLowerThreshold(20);
+    threshold.SetUpperThreshold(21);
+    threshold.SetActiveField("pointvar");
+    threshold.SetFieldsToPass("cellvar");
+
+    // Structured cells all have the same shape, so the output is a single type cell set.
+    auto output = threshold.Execute(dataset);
+    VTKM_TEST_ASSERT(output.GetCellSet().IsType<vtkm::cont::CellSetSingleType<>>(),
+                     "Expected a single type cell set");
+    vtkm::cont::CellSetSingleType<> compactCells;
+    output.GetCellSet().AsCellSet(compactCells);
+    VTKM_TEST_ASSERT(compactCells.GetNumberOfCells() == 2, "Wrong number of cells");
+    VTKM_TEST_ASSERT(compactCells.GetNumberOfPoints() == inputCells.GetNumberOfPoints(),
+                     "Wrong number of points");
+    const vtkm::Id expectedCells[2] = { 0, 1 };
+    for (vtkm::Id cell = 0; cell < 2; ++cell)
+    {
+      VTKM_TEST_ASSERT(compactCells.GetCellShape(cell) == vtkm::CELL_SHAPE_HEXAHEDRON,
+                       "Wrong cell shape");
+      vtkm::Id expectedIds[8];
+      vtkm::Id ids[8];
+      inputCells.GetCellPointIds(expectedCells[cell], expectedIds);
+      compactCells.GetCellPointIds(cell, ids);
+      for (vtkm::IdComponent i = 0; i < 8; ++i)
+      {
+        VTKM_TEST_ASSERT(ids[i] == expectedIds[i], "Wrong cell connectivity");
+      }
+    }
+
+    // Cells of mixed shapes are copied to an explicit cell set.
+    vtkm::cont::DataSet explicitDataset = MakeTestDataSet().Make3DExplicitDataSet5();
+    threshold.SetActiveField("cellvar");
+    threshold.SetLowerThreshold(100.1);
+    threshold.SetUpperThreshold(125);
+    auto explicitOutput = threshold.Execute(explicitDataset);
+    VTKM_TEST_ASSERT(explicitOutput.GetCellSet().IsType<vtkm::cont::CellSetExplicit<>>(),
+                     "Expected an explicit cell set");
+    VTKM_TEST_ASSERT(explicitOutput.GetNumberOfCells() == 3, "Wrong number of cells");
+
+    // With a lazy permutation, the output references the input cell set.
+    threshold.SetActiveField("pointvar");
+    threshold.SetLowerThreshold(20);
+    threshold.SetUpperThreshold(21);
+    threshold.SetLazyPermutation(true);
+    auto lazyOutput = threshold.Execute(dataset);
+    using PermutationType = vtkm::cont::CellSetPermutation<vtkm::cont::CellSetStructured<3>>;
+    VTKM_TEST_ASSERT(lazyOutput.GetCellSet().IsType<PermutationType>(),
+                     "Expected a permutation cell set");
+    VTKM_TEST_ASSERT(test_equal_ArrayHandles(
+      lazyOutput.GetCellSet().AsCellSet<PermutationType>().GetValidCellIds(),
+      vtkm::cont::make_ArrayHandle<vtkm::Id>({ 0, 1 })));
+    vtkm::cont::ArrayHandle<vtkm::Float32> cellFieldArray;
+    lazyOutput.GetField("cellvar").GetData().AsArrayHandle(cellFieldArray);
+    VTKM_TEST_ASSERT(
+      test_equal_ArrayHandles(cellFieldArray, vtkm::cont::make_ArrayHandle({ 100.1f, 100.2f })));
+  }
+
+  static void TestScalarRangeIndex()
+  {
+    std::cout << "Testing threshold with a ScalarRangeIndex" << std::endl;
+    const vtkm::Id3 dims(16, 16, 16);
+    vtkm::cont::DataSet dataset = vtkm::cont::DataSetBuilderUniform::Create(dims);
+    std::vector<vtkm::Float32> pointvar;
+    for (vtkm::Id k = 0; k < dims[2]; ++k)
+    {
+      for (vtkm::Id j = 0; j < dims[1]; ++j)
+      {
+        for (vtkm::Id i = 0; i < dims[0]; ++i)
+        {
+          pointvar.push_back(static_cast<vtkm::Float32>(i * i + j - 2 * k));
+        }
+      }
+    }
+    dataset.AddPointField("pointvar", pointvar);
+    std::vector<vtkm::Int32> cellvar;
+    for (vtkm::Id cell = 0; cell < dataset.GetNumberOfCells(); ++cell)
+    {
+      cellvar.push_back(static_cast<vtkm::Int32>((cell * 37) % 1000));
+    }
+    dataset.AddCellField("cellvar", cellvar);
+
+    using PermutationType = vtkm::cont::CellSetPermutation<vtkm::cont::CellSetStructured<3>>;
+    auto index = std::make_shared<vtkm::filter::ScalarRangeIndex>();
+    index->SetBrickSize(50);
+    vtkm::filter::entity_extraction::Threshold threshold;
+    threshold.SetLazyPermutation(true);
+    for (const std::string fieldName : { "pointvar", "cellvar" })
+    {
+      threshold.SetActiveField(fieldName);
+      for (bool allInRange : { false, true })
+      {
+        threshold.SetAllInRange(allInRange);
+        for (const vtkm::Vec2f_64& range :
+             { vtkm::Vec2f_64(10, 20), vtkm::Vec2f_64(100.5, 120.5), vtkm::Vec2f_64(-5, 0) })
+        {
+          threshold.SetLowerThreshold(range[0]);
+          threshold.SetUpperThreshold(range[1]);
+          threshold.SetScalarRangeIndex(nullptr);
+          auto expected = threshold.Execute(dataset);
+          threshold.SetScalarRangeIndex(index);
+          auto result = threshold.Execute(dataset);
+
+          VTKM_TEST_ASSERT(
+            index->IsBuiltFor(dataset.GetCellSet(), dataset.GetField(fieldName)),
+            "Index was not built for the active field");
+          VTKM_TEST_ASSERT(test_equal_ArrayHandles(
+            result.GetCellSet().AsCellSet<PermutationType>().GetValidCellIds(),
+            expected.GetCellSet().AsCellSet<PermutationType>().GetValidCellIds()));
+          VTKM_TEST_ASSERT(test_equal_ArrayHandles(result.GetCellField("cellvar").GetData(),
+                                                   expected.GetCellField("cellvar").GetData()));
+        }
+      }
+    }
+  }
+
   void operator()() const
   {
     TestingThreshold::TestRegular2D(false);
@@ -201,6 +326,8 @@ public:
     TestingThreshold::TestRegular3D(true);
     TestingThreshold::TestExplicit3D();
     TestingThreshold::TestExplicit3DZeroResults();
+    TestingThreshold::TestOutputCellSets();
+    TestingThreshold::TestScalarRangeIndex();
   }
 };
 }
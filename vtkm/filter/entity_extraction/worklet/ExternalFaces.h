@@ -30,6 +30,7 @@
 #include <vtkm/cont/ArrayHandleTransform.h>
 #include <vtkm/cont/ArrayHandleView.h>
 #include <vtkm/cont/CellSetExplicit.h>
+#include <vtkm/cont/ConcurrentHashTable.h>
 #include <vtkm/cont/ConvertNumComponentsToOffsets.h>
 #include <vtkm/cont/DataSet.h>
 #include <vtkm/cont/Field.h>
@@ -585,6 +586,247 @@ public:
     }
   };
 
+private:
+  // Packs the canonical id of a face into a key of the face hash table. Each point id takes
+  // pointIdBits bits, so this is only valid when 3 * pointIdBits <= 63.
+  template <typename CellShapeTag, typename CellNodeVecType>
+  VTKM_EXEC static vtkm::UInt64 FaceKey(vtkm::IdComponent faceIndex,
+                                        CellShapeTag shape,
+                                        const CellNodeVecType& cellNodeIds,
+                                        vtkm::UInt64 pointIdBits)
+  {
+    vtkm::Id3 faceId;
+    vtkm::exec::CellFaceCanonicalId(faceIndex, shape, cellNodeIds, faceId);
+    return (static_cast<vtkm::UInt64>(faceId[0]) << (2 * pointIdBits)) |
+      (static_cast<vtkm::UInt64>(faceId[1]) << pointIdBits) | static_cast<vtkm::UInt64>(faceId[2]);
+  }
+
+  // A face is external when it was counted for a single cell. Faces are missing from the
+  // table only when CountFacesInHashTable could not insert them, which raises an error.
+  template <typename CellShapeTag, typename CellNodeVecType, typename CountPortalType>
+  VTKM_EXEC static bool IsExternalFace(vtkm::IdComponent faceIndex,
+                                       CellShapeTag shape,
+                                       const CellNodeVecType& cellNodeIds,
+                                       const vtkm::exec::ConcurrentHashTable& faceTable,
+                                       const CountPortalType& faceCounts,
+                                       vtkm::UInt64 pointIdBits)
+  {
+    const vtkm::Id slot = faceTable.Find(FaceKey(faceIndex, shape, cellNodeIds, pointIdBits));
+    return (slot >= 0) && (faceCounts.Get(slot) == 1);
+  }
+
+  // Returns the index in its cell of the visitIndex-th external face of the cell.
+  template <typename CellShapeTag, typename CellNodeVecType, typename CountPortalType>
+  VTKM_EXEC static vtkm::IdComponent FindExternalFace(
+    CellShapeTag shape,
+    const CellNodeVecType& cellNodeIds,
+    const vtkm::exec::ConcurrentHashTable& faceTable,
+    const CountPortalType& faceCounts,
+    vtkm::UInt64 pointIdBits,
+    vtkm::IdComponent visitIndex)
+  {
+    vtkm::IdComponent numFaces;
+    vtkm::exec::CellFaceNumberOfFaces(shape, numFaces);
+    vtkm::IdComponent numFound = 0;
+    vtkm::IdComponent faceIndex = 0;
+    for (; faceIndex < numFaces; faceIndex++)
+    {
+      if (IsExternalFace(faceIndex, shape, cellNodeIds, faceTable, faceCounts, pointIdBits))
+      {
+        if (numFound == visitIndex)
+        {
+          break;
+        }
+        numFound++;
+      }
+    }
+    VTKM_ASSERT(faceIndex < numFaces);
+    return faceIndex;
+  }
+
+public:
+  // Worklet that inserts every face of a cell into a hash table of faces and counts the cells
+  // that share each face. Unlike FaceHash, no array of all the faces is generated: internal
+  // faces fold into a single slot of the table as they are inserted.
+  class CountFacesInHashTable : public vtkm::worklet::WorkletVisitCellsWithPoints
+  {
+  public:
+    using ControlSignature = void(CellSetIn cellset,
+                                  ExecObject faceTable,
+                                  AtomicArrayInOut faceCounts);
+    using ExecutionSignature = void(CellShape, PointIndices, _2, _3);
+    using InputDomain = _1;
+
+    VTKM_CONT explicit CountFacesInHashTable(vtkm::IdComponent pointIdBits)
+      : PointIdBits(static_cast<vtkm::UInt64>(pointIdBits))
+    {
+    }
+
+    template <typename CellShapeTag, typename CellNodeVecType, typename CountPortalType>
+    VTKM_EXEC void operator()(CellShapeTag shape,
+                              const CellNodeVecType& cellNodeIds,
+                              const vtkm::exec::ConcurrentHashTable& faceTable,
+                              const CountPortalType& faceCounts) const
+    {
+      vtkm::IdComponent numFaces;
+      vtkm::exec::CellFaceNumberOfFaces(shape, numFaces);
+      for (vtkm::IdComponent faceIndex = 0; faceIndex < numFaces; faceIndex++)
+      {
+        const vtkm::Id slot = faceTable.InsertOrGet(
+          ExternalFaces::FaceKey(faceIndex, shape, cellNodeIds, this->PointIdBits));
+        if (slot < 0)
+        {
+          this->RaiseError("The external faces hash table is full.");
+          return;
+        }
+        faceCounts.Add(slot, 1);
+      }
+    }
+
+  private:
+    vtkm::UInt64 PointIdBits;
+  };
+
+  // Worklet that returns the number of external faces of each cell from the face hash table.
+  class NumExternalFacesFromHashTable : public vtkm::worklet::WorkletVisitCellsWithPoints
+  {
+  public:
+    using ControlSignature = void(CellSetIn cellset,
+                                  ExecObject faceTable,
+                                  WholeArrayIn faceCounts,
+                                  FieldOutCell numExternalFaces);
+    using ExecutionSignature = _4(CellShape, PointIndices, _2, _3);
+    using InputDomain = _1;
+
+    VTKM_CONT explicit NumExternalFacesFromHashTable(vtkm::IdComponent pointIdBits)
+      : PointIdBits(static_cast<vtkm::UInt64>(pointIdBits))
+    {
+    }
+
+    template <typename CellShapeTag, typename CellNodeVecType, typename CountPortalType>
+    VTKM_EXEC vtkm::IdComponent operator()(CellShapeTag shape,
+                                           const CellNodeVecType& cellNodeIds,
+                                           const vtkm::exec::ConcurrentHashTable& faceTable,
+                                           const CountPortalType& faceCounts) const
+    {
+      vtkm::IdComponent numFaces;
+      vtkm::exec::CellFaceNumberOfFaces(shape, numFaces);
+      vtkm::IdComponent numExternalFaces = 0;
+      for (vtkm::IdComponent faceIndex = 0; faceIndex < numFaces; faceIndex++)
+      {
+        if (ExternalFaces::IsExternalFace(
+              faceIndex, shape, cellNodeIds, faceTable, faceCounts, this->PointIdBits))
+        {
+          numExternalFaces++;
+        }
+      }
+      return numExternalFaces;
+    }
+
+  private:
+    vtkm::UInt64 PointIdBits;
+  };
+
+  // Worklet that returns the shape, number of points and origin cell of each external face
+  // found in the face hash table.
+  class ExternalFaceShapesFromHashTable : public vtkm::worklet::WorkletVisitCellsWithPoints
+  {
+  public:
+    using ControlSignature = void(CellSetIn cellset,
+                                  ExecObject faceTable,
+                                  WholeArrayIn faceCounts,
+                                  FieldOutCell shapesOut,
+                                  FieldOutCell numPointsInFace,
+                                  FieldOutCell cellIdMapOut);
+    using ExecutionSignature =
+      void(CellShape, PointIndices, _2, _3, VisitIndex, InputIndex, _4, _5, _6);
+    using InputDomain = _1;
+
+    using ScatterType = vtkm::worklet::ScatterCounting;
+
+    VTKM_CONT explicit ExternalFaceShapesFromHashTable(vtkm::IdComponent pointIdBits)
+      : PointIdBits(static_cast<vtkm::UInt64>(pointIdBits))
+    {
+    }
+
+    template <typename CellShapeTag, typename CellNodeVecType, typename CountPortalType>
+    VTKM_EXEC void operator()(CellShapeTag shape,
+                              const CellNodeVecType& cellNodeIds,
+                              const vtkm::exec::ConcurrentHashTable& faceTable,
+                              const CountPortalType& faceCounts,
+                              vtkm::IdComponent visitIndex,
+                              vtkm::Id inputIndex,
+                              vtkm::UInt8& shapeOut,
+                              vtkm::IdComponent& numFacePoints,
+                              vtkm::Id& cellIdMapOut) const
+    {
+      const vtkm::IdComponent faceIndex = ExternalFaces::FindExternalFace(
+        shape, cellNodeIds, faceTable, faceCounts, this->PointIdBits, visitIndex);
+      vtkm::exec::CellFaceShape(faceIndex, shape, shapeOut);
+      vtkm::exec::CellFaceNumberOfPoints(faceIndex, shape, numFacePoints);
+      cellIdMapOut = inputIndex;
+    }
+
+  private:
+    vtkm::UInt64 PointIdBits;
+  };
+
+  // Worklet that returns the connectivity of each external face found in the face hash table.
+  class ExternalFaceConnectivityFromHashTable : public vtkm::worklet::WorkletVisitCellsWithPoints
+  {
+  public:
+    using ControlSignature = void(CellSetIn cellset,
+                                  ExecObject faceTable,
+                                  WholeArrayIn faceCounts,
+                                  FieldOutCell connectivityOut);
+    using ExecutionSignature = void(CellShape, PointIndices, _2, _3, VisitIndex, _4);
+    using InputDomain = _1;
+
+    using ScatterType = vtkm::worklet::ScatterCounting;
+
+    VTKM_CONT explicit ExternalFaceConnectivityFromHashTable(vtkm::IdComponent pointIdBits)
+      : PointIdBits(static_cast<vtkm::UInt64>(pointIdBits))
+    {
+    }
+
+    template <typename CellShapeTag,
+              typename CellNodeVecType,
+              typename CountPortalType,
+              typename ConnectivityType>
+    VTKM_EXEC void operator()(CellShapeTag shape,
+                              const CellNodeVecType& cellNodeIds,
+                              const vtkm::exec::ConcurrentHashTable& faceTable,
+                              const CountPortalType& faceCounts,
+                              vtkm::IdComponent visitIndex,
+                              ConnectivityType& connectivityOut) const
+    {
+      const vtkm::IdComponent faceIndex = ExternalFaces::FindExternalFace(
+        shape, cellNodeIds, faceTable, faceCounts, this->PointIdBits, visitIndex);
+
+      const vtkm::IdComponent numFacePoints = connectivityOut.GetNumberOfComponents();
+      for (vtkm::IdComponent facePointIndex = 0; facePointIndex < numFacePoints; facePointIndex++)
+      {
+        vtkm::IdComponent localFaceIndex;
+        vtkm::ErrorCode status =
+          vtkm::exec::CellFaceLocalIndex(facePointIndex, faceIndex, shape, localFaceIndex);
+        if (status == vtkm::ErrorCode::Success)
+        {
+          connectivityOut[facePointIndex] = cellNodeIds[localFaceIndex];
+        }
+        else
+        {
+          // The face was found when the output was counted, so the face table or counts
+          // changed since.
+          this->RaiseError("External face not found again in the face hash table.");
+          return;
+        }
+      }
+    }
+
+  private:
+    vtkm::UInt64 PointIdBits;
+  };
+
   class IsPolyDataCell : public vtkm::worklet::WorkletVisitCellsWithPoints
   {
   public:
@@ -663,6 +905,7 @@ public:
   VTKM_CONT
   ExternalFaces()
     : PassPolyData(true)
+    , MatchFacesWithHashTable(false)
   {
   }
 
@@ -672,6 +915,14 @@ public:
   VTKM_CONT
   bool GetPassPolyData() const { return this->PassPolyData; }
 
+  /// When on, the faces of unstructured cells are matched with a concurrent hash table instead
+  /// of by sorting a hash of every face. Off by default.
+  VTKM_CONT
+  void SetMatchFacesWithHashTable(bool flag) { this->MatchFacesWithHashTable = flag; }
+
+  VTKM_CONT
+  bool GetMatchFacesWithHashTable() const { return this->MatchFacesWithHashTable; }
+
   void ReleaseCellMapArrays() { this->CellIdMap.ReleaseResources(); }
 
 
@@ -844,57 +1095,41 @@ public:
       }
     }
 
-    vtkm::cont::ArrayHandle<vtkm::HashType> faceHashes;
-    vtkm::cont::ArrayHandle<vtkm::Id> originCells;
-    vtkm::cont::ArrayHandle<vtkm::IdComponent> originFaces;
-    vtkm::worklet::DispatcherMapTopology<FaceHash> faceHashDispatcher(scatterCellToFace);
-
-    faceHashDispatcher.Invoke(inCellSet, faceHashes, originCells, originFaces);
-
-    vtkm::worklet::Keys<vtkm::HashType> faceKeys(faceHashes);
-
-    vtkm::cont::ArrayHandle<vtkm::IdComponent> faceOutputCount;
-    vtkm::worklet::DispatcherReduceByKey<FaceCounts> faceCountDispatcher;
-
-    faceCountDispatcher.Invoke(faceKeys, inCellSet, originCells, originFaces, faceOutputCount);
-
-    auto scatterCullInternalFaces = NumPointsPerFace::MakeScatter(faceOutputCount);
-
     PointCountArrayType facePointCount;
-    vtkm::worklet::DispatcherReduceByKey<NumPointsPerFace> pointsPerFaceDispatcher(
-      scatterCullInternalFaces);
-
-    pointsPerFaceDispatcher.Invoke(faceKeys, inCellSet, originCells, originFaces, facePointCount);
-
     ShapeArrayType faceShapes;
-
     OffsetsArrayType faceOffsets;
-    vtkm::Id connectivitySize;
-    vtkm::cont::ConvertNumComponentsToOffsets(facePointCount, faceOffsets, connectivitySize);
-
     ConnectivityArrayType faceConnectivity;
-    // Must pre allocate because worklet invocation will not have enough
-    // information to.
-    faceConnectivity.Allocate(connectivitySize);
-
-    vtkm::worklet::DispatcherReduceByKey<BuildConnectivity> buildConnectivityDispatcher(
-      scatterCullInternalFaces);
-
     vtkm::cont::ArrayHandle<vtkm::Id> faceToCellIdMap;
 
+    // The hash table needs the canonical id of a face (3 point ids) to fit in a 64-bit key.
+    const vtkm::IdComponent pointIdBits =
+      vtkm::cont::ConcurrentHashTable::GetNumberOfBitsForIds(inCellSet.GetNumberOfPoints());
+    if (this->MatchFacesWithHashTable && (3 * pointIdBits <= 63))
+    {
+      this->MatchFacesUsingHashTable(inCellSet,
+                                     scatterCellToFace.GetOutputRange(inCellSet.GetNumberOfCells()),
+                                     pointIdBits,
+                                     faceShapes,
+                                     facePointCount,
+                                     faceOffsets,
+                                     faceConnectivity,
+                                     faceToCellIdMap);
+    }
+    else
+    {
+      this->MatchFacesUsingKeys(inCellSet,
+                                scatterCellToFace,
+                                faceShapes,
+                                facePointCount,
+                                faceOffsets,
+                                faceConnectivity,
+                                faceToCellIdMap);
+    }
+
     // Create a view that doesn't have the last offset:
     auto faceOffsetsTrim =
       vtkm::cont::make_ArrayHandleView(faceOffsets, 0, faceOffsets.GetNumberOfValues() - 1);
 
-    buildConnectivityDispatcher.Invoke(
-      faceKeys,
-      inCellSet,
-      originCells,
-      originFaces,
-      faceShapes,
-      vtkm::cont::make_ArrayHandleGroupVecVariable(faceConnectivity, faceOffsets),
-      faceToCellIdMap);
-
     if (!polyDataConnectivitySize)
     {
       outCellSet.Fill(inCellSet.GetNumberOfPoints(), faceShapes, faceConnectivity, faceOffsets);
@@ -944,8 +1179,119 @@ public:
   vtkm::cont::ArrayHandle<vtkm::Id> GetCellIdMap() const { return this->CellIdMap; }
 
 private:
+  // Finds the external faces by sorting a hash of every face of every cell with
+  // vtkm::worklet::Keys, and then resolving the faces that share each hash.
+  template <typename InCellSetType,
+            typename ShapeArrayType,
+            typename PointCountArrayType,
+            typename OffsetsArrayType,
+            typename ConnectivityArrayType>
+  VTKM_CONT void MatchFacesUsingKeys(const InCellSetType& inCellSet,
+                                     const vtkm::worklet::ScatterCounting& scatterCellToFace,
+                                     ShapeArrayType& faceShapes,
+                                     PointCountArrayType& facePointCount,
+                                     OffsetsArrayType& faceOffsets,
+                                     ConnectivityArrayType& faceConnectivity,
+                                     vtkm::cont::ArrayHandle<vtkm::Id>& faceToCellIdMap)
+  {
+    vtkm::cont::ArrayHandle<vtkm::HashType> faceHashes;
+    vtkm::cont::ArrayHandle<vtkm::Id> originCells;
+    vtkm::cont::ArrayHandle<vtkm::IdComponent> originFaces;
+    vtkm::worklet::DispatcherMapTopology<FaceHash> faceHashDispatcher(scatterCellToFace);
+
+    faceHashDispatcher.Invoke(inCellSet, faceHashes, originCells, originFaces);
+
+    vtkm::worklet::Keys<vtkm::HashType> faceKeys(faceHashes);
+
+    vtkm::cont::ArrayHandle<vtkm::IdComponent> faceOutputCount;
+    vtkm::worklet::DispatcherReduceByKey<FaceCounts> faceCountDispatcher;
+
+    faceCountDispatcher.Invoke(faceKeys, inCellSet, originCells, originFaces, faceOutputCount);
+
+    auto scatterCullInternalFaces = NumPointsPerFace::MakeScatter(faceOutputCount);
+
+    vtkm::worklet::DispatcherReduceByKey<NumPointsPerFace> pointsPerFaceDispatcher(
+      scatterCullInternalFaces);
+
+    pointsPerFaceDispatcher.Invoke(faceKeys, inCellSet, originCells, originFaces, facePointCount);
+
+    vtkm::Id connectivitySize;
+    vtkm::cont::ConvertNumComponentsToOffsets(facePointCount, faceOffsets, connectivitySize);
+
+    // Must pre allocate because worklet invocation will not have enough
+    // information to.
+    faceConnectivity.Allocate(connectivitySize);
+
+    vtkm::worklet::DispatcherReduceByKey<BuildConnectivity> buildConnectivityDispatcher(
+      scatterCullInternalFaces);
+
+    buildConnectivityDispatcher.Invoke(
+      faceKeys,
+      inCellSet,
+      originCells,
+      originFaces,
+      faceShapes,
+      vtkm::cont::make_ArrayHandleGroupVecVariable(faceConnectivity, faceOffsets),
+      faceToCellIdMap);
+  }
+
+  // Finds the external faces by counting the cells sharing each face in a concurrent hash
+  // table keyed by the canonical face id. No per-face arrays are generated: the table holds
+  // one slot per distinct face, and the external faces are emitted in cell order.
+  template <typename InCellSetType,
+            typename ShapeArrayType,
+            typename PointCountArrayType,
+            typename OffsetsArrayType,
+            typename ConnectivityArrayType>
+  VTKM_CONT void MatchFacesUsingHashTable(const InCellSetType& inCellSet,
+                                          vtkm::Id numberOfFaces,
+                                          vtkm::IdComponent pointIdBits,
+                                          ShapeArrayType& faceShapes,
+                                          PointCountArrayType& facePointCount,
+                                          OffsetsArrayType& faceOffsets,
+                                          ConnectivityArrayType& faceConnectivity,
+                                          vtkm::cont::ArrayHandle<vtkm::Id>& faceToCellIdMap)
+  {
+    // There are at most numberOfFaces distinct faces, when no face is shared. Sizing the table
+    // for all of them keeps its load factor at most 1/2.
+    vtkm::cont::ConcurrentHashTable faceTable(numberOfFaces);
+    vtkm::cont::ArrayHandle<vtkm::UInt32> faceCounts;
+    faceCounts.AllocateAndFill(faceTable.GetCapacity(), 0);
+
+    vtkm::worklet::DispatcherMapTopology<CountFacesInHashTable> countFacesDispatcher(
+      (CountFacesInHashTable(pointIdBits)));
+    countFacesDispatcher.Invoke(inCellSet, faceTable, faceCounts);
+
+    vtkm::cont::ArrayHandle<vtkm::IdComponent> numExternalFaces;
+    vtkm::worklet::DispatcherMapTopology<NumExternalFacesFromHashTable> numExternalFacesDispatcher(
+      (NumExternalFacesFromHashTable(pointIdBits)));
+    numExternalFacesDispatcher.Invoke(inCellSet, faceTable, faceCounts, numExternalFaces);
+
+    vtkm::worklet::ScatterCounting scatterCellToExternalFace(numExternalFaces);
+    numExternalFaces.ReleaseResources();
+
+    vtkm::worklet::DispatcherMapTopology<ExternalFaceShapesFromHashTable> faceShapesDispatcher(
+      ExternalFaceShapesFromHashTable(pointIdBits), scatterCellToExternalFace);
+    faceShapesDispatcher.Invoke(
+      inCellSet, faceTable, faceCounts, faceShapes, facePointCount, faceToCellIdMap);
+
+    vtkm::Id connectivitySize;
+    vtkm::cont::ConvertNumComponentsToOffsets(facePointCount, faceOffsets, connectivitySize);
+    faceConnectivity.Allocate(connectivitySize);
+
+    vtkm::worklet::DispatcherMapTopology<ExternalFaceConnectivityFromHashTable>
+      faceConnectivityDispatcher(ExternalFaceConnectivityFromHashTable(pointIdBits),
+                                 scatterCellToExternalFace);
+    faceConnectivityDispatcher.Invoke(
+      inCellSet,
+      faceTable,
+      faceCounts,
+      vtkm::cont::make_ArrayHandleGroupVecVariable(faceConnectivity, faceOffsets));
+  }
+
   vtkm::cont::ArrayHandle<vtkm::Id> CellIdMap;
   bool PassPolyData;
+  bool MatchFacesWithHashTable;
 
 }; //struct ExternalFaces
 }
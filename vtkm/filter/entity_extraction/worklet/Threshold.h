@@ -16,17 +16,45 @@
 
 #include <vtkm/cont/Algorithm.h>
 #include <vtkm/cont/ArrayHandle.h>
+#include <vtkm/cont/ArrayHandleCounting.h>
+#include <vtkm/cont/ArrayHandleGroupVecVariable.h>
 #include <vtkm/cont/ArrayHandleIndex.h>
+#include <vtkm/cont/ArrayHandlePermutation.h>
 #include <vtkm/cont/CellSetPermutation.h>
+#include <vtkm/cont/CellSetSingleType.h>
+#include <vtkm/cont/CellSetStructured.h>
 #include <vtkm/cont/Field.h>
+#include <vtkm/cont/Invoker.h>
 #include <vtkm/cont/UncertainCellSet.h>
 #include <vtkm/cont/UnknownCellSet.h>
 
+#include <type_traits>
+
 namespace vtkm
 {
 namespace worklet
 {
 
+namespace detail
+{
+
+// Cell sets where every cell has the same shape and number of points.
+template <typename CellSetType>
+struct ThresholdHasSingleShape : std::false_type
+{
+};
+template <typename ConnectivityStorage>
+struct ThresholdHasSingleShape<vtkm::cont::CellSetSingleType<ConnectivityStorage>>
+  : std::true_type
+{
+};
+template <vtkm::IdComponent Dimension>
+struct ThresholdHasSingleShape<vtkm::cont::CellSetStructured<Dimension>> : std::true_type
+{
+};
+
+} // namespace detail
+
 class Threshold
 {
 public:
@@ -36,6 +64,18 @@ public:
     Cell
   };
 
+  /// The cell sets that `Run` on an `UncertainCellSet` can return.
+  enum class OutputCellSetType
+  {
+    /// The selected cells are copied to a `CellSetExplicit`.
+    Explicit,
+    /// The selected cells are copied to a `CellSetSingleType` if all input cells have the same
+    /// shape, and to a `CellSetExplicit` otherwise.
+    Compact,
+    /// The `CellSetPermutation` of the input is returned without copying any cell.
+    Permutation
+  };
+
   template <typename UnaryPredicate>
   class ThresholdByPointField : public vtkm::worklet::WorkletVisitCellsWithPoints
   {
@@ -98,6 +138,34 @@ public:
   };
 
 
+  struct CopyPointIndices : public vtkm::worklet::WorkletVisitCellsWithPoints
+  {
+    using ControlSignature = void(CellSetIn cellset, FieldOutCell pointIndices);
+    using ExecutionSignature = void(PointIndices, _2);
+
+    template <typename InPointIndexType, typename OutPointIndexType>
+    VTKM_EXEC void operator()(const InPointIndexType& inPoints, OutPointIndexType& outPoints) const
+    {
+      for (vtkm::IdComponent i = 0; i < outPoints.GetNumberOfComponents(); ++i)
+      {
+        outPoints[i] = inPoints[i];
+      }
+    }
+  };
+
+  /// \brief Copies the cells selected by a threshold into a compact cell set.
+  ///
+  /// When every input cell has the same shape, the result is a `CellSetSingleType` built with
+  /// a single gather of the point indices of the selected cells. Otherwise the cells are copied
+  /// to a `CellSetExplicit`, which needs to count the points of each cell first.
+  ///
+  template <typename CellSetType>
+  static vtkm::cont::UnknownCellSet MakeCompactCellSet(
+    const vtkm::cont::CellSetPermutation<CellSetType>& cellSet)
+  {
+    return MakeCompactCellSet(cellSet, detail::ThresholdHasSingleShape<CellSetType>{});
+  }
+
   template <typename CellSetType, typename ValueType, typename StorageType, typename UnaryPredicate>
   vtkm::cont::CellSetPermutation<CellSetType> Run(
     const CellSetType& cellSet,
@@ -117,20 +185,41 @@ public:
 
         ThresholdWorklet worklet(predicate, returnAllInRange);
         DispatcherMapTopology<ThresholdWorklet> dispatcher(worklet);
-        dispatcher.Invoke(cellSet, field, passFlags);
-
-        vtkm::cont::Algorithm::CopyIf(vtkm::cont::ArrayHandleIndex(passFlags.GetNumberOfValues()),
-                                      passFlags,
-                                      this->ValidCellIds);
+        if (this->UseCandidateCellIds)
+        {
+          dispatcher.Invoke(vtkm::cont::make_CellSetPermutation(this->CandidateCellIds, cellSet),
+                            field,
+                            passFlags);
+          vtkm::cont::Algorithm::CopyIf(this->CandidateCellIds, passFlags, this->ValidCellIds);
+        }
+        else
+        {
+          dispatcher.Invoke(cellSet, field, passFlags);
+          vtkm::cont::Algorithm::CopyIf(
+            vtkm::cont::ArrayHandleIndex(passFlags.GetNumberOfValues()),
+            passFlags,
+            this->ValidCellIds);
+        }
 
         break;
       }
       case vtkm::cont::Field::Association::Cells:
       {
-        vtkm::cont::Algorithm::CopyIf(vtkm::cont::ArrayHandleIndex(field.GetNumberOfValues()),
-                                      field,
-                                      this->ValidCellIds,
-                                      predicate);
+        if (this->UseCandidateCellIds)
+        {
+          vtkm::cont::Algorithm::CopyIf(
+            this->CandidateCellIds,
+            vtkm::cont::make_ArrayHandlePermutation(this->CandidateCellIds, field),
+            this->ValidCellIds,
+            predicate);
+        }
+        else
+        {
+          vtkm::cont::Algorithm::CopyIf(vtkm::cont::ArrayHandleIndex(field.GetNumberOfValues()),
+                                        field,
+                                        this->ValidCellIds,
+                                        predicate);
+        }
         break;
       }
 
@@ -169,9 +258,20 @@ public:
     template <typename CellSetType>
     void operator()(const CellSetType& cellSet) const
     {
-      // Copy output to an explicit grid so that other units can guess what this is.
-      this->Output = vtkm::worklet::CellDeepCopy::Run(this->Worklet.Run(
-        cellSet, this->Field, this->FieldType, this->Predicate, this->ReturnAllInRange));
+      auto permutation = this->Worklet.Run(
+        cellSet, this->Field, this->FieldType, this->Predicate, this->ReturnAllInRange);
+      switch (this->Worklet.GetOutputCellSet())
+      {
+        case OutputCellSetType::Permutation:
+          this->Output = permutation;
+          break;
+        case OutputCellSetType::Compact:
+          this->Output = MakeCompactCellSet(permutation);
+          break;
+        default:
+          // Copy output to an explicit grid so that other units can guess what this is.
+          this->Output = vtkm::worklet::CellDeepCopy::Run(permutation);
+      }
     }
   };
 
@@ -193,8 +293,72 @@ public:
 
   vtkm::cont::ArrayHandle<vtkm::Id> GetValidCellIds() const { return this->ValidCellIds; }
 
+  /// Sets the type of cell set returned by `Run` on an `UncertainCellSet`.
+  void SetOutputCellSet(OutputCellSetType type) { this->OutputCellSet = type; }
+  OutputCellSetType GetOutputCellSet() const { return this->OutputCellSet; }
+
+  /// \brief Restricts `Run` to the given cells.
+  ///
+  /// Only the listed cells are tested against the predicate, so cells known to fail it (for
+  /// example from a `vtkm::filter::ScalarRangeIndex`) are never visited. The ids must be sorted
+  /// for the output cells to keep their input order.
+  ///
+  void SetCandidateCellIds(const vtkm::cont::ArrayHandle<vtkm::Id>& cellIds)
+  {
+    this->CandidateCellIds = cellIds;
+    this->UseCandidateCellIds = true;
+  }
+
+  /// \brief Tests all cells again in `Run`.
+  void ClearCandidateCellIds()
+  {
+    this->CandidateCellIds.ReleaseResources();
+    this->UseCandidateCellIds = false;
+  }
+
 private:
+  template <typename CellSetType>
+  static vtkm::cont::UnknownCellSet MakeCompactCellSet(
+    const vtkm::cont::CellSetPermutation<CellSetType>& cellSet,
+    std::false_type)
+  {
+    return vtkm::worklet::CellDeepCopy::Run(cellSet);
+  }
+
+  template <typename CellSetType>
+  static vtkm::cont::UnknownCellSet MakeCompactCellSet(
+    const vtkm::cont::CellSetPermutation<CellSetType>& cellSet,
+    std::true_type)
+  {
+    const CellSetType& fullCellSet = cellSet.GetFullCellSet();
+    if (fullCellSet.GetNumberOfCells() < 1)
+    {
+      return vtkm::worklet::CellDeepCopy::Run(cellSet);
+    }
+    const vtkm::UInt8 shape = fullCellSet.GetCellShape(0);
+    const vtkm::IdComponent numPointsInCell = fullCellSet.GetNumberOfPointsInCell(0);
+    const vtkm::Id numCells = cellSet.GetNumberOfCells();
+
+    // The offsets are implicit, so the point indices of the selected cells are gathered
+    // directly to their final place.
+    vtkm::cont::ArrayHandle<vtkm::Id> connectivity;
+    connectivity.Allocate(numCells * numPointsInCell);
+    vtkm::cont::Invoker invoke;
+    invoke(CopyPointIndices{},
+           cellSet,
+           vtkm::cont::make_ArrayHandleGroupVecVariable(
+             connectivity,
+             vtkm::cont::ArrayHandleCounting<vtkm::Id>(0, numPointsInCell, numCells + 1)));
+
+    vtkm::cont::CellSetSingleType<> output;
+    output.Fill(cellSet.GetNumberOfPoints(), shape, numPointsInCell, connectivity);
+    return output;
+  }
+
   vtkm::cont::ArrayHandle<vtkm::Id> ValidCellIds;
+  OutputCellSetType OutputCellSet = OutputCellSetType::Explicit;
+  vtkm::cont::ArrayHandle<vtkm::Id> CandidateCellIds;
+  bool UseCandidateCellIds = false;
 };
 }
 } // namespace vtkm::worklet
@@ -7,13 +7,29 @@
 //  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
 //  PURPOSE.  See the above copyright notice for more information.
 //============================================================================
+#include <vtkm/cont/ArrayHandleIndex.h>
 #include <vtkm/cont/CellSetExtrude.h>
+#include <vtkm/cont/CellSetStructured.h>
 #include <vtkm/cont/ErrorFilterExecution.h>
 #include <vtkm/cont/UncertainCellSet.h>
 #include <vtkm/cont/UnknownCellSet.h>
 #include <vtkm/filter/field_conversion/PointAverage.h>
 #include <vtkm/filter/field_conversion/worklet/PointAverage.h>
 
+namespace
+{
+// The row worklet handles structured cell sets with at least one cell along each axis.
+bool UseStructuredRows(const vtkm::cont::UnknownCellSet& cellSet, vtkm::Id3& pointDimensions)
+{
+  if (!cellSet.IsType<vtkm::cont::CellSetStructured<3>>())
+  {
+    return false;
+  }
+  pointDimensions = cellSet.AsCellSet<vtkm::cont::CellSetStructured<3>>().GetPointDimensions();
+  return (pointDimensions[0] > 1) && (pointDimensions[1] > 1) && (pointDimensions[2] > 1);
+}
+} // anonymous namespace
+
 namespace vtkm
 {
 namespace filter
@@ -37,10 +53,22 @@ vtkm::cont::DataSet PointAverage::DoExecute(const vtkm::cont::DataSet& input)
       vtkm::ListAppend<vtkm::List<vtkm::cont::CellSetExtrude>, VTKM_DEFAULT_CELL_SET_LIST>;
 
     vtkm::cont::ArrayHandle<T> result;
-    this->Invoke(vtkm::worklet::PointAverage{},
-                 cellSet.ResetCellSetList<SupportedCellSets>(),
-                 concrete,
-                 result);
+    vtkm::Id3 pointDimensions;
+    if (UseStructuredRows(cellSet, pointDimensions))
+    {
+      result.Allocate(cellSet.GetNumberOfPoints());
+      this->Invoke(vtkm::worklet::PointAverageStructuredRow{ pointDimensions },
+                   vtkm::cont::ArrayHandleIndex(pointDimensions[1] * pointDimensions[2]),
+                   concrete,
+                   result);
+    }
+    else
+    {
+      this->Invoke(vtkm::worklet::PointAverage{},
+                   cellSet.ResetCellSetList<SupportedCellSets>(),
+                   concrete,
+                   result);
+    }
     outArray = result;
   };
   // TODO: Do we need to deal with XCG storage type explicitly?
@@ -8,6 +8,7 @@
 //  PURPOSE.  See the above copyright notice for more information.
 //============================================================================
 
+#include <vtkm/cont/DataSetBuilderUniform.h>
 #include <vtkm/cont/testing/MakeTestDataSet.h>
 #include <vtkm/cont/testing/Testing.h>
 #include <vtkm/filter/field_conversion/PointAverage.h>
@@ -113,10 +114,72 @@ void TestPointAverageExplicit2()
   }
 }
 
+void TestPointAverageStructuredRows()
+{
+  std::cout << "Testing PointAverage Filter on a larger 3D structured grid" << std::endl;
+
+  const vtkm::Id3 dims(6, 4, 3);
+  const vtkm::Id3 cellDims = dims - vtkm::Id3(1);
+  vtkm::cont::DataSet dataSet = vtkm::cont::DataSetBuilderUniform::Create(dims);
+  auto cellValue = [&](vtkm::Id i, vtkm::Id j, vtkm::Id k) {
+    const vtkm::Float64 value = static_cast<vtkm::Float64>(i * i + 3 * j - k * j);
+    return vtkm::Vec3f_64(value, 2 * value, static_cast<vtkm::Float64>(k));
+  };
+  std::vector<vtkm::Vec3f_64> cellValues;
+  for (vtkm::Id k = 0; k < cellDims[2]; ++k)
+  {
+    for (vtkm::Id j = 0; j < cellDims[1]; ++j)
+    {
+      for (vtkm::Id i = 0; i < cellDims[0]; ++i)
+      {
+        cellValues.push_back(cellValue(i, j, k));
+      }
+    }
+  }
+  dataSet.AddCellField("cellvar", cellValues);
+
+  vtkm::filter::field_conversion::PointAverage pointAverage;
+  pointAverage.SetActiveField("cellvar");
+  auto result = pointAverage.Execute(dataSet);
+
+  vtkm::cont::ArrayHandle<vtkm::Vec3f_64> resultArrayHandle;
+  result.GetPointField("cellvar").GetData().AsArrayHandle(resultArrayHandle);
+  VTKM_TEST_ASSERT(resultArrayHandle.GetNumberOfValues() == 6 * 4 * 3, "Wrong number of points");
+  auto portal = resultArrayHandle.ReadPortal();
+  vtkm::Id point = 0;
+  for (vtkm::Id k = 0; k < dims[2]; ++k)
+  {
+    for (vtkm::Id j = 0; j < dims[1]; ++j)
+    {
+      for (vtkm::Id i = 0; i < dims[0]; ++i)
+      {
+        vtkm::Vec3f_64 sum(0);
+        vtkm::Id numCells = 0;
+        for (vtkm::Id corner = 0; corner < 8; ++corner)
+        {
+          const vtkm::Id3 cellIndex(i - (corner & 1), j - ((corner >> 1) & 1), k - (corner >> 2));
+          if ((cellIndex[0] >= 0) && (cellIndex[1] >= 0) && (cellIndex[2] >= 0) &&
+              (cellIndex[0] < cellDims[0]) && (cellIndex[1] < cellDims[1]) &&
+              (cellIndex[2] < cellDims[2]))
+          {
+            sum += cellValue(cellIndex[0], cellIndex[1], cellIndex[2]);
+            ++numCells;
+          }
+        }
+        VTKM_TEST_ASSERT(test_equal(portal.Get(point), sum / static_cast<vtkm::Float64>(numCells)),
+                         "Wrong result for PointAverage on point ",
+                         point);
+        ++point;
+      }
+    }
+  }
+}
+
 void TestPointAverage()
 {
   TestPointAverageUniform3D();
   TestPointAverageRegular3D();
+  TestPointAverageStructuredRows();
   TestPointAverageExplicit1();
   TestPointAverageExplicit2();
 }
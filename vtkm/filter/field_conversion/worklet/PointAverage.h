@@ -11,8 +11,10 @@
 #ifndef vtk_m_worklet_PointAverage_h
 #define vtk_m_worklet_PointAverage_h
 
+#include <vtkm/worklet/WorkletMapField.h>
 #include <vtkm/worklet/WorkletMapTopology.h>
 
+#include <vtkm/Math.h>
 #include <vtkm/VecTraits.h>
 
 namespace vtkm
@@ -81,6 +83,79 @@ private:
     this->RaiseError("PointAverage called with mismatched Vec sizes for PointAverage.");
   }
 };
+
+//averages the cell values around the points of a CellSetStructured<3> one row
+//of points at a time. The cells of each column around the row are summed once and
+//the sum is shared by the 2 points using them, so each cell value is loaded once
+//per row instead of once for each of its points.
+class PointAverageStructuredRow : public vtkm::worklet::WorkletMapField
+{
+public:
+  using ControlSignature = void(FieldIn rowIndex, WholeArrayIn inCells, WholeArrayOut outPoints);
+  using ExecutionSignature = void(_1, _2, _3);
+  using InputDomain = _1;
+
+  VTKM_CONT explicit PointAverageStructuredRow(const vtkm::Id3& pointDimensions)
+    : PointDimensions(pointDimensions)
+  {
+  }
+
+  template <typename InPortalType, typename OutPortalType>
+  VTKM_EXEC void operator()(vtkm::Id row,
+                            const InPortalType& inCells,
+                            const OutPortalType& outPoints) const
+  {
+    using OutType = typename OutPortalType::ValueType;
+    using OutComponentType = typename vtkm::VecTraits<OutType>::ComponentType;
+
+    const vtkm::Id rowLength = this->PointDimensions[0];
+    const vtkm::Id3 cellDimensions = this->PointDimensions - vtkm::Id3(1);
+    const vtkm::Id j = row % this->PointDimensions[1];
+    const vtkm::Id k = row / this->PointDimensions[1];
+
+    // The rows of cells around this row of points.
+    vtkm::Id cellRows[4] = { 0, 0, 0, 0 };
+    vtkm::IdComponent numCellRows = 0;
+    for (vtkm::Id cellK = vtkm::Max(k - 1, vtkm::Id(0));
+         cellK <= vtkm::Min(k, cellDimensions[2] - 1);
+         ++cellK)
+    {
+      for (vtkm::Id cellJ = vtkm::Max(j - 1, vtkm::Id(0));
+           cellJ <= vtkm::Min(j, cellDimensions[1] - 1);
+           ++cellJ)
+      {
+        cellRows[numCellRows++] = cellDimensions[0] * (cellJ + cellDimensions[1] * cellK);
+      }
+    }
+
+    auto columnSum = [&](vtkm::Id i) {
+      OutType sum = OutType(inCells.Get(cellRows[0] + i));
+      for (vtkm::IdComponent cellRow = 1; cellRow < numCellRows; ++cellRow)
+      {
+        // static_cast is for when OutType is a small int that gets promoted to int32.
+        sum = static_cast<OutType>(sum + OutType(inCells.Get(cellRows[cellRow] + i)));
+      }
+      return sum;
+    };
+
+    const vtkm::Id pointRow = row * rowLength;
+    OutType previous = columnSum(0);
+    // The points at the ends of the row only have one column of cells.
+    const OutType numEndCells = OutType(static_cast<OutComponentType>(numCellRows));
+    outPoints.Set(pointRow, static_cast<OutType>(previous / numEndCells));
+    const OutType numCells = OutType(static_cast<OutComponentType>(2 * numCellRows));
+    for (vtkm::Id i = 1; i < cellDimensions[0]; ++i)
+    {
+      const OutType next = columnSum(i);
+      outPoints.Set(pointRow + i, static_cast<OutType>((previous + next) / numCells));
+      previous = next;
+    }
+    outPoints.Set(pointRow + cellDimensions[0], static_cast<OutType>(previous / numEndCells));
+  }
+
+private:
+  vtkm::Id3 PointDimensions;
+};
 }
 } // namespace vtkm::worklet
 
@@ -63,6 +63,14 @@ public:
   VTKM_CONT
   void SetUseThreadedAlgorithm(bool val) { this->UseThreadedAlgorithm = val; }
 
+  /// Advect particles in the order of a Morton code of their position rather than
+  /// in the order given. The order of the particles in the output is unchanged.
+  VTKM_CONT
+  bool GetUseSpatialOrdering() const { return this->UseSpatialOrdering; }
+
+  VTKM_CONT
+  void SetUseSpatialOrdering(bool val) { this->UseSpatialOrdering = val; }
+
 protected:
   VTKM_CONT virtual void ValidateOptions() const;
 
@@ -74,6 +82,7 @@ protected:
     vtkm::filter::flow::IntegrationSolverType::RK4_TYPE;
   vtkm::FloatDefault StepSize = 0;
   bool UseThreadedAlgorithm = false;
+  bool UseSpatialOrdering = false;
   vtkm::filter::flow::VectorFieldType VecFieldType =
     vtkm::filter::flow::VectorFieldType::VELOCITY_FIELD_TYPE;
 
@@ -61,6 +61,10 @@ VTKM_CONT vtkm::cont::PartitionedDataSet NewFilterParticleAdvectionSteadyState::
                                       this->SolverType,
                                       this->VecFieldType,
                                       this->GetResultType());
+  for (auto& integrator : dsi)
+  {
+    integrator.SetUseSpatialOrdering(this->UseSpatialOrdering);
+  }
 
   vtkm::filter::flow::internal::ParticleAdvector<DSIType> pav(
     boundsMap, dsi, this->UseThreadedAlgorithm, this->GetResultType());
@@ -75,6 +75,10 @@ NewFilterParticleAdvectionUnsteadyState::DoExecutePartitions(
                                       this->SolverType,
                                       this->VecFieldType,
                                       this->GetResultType());
+  for (auto& integrator : dsi)
+  {
+    integrator.SetUseSpatialOrdering(this->UseSpatialOrdering);
+  }
 
   vtkm::filter::flow::internal::ParticleAdvector<DSIType> pav(
     boundsMap, dsi, this->UseThreadedAlgorithm, this->GetResultType());
@@ -0,0 +1,265 @@
+//============================================================================
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//============================================================================
+
+#include <vtkm/UnaryPredicates.h>
+#include <vtkm/cont/Algorithm.h>
+#include <vtkm/cont/ArrayCopy.h>
+#include <vtkm/cont/ErrorFilterExecution.h>
+#include <vtkm/cont/Invoker.h>
+#include <vtkm/cont/Logging.h>
+#include <vtkm/cont/ParticleArrayCopy.h>
+#include <vtkm/filter/flow/StreamingPathline.h>
+#include <vtkm/filter/flow/worklet/EulerIntegrator.h>
+#include <vtkm/filter/flow/worklet/ParticleAdvection.h>
+#include <vtkm/filter/flow/worklet/RK4Integrator.h>
+#include <vtkm/filter/flow/worklet/Stepper.h>
+#include <vtkm/filter/flow/worklet/TemporalGridEvaluators.h>
+
+#include <future>
+
+namespace vtkm
+{
+namespace filter
+{
+namespace flow
+{
+namespace
+{
+using ArrayType = vtkm::cont::ArrayHandle<vtkm::Vec3f>;
+using FieldType = vtkm::worklet::flow::VelocityField<ArrayType>;
+using TemporalGridEvalType = vtkm::worklet::flow::TemporalGridEvaluator<FieldType>;
+using StreamlineResultType = vtkm::worklet::flow::StreamlineResult<vtkm::Particle>;
+
+// Particles that stopped only because they reached the end of the current interval
+// get their status reset so that they continue in the next one.
+class ResumeAtTemporalBoundary : public vtkm::worklet::WorkletMapField
+{
+public:
+  using ControlSignature = void(FieldInOut particle, FieldOut alive);
+  using ExecutionSignature = void(_1, _2);
+
+  VTKM_EXEC void operator()(vtkm::Particle& particle, bool& alive) const
+  {
+    const auto& status = particle.Status;
+    alive = status.CheckTemporalBounds() && !status.CheckTerminate() &&
+      !status.CheckSpatialBounds() && !status.CheckInGhostCell();
+    if (alive)
+      particle.Status = vtkm::ParticleStatus();
+  }
+};
+
+FieldType GetVelocityField(const vtkm::cont::DataSet& ds, const std::string& fieldName)
+{
+  if (!ds.HasPointField(fieldName) && !ds.HasCellField(fieldName))
+    throw vtkm::cont::ErrorFilterExecution("Unsupported field assocation");
+
+  const auto& field = ds.GetField(fieldName);
+  ArrayType arr;
+  vtkm::cont::ArrayCopyShallowIfPossible(field.GetData(), arr);
+  return FieldType(arr, field.GetAssociation());
+}
+
+template <template <typename> class SolverType>
+void AdvectInterval(const TemporalGridEvalType& eval,
+                    vtkm::FloatDefault stepSize,
+                    vtkm::cont::ArrayHandle<vtkm::Particle>& particles,
+                    vtkm::Id maxSteps,
+                    bool recordPathlines,
+                    std::vector<StreamlineResultType>& segments)
+{
+  using StepperType =
+    vtkm::worklet::flow::Stepper<SolverType<TemporalGridEvalType>, TemporalGridEvalType>;
+  StepperType stepper(eval, stepSize);
+
+  if (recordPathlines)
+  {
+    vtkm::worklet::flow::Streamline worklet;
+    segments.emplace_back(worklet.Run(stepper, particles, maxSteps));
+  }
+  else
+  {
+    vtkm::worklet::flow::ParticleAdvection worklet;
+    worklet.Run(stepper, particles, maxSteps);
+  }
+}
+
+vtkm::cont::DataSet MakePathlineOutput(const std::vector<StreamlineResultType>& segments)
+{
+  vtkm::cont::DataSet ds;
+
+  vtkm::Id totalNumCells = 0, totalNumPts = 0;
+  for (const auto& res : segments)
+  {
+    totalNumPts += res.Positions.GetNumberOfValues();
+    totalNumCells += res.PolyLines.GetNumberOfCells();
+  }
+
+  //Append all the points together.
+  vtkm::cont::ArrayHandle<vtkm::Vec3f> appendPts;
+  appendPts.Allocate(totalNumPts);
+  std::vector<vtkm::Id> numPtsPerCell;
+  numPtsPerCell.reserve(static_cast<std::size_t>(totalNumCells));
+  vtkm::Id posOffset = 0;
+  for (const auto& res : segments)
+  {
+    vtkm::Id nPts = res.Positions.GetNumberOfValues();
+    vtkm::cont::Algorithm::CopySubRange(res.Positions, 0, nPts, appendPts, posOffset);
+    posOffset += nPts;
+
+    vtkm::Id nCells = res.PolyLines.GetNumberOfCells();
+    for (vtkm::Id j = 0; j < nCells; j++)
+      numPtsPerCell.emplace_back(static_cast<vtkm::Id>(res.PolyLines.GetNumberOfPointsInCell(j)));
+  }
+  ds.AddCoordinateSystem(vtkm::cont::CoordinateSystem("coordinates", appendPts));
+
+  //Create polylines.
+  auto numPointsPerCellArray = vtkm::cont::make_ArrayHandle(numPtsPerCell, vtkm::CopyFlag::Off);
+  vtkm::cont::ArrayHandle<vtkm::Id> connectivity;
+  vtkm::cont::ArrayCopy(vtkm::cont::ArrayHandleIndex(totalNumPts), connectivity);
+
+  vtkm::cont::ArrayHandle<vtkm::UInt8> cellTypes;
+  vtkm::cont::ArrayCopy(
+    vtkm::cont::make_ArrayHandleConstant<vtkm::UInt8>(vtkm::CELL_SHAPE_POLY_LINE, totalNumCells),
+    cellTypes);
+  auto offsets = vtkm::cont::ConvertNumComponentsToOffsets(numPointsPerCellArray);
+
+  vtkm::cont::CellSetExplicit<> polyLines;
+  polyLines.Fill(totalNumPts, cellTypes, connectivity, offsets);
+  ds.SetCellSet(polyLines);
+
+  return ds;
+}
+
+vtkm::cont::DataSet MakeParticleOutput(const vtkm::cont::ArrayHandle<vtkm::Particle>& particles)
+{
+  vtkm::cont::DataSet ds;
+
+  vtkm::cont::ArrayHandle<vtkm::Vec3f> pts;
+  vtkm::cont::ParticleArrayCopy(particles, pts);
+  vtkm::Id numPoints = pts.GetNumberOfValues();
+  ds.AddCoordinateSystem(vtkm::cont::CoordinateSystem("coordinates", pts));
+
+  vtkm::cont::CellSetSingleType<> cells;
+  vtkm::cont::ArrayHandle<vtkm::Id> connectivity;
+  vtkm::cont::ArrayCopy(vtkm::cont::ArrayHandleIndex(numPoints), connectivity);
+  cells.Fill(numPoints, vtkm::CELL_SHAPE_VERTEX, 1, connectivity);
+  ds.SetCellSet(cells);
+
+  return ds;
+}
+} // anonymous namespace
+
+VTKM_CONT void StreamingPathline::ValidateOptions() const
+{
+  if (!this->Loader)
+    throw vtkm::cont::ErrorFilterExecution("No time slice loader provided.");
+  if (this->TimeValues.size() < 2)
+    throw vtkm::cont::ErrorFilterExecution("At least two time slices are required.");
+  for (std::size_t i = 1; i < this->TimeValues.size(); i++)
+    if (this->TimeValues[i - 1] >= this->TimeValues[i])
+      throw vtkm::cont::ErrorFilterExecution("Time values must be strictly increasing.");
+  if (this->ActiveFieldName.empty())
+    throw vtkm::cont::ErrorFilterExecution("No active field specified.");
+  if (this->Seeds.GetNumberOfValues() == 0)
+    throw vtkm::cont::ErrorFilterExecution("No seeds provided.");
+  if (this->NumberOfSteps <= 0)
+    throw vtkm::cont::ErrorFilterExecution("Number of steps not specified.");
+  if (this->StepSize <= 0)
+    throw vtkm::cont::ErrorFilterExecution("Step size not specified.");
+}
+
+VTKM_CONT vtkm::cont::DataSet StreamingPathline::Execute()
+{
+  this->ValidateOptions();
+
+  const vtkm::Id numSlices = static_cast<vtkm::Id>(this->TimeValues.size());
+  auto loadSlice = [this](vtkm::Id index) { return this->Loader(index); };
+  auto timeValue = [this](vtkm::Id index) {
+    return this->TimeValues[static_cast<std::size_t>(index)];
+  };
+
+  vtkm::cont::ArrayHandle<vtkm::Particle> live;
+  vtkm::cont::ArrayCopy(this->Seeds, live);
+
+  std::vector<vtkm::cont::ArrayHandle<vtkm::Particle>> finished;
+  std::vector<StreamlineResultType> segments;
+  vtkm::cont::Invoker invoke;
+
+  vtkm::cont::DataSet slice0 = loadSlice(0);
+  FieldType field0 = GetVelocityField(slice0, this->ActiveFieldName);
+  std::future<vtkm::cont::DataSet> next;
+  if (this->UsePrefetch)
+    next = std::async(std::launch::async, loadSlice, 1);
+
+  for (vtkm::Id i = 0; i < numSlices - 1; i++)
+  {
+    vtkm::cont::DataSet slice1 = this->UsePrefetch ? next.get() : loadSlice(i + 1);
+    if (this->UsePrefetch && i + 2 < numSlices)
+      next = std::async(std::launch::async, loadSlice, i + 2);
+    FieldType field1 = GetVelocityField(slice1, this->ActiveFieldName);
+
+    VTKM_LOG_S(vtkm::cont::LogLevel::Perf,
+               "StreamingPathline advecting " << live.GetNumberOfValues()
+                                              << " particles over interval " << i);
+
+    TemporalGridEvalType eval(slice0, timeValue(i), field0, slice1, timeValue(i + 1), field1);
+    if (this->SolverType == IntegrationSolverType::RK4_TYPE)
+      AdvectInterval<vtkm::worklet::flow::RK4Integrator>(
+        eval, this->StepSize, live, this->NumberOfSteps, this->OutputPathlines, segments);
+    else if (this->SolverType == IntegrationSolverType::EULER_TYPE)
+      AdvectInterval<vtkm::worklet::flow::EulerIntegrator>(
+        eval, this->StepSize, live, this->NumberOfSteps, this->OutputPathlines, segments);
+    else
+      throw vtkm::cont::ErrorFilterExecution("Unsupported Integrator type");
+
+    //Retire the particles that are done and continue with the rest.
+    vtkm::cont::ArrayHandle<bool> alive;
+    invoke(ResumeAtTemporalBoundary{}, live, alive);
+    vtkm::cont::ArrayHandle<vtkm::Particle> done, stillAlive;
+    vtkm::cont::Algorithm::CopyIf(live, alive, done, vtkm::LogicalNot());
+    vtkm::cont::Algorithm::CopyIf(live, alive, stillAlive);
+    if (done.GetNumberOfValues() > 0)
+      finished.emplace_back(done);
+    live = stillAlive;
+
+    if (live.GetNumberOfValues() == 0)
+      break;
+
+    //Slide the window. The old slice is released here.
+    slice0 = slice1;
+    field0 = field1;
+  }
+  if (live.GetNumberOfValues() > 0)
+    finished.emplace_back(live);
+
+  //Wait for an outstanding prefetch if we finished early.
+  if (next.valid())
+    next.wait();
+
+  vtkm::Id numParticles = 0;
+  for (const auto& p : finished)
+    numParticles += p.GetNumberOfValues();
+  this->Particles = vtkm::cont::ArrayHandle<vtkm::Particle>{};
+  this->Particles.Allocate(numParticles);
+  vtkm::Id offset = 0;
+  for (const auto& p : finished)
+  {
+    vtkm::cont::Algorithm::CopySubRange(p, 0, p.GetNumberOfValues(), this->Particles, offset);
+    offset += p.GetNumberOfValues();
+  }
+
+  if (this->OutputPathlines)
+    return MakePathlineOutput(segments);
+  return MakeParticleOutput(this->Particles);
+}
+
+}
+}
+} // namespace vtkm::filter::flow
@@ -0,0 +1,130 @@
+//============================================================================
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//============================================================================
+
+#ifndef vtk_m_filter_flow_StreamingPathline_h
+#define vtk_m_filter_flow_StreamingPathline_h
+
+#include <vtkm/Particle.h>
+#include <vtkm/cont/ArrayHandle.h>
+#include <vtkm/cont/DataSet.h>
+#include <vtkm/filter/flow/FlowTypes.h>
+#include <vtkm/filter/flow/vtkm_filter_flow_export.h>
+
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace vtkm
+{
+namespace filter
+{
+namespace flow
+{
+
+/// \brief Advect particles through a time series that is loaded on demand.
+
+/// `Pathline` requires the data sets at both ends of the time interval to be
+/// resident for the whole advection. `StreamingPathline` instead pulls each time
+/// slice from a user supplied loader and advances all particles one interval at a
+/// time. Only the two slices bounding the current interval are kept, and while an
+/// interval is advected the next slice is loaded on a background thread. Memory use
+/// is therefore bounded by three time slices regardless of the length of the series.
+///
+/// The loader is called exactly once for each slice, in increasing order, and may be
+/// called from a thread other than the one calling `Execute`.
+///
+/// The output is either the pathlines (one polyline per particle and interval) or,
+/// when `SetOutputPathlines(false)` is used, the final particle positions as vertices.
+
+class VTKM_FILTER_FLOW_EXPORT StreamingPathline
+{
+public:
+  using TimeSliceLoaderType = std::function<vtkm::cont::DataSet(vtkm::Id)>;
+
+  /// Set the function returning the data set for a given time slice index.
+  VTKM_CONT void SetTimeSliceLoader(const TimeSliceLoaderType& loader) { this->Loader = loader; }
+
+  /// Set the time value of each slice. The number of slices is the size of this
+  /// vector and the values must be strictly increasing.
+  VTKM_CONT void SetTimeValues(const std::vector<vtkm::FloatDefault>& times)
+  {
+    this->TimeValues = times;
+  }
+
+  VTKM_CONT void SetActiveField(const std::string& name) { this->ActiveFieldName = name; }
+  VTKM_CONT const std::string& GetActiveFieldName() const { return this->ActiveFieldName; }
+
+  VTKM_CONT void SetStepSize(vtkm::FloatDefault s) { this->StepSize = s; }
+
+  /// Maximum number of steps over the whole time series.
+  VTKM_CONT void SetNumberOfSteps(vtkm::Id n) { this->NumberOfSteps = n; }
+
+  VTKM_CONT void SetSeeds(const vtkm::cont::ArrayHandle<vtkm::Particle>& seeds)
+  {
+    this->Seeds = seeds;
+  }
+
+  VTKM_CONT void SetSeeds(const std::vector<vtkm::Particle>& seeds,
+                          vtkm::CopyFlag copyFlag = vtkm::CopyFlag::On)
+  {
+    this->Seeds = vtkm::cont::make_ArrayHandle(seeds, copyFlag);
+  }
+
+  VTKM_CONT
+  void SetSolverRK4() { this->SolverType = vtkm::filter::flow::IntegrationSolverType::RK4_TYPE; }
+  VTKM_CONT
+  void SetSolverEuler()
+  {
+    this->SolverType = vtkm::filter::flow::IntegrationSolverType::EULER_TYPE;
+  }
+
+  /// Load the next time slice on a background thread while the current interval
+  /// is advected. On by default.
+  VTKM_CONT void SetUsePrefetch(bool val) { this->UsePrefetch = val; }
+  VTKM_CONT bool GetUsePrefetch() const { return this->UsePrefetch; }
+
+  VTKM_CONT void SetOutputPathlines(bool val) { this->OutputPathlines = val; }
+  VTKM_CONT bool GetOutputPathlines() const { return this->OutputPathlines; }
+
+  /// \brief The particles at the end of the last call to `Execute`.
+  ///
+  /// The particles are not in the order of the seeds. They are grouped by the interval in
+  /// which they stopped, earliest first, and keep the order of the seeds within each group.
+  /// Match them with their seeds by `ID`. The vertices output with
+  /// `SetOutputPathlines(false)` are in the same order.
+  ///
+  VTKM_CONT vtkm::cont::ArrayHandle<vtkm::Particle> GetParticles() const
+  {
+    return this->Particles;
+  }
+
+  VTKM_CONT vtkm::cont::DataSet Execute();
+
+private:
+  VTKM_CONT void ValidateOptions() const;
+
+  TimeSliceLoaderType Loader;
+  std::vector<vtkm::FloatDefault> TimeValues;
+  std::string ActiveFieldName;
+  vtkm::Id NumberOfSteps = 0;
+  vtkm::FloatDefault StepSize = 0;
+  vtkm::cont::ArrayHandle<vtkm::Particle> Seeds;
+  vtkm::cont::ArrayHandle<vtkm::Particle> Particles;
+  vtkm::filter::flow::IntegrationSolverType SolverType =
+    vtkm::filter::flow::IntegrationSolverType::RK4_TYPE;
+  bool UsePrefetch = true;
+  bool OutputPathlines = true;
+};
+
+}
+}
+} // namespace vtkm::filter::flow
+
+#endif // vtk_m_filter_flow_StreamingPathline_h
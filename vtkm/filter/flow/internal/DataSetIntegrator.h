@@ -90,6 +90,7 @@ public:
 
   VTKM_CONT vtkm::Id GetID() const { return this->Id; }
   VTKM_CONT void SetCopySeedFlag(bool val) { this->CopySeedArray = val; }
+  VTKM_CONT void SetUseSpatialOrdering(bool val) { this->UseSpatialOrdering = val; }
 
   VTKM_CONT
   void Advect(DSIHelperInfoType& b,
@@ -137,6 +138,7 @@ protected:
   vtkmdiy::mpi::communicator Comm = vtkm::cont::EnvironmentTracker::GetCommunicator();
   vtkm::Id Rank;
   bool CopySeedArray = false;
+  bool UseSpatialOrdering = false;
   std::vector<RType> Results;
 };
 
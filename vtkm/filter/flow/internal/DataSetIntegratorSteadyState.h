@@ -92,6 +92,7 @@ public:
                      vtkm::FloatDefault stepSize,
                      vtkm::Id maxSteps,
                      const IntegrationSolverType& solverType,
+                     bool useSpatialOrdering,
                      vtkm::worklet::flow::ParticleAdvectionResult<ParticleType>& result)
   {
     if (solverType == IntegrationSolverType::RK4_TYPE)
@@ -99,14 +100,14 @@ public:
       DoAdvect<vtkm::worklet::flow::ParticleAdvection,
                vtkm::worklet::flow::ParticleAdvectionResult,
                vtkm::worklet::flow::RK4Integrator>(
-        velField, ds, seedArray, stepSize, maxSteps, result);
+        velField, ds, seedArray, stepSize, maxSteps, useSpatialOrdering, result);
     }
     else if (solverType == IntegrationSolverType::EULER_TYPE)
     {
       DoAdvect<vtkm::worklet::flow::ParticleAdvection,
                vtkm::worklet::flow::ParticleAdvectionResult,
                vtkm::worklet::flow::EulerIntegrator>(
-        velField, ds, seedArray, stepSize, maxSteps, result);
+        velField, ds, seedArray, stepSize, maxSteps, useSpatialOrdering, result);
     }
     else
       throw vtkm::cont::ErrorFilterExecution("Unsupported Integrator type");
@@ -118,6 +119,7 @@ public:
                      vtkm::FloatDefault stepSize,
                      vtkm::Id maxSteps,
                      const IntegrationSolverType& solverType,
+                     bool useSpatialOrdering,
                      vtkm::worklet::flow::StreamlineResult<ParticleType>& result)
   {
     if (solverType == IntegrationSolverType::RK4_TYPE)
@@ -125,14 +127,14 @@ public:
       DoAdvect<vtkm::worklet::flow::Streamline,
                vtkm::worklet::flow::StreamlineResult,
                vtkm::worklet::flow::RK4Integrator>(
-        velField, ds, seedArray, stepSize, maxSteps, result);
+        velField, ds, seedArray, stepSize, maxSteps, useSpatialOrdering, result);
     }
     else if (solverType == IntegrationSolverType::EULER_TYPE)
     {
       DoAdvect<vtkm::worklet::flow::Streamline,
                vtkm::worklet::flow::StreamlineResult,
                vtkm::worklet::flow::EulerIntegrator>(
-        velField, ds, seedArray, stepSize, maxSteps, result);
+        velField, ds, seedArray, stepSize, maxSteps, useSpatialOrdering, result);
     }
     else
       throw vtkm::cont::ErrorFilterExecution("Unsupported Integrator type");
@@ -148,12 +150,14 @@ public:
                        vtkm::cont::ArrayHandle<ParticleType>& seedArray,
                        vtkm::FloatDefault stepSize,
                        vtkm::Id maxSteps,
+                       bool useSpatialOrdering,
                        ResultType<ParticleType>& result)
   {
     using StepperType =
       vtkm::worklet::flow::Stepper<SolverType<SteadyStateGridEvalType>, SteadyStateGridEvalType>;
 
     WorkletType worklet;
+    worklet.SetUseSpatialOrdering(useSpatialOrdering);
     SteadyStateGridEvalType eval(ds, velField);
     StepperType stepper(eval, stepSize);
     result = worklet.Run(stepper, seedArray, maxSteps);
@@ -181,15 +185,27 @@ VTKM_CONT inline void DataSetIntegratorSteadyState::DoAdvect(DSIHelperInfo<vtkm:
     if (this->IsParticleAdvectionResult())
     {
       vtkm::worklet::flow::ParticleAdvectionResult<vtkm::Particle> result;
-      AHType::Advect(
-        velField, this->DataSet, seedArray, stepSize, maxSteps, this->SolverType, result);
+      AHType::Advect(velField,
+                     this->DataSet,
+                     seedArray,
+                     stepSize,
+                     maxSteps,
+                     this->SolverType,
+                     this->UseSpatialOrdering,
+                     result);
       this->UpdateResult(result, b);
     }
     else if (this->IsStreamlineResult())
     {
       vtkm::worklet::flow::StreamlineResult<vtkm::Particle> result;
-      AHType::Advect(
-        velField, this->DataSet, seedArray, stepSize, maxSteps, this->SolverType, result);
+      AHType::Advect(velField,
+                     this->DataSet,
+                     seedArray,
+                     stepSize,
+                     maxSteps,
+                     this->SolverType,
+                     this->UseSpatialOrdering,
+                     result);
       this->UpdateResult(result, b);
     }
     else
@@ -115,21 +115,40 @@ public:
                      vtkm::FloatDefault stepSize,
                      vtkm::Id maxSteps,
                      const IntegrationSolverType& solverType,
+                     bool useSpatialOrdering,
                      vtkm::worklet::flow::ParticleAdvectionResult<ParticleType>& result)
   {
     if (solverType == IntegrationSolverType::RK4_TYPE)
     {
       DoAdvect<vtkm::worklet::flow::ParticleAdvection,
                vtkm::worklet::flow::ParticleAdvectionResult,
-               vtkm::worklet::flow::RK4Integrator>(
-        velField1, ds1, t1, velField2, ds2, t2, seedArray, stepSize, maxSteps, result);
+               vtkm::worklet::flow::RK4Integrator>(velField1,
+                                                   ds1,
+                                                   t1,
+                                                   velField2,
+                                                   ds2,
+                                                   t2,
+                                                   seedArray,
+                                                   stepSize,
+                                                   maxSteps,
+                                                   useSpatialOrdering,
+                                                   result);
     }
     else if (solverType == IntegrationSolverType::EULER_TYPE)
     {
       DoAdvect<vtkm::worklet::flow::ParticleAdvection,
                vtkm::worklet::flow::ParticleAdvectionResult,
-               vtkm::worklet::flow::EulerIntegrator>(
-        velField1, ds1, t1, velField2, ds2, t2, seedArray, stepSize, maxSteps, result);
+               vtkm::worklet::flow::EulerIntegrator>(velField1,
+                                                     ds1,
+                                                     t1,
+                                                     velField2,
+                                                     ds2,
+                                                     t2,
+                                                     seedArray,
+                                                     stepSize,
+                                                     maxSteps,
+                                                     useSpatialOrdering,
+                                                     result);
     }
     else
       throw vtkm::cont::ErrorFilterExecution("Unsupported Integrator type");
@@ -145,21 +164,40 @@ public:
                      vtkm::FloatDefault stepSize,
                      vtkm::Id maxSteps,
                      const IntegrationSolverType& solverType,
+                     bool useSpatialOrdering,
                      vtkm::worklet::flow::StreamlineResult<ParticleType>& result)
   {
     if (solverType == IntegrationSolverType::RK4_TYPE)
     {
       DoAdvect<vtkm::worklet::flow::Streamline,
                vtkm::worklet::flow::StreamlineResult,
-               vtkm::worklet::flow::RK4Integrator>(
-        velField1, ds1, t1, velField2, ds2, t2, seedArray, stepSize, maxSteps, result);
+               vtkm::worklet::flow::RK4Integrator>(velField1,
+                                                   ds1,
+                                                   t1,
+                                                   velField2,
+                                                   ds2,
+                                                   t2,
+                                                   seedArray,
+                                                   stepSize,
+                                                   maxSteps,
+                                                   useSpatialOrdering,
+                                                   result);
     }
     else if (solverType == IntegrationSolverType::EULER_TYPE)
     {
       DoAdvect<vtkm::worklet::flow::Streamline,
                vtkm::worklet::flow::StreamlineResult,
-               vtkm::worklet::flow::EulerIntegrator>(
-        velField1, ds1, t1, velField2, ds2, t2, seedArray, stepSize, maxSteps, result);
+               vtkm::worklet::flow::EulerIntegrator>(velField1,
+                                                     ds1,
+                                                     t1,
+                                                     velField2,
+                                                     ds2,
+                                                     t2,
+                                                     seedArray,
+                                                     stepSize,
+                                                     maxSteps,
+                                                     useSpatialOrdering,
+                                                     result);
     }
     else
       throw vtkm::cont::ErrorFilterExecution("Unsupported Integrator type");
@@ -179,12 +217,14 @@ public:
                        vtkm::cont::ArrayHandle<ParticleType>& seedArray,
                        vtkm::FloatDefault stepSize,
                        vtkm::Id maxSteps,
+                       bool useSpatialOrdering,
                        ResultType<ParticleType>& result)
   {
     using StepperType = vtkm::worklet::flow::Stepper<SolverType<UnsteadyStateGridEvalType>,
                                                      UnsteadyStateGridEvalType>;
 
     WorkletType worklet;
+    worklet.SetUseSpatialOrdering(useSpatialOrdering);
     UnsteadyStateGridEvalType eval(ds1, t1, velField1, ds2, t2, velField2);
     StepperType stepper(eval, stepSize);
     result = worklet.Run(stepper, seedArray, maxSteps);
@@ -223,6 +263,7 @@ VTKM_CONT inline void DataSetIntegratorUnsteadyState::DoAdvect(DSIHelperInfo<vtk
                      stepSize,
                      maxSteps,
                      this->SolverType,
+                     this->UseSpatialOrdering,
                      result);
       this->UpdateResult(result, b);
     }
@@ -239,6 +280,7 @@ VTKM_CONT inline void DataSetIntegratorUnsteadyState::DoAdvect(DSIHelperInfo<vtk
                      stepSize,
                      maxSteps,
                      this->SolverType,
+                     this->UseSpatialOrdering,
                      result);
       this->UpdateResult(result, b);
     }
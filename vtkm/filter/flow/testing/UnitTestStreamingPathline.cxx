@@ -0,0 +1,110 @@
+//============================================================================
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//============================================================================
+
+#include <vtkm/cont/ArrayCopy.h>
+#include <vtkm/cont/ArrayHandleConstant.h>
+#include <vtkm/cont/DataSetBuilderUniform.h>
+#include <vtkm/cont/testing/Testing.h>
+#include <vtkm/filter/flow/StreamingPathline.h>
+
+#include <atomic>
+
+namespace
+{
+
+vtkm::cont::DataSet MakeSlice(const vtkm::Id3& dims, const vtkm::Vec3f& vec)
+{
+  vtkm::cont::DataSet ds = vtkm::cont::DataSetBuilderUniform::Create(dims);
+  vtkm::cont::ArrayHandle<vtkm::Vec3f> vecField;
+  vtkm::cont::ArrayCopy(vtkm::cont::make_ArrayHandleConstant(vec, ds.GetNumberOfPoints()),
+                        vecField);
+  ds.AddPointField("vec", vecField);
+  return ds;
+}
+
+void TestStreamingPathline(bool prefetch, bool pathlines)
+{
+  std::cout << "Testing StreamingPathline prefetch= " << prefetch << " pathlines= " << pathlines
+            << std::endl;
+
+  const vtkm::Id3 dims(20, 5, 5);
+  const vtkm::Vec3f vecX(1, 0, 0);
+  const std::vector<vtkm::FloatDefault> times = { 0, 1, 2, 3, 4 };
+  const vtkm::FloatDefault stepSize = 0.1f;
+
+  std::atomic<int> numLoads(0);
+  std::vector<int> loadCount(times.size(), 0);
+  auto loader = [&](vtkm::Id index) {
+    numLoads++;
+    loadCount[static_cast<std::size_t>(index)]++;
+    return MakeSlice(dims, vecX);
+  };
+
+  vtkm::cont::ArrayHandle<vtkm::Particle> seedArray =
+    vtkm::cont::make_ArrayHandle({ vtkm::Particle(vtkm::Vec3f(.2f, 1.0f, .2f), 0),
+                                   vtkm::Particle(vtkm::Vec3f(.2f, 2.0f, .2f), 1),
+                                   vtkm::Particle(vtkm::Vec3f(.2f, 3.0f, .2f), 2) });
+
+  vtkm::filter::flow::StreamingPathline filt;
+  filt.SetTimeSliceLoader(loader);
+  filt.SetTimeValues(times);
+  filt.SetActiveField("vec");
+  filt.SetStepSize(stepSize);
+  filt.SetNumberOfSteps(1000);
+  filt.SetSeeds(seedArray);
+  filt.SetUsePrefetch(prefetch);
+  filt.SetOutputPathlines(pathlines);
+
+  auto output = filt.Execute();
+
+  VTKM_TEST_ASSERT(numLoads == static_cast<int>(times.size()), "Wrong number of slice loads");
+  for (auto c : loadCount)
+    VTKM_TEST_ASSERT(c == 1, "Each slice must be loaded exactly once");
+
+  // In a constant field the particles move with unit speed, so the distance traveled
+  // along x is the elapsed time. Every particle must have made it to the last slice.
+  auto particles = filt.GetParticles();
+  VTKM_TEST_ASSERT(particles.GetNumberOfValues() == seedArray.GetNumberOfValues(),
+                   "Wrong number of particles");
+  auto portal = particles.ReadPortal();
+  for (vtkm::Id i = 0; i < portal.GetNumberOfValues(); i++)
+  {
+    auto p = portal.Get(i);
+    VTKM_TEST_ASSERT(p.Time >= times.back(), "Particle did not reach the last time slice");
+    VTKM_TEST_ASSERT(test_equal(p.Pos[0] - 0.2f, p.Time), "Wrong particle position");
+  }
+
+  if (pathlines)
+  {
+    // One polyline per particle and interval.
+    vtkm::Id numIntervals = static_cast<vtkm::Id>(times.size() - 1);
+    VTKM_TEST_ASSERT(output.GetNumberOfCells() == numIntervals * seedArray.GetNumberOfValues(),
+                     "Wrong number of pathline segments");
+  }
+  else
+  {
+    VTKM_TEST_ASSERT(output.GetNumberOfPoints() == seedArray.GetNumberOfValues(),
+                     "Wrong number of output points");
+  }
+}
+
+void TestStreamingPathlineAll()
+{
+  TestStreamingPathline(true, true);
+  TestStreamingPathline(false, true);
+  TestStreamingPathline(true, false);
+}
+
+}
+
+int UnitTestStreamingPathline(int argc, char* argv[])
+{
+  return vtkm::cont::testing::Testing::Run(TestStreamingPathlineAll, argc, argv);
+}
@@ -581,6 +581,79 @@ void TestStreamlineFile(const std::string& fname,
   }
 }
 
+void TestSpatialOrdering()
+{
+  //Spatial ordering only changes which work item advects a particle, so the results
+  //must be the same as without it, in the same order.
+  const vtkm::Id3 dims(9, 9, 9);
+  auto ds = vtkm::cont::DataSetBuilderUniform::Create(dims);
+  vtkm::cont::ArrayHandle<vtkm::Vec3f> vecField;
+  vecField.Allocate(ds.GetNumberOfPoints());
+  {
+    auto portal = vecField.WritePortal();
+    auto points = ds.GetCoordinateSystem().GetDataAsMultiplexer().ReadPortal();
+    for (vtkm::Id i = 0; i < portal.GetNumberOfValues(); i++)
+    {
+      vtkm::Vec3f p = points.Get(i);
+      portal.Set(i, vtkm::Vec3f(4 - p[1], p[0] - 4, 0.25f));
+    }
+  }
+  ds.AddPointField("vec", vecField);
+
+  std::vector<vtkm::Particle> seeds;
+  vtkm::UInt32 state = 1;
+  auto next = [&state]() {
+    state = state * 1664525u + 1013904223u;
+    return 1.0f + 6.0f * static_cast<vtkm::FloatDefault>(state >> 8) / (1 << 24);
+  };
+  for (vtkm::Id i = 0; i < 200; i++)
+  {
+    vtkm::Vec3f pt;
+    pt[0] = next();
+    pt[1] = next();
+    pt[2] = next();
+    seeds.push_back(vtkm::Particle(pt, i));
+  }
+
+  for (auto fType : { FilterType::PARTICLE_ADVECTION, FilterType::STREAMLINE })
+  {
+    vtkm::cont::DataSet outputs[2];
+    for (int ordered = 0; ordered < 2; ordered++)
+    {
+      vtkm::cont::ArrayHandle<vtkm::Particle> seedArray =
+        vtkm::cont::make_ArrayHandle(seeds, vtkm::CopyFlag::On);
+      if (fType == FilterType::PARTICLE_ADVECTION)
+      {
+        vtkm::filter::flow::ParticleAdvection filter;
+        VTKM_TEST_ASSERT(!filter.GetUseSpatialOrdering(), "Spatial ordering is on by default");
+        filter.SetUseSpatialOrdering(ordered == 1);
+        filter.SetStepSize(0.05f);
+        filter.SetNumberOfSteps(100);
+        filter.SetSeeds(seedArray);
+        filter.SetActiveField("vec");
+        outputs[ordered] = filter.Execute(ds);
+      }
+      else
+      {
+        vtkm::filter::flow::Streamline filter;
+        filter.SetUseSpatialOrdering(ordered == 1);
+        filter.SetStepSize(0.05f);
+        filter.SetNumberOfSteps(100);
+        filter.SetSeeds(seedArray);
+        filter.SetActiveField("vec");
+        outputs[ordered] = filter.Execute(ds);
+      }
+    }
+
+    VTKM_TEST_ASSERT(outputs[0].GetNumberOfPoints() > 0, "No particles advected");
+    VTKM_TEST_ASSERT(test_equal_ArrayHandles(outputs[0].GetCoordinateSystem().GetData(),
+                                             outputs[1].GetCoordinateSystem().GetData()),
+                     "Spatial ordering changed the advected particles");
+    VTKM_TEST_ASSERT(outputs[0].GetNumberOfCells() == outputs[1].GetNumberOfCells(),
+                     "Spatial ordering changed the number of cells");
+  }
+}
+
 void TestStreamlineFilters()
 {
   std::vector<bool> flags = { true, false };
@@ -600,6 +673,7 @@ void TestStreamlineFilters()
 
   TestStreamline();
   TestPathline();
+  TestSpatialOrdering();
 
   for (auto useSL : flags)
     TestAMRStreamline(useSL);
@@ -13,6 +13,7 @@
 
 #include <vtkm/CellClassification.h>
 #include <vtkm/cont/ArrayHandle.h>
+#include <vtkm/cont/CellLocatorCache.h>
 #include <vtkm/cont/CellLocatorGeneral.h>
 #include <vtkm/cont/CellLocatorRectilinearGrid.h>
 #include <vtkm/cont/CellLocatorTwoLevel.h>
@@ -215,9 +216,8 @@ private:
   VTKM_CONT void InitializeLocator(const vtkm::cont::CoordinateSystem& coordinates,
                                    const vtkm::cont::UnknownCellSet& cellset)
   {
-    this->Locator.SetCoordinates(coordinates);
-    this->Locator.SetCellSet(cellset);
-    this->Locator.Update();
+    this->Locator = vtkm::cont::GetGlobalCellLocatorCache().Get<vtkm::cont::CellLocatorGeneral>(
+      cellset, coordinates);
     this->InterpolationHelper = vtkm::cont::CellInterpolationHelper(cellset);
   }
 
@@ -69,6 +69,11 @@ class ParticleAdvection
 public:
   ParticleAdvection() {}
 
+  /// Advect particles in the order of a Morton code of their position rather than
+  /// in the order given. The order of the particles in the result is unchanged.
+  void SetUseSpatialOrdering(bool val) { this->UseSpatialOrdering = val; }
+  bool GetUseSpatialOrdering() const { return this->UseSpatialOrdering; }
+
   template <typename IntegratorType, typename ParticleType, typename ParticleStorage>
   void Run2(const IntegratorType& it,
             vtkm::cont::ArrayHandle<ParticleType, ParticleStorage>& particles,
@@ -76,6 +81,7 @@ public:
             ParticleAdvectionResult<ParticleType>& result)
   {
     vtkm::worklet::flow::ParticleAdvectionWorklet<IntegratorType, ParticleType> worklet;
+    worklet.SetUseSpatialOrdering(this->UseSpatialOrdering);
 
     worklet.Run(it, particles, MaxSteps);
     result = ParticleAdvectionResult<ParticleType>(particles);
@@ -88,6 +94,7 @@ public:
     vtkm::Id MaxSteps)
   {
     vtkm::worklet::flow::ParticleAdvectionWorklet<IntegratorType, ParticleType> worklet;
+    worklet.SetUseSpatialOrdering(this->UseSpatialOrdering);
 
     worklet.Run(it, particles, MaxSteps);
     return ParticleAdvectionResult<ParticleType>(particles);
@@ -100,6 +107,7 @@ public:
     vtkm::Id MaxSteps)
   {
     vtkm::worklet::flow::ParticleAdvectionWorklet<IntegratorType, ParticleType> worklet;
+    worklet.SetUseSpatialOrdering(this->UseSpatialOrdering);
 
     vtkm::cont::ArrayHandle<ParticleType> particles;
     vtkm::cont::ArrayHandle<vtkm::Id> step, ids;
@@ -120,6 +128,9 @@ public:
     worklet.Run(it, particles, MaxSteps);
     return ParticleAdvectionResult<ParticleType>(particles);
   }
+
+private:
+  bool UseSpatialOrdering = false;
 };
 
 template <typename ParticleType>
@@ -151,6 +162,10 @@ class Streamline
 public:
   Streamline() {}
 
+  /// See ParticleAdvection::SetUseSpatialOrdering.
+  void SetUseSpatialOrdering(bool val) { this->UseSpatialOrdering = val; }
+  bool GetUseSpatialOrdering() const { return this->UseSpatialOrdering; }
+
   template <typename IntegratorType, typename ParticleType, typename ParticleStorage>
   StreamlineResult<ParticleType> Run(
     const IntegratorType& it,
@@ -158,6 +173,7 @@ public:
     vtkm::Id MaxSteps)
   {
     vtkm::worklet::flow::StreamlineWorklet<IntegratorType, ParticleType> worklet;
+    worklet.SetUseSpatialOrdering(this->UseSpatialOrdering);
 
     vtkm::cont::ArrayHandle<vtkm::Vec3f> positions;
     vtkm::cont::CellSetExplicit<> polyLines;
@@ -166,6 +182,9 @@ public:
 
     return StreamlineResult<ParticleType>(particles, positions, polyLines);
   }
+
+private:
+  bool UseSpatialOrdering = false;
 };
 
 }
@@ -17,6 +17,7 @@
 #include <vtkm/cont/ExecutionObjectBase.h>
 
 #include <vtkm/Particle.h>
+#include <vtkm/filter/flow/worklet/ParticleSpatialOrdering.h>
 #include <vtkm/filter/flow/worklet/Particles.h>
 #include <vtkm/worklet/WorkletMapField.h>
 
@@ -95,6 +96,12 @@ public:
 
   ~ParticleAdvectionWorklet() {}
 
+  /// When enabled, particles are advected in the order of a Morton code of their
+  /// position rather than in the order given, so that neighboring work items
+  /// evaluate the field in the same region of the mesh.
+  VTKM_CONT void SetUseSpatialOrdering(bool val) { this->UseSpatialOrdering = val; }
+  VTKM_CONT bool GetUseSpatialOrdering() const { return this->UseSpatialOrdering; }
+
   void Run(const IntegratorType& integrator,
            vtkm::cont::ArrayHandle<ParticleType>& particles,
            vtkm::Id& MaxSteps)
@@ -108,7 +115,6 @@ public:
     vtkm::Id numSeeds = static_cast<vtkm::Id>(particles.GetNumberOfValues());
     //Create and invoke the particle advection.
     vtkm::cont::ArrayHandleConstant<vtkm::Id> maxSteps(MaxSteps, numSeeds);
-    vtkm::cont::ArrayHandleIndex idxArray(numSeeds);
 
     // TODO: The particle advection sometimes behaves incorrectly on CUDA if the stack size
     // is not changed thusly. This is concerning as the compiler should be able to determine
@@ -126,8 +132,21 @@ public:
     //Invoke particle advection worklet
     ParticleWorkletDispatchType particleWorkletDispatch;
 
-    particleWorkletDispatch.Invoke(idxArray, integrator, particlesObj, maxSteps);
+    if (this->UseSpatialOrdering)
+    {
+      vtkm::cont::ArrayHandle<vtkm::Id> idxArray;
+      vtkm::worklet::flow::ComputeParticleSpatialOrdering(particles, idxArray);
+      particleWorkletDispatch.Invoke(idxArray, integrator, particlesObj, maxSteps);
+    }
+    else
+    {
+      vtkm::cont::ArrayHandleIndex idxArray(numSeeds);
+      particleWorkletDispatch.Invoke(idxArray, integrator, particlesObj, maxSteps);
+    }
   }
+
+private:
+  bool UseSpatialOrdering = false;
 };
 
 namespace detail
@@ -172,6 +191,10 @@ template <typename IntegratorType, typename ParticleType>
 class StreamlineWorklet
 {
 public:
+  /// See ParticleAdvectionWorklet::SetUseSpatialOrdering.
+  VTKM_CONT void SetUseSpatialOrdering(bool val) { this->UseSpatialOrdering = val; }
+  VTKM_CONT bool GetUseSpatialOrdering() const { return this->UseSpatialOrdering; }
+
   template <typename PointStorage, typename PointStorage2>
   void Run(const IntegratorType& it,
            vtkm::cont::ArrayHandle<ParticleType, PointStorage>& particles,
@@ -187,7 +210,6 @@ public:
     vtkm::cont::ArrayHandle<vtkm::Id> initialStepsTaken;
 
     vtkm::Id numSeeds = static_cast<vtkm::Id>(particles.GetNumberOfValues());
-    vtkm::cont::ArrayHandleIndex idxArray(numSeeds);
 
     vtkm::worklet::DispatcherMapField<detail::GetSteps> getStepDispatcher{ (detail::GetSteps{}) };
     getStepDispatcher.Invoke(particles, initialStepsTaken);
@@ -205,7 +227,17 @@ public:
     StreamlineArrayType streamlines(particles, MaxSteps);
     ParticleWorkletDispatchType particleWorkletDispatch;
     vtkm::cont::ArrayHandleConstant<vtkm::Id> maxSteps(MaxSteps, numSeeds);
-    particleWorkletDispatch.Invoke(idxArray, it, streamlines, maxSteps);
+    if (this->UseSpatialOrdering)
+    {
+      vtkm::cont::ArrayHandle<vtkm::Id> idxArray;
+      vtkm::worklet::flow::ComputeParticleSpatialOrdering(particles, idxArray);
+      particleWorkletDispatch.Invoke(idxArray, it, streamlines, maxSteps);
+    }
+    else
+    {
+      vtkm::cont::ArrayHandleIndex idxArray(numSeeds);
+      particleWorkletDispatch.Invoke(idxArray, it, streamlines, maxSteps);
+    }
 
     //Get the positions
     streamlines.GetCompactedHistory(positions);
@@ -230,6 +262,9 @@ public:
     auto offsets = vtkm::cont::ConvertNumComponentsToOffsets(numPoints);
     polyLines.Fill(positions.GetNumberOfValues(), cellTypes, connectivity, offsets);
   }
+
+private:
+  bool UseSpatialOrdering = false;
 };
 
 }
@@ -0,0 +1,111 @@
+//============================================================================
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//============================================================================
+
+#ifndef vtk_m_filter_flow_worklet_ParticleSpatialOrdering_h
+#define vtk_m_filter_flow_worklet_ParticleSpatialOrdering_h
+
+#include <vtkm/cont/Algorithm.h>
+#include <vtkm/cont/ArrayCopy.h>
+#include <vtkm/cont/ArrayHandleIndex.h>
+#include <vtkm/cont/ArrayRangeCompute.h>
+#include <vtkm/cont/Invoker.h>
+
+#include <vtkm/worklet/WorkletMapField.h>
+#include <vtkm/worklet/spatialstructure/MortonCode.h>
+
+namespace vtkm
+{
+namespace worklet
+{
+namespace flow
+{
+
+namespace detail
+{
+class GetParticlePosition : public vtkm::worklet::WorkletMapField
+{
+public:
+  using ControlSignature = void(FieldIn particle, FieldOut pos);
+  using ExecutionSignature = void(_1, _2);
+
+  template <typename ParticleType>
+  VTKM_EXEC void operator()(const ParticleType& particle, vtkm::Vec3f& pos) const
+  {
+    pos = particle.Pos;
+  }
+};
+
+class ParticleMortonCode : public vtkm::worklet::WorkletMapField
+{
+public:
+  using ControlSignature = void(FieldIn pos, FieldOut code);
+  using ExecutionSignature = void(_1, _2);
+
+  VTKM_CONT ParticleMortonCode(const vtkm::Vec3f& minPoint, const vtkm::Vec3f& inverseExtent)
+    : MinPoint(minPoint)
+    , InverseExtent(inverseExtent)
+  {
+  }
+
+  VTKM_EXEC void operator()(const vtkm::Vec3f& pos, vtkm::UInt32& code) const
+  {
+    code = vtkm::worklet::spatialstructure::MortonCode30((pos - this->MinPoint) *
+                                                         this->InverseExtent);
+  }
+
+private:
+  vtkm::Vec3f MinPoint;
+  vtkm::Vec3f InverseExtent;
+};
+} // namespace detail
+
+/// \brief Compute an ordering of particles that groups spatially close particles.
+///
+/// The particle positions are encoded with a 30 bit Morton code (the same encoding
+/// used to build the ray tracing BVH) relative to the bounds of the particles.
+/// On return, \c ordering holds the particle indices sorted by that code. Using it
+/// as the work item to particle mapping makes neighboring work items sample the
+/// same region of the mesh, which improves cache reuse in the field evaluation.
+///
+template <typename ParticleType, typename ParticleStorage>
+VTKM_CONT void ComputeParticleSpatialOrdering(
+  const vtkm::cont::ArrayHandle<ParticleType, ParticleStorage>& particles,
+  vtkm::cont::ArrayHandle<vtkm::Id>& ordering)
+{
+  vtkm::Id numParticles = particles.GetNumberOfValues();
+  vtkm::cont::ArrayCopy(vtkm::cont::ArrayHandleIndex(numParticles), ordering);
+  if (numParticles < 2)
+    return;
+
+  vtkm::cont::Invoker invoke;
+  vtkm::cont::ArrayHandle<vtkm::Vec3f> positions;
+  invoke(detail::GetParticlePosition{}, particles, positions);
+
+  auto ranges = vtkm::cont::ArrayRangeCompute(positions).ReadPortal();
+  vtkm::Vec3f minPoint, inverseExtent;
+  for (vtkm::IdComponent i = 0; i < 3; i++)
+  {
+    const vtkm::Range& r = ranges.Get(i);
+    minPoint[i] = static_cast<vtkm::FloatDefault>(r.Min);
+    inverseExtent[i] =
+      r.Length() > 0 ? static_cast<vtkm::FloatDefault>(1.0 / r.Length()) : vtkm::FloatDefault(0);
+  }
+
+  vtkm::cont::ArrayHandle<vtkm::UInt32> codes;
+  invoke(detail::ParticleMortonCode{ minPoint, inverseExtent }, positions, codes);
+
+  vtkm::cont::Algorithm::SortByKey(codes, ordering);
+}
+
+}
+}
+} // namespace vtkm::worklet::flow
+
+#endif // vtk_m_filter_flow_worklet_ParticleSpatialOrdering_h
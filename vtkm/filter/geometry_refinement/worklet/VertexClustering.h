@@ -194,18 +194,22 @@ struct VertexClustering
   };
 
   /// pass 3
-  class IndexingWorklet : public vtkm::worklet::WorkletMapField
+  /// input: clusters  output: index of the cluster of each point
+  class IndexingWorklet : public vtkm::worklet::WorkletReduceByKey
   {
   public:
-    using ControlSignature = void(FieldIn, WholeArrayOut);
-    using ExecutionSignature = void(WorkIndex, _1, _2); // WorkIndex: use vtkm indexing
+    using ControlSignature = void(KeysIn clusterIds, ValuesOut pointClusterIndices);
+    using ExecutionSignature = void(InputIndex, _2);
+    using InputDomain = _1;
 
-    template <typename OutPortalType>
-    VTKM_EXEC void operator()(const vtkm::Id& counter,
-                              const vtkm::Id& cid,
-                              const OutPortalType& outPortal) const
+    template <typename IndicesOutVecType>
+    VTKM_EXEC void operator()(const vtkm::Id& clusterIndex,
+                              IndicesOutVecType& pointClusterIndices) const
     {
-      outPortal.Set(cid, counter);
+      for (vtkm::IdComponent i = 0; i < pointClusterIndices.GetNumberOfComponents(); ++i)
+      {
+        pointClusterIndices[i] = clusterIndex;
+      }
     }
   };
 
@@ -223,8 +227,8 @@ struct VertexClustering
     }
 
   public:
-    using ControlSignature = void(FieldIn, FieldOut, WholeArrayIn);
-    using ExecutionSignature = void(_1, _2, _3);
+    using ControlSignature = void(FieldIn, FieldOut);
+    using ExecutionSignature = void(_1, _2);
 
     VTKM_CONT
     Cid2PointIdWorklet(vtkm::Id nPoints)
@@ -232,10 +236,7 @@ struct VertexClustering
     {
     }
 
-    template <typename InPortalType>
-    VTKM_EXEC void operator()(const vtkm::Id3& cid3,
-                              vtkm::Id3& pointId3,
-                              const InPortalType& inPortal) const
+    VTKM_EXEC void operator()(const vtkm::Id3& cid3, vtkm::Id3& pointId3) const
     {
       if (cid3[0] == cid3[1] || cid3[0] == cid3[2] || cid3[1] == cid3[2])
       {
@@ -243,9 +244,8 @@ struct VertexClustering
       }
       else
       {
-        pointId3[0] = inPortal.Get(cid3[0]);
-        pointId3[1] = inPortal.Get(cid3[1]);
-        pointId3[2] = inPortal.Get(cid3[2]);
+        // Clusters are numbered as their representative points are.
+        pointId3 = cid3;
 
         // Sort triangle point ids so that the same triangle will have the same signature
         // Rotate these ids making the first one the smallest
@@ -369,9 +369,11 @@ public:
 
     /// pass 2 : Choose a representative point from each cluster for the output:
     vtkm::cont::UnknownArrayHandle repPointArray;
+    vtkm::cont::ArrayHandle<vtkm::Id> pointClusterIndexArray;
     {
       vtkm::worklet::Keys<vtkm::Id> keys;
       keys.BuildArrays(pointCidArray, vtkm::worklet::KeysSortType::Stable);
+      pointCidArray.ReleaseResources();
 
       // Create a View with all the keys offsets but the last element since
       // BuildArrays uses ScanExtended
@@ -385,10 +387,13 @@ public:
       // Compute representative points from each cluster (may not match the
       // PointIdMap indexing)
       repPointArray = internal::SelectRepresentativePoint::Run(keys, coordinates);
-    }
 
-    auto repPointCidArray =
-      vtkm::cont::make_ArrayHandlePermutation(this->PointIdMap, pointCidArray);
+      // Number the clusters of the points. Clusters are identified by their grid bin, but
+      // indexing an array by bin would take memory for every bin of the grid, empty or not.
+      pointClusterIndexArray.Allocate(coordinates.GetNumberOfValues());
+      vtkm::worklet::DispatcherReduceByKey<IndexingWorklet> indexingDispatcher;
+      indexingDispatcher.Invoke(keys, pointClusterIndexArray);
+    }
 
 #ifdef __VTKM_VERTEX_CLUSTERING_BENCHMARK
     std::cout << "Time after reducing points (s): " << timer.GetElapsedTime() << std::endl;
@@ -399,28 +404,19 @@ public:
     ///          For each original triangle, only output vertices from
     ///          three different clusters
 
-    /// map each triangle vertex to the cluster id's
+    /// map each triangle vertex to the cluster indices
     /// of the cell vertices
     vtkm::cont::ArrayHandle<vtkm::Id3> cid3Array;
 
     vtkm::worklet::DispatcherMapTopology<MapCellsWorklet> mapCellsDispatcher;
-    mapCellsDispatcher.Invoke(cellSet, pointCidArray, cid3Array);
+    mapCellsDispatcher.Invoke(cellSet, pointClusterIndexArray, cid3Array);
+    pointClusterIndexArray.ReleaseResources();
 
 #ifdef __VTKM_VERTEX_CLUSTERING_BENCHMARK
     std::cout << "Time after clustering cells (s): " << timer.GetElapsedTime() << std::endl;
     timer.Start();
 #endif
 
-    /// preparation: Get the indexes of the clustered points to prepare for new cell array
-    vtkm::cont::ArrayHandle<vtkm::Id> cidIndexArray;
-    cidIndexArray.Allocate(gridInfo.dim[0] * gridInfo.dim[1] * gridInfo.dim[2]);
-
-    vtkm::worklet::DispatcherMapField<IndexingWorklet> indexingDispatcher;
-    indexingDispatcher.Invoke(repPointCidArray, cidIndexArray);
-
-    pointCidArray.ReleaseResources();
-    repPointCidArray.ReleaseResources();
-
     ///
     /// map: convert each triangle vertices from original point id to the new cluster indexes
     ///      If the triangle is degenerated, set the ids to <nPoints, nPoints, nPoints>
@@ -432,10 +428,9 @@ public:
 
     vtkm::worklet::DispatcherMapField<Cid2PointIdWorklet> cid2PointIdDispatcher(
       (Cid2PointIdWorklet(nPoints)));
-    cid2PointIdDispatcher.Invoke(cid3Array, pointId3Array, cidIndexArray);
+    cid2PointIdDispatcher.Invoke(cid3Array, pointId3Array);
 
     cid3Array.ReleaseResources();
-    cidIndexArray.ReleaseResources();
 
     bool doHashing = (nPoints < (1 << 21)); // Check whether we can hash Id3 into 64-bit integers
 
@@ -0,0 +1,259 @@
+//============================================================================
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//============================================================================
+
+#include <vtkm/filter/ScalarRangeIndex.h>
+
+#include <vtkm/cont/DataSetBuilderUniform.h>
+#include <vtkm/cont/testing/Testing.h>
+
+#include <vector>
+
+namespace
+{
+
+const vtkm::Id3 Dims(12, 10, 8);
+
+vtkm::Float64 PointValue(vtkm::Id i, vtkm::Id j, vtkm::Id k)
+{
+  return static_cast<vtkm::Float64>(i * j) - 3.0 * static_cast<vtkm::Float64>(k);
+}
+
+vtkm::cont::DataSet MakeDataSet()
+{
+  vtkm::cont::DataSet dataSet = vtkm::cont::DataSetBuilderUniform::Create(Dims);
+  std::vector<vtkm::Float32> pointValues;
+  for (vtkm::Id k = 0; k < Dims[2]; ++k)
+  {
+    for (vtkm::Id j = 0; j < Dims[1]; ++j)
+    {
+      for (vtkm::Id i = 0; i < Dims[0]; ++i)
+      {
+        pointValues.push_back(static_cast<vtkm::Float32>(PointValue(i, j, k)));
+      }
+    }
+  }
+  dataSet.AddPointField("pointvar", pointValues);
+  std::vector<vtkm::Float64> cellValues;
+  for (vtkm::Id cell = 0; cell < dataSet.GetNumberOfCells(); ++cell)
+  {
+    cellValues.push_back(static_cast<vtkm::Float64>((cell * 13) % 100));
+  }
+  dataSet.AddCellField("cellvar", cellValues);
+  return dataSet;
+}
+
+// Range of the point values of each cell, computed on the host.
+std::vector<vtkm::Range> PointCellRanges()
+{
+  std::vector<vtkm::Range> ranges;
+  for (vtkm::Id k = 0; k < Dims[2] - 1; ++k)
+  {
+    for (vtkm::Id j = 0; j < Dims[1] - 1; ++j)
+    {
+      for (vtkm::Id i = 0; i < Dims[0] - 1; ++i)
+      {
+        vtkm::Range range;
+        for (vtkm::Id corner = 0; corner < 8; ++corner)
+        {
+          range.Include(PointValue(i + (corner & 1), j + ((corner >> 1) & 1), k + (corner >> 2)));
+        }
+        ranges.push_back(range);
+      }
+    }
+  }
+  return ranges;
+}
+
+void CheckIndex(const vtkm::filter::ScalarRangeIndex& index,
+                const std::vector<vtkm::Range>& cellRanges)
+{
+  const vtkm::Id brickSize = index.GetBrickSize();
+  const vtkm::Id numberOfCells = static_cast<vtkm::Id>(cellRanges.size());
+  VTKM_TEST_ASSERT(index.GetNumberOfCells() == numberOfCells, "Wrong number of cells");
+  VTKM_TEST_ASSERT(index.GetNumberOfBricks() == (numberOfCells + brickSize - 1) / brickSize,
+                   "Wrong number of bricks");
+
+  std::vector<vtkm::Range> brickRanges(static_cast<std::size_t>(index.GetNumberOfBricks()));
+  for (vtkm::Id cell = 0; cell < numberOfCells; ++cell)
+  {
+    brickRanges[static_cast<std::size_t>(cell / brickSize)].Include(
+      cellRanges[static_cast<std::size_t>(cell)]);
+  }
+  auto brickPortal = index.GetBrickRanges().ReadPortal();
+  for (vtkm::Id brick = 0; brick < index.GetNumberOfBricks(); ++brick)
+  {
+    VTKM_TEST_ASSERT(brickPortal.Get(brick) == brickRanges[static_cast<std::size_t>(brick)],
+                     "Wrong range for brick ",
+                     brick);
+  }
+
+  auto checkQuery = [&](const vtkm::cont::ArrayHandle<vtkm::Id>& cells,
+                        const std::vector<vtkm::Range>& queries) {
+    std::vector<vtkm::Id> expected;
+    for (vtkm::Id cell = 0; cell < numberOfCells; ++cell)
+    {
+      for (const vtkm::Range& query : queries)
+      {
+        if (brickRanges[static_cast<std::size_t>(cell / brickSize)]
+              .Intersection(query)
+              .IsNonEmpty())
+        {
+          expected.push_back(cell);
+          break;
+        }
+      }
+    }
+    VTKM_TEST_ASSERT(test_equal_ArrayHandles(
+      cells, vtkm::cont::make_ArrayHandle(expected, vtkm::CopyFlag::Off)));
+  };
+  checkQuery(index.GetCellsInRange(10, 12), { vtkm::Range(10, 12) });
+  checkQuery(index.GetCellsInRange(-100, 1000), { vtkm::Range(-100, 1000) });
+  checkQuery(index.GetCellsInRange(1000, 2000), { vtkm::Range(1000, 2000) });
+  checkQuery(index.GetCellsContaining({ -10.5, 40.5 }),
+             { vtkm::Range(-10.5, -10.5), vtkm::Range(40.5, 40.5) });
+}
+
+void TestPointField()
+{
+  std::cout << "Testing index of a point field" << std::endl;
+  vtkm::cont::DataSet dataSet = MakeDataSet();
+  const std::vector<vtkm::Range> cellRanges = PointCellRanges();
+
+  vtkm::filter::ScalarRangeIndex index;
+  for (vtkm::Id brickSize : { 1, 7, 64, 1000 })
+  {
+    index.SetBrickSize(brickSize);
+    VTKM_TEST_ASSERT(!index.IsBuiltFor(dataSet.GetCellSet(), dataSet.GetField("pointvar")),
+                     "Changing the brick size should invalidate the index");
+    index.Build(dataSet.GetCellSet(), dataSet.GetField("pointvar"));
+    CheckIndex(index, cellRanges);
+  }
+}
+
+void TestCellField()
+{
+  std::cout << "Testing index of a cell field" << std::endl;
+  vtkm::cont::DataSet dataSet = MakeDataSet();
+  std::vector<vtkm::Range> cellRanges;
+  for (vtkm::Id cell = 0; cell < dataSet.GetNumberOfCells(); ++cell)
+  {
+    const vtkm::Float64 value = static_cast<vtkm::Float64>((cell * 13) % 100);
+    cellRanges.emplace_back(value, value);
+  }
+
+  vtkm::filter::ScalarRangeIndex index;
+  index.SetBrickSize(25);
+  index.Build(dataSet.GetCellSet(), dataSet.GetField("cellvar"));
+  CheckIndex(index, cellRanges);
+}
+
+// The span space returns exactly the cells whose range meets the query.
+void CheckSpanSpace(const vtkm::filter::ScalarRangeIndex& index,
+                    const std::vector<vtkm::Range>& cellRanges)
+{
+  VTKM_TEST_ASSERT(index.GetNumberOfCells() == static_cast<vtkm::Id>(cellRanges.size()),
+                   "Wrong number of cells");
+  VTKM_TEST_ASSERT(index.GetNumberOfBricks() == 0, "Span space should not have bricks");
+
+  auto checkQuery = [&](const vtkm::cont::ArrayHandle<vtkm::Id>& cells,
+                        const std::vector<vtkm::Range>& queries) {
+    std::vector<vtkm::Id> expected;
+    for (std::size_t cell = 0; cell < cellRanges.size(); ++cell)
+    {
+      for (const vtkm::Range& query : queries)
+      {
+        if (cellRanges[cell].Intersection(query).IsNonEmpty())
+        {
+          expected.push_back(static_cast<vtkm::Id>(cell));
+          break;
+        }
+      }
+    }
+    VTKM_TEST_ASSERT(test_equal_ArrayHandles(
+      cells, vtkm::cont::make_ArrayHandle(expected, vtkm::CopyFlag::Off)));
+  };
+  checkQuery(index.GetCellsInRange(10, 12), { vtkm::Range(10, 12) });
+  checkQuery(index.GetCellsInRange(-100, 1000), { vtkm::Range(-100, 1000) });
+  checkQuery(index.GetCellsInRange(1000, 2000), { vtkm::Range(1000, 2000) });
+  checkQuery(index.GetCellsInRange(-21, -21), { vtkm::Range(-21, -21) });
+  checkQuery(index.GetCellsContaining({ -10.5, 40.5, 41 }),
+             { vtkm::Range(-10.5, -10.5), vtkm::Range(40.5, 40.5), vtkm::Range(41, 41) });
+  checkQuery(index.GetCellsContaining({ 0, 99 }), { vtkm::Range(0, 0), vtkm::Range(99, 99) });
+}
+
+void TestSpanSpace()
+{
+  std::cout << "Testing span space index" << std::endl;
+  vtkm::cont::DataSet dataSet = MakeDataSet();
+  const std::vector<vtkm::Range> pointCellRanges = PointCellRanges();
+  std::vector<vtkm::Range> cellFieldRanges;
+  for (vtkm::Id cell = 0; cell < dataSet.GetNumberOfCells(); ++cell)
+  {
+    const vtkm::Float64 value = static_cast<vtkm::Float64>((cell * 13) % 100);
+    cellFieldRanges.emplace_back(value, value);
+  }
+
+  vtkm::filter::ScalarRangeIndex index;
+  index.SetMethod(vtkm::filter::ScalarRangeIndex::Method::SpanSpace);
+  for (vtkm::Id resolution : { 1, 7, 64 })
+  {
+    index.SetSpanSpaceResolution(resolution);
+    index.Build(dataSet.GetCellSet(), dataSet.GetField("pointvar"));
+    CheckSpanSpace(index, pointCellRanges);
+    index.Build(dataSet.GetCellSet(), dataSet.GetField("cellvar"));
+    CheckSpanSpace(index, cellFieldRanges);
+  }
+}
+
+void TestUpdate()
+{
+  std::cout << "Testing index reuse" << std::endl;
+  vtkm::cont::DataSet dataSet = MakeDataSet();
+  vtkm::filter::ScalarRangeIndex index;
+  index.SetBrickSize(16);
+
+  VTKM_TEST_ASSERT(index.Update(dataSet.GetCellSet(), dataSet.GetField("pointvar")),
+                   "First update should build the index");
+  VTKM_TEST_ASSERT(!index.Update(dataSet.GetCellSet(), dataSet.GetField("pointvar")),
+                   "Unchanged data should reuse the index");
+  VTKM_TEST_ASSERT(!index.IsBuiltFor(dataSet.GetCellSet(), dataSet.GetField("cellvar")),
+                   "Index should not match another field");
+
+  // Modifying the field in place invalidates the index.
+  vtkm::cont::ArrayHandle<vtkm::Float32> pointvar;
+  dataSet.GetField("pointvar").GetData().AsArrayHandle(pointvar);
+  pointvar.WritePortal().Set(0, 5000.0f);
+  VTKM_TEST_ASSERT(!index.IsBuiltFor(dataSet.GetCellSet(), dataSet.GetField("pointvar")),
+                   "Modified field should invalidate the index");
+  VTKM_TEST_ASSERT(index.Update(dataSet.GetCellSet(), dataSet.GetField("pointvar")),
+                   "Modified field should rebuild the index");
+  VTKM_TEST_ASSERT(index.GetCellsInRange(5000, 5000).GetNumberOfValues() == 16,
+                   "Index does not reflect the modified field");
+
+  index.Clear();
+  VTKM_TEST_ASSERT(index.GetNumberOfBricks() == 0, "Index was not cleared");
+  VTKM_TEST_ASSERT(index.GetCellsInRange(-1000, 1000).GetNumberOfValues() == 0,
+                   "Empty index should not return cells");
+}
+
+void Run()
+{
+  TestPointField();
+  TestCellField();
+  TestSpanSpace();
+  TestUpdate();
+}
+
+} // anonymous namespace
+
+int UnitTestScalarRangeIndex(int argc, char* argv[])
+{
+  return vtkm::cont::testing::Testing::Run(Run, argc, argv);
+}
@@ -12,24 +12,6 @@
 #include <vtkm/filter/vector_analysis/Gradient.h>
 #include <vtkm/filter/vector_analysis/worklet/Gradient.h>
 
-namespace
-{
-//-----------------------------------------------------------------------------
-template <typename T, typename S>
-inline void transpose_3x3(vtkm::cont::ArrayHandle<vtkm::Vec<vtkm::Vec<T, 3>, 3>, S>& field)
-{
-  vtkm::worklet::gradient::Transpose3x3<T> transpose;
-  transpose.Run(field);
-}
-
-//-----------------------------------------------------------------------------
-template <typename T, typename S>
-inline void transpose_3x3(vtkm::cont::ArrayHandle<vtkm::Vec<T, 3>, S>&)
-{ //This is not a 3x3 matrix so no transpose needed
-}
-
-} //namespace
-
 namespace vtkm
 {
 namespace filter
@@ -74,6 +56,7 @@ vtkm::cont::DataSet Gradient::DoExecute(const vtkm::cont::DataSet& inputDataSet)
                                                           this->GetComputeDivergence(),
                                                           this->GetComputeVorticity(),
                                                           this->GetComputeQCriterion());
+    gradientfields.SetRowOrdering(this->RowOrdering);
 
     vtkm::cont::ArrayHandle<vtkm::Vec<T, 3>> result;
     if (this->ComputePointGradient)
@@ -86,10 +69,6 @@ vtkm::cont::DataSet Gradient::DoExecute(const vtkm::cont::DataSet& inputDataSet)
       vtkm::worklet::CellGradient gradient;
       result = gradient.Run(inputCellSet, coords, concrete, gradientfields);
     }
-    if (!this->RowOrdering)
-    {
-      transpose_3x3(result);
-    }
 
     gradientArray = result;
     divergenceArray = gradientfields.Divergence;
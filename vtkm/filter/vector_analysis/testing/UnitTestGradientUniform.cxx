@@ -160,11 +160,66 @@ void TestPointGradientUniform3DWithVectorField()
 
 
 
+void TestPointGradientUniform3DColumnMajor()
+{
+  std::cout << "Testing Gradient Filter with column-major point output on 3D structured data"
+            << std::endl;
+  vtkm::cont::testing::MakeTestDataSet testDataSet;
+  vtkm::cont::DataSet dataSet = testDataSet.Make3DUniformDataSet1();
+
+  // Use different components so that the gradient tensor is not symmetric.
+  const vtkm::Id nVerts = dataSet.GetNumberOfPoints();
+  std::vector<vtkm::Vec3f_64> vec(static_cast<std::size_t>(nVerts));
+  for (vtkm::Id i = 0; i < nVerts; ++i)
+  {
+    const vtkm::Float64 x = static_cast<vtkm::Float64>(i);
+    vec[static_cast<std::size_t>(i)] = vtkm::make_Vec(x, 0.5 * x * x, 3.0 - x);
+  }
+  dataSet.AddPointField("vec_pointvar", vec);
+
+  vtkm::filter::vector_analysis::Gradient gradient;
+  gradient.SetComputePointGradient(true);
+  gradient.SetComputeDivergence(true);
+  gradient.SetComputeQCriterion(true);
+  gradient.SetActiveField("vec_pointvar");
+  vtkm::cont::DataSet rowResult = gradient.Execute(dataSet);
+  gradient.SetColumnMajorOrdering();
+  vtkm::cont::DataSet columnResult = gradient.Execute(dataSet);
+
+  vtkm::cont::ArrayHandle<vtkm::Vec<vtkm::Vec3f_64, 3>> rowGradient;
+  rowResult.GetPointField("Gradients").GetData().AsArrayHandle(rowGradient);
+  vtkm::cont::ArrayHandle<vtkm::Vec<vtkm::Vec3f_64, 3>> columnGradient;
+  columnResult.GetPointField("Gradients").GetData().AsArrayHandle(columnGradient);
+  VTKM_TEST_ASSERT(columnGradient.GetNumberOfValues() == nVerts, "Wrong number of gradients");
+  auto rowPortal = rowGradient.ReadPortal();
+  auto columnPortal = columnGradient.ReadPortal();
+  for (vtkm::Id i = 0; i < nVerts; ++i)
+  {
+    const vtkm::Vec<vtkm::Vec3f_64, 3> r = rowPortal.Get(i);
+    const vtkm::Vec<vtkm::Vec3f_64, 3> c = columnPortal.Get(i);
+    for (vtkm::IdComponent row = 0; row < 3; ++row)
+    {
+      for (vtkm::IdComponent col = 0; col < 3; ++col)
+      {
+        VTKM_TEST_ASSERT(test_equal(r[row][col], c[col][row]),
+                         "Column-major gradient is not the transpose of the row-major one");
+      }
+    }
+  }
+
+  // The derived quantities do not depend on the ordering of the gradient.
+  VTKM_TEST_ASSERT(test_equal_ArrayHandles(rowResult.GetPointField("Divergence").GetData(),
+                                           columnResult.GetPointField("Divergence").GetData()));
+  VTKM_TEST_ASSERT(test_equal_ArrayHandles(rowResult.GetPointField("QCriterion").GetData(),
+                                           columnResult.GetPointField("QCriterion").GetData()));
+}
+
 void TestGradient()
 {
   TestCellGradientUniform3D();
   TestCellGradientUniform3DWithVectorField();
   TestPointGradientUniform3DWithVectorField();
+  TestPointGradientUniform3DColumnMajor();
 }
 }
 
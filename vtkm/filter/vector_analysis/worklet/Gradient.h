@@ -20,7 +20,6 @@
 #include <vtkm/filter/vector_analysis/worklet/gradient/PointGradient.h>
 #include <vtkm/filter/vector_analysis/worklet/gradient/QCriterion.h>
 #include <vtkm/filter/vector_analysis/worklet/gradient/StructuredPointGradient.h>
-#include <vtkm/filter/vector_analysis/worklet/gradient/Transpose.h>
 #include <vtkm/filter/vector_analysis/worklet/gradient/Vorticity.h>
 
 // Required for instantiations
@@ -199,6 +198,12 @@ struct GradientOutputFields : public vtkm::cont::ExecutionObjectBase
   void SetComputeGradient(bool enable) { StoreGradient = enable; }
   bool GetComputeGradient() const { return StoreGradient; }
 
+  /// Store the gradient of a vector field in C row-major order. When off, the
+  /// gradient is stored in FORTRAN column-major order, transposed as it is written.
+  /// The default is on.
+  void SetRowOrdering(bool enable) { RowOrdering = enable; }
+  bool GetRowOrdering() const { return RowOrdering; }
+
   //todo fix this for scalar
   vtkm::exec::GradientOutput<T> PrepareForOutput(vtkm::Id size)
   {
@@ -210,7 +215,8 @@ struct GradientOutputFields : public vtkm::cont::ExecutionObjectBase
                                          this->Divergence,
                                          this->Vorticity,
                                          this->QCriterion,
-                                         size);
+                                         size,
+                                         this->RowOrdering);
     return portal;
   }
 
@@ -224,6 +230,7 @@ private:
   bool ComputeDivergence;
   bool ComputeVorticity;
   bool ComputeQCriterion;
+  bool RowOrdering = true;
 };
 class PointGradient
 {
@@ -79,7 +79,8 @@ struct GradientScalarOutput : public vtkm::cont::ExecutionObjectBase
                        vtkm::cont::ArrayHandle<BaseTType>&,
                        vtkm::cont::ArrayHandle<vtkm::Vec<BaseTType, 3>>&,
                        vtkm::cont::ArrayHandle<BaseTType>&,
-                       vtkm::Id size)
+                       vtkm::Id size,
+                       bool = true)
     : Size(size)
     , Gradient(gradient)
   {
@@ -108,10 +109,12 @@ struct GradientVecOutputExecutionObject
                                    vtkm::cont::ArrayHandle<vtkm::Vec<BaseTType, 3>> vorticity,
                                    vtkm::cont::ArrayHandle<BaseTType> qcriterion,
                                    vtkm::Id size,
+                                   bool rowOrdering,
                                    vtkm::cont::DeviceAdapterId device,
                                    vtkm::cont::Token& token)
   {
     this->SetGradient = g;
+    this->RowOrdering = rowOrdering;
     this->SetDivergence = d;
     this->SetVorticity = v;
     this->SetQCriterion = q;
@@ -140,7 +143,18 @@ struct GradientVecOutputExecutionObject
   {
     if (this->SetGradient)
     {
-      this->GradientPortal.Set(index, value);
+      if (this->RowOrdering)
+      {
+        this->GradientPortal.Set(index, value);
+      }
+      else
+      {
+        // Writing the transpose here saves a pass over the whole tensor array.
+        this->GradientPortal.Set(index,
+                                 ValueType(T(value[0][0], value[1][0], value[2][0]),
+                                           T(value[0][1], value[1][1], value[2][1]),
+                                           T(value[0][2], value[1][2], value[2][2])));
+      }
     }
     if (this->SetDivergence)
     {
@@ -169,6 +183,7 @@ struct GradientVecOutputExecutionObject
   bool SetDivergence;
   bool SetVorticity;
   bool SetQCriterion;
+  bool RowOrdering;
 
   PortalType<ValueType> GradientPortal;
   PortalType<BaseTType> DivergencePortal;
@@ -195,6 +210,7 @@ struct GradientVecOutput : public vtkm::cont::ExecutionObjectBase
                                                            this->Vorticity,
                                                            this->Qcriterion,
                                                            this->Size,
+                                                           this->RowOrdering,
                                                            device,
                                                            token);
   }
@@ -209,7 +225,8 @@ struct GradientVecOutput : public vtkm::cont::ExecutionObjectBase
                     vtkm::cont::ArrayHandle<BaseTType>& divergence,
                     vtkm::cont::ArrayHandle<vtkm::Vec<BaseTType, 3>>& vorticity,
                     vtkm::cont::ArrayHandle<BaseTType>& qcriterion,
-                    vtkm::Id size)
+                    vtkm::Id size,
+                    bool rowOrdering = true)
   {
     this->G = g;
     this->D = d;
@@ -220,6 +237,7 @@ struct GradientVecOutput : public vtkm::cont::ExecutionObjectBase
     this->Vorticity = vorticity;
     this->Qcriterion = qcriterion;
     this->Size = size;
+    this->RowOrdering = rowOrdering;
   }
 
   bool G;
@@ -231,6 +249,7 @@ struct GradientVecOutput : public vtkm::cont::ExecutionObjectBase
   vtkm::cont::ArrayHandle<vtkm::Vec<BaseTType, 3>> Vorticity;
   vtkm::cont::ArrayHandle<BaseTType> Qcriterion;
   vtkm::Id Size;
+  bool RowOrdering = true;
 };
 
 template <typename T>
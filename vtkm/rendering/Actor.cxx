@@ -101,6 +101,20 @@ void Actor::Render(vtkm::rendering::Mapper& mapper,
                      this->Internals->ScalarRange);
 }
 
+void Actor::Render(vtkm::rendering::Mapper& mapper,
+                   const std::vector<vtkm::rendering::Canvas*>& canvases,
+                   const std::vector<vtkm::rendering::Camera>& cameras) const
+{
+  mapper.SetActiveColorTable(this->Internals->ColorTable);
+  mapper.RenderCellsMultiView(this->Internals->Cells,
+                              this->Internals->Coordinates,
+                              this->Internals->ScalarField,
+                              this->Internals->ColorTable,
+                              cameras,
+                              canvases,
+                              this->Internals->ScalarRange);
+}
+
 const vtkm::cont::UnknownCellSet& Actor::GetCells() const
 {
   return this->Internals->Cells;
@@ -17,6 +17,7 @@
 #include <vtkm/rendering/Mapper.h>
 
 #include <memory>
+#include <vector>
 
 namespace vtkm
 {
@@ -44,6 +45,14 @@ public:
               vtkm::rendering::Canvas& canvas,
               const vtkm::rendering::Camera& camera) const;
 
+  /// \brief Renders the actor from each camera into the canvas of the same index.
+  ///
+  /// See `Mapper::RenderCellsMultiView`.
+  ///
+  void Render(vtkm::rendering::Mapper& mapper,
+              const std::vector<vtkm::rendering::Canvas*>& canvases,
+              const std::vector<vtkm::rendering::Camera>& cameras) const;
+
   const vtkm::cont::UnknownCellSet& GetCells() const;
 
   const vtkm::cont::CoordinateSystem& GetCoordinates() const;
@@ -10,13 +10,17 @@
 
 #include <vtkm/rendering/CanvasRayTracer.h>
 
+#include <vtkm/cont/ErrorBadValue.h>
 #include <vtkm/cont/TryExecute.h>
 #include <vtkm/rendering/Canvas.h>
 #include <vtkm/rendering/Color.h>
 #include <vtkm/rendering/raytracing/Ray.h>
+#include <vtkm/rendering/raytracing/RayOperations.h>
 #include <vtkm/worklet/DispatcherMapField.h>
 #include <vtkm/worklet/WorkletMapField.h>
 
+#include <vector>
+
 namespace vtkm
 {
 namespace rendering
@@ -106,6 +110,104 @@ public:
   }
 }; //class SurfaceConverter
 
+// Marks the rays of the pixels traced by the current progressive render.
+class SelectProgressivePixels : public vtkm::worklet::WorkletMapField
+{
+  vtkm::Id StepBegin;
+  vtkm::Id StepEnd;
+
+public:
+  VTKM_CONT
+  SelectProgressivePixels(vtkm::Id stepBegin, vtkm::Id stepEnd)
+    : StepBegin(stepBegin)
+    , StepEnd(stepEnd)
+  {
+  }
+
+  using ControlSignature = void(FieldIn, FieldOut, WholeArrayIn);
+  using ExecutionSignature = void(_1, _2, _3);
+
+  template <typename RankPortalType>
+  VTKM_EXEC void operator()(const vtkm::Id& pixelIndex,
+                            vtkm::UInt8& status,
+                            const RankPortalType& ranks) const
+  {
+    const vtkm::Id rank = ranks.Get(pixelIndex);
+    status = (rank >= StepBegin && rank < StepEnd) ? RAY_ACTIVE : RAY_TERMINATED;
+  }
+}; //class SelectProgressivePixels
+
+// Saves the pixels traced by the current progressive render, and fills every other pixel with
+// the closest pixel traced so far at the corner of its block.
+class UpdateProgressiveImage : public vtkm::worklet::WorkletMapField
+{
+  vtkm::Id Width;
+  vtkm::Id MaxBlockSize;
+  vtkm::Id StepBegin;
+  vtkm::Id StepEnd;
+
+public:
+  VTKM_CONT
+  UpdateProgressiveImage(vtkm::Id width,
+                         vtkm::Id maxBlockSize,
+                         vtkm::Id stepBegin,
+                         vtkm::Id stepEnd)
+    : Width(width)
+    , MaxBlockSize(maxBlockSize)
+    , StepBegin(stepBegin)
+    , StepEnd(stepEnd)
+  {
+  }
+
+  using ControlSignature =
+    void(FieldIn, WholeArrayIn, WholeArrayInOut, WholeArrayInOut, WholeArrayInOut, WholeArrayInOut);
+  using ExecutionSignature = void(WorkIndex, _1, _2, _3, _4, _5, _6);
+
+  template <typename RankPortalType,
+            typename ColorPortalType,
+            typename DepthPortalType,
+            typename SavedColorPortalType,
+            typename SavedDepthPortalType>
+  VTKM_EXEC void operator()(const vtkm::Id& pixelIndex,
+                            const vtkm::Id& rank,
+                            const RankPortalType& ranks,
+                            ColorPortalType& colorBuffer,
+                            DepthPortalType& depthBuffer,
+                            SavedColorPortalType& savedColors,
+                            SavedDepthPortalType& savedDepths) const
+  {
+    if (rank >= StepBegin && rank < StepEnd)
+    {
+      savedColors.Set(pixelIndex, colorBuffer.Get(pixelIndex));
+      savedDepths.Set(pixelIndex, depthBuffer.Get(pixelIndex));
+      return;
+    }
+
+    // Pixels of this render are read from the canvas, older ones from the saved image. Neither
+    // is written by another thread. Block sizes are powers of 2.
+    const vtkm::Id x = pixelIndex % Width;
+    const vtkm::Id y = pixelIndex / Width;
+    for (vtkm::Id blockSize = 1; blockSize <= MaxBlockSize; blockSize *= 2)
+    {
+      const vtkm::Id mask = ~(blockSize - 1);
+      const vtkm::Id source = (y & mask) * Width + (x & mask);
+      const vtkm::Id sourceRank = ranks.Get(source);
+      if (sourceRank < StepBegin)
+      {
+        colorBuffer.Set(pixelIndex, savedColors.Get(source));
+        depthBuffer.Set(pixelIndex, savedDepths.Get(source));
+        return;
+      }
+      if (sourceRank < StepEnd)
+      {
+        colorBuffer.Set(pixelIndex, colorBuffer.Get(source));
+        depthBuffer.Set(pixelIndex, depthBuffer.Get(source));
+        return;
+      }
+    }
+  }
+}; //class UpdateProgressiveImage
+
 template <typename Precision>
 VTKM_CONT void WriteToCanvas(const vtkm::rendering::raytracing::Ray<Precision>& rays,
                              const vtkm::cont::ArrayHandle<Precision>& colors,
@@ -132,18 +234,118 @@ VTKM_CONT void WriteToCanvas(const vtkm::rendering::raytracing::Ray<Precision>&
 
 } // namespace internal
 
+struct CanvasRayTracer::ProgressiveInternals
+{
+  bool Enabled = false;
+  vtkm::Id RayBudget = 65536;
+  std::function<bool()> CancelCallback;
+
+  // The rank of each pixel in the order pixels are traced: the corners of blocks of
+  // MaxBlockSize pixels first, then the corners of blocks half as large, and so on.
+  vtkm::cont::ArrayHandle<vtkm::Id> Ranks;
+  vtkm::Id Width = 0;
+  vtkm::Id Height = 0;
+  vtkm::Id RanksBudget = 0;
+  vtkm::Id MaxBlockSize = 1;
+
+  // The pixels traced by previous renders
+  vtkm::cont::ArrayHandle<vtkm::Vec4f_32> Colors;
+  vtkm::cont::ArrayHandle<vtkm::Float32> Depths;
+
+  bool HasView = false;
+  vtkm::Matrix<vtkm::Float32, 4, 4> ViewProjection;
+  // Pixels ranked below Traced are saved. The current render traces those ranked from Traced
+  // to StepEnd.
+  vtkm::Id Traced = 0;
+  vtkm::Id StepEnd = 0;
+  bool StepStarted = false;
+  bool Canceled = false;
+
+  void ComputeRanks(vtkm::Id width, vtkm::Id height)
+  {
+    // The coarsest blocks are the smallest ones whose corners fit in one render.
+    this->MaxBlockSize = 1;
+    while ((this->MaxBlockSize < vtkm::Max(width, height)) &&
+           (((width + this->MaxBlockSize - 1) / this->MaxBlockSize) *
+              ((height + this->MaxBlockSize - 1) / this->MaxBlockSize) >
+            this->RayBudget))
+    {
+      this->MaxBlockSize *= 2;
+    }
+    auto getLevel = [this](vtkm::Id x, vtkm::Id y) {
+      vtkm::Id level = 0;
+      for (vtkm::Id blockSize = this->MaxBlockSize; blockSize > 1; blockSize /= 2)
+      {
+        if ((x % blockSize == 0) && (y % blockSize == 0))
+        {
+          break;
+        }
+        ++level;
+      }
+      return level;
+    };
+
+    vtkm::Id numLevels = 1;
+    for (vtkm::Id blockSize = this->MaxBlockSize; blockSize > 1; blockSize /= 2)
+    {
+      ++numLevels;
+    }
+    std::vector<vtkm::Id> levelOffsets(static_cast<std::size_t>(numLevels), 0);
+    for (vtkm::Id y = 0; y < height; ++y)
+    {
+      for (vtkm::Id x = 0; x < width; ++x)
+      {
+        ++levelOffsets[static_cast<std::size_t>(getLevel(x, y))];
+      }
+    }
+    vtkm::Id offset = 0;
+    for (auto& levelOffset : levelOffsets)
+    {
+      const vtkm::Id count = levelOffset;
+      levelOffset = offset;
+      offset += count;
+    }
+
+    this->Ranks.Allocate(width * height);
+    auto ranksPortal = this->Ranks.WritePortal();
+    for (vtkm::Id y = 0; y < height; ++y)
+    {
+      for (vtkm::Id x = 0; x < width; ++x)
+      {
+        ranksPortal.Set(y * width + x, levelOffsets[static_cast<std::size_t>(getLevel(x, y))]++);
+      }
+    }
+    this->Colors.Allocate(width * height);
+    this->Depths.Allocate(width * height);
+    this->Width = width;
+    this->Height = height;
+    this->RanksBudget = this->RayBudget;
+  }
+};
+
 CanvasRayTracer::CanvasRayTracer(vtkm::Id width, vtkm::Id height)
   : Canvas(width, height)
+  , Progressive(std::make_shared<ProgressiveInternals>())
 {
 }
 
 CanvasRayTracer::~CanvasRayTracer() {}
 
+void CanvasRayTracer::Clear()
+{
+  Canvas::Clear();
+  this->Progressive->StepStarted = false;
+}
+
 void CanvasRayTracer::WriteToCanvas(const vtkm::rendering::raytracing::Ray<vtkm::Float32>& rays,
                                     const vtkm::cont::ArrayHandle<vtkm::Float32>& colors,
                                     const vtkm::rendering::Camera& camera)
 {
   internal::WriteToCanvas(rays, colors, camera, this);
+  if (this->Progressive->Enabled && this->Progressive->StepStarted)
+  {
+    this->UpdateProgressiveImage();
+  }
 }
 
 void CanvasRayTracer::WriteToCanvas(const vtkm::rendering::raytracing::Ray<vtkm::Float64>& rays,
@@ -151,6 +353,147 @@ void CanvasRayTracer::WriteToCanvas(const vtkm::rendering::raytracing::Ray<vtkm:
                                     const vtkm::rendering::Camera& camera)
 {
   internal::WriteToCanvas(rays, colors, camera, this);
+  if (this->Progressive->Enabled && this->Progressive->StepStarted)
+  {
+    this->UpdateProgressiveImage();
+  }
+}
+
+void CanvasRayTracer::SetTileSize(vtkm::Id tileSize)
+{
+  if (tileSize < 0)
+  {
+    throw vtkm::cont::ErrorBadValue("Tile size cannot be negative.");
+  }
+  this->TileSize = tileSize;
+}
+
+void CanvasRayTracer::SetProgressiveRendering(bool on)
+{
+  this->Progressive->Enabled = on;
+  this->Progressive->HasView = false;
+}
+
+bool CanvasRayTracer::GetProgressiveRendering() const
+{
+  return this->Progressive->Enabled;
+}
+
+void CanvasRayTracer::SetProgressiveRayBudget(vtkm::Id numRays)
+{
+  if (numRays < 1)
+  {
+    throw vtkm::cont::ErrorBadValue("Progressive ray budget must be positive.");
+  }
+  this->Progressive->RayBudget = numRays;
+}
+
+vtkm::Id CanvasRayTracer::GetProgressiveRayBudget() const
+{
+  return this->Progressive->RayBudget;
+}
+
+void CanvasRayTracer::SetProgressiveCancelCallback(const std::function<bool()>& callback)
+{
+  this->Progressive->CancelCallback = callback;
+}
+
+bool CanvasRayTracer::IsProgressiveRenderingComplete() const
+{
+  const ProgressiveInternals& progressive = *this->Progressive;
+  return !progressive.Enabled ||
+    (progressive.HasView && !progressive.Canceled &&
+     progressive.StepEnd == progressive.Width * progressive.Height);
+}
+
+void CanvasRayTracer::ResetProgressiveRendering()
+{
+  this->Progressive->HasView = false;
+}
+
+bool CanvasRayTracer::SelectProgressiveRays(vtkm::rendering::raytracing::Ray<vtkm::Float32>& rays,
+                                            const vtkm::rendering::Camera& camera)
+{
+  return this->SelectProgressiveRaysImpl(rays, camera);
+}
+
+bool CanvasRayTracer::SelectProgressiveRays(vtkm::rendering::raytracing::Ray<vtkm::Float64>& rays,
+                                            const vtkm::rendering::Camera& camera)
+{
+  return this->SelectProgressiveRaysImpl(rays, camera);
+}
+
+template <typename Precision>
+bool CanvasRayTracer::SelectProgressiveRaysImpl(vtkm::rendering::raytracing::Ray<Precision>& rays,
+                                                const vtkm::rendering::Camera& camera)
+{
+  ProgressiveInternals& progressive = *this->Progressive;
+  if (!progressive.StepStarted)
+  {
+    // First mapper of this render: decide which pixels it traces
+    progressive.StepStarted = true;
+    const vtkm::Id width = this->GetWidth();
+    const vtkm::Id height = this->GetHeight();
+    const vtkm::Matrix<vtkm::Float32, 4, 4> viewProjection = vtkm::MatrixMultiply(
+      camera.CreateProjectionMatrix(width, height), camera.CreateViewMatrix());
+    const bool sameSize = (width == progressive.Width) && (height == progressive.Height) &&
+      (progressive.RayBudget == progressive.RanksBudget);
+    bool sameView = progressive.HasView && sameSize;
+    for (vtkm::IdComponent i = 0; sameView && i < 4; ++i)
+    {
+      sameView = (viewProjection[i] == progressive.ViewProjection[i]);
+    }
+
+    if (!sameSize)
+    {
+      progressive.ComputeRanks(width, height);
+    }
+    if (!sameView)
+    {
+      progressive.Traced = 0;
+    }
+    else if (!progressive.Canceled)
+    {
+      progressive.Traced = progressive.StepEnd;
+    }
+    progressive.HasView = true;
+    progressive.ViewProjection = viewProjection;
+    progressive.Canceled = false;
+    progressive.StepEnd = vtkm::Min(progressive.Traced + progressive.RayBudget, width * height);
+  }
+
+  if (!progressive.Canceled && progressive.CancelCallback && progressive.CancelCallback())
+  {
+    progressive.Canceled = true;
+  }
+  if (!progressive.Canceled && progressive.Traced < progressive.StepEnd)
+  {
+    vtkm::worklet::DispatcherMapField<internal::SelectProgressivePixels>(
+      internal::SelectProgressivePixels(progressive.Traced, progressive.StepEnd))
+      .Invoke(rays.PixelIdx, rays.Status, progressive.Ranks);
+    vtkm::rendering::raytracing::RayOperations::CompactActiveRays(rays);
+    if (rays.NumRays > 0)
+    {
+      return true;
+    }
+  }
+  this->UpdateProgressiveImage();
+  return false;
+}
+
+void CanvasRayTracer::UpdateProgressiveImage()
+{
+  const ProgressiveInternals& progressive = *this->Progressive;
+  const vtkm::Id stepEnd = progressive.Canceled ? progressive.Traced : progressive.StepEnd;
+  vtkm::worklet::DispatcherMapField<internal::UpdateProgressiveImage>(
+    internal::UpdateProgressiveImage(
+      progressive.Width, progressive.MaxBlockSize, progressive.Traced, stepEnd))
+    .Invoke(progressive.Ranks,
+            progressive.Ranks,
+            this->GetColorBuffer(),
+            this->GetDepthBuffer(),
+            progressive.Colors,
+            progressive.Depths);
 }
 
 vtkm::rendering::Canvas* CanvasRayTracer::NewCopy() const
@@ -15,6 +15,9 @@
 #include <vtkm/rendering/Canvas.h>
 #include <vtkm/rendering/raytracing/Ray.h>
 
+#include <functional>
+#include <memory>
+
 namespace vtkm
 {
 namespace rendering
@@ -29,6 +32,8 @@ public:
 
   vtkm::rendering::Canvas* NewCopy() const override;
 
+  void Clear() override;
+
   void WriteToCanvas(const vtkm::rendering::raytracing::Ray<vtkm::Float32>& rays,
                      const vtkm::cont::ArrayHandle<vtkm::Float32>& colors,
                      const vtkm::rendering::Camera& camera);
@@ -36,6 +41,77 @@ public:
   void WriteToCanvas(const vtkm::rendering::raytracing::Ray<vtkm::Float64>& rays,
                      const vtkm::cont::ArrayHandle<vtkm::Float64>& colors,
                      const vtkm::rendering::Camera& camera);
+
+  /// \brief Renders the image in square tiles of `tileSize` pixels a side.
+  ///
+  /// By default, mappers create the rays of every pixel they cover at once, which takes over
+  /// 100 bytes per pixel. With a tile size, `MapperRayTracer` and `MapperVolume` create and
+  /// trace the rays of one tile after another, reusing the same ray buffers and writing each
+  /// tile to the canvas. This bounds their memory use for large images. A tile size of 0, the
+  /// default, renders the whole image at once. Tiles are not used when progressive rendering is
+  /// on, since each render then traces a bounded number of rays.
+  ///
+  void SetTileSize(vtkm::Id tileSize);
+  vtkm::Id GetTileSize() const { return this->TileSize; }
+
+  /// \brief Renders images over several passes, each tracing a bounded number of rays.
+  ///
+  /// With progressive rendering on, a render (a `Clear` followed by the mappers writing to the
+  /// canvas, as `View::Paint` does) traces at most `GetProgressiveRayBudget()` pixels. The
+  /// first render for a camera traces a coarse grid of pixels, each standing in for its block
+  /// of the image. The following renders with the same camera refine the image with further
+  /// pixels, which accumulate in the canvas until every pixel is traced. The time of a render
+  /// thus depends on the budget rather than on the size of the canvas, which suits interactive
+  /// views. The complete image is the same as a render without progressive rendering.
+  ///
+  /// `MapperRayTracer` and `MapperVolume` render progressively. Other mappers trace every
+  /// pixel in each render.
+  ///
+  void SetProgressiveRendering(bool on);
+  bool GetProgressiveRendering() const;
+
+  /// \brief The number of pixels traced by a progressive render. The default is 65536.
+  void SetProgressiveRayBudget(vtkm::Id numRays);
+  vtkm::Id GetProgressiveRayBudget() const;
+
+  /// \brief A function polled by each mapper before it traces its rays.
+  ///
+  /// If the function returns true, the progressive render is canceled: the canvas shows the
+  /// image of the previous render, and the next render traces the pixels that this one would
+  /// have.
+  ///
+  void SetProgressiveCancelCallback(const std::function<bool()>& callback);
+
+  /// \brief True once every pixel of the image was traced for the current camera.
+  bool IsProgressiveRenderingComplete() const;
+
+  /// \brief Starts the progressive image anew on the next render.
+  ///
+  /// Progressive rendering only detects changes of the camera and canvas size. Call this when
+  /// anything else in the scene changed.
+  ///
+  void ResetProgressiveRendering();
+
+  /// \brief Keeps the rays of the pixels traced by the current progressive render.
+  ///
+  /// Mappers call this with the rays created for `camera`, when progressive rendering is on.
+  /// Returns false when there is nothing to trace, either because the render was canceled or
+  /// because the image is complete. The canvas then already shows the image.
+  ///
+  bool SelectProgressiveRays(vtkm::rendering::raytracing::Ray<vtkm::Float32>& rays,
+                             const vtkm::rendering::Camera& camera);
+  bool SelectProgressiveRays(vtkm::rendering::raytracing::Ray<vtkm::Float64>& rays,
+                             const vtkm::rendering::Camera& camera);
+
+private:
+  template <typename Precision>
+  bool SelectProgressiveRaysImpl(vtkm::rendering::raytracing::Ray<Precision>& rays,
+                                 const vtkm::rendering::Camera& camera);
+  void UpdateProgressiveImage();
+
+  vtkm::Id TileSize = 0;
+  struct ProgressiveInternals;
+  std::shared_ptr<ProgressiveInternals> Progressive;
 }; // class CanvasRayTracer
 }
 } // namespace vtkm::rendering
@@ -100,6 +100,13 @@ public:
   VTKM_CONT
   void SetEpsilon(vtkm::Float64 epsilon) { Tracer.SetEpsilon(epsilon); }
 
+  VTKM_CONT
+  void SetMeshConnectivityCache(
+    const std::shared_ptr<vtkm::rendering::raytracing::MeshConnectivityCache>& cache)
+  {
+    Tracer.SetMeshConnectivityCache(cache);
+  }
+
   VTKM_CONT
   void SetEmissionField(const std::string& fieldName)
   {
@@ -434,5 +441,12 @@ void ConnectivityProxy::SetUnitScalar(vtkm::Float32 unitScalar)
 {
   Internals->SetUnitScalar(unitScalar);
 }
+
+VTKM_CONT
+void ConnectivityProxy::SetMeshConnectivityCache(
+  const std::shared_ptr<vtkm::rendering::raytracing::MeshConnectivityCache>& cache)
+{
+  Internals->SetMeshConnectivityCache(cache);
+}
 }
 } // namespace vtkm::rendering
@@ -24,6 +24,10 @@ namespace vtkm
 {
 namespace rendering
 {
+namespace raytracing
+{
+class MeshConnectivityCache;
+}
 
 using PartialVector64 = std::vector<vtkm::rendering::raytracing::PartialComposite<vtkm::Float64>>;
 using PartialVector32 = std::vector<vtkm::rendering::raytracing::PartialComposite<vtkm::Float32>>;
@@ -62,6 +66,9 @@ public:
   void SetDebugPrints(bool on);
   void SetUnitScalar(vtkm::Float32 unitScalar);
   void SetEpsilon(vtkm::Float64 epsilon); // epsilon for bumping lost rays
+  // Shares the connectivity built for each mesh between the proxies given the same cache.
+  void SetMeshConnectivityCache(
+    const std::shared_ptr<vtkm::rendering::raytracing::MeshConnectivityCache>& cache);
 
   vtkm::Bounds GetSpatialBounds();
   vtkm::Range GetScalarFieldRange();
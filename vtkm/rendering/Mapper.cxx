@@ -10,6 +10,8 @@
 
 #include <vtkm/rendering/Mapper.h>
 
+#include <vtkm/cont/ErrorBadValue.h>
+
 namespace vtkm
 {
 namespace rendering
@@ -17,6 +19,25 @@ namespace rendering
 
 Mapper::~Mapper() {}
 
+void Mapper::RenderCellsMultiView(const vtkm::cont::UnknownCellSet& cellset,
+                                  const vtkm::cont::CoordinateSystem& coords,
+                                  const vtkm::cont::Field& scalarField,
+                                  const vtkm::cont::ColorTable& colorTable,
+                                  const std::vector<vtkm::rendering::Camera>& cameras,
+                                  const std::vector<vtkm::rendering::Canvas*>& canvases,
+                                  const vtkm::Range& scalarRange)
+{
+  if (cameras.size() != canvases.size())
+  {
+    throw vtkm::cont::ErrorBadValue("Need one canvas per camera.");
+  }
+  for (std::size_t view = 0; view < cameras.size(); ++view)
+  {
+    this->SetCanvas(canvases[view]);
+    this->RenderCells(cellset, coords, scalarField, colorTable, cameras[view], scalarRange);
+  }
+}
+
 void Mapper::SetActiveColorTable(const vtkm::cont::ColorTable& colorTable)
 {
 
@@ -17,6 +17,9 @@
 #include <vtkm/cont/UnknownCellSet.h>
 #include <vtkm/rendering/Camera.h>
 #include <vtkm/rendering/Canvas.h>
+
+#include <vector>
+
 namespace vtkm
 {
 namespace rendering
@@ -37,6 +40,21 @@ public:
                            const vtkm::rendering::Camera& camera,
                            const vtkm::Range& scalarRange) = 0;
 
+  /// \brief Renders the cells from each camera into the canvas of the same index.
+  ///
+  /// This is the same as calling `SetCanvas` and `RenderCells` for each camera, which is what
+  /// the default implementation does. Mappers that build structures for the cells, such as
+  /// acceleration structures for ray tracing, override it to build or look them up once for
+  /// every view. The mapper is left with the last canvas set.
+  ///
+  virtual void RenderCellsMultiView(const vtkm::cont::UnknownCellSet& cellset,
+                                    const vtkm::cont::CoordinateSystem& coords,
+                                    const vtkm::cont::Field& scalarField,
+                                    const vtkm::cont::ColorTable& colorTable,
+                                    const std::vector<vtkm::rendering::Camera>& cameras,
+                                    const std::vector<vtkm::rendering::Canvas*>& canvases,
+                                    const vtkm::Range& scalarRange);
+
   virtual void SetActiveColorTable(const vtkm::cont::ColorTable& ct);
 
   VTKM_DEPRECATED(1.6, "StartScene() does nothing")
@@ -16,6 +16,7 @@
 
 #include <cstdlib>
 #include <vtkm/rendering/raytracing/Camera.h>
+#include <vtkm/rendering/raytracing/MeshConnectivityCache.h>
 
 namespace vtkm
 {
@@ -24,6 +25,7 @@ namespace rendering
 
 VTKM_CONT
 MapperConnectivity::MapperConnectivity()
+  : MeshCache(std::make_shared<raytracing::MeshConnectivityCache>())
 {
   CanvasRT = nullptr;
   SampleDistance = -1;
@@ -67,6 +69,7 @@ void MapperConnectivity::RenderCells(const vtkm::cont::UnknownCellSet& cellset,
                                      const vtkm::Range& scalarRange)
 {
   vtkm::rendering::ConnectivityProxy tracerProxy(cellset, coords, scalarField);
+  tracerProxy.SetMeshConnectivityCache(this->MeshCache);
   if (SampleDistance == -1.f)
   {
     // set a default distance
@@ -15,10 +15,16 @@
 #include <vtkm/rendering/Mapper.h>
 #include <vtkm/rendering/View.h>
 
+#include <memory>
+
 namespace vtkm
 {
 namespace rendering
 {
+namespace raytracing
+{
+class MeshConnectivityCache;
+}
 
 class VTKM_RENDERING_EXPORT MapperConnectivity : public Mapper
 {
@@ -43,6 +49,8 @@ public:
 protected:
   vtkm::Float32 SampleDistance;
   CanvasRayTracer* CanvasRT;
+  // The connectivity of the meshes rendered before, shared by the copies of this mapper.
+  std::shared_ptr<raytracing::MeshConnectivityCache> MeshCache;
 };
 }
 } //namespace vtkm::rendering
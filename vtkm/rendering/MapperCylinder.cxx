@@ -21,6 +21,7 @@
 #include <vtkm/rendering/raytracing/Logger.h>
 #include <vtkm/rendering/raytracing/RayOperations.h>
 #include <vtkm/rendering/raytracing/RayTracer.h>
+#include <vtkm/rendering/raytracing/ShapeIntersectorCache.h>
 #include <vtkm/rendering/raytracing/Worklets.h>
 
 namespace vtkm
@@ -54,6 +55,7 @@ struct MapperCylinder::InternalsType
   vtkm::rendering::raytracing::RayTracer Tracer;
   vtkm::rendering::raytracing::Camera RayCamera;
   vtkm::rendering::raytracing::Ray<vtkm::Float32> Rays;
+  vtkm::rendering::raytracing::ShapeIntersectorCache Intersectors;
   bool CompositeBackground;
   vtkm::Float32 Radius;
   vtkm::Float32 Delta;
@@ -123,12 +125,14 @@ void MapperCylinder::RenderCells(const vtkm::cont::UnknownCellSet& cellset,
                                  const vtkm::Range& scalarRange)
 {
   raytracing::Logger* logger = raytracing::Logger::GetInstance();
+  // make sure we start fresh
+  this->Internals->Tracer.Clear();
+
   logger->OpenLogEntry("mapper_cylinder");
   vtkm::cont::Timer tot_timer;
   tot_timer.Start();
   vtkm::cont::Timer timer;
 
-
   vtkm::Bounds shapeBounds;
   raytracing::CylinderExtractor cylExtractor;
 
@@ -154,26 +158,57 @@ void MapperCylinder::RenderCells(const vtkm::cont::UnknownCellSet& cellset,
       .Invoke(cylExtractor.GetRadii());
   }
 
-  if (this->Internals->UseVariableRadius)
+  //
+  // Add supported shapes
+  //
+  using MatchType = raytracing::ShapeIntersectorCache::MatchType;
+  const std::vector<vtkm::Float64> parameters{
+    baseRadius, this->Internals->UseVariableRadius ? this->Internals->Delta : 0.f
+  };
+  MatchType match;
+  auto cylIntersector = std::static_pointer_cast<raytracing::CylinderIntersector>(
+    this->Internals->Intersectors.Find(cellset, coords, parameters, match));
+  if ((match == MatchType::All) && this->Internals->UseVariableRadius)
   {
-    vtkm::Float32 minRadius = baseRadius - baseRadius * this->Internals->Delta;
-    vtkm::Float32 maxRadius = baseRadius + baseRadius * this->Internals->Delta;
-
-    cylExtractor.ExtractCells(cellset, scalarField, minRadius, maxRadius);
+    // The radii come from the scalar field, which may have changed.
+    match = MatchType::CellSet;
   }
-  else
+
+  if (match != MatchType::All)
   {
-    cylExtractor.ExtractCells(cellset, baseRadius);
-  }
+    if (this->Internals->UseVariableRadius)
+    {
+      vtkm::Float32 minRadius = baseRadius - baseRadius * this->Internals->Delta;
+      vtkm::Float32 maxRadius = baseRadius + baseRadius * this->Internals->Delta;
 
-  //
-  // Add supported shapes
-  //
+      cylExtractor.ExtractCells(cellset, scalarField, minRadius, maxRadius);
+    }
+    else
+    {
+      cylExtractor.ExtractCells(cellset, baseRadius);
+    }
+
+    if (cylExtractor.GetNumberOfCylinders() == 0)
+    {
+      cylIntersector = nullptr;
+    }
+    else if (match == MatchType::CellSet)
+    {
+      // The cylinders are the same, only their coordinates or radii changed.
+      cylIntersector->Refit(coords, cylExtractor.GetRadii());
+      this->Internals->Intersectors.Insert(cellset, coords, parameters, cylIntersector);
+    }
+    else
+    {
+      cylIntersector = std::make_shared<raytracing::CylinderIntersector>();
+      cylIntersector->SetKeepTreeForRefit(this->Internals->Intersectors.GetCapacity() > 0);
+      cylIntersector->SetData(coords, cylExtractor.GetCylIds(), cylExtractor.GetRadii());
+      this->Internals->Intersectors.Insert(cellset, coords, parameters, cylIntersector);
+    }
+  }
 
-  if (cylExtractor.GetNumberOfCylinders() > 0)
+  if (cylIntersector)
   {
-    auto cylIntersector = std::make_shared<raytracing::CylinderIntersector>();
-    cylIntersector->SetData(coords, cylExtractor.GetCylIds(), cylExtractor.GetRadii());
     this->Internals->Tracer.AddShapeIntersector(cylIntersector);
     shapeBounds.Include(cylIntersector->GetShapeBounds());
   }
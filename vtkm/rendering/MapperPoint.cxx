@@ -18,6 +18,7 @@
 #include <vtkm/rendering/raytracing/Logger.h>
 #include <vtkm/rendering/raytracing/RayOperations.h>
 #include <vtkm/rendering/raytracing/RayTracer.h>
+#include <vtkm/rendering/raytracing/ShapeIntersectorCache.h>
 #include <vtkm/rendering/raytracing/SphereExtractor.h>
 #include <vtkm/rendering/raytracing/SphereIntersector.h>
 
@@ -32,6 +33,7 @@ struct MapperPoint::InternalsType
   vtkm::rendering::raytracing::RayTracer Tracer;
   vtkm::rendering::raytracing::Camera RayCamera;
   vtkm::rendering::raytracing::Ray<vtkm::Float32> Rays;
+  vtkm::rendering::raytracing::ShapeIntersectorCache Intersectors;
   bool CompositeBackground;
   vtkm::Float32 PointRadius;
   bool UseNodes;
@@ -141,37 +143,72 @@ void MapperPoint::RenderCells(const vtkm::cont::UnknownCellSet& cellset,
 
   raytracing::SphereExtractor sphereExtractor;
 
-  if (this->Internals->UseVariableRadius)
+  using MatchType = raytracing::ShapeIntersectorCache::MatchType;
+  const std::vector<vtkm::Float64> parameters{
+    baseRadius,
+    this->Internals->UseVariableRadius ? this->Internals->PointDelta : 0.f,
+    this->Internals->UseNodes ? 1. : 0.
+  };
+  MatchType match;
+  auto sphereIntersector = std::static_pointer_cast<raytracing::SphereIntersector>(
+    this->Internals->Intersectors.Find(cellset, coords, parameters, match));
+  if ((match == MatchType::All) && this->Internals->UseVariableRadius)
   {
-    vtkm::Float32 minRadius = baseRadius - baseRadius * this->Internals->PointDelta;
-    vtkm::Float32 maxRadius = baseRadius + baseRadius * this->Internals->PointDelta;
-    if (this->Internals->UseNodes)
-    {
+    // The radii come from the scalar field, which may have changed.
+    match = MatchType::CellSet;
+  }
 
-      sphereExtractor.ExtractCoordinates(coords, scalarField, minRadius, maxRadius);
+  if (match != MatchType::All)
+  {
+    if (this->Internals->UseVariableRadius)
+    {
+      vtkm::Float32 minRadius = baseRadius - baseRadius * this->Internals->PointDelta;
+      vtkm::Float32 maxRadius = baseRadius + baseRadius * this->Internals->PointDelta;
+      if (this->Internals->UseNodes)
+      {
+
+        sphereExtractor.ExtractCoordinates(coords, scalarField, minRadius, maxRadius);
+      }
+      else
+      {
+        sphereExtractor.ExtractCells(cellset, scalarField, minRadius, maxRadius);
+      }
     }
     else
     {
-      sphereExtractor.ExtractCells(cellset, scalarField, minRadius, maxRadius);
+      if (this->Internals->UseNodes)
+      {
+
+        sphereExtractor.ExtractCoordinates(coords, baseRadius);
+      }
+      else
+      {
+        sphereExtractor.ExtractCells(cellset, baseRadius);
+      }
     }
-  }
-  else
-  {
-    if (this->Internals->UseNodes)
-    {
 
-      sphereExtractor.ExtractCoordinates(coords, baseRadius);
+    if (sphereExtractor.GetNumberOfSpheres() == 0)
+    {
+      sphereIntersector = nullptr;
+    }
+    else if (match == MatchType::CellSet)
+    {
+      // The spheres are the same, only their coordinates or radii changed.
+      sphereIntersector->Refit(coords, sphereExtractor.GetRadii());
+      this->Internals->Intersectors.Insert(cellset, coords, parameters, sphereIntersector);
     }
     else
     {
-      sphereExtractor.ExtractCells(cellset, baseRadius);
+      sphereIntersector = std::make_shared<raytracing::SphereIntersector>();
+      sphereIntersector->SetKeepTreeForRefit(this->Internals->Intersectors.GetCapacity() > 0);
+      sphereIntersector->SetData(
+        coords, sphereExtractor.GetPointIds(), sphereExtractor.GetRadii());
+      this->Internals->Intersectors.Insert(cellset, coords, parameters, sphereIntersector);
     }
   }
 
-  if (sphereExtractor.GetNumberOfSpheres() > 0)
+  if (sphereIntersector)
   {
-    auto sphereIntersector = std::make_shared<raytracing::SphereIntersector>();
-    sphereIntersector->SetData(coords, sphereExtractor.GetPointIds(), sphereExtractor.GetRadii());
     this->Internals->Tracer.AddShapeIntersector(sphereIntersector);
     shapeBounds.Include(sphereIntersector->GetShapeBounds());
   }
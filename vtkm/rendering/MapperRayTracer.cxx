@@ -13,12 +13,15 @@
 #include <vtkm/cont/Timer.h>
 #include <vtkm/cont/TryExecute.h>
 
+#include <vtkm/filter/MapFieldPermutation.h>
 #include <vtkm/rendering/CanvasRayTracer.h>
 #include <vtkm/rendering/internal/RunTriangulator.h>
 #include <vtkm/rendering/raytracing/Camera.h>
+#include <vtkm/rendering/raytracing/LevelOfDetailCache.h>
 #include <vtkm/rendering/raytracing/Logger.h>
 #include <vtkm/rendering/raytracing/RayOperations.h>
 #include <vtkm/rendering/raytracing/RayTracer.h>
+#include <vtkm/rendering/raytracing/ShapeIntersectorCache.h>
 #include <vtkm/rendering/raytracing/SphereExtractor.h>
 #include <vtkm/rendering/raytracing/SphereIntersector.h>
 #include <vtkm/rendering/raytracing/TriangleExtractor.h>
@@ -34,13 +37,19 @@ struct MapperRayTracer::InternalsType
   vtkm::rendering::raytracing::RayTracer Tracer;
   vtkm::rendering::raytracing::Camera RayCamera;
   vtkm::rendering::raytracing::Ray<vtkm::Float32> Rays;
+  vtkm::rendering::raytracing::ShapeIntersectorCache Intersectors;
+  vtkm::rendering::raytracing::LevelOfDetailCache LevelsOfDetail;
   bool CompositeBackground;
   bool Shade;
+  bool LevelOfDetail;
+  vtkm::Float64 LevelOfDetailPixelSize;
   VTKM_CONT
   InternalsType()
     : Canvas(nullptr)
     , CompositeBackground(true)
     , Shade(true)
+    , LevelOfDetail(false)
+    , LevelOfDetailPixelSize(1.)
   {
   }
 };
@@ -76,10 +85,28 @@ vtkm::rendering::Canvas* MapperRayTracer::GetCanvas() const
 void MapperRayTracer::RenderCells(const vtkm::cont::UnknownCellSet& cellset,
                                   const vtkm::cont::CoordinateSystem& coords,
                                   const vtkm::cont::Field& scalarField,
-                                  const vtkm::cont::ColorTable& vtkmNotUsed(colorTable),
+                                  const vtkm::cont::ColorTable& colorTable,
                                   const vtkm::rendering::Camera& camera,
                                   const vtkm::Range& scalarRange)
 {
+  this->RenderCellsMultiView(
+    cellset, coords, scalarField, colorTable, { camera }, { this->Internals->Canvas }, scalarRange);
+}
+
+void MapperRayTracer::RenderCellsMultiView(
+  const vtkm::cont::UnknownCellSet& cellset,
+  const vtkm::cont::CoordinateSystem& coords,
+  const vtkm::cont::Field& scalarField,
+  const vtkm::cont::ColorTable& vtkmNotUsed(colorTable),
+  const std::vector<vtkm::rendering::Camera>& cameras,
+  const std::vector<vtkm::rendering::Canvas*>& canvases,
+  const vtkm::Range& scalarRange)
+{
+  if (cameras.size() != canvases.size())
+  {
+    throw vtkm::cont::ErrorBadValue("Need one canvas per camera.");
+  }
+
   raytracing::Logger* logger = raytracing::Logger::GetInstance();
   logger->OpenLogEntry("mapper_ray_tracer");
   vtkm::cont::Timer tot_timer;
@@ -92,50 +119,147 @@ void MapperRayTracer::RenderCells(const vtkm::cont::UnknownCellSet& cellset,
   // Add supported shapes
   //
   vtkm::Bounds shapeBounds;
-  raytracing::TriangleExtractor triExtractor;
-  triExtractor.ExtractCells(cellset);
-  if (triExtractor.GetNumberOfTriangles() > 0)
+  std::shared_ptr<raytracing::TriangleIntersector> triIntersector;
+  vtkm::cont::Field field = scalarField;
+  if (this->Internals->LevelOfDetail)
+  {
+    // All views are traced through the same shapes, so use the finest level any of them needs.
+    vtkm::Id divisions = 0;
+    const vtkm::Bounds bounds = coords.GetBounds();
+    for (std::size_t view = 0; view < cameras.size(); ++view)
+    {
+      const vtkm::Id viewDivisions = raytracing::LevelOfDetailCache::GetDivisions(
+        cameras[view],
+        canvases[view]->GetWidth(),
+        canvases[view]->GetHeight(),
+        bounds,
+        this->Internals->LevelOfDetailPixelSize);
+      if (viewDivisions == 0)
+      {
+        divisions = 0;
+        break;
+      }
+      divisions = vtkm::Max(divisions, viewDivisions);
+    }
+    if (divisions > 0)
+    {
+      auto level = this->Internals->LevelsOfDetail.Get(cellset, coords, divisions);
+      if (level->Intersector)
+      {
+        triIntersector = level->Intersector;
+        if (scalarField.IsFieldPoint())
+        {
+          vtkm::filter::MapFieldPermutation(scalarField, level->PointIds, field);
+        }
+        logger->AddLogData("lod_divisions", divisions);
+        logger->AddLogData("lod_triangles", level->NumberOfTriangles);
+      }
+    }
+  }
+
+  if (!triIntersector)
+  {
+    using MatchType = raytracing::ShapeIntersectorCache::MatchType;
+    MatchType match;
+    triIntersector = std::static_pointer_cast<raytracing::TriangleIntersector>(
+      this->Internals->Intersectors.Find(cellset, coords, {}, match));
+    if (match == MatchType::CellSet)
+    {
+      // Only the coordinates changed, so the triangles are the same.
+      triIntersector->Refit(coords);
+      this->Internals->Intersectors.Insert(cellset, coords, {}, triIntersector);
+    }
+    else if (match == MatchType::None)
+    {
+      raytracing::TriangleExtractor triExtractor;
+      triExtractor.ExtractCells(cellset);
+      if (triExtractor.GetNumberOfTriangles() > 0)
+      {
+        triIntersector = std::make_shared<raytracing::TriangleIntersector>();
+        triIntersector->SetKeepTreeForRefit(this->Internals->Intersectors.GetCapacity() > 0);
+        triIntersector->SetData(coords, triExtractor.GetTriangles());
+        this->Internals->Intersectors.Insert(cellset, coords, {}, triIntersector);
+      }
+    }
+  }
+  if (triIntersector)
   {
-    auto triIntersector = std::make_shared<raytracing::TriangleIntersector>();
-    triIntersector->SetData(coords, triExtractor.GetTriangles());
     this->Internals->Tracer.AddShapeIntersector(triIntersector);
     shapeBounds.Include(triIntersector->GetShapeBounds());
   }
 
-  //
-  // Create rays
-  //
-  vtkm::Int32 width = (vtkm::Int32)this->Internals->Canvas->GetWidth();
-  vtkm::Int32 height = (vtkm::Int32)this->Internals->Canvas->GetHeight();
+  this->Internals->Tracer.SetField(field, scalarRange);
+  this->Internals->Tracer.SetColorMap(this->ColorMap);
+  this->Internals->Tracer.SetShadingOn(this->Internals->Shade);
 
-  this->Internals->RayCamera.SetParameters(camera, width, height);
+  // The shapes are shared by all the views. Each one is traced with its own rays.
+  vtkm::Float64 writeTime = 0.;
+  for (std::size_t view = 0; view < cameras.size(); ++view)
+  {
+    this->SetCanvas(canvases[view]);
+    const vtkm::rendering::Camera& camera = cameras[view];
 
-  this->Internals->RayCamera.CreateRays(this->Internals->Rays, shapeBounds);
-  this->Internals->Tracer.GetCamera() = this->Internals->RayCamera;
-  this->Internals->Rays.Buffers.at(0).InitConst(0.f);
-  raytracing::RayOperations::MapCanvasToRays(
-    this->Internals->Rays, camera, *this->Internals->Canvas);
+    //
+    // Create rays
+    //
+    vtkm::Int32 width = (vtkm::Int32)this->Internals->Canvas->GetWidth();
+    vtkm::Int32 height = (vtkm::Int32)this->Internals->Canvas->GetHeight();
 
+    this->Internals->RayCamera.SetParameters(camera, width, height);
 
+    const bool progressive = this->Internals->Canvas->GetProgressiveRendering();
+    vtkm::Int32 tileSize = static_cast<vtkm::Int32>(this->Internals->Canvas->GetTileSize());
+    const bool tiled = !progressive && tileSize > 0 && tileSize < vtkm::Max(width, height);
+    if (!tiled)
+    {
+      this->Internals->RayCamera.ClearTile();
+      tileSize = vtkm::Max(width, height);
+    }
 
-  this->Internals->Tracer.SetField(scalarField, scalarRange);
+    for (vtkm::Int32 tileY = 0; tileY < height; tileY += tileSize)
+    {
+      for (vtkm::Int32 tileX = 0; tileX < width; tileX += tileSize)
+      {
+        if (tiled)
+        {
+          this->Internals->RayCamera.SetTile(vtkm::Vec2i_32(tileX, tileY),
+                                             vtkm::Vec2i_32(tileX + tileSize, tileY + tileSize));
+        }
+        this->Internals->RayCamera.CreateRays(this->Internals->Rays, shapeBounds);
+        bool traceRays = this->Internals->Rays.NumRays > 0;
+        if (traceRays && progressive)
+        {
+          traceRays =
+            this->Internals->Canvas->SelectProgressiveRays(this->Internals->Rays, camera);
+        }
+        if (!traceRays)
+        {
+          continue;
+        }
 
-  this->Internals->Tracer.SetColorMap(this->ColorMap);
-  this->Internals->Tracer.SetShadingOn(this->Internals->Shade);
-  this->Internals->Tracer.Render(this->Internals->Rays);
+        this->Internals->Tracer.GetCamera() = this->Internals->RayCamera;
+        this->Internals->Rays.Buffers.at(0).InitConst(0.f);
+        raytracing::RayOperations::MapCanvasToRays(
+          this->Internals->Rays, camera, *this->Internals->Canvas);
+        this->Internals->Tracer.Render(this->Internals->Rays);
 
-  timer.Start();
-  this->Internals->Canvas->WriteToCanvas(
-    this->Internals->Rays, this->Internals->Rays.Buffers.at(0).Buffer, camera);
+        timer.Start();
+        this->Internals->Canvas->WriteToCanvas(
+          this->Internals->Rays, this->Internals->Rays.Buffers.at(0).Buffer, camera);
+        writeTime += timer.GetElapsedTime();
+      }
+    }
 
-  if (this->Internals->CompositeBackground)
-  {
-    this->Internals->Canvas->BlendBackground();
+    timer.Start();
+    if (this->Internals->CompositeBackground)
+    {
+      this->Internals->Canvas->BlendBackground();
+    }
+    writeTime += timer.GetElapsedTime();
   }
 
-  vtkm::Float64 time = timer.GetElapsedTime();
-  logger->AddLogData("write_to_canvas", time);
-  time = tot_timer.GetElapsedTime();
+  logger->AddLogData("write_to_canvas", writeTime);
+  vtkm::Float64 time = tot_timer.GetElapsedTime();
   logger->CloseLogEntry(time);
 }
 
@@ -149,6 +273,30 @@ void MapperRayTracer::SetShadingOn(bool on)
   this->Internals->Shade = on;
 }
 
+void MapperRayTracer::SetLevelOfDetailOn(bool on)
+{
+  this->Internals->LevelOfDetail = on;
+}
+
+bool MapperRayTracer::GetLevelOfDetailOn() const
+{
+  return this->Internals->LevelOfDetail;
+}
+
+void MapperRayTracer::SetLevelOfDetailPixelSize(vtkm::Float64 pixelSize)
+{
+  if (!(pixelSize > 0.))
+  {
+    throw vtkm::cont::ErrorBadValue("Level of detail pixel size must be positive.");
+  }
+  this->Internals->LevelOfDetailPixelSize = pixelSize;
+}
+
+vtkm::Float64 MapperRayTracer::GetLevelOfDetailPixelSize() const
+{
+  return this->Internals->LevelOfDetailPixelSize;
+}
+
 vtkm::rendering::Mapper* MapperRayTracer::NewCopy() const
 {
   return new vtkm::rendering::MapperRayTracer(*this);
@@ -38,10 +38,35 @@ public:
                    const vtkm::rendering::Camera& camera,
                    const vtkm::Range& scalarRange) override;
 
+  void RenderCellsMultiView(const vtkm::cont::UnknownCellSet& cellset,
+                            const vtkm::cont::CoordinateSystem& coords,
+                            const vtkm::cont::Field& scalarField,
+                            const vtkm::cont::ColorTable& colorTable,
+                            const std::vector<vtkm::rendering::Camera>& cameras,
+                            const std::vector<vtkm::rendering::Canvas*>& canvases,
+                            const vtkm::Range& scalarRange) override;
+
   void SetCompositeBackground(bool on);
   vtkm::rendering::Mapper* NewCopy() const override;
   void SetShadingOn(bool on);
 
+  /// \brief Renders triangle meshes from decimated copies that match the screen resolution.
+  ///
+  /// Extracting the triangles of a large surface and building a BVH over them can take more
+  /// time and memory than tracing the rays of a frame, even when the surface covers few pixels.
+  /// When enabled, vertices are merged on a grid whose bins are about
+  /// `GetLevelOfDetailPixelSize()` pixels wide where the mesh is nearest to the camera, and
+  /// the surface is traced from the triangles that remain. Decimated copies are kept across
+  /// frames, for each mesh and grid resolution. Meshes that would barely shrink, and views from
+  /// inside the bounds of a mesh, are rendered at full resolution. Off by default.
+  ///
+  void SetLevelOfDetailOn(bool on);
+  bool GetLevelOfDetailOn() const;
+
+  /// \brief The width, in pixels, of the bins vertices are merged in. The default is 1.
+  void SetLevelOfDetailPixelSize(vtkm::Float64 pixelSize);
+  vtkm::Float64 GetLevelOfDetailPixelSize() const;
+
 private:
   struct InternalsType;
   std::shared_ptr<InternalsType> Internals;
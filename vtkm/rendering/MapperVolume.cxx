@@ -75,9 +75,21 @@ vtkm::rendering::Canvas* MapperVolume::GetCanvas() const
 void MapperVolume::RenderCells(const vtkm::cont::UnknownCellSet& cellset,
                                const vtkm::cont::CoordinateSystem& coords,
                                const vtkm::cont::Field& scalarField,
-                               const vtkm::cont::ColorTable& vtkmNotUsed(colorTable),
+                               const vtkm::cont::ColorTable& colorTable,
                                const vtkm::rendering::Camera& camera,
                                const vtkm::Range& scalarRange)
+{
+  this->RenderCellsMultiView(
+    cellset, coords, scalarField, colorTable, { camera }, { this->Internals->Canvas }, scalarRange);
+}
+
+void MapperVolume::RenderCellsMultiView(const vtkm::cont::UnknownCellSet& cellset,
+                                        const vtkm::cont::CoordinateSystem& coords,
+                                        const vtkm::cont::Field& scalarField,
+                                        const vtkm::cont::ColorTable& vtkmNotUsed(colorTable),
+                                        const std::vector<vtkm::rendering::Camera>& cameras,
+                                        const std::vector<vtkm::rendering::Canvas*>& canvases,
+                                        const vtkm::Range& scalarRange)
 {
   if (!cellset.CanConvert<vtkm::cont::CellSetStructured<3>>())
   {
@@ -87,6 +99,10 @@ void MapperVolume::RenderCells(const vtkm::cont::UnknownCellSet& cellset,
     msg << "Type : " << theType << std::endl;
     throw vtkm::cont::ErrorBadValue(msg.str());
   }
+  else if (cameras.size() != canvases.size())
+  {
+    throw vtkm::cont::ErrorBadValue("Need one canvas per camera.");
+  }
   else
   {
     raytracing::Logger* logger = raytracing::Logger::GetInstance();
@@ -100,37 +116,75 @@ void MapperVolume::RenderCells(const vtkm::cont::UnknownCellSet& cellset,
     vtkm::rendering::raytracing::Camera rayCamera;
     vtkm::rendering::raytracing::Ray<vtkm::Float32> rays;
 
-    vtkm::Int32 width = (vtkm::Int32)this->Internals->Canvas->GetWidth();
-    vtkm::Int32 height = (vtkm::Int32)this->Internals->Canvas->GetHeight();
-
-    rayCamera.SetParameters(camera, width, height);
-
-    rayCamera.CreateRays(rays, coords.GetBounds());
-    rays.Buffers.at(0).InitConst(0.f);
-    raytracing::RayOperations::MapCanvasToRays(rays, camera, *this->Internals->Canvas);
-
-
     if (this->Internals->SampleDistance != DEFAULT_SAMPLE_DISTANCE)
     {
       tracer.SetSampleDistance(this->Internals->SampleDistance);
     }
-
     tracer.SetData(
       coords, scalarField, cellset.AsCellSet<vtkm::cont::CellSetStructured<3>>(), scalarRange);
     tracer.SetColorMap(this->ColorMap);
 
-    tracer.Render(rays);
-
-    timer.Start();
-    this->Internals->Canvas->WriteToCanvas(rays, rays.Buffers.at(0).Buffer, camera);
-
-    if (this->Internals->CompositeBackground)
+    // The empty bricks found by the tracer are shared by all the views
+    vtkm::Float64 writeTime = 0.;
+    for (std::size_t view = 0; view < cameras.size(); ++view)
     {
-      this->Internals->Canvas->BlendBackground();
+      this->SetCanvas(canvases[view]);
+      const vtkm::rendering::Camera& camera = cameras[view];
+
+      vtkm::Int32 width = (vtkm::Int32)this->Internals->Canvas->GetWidth();
+      vtkm::Int32 height = (vtkm::Int32)this->Internals->Canvas->GetHeight();
+
+      rayCamera.SetParameters(camera, width, height);
+
+      const bool progressive = this->Internals->Canvas->GetProgressiveRendering();
+      vtkm::Int32 tileSize = static_cast<vtkm::Int32>(this->Internals->Canvas->GetTileSize());
+      const bool tiled = !progressive && tileSize > 0 && tileSize < vtkm::Max(width, height);
+      if (!tiled)
+      {
+        rayCamera.ClearTile();
+        tileSize = vtkm::Max(width, height);
+      }
+
+      for (vtkm::Int32 tileY = 0; tileY < height; tileY += tileSize)
+      {
+        for (vtkm::Int32 tileX = 0; tileX < width; tileX += tileSize)
+        {
+          if (tiled)
+          {
+            rayCamera.SetTile(vtkm::Vec2i_32(tileX, tileY),
+                              vtkm::Vec2i_32(tileX + tileSize, tileY + tileSize));
+          }
+          rayCamera.CreateRays(rays, coords.GetBounds());
+          bool traceRays = rays.NumRays > 0;
+          if (traceRays && progressive)
+          {
+            traceRays = this->Internals->Canvas->SelectProgressiveRays(rays, camera);
+          }
+          if (!traceRays)
+          {
+            continue;
+          }
+
+          rays.Buffers.at(0).InitConst(0.f);
+          raytracing::RayOperations::MapCanvasToRays(rays, camera, *this->Internals->Canvas);
+          tracer.Render(rays);
+
+          timer.Start();
+          this->Internals->Canvas->WriteToCanvas(rays, rays.Buffers.at(0).Buffer, camera);
+          writeTime += timer.GetElapsedTime();
+        }
+      }
+
+      timer.Start();
+      if (this->Internals->CompositeBackground)
+      {
+        this->Internals->Canvas->BlendBackground();
+      }
+      writeTime += timer.GetElapsedTime();
     }
-    vtkm::Float64 time = timer.GetElapsedTime();
-    logger->AddLogData("write_to_canvas", time);
-    time = tot_timer.GetElapsedTime();
+
+    logger->AddLogData("write_to_canvas", writeTime);
+    vtkm::Float64 time = tot_timer.GetElapsedTime();
     logger->CloseLogEntry(time);
   }
 }
@@ -36,6 +36,14 @@ public:
                            const vtkm::rendering::Camera& camera,
                            const vtkm::Range& scalarRange) override;
 
+  void RenderCellsMultiView(const vtkm::cont::UnknownCellSet& cellset,
+                            const vtkm::cont::CoordinateSystem& coords,
+                            const vtkm::cont::Field& scalarField,
+                            const vtkm::cont::ColorTable& colorTable,
+                            const std::vector<vtkm::rendering::Camera>& cameras,
+                            const std::vector<vtkm::rendering::Canvas*>& canvases,
+                            const vtkm::Range& scalarRange) override;
+
   vtkm::rendering::Mapper* NewCopy() const override;
   void SetSampleDistance(const vtkm::Float32 distance);
   void SetCompositeBackground(const bool compositeBackground);
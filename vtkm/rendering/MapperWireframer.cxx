@@ -9,6 +9,7 @@
 //============================================================================
 
 #include <vtkm/cont/Algorithm.h>
+#include <vtkm/cont/ErrorBadValue.h>
 
 #include <vtkm/exec/CellEdge.h>
 #include <vtkm/filter/entity_extraction/ExternalFaces.h>
@@ -181,6 +182,8 @@ struct MapperWireframer::InternalsType
     , ShowInternalZones(showInternalZones)
     , IsOverlay(isOverlay)
     , CompositeBackground(true)
+    , UseTiledRasterizer(false)
+    , RasterizerTileSize(32)
   {
   }
 
@@ -188,6 +191,8 @@ struct MapperWireframer::InternalsType
   bool ShowInternalZones;
   bool IsOverlay;
   bool CompositeBackground;
+  bool UseTiledRasterizer;
+  vtkm::Id RasterizerTileSize;
 }; // struct MapperWireframer::InternalsType
 
 MapperWireframer::MapperWireframer()
@@ -227,6 +232,30 @@ void MapperWireframer::SetIsOverlay(bool isOverlay)
   this->Internals->IsOverlay = isOverlay;
 }
 
+bool MapperWireframer::GetUseTiledRasterizer() const
+{
+  return this->Internals->UseTiledRasterizer;
+}
+
+void MapperWireframer::SetUseTiledRasterizer(bool on)
+{
+  this->Internals->UseTiledRasterizer = on;
+}
+
+vtkm::Id MapperWireframer::GetRasterizerTileSize() const
+{
+  return this->Internals->RasterizerTileSize;
+}
+
+void MapperWireframer::SetRasterizerTileSize(vtkm::Id tileSize)
+{
+  if (tileSize < 1)
+  {
+    throw vtkm::cont::ErrorBadValue("Rasterizer tile size must be at least 1.");
+  }
+  this->Internals->RasterizerTileSize = tileSize;
+}
+
 void MapperWireframer::RenderCells(const vtkm::cont::UnknownCellSet& inCellSet,
                                    const vtkm::cont::CoordinateSystem& coords,
                                    const vtkm::cont::Field& inScalarField,
@@ -341,6 +370,10 @@ void MapperWireframer::RenderCells(const vtkm::cont::UnknownCellSet& inCellSet,
 
   renderer.SetCamera(camera);
   renderer.SetColorMap(this->ColorMap);
+  if (this->Internals->UseTiledRasterizer)
+  {
+    renderer.SetTileSize(this->Internals->RasterizerTileSize);
+  }
   renderer.SetData(actualCoords, edgeIndices, actualField, scalarRange);
   renderer.Render();
 
@@ -42,6 +42,23 @@ public:
   bool GetIsOverlay() const;
   void SetIsOverlay(bool isOverlay);
 
+  /// \brief Draws the edges one screen tile at a time.
+  ///
+  /// By default, all edges are drawn concurrently and resolve the pixels they share with atomic
+  /// depth tests, which contend when many edges cover few pixels. When enabled, the edges are
+  /// first binned to the screen tiles they cross, and each tile is then drawn by a single thread
+  /// without atomics. The image is the same either way, except that it no longer depends on the
+  /// order threads happen to run in. Scenes with more tiles times edges than a vtkm::Id can
+  /// count are drawn with atomics regardless. Off by default.
+  ///
+  bool GetUseTiledRasterizer() const;
+  void SetUseTiledRasterizer(bool on);
+
+  /// \brief The width and height, in pixels, of the tiles of the tiled rasterizer. The default is
+  /// 32.
+  vtkm::Id GetRasterizerTileSize() const;
+  void SetRasterizerTileSize(vtkm::Id tileSize);
+
   virtual void RenderCells(const vtkm::cont::UnknownCellSet& cellset,
                            const vtkm::cont::CoordinateSystem& coords,
                            const vtkm::cont::Field& scalarField,
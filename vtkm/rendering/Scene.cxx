@@ -53,6 +53,17 @@ void Scene::Render(vtkm::rendering::Mapper& mapper,
   }
 }
 
+void Scene::Render(vtkm::rendering::Mapper& mapper,
+                   const std::vector<vtkm::rendering::Canvas*>& canvases,
+                   const std::vector<vtkm::rendering::Camera>& cameras) const
+{
+  for (vtkm::IdComponent actorIndex = 0; actorIndex < this->GetNumberOfActors(); actorIndex++)
+  {
+    const vtkm::rendering::Actor& actor = this->GetActor(actorIndex);
+    actor.Render(mapper, canvases, cameras);
+  }
+}
+
 vtkm::Bounds Scene::GetSpatialBounds() const
 {
   vtkm::Bounds bounds;
@@ -18,6 +18,7 @@
 #include <vtkm/rendering/Mapper.h>
 
 #include <memory>
+#include <vector>
 
 namespace vtkm
 {
@@ -39,6 +40,18 @@ public:
               vtkm::rendering::Canvas& canvas,
               const vtkm::rendering::Camera& camera) const;
 
+  /// \brief Renders the scene from each camera into the canvas of the same index.
+  ///
+  /// The images are the same as rendering the scene once for each camera and canvas, but each
+  /// actor is handed all the views at once (see `Mapper::RenderCellsMultiView`). Mappers thus
+  /// prepare the geometry of an actor, such as its ray tracing acceleration structure, once
+  /// for all the views. This suits image databases, where a scene is rendered from many
+  /// cameras. The canvases are not cleared.
+  ///
+  void Render(vtkm::rendering::Mapper& mapper,
+              const std::vector<vtkm::rendering::Canvas*>& canvases,
+              const std::vector<vtkm::rendering::Camera>& cameras) const;
+
   vtkm::Bounds GetSpatialBounds() const;
 
 private:
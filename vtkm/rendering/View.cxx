@@ -218,6 +218,36 @@ void View::RenderAnnotations()
   }
 }
 
+void View::RenderAnnotations(vtkm::rendering::Canvas& canvas,
+                             const vtkm::rendering::Camera& camera)
+{
+  // Annotations draw into the canvas of the view, from its camera. Lend them the ones given
+  // while they render.
+  vtkm::rendering::Canvas* viewCanvas = this->Internal->CanvasPointer;
+  vtkm::rendering::WorldAnnotator* viewWorldAnnotator = this->Internal->WorldAnnotatorPointer;
+  const vtkm::rendering::Camera viewCamera = this->Internal->Camera;
+  std::unique_ptr<vtkm::rendering::WorldAnnotator> worldAnnotator(canvas.CreateWorldAnnotator());
+  auto restore = [&]() {
+    this->Internal->CanvasPointer = viewCanvas;
+    this->Internal->WorldAnnotatorPointer = viewWorldAnnotator;
+    this->Internal->Camera = viewCamera;
+  };
+
+  this->Internal->CanvasPointer = &canvas;
+  this->Internal->WorldAnnotatorPointer = worldAnnotator.get();
+  this->Internal->Camera = camera;
+  try
+  {
+    this->RenderAnnotations();
+  }
+  catch (...)
+  {
+    restore();
+    throw;
+  }
+  restore();
+}
+
 void View::SetupForWorldSpace(bool viewportClip)
 {
   this->GetCanvas().SetViewToWorldSpace(this->Internal->Camera, viewportClip);
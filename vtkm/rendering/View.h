@@ -129,6 +129,9 @@ protected:
 
   void SetupForScreenSpace(bool viewportClip = false);
 
+  // Renders the annotations of the view into another canvas, seen from another camera.
+  void RenderAnnotations(vtkm::rendering::Canvas& canvas, const vtkm::rendering::Camera& camera);
+
 
   vtkm::rendering::Color AxisColor = vtkm::rendering::Color::white;
   bool WorldAnnotationsEnabled = true;
@@ -10,6 +10,8 @@
 
 #include <vtkm/rendering/View3D.h>
 
+#include <vtkm/cont/ErrorBadValue.h>
+
 namespace vtkm
 {
 namespace rendering
@@ -43,6 +45,24 @@ void View3D::Paint()
   this->GetScene().Render(this->GetMapper(), this->GetCanvas(), this->GetCamera());
 }
 
+void View3D::Paint(const std::vector<vtkm::rendering::Camera>& cameras,
+                   const std::vector<vtkm::rendering::Canvas*>& canvases)
+{
+  if (cameras.size() != canvases.size())
+  {
+    throw vtkm::cont::ErrorBadValue("Need one canvas per camera.");
+  }
+  for (std::size_t view = 0; view < cameras.size(); ++view)
+  {
+    vtkm::rendering::Canvas& canvas = *canvases[view];
+    canvas.SetBackgroundColor(this->GetCanvas().GetBackgroundColor());
+    canvas.SetForegroundColor(this->GetCanvas().GetForegroundColor());
+    canvas.Clear();
+    this->RenderAnnotations(canvas, cameras[view]);
+  }
+  this->GetScene().Render(this->GetMapper(), canvases, cameras);
+}
+
 void View3D::RenderScreenAnnotations()
 {
   if (this->GetScene().GetNumberOfActors() > 0)
@@ -41,6 +41,16 @@ public:
 
   void Paint() override;
 
+  /// \brief Paints the view from each camera into the canvas of the same index.
+  ///
+  /// Each canvas is cleared to the colors of the view's canvas and receives the annotations of
+  /// the view, as `Paint` would. The scene is then rendered for all the views at once, which
+  /// lets mappers prepare the geometry of each actor once (see `Scene::Render`). The canvases
+  /// must be of a type the mapper accepts.
+  ///
+  void Paint(const std::vector<vtkm::rendering::Camera>& cameras,
+             const std::vector<vtkm::rendering::Canvas*>& canvases);
+
   void RenderScreenAnnotations() override;
 
   void RenderWorldAnnotations() override;
@@ -16,13 +16,18 @@
 #include <vtkm/Swap.h>
 #include <vtkm/Types.h>
 #include <vtkm/VectorAnalysis.h>
+#include <vtkm/cont/Algorithm.h>
 #include <vtkm/cont/ArrayHandle.h>
+#include <vtkm/cont/ArrayHandleCounting.h>
+#include <vtkm/cont/ArrayHandleView.h>
 #include <vtkm/cont/AtomicArray.h>
 #include <vtkm/rendering/MatrixHelpers.h>
 #include <vtkm/rendering/Triangulator.h>
 #include <vtkm/worklet/DispatcherMapField.h>
 #include <vtkm/worklet/WorkletMapField.h>
 
+#include <limits>
+
 namespace vtkm
 {
 namespace rendering
@@ -143,31 +148,42 @@ struct CopyIntoFrameBuffer : public vtkm::worklet::WorkletMapField
   }
 }; //struct CopyIntoFrameBuffer
 
+// An edge projected to the viewport and set up to be walked one pixel at a time along its major
+// axis. Steep edges are transposed, so that x is always the major axis.
+struct ScreenEdge
+{
+  vtkm::Float32 X1;
+  vtkm::Float32 Z1;
+  vtkm::Float32 Z2;
+  vtkm::Float32 Dx;
+  vtkm::Float32 Gradient;
+  bool Transposed;
+  // The pixels of the end points and the line height at each.
+  vtkm::Float32 XPxl1;
+  vtkm::Float32 YEnd1;
+  vtkm::Float32 XPxl2;
+  vtkm::Float32 YEnd2;
+};
+
+// Draws edges with Xiaolin Wu's algorithm. The pixels covered are passed to a plot functor,
+// which decides how they are written to the frame buffer.
 template <typename DeviceTag>
-class EdgePlotter : public vtkm::worklet::WorkletMapField
+class EdgeRasterizer
 {
 public:
-  using AtomicPackedFrameBufferHandle = vtkm::exec::AtomicArrayExecutionObject<vtkm::Int64>;
-  using AtomicPackedFrameBuffer = vtkm::cont::AtomicArray<vtkm::Int64>;
-
-  using ControlSignature = void(FieldIn, WholeArrayIn, WholeArrayIn);
-  using ExecutionSignature = void(_1, _2, _3);
-  using InputDomain = _1;
-
   VTKM_CONT
-  EdgePlotter(const vtkm::Matrix<vtkm::Float32, 4, 4>& worldToProjection,
-              vtkm::Id width,
-              vtkm::Id height,
-              vtkm::Id subsetWidth,
-              vtkm::Id subsetHeight,
-              vtkm::Id xOffset,
-              vtkm::Id yOffset,
-              bool assocPoints,
-              const vtkm::Range& fieldRange,
-              const ColorMapHandle& colorMap,
-              const AtomicPackedFrameBuffer& frameBuffer,
-              const vtkm::Range& clippingRange,
-              vtkm::cont::Token& token)
+  EdgeRasterizer(const vtkm::Matrix<vtkm::Float32, 4, 4>& worldToProjection,
+                 vtkm::Id width,
+                 vtkm::Id height,
+                 vtkm::Id subsetWidth,
+                 vtkm::Id subsetHeight,
+                 vtkm::Id xOffset,
+                 vtkm::Id yOffset,
+                 bool assocPoints,
+                 const vtkm::Range& fieldRange,
+                 const ColorMapHandle& colorMap,
+                 const vtkm::Range& clippingRange,
+                 vtkm::cont::Token& token)
     : WorldToProjection(worldToProjection)
     , Width(width)
     , Height(height)
@@ -178,7 +194,6 @@ public:
     , AssocPoints(assocPoints)
     , ColorMap(colorMap.PrepareForInput(DeviceTag(), token))
     , ColorMapSize(vtkm::Float32(colorMap.GetNumberOfValues() - 1))
-    , FrameBuffer(frameBuffer.PrepareForExecution(DeviceTag(), token))
     , FieldMin(vtkm::Float32(fieldRange.Min))
   {
     vtkm::Float32 fieldLength = vtkm::Float32(fieldRange.Length());
@@ -194,14 +209,14 @@ public:
     this->Offset = vtkm::Max(0.03f / vtkm::Float32(clippingRange.Length()), 0.0001f);
   }
 
-  template <typename CoordinatesPortalType, typename ScalarFieldPortalType>
-  VTKM_EXEC void operator()(const vtkm::Id2& edgeIndices,
-                            const CoordinatesPortalType& coordsPortal,
-                            const ScalarFieldPortalType& fieldPortal) const
-  {
-    vtkm::Id point1Idx = edgeIndices[0];
-    vtkm::Id point2Idx = edgeIndices[1];
+  VTKM_EXEC_CONT vtkm::Id GetWidth() const { return this->Width; }
+  VTKM_EXEC_CONT vtkm::Id GetHeight() const { return this->Height; }
 
+  template <typename CoordinatesPortalType>
+  VTKM_EXEC void Setup(const vtkm::Id2& edgeIndices,
+                       const CoordinatesPortalType& coordsPortal,
+                       ScreenEdge& edge) const
+  {
     vtkm::Vec3f_32 point1 = coordsPortal.Get(edgeIndices[0]);
     vtkm::Vec3f_32 point2 = coordsPortal.Get(edgeIndices[1]);
 
@@ -234,12 +249,41 @@ public:
 
     vtkm::Float32 dx = x2 - x1;
     vtkm::Float32 dy = y2 - y1;
-    vtkm::Float32 gradient = (dx == 0.0) ? 1.0f : (dy / dx);
+    edge.X1 = x1;
+    edge.Z1 = z1;
+    edge.Z2 = z2;
+    edge.Dx = dx;
+    edge.Gradient = (dx == 0.0) ? 1.0f : (dy / dx);
+    edge.Transposed = transposed;
+
+    edge.XPxl1 = vtkm::Round(x1);
+    edge.YEnd1 = y1 + edge.Gradient * (edge.XPxl1 - x1);
+    edge.XPxl2 = vtkm::Round(x2);
+    edge.YEnd2 = y2 + edge.Gradient * (edge.XPxl2 - x2);
+  }
+
+  // Plots the pixels of an edge within the rectangle from `clipMin` to `clipMax`, inclusive.
+  // Pixels outside of it may be plotted as well.
+  template <typename CoordinatesPortalType, typename ScalarFieldPortalType, typename PlotType>
+  VTKM_EXEC void Rasterize(const vtkm::Id2& edgeIndices,
+                           const CoordinatesPortalType& coordsPortal,
+                           const ScalarFieldPortalType& fieldPortal,
+                           const vtkm::Id2& clipMin,
+                           const vtkm::Id2& clipMax,
+                           const PlotType& plot) const
+  {
+    vtkm::Id point1Idx = edgeIndices[0];
+    vtkm::Id point2Idx = edgeIndices[1];
 
-    vtkm::Float32 xEnd = vtkm::Round(x1);
-    vtkm::Float32 yEnd = y1 + gradient * (xEnd - x1);
-    vtkm::Float32 xPxl1 = xEnd, yPxl1 = IntegerPart(yEnd);
-    vtkm::Float32 zPxl1 = vtkm::Lerp(z1, z2, (xPxl1 - x1) / dx);
+    ScreenEdge edge;
+    this->Setup(edgeIndices, coordsPortal, edge);
+    const vtkm::Float32 x1 = edge.X1;
+    const vtkm::Float32 dx = edge.Dx;
+    const vtkm::Float32 gradient = edge.Gradient;
+    const bool transposed = edge.Transposed;
+
+    vtkm::Float32 xPxl1 = edge.XPxl1, yPxl1 = IntegerPart(edge.YEnd1);
+    vtkm::Float32 zPxl1 = vtkm::Lerp(edge.Z1, edge.Z2, (xPxl1 - x1) / dx);
     vtkm::Float64 point1Field = fieldPortal.Get(point1Idx);
     vtkm::Float64 point2Field;
     if (AssocPoints)
@@ -256,57 +300,102 @@ public:
     vtkm::Vec4f_32 color = GetColor(point1Field);
     if (transposed)
     {
-      Plot(yPxl1, xPxl1, zPxl1, color, 1.0f);
+      plot(yPxl1, xPxl1, zPxl1, color, 1.0f);
     }
     else
     {
-      Plot(xPxl1, yPxl1, zPxl1, color, 1.0f);
+      plot(xPxl1, yPxl1, zPxl1, color, 1.0f);
     }
 
-    vtkm::Float32 interY = yEnd + gradient;
-    xEnd = vtkm::Round(x2);
-    yEnd = y2 + gradient * (xEnd - x2);
-    vtkm::Float32 xPxl2 = xEnd, yPxl2 = IntegerPart(yEnd);
-    vtkm::Float32 zPxl2 = vtkm::Lerp(z1, z2, (xPxl2 - x1) / dx);
+    vtkm::Float32 xPxl2 = edge.XPxl2, yPxl2 = IntegerPart(edge.YEnd2);
+    vtkm::Float32 zPxl2 = vtkm::Lerp(edge.Z1, edge.Z2, (xPxl2 - x1) / dx);
 
     // Plot second endpoint
     color = GetColor(point2Field);
     if (transposed)
     {
-      Plot(yPxl2, xPxl2, zPxl2, color, 1.0f);
+      plot(yPxl2, xPxl2, zPxl2, color, 1.0f);
     }
     else
     {
-      Plot(xPxl2, yPxl2, zPxl2, color, 1.0f);
+      plot(xPxl2, yPxl2, zPxl2, color, 1.0f);
     }
 
-    // Plot rest of the line
-    if (transposed)
+    // Plot rest of the line, skipping the pixels before the clip rectangle. The line height is
+    // computed from the first end point at every pixel rather than accumulated, so that every
+    // clip rectangle sees the very same line and long edges cost only their visible pixels.
+    const vtkm::Float32 majorMin = vtkm::Float32(transposed ? clipMin[1] : clipMin[0]);
+    const vtkm::Float32 majorMax = vtkm::Float32(transposed ? clipMax[1] : clipMax[0]);
+    const vtkm::Float32 xStart = vtkm::Max(xPxl1 + 1, majorMin);
+    const vtkm::Float32 xEnd = vtkm::Min(xPxl2 - 1, majorMax);
+    for (vtkm::Float32 x = xStart; x <= xEnd; ++x)
     {
-      for (vtkm::Float32 x = xPxl1 + 1; x <= xPxl2 - 1; ++x)
+      vtkm::Float32 interY = edge.YEnd1 + gradient * (x - xPxl1);
+      vtkm::Float32 t = IntegerPart(interY);
+      vtkm::Float32 factor = (x - x1) / dx;
+      vtkm::Float32 depth = vtkm::Lerp(zPxl1, zPxl2, factor);
+      vtkm::Float64 fieldValue = vtkm::Lerp(point1Field, point2Field, factor);
+      color = GetColor(fieldValue);
+      if (transposed)
+      {
+        plot(t, x, depth, color, ReverseFractionalPart(interY));
+        plot(t + 1, x, depth, color, FractionalPart(interY));
+      }
+      else
       {
-        vtkm::Float32 t = IntegerPart(interY);
-        vtkm::Float32 factor = (x - x1) / dx;
-        vtkm::Float32 depth = vtkm::Lerp(zPxl1, zPxl2, factor);
-        vtkm::Float64 fieldValue = vtkm::Lerp(point1Field, point2Field, factor);
-        color = GetColor(fieldValue);
-        Plot(t, x, depth, color, ReverseFractionalPart(interY));
-        Plot(t + 1, x, depth, color, FractionalPart(interY));
-        interY += gradient;
+        plot(x, t, depth, color, ReverseFractionalPart(interY));
+        plot(x, t + 1, depth, color, FractionalPart(interY));
       }
     }
-    else
+  }
+
+  // Calls `visit(tileX, tileY)` for every tile of `tileSize` pixels that the edge may plot pixels
+  // in. Tiles are only visited once.
+  template <typename VisitType>
+  VTKM_EXEC void ForEachTile(const ScreenEdge& edge, vtkm::Id tileSize, VisitType& visit) const
+  {
+    if (!vtkm::IsFinite(edge.XPxl1) || !vtkm::IsFinite(edge.XPxl2) ||
+        !vtkm::IsFinite(edge.YEnd1) || !vtkm::IsFinite(edge.YEnd2))
+    {
+      return;
+    }
+    const vtkm::Float32 majorSize = vtkm::Float32(edge.Transposed ? this->Height : this->Width);
+    const vtkm::Float32 minorSize = vtkm::Float32(edge.Transposed ? this->Width : this->Height);
+    const vtkm::Float32 size = vtkm::Float32(tileSize);
+    const vtkm::Float32 majorLow = vtkm::Max(edge.XPxl1, 0.f);
+    const vtkm::Float32 majorHigh = vtkm::Min(edge.XPxl2, majorSize - 1.f);
+    if (majorLow > majorHigh)
+    {
+      return;
+    }
+    for (vtkm::Id tileMajor = vtkm::Id(majorLow / size); tileMajor <= vtkm::Id(majorHigh / size);
+         ++tileMajor)
     {
-      for (vtkm::Float32 x = xPxl1 + 1; x <= xPxl2 - 1; ++x)
+      // The pixels plotted in this column of tiles are within a pixel of the line. Allow for more,
+      // to cover rounding in the line height.
+      const vtkm::Float32 low = vtkm::Max(majorLow, vtkm::Float32(tileMajor) * size);
+      const vtkm::Float32 high = vtkm::Min(majorHigh, vtkm::Float32(tileMajor + 1) * size - 1.f);
+      const vtkm::Float32 yLow = edge.YEnd1 + edge.Gradient * (low - edge.XPxl1);
+      const vtkm::Float32 yHigh = edge.YEnd1 + edge.Gradient * (high - edge.XPxl1);
+      const vtkm::Float32 minorLow = vtkm::Max(vtkm::Floor(vtkm::Min(yLow, yHigh)) - 2.f, 0.f);
+      const vtkm::Float32 minorHigh =
+        vtkm::Min(vtkm::Floor(vtkm::Max(yLow, yHigh)) + 3.f, minorSize - 1.f);
+      if (minorLow > minorHigh)
+      {
+        continue;
+      }
+      for (vtkm::Id tileMinor = vtkm::Id(minorLow / size);
+           tileMinor <= vtkm::Id(minorHigh / size);
+           ++tileMinor)
       {
-        vtkm::Float32 t = IntegerPart(interY);
-        vtkm::Float32 factor = (x - x1) / dx;
-        vtkm::Float32 depth = vtkm::Lerp(zPxl1, zPxl2, factor);
-        vtkm::Float64 fieldValue = vtkm::Lerp(point1Field, point2Field, factor);
-        color = GetColor(fieldValue);
-        Plot(x, t, depth, color, ReverseFractionalPart(interY));
-        Plot(x, t + 1, depth, color, FractionalPart(interY));
-        interY += gradient;
+        if (edge.Transposed)
+        {
+          visit(tileMinor, tileMajor);
+        }
+        else
+        {
+          visit(tileMajor, tileMinor);
+        }
       }
     }
   }
@@ -343,12 +432,54 @@ private:
     return this->ColorMap.Get(colorIdx);
   }
 
+  vtkm::Matrix<vtkm::Float32, 4, 4> WorldToProjection;
+  vtkm::Id Width;
+  vtkm::Id Height;
+  vtkm::Id SubsetWidth;
+  vtkm::Id SubsetHeight;
+  vtkm::Id XOffset;
+  vtkm::Id YOffset;
+  bool AssocPoints;
+  ColorMapPortalConst ColorMap;
+  vtkm::Float32 ColorMapSize;
+  vtkm::Float32 FieldMin;
+  vtkm::Float32 InverseFieldDelta;
+  vtkm::Float32 Offset;
+};
+
+// Blends a pixel of an edge over the packed frame buffer value `current`.
+VTKM_EXEC_CONT
+vtkm::UInt32 BlendEdgeColor(const PackedValue& current,
+                            const vtkm::Vec4f_32& color,
+                            vtkm::Float32 intensity)
+{
+  vtkm::Vec4f_32 blendedColor;
+  vtkm::Vec4f_32 srcColor;
+  UnpackColor(current.Ints.Color, srcColor);
+  vtkm::Float32 inverseIntensity = (1.0f - intensity);
+  vtkm::Float32 alpha = srcColor[3] * inverseIntensity;
+  blendedColor[0] = color[0] * intensity + srcColor[0] * alpha;
+  blendedColor[1] = color[1] * intensity + srcColor[1] * alpha;
+  blendedColor[2] = color[2] * intensity + srcColor[2] * alpha;
+  blendedColor[3] = alpha + intensity;
+  return PackColor(blendedColor);
+}
+
+// Writes pixels of edges drawn concurrently anywhere on the screen, using a compare-and-swap
+// loop on the packed depth and color.
+template <typename FrameBufferPortalType>
+struct AtomicEdgePlot
+{
+  FrameBufferPortalType FrameBuffer;
+  vtkm::Id Width;
+  vtkm::Id Height;
+
   VTKM_EXEC
-  void Plot(vtkm::Float32 x,
-            vtkm::Float32 y,
-            vtkm::Float32 depth,
-            const vtkm::Vec4f_32& color,
-            vtkm::Float32 intensity) const
+  void operator()(vtkm::Float32 x,
+                  vtkm::Float32 y,
+                  vtkm::Float32 depth,
+                  const vtkm::Vec4f_32& color,
+                  vtkm::Float32 intensity) const
   {
     vtkm::Id xi = static_cast<vtkm::Id>(x), yi = static_cast<vtkm::Id>(y);
     if (xi < 0 || xi >= Width || yi < 0 || yi >= Height)
@@ -359,36 +490,243 @@ private:
     PackedValue current, next;
     current.Raw = ClearValue;
     next.Floats.Depth = depth;
-    vtkm::Vec4f_32 blendedColor;
-    vtkm::Vec4f_32 srcColor;
     do
     {
-      UnpackColor(current.Ints.Color, srcColor);
-      vtkm::Float32 inverseIntensity = (1.0f - intensity);
-      vtkm::Float32 alpha = srcColor[3] * inverseIntensity;
-      blendedColor[0] = color[0] * intensity + srcColor[0] * alpha;
-      blendedColor[1] = color[1] * intensity + srcColor[1] * alpha;
-      blendedColor[2] = color[2] * intensity + srcColor[2] * alpha;
-      blendedColor[3] = alpha + intensity;
-      next.Ints.Color = PackColor(blendedColor);
+      next.Ints.Color = BlendEdgeColor(current, color, intensity);
       FrameBuffer.CompareExchange(index, &current.Raw, next.Raw);
     } while (current.Floats.Depth > next.Floats.Depth);
   }
+};
 
-  vtkm::Matrix<vtkm::Float32, 4, 4> WorldToProjection;
+template <typename DeviceTag>
+class EdgePlotter : public vtkm::worklet::WorkletMapField
+{
+public:
+  using AtomicPackedFrameBufferHandle = vtkm::exec::AtomicArrayExecutionObject<vtkm::Int64>;
+  using AtomicPackedFrameBuffer = vtkm::cont::AtomicArray<vtkm::Int64>;
+
+  using ControlSignature = void(FieldIn, WholeArrayIn, WholeArrayIn);
+  using ExecutionSignature = void(_1, _2, _3);
+  using InputDomain = _1;
+
+  VTKM_CONT
+  EdgePlotter(const EdgeRasterizer<DeviceTag>& rasterizer,
+              const AtomicPackedFrameBuffer& frameBuffer,
+              vtkm::cont::Token& token)
+    : Rasterizer(rasterizer)
+    , Plot{ frameBuffer.PrepareForExecution(DeviceTag(), token),
+            rasterizer.GetWidth(),
+            rasterizer.GetHeight() }
+  {
+  }
+
+  template <typename CoordinatesPortalType, typename ScalarFieldPortalType>
+  VTKM_EXEC void operator()(const vtkm::Id2& edgeIndices,
+                            const CoordinatesPortalType& coordsPortal,
+                            const ScalarFieldPortalType& fieldPortal) const
+  {
+    this->Rasterizer.Rasterize(edgeIndices,
+                               coordsPortal,
+                               fieldPortal,
+                               vtkm::Id2(0, 0),
+                               vtkm::Id2(this->Plot.Width - 1, this->Plot.Height - 1),
+                               this->Plot);
+  }
+
+private:
+  EdgeRasterizer<DeviceTag> Rasterizer;
+  AtomicEdgePlot<AtomicPackedFrameBufferHandle> Plot;
+};
+
+// Counts the screen tiles each edge is binned to.
+template <typename DeviceTag>
+class EdgeTileCounter : public vtkm::worklet::WorkletMapField
+{
+public:
+  using ControlSignature = void(FieldIn, WholeArrayIn, FieldOut);
+  using ExecutionSignature = void(_1, _2, _3);
+
+  VTKM_CONT
+  EdgeTileCounter(const EdgeRasterizer<DeviceTag>& rasterizer, vtkm::Id tileSize)
+    : Rasterizer(rasterizer)
+    , TileSize(tileSize)
+  {
+  }
+
+  struct CountTiles
+  {
+    vtkm::Id Count;
+    VTKM_EXEC void operator()(vtkm::Id, vtkm::Id) { ++this->Count; }
+  };
+
+  template <typename CoordinatesPortalType>
+  VTKM_EXEC void operator()(const vtkm::Id2& edgeIndices,
+                            const CoordinatesPortalType& coordsPortal,
+                            vtkm::Id& count) const
+  {
+    ScreenEdge edge;
+    this->Rasterizer.Setup(edgeIndices, coordsPortal, edge);
+    CountTiles counter{ 0 };
+    this->Rasterizer.ForEachTile(edge, this->TileSize, counter);
+    count = counter.Count;
+  }
+
+private:
+  EdgeRasterizer<DeviceTag> Rasterizer;
+  vtkm::Id TileSize;
+};
+
+// Writes a key for every tile an edge is binned to. Keys are `tile * numberOfEdges + edge`, so
+// that sorting them groups the edges by tile and keeps them in order within a tile.
+template <typename DeviceTag>
+class EdgeBinner : public vtkm::worklet::WorkletMapField
+{
+public:
+  using ControlSignature = void(FieldIn, FieldIn, WholeArrayIn, WholeArrayOut);
+  using ExecutionSignature = void(_1, _2, _3, _4, WorkIndex);
+
+  VTKM_CONT
+  EdgeBinner(const EdgeRasterizer<DeviceTag>& rasterizer,
+             vtkm::Id tileSize,
+             vtkm::Id tilesX,
+             vtkm::Id numberOfEdges)
+    : Rasterizer(rasterizer)
+    , TileSize(tileSize)
+    , TilesX(tilesX)
+    , NumberOfEdges(numberOfEdges)
+  {
+  }
+
+  template <typename KeysPortalType>
+  struct WriteKeys
+  {
+    KeysPortalType& Keys;
+    vtkm::Id Offset;
+    vtkm::Id TilesX;
+    vtkm::Id NumberOfEdges;
+    vtkm::Id EdgeIndex;
+
+    VTKM_EXEC void operator()(vtkm::Id tileX, vtkm::Id tileY)
+    {
+      this->Keys.Set(this->Offset++,
+                     (tileY * this->TilesX + tileX) * this->NumberOfEdges + this->EdgeIndex);
+    }
+  };
+
+  template <typename CoordinatesPortalType, typename KeysPortalType>
+  VTKM_EXEC void operator()(const vtkm::Id2& edgeIndices,
+                            const vtkm::Id& offset,
+                            const CoordinatesPortalType& coordsPortal,
+                            KeysPortalType& keys,
+                            const vtkm::Id& edgeIndex) const
+  {
+    ScreenEdge edge;
+    this->Rasterizer.Setup(edgeIndices, coordsPortal, edge);
+    WriteKeys<KeysPortalType> writer{ keys, offset, this->TilesX, this->NumberOfEdges, edgeIndex };
+    this->Rasterizer.ForEachTile(edge, this->TileSize, writer);
+  }
+
+private:
+  EdgeRasterizer<DeviceTag> Rasterizer;
+  vtkm::Id TileSize;
+  vtkm::Id TilesX;
+  vtkm::Id NumberOfEdges;
+};
+
+// Writes pixels of edges within a tile that no other thread writes to.
+template <typename FrameBufferPortalType>
+struct TileEdgePlot
+{
+  FrameBufferPortalType& FrameBuffer;
   vtkm::Id Width;
-  vtkm::Id Height;
-  vtkm::Id SubsetWidth;
-  vtkm::Id SubsetHeight;
-  vtkm::Id XOffset;
-  vtkm::Id YOffset;
-  bool AssocPoints;
-  ColorMapPortalConst ColorMap;
-  vtkm::Float32 ColorMapSize;
-  AtomicPackedFrameBufferHandle FrameBuffer;
-  vtkm::Float32 FieldMin;
-  vtkm::Float32 InverseFieldDelta;
-  vtkm::Float32 Offset;
+  vtkm::Id2 Min;
+  vtkm::Id2 Max;
+
+  VTKM_EXEC
+  void operator()(vtkm::Float32 x,
+                  vtkm::Float32 y,
+                  vtkm::Float32 depth,
+                  const vtkm::Vec4f_32& color,
+                  vtkm::Float32 intensity) const
+  {
+    vtkm::Id xi = static_cast<vtkm::Id>(x), yi = static_cast<vtkm::Id>(y);
+    if (xi < Min[0] || xi > Max[0] || yi < Min[1] || yi > Max[1])
+    {
+      return;
+    }
+    vtkm::Id index = yi * Width + xi;
+    PackedValue current, next;
+    current.Raw = FrameBuffer.Get(index);
+    // Same outcome as the compare-and-swap loop of AtomicEdgePlot.
+    if (current.Raw == ClearValue || current.Floats.Depth > depth)
+    {
+      next.Floats.Depth = depth;
+      next.Ints.Color = BlendEdgeColor(current, color, intensity);
+      FrameBuffer.Set(index, next.Raw);
+    }
+  }
+};
+
+// Draws the edges binned to a tile, in order, on a single thread.
+template <typename DeviceTag>
+class TileRasterizer : public vtkm::worklet::WorkletMapField
+{
+public:
+  using ControlSignature = void(FieldIn,
+                                FieldIn,
+                                WholeArrayIn,
+                                WholeArrayIn,
+                                WholeArrayIn,
+                                WholeArrayIn,
+                                WholeArrayInOut);
+  using ExecutionSignature = void(_1, _2, _3, _4, _5, _6, _7, WorkIndex);
+
+  VTKM_CONT
+  TileRasterizer(const EdgeRasterizer<DeviceTag>& rasterizer,
+                 vtkm::Id tileSize,
+                 vtkm::Id tilesX,
+                 vtkm::Id numberOfEdges)
+    : Rasterizer(rasterizer)
+    , TileSize(tileSize)
+    , TilesX(tilesX)
+    , NumberOfEdges(numberOfEdges)
+  {
+  }
+
+  template <typename KeysPortalType,
+            typename EdgesPortalType,
+            typename CoordinatesPortalType,
+            typename ScalarFieldPortalType,
+            typename FrameBufferPortalType>
+  VTKM_EXEC void operator()(const vtkm::Id& binStart,
+                            const vtkm::Id& binEnd,
+                            const KeysPortalType& keys,
+                            const EdgesPortalType& edges,
+                            const CoordinatesPortalType& coordsPortal,
+                            const ScalarFieldPortalType& fieldPortal,
+                            FrameBufferPortalType& frameBuffer,
+                            const vtkm::Id& tile) const
+  {
+    const vtkm::Id width = this->Rasterizer.GetWidth();
+    const vtkm::Id height = this->Rasterizer.GetHeight();
+    const vtkm::Id2 tileMin((tile % this->TilesX) * this->TileSize,
+                            (tile / this->TilesX) * this->TileSize);
+    const vtkm::Id2 tileMax(vtkm::Min(tileMin[0] + this->TileSize, width) - 1,
+                            vtkm::Min(tileMin[1] + this->TileSize, height) - 1);
+    TileEdgePlot<FrameBufferPortalType> plot{ frameBuffer, width, tileMin, tileMax };
+    for (vtkm::Id i = binStart; i < binEnd; ++i)
+    {
+      const vtkm::Id edgeIndex = keys.Get(i) - tile * this->NumberOfEdges;
+      this->Rasterizer.Rasterize(
+        edges.Get(edgeIndex), coordsPortal, fieldPortal, tileMin, tileMax, plot);
+    }
+  }
+
+private:
+  EdgeRasterizer<DeviceTag> Rasterizer;
+  vtkm::Id TileSize;
+  vtkm::Id TilesX;
+  vtkm::Id NumberOfEdges;
 };
 
 struct BufferConverter : public vtkm::worklet::WorkletMapField
@@ -457,6 +795,12 @@ public:
     this->ScalarFieldRange = fieldRange;
   }
 
+  /// \brief Draws the edges one screen tile of `tileSize` pixels at a time.
+  ///
+  /// 0, the default, draws all edges concurrently with atomic depth tests instead.
+  VTKM_CONT
+  void SetTileSize(vtkm::Id tileSize) { this->TileSize = tileSize; }
+
   VTKM_CONT
   void Render()
   {
@@ -538,23 +882,26 @@ private:
 
     {
       vtkm::cont::Token token;
-      EdgePlotter<DeviceTag> plotter(WorldToProjection,
-                                     width,
-                                     height,
-                                     subsetWidth,
-                                     subsetHeight,
-                                     xOffset,
-                                     yOffset,
-                                     isAssocPoints,
-                                     ScalarFieldRange,
-                                     ColorMap,
-                                     FrameBuffer,
-                                     Camera.GetClippingRange(),
-                                     token);
-      vtkm::worklet::DispatcherMapField<EdgePlotter<DeviceTag>> plotterDispatcher(plotter);
-      plotterDispatcher.SetDevice(DeviceTag());
-      plotterDispatcher.Invoke(
-        PointIndices, Coordinates, vtkm::rendering::raytracing::GetScalarFieldArray(ScalarField));
+      EdgeRasterizer<DeviceTag> rasterizer(WorldToProjection,
+                                           width,
+                                           height,
+                                           subsetWidth,
+                                           subsetHeight,
+                                           xOffset,
+                                           yOffset,
+                                           isAssocPoints,
+                                           ScalarFieldRange,
+                                           ColorMap,
+                                           Camera.GetClippingRange(),
+                                           token);
+      if (this->TileSize <= 0 || !this->RasterizeTiles(rasterizer, DeviceTag()))
+      {
+        EdgePlotter<DeviceTag> plotter(rasterizer, FrameBuffer, token);
+        vtkm::worklet::DispatcherMapField<EdgePlotter<DeviceTag>> plotterDispatcher(plotter);
+        plotterDispatcher.SetDevice(DeviceTag());
+        plotterDispatcher.Invoke(
+          PointIndices, Coordinates, vtkm::rendering::raytracing::GetScalarFieldArray(ScalarField));
+      }
     }
 
     BufferConverter converter;
@@ -563,6 +910,66 @@ private:
     converterDispatcher.Invoke(FrameBuffer, Canvas->GetDepthBuffer(), Canvas->GetColorBuffer());
   }
 
+  // Bins the edges to the screen tiles they cross, then draws each tile on a single thread.
+  // Returns false, without drawing anything, when the bin keys (tile * numberOfEdges + edge)
+  // do not fit in a vtkm::Id.
+  template <typename DeviceTag>
+  VTKM_CONT bool RasterizeTiles(const EdgeRasterizer<DeviceTag>& rasterizer, DeviceTag)
+  {
+    const vtkm::Id numberOfEdges = PointIndices.GetNumberOfValues();
+    const vtkm::Id tilesX = (rasterizer.GetWidth() + this->TileSize - 1) / this->TileSize;
+    const vtkm::Id tilesY = (rasterizer.GetHeight() + this->TileSize - 1) / this->TileSize;
+    const vtkm::Id numberOfTiles = tilesX * tilesY;
+    if (numberOfEdges == 0 || numberOfTiles == 0)
+    {
+      return true;
+    }
+    if (numberOfTiles > std::numeric_limits<vtkm::Id>::max() / numberOfEdges)
+    {
+      return false;
+    }
+
+    vtkm::cont::ArrayHandle<vtkm::Id> binCounts;
+    vtkm::worklet::DispatcherMapField<EdgeTileCounter<DeviceTag>> counterDispatcher(
+      EdgeTileCounter<DeviceTag>(rasterizer, this->TileSize));
+    counterDispatcher.SetDevice(DeviceTag());
+    counterDispatcher.Invoke(PointIndices, Coordinates, binCounts);
+    vtkm::cont::ArrayHandle<vtkm::Id> binOffsets;
+    const vtkm::Id numberOfKeys =
+      vtkm::cont::Algorithm::ScanExclusive(DeviceTag(), binCounts, binOffsets);
+    binCounts.ReleaseResources();
+
+    vtkm::cont::ArrayHandle<vtkm::Id> keys;
+    keys.Allocate(numberOfKeys);
+    vtkm::worklet::DispatcherMapField<EdgeBinner<DeviceTag>> binnerDispatcher(
+      EdgeBinner<DeviceTag>(rasterizer, this->TileSize, tilesX, numberOfEdges));
+    binnerDispatcher.SetDevice(DeviceTag());
+    binnerDispatcher.Invoke(PointIndices, binOffsets, Coordinates, keys);
+    binOffsets.ReleaseResources();
+
+    // The keys hold the tile and the edge, so a plain sort is deterministic and keeps the edges
+    // of a tile in the order the other rasterizer would draw them on a single thread.
+    vtkm::cont::Algorithm::Sort(DeviceTag(), keys);
+    vtkm::cont::ArrayHandle<vtkm::Id> binStarts;
+    vtkm::cont::Algorithm::LowerBounds(
+      DeviceTag(),
+      keys,
+      vtkm::cont::ArrayHandleCounting<vtkm::Id>(0, numberOfEdges, numberOfTiles + 1),
+      binStarts);
+
+    vtkm::worklet::DispatcherMapField<TileRasterizer<DeviceTag>> tileDispatcher(
+      TileRasterizer<DeviceTag>(rasterizer, this->TileSize, tilesX, numberOfEdges));
+    tileDispatcher.SetDevice(DeviceTag());
+    tileDispatcher.Invoke(vtkm::cont::make_ArrayHandleView(binStarts, 0, numberOfTiles),
+                          vtkm::cont::make_ArrayHandleView(binStarts, 1, numberOfTiles),
+                          keys,
+                          PointIndices,
+                          Coordinates,
+                          vtkm::rendering::raytracing::GetScalarFieldArray(ScalarField),
+                          FrameBuffer);
+    return true;
+  }
+
   VTKM_CONT
   struct RenderWithDeviceFunctor
   {
@@ -594,6 +1001,7 @@ private:
   vtkm::Range ScalarFieldRange;
   vtkm::cont::ArrayHandle<vtkm::Float32> SolidDepthBuffer;
   PackedFrameBufferHandle FrameBuffer;
+  vtkm::Id TileSize = 0;
 }; // class Wireframer
 }
 } //namespace vtkm::rendering
@@ -0,0 +1,446 @@
+//============================================================================
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//============================================================================
+
+#include <vtkm/rendering/compositing/Compositor.h>
+
+#include <vtkm/cont/EnvironmentTracker.h>
+#include <vtkm/cont/ErrorBadValue.h>
+
+#include <vtkm/thirdparty/diy/diy.h>
+
+#include <algorithm>
+#include <utility>
+
+namespace vtkm
+{
+namespace rendering
+{
+namespace compositing
+{
+
+namespace
+{
+
+// Composites the images of one part of the frame.
+Image CompositeImages(std::vector<Image>& images, Compositor::CompositeMode mode)
+{
+  // Grow the result once to hold the active pixels of all images.
+  vtkm::RangeId2 active(0, 0, 0, 0);
+  for (const Image& image : images)
+  {
+    if (image.GetActiveBounds().IsNonEmpty())
+    {
+      active = active.IsNonEmpty() ? active.Union(image.GetActiveBounds())
+                                   : image.GetActiveBounds();
+    }
+  }
+
+  if (mode == Compositor::CompositeMode::VisibilityOrder)
+  {
+    std::stable_sort(images.begin(), images.end(), [](const Image& a, const Image& b) {
+      return a.GetOrder() < b.GetOrder();
+    });
+  }
+
+  Image result = std::move(images.front());
+  result.SetActiveBounds(active);
+  for (std::size_t i = 1; i < images.size(); ++i)
+  {
+    if (mode == Compositor::CompositeMode::ZBuffer)
+    {
+      result.CompositeZBuffer(images[i]);
+    }
+    else
+    {
+      result.Blend(images[i]);
+    }
+  }
+  return result;
+}
+
+// The `index`th of `count` bands of rows of `region`.
+vtkm::RangeId2 SplitRows(const vtkm::RangeId2& region, int index, int count)
+{
+  const vtkm::Id height = region.Y.Length();
+  return vtkm::RangeId2(region.X.Min,
+                        region.X.Max,
+                        region.Y.Min + height * index / count,
+                        region.Y.Min + height * (index + 1) / count);
+}
+
+struct ImageBlock
+{
+  // The composited image of the part of the frame this block is responsible for.
+  Image Piece;
+  vtkm::RangeId2 Region;
+};
+
+// One round of radix-k. The block composites the pieces of its region it received in the
+// previous round, then splits the region among its partners of this round. Every member of a
+// group holds the same region and lists the partners in the same order, so partner i receives
+// band i from all of them.
+struct SwapImages
+{
+  Compositor::CompositeMode Mode;
+
+  void operator()(ImageBlock* block,
+                  const vtkmdiy::ReduceProxy& proxy,
+                  const vtkmdiy::RegularSwapPartners&) const
+  {
+    const int selfGid = proxy.gid();
+    if (proxy.in_link().size() > 0)
+    {
+      std::vector<Image> pieces;
+      pieces.reserve(static_cast<std::size_t>(proxy.in_link().size()));
+      for (int i = 0; i < proxy.in_link().size(); ++i)
+      {
+        const int gid = proxy.in_link().target(i).gid;
+        if (gid == selfGid)
+        {
+          pieces.push_back(std::move(block->Piece));
+        }
+        else
+        {
+          pieces.emplace_back();
+          proxy.dequeue(gid, pieces.back());
+        }
+      }
+      block->Piece = CompositeImages(pieces, this->Mode);
+    }
+
+    const int numberOfPartners = proxy.out_link().size();
+    if (numberOfPartners == 0)
+    {
+      return;
+    }
+    vtkm::RangeId2 keptRegion;
+    Image keptPiece;
+    for (int i = 0; i < numberOfPartners; ++i)
+    {
+      const vtkmdiy::BlockID target = proxy.out_link().target(i);
+      const vtkm::RangeId2 band = SplitRows(block->Region, i, numberOfPartners);
+      if (target.gid == selfGid)
+      {
+        keptRegion = band;
+        keptPiece = block->Piece.Subset(band);
+      }
+      else
+      {
+        proxy.enqueue(target, block->Piece.Subset(band));
+      }
+    }
+    block->Region = keptRegion;
+    block->Piece = std::move(keptPiece);
+  }
+};
+
+// Gathers a value from all ranks on rank 0. Returns the values of all ranks on rank 0 and
+// nothing on the others.
+template <typename T>
+std::vector<T> GatherToRoot(const vtkmdiy::mpi::communicator& comm, const T& value)
+{
+  vtkmdiy::MemoryBuffer buffer;
+  vtkmdiy::save(buffer, value);
+
+  std::vector<std::vector<char>> gathered;
+  if (comm.rank() == 0)
+  {
+    vtkmdiy::mpi::gather(comm, buffer.buffer, gathered, 0);
+  }
+  else
+  {
+    vtkmdiy::mpi::gather(comm, buffer.buffer, 0);
+  }
+
+  std::vector<T> values(gathered.size());
+  for (std::size_t i = 0; i < gathered.size(); ++i)
+  {
+    vtkmdiy::MemoryBuffer received;
+    received.buffer.swap(gathered[i]);
+    vtkmdiy::load(received, values[i]);
+  }
+  return values;
+}
+
+template <typename FloatType>
+struct Fragment
+{
+  vtkm::Id PixelId;
+  FloatType Distance;
+  vtkm::Vec<FloatType, 4> Color;
+};
+
+template <typename FloatType>
+using FragmentVector = std::vector<Fragment<FloatType>>;
+
+// Sends every fragment to the block owning its pixel.
+template <typename FloatType>
+struct ExchangeFragments
+{
+  vtkm::Id NumberOfPixels;
+  int NumberOfBlocks;
+
+  int Owner(vtkm::Id pixelId) const
+  {
+    return static_cast<int>(pixelId * this->NumberOfBlocks / this->NumberOfPixels);
+  }
+
+  void operator()(FragmentVector<FloatType>* fragments, const vtkmdiy::ReduceProxy& proxy) const
+  {
+    if (proxy.in_link().size() == 0)
+    {
+      std::vector<FragmentVector<FloatType>> outgoing(
+        static_cast<std::size_t>(this->NumberOfBlocks));
+      for (const Fragment<FloatType>& fragment : *fragments)
+      {
+        outgoing[static_cast<std::size_t>(this->Owner(fragment.PixelId))].push_back(fragment);
+      }
+      fragments->clear();
+      for (int i = 0; i < proxy.out_link().size(); ++i)
+      {
+        const vtkmdiy::BlockID target = proxy.out_link().target(i);
+        proxy.enqueue(target, outgoing[static_cast<std::size_t>(target.gid)]);
+      }
+    }
+    else
+    {
+      for (int i = 0; i < proxy.in_link().size(); ++i)
+      {
+        FragmentVector<FloatType> incoming;
+        proxy.dequeue(proxy.in_link().target(i).gid, incoming);
+        fragments->insert(fragments->end(), incoming.begin(), incoming.end());
+      }
+    }
+  }
+};
+
+// Blends the fragments of each pixel front to back, leaving one fragment per pixel.
+template <typename FloatType>
+void BlendFragments(FragmentVector<FloatType>& fragments)
+{
+  std::sort(fragments.begin(),
+            fragments.end(),
+            [](const Fragment<FloatType>& a, const Fragment<FloatType>& b) {
+              return a.PixelId < b.PixelId || (a.PixelId == b.PixelId && a.Distance < b.Distance);
+            });
+
+  std::size_t numberOfPixels = 0;
+  for (std::size_t i = 0; i < fragments.size(); ++numberOfPixels)
+  {
+    Fragment<FloatType> pixel = fragments[i];
+    for (++i; i < fragments.size() && fragments[i].PixelId == pixel.PixelId; ++i)
+    {
+      pixel.Color = pixel.Color + fragments[i].Color * (FloatType(1) - pixel.Color[3]);
+      pixel.Distance = fragments[i].Distance;
+    }
+    fragments[numberOfPixels] = pixel;
+  }
+  fragments.resize(numberOfPixels);
+}
+
+// Packs the composited fragments of all ranks in a partial composite.
+template <typename FloatType>
+vtkm::rendering::raytracing::PartialComposite<FloatType> MakePartialComposite(
+  const std::vector<FragmentVector<FloatType>>& gathered)
+{
+  std::size_t numberOfComposites = 0;
+  for (const auto& rankFragments : gathered)
+  {
+    numberOfComposites += rankFragments.size();
+  }
+
+  vtkm::rendering::raytracing::PartialComposite<FloatType> result;
+  result.Buffer = vtkm::rendering::raytracing::ChannelBuffer<FloatType>(
+    4, static_cast<vtkm::Id>(numberOfComposites));
+  result.PixelIds.Allocate(static_cast<vtkm::Id>(numberOfComposites));
+  result.Distances.Allocate(static_cast<vtkm::Id>(numberOfComposites));
+  auto pixelIds = result.PixelIds.WritePortal();
+  auto distances = result.Distances.WritePortal();
+  auto buffer = result.Buffer.Buffer.WritePortal();
+  vtkm::Id index = 0;
+  for (const auto& rankFragments : gathered)
+  {
+    for (const Fragment<FloatType>& fragment : rankFragments)
+    {
+      pixelIds.Set(index, fragment.PixelId);
+      distances.Set(index, fragment.Distance);
+      for (vtkm::IdComponent c = 0; c < 4; ++c)
+      {
+        buffer.Set(index * 4 + c, fragment.Color[c]);
+      }
+      ++index;
+    }
+  }
+  return result;
+}
+
+template <typename FloatType>
+vtkm::rendering::raytracing::PartialComposite<FloatType> CompositePartials(
+  const std::vector<vtkm::rendering::raytracing::PartialComposite<FloatType>>& partials,
+  vtkm::Id numberOfPixels,
+  int radix)
+{
+  FragmentVector<FloatType> localFragments;
+  for (const auto& partial : partials)
+  {
+    if (partial.Buffer.GetNumChannels() != 4)
+    {
+      throw vtkm::cont::ErrorBadValue("Partial composites must have 4 color channels.");
+    }
+    auto pixelIds = partial.PixelIds.ReadPortal();
+    auto distances = partial.Distances.ReadPortal();
+    auto buffer = partial.Buffer.Buffer.ReadPortal();
+    for (vtkm::Id i = 0; i < pixelIds.GetNumberOfValues(); ++i)
+    {
+      Fragment<FloatType> fragment;
+      fragment.PixelId = pixelIds.Get(i);
+      if (fragment.PixelId < 0 || fragment.PixelId >= numberOfPixels)
+      {
+        throw vtkm::cont::ErrorBadValue("Partial composite pixel id out of range.");
+      }
+      fragment.Distance = distances.Get(i);
+      for (vtkm::IdComponent c = 0; c < 4; ++c)
+      {
+        fragment.Color[c] = buffer.Get(i * 4 + c);
+      }
+      localFragments.push_back(fragment);
+    }
+  }
+
+  vtkmdiy::mpi::communicator comm = vtkm::cont::EnvironmentTracker::GetCommunicator();
+  if (comm.size() == 1)
+  {
+    BlendFragments(localFragments);
+    return MakePartialComposite<FloatType>({ localFragments });
+  }
+
+  vtkmdiy::Master master(
+    comm,
+    1,
+    -1,
+    []() -> void* { return new FragmentVector<FloatType>(); },
+    [](void* ptr) { delete static_cast<FragmentVector<FloatType>*>(ptr); });
+  vtkmdiy::ContiguousAssigner assigner(comm.size(), comm.size());
+  vtkmdiy::RegularDecomposer<vtkmdiy::DiscreteBounds> decomposer(
+    1, vtkmdiy::interval(0, comm.size() - 1), comm.size());
+  decomposer.decompose(comm.rank(), assigner, master);
+  master.block<FragmentVector<FloatType>>(0)->swap(localFragments);
+
+  vtkmdiy::all_to_all(
+    master, assigner, ExchangeFragments<FloatType>{ numberOfPixels, comm.size() }, radix);
+
+  FragmentVector<FloatType>& fragments = *master.block<FragmentVector<FloatType>>(0);
+  BlendFragments(fragments);
+
+  // Each rank owns a range of pixel ids, so concatenating the ranks keeps them sorted.
+  return MakePartialComposite(GatherToRoot(comm, fragments));
+}
+
+} // anonymous namespace
+
+void Compositor::SetRadix(vtkm::IdComponent radix)
+{
+  if (radix < 2)
+  {
+    throw vtkm::cont::ErrorBadValue("The compositing radix must be at least 2.");
+  }
+  this->Radix = radix;
+}
+
+void Compositor::AddImage(const vtkm::rendering::Canvas& canvas, vtkm::Int32 order)
+{
+  this->Images.push_back(Image::FromCanvas(canvas, order));
+}
+
+void Compositor::AddImage(const Image& image)
+{
+  this->Images.push_back(image);
+}
+
+Image Compositor::Composite()
+{
+  if (this->Images.empty())
+  {
+    throw vtkm::cont::ErrorBadValue("No images to composite.");
+  }
+  Image local = CompositeImages(this->Images, this->Mode);
+  this->Images.clear();
+
+  vtkmdiy::mpi::communicator comm = vtkm::cont::EnvironmentTracker::GetCommunicator();
+  if (comm.size() == 1)
+  {
+    return local;
+  }
+
+  vtkmdiy::Master master(
+    comm,
+    1,
+    -1,
+    []() -> void* { return new ImageBlock(); },
+    [](void* ptr) { delete static_cast<ImageBlock*>(ptr); });
+  vtkmdiy::ContiguousAssigner assigner(comm.size(), comm.size());
+  vtkmdiy::RegularDecomposer<vtkmdiy::DiscreteBounds> decomposer(
+    1, vtkmdiy::interval(0, comm.size() - 1), comm.size());
+  decomposer.decompose(comm.rank(), assigner, master);
+  ImageBlock* block = master.block<ImageBlock>(0);
+  block->Region = local.GetBounds();
+  block->Piece = std::move(local);
+
+  // Blending in visibility order needs all images of a piece at once, so use a single round
+  // with all ranks (direct send).
+  const int radix =
+    this->Mode == CompositeMode::ZBuffer ? static_cast<int>(this->Radix) : comm.size();
+  vtkmdiy::RegularSwapPartners partners(decomposer, radix);
+  vtkmdiy::reduce(master, assigner, partners, SwapImages{ this->Mode });
+
+  // The pieces cover disjoint regions, so the composite operation only pastes them.
+  std::vector<Image> pieces = GatherToRoot(comm, block->Piece);
+  if (pieces.empty())
+  {
+    return Image();
+  }
+  return CompositeImages(pieces, this->Mode);
+}
+
+void Compositor::Composite(vtkm::rendering::Canvas& canvas)
+{
+  Image image = this->Composite();
+  if (vtkm::cont::EnvironmentTracker::GetCommunicator().rank() == 0)
+  {
+    image.ToCanvas(canvas);
+  }
+}
+
+void PartialCompositor::SetRadix(vtkm::IdComponent radix)
+{
+  if (radix < 2)
+  {
+    throw vtkm::cont::ErrorBadValue("The compositing radix must be at least 2.");
+  }
+  this->Radix = radix;
+}
+
+vtkm::rendering::raytracing::PartialComposite<vtkm::Float32> PartialCompositor::Composite(
+  const std::vector<vtkm::rendering::raytracing::PartialComposite<vtkm::Float32>>& partials,
+  vtkm::Id numberOfPixels)
+{
+  return CompositePartials(partials, numberOfPixels, static_cast<int>(this->Radix));
+}
+
+vtkm::rendering::raytracing::PartialComposite<vtkm::Float64> PartialCompositor::Composite(
+  const std::vector<vtkm::rendering::raytracing::PartialComposite<vtkm::Float64>>& partials,
+  vtkm::Id numberOfPixels)
+{
+  return CompositePartials(partials, numberOfPixels, static_cast<int>(this->Radix));
+}
+
+}
+}
+} // namespace vtkm::rendering::compositing
@@ -0,0 +1,140 @@
+//============================================================================
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//============================================================================
+#ifndef vtk_m_rendering_compositing_Compositor_h
+#define vtk_m_rendering_compositing_Compositor_h
+
+#include <vtkm/rendering/Canvas.h>
+#include <vtkm/rendering/compositing/Image.h>
+#include <vtkm/rendering/raytracing/PartialComposite.h>
+#include <vtkm/rendering/vtkm_rendering_export.h>
+
+#include <vector>
+
+namespace vtkm
+{
+namespace rendering
+{
+namespace compositing
+{
+
+/// \brief Composites the images rendered by all ranks into one image.
+///
+/// This is sort-last compositing: every rank renders its part of a distributed data set into a
+/// full frame, and the frames are then merged across the ranks of the communicator held by
+/// `vtkm::cont::EnvironmentTracker`. All ranks must call `Composite`; the result is gathered on
+/// rank 0.
+///
+/// Opaque images (`CompositeMode::ZBuffer`) are composited with radix-k: in each round, groups
+/// of k ranks split the part of the frame they share into k pieces, and each rank composites
+/// one piece of all k images. After the rounds every rank owns a composited piece of the frame,
+/// so the work and the message sizes are spread evenly over the ranks. A radix of 2 is binary
+/// swap. Semi-transparent images (`CompositeMode::VisibilityOrder`) must be blended in
+/// visibility order, which rounds of k ranks would not respect, so they are composited with
+/// direct send: the frame is split in one piece per rank, and each rank blends all images of its
+/// piece in order.
+///
+/// In both modes only the active pixels of each piece (see `Image`) are sent.
+///
+class VTKM_RENDERING_EXPORT Compositor
+{
+public:
+  enum struct CompositeMode
+  {
+    /// Keep the closest pixel. For opaque geometry.
+    ZBuffer,
+    /// Blend the images in the order given to `AddImage`. For volumes and translucent geometry.
+    VisibilityOrder
+  };
+
+  /// \brief How the images are combined. The default is `CompositeMode::ZBuffer`.
+  void SetCompositeMode(CompositeMode mode) { this->Mode = mode; }
+  CompositeMode GetCompositeMode() const { return this->Mode; }
+
+  /// \brief The number of ranks exchanging pieces in each round of radix-k.
+  ///
+  /// The number of ranks is factored in rounds of at most this many ranks. The default of 2 is
+  /// binary swap; larger radices use fewer rounds of more messages.
+  ///
+  void SetRadix(vtkm::IdComponent radix);
+  vtkm::IdComponent GetRadix() const { return this->Radix; }
+
+  /// \brief Adds an image rendered by this rank.
+  ///
+  /// All images, on all ranks, must have the same size. For `CompositeMode::VisibilityOrder`,
+  /// `order` is the place of the image in the visibility order (lower is closer to the camera).
+  /// The images added on one rank must be consecutive in that order.
+  ///
+  void AddImage(const vtkm::rendering::Canvas& canvas, vtkm::Int32 order = 0);
+  void AddImage(const Image& image);
+
+  /// \brief Composites the images added on all ranks.
+  ///
+  /// Returns the composited frame on rank 0 and an empty image on the other ranks. The added
+  /// images are cleared.
+  ///
+  Image Composite();
+
+  /// \brief Composites the images added on all ranks and writes the result to `canvas`.
+  ///
+  /// Only the canvas of rank 0 is written.
+  ///
+  void Composite(vtkm::rendering::Canvas& canvas);
+
+  void ClearImages() { this->Images.clear(); }
+
+private:
+  CompositeMode Mode = CompositeMode::ZBuffer;
+  vtkm::IdComponent Radix = 2;
+  std::vector<Image> Images;
+};
+
+/// \brief Composites the partial composites traced by all ranks.
+///
+/// When rendering a distributed unstructured volume, each rank traces the rays of the frame
+/// through its part of the mesh (see `ConnectivityProxy::PartialTrace`). This yields, for each
+/// pixel, a partial composite: the color accumulated along the segment of the ray inside that
+/// part, and the distance where the segment ends. The segments of a ray do not overlap, so
+/// sorting the partial composites of a pixel by distance and blending them front to back gives
+/// the color of the whole ray.
+///
+/// The partial composites are sent to their pixel's owner with an all-to-all exchange (each
+/// rank owns an equal range of pixel ids), composited there, and gathered on rank 0. Only the
+/// traced pixels are sent. All ranks must call `Composite`.
+///
+class VTKM_RENDERING_EXPORT PartialCompositor
+{
+public:
+  /// \brief The fan-out of the rounds of the all-to-all exchange. The default is 2.
+  void SetRadix(vtkm::IdComponent radix);
+  vtkm::IdComponent GetRadix() const { return this->Radix; }
+
+  /// \brief Composites the partial composites of all ranks.
+  ///
+  /// The pixel ids of the partial composites index a frame of `numberOfPixels` pixels, and their
+  /// buffers must hold 4 channels of color with premultiplied alpha. Returns on rank 0 a single
+  /// partial composite with one entry per traced pixel, sorted by pixel id, whose distance is the
+  /// end of the farthest segment. Returns an empty partial composite on the other ranks.
+  ///
+  vtkm::rendering::raytracing::PartialComposite<vtkm::Float32> Composite(
+    const std::vector<vtkm::rendering::raytracing::PartialComposite<vtkm::Float32>>& partials,
+    vtkm::Id numberOfPixels);
+  vtkm::rendering::raytracing::PartialComposite<vtkm::Float64> Composite(
+    const std::vector<vtkm::rendering::raytracing::PartialComposite<vtkm::Float64>>& partials,
+    vtkm::Id numberOfPixels);
+
+private:
+  vtkm::IdComponent Radix = 2;
+};
+
+}
+}
+} // namespace vtkm::rendering::compositing
+
+#endif //vtk_m_rendering_compositing_Compositor_h
@@ -0,0 +1,267 @@
+//============================================================================
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//============================================================================
+
+#include <vtkm/rendering/compositing/Image.h>
+
+#include <vtkm/Math.h>
+#include <vtkm/cont/ErrorBadValue.h>
+
+#include <algorithm>
+#include <utility>
+
+namespace vtkm
+{
+namespace rendering
+{
+namespace compositing
+{
+
+namespace
+{
+
+const vtkm::Vec4f_32 BackgroundColor(0.f, 0.f, 0.f, 0.f);
+
+vtkm::RangeId2 Intersect(const vtkm::RangeId2& a, const vtkm::RangeId2& b)
+{
+  vtkm::RangeId2 result(vtkm::Max(a.X.Min, b.X.Min),
+                        vtkm::Min(a.X.Max, b.X.Max),
+                        vtkm::Max(a.Y.Min, b.Y.Min),
+                        vtkm::Min(a.Y.Max, b.Y.Max));
+  return result.IsNonEmpty() ? result : vtkm::RangeId2(0, 0, 0, 0);
+}
+
+vtkm::RangeId2 Unite(const vtkm::RangeId2& a, const vtkm::RangeId2& b)
+{
+  if (!a.IsNonEmpty())
+  {
+    return b;
+  }
+  if (!b.IsNonEmpty())
+  {
+    return a;
+  }
+  return a.Union(b);
+}
+
+// Index of pixel (x, y) in the pixels stored for `bounds`.
+std::size_t PixelIndex(const vtkm::RangeId2& bounds, vtkm::Id x, vtkm::Id y)
+{
+  return static_cast<std::size_t>((y - bounds.Y.Min) * bounds.X.Length() + (x - bounds.X.Min));
+}
+
+void CheckSameFrame(const Image& a, const Image& b)
+{
+  if (a.GetBounds() != b.GetBounds())
+  {
+    throw vtkm::cont::ErrorBadValue("Composited images must cover the same frame.");
+  }
+}
+
+} // anonymous namespace
+
+Image::Image(vtkm::Id width, vtkm::Id height, vtkm::Int32 order)
+  : Bounds(0, width, 0, height)
+  , Order(order)
+{
+}
+
+Image Image::FromCanvas(const vtkm::rendering::Canvas& canvas, vtkm::Int32 order)
+{
+  const vtkm::Id width = canvas.GetWidth();
+  const vtkm::Id height = canvas.GetHeight();
+  auto colorPortal = canvas.GetColorBuffer().ReadPortal();
+  auto depthPortal = canvas.GetDepthBuffer().ReadPortal();
+
+  // Find the rectangle of rendered pixels before copying them.
+  vtkm::RangeId2 active(width, 0, height, 0);
+  for (vtkm::Id y = 0; y < height; ++y)
+  {
+    for (vtkm::Id x = 0; x < width; ++x)
+    {
+      const vtkm::Id index = y * width + x;
+      if (depthPortal.Get(index) < VTKM_DEFAULT_CANVAS_DEPTH || colorPortal.Get(index)[3] > 0.f)
+      {
+        active.X.Min = vtkm::Min(active.X.Min, x);
+        active.X.Max = vtkm::Max(active.X.Max, x + 1);
+        active.Y.Min = vtkm::Min(active.Y.Min, y);
+        active.Y.Max = vtkm::Max(active.Y.Max, y + 1);
+      }
+    }
+  }
+
+  Image image(width, height, order);
+  image.SetActiveBounds(active);
+  std::size_t pixel = 0;
+  for (vtkm::Id y = image.ActiveBounds.Y.Min; y < image.ActiveBounds.Y.Max; ++y)
+  {
+    for (vtkm::Id x = image.ActiveBounds.X.Min; x < image.ActiveBounds.X.Max; ++x, ++pixel)
+    {
+      image.Colors[pixel] = colorPortal.Get(y * width + x);
+      image.Depths[pixel] = depthPortal.Get(y * width + x);
+    }
+  }
+  return image;
+}
+
+void Image::ToCanvas(vtkm::rendering::Canvas& canvas) const
+{
+  const vtkm::Id width = this->Bounds.X.Length();
+  const vtkm::Id height = this->Bounds.Y.Length();
+  canvas.ResizeBuffers(width, height);
+  auto colorPortal = canvas.GetColorBuffer().WritePortal();
+  auto depthPortal = canvas.GetDepthBuffer().WritePortal();
+  for (vtkm::Id y = 0; y < height; ++y)
+  {
+    for (vtkm::Id x = 0; x < width; ++x)
+    {
+      colorPortal.Set(y * width + x, this->GetColor(x, y));
+      depthPortal.Set(y * width + x, this->GetDepth(x, y));
+    }
+  }
+}
+
+vtkm::Vec4f_32 Image::GetColor(vtkm::Id x, vtkm::Id y) const
+{
+  if (!this->ActiveBounds.Contains(vtkm::Id2(x, y)))
+  {
+    return BackgroundColor;
+  }
+  return this->Colors[PixelIndex(this->ActiveBounds, x, y)];
+}
+
+vtkm::Float32 Image::GetDepth(vtkm::Id x, vtkm::Id y) const
+{
+  if (!this->ActiveBounds.Contains(vtkm::Id2(x, y)))
+  {
+    return VTKM_DEFAULT_CANVAS_DEPTH;
+  }
+  return this->Depths[PixelIndex(this->ActiveBounds, x, y)];
+}
+
+Image Image::Subset(const vtkm::RangeId2& region) const
+{
+  Image subset;
+  subset.Bounds = this->Bounds;
+  subset.Order = this->Order;
+  subset.SetActiveBounds(Intersect(this->ActiveBounds, region));
+
+  const vtkm::RangeId2& active = subset.ActiveBounds;
+  const std::size_t rowLength = static_cast<std::size_t>(active.X.Length());
+  for (vtkm::Id y = active.Y.Min; y < active.Y.Max; ++y)
+  {
+    const std::size_t from = PixelIndex(this->ActiveBounds, active.X.Min, y);
+    const std::size_t to = PixelIndex(active, active.X.Min, y);
+    std::copy_n(this->Colors.begin() + from, rowLength, subset.Colors.begin() + to);
+    std::copy_n(this->Depths.begin() + from, rowLength, subset.Depths.begin() + to);
+  }
+  return subset;
+}
+
+void Image::CompositeZBuffer(const Image& other)
+{
+  CheckSameFrame(*this, other);
+  this->SetActiveBounds(Unite(this->ActiveBounds, other.ActiveBounds));
+
+  const vtkm::RangeId2& from = other.ActiveBounds;
+  std::size_t source = 0;
+  for (vtkm::Id y = from.Y.Min; y < from.Y.Max; ++y)
+  {
+    std::size_t target = PixelIndex(this->ActiveBounds, from.X.Min, y);
+    for (vtkm::Id x = from.X.Min; x < from.X.Max; ++x, ++source, ++target)
+    {
+      if (other.Depths[source] < this->Depths[target])
+      {
+        this->Colors[target] = other.Colors[source];
+        this->Depths[target] = other.Depths[source];
+      }
+    }
+  }
+}
+
+void Image::Blend(const Image& other)
+{
+  CheckSameFrame(*this, other);
+  this->SetActiveBounds(Unite(this->ActiveBounds, other.ActiveBounds));
+
+  const bool otherInFront = other.Order < this->Order;
+  const vtkm::RangeId2& from = other.ActiveBounds;
+  std::size_t source = 0;
+  for (vtkm::Id y = from.Y.Min; y < from.Y.Max; ++y)
+  {
+    std::size_t target = PixelIndex(this->ActiveBounds, from.X.Min, y);
+    for (vtkm::Id x = from.X.Min; x < from.X.Max; ++x, ++source, ++target)
+    {
+      const vtkm::Vec4f_32& front = otherInFront ? other.Colors[source] : this->Colors[target];
+      const vtkm::Vec4f_32& back = otherInFront ? this->Colors[target] : other.Colors[source];
+      this->Colors[target] = front + back * (1.f - front[3]);
+      this->Depths[target] = vtkm::Min(this->Depths[target], other.Depths[source]);
+    }
+  }
+  this->Order = vtkm::Min(this->Order, other.Order);
+}
+
+void Image::SetActiveBounds(const vtkm::RangeId2& newBounds)
+{
+  const vtkm::RangeId2 bounds = newBounds.IsNonEmpty() ? newBounds : vtkm::RangeId2(0, 0, 0, 0);
+  if (bounds == this->ActiveBounds)
+  {
+    return;
+  }
+
+  const std::size_t numberOfPixels =
+    static_cast<std::size_t>(bounds.X.Length() * bounds.Y.Length());
+  std::vector<vtkm::Vec4f_32> colors(numberOfPixels, BackgroundColor);
+  std::vector<vtkm::Float32> depths(numberOfPixels, VTKM_DEFAULT_CANVAS_DEPTH);
+
+  const vtkm::RangeId2 kept = Intersect(this->ActiveBounds, bounds);
+  const std::size_t rowLength = static_cast<std::size_t>(kept.X.Length());
+  for (vtkm::Id y = kept.Y.Min; y < kept.Y.Max; ++y)
+  {
+    const std::size_t from = PixelIndex(this->ActiveBounds, kept.X.Min, y);
+    const std::size_t to = PixelIndex(bounds, kept.X.Min, y);
+    std::copy_n(this->Colors.begin() + from, rowLength, colors.begin() + to);
+    std::copy_n(this->Depths.begin() + from, rowLength, depths.begin() + to);
+  }
+
+  this->ActiveBounds = bounds;
+  this->Colors = std::move(colors);
+  this->Depths = std::move(depths);
+}
+
+}
+}
+} // namespace vtkm::rendering::compositing
+
+namespace mangled_diy_namespace
+{
+
+void Serialization<vtkm::rendering::compositing::Image>::save(
+  BinaryBuffer& bb,
+  const vtkm::rendering::compositing::Image& image)
+{
+  vtkmdiy::save(bb, image.Bounds);
+  vtkmdiy::save(bb, image.ActiveBounds);
+  vtkmdiy::save(bb, image.Order);
+  vtkmdiy::save(bb, image.Colors);
+  vtkmdiy::save(bb, image.Depths);
+}
+
+void Serialization<vtkm::rendering::compositing::Image>::load(
+  BinaryBuffer& bb,
+  vtkm::rendering::compositing::Image& image)
+{
+  vtkmdiy::load(bb, image.Bounds);
+  vtkmdiy::load(bb, image.ActiveBounds);
+  vtkmdiy::load(bb, image.Order);
+  vtkmdiy::load(bb, image.Colors);
+  vtkmdiy::load(bb, image.Depths);
+}
+
+} // namespace mangled_diy_namespace
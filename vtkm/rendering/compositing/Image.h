@@ -0,0 +1,130 @@
+//============================================================================
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//============================================================================
+#ifndef vtk_m_rendering_compositing_Image_h
+#define vtk_m_rendering_compositing_Image_h
+
+#include <vtkm/RangeId2.h>
+#include <vtkm/Types.h>
+
+#include <vtkm/cont/Serialization.h>
+
+#include <vtkm/rendering/Canvas.h>
+#include <vtkm/rendering/vtkm_rendering_export.h>
+
+#include <vector>
+
+namespace vtkm
+{
+namespace rendering
+{
+namespace compositing
+{
+
+/// \brief A rendered image, or a part of one, held in host memory for compositing.
+///
+/// An image covers a frame of `GetBounds()` pixels, but it only stores the pixels inside
+/// `GetActiveBounds()`, the smallest rectangle holding every pixel something was rendered to.
+/// All other pixels are background: transparent black at the far depth, which is what a cleared
+/// canvas holds. A rank rendering part of a distributed data set usually covers only part of the
+/// frame, so this keeps both the compositing work and the messages small.
+///
+/// Colors are RGBA with premultiplied alpha, as the mappers write them, so images must be
+/// composited before the background color is blended in. Depths are those of the canvas depth
+/// buffer.
+///
+/// The order of an image is its place in the visibility order of the images being blended:
+/// lower orders are closer to the camera.
+///
+class VTKM_RENDERING_EXPORT Image
+{
+public:
+  Image() = default;
+
+  /// Creates a `width` by `height` image where every pixel is background.
+  Image(vtkm::Id width, vtkm::Id height, vtkm::Int32 order = 0);
+
+  /// Copies the pixels of `canvas` that are not background.
+  static Image FromCanvas(const vtkm::rendering::Canvas& canvas, vtkm::Int32 order = 0);
+
+  /// Writes the image to the color and depth buffers of `canvas`, resizing them if needed.
+  void ToCanvas(vtkm::rendering::Canvas& canvas) const;
+
+  const vtkm::RangeId2& GetBounds() const { return this->Bounds; }
+  const vtkm::RangeId2& GetActiveBounds() const { return this->ActiveBounds; }
+
+  vtkm::Int32 GetOrder() const { return this->Order; }
+  void SetOrder(vtkm::Int32 order) { this->Order = order; }
+
+  /// The color of pixel (`x`, `y`) of the frame.
+  vtkm::Vec4f_32 GetColor(vtkm::Id x, vtkm::Id y) const;
+  /// The depth of pixel (`x`, `y`) of the frame.
+  vtkm::Float32 GetDepth(vtkm::Id x, vtkm::Id y) const;
+
+  /// The pixels in `GetActiveBounds()`, row by row.
+  const std::vector<vtkm::Vec4f_32>& GetColors() const { return this->Colors; }
+  const std::vector<vtkm::Float32>& GetDepths() const { return this->Depths; }
+
+  /// \brief Sets the rectangle of stored pixels.
+  ///
+  /// Pixels outside of `bounds` are dropped, and pixels that were not stored are set to
+  /// background. Growing the active bounds ahead of a series of composites avoids growing them
+  /// at every composite.
+  ///
+  void SetActiveBounds(const vtkm::RangeId2& bounds);
+
+  /// \brief Returns the part of this image inside `region`.
+  ///
+  /// The result covers the same frame and has the same order, but only stores the active
+  /// pixels inside `region`.
+  ///
+  Image Subset(const vtkm::RangeId2& region) const;
+
+  /// \brief Keeps the closest of the pixels of this image and `other` at every pixel.
+  ///
+  /// This composites opaque geometry. The result does not depend on the order the images are
+  /// composited in.
+  ///
+  void CompositeZBuffer(const Image& other);
+
+  /// \brief Blends this image with `other` with the "over" operator.
+  ///
+  /// The image with the lower order is in front of the other. The result takes the lower of the
+  /// two orders and the closer of the two depths. Blending is associative but not commutative, so
+  /// a sequence of images has to be blended with its neighbors in visibility order.
+  ///
+  void Blend(const Image& other);
+
+private:
+  friend struct mangled_diy_namespace::Serialization<vtkm::rendering::compositing::Image>;
+
+  vtkm::RangeId2 Bounds{ 0, 0, 0, 0 };
+  vtkm::RangeId2 ActiveBounds{ 0, 0, 0, 0 };
+  vtkm::Int32 Order = 0;
+  std::vector<vtkm::Vec4f_32> Colors;
+  std::vector<vtkm::Float32> Depths;
+};
+
+}
+}
+} // namespace vtkm::rendering::compositing
+
+namespace mangled_diy_namespace
+{
+
+template <>
+struct VTKM_RENDERING_EXPORT Serialization<vtkm::rendering::compositing::Image>
+{
+  static VTKM_CONT void save(BinaryBuffer& bb, const vtkm::rendering::compositing::Image& image);
+  static VTKM_CONT void load(BinaryBuffer& bb, vtkm::rendering::compositing::Image& image);
+};
+
+} // namespace mangled_diy_namespace
+
+#endif //vtk_m_rendering_compositing_Image_h
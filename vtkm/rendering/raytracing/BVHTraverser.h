@@ -25,50 +25,64 @@ namespace raytracing
 {
 #define END_FLAG -1000000000
 
+// Intersects a ray with the four child boxes of a node of the wide hierarchy, see
+// LinearBVH::WideBVH. Returns the number of children hit, which are written nearest first.
 template <typename BVHPortalType, typename Precision>
-VTKM_EXEC inline bool IntersectAABB(const BVHPortalType& bvh,
-                                    const vtkm::Int32& currentNode,
-                                    const vtkm::Vec<Precision, 3>& originDir,
-                                    const vtkm::Vec<Precision, 3>& invDir,
-                                    const Precision& closestDistance,
-                                    bool& hitLeftChild,
-                                    bool& hitRightChild,
-                                    const Precision& minDistance) //Find hit after this distance
+VTKM_EXEC inline vtkm::Int32 IntersectWideAABB(const BVHPortalType& bvh,
+                                               const vtkm::Int32& currentNode,
+                                               const vtkm::Vec<Precision, 3>& originDir,
+                                               const vtkm::Vec<Precision, 3>& invDir,
+                                               const Precision& closestDistance,
+                                               const Precision& minDistance,
+                                               vtkm::Int32 hitChildren[4])
 {
-  vtkm::Vec4f_32 first4 = bvh.Get(currentNode);
-  vtkm::Vec4f_32 second4 = bvh.Get(currentNode + 1);
-  vtkm::Vec4f_32 third4 = bvh.Get(currentNode + 2);
-
-  Precision xmin0 = first4[0] * invDir[0] - originDir[0];
-  Precision ymin0 = first4[1] * invDir[1] - originDir[1];
-  Precision zmin0 = first4[2] * invDir[2] - originDir[2];
-  Precision xmax0 = first4[3] * invDir[0] - originDir[0];
-  Precision ymax0 = second4[0] * invDir[1] - originDir[1];
-  Precision zmax0 = second4[1] * invDir[2] - originDir[2];
-
-  Precision min0 = vtkm::Max(
-    vtkm::Max(vtkm::Max(vtkm::Min(ymin0, ymax0), vtkm::Min(xmin0, xmax0)), vtkm::Min(zmin0, zmax0)),
-    minDistance);
-  Precision max0 = vtkm::Min(
-    vtkm::Min(vtkm::Min(vtkm::Max(ymin0, ymax0), vtkm::Max(xmin0, xmax0)), vtkm::Max(zmin0, zmax0)),
-    closestDistance);
-  hitLeftChild = (max0 >= min0);
-
-  Precision xmin1 = second4[2] * invDir[0] - originDir[0];
-  Precision ymin1 = second4[3] * invDir[1] - originDir[1];
-  Precision zmin1 = third4[0] * invDir[2] - originDir[2];
-  Precision xmax1 = third4[1] * invDir[0] - originDir[0];
-  Precision ymax1 = third4[2] * invDir[1] - originDir[1];
-  Precision zmax1 = third4[3] * invDir[2] - originDir[2];
-
-  Precision min1 = vtkm::Max(
-    vtkm::Max(vtkm::Max(vtkm::Min(ymin1, ymax1), vtkm::Min(xmin1, xmax1)), vtkm::Min(zmin1, zmax1)),
-    minDistance);
-  Precision max1 = vtkm::Min(
-    vtkm::Min(vtkm::Min(vtkm::Max(ymin1, ymax1), vtkm::Max(xmin1, xmax1)), vtkm::Max(zmin1, zmax1)),
-    closestDistance);
-  hitRightChild = (max1 >= min1);
-  return (min0 > min1);
+  const vtkm::Vec4f_32 xmin = bvh.Get(currentNode);
+  const vtkm::Vec4f_32 ymin = bvh.Get(currentNode + 1);
+  const vtkm::Vec4f_32 zmin = bvh.Get(currentNode + 2);
+  const vtkm::Vec4f_32 xmax = bvh.Get(currentNode + 3);
+  const vtkm::Vec4f_32 ymax = bvh.Get(currentNode + 4);
+  const vtkm::Vec4f_32 zmax = bvh.Get(currentNode + 5);
+  const vtkm::Vec4f_32 children4 = bvh.Get(currentNode + 6);
+  vtkm::Int32 children[4];
+  memcpy(children, &children4[0], 16);
+
+  // The slab tests of the four lanes are independent, which lets the compiler vectorize them.
+  Precision tmin[4];
+  Precision tmax[4];
+  for (vtkm::Int32 lane = 0; lane < 4; ++lane)
+  {
+    Precision xmin0 = xmin[lane] * invDir[0] - originDir[0];
+    Precision ymin0 = ymin[lane] * invDir[1] - originDir[1];
+    Precision zmin0 = zmin[lane] * invDir[2] - originDir[2];
+    Precision xmax0 = xmax[lane] * invDir[0] - originDir[0];
+    Precision ymax0 = ymax[lane] * invDir[1] - originDir[1];
+    Precision zmax0 = zmax[lane] * invDir[2] - originDir[2];
+    tmin[lane] = vtkm::Max(vtkm::Max(vtkm::Min(xmin0, xmax0), vtkm::Min(ymin0, ymax0)),
+                           vtkm::Max(vtkm::Min(zmin0, zmax0), minDistance));
+    tmax[lane] = vtkm::Min(vtkm::Min(vtkm::Max(xmin0, xmax0), vtkm::Max(ymin0, ymax0)),
+                           vtkm::Min(vtkm::Max(zmin0, zmax0), closestDistance));
+  }
+
+  // Insertion sort of the children hit, nearest first. An unused lane has a 0 child.
+  Precision hitDistances[4];
+  vtkm::Int32 hitCount = 0;
+  for (vtkm::Int32 lane = 0; lane < 4; ++lane)
+  {
+    if (children[lane] == 0 || tmax[lane] < tmin[lane])
+    {
+      continue;
+    }
+    vtkm::Int32 i = hitCount++;
+    while (i > 0 && hitDistances[i - 1] > tmin[lane])
+    {
+      hitDistances[i] = hitDistances[i - 1];
+      hitChildren[i] = hitChildren[i - 1];
+      i--;
+    }
+    hitDistances[i] = tmin[lane];
+    hitChildren[i] = children[lane];
+  }
+  return hitCount;
 }
 
 class BVHTraverser
@@ -125,7 +139,7 @@ public:
                               vtkm::Id& hitIndex,
                               const PointPortalType& points,
                               LeafType& leafIntersector,
-                              const InnerNodePortalType& flatBVH,
+                              const InnerNodePortalType& wideBVH,
                               const LeafPortalType& leafs) const
     {
       Precision closestDistance = maxDistance;
@@ -138,7 +152,9 @@ public:
       invDir[2] = rcp_safe(dir[2]);
       vtkm::Int32 currentNode;
 
-      vtkm::Int32 todo[64];
+      // A wide node pushes up to three children. Construct checks that the depth of the
+      // hierarchy fits the stack.
+      vtkm::Int32 todo[LinearBVH::WideStackSize];
       vtkm::Int32 stackptr = 0;
       vtkm::Int32 barrier = (vtkm::Int32)END_FLAG;
       currentNode = 0;
@@ -151,45 +167,24 @@ public:
       {
         if (currentNode > -1)
         {
+          vtkm::Int32 hitChildren[4];
+          vtkm::Int32 hitCount = IntersectWideAABB(
+            wideBVH, currentNode, originDir, invDir, closestDistance, minDistance, hitChildren);
 
-
-          bool hitLeftChild, hitRightChild;
-          bool rightCloser = IntersectAABB(flatBVH,
-                                           currentNode,
-                                           originDir,
-                                           invDir,
-                                           closestDistance,
-                                           hitLeftChild,
-                                           hitRightChild,
-                                           minDistance);
-
-          if (!hitLeftChild && !hitRightChild)
+          if (hitCount == 0)
           {
             currentNode = todo[stackptr];
             stackptr--;
           }
           else
           {
-            vtkm::Vec4f_32 children = flatBVH.Get(currentNode + 3); //Children.Get(currentNode);
-            vtkm::Int32 leftChild;
-            memcpy(&leftChild, &children[0], 4);
-            vtkm::Int32 rightChild;
-            memcpy(&rightChild, &children[1], 4);
-            currentNode = (hitLeftChild) ? leftChild : rightChild;
-            if (hitLeftChild && hitRightChild)
+            // Visit the nearest child first, the others are pushed farthest first.
+            for (vtkm::Int32 i = hitCount - 1; i > 0; --i)
             {
-              if (rightCloser)
-              {
-                currentNode = rightChild;
-                stackptr++;
-                todo[stackptr] = leftChild;
-              }
-              else
-              {
-                stackptr++;
-                todo[stackptr] = rightChild;
-              }
+              stackptr++;
+              todo[stackptr] = hitChildren[i];
             }
+            currentNode = hitChildren[0];
           }
         } // if inner node
 
@@ -235,7 +230,7 @@ public:
                              rays.HitIdx,
                              coordsHandle,
                              leafIntersector,
-                             bvh.FlatBVH,
+                             bvh.WideBVH,
                              bvh.Leafs);
   }
 }; // BVHTraverser
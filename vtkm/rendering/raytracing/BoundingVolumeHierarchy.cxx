@@ -14,6 +14,9 @@
 #include <vtkm/VectorAnalysis.h>
 
 #include <vtkm/cont/Algorithm.h>
+#include <vtkm/cont/ArrayCopy.h>
+#include <vtkm/cont/ArrayHandleConstant.h>
+#include <vtkm/cont/ArrayHandleGroupVec.h>
 #include <vtkm/cont/DeviceAdapter.h>
 #include <vtkm/cont/DeviceAdapterAlgorithm.h>
 #include <vtkm/cont/Invoker.h>
@@ -58,6 +61,10 @@ public:
 
   class TreeBuilder;
 
+  class MarkWideLevel;
+
+  class CollapseNodes;
+
   VTKM_CONT
   LinearBVHBuilder() {}
 
@@ -66,6 +73,23 @@ public:
   VTKM_CONT void BuildHierarchy(BVHData& bvh);
 
   VTKM_CONT void Build(LinearBVH& linearBVH);
+
+  VTKM_CONT void Refit(LinearBVH& linearBVH, AABBs& aabbs);
+
+private:
+  // Sets the total bounds of the hierarchy to the extent of its AABBs.
+  VTKM_CONT void FindTotalBounds(LinearBVH& linearBVH);
+
+  // Writes the bounds of the inner nodes, from the leaves up.
+  VTKM_CONT void PropagateBounds(LinearBVH& linearBVH,
+                                 const vtkm::cont::ArrayHandle<vtkm::Id>& parent,
+                                 const vtkm::cont::ArrayHandle<vtkm::Id>& leftChild,
+                                 const vtkm::cont::ArrayHandle<vtkm::Id>& rightChild);
+
+  // Writes the 4-wide hierarchy the rays traverse from the binary one.
+  VTKM_CONT void CollapseToWide(LinearBVH& linearBVH,
+                                const vtkm::cont::ArrayHandle<vtkm::Id>& leftChild,
+                                const vtkm::cont::ArrayHandle<vtkm::Id>& rightChild);
 }; // class LinearBVHBuilder
 
 class LinearBVHBuilder::CountingIterator : public vtkm::worklet::WorkletMapField
@@ -157,13 +181,12 @@ public:
   vtkm::cont::ArrayHandle<vtkm::Id> leftChild;
   vtkm::cont::ArrayHandle<vtkm::Id> rightChild;
   vtkm::cont::ArrayHandle<vtkm::Id> leafs;
+  vtkm::cont::ArrayHandle<vtkm::Id> order;
   vtkm::cont::ArrayHandle<vtkm::Bounds> innerBounds;
-  vtkm::cont::ArrayHandleCounting<vtkm::Id> leafOffsets;
   AABBs& AABB;
 
   VTKM_CONT BVHData(vtkm::Id numPrimitives, AABBs& aabbs)
-    : leafOffsets(0, 2, numPrimitives)
-    , AABB(aabbs)
+    : AABB(aabbs)
     , NumPrimitives(numPrimitives)
   {
     InnerNodeCount = NumPrimitives - 1;
@@ -355,6 +378,135 @@ public:
   }
 }; //class PropagateAABBs
 
+// Flags whether the inner nodes of a level of the binary hierarchy head a node of the 4-wide
+// hierarchy, which the root and every other level below it do. Each of those nodes absorbs its
+// inner children, and their children become the (up to four) children of the wide node. The
+// children of the level are written out, so that the levels are marked from the root down.
+class LinearBVHBuilder::MarkWideLevel : public vtkm::worklet::WorkletMapField
+{
+private:
+  vtkm::Id IsWide;
+
+public:
+  VTKM_CONT
+  MarkWideLevel(bool isWide)
+    : IsWide(isWide ? 1 : 0)
+  {
+  }
+  using ControlSignature = void(FieldIn, FieldOut, WholeArrayIn, WholeArrayIn, WholeArrayOut);
+  using ExecutionSignature = void(_1, _2, _3, _4, _5);
+
+  template <typename ChildPortalType, typename IsWidePortalType>
+  VTKM_EXEC void operator()(const vtkm::Id& innerNode,
+                            vtkm::Id2& children,
+                            const ChildPortalType& leftChildren,
+                            const ChildPortalType& rightChildren,
+                            IsWidePortalType& isWide) const
+  {
+    isWide.Set(innerNode, this->IsWide);
+    children = vtkm::Id2(leftChildren.Get(innerNode), rightChildren.Get(innerNode));
+  }
+}; //class MarkWideLevel
+
+// Leaves are numbered after the inner nodes in the child arrays of the binary hierarchy.
+struct IsInnerNode
+{
+  vtkm::Id InnerCount;
+
+  VTKM_EXEC_CONT bool operator()(const vtkm::Id& node) const { return node < this->InnerCount; }
+};
+
+// Writes a node of the 4-wide hierarchy. A wide node is 7 Vec4f_32: the xmin, ymin, zmin, xmax,
+// ymax and zmax of its four children, lane by lane, then the four child references. References
+// to inner nodes are offsets into the wide hierarchy, references to leaves are negative like in
+// the binary hierarchy, and 0, the root, marks an unused lane.
+class LinearBVHBuilder::CollapseNodes : public vtkm::worklet::WorkletMapField
+{
+private:
+  template <typename FlatBVHPortalType>
+  VTKM_EXEC void ReadChildren(const FlatBVHPortalType& flatBVH,
+                              const vtkm::Int32& node,
+                              vtkm::Vec<vtkm::Float32, 6> boxes[2],
+                              vtkm::Int32 children[2]) const
+  {
+    const vtkm::Vec4f_32 first4 = flatBVH.Get(node);
+    const vtkm::Vec4f_32 second4 = flatBVH.Get(node + 1);
+    const vtkm::Vec4f_32 third4 = flatBVH.Get(node + 2);
+    const vtkm::Vec4f_32 fourth4 = flatBVH.Get(node + 3);
+    boxes[0] = vtkm::make_Vec(first4[0], first4[1], first4[2], first4[3], second4[0], second4[1]);
+    boxes[1] = vtkm::make_Vec(second4[2], second4[3], third4[0], third4[1], third4[2], third4[3]);
+    memcpy(&children[0], &fourth4[0], 4);
+    memcpy(&children[1], &fourth4[1], 4);
+  }
+
+  template <typename OffsetPortalType>
+  VTKM_EXEC void SetLane(vtkm::Vec4f_32 wideNode[7],
+                         const vtkm::IdComponent& lane,
+                         const vtkm::Vec<vtkm::Float32, 6>& box,
+                         vtkm::Int32 child,
+                         const OffsetPortalType& wideOffsets) const
+  {
+    for (vtkm::IdComponent i = 0; i < 6; ++i)
+    {
+      wideNode[i][lane] = box[i];
+    }
+    if (child >= 0)
+    {
+      child = static_cast<vtkm::Int32>(wideOffsets.Get(child / 4) * 7);
+    }
+    memcpy(&wideNode[6][lane], &child, 4);
+  }
+
+public:
+  VTKM_CONT
+  CollapseNodes() {}
+  using ControlSignature = void(FieldIn, FieldIn, WholeArrayIn, WholeArrayIn, WholeArrayOut);
+  using ExecutionSignature = void(WorkIndex, _1, _2, _3, _4, _5);
+
+  template <typename OffsetPortalType, typename FlatBVHPortalType, typename WideBVHPortalType>
+  VTKM_EXEC void operator()(const vtkm::Id& innerNode,
+                            const vtkm::Id& isWide,
+                            const vtkm::Id& wideOffset,
+                            const OffsetPortalType& wideOffsets,
+                            const FlatBVHPortalType& flatBVH,
+                            WideBVHPortalType& wideBVH) const
+  {
+    if (isWide == 0)
+    {
+      return;
+    }
+
+    vtkm::Vec4f_32 wideNode[7];
+    for (vtkm::IdComponent i = 0; i < 7; ++i)
+    {
+      wideNode[i] = vtkm::Vec4f_32(0.f);
+    }
+
+    vtkm::Vec<vtkm::Float32, 6> boxes[2];
+    vtkm::Int32 children[2];
+    ReadChildren(flatBVH, static_cast<vtkm::Int32>(innerNode * 4), boxes, children);
+    vtkm::IdComponent lane = 0;
+    for (vtkm::IdComponent c = 0; c < 2; ++c)
+    {
+      if (children[c] < 0)
+      {
+        SetLane(wideNode, lane++, boxes[c], children[c], wideOffsets);
+        continue;
+      }
+      vtkm::Vec<vtkm::Float32, 6> grandBoxes[2];
+      vtkm::Int32 grandChildren[2];
+      ReadChildren(flatBVH, children[c], grandBoxes, grandChildren);
+      SetLane(wideNode, lane++, grandBoxes[0], grandChildren[0], wideOffsets);
+      SetLane(wideNode, lane++, grandBoxes[1], grandChildren[1], wideOffsets);
+    }
+
+    for (vtkm::IdComponent i = 0; i < 7; ++i)
+    {
+      wideBVH.Set(wideOffset * 7 + i, wideNode[i]);
+    }
+  }
+}; //class CollapseNodes
+
 class LinearBVHBuilder::TreeBuilder : public vtkm::worklet::WorkletMapField
 {
 private:
@@ -511,7 +663,7 @@ public:
 VTKM_CONT void LinearBVHBuilder::SortAABBS(BVHData& bvh, bool singleAABB)
 {
   //create array of indexes to be sorted with morton codes
-  vtkm::cont::ArrayHandle<vtkm::Id> iterator;
+  vtkm::cont::ArrayHandle<vtkm::Id>& iterator = bvh.order;
   iterator.Allocate(bvh.GetNumberOfPrimitives());
 
   vtkm::worklet::DispatcherMapField<CountingIterator> iterDispatcher;
@@ -627,22 +779,14 @@ VTKM_CONT void LinearBVHBuilder::Build(LinearBVH& linearBVH)
 
 
   // Find the extent of all bounding boxes to generate normalization for morton codes
-  vtkm::Vec3f_32 minExtent(vtkm::Infinity32(), vtkm::Infinity32(), vtkm::Infinity32());
-  vtkm::Vec3f_32 maxExtent(
-    vtkm::NegativeInfinity32(), vtkm::NegativeInfinity32(), vtkm::NegativeInfinity32());
-  maxExtent[0] = vtkm::cont::Algorithm::Reduce(bvh.AABB.xmaxs, maxExtent[0], MaxValue());
-  maxExtent[1] = vtkm::cont::Algorithm::Reduce(bvh.AABB.ymaxs, maxExtent[1], MaxValue());
-  maxExtent[2] = vtkm::cont::Algorithm::Reduce(bvh.AABB.zmaxs, maxExtent[2], MaxValue());
-  minExtent[0] = vtkm::cont::Algorithm::Reduce(bvh.AABB.xmins, minExtent[0], MinValue());
-  minExtent[1] = vtkm::cont::Algorithm::Reduce(bvh.AABB.ymins, minExtent[1], MinValue());
-  minExtent[2] = vtkm::cont::Algorithm::Reduce(bvh.AABB.zmins, minExtent[2], MinValue());
-
-  linearBVH.TotalBounds.X.Min = minExtent[0];
-  linearBVH.TotalBounds.X.Max = maxExtent[0];
-  linearBVH.TotalBounds.Y.Min = minExtent[1];
-  linearBVH.TotalBounds.Y.Max = maxExtent[1];
-  linearBVH.TotalBounds.Z.Min = minExtent[2];
-  linearBVH.TotalBounds.Z.Max = maxExtent[2];
+  FindTotalBounds(linearBVH);
+  const vtkm::Bounds& totalBounds = linearBVH.TotalBounds;
+  vtkm::Vec3f_32 minExtent(static_cast<vtkm::Float32>(totalBounds.X.Min),
+                           static_cast<vtkm::Float32>(totalBounds.Y.Min),
+                           static_cast<vtkm::Float32>(totalBounds.Z.Min));
+  vtkm::Vec3f_32 maxExtent(static_cast<vtkm::Float32>(totalBounds.X.Max),
+                           static_cast<vtkm::Float32>(totalBounds.Y.Max),
+                           static_cast<vtkm::Float32>(totalBounds.Z.Max));
 
   vtkm::Vec3f_32 deltaExtent = maxExtent - minExtent;
   vtkm::Vec3f_32 inverseExtent;
@@ -669,42 +813,165 @@ VTKM_CONT void LinearBVHBuilder::Build(LinearBVH& linearBVH)
     TreeBuilder(bvh.GetNumberOfPrimitives()));
   treeDispatch.Invoke(bvh.leftChild, bvh.rightChild, bvh.mortonCodes, bvh.parent);
 
-  const vtkm::Int32 primitiveCount = vtkm::Int32(bvh.GetNumberOfPrimitives());
+  PropagateBounds(linearBVH, bvh.parent, bvh.leftChild, bvh.rightChild);
+  CollapseToWide(linearBVH, bvh.leftChild, bvh.rightChild);
+
+  linearBVH.Leafs = bvh.leafs;
+
+  // Keep the tree for refitting, if asked to. A single AABB was duplicated above, so new boxes
+  // could not be matched with the leaves: that hierarchy is just constructed again. Rays only
+  // traverse the wide hierarchy, so the binary one goes with the tree.
+  if (singleAABB || !linearBVH.KeepTreeForRefit)
+  {
+    linearBVH.FlatBVH.ReleaseResources();
+    linearBVH.Order.ReleaseResources();
+    linearBVH.Parents.ReleaseResources();
+    linearBVH.LeftChildren.ReleaseResources();
+    linearBVH.RightChildren.ReleaseResources();
+  }
+  else
+  {
+    linearBVH.Order = bvh.order;
+    linearBVH.Parents = bvh.parent;
+    linearBVH.LeftChildren = bvh.leftChild;
+    linearBVH.RightChildren = bvh.rightChild;
+  }
+}
+
+VTKM_CONT void LinearBVHBuilder::Refit(LinearBVH& linearBVH, AABBs& aabbs)
+{
+  // Gather the boxes in the order of the leaves. They are gathered into new arrays in case
+  // `aabbs` shares arrays with the hierarchy.
+  const vtkm::Id arraySize = linearBVH.Order.GetNumberOfValues();
+  AABBs sorted;
+  sorted.xmins.Allocate(arraySize);
+  sorted.ymins.Allocate(arraySize);
+  sorted.zmins.Allocate(arraySize);
+  sorted.xmaxs.Allocate(arraySize);
+  sorted.ymaxs.Allocate(arraySize);
+  sorted.zmaxs.Allocate(arraySize);
+  vtkm::worklet::DispatcherMapField<GatherFloat32> gatherDispatcher;
+  gatherDispatcher.Invoke(linearBVH.Order, aabbs.xmins, sorted.xmins);
+  gatherDispatcher.Invoke(linearBVH.Order, aabbs.ymins, sorted.ymins);
+  gatherDispatcher.Invoke(linearBVH.Order, aabbs.zmins, sorted.zmins);
+  gatherDispatcher.Invoke(linearBVH.Order, aabbs.xmaxs, sorted.xmaxs);
+  gatherDispatcher.Invoke(linearBVH.Order, aabbs.ymaxs, sorted.ymaxs);
+  gatherDispatcher.Invoke(linearBVH.Order, aabbs.zmaxs, sorted.zmaxs);
+  linearBVH.AABB = sorted;
+
+  FindTotalBounds(linearBVH);
+  linearBVH.FlatBVH.Allocate((linearBVH.LeafCount - 1) * 4);
+  PropagateBounds(
+    linearBVH, linearBVH.Parents, linearBVH.LeftChildren, linearBVH.RightChildren);
+  CollapseToWide(linearBVH, linearBVH.LeftChildren, linearBVH.RightChildren);
+}
+
+VTKM_CONT void LinearBVHBuilder::FindTotalBounds(LinearBVH& linearBVH)
+{
+  const AABBs& aabb = linearBVH.AABB;
+  vtkm::Vec3f_32 minExtent(vtkm::Infinity32(), vtkm::Infinity32(), vtkm::Infinity32());
+  vtkm::Vec3f_32 maxExtent(
+    vtkm::NegativeInfinity32(), vtkm::NegativeInfinity32(), vtkm::NegativeInfinity32());
+  maxExtent[0] = vtkm::cont::Algorithm::Reduce(aabb.xmaxs, maxExtent[0], MaxValue());
+  maxExtent[1] = vtkm::cont::Algorithm::Reduce(aabb.ymaxs, maxExtent[1], MaxValue());
+  maxExtent[2] = vtkm::cont::Algorithm::Reduce(aabb.zmaxs, maxExtent[2], MaxValue());
+  minExtent[0] = vtkm::cont::Algorithm::Reduce(aabb.xmins, minExtent[0], MinValue());
+  minExtent[1] = vtkm::cont::Algorithm::Reduce(aabb.ymins, minExtent[1], MinValue());
+  minExtent[2] = vtkm::cont::Algorithm::Reduce(aabb.zmins, minExtent[2], MinValue());
+
+  linearBVH.TotalBounds.X.Min = minExtent[0];
+  linearBVH.TotalBounds.X.Max = maxExtent[0];
+  linearBVH.TotalBounds.Y.Min = minExtent[1];
+  linearBVH.TotalBounds.Y.Max = maxExtent[1];
+  linearBVH.TotalBounds.Z.Min = minExtent[2];
+  linearBVH.TotalBounds.Z.Max = maxExtent[2];
+}
+
+VTKM_CONT void LinearBVHBuilder::PropagateBounds(
+  LinearBVH& linearBVH,
+  const vtkm::cont::ArrayHandle<vtkm::Id>& parent,
+  const vtkm::cont::ArrayHandle<vtkm::Id>& leftChild,
+  const vtkm::cont::ArrayHandle<vtkm::Id>& rightChild)
+{
+  const vtkm::Id leafCount = linearBVH.LeafCount;
+  const vtkm::Int32 primitiveCount = vtkm::Int32(leafCount);
 
   vtkm::cont::ArrayHandle<vtkm::Int32> counters;
-  counters.Allocate(bvh.GetNumberOfPrimitives() - 1);
+  counters.Allocate(leafCount - 1);
 
-  vtkm::cont::ArrayHandleConstant<vtkm::Int32> zero(0, bvh.GetNumberOfPrimitives() - 1);
+  vtkm::cont::ArrayHandleConstant<vtkm::Int32> zero(0, leafCount - 1);
   vtkm::cont::Algorithm::Copy(zero, counters);
 
   vtkm::worklet::DispatcherMapField<PropagateAABBs> propDispatch(PropagateAABBs{ primitiveCount });
 
-  propDispatch.Invoke(bvh.AABB.xmins,
-                      bvh.AABB.ymins,
-                      bvh.AABB.zmins,
-                      bvh.AABB.xmaxs,
-                      bvh.AABB.ymaxs,
-                      bvh.AABB.zmaxs,
-                      bvh.leafOffsets,
-                      bvh.parent,
-                      bvh.leftChild,
-                      bvh.rightChild,
+  propDispatch.Invoke(linearBVH.AABB.xmins,
+                      linearBVH.AABB.ymins,
+                      linearBVH.AABB.zmins,
+                      linearBVH.AABB.xmaxs,
+                      linearBVH.AABB.ymaxs,
+                      linearBVH.AABB.zmaxs,
+                      vtkm::cont::ArrayHandleCounting<vtkm::Id>(0, 2, leafCount),
+                      parent,
+                      leftChild,
+                      rightChild,
                       counters,
                       linearBVH.FlatBVH);
+}
 
-  linearBVH.Leafs = bvh.leafs;
+VTKM_CONT void LinearBVHBuilder::CollapseToWide(
+  LinearBVH& linearBVH,
+  const vtkm::cont::ArrayHandle<vtkm::Id>& leftChild,
+  const vtkm::cont::ArrayHandle<vtkm::Id>& rightChild)
+{
+  const vtkm::Id innerCount = linearBVH.LeafCount - 1;
+  vtkm::cont::ArrayHandle<vtkm::Id> isWide;
+  isWide.Allocate(innerCount);
+  vtkm::cont::ArrayHandle<vtkm::Id> level;
+  vtkm::cont::ArrayCopy(vtkm::cont::make_ArrayHandleConstant(vtkm::Id(0), 1), level);
+  vtkm::Id depth = 0;
+  while (level.GetNumberOfValues() > 0)
+  {
+    vtkm::cont::ArrayHandle<vtkm::Id> children;
+    vtkm::worklet::DispatcherMapField<MarkWideLevel> markDispatch(MarkWideLevel(depth % 2 == 0));
+    markDispatch.Invoke(
+      level, vtkm::cont::make_ArrayHandleGroupVec<2>(children), leftChild, rightChild, isWide);
+    vtkm::cont::Algorithm::CopyIf(children, children, level, IsInnerNode{ innerCount });
+    depth++;
+  }
+
+  // Rays push up to three children of each wide node along their path, on top of the barrier.
+  const vtkm::Id wideDepth = (depth + 1) / 2;
+  if (3 * wideDepth + 1 > LinearBVH::WideStackSize)
+  {
+    throw vtkm::cont::ErrorBadValue("Linear BVH: the hierarchy is too deep to be traversed.");
+  }
+
+  vtkm::cont::ArrayHandle<vtkm::Id> wideOffsets;
+  const vtkm::Id wideCount = vtkm::cont::Algorithm::ScanExclusive(isWide, wideOffsets);
+
+  linearBVH.WideBVH.Allocate(wideCount * 7);
+  vtkm::worklet::DispatcherMapField<CollapseNodes> collapseDispatch;
+  collapseDispatch.Invoke(isWide, wideOffsets, wideOffsets, linearBVH.FlatBVH, linearBVH.WideBVH);
+}
+
+template <typename T>
+vtkm::Id NumberOfBytes(const vtkm::cont::ArrayHandle<T>& array)
+{
+  return array.GetNumberOfValues() * static_cast<vtkm::Id>(sizeof(T));
 }
 } //namespace detail
 
 LinearBVH::LinearBVH()
   : IsConstructed(false)
-  , CanConstruct(false){};
+  , CanConstruct(false)
+  , KeepTreeForRefit(false){};
 
 VTKM_CONT
 LinearBVH::LinearBVH(AABBs& aabbs)
   : AABB(aabbs)
   , IsConstructed(false)
   , CanConstruct(true)
+  , KeepTreeForRefit(false)
 {
 }
 
@@ -712,10 +979,16 @@ VTKM_CONT
 LinearBVH::LinearBVH(const LinearBVH& other)
   : AABB(other.AABB)
   , FlatBVH(other.FlatBVH)
+  , WideBVH(other.WideBVH)
   , Leafs(other.Leafs)
   , LeafCount(other.LeafCount)
   , IsConstructed(other.IsConstructed)
   , CanConstruct(other.CanConstruct)
+  , KeepTreeForRefit(other.KeepTreeForRefit)
+  , Order(other.Order)
+  , Parents(other.Parents)
+  , LeftChildren(other.LeftChildren)
+  , RightChildren(other.RightChildren)
 {
 }
 
@@ -737,6 +1010,20 @@ void LinearBVH::Construct()
   builder.Build(*this);
 }
 
+void LinearBVH::Refit(AABBs& aabbs)
+{
+  const vtkm::Id numberOfAABBs = aabbs.xmins.GetNumberOfValues();
+  if ((numberOfAABBs < 2) || (numberOfAABBs != this->Order.GetNumberOfValues()))
+  {
+    this->SetData(aabbs);
+    this->Construct();
+    return;
+  }
+
+  detail::LinearBVHBuilder builder;
+  builder.Refit(*this, aabbs);
+}
+
 VTKM_CONT
 void LinearBVH::SetData(AABBs& aabbs)
 {
@@ -776,6 +1063,16 @@ AABBs& LinearBVH::GetAABBs()
 {
   return AABB;
 }
+
+vtkm::Id LinearBVH::GetNumberOfBytes() const
+{
+  return detail::NumberOfBytes(AABB.xmins) + detail::NumberOfBytes(AABB.ymins) +
+    detail::NumberOfBytes(AABB.zmins) + detail::NumberOfBytes(AABB.xmaxs) +
+    detail::NumberOfBytes(AABB.ymaxs) + detail::NumberOfBytes(AABB.zmaxs) +
+    detail::NumberOfBytes(FlatBVH) + detail::NumberOfBytes(WideBVH) +
+    detail::NumberOfBytes(Leafs) + detail::NumberOfBytes(Order) + detail::NumberOfBytes(Parents) +
+    detail::NumberOfBytes(LeftChildren) + detail::NumberOfBytes(RightChildren);
+}
 }
 }
 } // namespace vtkm::rendering::raytracing
@@ -31,6 +31,11 @@ struct AABBs
   vtkm::cont::ArrayHandle<vtkm::Float32> zmaxs;
 };
 
+namespace detail
+{
+class LinearBVHBuilder;
+}
+
 //
 // This is the data structure that is passed to the ray tracer.
 //
@@ -40,14 +45,33 @@ public:
   using InnerNodesHandle = vtkm::cont::ArrayHandle<vtkm::Vec4f_32>;
   using LeafNodesHandle = vtkm::cont::ArrayHandle<Id>;
   AABBs AABB;
+  // The binary hierarchy, kept after Construct only with KeepTreeForRefit.
   InnerNodesHandle FlatBVH;
+  // FlatBVH collapsed into nodes of up to four children, which is what rays traverse. Testing
+  // the four boxes of a node together halves the number of nodes visited per ray.
+  InnerNodesHandle WideBVH;
   LeafNodesHandle Leafs;
   vtkm::Bounds TotalBounds;
   vtkm::Id LeafCount;
 
+  // The size of the stack rays traverse WideBVH with. The hierarchy is split on 30 bit Morton
+  // codes, then on 32 bit primitive indices, so it is at most 62 levels deep, or 31 wide levels
+  // that push up to three children each.
+  static constexpr vtkm::Int32 WideStackSize = 96;
+
 protected:
   bool IsConstructed;
   bool CanConstruct;
+  bool KeepTreeForRefit;
+  // The tree built by Construct, kept only with KeepTreeForRefit so that Refit can update the
+  // bounds of its nodes. Order holds the index of the primitive of each leaf, in the order of
+  // the leaves.
+  vtkm::cont::ArrayHandle<vtkm::Id> Order;
+  vtkm::cont::ArrayHandle<vtkm::Id> Parents;
+  vtkm::cont::ArrayHandle<vtkm::Id> LeftChildren;
+  vtkm::cont::ArrayHandle<vtkm::Id> RightChildren;
+
+  friend class detail::LinearBVHBuilder;
 
 public:
   LinearBVH();
@@ -63,6 +87,26 @@ public:
   VTKM_CONT
   void Construct();
 
+  /// \brief Updates the hierarchy for new bounding boxes of the same primitives.
+  ///
+  /// `aabbs` must hold the boxes of the primitives the hierarchy was constructed for, in the
+  /// same order. The tree is kept and only the bounds of its nodes are recomputed, which skips
+  /// sorting the primitives along the Morton curve. This is much faster than `Construct`, and
+  /// the tree stays efficient as long as the primitives do not move far from their neighbors.
+  /// If the number of boxes changed, the hierarchy is constructed anew.
+  ///
+  VTKM_CONT
+  void Refit(AABBs& aabbs);
+
+  /// \brief Keeps the tree after `Construct`, which `Refit` needs to skip building it again.
+  ///
+  /// The tree, with the binary hierarchy in `FlatBVH`, costs about four ids and two nodes per
+  /// primitive, so it is dropped by default and `Refit` then constructs the hierarchy anew. Set
+  /// this before `Construct`.
+  ///
+  VTKM_CONT void SetKeepTreeForRefit(bool keep) { this->KeepTreeForRefit = keep; }
+  VTKM_CONT bool GetKeepTreeForRefit() const { return this->KeepTreeForRefit; }
+
   VTKM_CONT
   void SetData(AABBs& aabbs);
 
@@ -73,6 +117,9 @@ public:
   bool GetIsConstructed() const;
 
   vtkm::Id GetNumberOfAABBs() const;
+
+  /// \brief The memory held by the boxes and the nodes of the hierarchy, in bytes.
+  vtkm::Id GetNumberOfBytes() const;
 }; // class LinearBVH
 }
 }
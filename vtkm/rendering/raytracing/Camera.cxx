@@ -237,6 +237,8 @@ public:
   vtkm::Int32 Minx;
   vtkm::Int32 Miny;
   vtkm::Int32 SubsetWidth;
+  vtkm::Int32 ViewportMinX;
+  vtkm::Int32 ViewportMinY;
   vtkm::Vec3f_32 PixelDelta;
   vtkm::Vec3f_32 StartOffset;
 
@@ -261,6 +263,9 @@ public:
     camera.GetRealViewport(width, height, vl, vr, vb, vt);
     vtkm::Float32 _w = static_cast<vtkm::Float32>(width) * (vr - vl) / 2.f;
     vtkm::Float32 _h = static_cast<vtkm::Float32>(height) * (vt - vb) / 2.f;
+    // The subset may only cover part of the viewport when rendering a tile
+    ViewportMinX = static_cast<vtkm::Int32>(static_cast<vtkm::Float32>(width) * (1.f + vl) / 2.f);
+    ViewportMinY = static_cast<vtkm::Int32>(static_cast<vtkm::Float32>(height) * (1.f + vb) / 2.f);
     vtkm::Vec2f_32 minPoint(left, bottom);
     vtkm::Vec2f_32 maxPoint(right, top);
     vtkm::Vec2f_32 delta = maxPoint - minPoint;
@@ -302,19 +307,17 @@ public:
     // not where the rays might intersect data like
     // the perspective ray gen
     //
-    int i = vtkm::Int32(idx) % SubsetWidth;
-    int j = vtkm::Int32(idx) / SubsetWidth;
+    int i = vtkm::Int32(idx) % SubsetWidth + Minx;
+    int j = vtkm::Int32(idx) / SubsetWidth + Miny;
 
     vtkm::Vec3f_32 pos;
-    pos[0] = vtkm::Float32(i);
-    pos[1] = vtkm::Float32(j);
+    pos[0] = vtkm::Float32(i - ViewportMinX);
+    pos[1] = vtkm::Float32(j - ViewportMinY);
     pos[2] = 0.f;
     vtkm::Vec3f_32 origin = StartOffset + pos * PixelDelta;
     rayOriginX = origin[0];
     rayOriginY = origin[1];
     rayOriginZ = origin[2];
-    i += Minx;
-    j += Miny;
     pixelIndex = static_cast<vtkm::Id>(j * w + i);
   }
 
@@ -421,6 +424,12 @@ bool Camera::operator==(const Camera& other) const
     return false;
   if (this->SubsetMinY != other.SubsetMinY)
     return false;
+  if (this->TileOn != other.TileOn)
+    return false;
+  if (this->TileMin != other.TileMin)
+    return false;
+  if (this->TileMax != other.TileMax)
+    return false;
   if (this->FovY != other.FovY)
     return false;
   if (this->FovX != other.FovX)
@@ -464,6 +473,9 @@ Camera::Camera()
   this->SubsetHeight = 500;
   this->SubsetMinX = 0;
   this->SubsetMinY = 0;
+  this->TileOn = false;
+  this->TileMin = vtkm::Vec2i_32(0, 0);
+  this->TileMax = vtkm::Vec2i_32(0, 0);
   this->FovY = 30.f;
   this->FovX = 30.f;
   this->Zoom = 1.f;
@@ -567,6 +579,20 @@ vtkm::Int32 Camera::GetSubsetHeight() const
   return this->SubsetHeight;
 }
 
+VTKM_CONT
+void Camera::SetTile(const vtkm::Vec2i_32& min, const vtkm::Vec2i_32& max)
+{
+  this->TileOn = true;
+  this->TileMin = min;
+  this->TileMax = max;
+}
+
+VTKM_CONT
+void Camera::ClearTile()
+{
+  this->TileOn = false;
+}
+
 VTKM_CONT
 void Camera::SetZoom(const vtkm::Float32& zoom)
 {
@@ -994,6 +1020,19 @@ VTKM_CONT void Camera::UpdateDimensions(Ray<Precision>& rays,
     this->SubsetMinX = 0;
   }
 
+  if (this->TileOn)
+  {
+    // Only keep the part of the subset inside the tile
+    const vtkm::Int32 minX = vtkm::Max(this->SubsetMinX, this->TileMin[0]);
+    const vtkm::Int32 minY = vtkm::Max(this->SubsetMinY, this->TileMin[1]);
+    const vtkm::Int32 maxX = vtkm::Min(this->SubsetMinX + this->SubsetWidth, this->TileMax[0]);
+    const vtkm::Int32 maxY = vtkm::Min(this->SubsetMinY + this->SubsetHeight, this->TileMax[1]);
+    this->SubsetMinX = minX;
+    this->SubsetMinY = minY;
+    this->SubsetWidth = vtkm::Max(maxX - minX, 0);
+    this->SubsetHeight = vtkm::Max(maxY - minY, 0);
+  }
+
   // resize rays and buffers
   if (rays.NumRays != SubsetWidth * SubsetHeight)
   {
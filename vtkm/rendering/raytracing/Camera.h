@@ -33,6 +33,9 @@ private:
   vtkm::Int32 SubsetHeight;
   vtkm::Int32 SubsetMinX;
   vtkm::Int32 SubsetMinY;
+  bool TileOn;
+  vtkm::Vec2i_32 TileMin;
+  vtkm::Vec2i_32 TileMax;
   vtkm::Float32 FovX;
   vtkm::Float32 FovY;
   vtkm::Float32 Zoom;
@@ -88,6 +91,14 @@ public:
   VTKM_CONT
   vtkm::Int32 GetSubsetHeight() const;
 
+  // Only create the rays of the pixels from min up to max, excluded
+  VTKM_CONT
+  void SetTile(const vtkm::Vec2i_32& min, const vtkm::Vec2i_32& max);
+
+  // Create the rays of every pixel
+  VTKM_CONT
+  void ClearTile();
+
   VTKM_CONT
   void SetZoom(const vtkm::Float32& zoom);
 
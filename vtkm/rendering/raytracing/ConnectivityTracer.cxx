@@ -19,7 +19,6 @@
 #include <vtkm/rendering/raytracing/CellIntersector.h>
 #include <vtkm/rendering/raytracing/CellSampler.h>
 #include <vtkm/rendering/raytracing/CellTables.h>
-#include <vtkm/rendering/raytracing/MeshConnectivityBuilder.h>
 #include <vtkm/rendering/raytracing/Ray.h>
 #include <vtkm/rendering/raytracing/RayOperations.h>
 #include <vtkm/rendering/raytracing/RayTracingTypeDefs.h>
@@ -214,16 +213,7 @@ void ConnectivityTracer::SetVolumeData(const vtkm::cont::Field& scalarField,
 
   this->Integrator = Volume;
 
-  if (MeshContainer == nullptr)
-  {
-    delete MeshContainer;
-  }
-  MeshConnectivityBuilder builder;
-  MeshContainer = builder.BuildConnectivity(cellSet, coords);
-
-  Locator.SetCellSet(this->CellSet);
-  Locator.SetCoordinates(this->Coords);
-  Locator.Update();
+  this->SetMesh(cellSet, coords);
 }
 
 void ConnectivityTracer::SetEnergyData(const vtkm::cont::Field& absorption,
@@ -281,16 +271,36 @@ void ConnectivityTracer::SetEnergyData(const vtkm::cont::Field& absorption,
   //TODO: Need a way to tell if we have been updated
   this->Integrator = Energy;
 
-  if (MeshContainer == nullptr)
+  this->SetMesh(cellSet, coords);
+}
+
+void ConnectivityTracer::SetMeshConnectivityCache(
+  const std::shared_ptr<MeshConnectivityCache>& cache)
+{
+  if (!cache)
   {
-    delete MeshContainer;
+    throw vtkm::cont::ErrorBadValue("Mesh connectivity cache must not be null.");
   }
+  MeshCache = cache;
+}
+
+void ConnectivityTracer::SetMesh(const vtkm::cont::UnknownCellSet& cellSet,
+                                 const vtkm::cont::CoordinateSystem& coords)
+{
+  Logger* logger = Logger::GetInstance();
+  logger->OpenLogEntry("mesh_conn_cache");
+  vtkm::cont::Timer timer;
+  timer.Start();
+
+  const vtkm::Id hits = MeshCache->GetNumberOfHits();
+  Mesh = MeshCache->Get(cellSet, coords);
+  MeshContainer = Mesh->Connectivity.get();
 
-  MeshConnectivityBuilder builder;
-  MeshContainer = builder.BuildConnectivity(cellSet, coords);
-  Locator.SetCellSet(this->CellSet);
-  Locator.SetCoordinates(this->Coords);
-  Locator.Update();
+  logger->AddLogData("hit", MeshCache->GetNumberOfHits() > hits);
+  logger->AddLogData("mesh_conn_bytes", Mesh->NumberOfBytes);
+  logger->AddLogData("cached_meshes", MeshCache->GetNumberOfEntries());
+  logger->AddLogData("cached_bytes", MeshCache->GetNumberOfBytes());
+  logger->CloseLogEntry(timer.GetElapsedTime());
 }
 
 void ConnectivityTracer::SetBackgroundColor(const vtkm::Vec4f_32& backgroundColor)
@@ -1188,7 +1198,7 @@ void ConnectivityTracer::FindLostRays(Ray<FloatType>& rays, detail::RayTracking<
                       rays.Origin,
                       rays.Dir,
                       MeshContainer,
-                      &this->Locator);
+                      &this->Mesh->Locator);
 
   this->LostRayTime += timer.GetElapsedTime();
 }
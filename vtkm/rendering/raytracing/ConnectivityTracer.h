@@ -13,8 +13,8 @@
 #include <vtkm/rendering/vtkm_rendering_export.h>
 
 #include <vtkm/cont/ArrayHandle.h>
-#include <vtkm/cont/CellLocatorGeneral.h>
 
+#include <vtkm/rendering/raytracing/MeshConnectivityCache.h>
 #include <vtkm/rendering/raytracing/MeshConnectivityContainers.h>
 #include <vtkm/rendering/raytracing/PartialComposite.h>
 
@@ -72,19 +72,14 @@ class VTKM_RENDERING_EXPORT ConnectivityTracer
 {
 public:
   ConnectivityTracer()
-    : MeshContainer(nullptr)
+    : MeshCache(std::make_shared<MeshConnectivityCache>())
+    , MeshContainer(nullptr)
     , BumpEpsilon(1e-3)
     , CountRayStatus(false)
     , UnitScalar(1.f)
   {
-  }
-
-  ~ConnectivityTracer()
-  {
-    if (MeshContainer != nullptr)
-    {
-      delete MeshContainer;
-    }
+    // Without a shared cache, only keep the mesh traced last.
+    MeshCache->SetCapacity(1);
   }
 
   enum IntegrationMode
@@ -110,6 +105,13 @@ public:
 
   MeshConnectivityContainer* GetMeshContainer() { return MeshContainer; }
 
+  ///
+  /// Sets the cache the mesh connectivity is taken from. Sharing a cache
+  /// between tracers lets them reuse the connectivity of the meshes
+  /// traced before.
+  ///
+  void SetMeshConnectivityCache(const std::shared_ptr<MeshConnectivityCache>& cache);
+
   void Init();
 
   void SetDebugOn(bool on) { CountRayStatus = on; }
@@ -177,6 +179,9 @@ private:
   template <typename FloatType>
   void PrintRayStatus(Ray<FloatType>& rays);
 
+  void SetMesh(const vtkm::cont::UnknownCellSet& cellSet,
+               const vtkm::cont::CoordinateSystem& coords);
+
 protected:
   // Data set info
   vtkm::cont::Field ScalarField;
@@ -193,8 +198,10 @@ protected:
   vtkm::Id RaysLost;
   IntegrationMode Integrator;
 
+  std::shared_ptr<MeshConnectivityCache> MeshCache;
+  // Held so that MeshContainer stays valid if the cache drops the mesh.
+  std::shared_ptr<MeshConnectivityCache::Structures> Mesh;
   MeshConnectivityContainer* MeshContainer;
-  vtkm::cont::CellLocatorGeneral Locator;
   vtkm::Float64 BumpEpsilon;
   vtkm::Float64 BumpDistance;
   //
@@ -431,19 +431,32 @@ void CylinderIntersector::SetData(const vtkm::cont::CoordinateSystem& coords,
   this->CylIds = cylIds;
   this->CoordsHandle = coords;
   AABBs AABB;
+  this->FindAABBs(AABB);
+  this->SetAABBs(AABB);
+}
 
+void CylinderIntersector::Refit(const vtkm::cont::CoordinateSystem& coords,
+                                vtkm::cont::ArrayHandle<vtkm::Float32> radii)
+{
+  this->Radii = radii;
+  this->CoordsHandle = coords;
+  AABBs AABB;
+  this->FindAABBs(AABB);
+  this->RefitAABBs(AABB);
+}
+
+void CylinderIntersector::FindAABBs(AABBs& aabbs)
+{
   vtkm::worklet::DispatcherMapField<detail::FindCylinderAABBs>(detail::FindCylinderAABBs())
     .Invoke(this->CylIds,
             this->Radii,
-            AABB.xmins,
-            AABB.ymins,
-            AABB.zmins,
-            AABB.xmaxs,
-            AABB.ymaxs,
-            AABB.zmaxs,
+            aabbs.xmins,
+            aabbs.ymins,
+            aabbs.zmins,
+            aabbs.xmaxs,
+            aabbs.ymaxs,
+            aabbs.zmaxs,
             CoordsHandle);
-
-  this->SetAABBs(AABB);
 }
 
 void CylinderIntersector::IntersectRays(Ray<vtkm::Float32>& rays, bool returnCellIndex)
@@ -27,6 +27,7 @@ class CylinderIntersector : public ShapeIntersector
 protected:
   vtkm::cont::ArrayHandle<vtkm::Id3> CylIds;
   vtkm::cont::ArrayHandle<vtkm::Float32> Radii;
+  void FindAABBs(AABBs& aabbs);
 
 public:
   CylinderIntersector();
@@ -37,6 +38,13 @@ public:
                vtkm::cont::ArrayHandle<vtkm::Id3> cylIds,
                vtkm::cont::ArrayHandle<vtkm::Float32> radii);
 
+  //
+  // Moves the cylinders to new coordinates and radii, keeping their ids. The BVH is refit
+  // instead of constructed, which is much faster than calling SetData again.
+  //
+  void Refit(const vtkm::cont::CoordinateSystem& coords,
+             vtkm::cont::ArrayHandle<vtkm::Float32> radii);
+
   void IntersectRays(Ray<vtkm::Float32>& rays, bool returnCellIndex = false) override;
 
 
@@ -0,0 +1,222 @@
+//============================================================================
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//============================================================================
+#include <vtkm/rendering/raytracing/LevelOfDetailCache.h>
+
+#include <vtkm/VectorAnalysis.h>
+#include <vtkm/cont/ArrayHandleGroupVec.h>
+#include <vtkm/cont/CellSetSingleType.h>
+#include <vtkm/cont/Logging.h>
+#include <vtkm/filter/geometry_refinement/worklet/VertexClustering.h>
+#include <vtkm/rendering/raytracing/TriangleExtractor.h>
+#include <vtkm/worklet/DispatcherMapField.h>
+#include <vtkm/worklet/WorkletMapField.h>
+
+namespace vtkm
+{
+namespace rendering
+{
+namespace raytracing
+{
+
+namespace
+{
+
+// Coarser grids would reduce small meshes to a handful of points.
+constexpr vtkm::Id MinimumDivisions = 8;
+// Finer grids are past the resolution of any screen.
+constexpr vtkm::Id MaximumDivisions = vtkm::Id(1) << 16;
+// Decimating is not worth it if it keeps more than this fraction of the triangles.
+constexpr vtkm::Float64 MaximumTriangleRatio = 0.5;
+
+// (cellid, v0, v1, v2) to the points of a triangle cell.
+class TriangleConnectivity : public vtkm::worklet::WorkletMapField
+{
+public:
+  using ControlSignature = void(FieldIn triangles, FieldOut points);
+  using ExecutionSignature = void(_1, _2);
+
+  template <typename PointsVecType>
+  VTKM_EXEC void operator()(const vtkm::Id4& triangle, PointsVecType& points) const
+  {
+    points[0] = triangle[1];
+    points[1] = triangle[2];
+    points[2] = triangle[3];
+  }
+};
+
+// The points of a decimated triangle, and the cell id of the input triangle it comes from, to
+// (cellid, v0, v1, v2).
+class DecimatedTriangles : public vtkm::worklet::WorkletMapField
+{
+public:
+  using ControlSignature = void(FieldIn inputTriangleIds,
+                                FieldIn points,
+                                WholeArrayIn inputTriangles,
+                                FieldOut triangles);
+  using ExecutionSignature = void(_1, _2, _3, _4);
+
+  template <typename PointsVecType, typename TrianglesPortalType>
+  VTKM_EXEC void operator()(const vtkm::Id& inputTriangleId,
+                            const PointsVecType& points,
+                            const TrianglesPortalType& inputTriangles,
+                            vtkm::Id4& triangle) const
+  {
+    triangle[0] = inputTriangles.Get(inputTriangleId)[0];
+    triangle[1] = points[0];
+    triangle[2] = points[1];
+    triangle[3] = points[2];
+  }
+};
+
+std::shared_ptr<LevelOfDetailCache::Level> BuildLevel(const vtkm::cont::UnknownCellSet& cellSet,
+                                                      const vtkm::cont::CoordinateSystem& coords,
+                                                      vtkm::Id divisions)
+{
+  auto level = std::make_shared<LevelOfDetailCache::Level>();
+  level->Divisions = divisions;
+
+  TriangleExtractor extractor;
+  extractor.ExtractCells(cellSet);
+  vtkm::cont::ArrayHandle<vtkm::Id4> inputTriangles = extractor.GetTriangles();
+  level->NumberOfInputTriangles = inputTriangles.GetNumberOfValues();
+  level->NumberOfTriangles = level->NumberOfInputTriangles;
+  const vtkm::Bounds bounds = coords.GetBounds();
+  if (level->NumberOfInputTriangles == 0 || !bounds.IsNonEmpty())
+  {
+    return level;
+  }
+
+  vtkm::cont::ArrayHandle<vtkm::Id> connectivity;
+  vtkm::worklet::DispatcherMapField<TriangleConnectivity>().Invoke(
+    inputTriangles, vtkm::cont::make_ArrayHandleGroupVec<3>(connectivity));
+  vtkm::cont::CellSetSingleType<> triangleCells;
+  triangleCells.Fill(coords.GetNumberOfPoints(), vtkm::CELL_SHAPE_TRIANGLE, 3, connectivity);
+
+  // Bins are cubes, so the grid is laid over the bounds grown to a whole number of bins. This
+  // also gives flat meshes a bin across their flat side.
+  const vtkm::Float64 longest =
+    vtkm::Max(bounds.X.Length(), vtkm::Max(bounds.Y.Length(), bounds.Z.Length()));
+  const vtkm::Float64 binSize = longest / static_cast<vtkm::Float64>(divisions);
+  vtkm::Bounds gridBounds = bounds;
+  vtkm::Id3 gridDivisions;
+  vtkm::Range* ranges[3] = { &gridBounds.X, &gridBounds.Y, &gridBounds.Z };
+  for (vtkm::IdComponent i = 0; i < 3; ++i)
+  {
+    gridDivisions[i] = vtkm::Max(
+      vtkm::Id(1), static_cast<vtkm::Id>(vtkm::Ceil(ranges[i]->Length() / binSize)));
+    ranges[i]->Max = ranges[i]->Min + static_cast<vtkm::Float64>(gridDivisions[i]) * binSize;
+  }
+
+  vtkm::worklet::VertexClustering clustering;
+  vtkm::cont::UnknownCellSet decimatedCells;
+  vtkm::cont::UnknownArrayHandle decimatedPoints;
+  clustering.Run(
+    triangleCells, coords, gridBounds, gridDivisions, decimatedCells, decimatedPoints);
+  const vtkm::Id numberOfTriangles = decimatedCells.GetNumberOfCells();
+  if (static_cast<vtkm::Float64>(numberOfTriangles) >
+      MaximumTriangleRatio * static_cast<vtkm::Float64>(level->NumberOfInputTriangles))
+  {
+    return level;
+  }
+
+  vtkm::cont::ArrayHandle<vtkm::Id4> triangles;
+  vtkm::worklet::DispatcherMapField<DecimatedTriangles>().Invoke(
+    clustering.GetCellIdMap(),
+    vtkm::cont::make_ArrayHandleGroupVec<3>(
+      decimatedCells.AsCellSet<vtkm::cont::CellSetSingleType<>>().GetConnectivityArray(
+        vtkm::TopologyElementTagCell(), vtkm::TopologyElementTagPoint())),
+    inputTriangles,
+    triangles);
+
+  level->NumberOfTriangles = numberOfTriangles;
+  level->PointIds = clustering.GetPointIdMap();
+  level->Intersector = std::make_shared<TriangleIntersector>();
+  level->Intersector->SetData(vtkm::cont::CoordinateSystem(coords.GetName(), decimatedPoints),
+                              triangles);
+  return level;
+}
+
+} // anonymous namespace
+
+LevelOfDetailCache::LevelOfDetailCache() = default;
+
+LevelOfDetailCache::~LevelOfDetailCache() = default;
+
+std::shared_ptr<LevelOfDetailCache::Level> LevelOfDetailCache::Get(
+  const vtkm::cont::UnknownCellSet& cellSet,
+  const vtkm::cont::CoordinateSystem& coords,
+  vtkm::Id divisions)
+{
+  const vtkm::cont::internal::MeshKey key(cellSet, coords);
+  using Entry = vtkm::cont::internal::MeshCache<std::shared_ptr<Level>>::Entry;
+  Entry* found = this->Entries.Find([&](const Entry& entry) {
+    return entry.Mesh.Matches(key) && (entry.Value->Divisions == divisions);
+  });
+  if (found)
+  {
+    return found->Value;
+  }
+
+  VTKM_LOG_S(vtkm::cont::LogLevel::Perf,
+             "LevelOfDetailCache decimating mesh to " << divisions << " divisions");
+  std::shared_ptr<Level> level = BuildLevel(cellSet, coords, divisions);
+
+  // Levels built for an older version of these arrays will never be used again.
+  this->Entries.Insert(key, level, [&](const Entry& entry) {
+    return entry.Mesh.SameArrays(key) && !entry.Mesh.Matches(key);
+  });
+  return level;
+}
+
+vtkm::Id LevelOfDetailCache::GetDivisions(const vtkm::rendering::Camera& camera,
+                                          vtkm::Id vtkmNotUsed(width),
+                                          vtkm::Id height,
+                                          const vtkm::Bounds& bounds,
+                                          vtkm::Float64 pixelSize)
+{
+  if (camera.GetMode() != vtkm::rendering::Camera::Mode::ThreeD || !bounds.IsNonEmpty() ||
+      height < 1 || !(pixelSize > 0.))
+  {
+    return 0;
+  }
+
+  // Pixels are smallest where the bounds are nearest to the camera.
+  const vtkm::Vec3f_64 position(camera.GetPosition());
+  const vtkm::Vec3f_64 nearest(vtkm::Max(bounds.X.Min, vtkm::Min(position[0], bounds.X.Max)),
+                               vtkm::Max(bounds.Y.Min, vtkm::Min(position[1], bounds.Y.Max)),
+                               vtkm::Max(bounds.Z.Min, vtkm::Min(position[2], bounds.Z.Max)));
+  const vtkm::Float64 distance = vtkm::Magnitude(position - nearest);
+  const vtkm::Float64 longest =
+    vtkm::Max(bounds.X.Length(), vtkm::Max(bounds.Y.Length(), bounds.Z.Length()));
+  if (!(distance > 0.) || !(longest > 0.))
+  {
+    return 0;
+  }
+
+  const vtkm::Float64 zoom = (camera.GetZoom() > 0.f) ? camera.GetZoom() : 1.;
+  const vtkm::Float64 pixel = 2. * distance *
+    vtkm::Tan(0.5 * vtkm::Pi_180() * static_cast<vtkm::Float64>(camera.GetFieldOfView())) /
+    (static_cast<vtkm::Float64>(height) * zoom);
+  const vtkm::Float64 divisions = longest / (pixel * pixelSize);
+  if (!(divisions <= static_cast<vtkm::Float64>(MaximumDivisions)))
+  {
+    return 0;
+  }
+  vtkm::Id result = MinimumDivisions;
+  while (static_cast<vtkm::Float64>(result) < divisions)
+  {
+    result *= 2;
+  }
+  return result;
+}
+
+}
+}
+} //namespace vtkm::rendering::raytracing
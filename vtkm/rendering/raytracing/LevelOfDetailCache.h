@@ -0,0 +1,102 @@
+//============================================================================
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//============================================================================
+#ifndef vtk_m_rendering_raytracing_LevelOfDetailCache_h
+#define vtk_m_rendering_raytracing_LevelOfDetailCache_h
+
+#include <vtkm/Bounds.h>
+#include <vtkm/cont/ArrayHandle.h>
+#include <vtkm/cont/CoordinateSystem.h>
+#include <vtkm/cont/UnknownCellSet.h>
+#include <vtkm/cont/internal/MeshCache.h>
+#include <vtkm/rendering/Camera.h>
+#include <vtkm/rendering/raytracing/TriangleIntersector.h>
+#include <vtkm/rendering/vtkm_rendering_export.h>
+
+#include <memory>
+
+namespace vtkm
+{
+namespace rendering
+{
+namespace raytracing
+{
+
+/// \brief Keeps decimated copies of the triangle meshes a mapper renders.
+///
+/// A surface seen from afar, or with more triangles than the pixels it covers, still costs its
+/// full triangle count to extract and to build a BVH over. A level of detail merges the
+/// vertices that fall in the same bin of a uniform grid over the mesh bounds, and drops the
+/// triangles that collapse (see `vtkm::worklet::VertexClustering`). `GetDivisions` picks a grid
+/// whose bins are about the size of a pixel for a camera.
+///
+/// Levels are keyed on the arrays of the cell set and coordinates (see
+/// `vtkm::cont::internal::MeshKey`) and on the grid divisions. Divisions are powers of two, so
+/// that a camera moving a little keeps using the same level. The cache keeps the
+/// `GetCapacity()` most recently used levels, and the arrays of their meshes.
+///
+class VTKM_RENDERING_EXPORT LevelOfDetailCache
+{
+public:
+  /// \brief A decimated copy of a mesh.
+  struct Level
+  {
+    /// The number of bins of the grid along the longest side of the mesh bounds.
+    vtkm::Id Divisions = 0;
+    /// Intersects rays with the decimated triangles. Null when decimating removes too few
+    /// triangles to pay off, in which case the mesh is best rendered as is.
+    std::shared_ptr<TriangleIntersector> Intersector;
+    /// For each point of the decimated mesh, a point of the input it stands for. Point fields
+    /// are mapped to the decimated mesh with it. Triangles keep the ids of their input cells.
+    vtkm::cont::ArrayHandle<vtkm::Id> PointIds;
+    vtkm::Id NumberOfInputTriangles = 0;
+    vtkm::Id NumberOfTriangles = 0;
+  };
+
+  LevelOfDetailCache();
+  ~LevelOfDetailCache();
+
+  /// \brief Returns the level of a mesh for a grid of `divisions` bins along its longest side,
+  /// building it if it is not in the cache.
+  std::shared_ptr<Level> Get(const vtkm::cont::UnknownCellSet& cellSet,
+                             const vtkm::cont::CoordinateSystem& coords,
+                             vtkm::Id divisions);
+
+  /// \brief The grid divisions at which a bin of `bounds` is `pixelSize` pixels wide.
+  ///
+  /// Bins are measured where the bounds are nearest to the camera, and the result is rounded
+  /// up to a power of two. Returns 0 when the mesh should be rendered at full resolution, such
+  /// as when the camera is inside the bounds or is not a 3D camera.
+  ///
+  static vtkm::Id GetDivisions(const vtkm::rendering::Camera& camera,
+                               vtkm::Id width,
+                               vtkm::Id height,
+                               const vtkm::Bounds& bounds,
+                               vtkm::Float64 pixelSize);
+
+  /// \brief The maximum number of levels held. The default is 8, 0 disables caching.
+  void SetCapacity(vtkm::Id capacity) { this->Entries.SetCapacity(capacity); }
+  vtkm::Id GetCapacity() const { return this->Entries.GetCapacity(); }
+
+  vtkm::Id GetNumberOfEntries() const { return this->Entries.GetNumberOfEntries(); }
+
+  /// \brief The number of calls to `Get` that were served from the cache.
+  vtkm::Id GetNumberOfHits() const { return this->Entries.GetNumberOfHits(); }
+
+  void Clear() { this->Entries.Clear(); }
+
+private:
+  vtkm::cont::internal::MeshCache<std::shared_ptr<Level>> Entries{ 8 };
+};
+
+}
+}
+} //namespace vtkm::rendering::raytracing
+
+#endif //vtk_m_rendering_raytracing_LevelOfDetailCache_h
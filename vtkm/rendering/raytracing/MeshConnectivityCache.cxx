@@ -0,0 +1,65 @@
+//============================================================================
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//============================================================================
+#include <vtkm/rendering/raytracing/MeshConnectivityCache.h>
+
+#include <vtkm/cont/Logging.h>
+#include <vtkm/rendering/raytracing/MeshConnectivityBuilder.h>
+
+namespace vtkm
+{
+namespace rendering
+{
+namespace raytracing
+{
+
+MeshConnectivityCache::MeshConnectivityCache() = default;
+
+MeshConnectivityCache::~MeshConnectivityCache() = default;
+
+std::shared_ptr<MeshConnectivityCache::Structures> MeshConnectivityCache::Get(
+  const vtkm::cont::UnknownCellSet& cellSet,
+  const vtkm::cont::CoordinateSystem& coords)
+{
+  const vtkm::cont::internal::MeshKey key(cellSet, coords);
+  using Entry = vtkm::cont::internal::MeshCache<std::shared_ptr<Structures>>::Entry;
+  Entry* found = this->Entries.Find([&](const Entry& entry) { return entry.Mesh.Matches(key); });
+  if (found)
+  {
+    return found->Value;
+  }
+
+  VTKM_LOG_S(vtkm::cont::LogLevel::Perf, "MeshConnectivityCache building mesh connectivity");
+  auto structures = std::make_shared<Structures>();
+  MeshConnectivityBuilder builder;
+  structures->Connectivity.reset(builder.BuildConnectivity(cellSet, coords));
+  structures->Locator.SetCellSet(cellSet);
+  structures->Locator.SetCoordinates(coords);
+  structures->Locator.Update();
+  structures->NumberOfBytes = structures->Connectivity->GetNumberOfBytes();
+
+  // Structures built for an older version of these arrays will never be used again.
+  this->Entries.Insert(
+    key, structures, [&](const Entry& entry) { return entry.Mesh.SameArrays(key); });
+  return structures;
+}
+
+vtkm::Id MeshConnectivityCache::GetNumberOfBytes() const
+{
+  vtkm::Id bytes = 0;
+  for (const auto& entry : this->Entries.GetEntries())
+  {
+    bytes += entry.Value->NumberOfBytes;
+  }
+  return bytes;
+}
+
+}
+}
+} //namespace vtkm::rendering::raytracing
@@ -0,0 +1,85 @@
+//============================================================================
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//============================================================================
+#ifndef vtk_m_rendering_raytracing_MeshConnectivityCache_h
+#define vtk_m_rendering_raytracing_MeshConnectivityCache_h
+
+#include <vtkm/cont/CellLocatorGeneral.h>
+#include <vtkm/cont/CoordinateSystem.h>
+#include <vtkm/cont/UnknownCellSet.h>
+#include <vtkm/cont/internal/MeshCache.h>
+#include <vtkm/rendering/raytracing/MeshConnectivityContainers.h>
+#include <vtkm/rendering/vtkm_rendering_export.h>
+
+#include <memory>
+
+namespace vtkm
+{
+namespace rendering
+{
+namespace raytracing
+{
+
+/// \brief Keeps the mesh connectivity `ConnectivityTracer` builds, so that it survives across
+/// frames.
+///
+/// Before tracing rays through an unstructured mesh, `ConnectivityTracer` matches the faces of
+/// its cells to find the neighbors of every cell, builds a BVH of the external faces to find
+/// where rays enter the mesh, and builds a cell locator to recover rays lost between cells.
+/// This takes much longer than marching the rays of a frame, and only depends on the mesh: the
+/// camera, the scalar field and the transfer function can all change without invalidating it.
+///
+/// Structures are keyed on the arrays of the cell set and coordinates (see
+/// `vtkm::cont::internal::MeshKey`). The cache keeps the `GetCapacity()` most recently used
+/// ones, and the arrays of their meshes.
+///
+class VTKM_RENDERING_EXPORT MeshConnectivityCache
+{
+public:
+  /// \brief The structures built for a mesh.
+  struct Structures
+  {
+    /// Face connectivity and the BVH of the external faces.
+    std::unique_ptr<MeshConnectivityContainer> Connectivity;
+    /// Finds the cell holding a point, for rays that got lost.
+    vtkm::cont::CellLocatorGeneral Locator;
+    /// The memory held by `Connectivity`, in bytes.
+    vtkm::Id NumberOfBytes = 0;
+  };
+
+  MeshConnectivityCache();
+  ~MeshConnectivityCache();
+
+  /// \brief Returns the structures for a mesh, building them if they are not in the cache.
+  std::shared_ptr<Structures> Get(const vtkm::cont::UnknownCellSet& cellSet,
+                                  const vtkm::cont::CoordinateSystem& coords);
+
+  /// \brief The maximum number of meshes held. The default is 4, 0 disables caching.
+  void SetCapacity(vtkm::Id capacity) { this->Entries.SetCapacity(capacity); }
+  vtkm::Id GetCapacity() const { return this->Entries.GetCapacity(); }
+
+  vtkm::Id GetNumberOfEntries() const { return this->Entries.GetNumberOfEntries(); }
+
+  /// \brief The number of calls to `Get` that were served from the cache.
+  vtkm::Id GetNumberOfHits() const { return this->Entries.GetNumberOfHits(); }
+
+  /// \brief The memory held by the structures in the cache, in bytes.
+  vtkm::Id GetNumberOfBytes() const;
+
+  void Clear() { this->Entries.Clear(); }
+
+private:
+  vtkm::cont::internal::MeshCache<std::shared_ptr<Structures>> Entries{ 4 };
+};
+
+}
+}
+} //namespace vtkm::rendering::raytracing
+
+#endif //vtk_m_rendering_raytracing_MeshConnectivityCache_h
@@ -25,6 +25,15 @@ namespace rendering
 namespace raytracing
 {
 
+namespace
+{
+template <typename T>
+vtkm::Id NumberOfBytes(const vtkm::cont::ArrayHandle<T>& array)
+{
+  return array.GetNumberOfValues() * static_cast<vtkm::Id>(sizeof(T));
+}
+} // anonymous namespace
+
 MeshConnectivityContainer::MeshConnectivityContainer(){};
 MeshConnectivityContainer::~MeshConnectivityContainer(){};
 
@@ -48,6 +57,11 @@ void MeshConnectivityContainer::FindEntry(Ray<vtkm::Float64>& rays)
   this->FindEntryImpl(rays);
 }
 
+vtkm::Id MeshConnectivityContainer::GetNumberOfBytes() const
+{
+  return NumberOfBytes(this->Triangles) + this->Intersector.GetBVH().GetNumberOfBytes();
+}
+
 VTKM_CONT
 MeshConnectivityContainerUnstructured::MeshConnectivityContainerUnstructured(
   const vtkm::cont::CellSetExplicit<>& cellset,
@@ -88,6 +102,12 @@ MeshConnectivity MeshConnectivityContainerUnstructured::PrepareForExecution(
                           token);
 }
 
+vtkm::Id MeshConnectivityContainerUnstructured::GetNumberOfBytes() const
+{
+  return this->MeshConnectivityContainer::GetNumberOfBytes() +
+    NumberOfBytes(this->FaceConnectivity) + NumberOfBytes(this->FaceOffsets);
+}
+
 VTKM_CONT
 MeshConnectivityContainerSingleType::MeshConnectivityContainerSingleType(
   const vtkm::cont::CellSetSingleType<>& cellset,
@@ -145,6 +165,12 @@ MeshConnectivity MeshConnectivityContainerSingleType::PrepareForExecution(
                           token);
 }
 
+vtkm::Id MeshConnectivityContainerSingleType::GetNumberOfBytes() const
+{
+  return this->MeshConnectivityContainer::GetNumberOfBytes() +
+    NumberOfBytes(this->FaceConnectivity);
+}
+
 MeshConnectivityContainerStructured::MeshConnectivityContainerStructured(
   const vtkm::cont::CellSetStructured<3>& cellset,
   const vtkm::cont::CoordinateSystem& coords,
@@ -34,6 +34,12 @@ public:
 
   void FindEntry(Ray<vtkm::Float64>& rays);
 
+  /// \brief The memory held by the connectivity and the boundary BVH, in bytes.
+  ///
+  /// Arrays shared with the cell set are not counted.
+  ///
+  virtual vtkm::Id GetNumberOfBytes() const;
+
 protected:
   using Id4Handle = typename vtkm::cont::ArrayHandle<vtkm::Id4>;
   // Mesh Boundary
@@ -76,6 +82,8 @@ public:
 
   MeshConnectivity PrepareForExecution(vtkm::cont::DeviceAdapterId deviceId,
                                        vtkm::cont::Token& token) const override;
+
+  vtkm::Id GetNumberOfBytes() const override;
 };
 
 class MeshConnectivityContainerStructured : public MeshConnectivityContainer
@@ -130,6 +138,7 @@ public:
   MeshConnectivity PrepareForExecution(vtkm::cont::DeviceAdapterId deviceId,
                                        vtkm::cont::Token& token) const override;
 
+  vtkm::Id GetNumberOfBytes() const override;
 }; //UnstructuredSingleContainer
 }
 }
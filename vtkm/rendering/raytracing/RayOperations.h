@@ -214,6 +214,8 @@ public:
 
     vtkm::cont::ArrayHandle<T> emptyHandle;
 
+    rays.Intersection =
+      vtkm::cont::make_ArrayHandleCompositeVector(emptyHandle, emptyHandle, emptyHandle);
     rays.Normal =
       vtkm::cont::make_ArrayHandleCompositeVector(emptyHandle, emptyHandle, emptyHandle);
     rays.Origin =
@@ -257,6 +259,8 @@ public:
     //
     // restore the composite vectors
     //
+    rays.Intersection = vtkm::cont::make_ArrayHandleCompositeVector(
+      rays.IntersectionX, rays.IntersectionY, rays.IntersectionZ);
     rays.Normal =
       vtkm::cont::make_ArrayHandleCompositeVector(rays.NormalX, rays.NormalY, rays.NormalZ);
     rays.Origin =
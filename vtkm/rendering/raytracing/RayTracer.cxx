@@ -261,6 +261,7 @@ vtkm::Id RayTracer::GetNumberOfShapes() const
 void RayTracer::Clear()
 {
   Intersectors.clear();
+  NumberOfShapes = 0;
 }
 
 template <typename Precision>
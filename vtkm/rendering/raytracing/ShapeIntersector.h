@@ -28,6 +28,8 @@ protected:
   vtkm::cont::CoordinateSystem CoordsHandle;
   vtkm::Bounds ShapeBounds;
   void SetAABBs(AABBs& aabbs);
+  // Updates the BVH for new boxes of the same shapes, see LinearBVH::Refit.
+  void RefitAABBs(AABBs& aabbs);
 
 public:
   ShapeIntersector();
@@ -67,6 +69,12 @@ public:
 
   vtkm::Bounds GetShapeBounds() const;
   virtual vtkm::Id GetNumberOfShapes() const = 0;
+
+  const LinearBVH& GetBVH() const { return this->BVH; }
+
+  // Whether the BVH keeps its tree so that the shapes can be refit, see
+  // LinearBVH::SetKeepTreeForRefit. Set this before the data.
+  void SetKeepTreeForRefit(bool keep) { this->BVH.SetKeepTreeForRefit(keep); }
 }; // class ShapeIntersector
 }
 }
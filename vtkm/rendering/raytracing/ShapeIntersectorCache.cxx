@@ -0,0 +1,71 @@
+//============================================================================
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//============================================================================
+#include <vtkm/rendering/raytracing/ShapeIntersectorCache.h>
+
+namespace vtkm
+{
+namespace rendering
+{
+namespace raytracing
+{
+
+ShapeIntersectorCache::ShapeIntersectorCache() = default;
+
+ShapeIntersectorCache::~ShapeIntersectorCache() = default;
+
+std::shared_ptr<ShapeIntersector> ShapeIntersectorCache::Find(
+  const vtkm::cont::UnknownCellSet& cellSet,
+  const vtkm::cont::CoordinateSystem& coords,
+  const std::vector<vtkm::Float64>& parameters,
+  MatchType& match)
+{
+  match = MatchType::None;
+  const vtkm::cont::internal::MeshKey key(cellSet, coords);
+  if (!key.IsValid())
+  {
+    return nullptr;
+  }
+
+  using Entry = vtkm::cont::internal::MeshCache<Intersection>::Entry;
+  Entry* found = this->Entries.Find([&](const Entry& entry) {
+    return entry.Mesh.Matches(key) && (entry.Value.Parameters == parameters);
+  });
+  if (found)
+  {
+    match = MatchType::All;
+    return found->Value.Intersector;
+  }
+  found = this->Entries.Find([&](const Entry& entry) { return entry.Mesh.CellSetMatches(key); });
+  if (found)
+  {
+    match = MatchType::CellSet;
+    return found->Value.Intersector;
+  }
+  return nullptr;
+}
+
+void ShapeIntersectorCache::Insert(const vtkm::cont::UnknownCellSet& cellSet,
+                                   const vtkm::cont::CoordinateSystem& coords,
+                                   const std::vector<vtkm::Float64>& parameters,
+                                   const std::shared_ptr<ShapeIntersector>& intersector)
+{
+  const vtkm::cont::internal::MeshKey key(cellSet, coords);
+  // An intersector refit for this mesh no longer fits the mesh it was built for, and one built
+  // for an older version of the cell set will never be used again.
+  using Entry = vtkm::cont::internal::MeshCache<Intersection>::Entry;
+  this->Entries.Insert(key, { parameters, intersector }, [&](const Entry& entry) {
+    return (entry.Value.Intersector == intersector) || entry.Mesh.CellSetMatches(key) ||
+      (entry.Mesh.SameArrays(key) && !entry.Mesh.Matches(key));
+  });
+}
+
+}
+}
+} //namespace vtkm::rendering::raytracing
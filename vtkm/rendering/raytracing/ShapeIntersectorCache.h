@@ -0,0 +1,101 @@
+//============================================================================
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//============================================================================
+#ifndef vtk_m_rendering_raytracing_ShapeIntersectorCache_h
+#define vtk_m_rendering_raytracing_ShapeIntersectorCache_h
+
+#include <vtkm/cont/CoordinateSystem.h>
+#include <vtkm/cont/UnknownCellSet.h>
+#include <vtkm/cont/internal/MeshCache.h>
+#include <vtkm/rendering/raytracing/ShapeIntersector.h>
+#include <vtkm/rendering/vtkm_rendering_export.h>
+
+#include <memory>
+#include <vector>
+
+namespace vtkm
+{
+namespace rendering
+{
+namespace raytracing
+{
+
+/// \brief Keeps the shape intersectors a mapper built, so that they survive across frames.
+///
+/// Extracting the shapes of a mesh and constructing their BVH usually costs more than tracing
+/// the rays of a frame through them. A mapper renders the same actors over and over when only
+/// the camera moves, so it keeps the intersector of each mesh in this cache. Intersectors are
+/// keyed on the arrays of the cell set and coordinates (see `vtkm::cont::internal::MeshKey`),
+/// and on the parameters the shapes were extracted with, such as a radius.
+///
+/// When the cell set is unchanged but the coordinates or parameters are not, the shapes are the
+/// same and only their bounds moved: the intersector can be refit instead of built anew.
+///
+/// The cache keeps the `GetCapacity()` most recently used intersectors, and the arrays of their
+/// meshes.
+///
+class VTKM_RENDERING_EXPORT ShapeIntersectorCache
+{
+public:
+  enum struct MatchType
+  {
+    /// No intersector was built for this cell set.
+    None,
+    /// An intersector was built for this cell set, but with other coordinates or parameters.
+    CellSet,
+    /// The intersector was built for this very mesh and parameters.
+    All
+  };
+
+  ShapeIntersectorCache();
+  ~ShapeIntersectorCache();
+
+  /// \brief Finds the intersector built for a mesh.
+  ///
+  /// Returns a null pointer if there is none. Otherwise `match` tells whether the intersector
+  /// can be used as is, or must be refit and then given back with `Insert`.
+  ///
+  std::shared_ptr<ShapeIntersector> Find(const vtkm::cont::UnknownCellSet& cellSet,
+                                         const vtkm::cont::CoordinateSystem& coords,
+                                         const std::vector<vtkm::Float64>& parameters,
+                                         MatchType& match);
+
+  /// \brief Adds the intersector built, or refit, for a mesh.
+  ///
+  /// Any other intersector of the same cell set is dropped. Nothing is added if the mesh cannot
+  /// be identified.
+  ///
+  void Insert(const vtkm::cont::UnknownCellSet& cellSet,
+              const vtkm::cont::CoordinateSystem& coords,
+              const std::vector<vtkm::Float64>& parameters,
+              const std::shared_ptr<ShapeIntersector>& intersector);
+
+  /// \brief The maximum number of intersectors held. The default is 8, 0 disables caching.
+  void SetCapacity(vtkm::Id capacity) { this->Entries.SetCapacity(capacity); }
+  vtkm::Id GetCapacity() const { return this->Entries.GetCapacity(); }
+
+  vtkm::Id GetNumberOfEntries() const { return this->Entries.GetNumberOfEntries(); }
+
+  void Clear() { this->Entries.Clear(); }
+
+private:
+  struct Intersection
+  {
+    std::vector<vtkm::Float64> Parameters;
+    std::shared_ptr<ShapeIntersector> Intersector;
+  };
+
+  vtkm::cont::internal::MeshCache<Intersection> Entries{ 8 };
+};
+
+}
+}
+} //namespace vtkm::rendering::raytracing
+
+#endif //vtk_m_rendering_raytracing_ShapeIntersectorCache_h
@@ -308,18 +308,32 @@ void SphereIntersector::SetData(const vtkm::cont::CoordinateSystem& coords,
   this->Radii = radii;
   this->CoordsHandle = coords;
   AABBs AABB;
+  this->FindAABBs(AABB);
+  this->SetAABBs(AABB);
+}
+
+void SphereIntersector::Refit(const vtkm::cont::CoordinateSystem& coords,
+                              vtkm::cont::ArrayHandle<vtkm::Float32> radii)
+{
+  this->Radii = radii;
+  this->CoordsHandle = coords;
+  AABBs AABB;
+  this->FindAABBs(AABB);
+  this->RefitAABBs(AABB);
+}
+
+void SphereIntersector::FindAABBs(AABBs& aabbs)
+{
   vtkm::worklet::DispatcherMapField<detail::FindSphereAABBs>(detail::FindSphereAABBs())
     .Invoke(PointIds,
             Radii,
-            AABB.xmins,
-            AABB.ymins,
-            AABB.zmins,
-            AABB.xmaxs,
-            AABB.ymaxs,
-            AABB.zmaxs,
+            aabbs.xmins,
+            aabbs.ymins,
+            aabbs.zmins,
+            aabbs.xmaxs,
+            aabbs.ymaxs,
+            aabbs.zmaxs,
             CoordsHandle);
-
-  this->SetAABBs(AABB);
 }
 
 void SphereIntersector::IntersectRays(Ray<vtkm::Float32>& rays, bool returnCellIndex)
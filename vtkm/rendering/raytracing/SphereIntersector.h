@@ -24,6 +24,7 @@ class SphereIntersector : public ShapeIntersector
 protected:
   vtkm::cont::ArrayHandle<vtkm::Id> PointIds;
   vtkm::cont::ArrayHandle<vtkm::Float32> Radii;
+  void FindAABBs(AABBs& aabbs);
 
 public:
   SphereIntersector();
@@ -33,6 +34,13 @@ public:
                vtkm::cont::ArrayHandle<vtkm::Id> pointIds,
                vtkm::cont::ArrayHandle<vtkm::Float32> radii);
 
+  //
+  // Moves the spheres to new coordinates and radii, keeping their point ids. The BVH is refit
+  // instead of constructed, which is much faster than calling SetData again.
+  //
+  void Refit(const vtkm::cont::CoordinateSystem& coords,
+             vtkm::cont::ArrayHandle<vtkm::Float32> radii);
+
   void IntersectRays(Ray<vtkm::Float32>& rays, bool returnCellIndex = false) override;
 
 
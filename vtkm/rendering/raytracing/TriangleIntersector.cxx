@@ -479,17 +479,30 @@ void TriangleIntersector::SetData(const vtkm::cont::CoordinateSystem& coords,
   Triangles = triangles;
 
   vtkm::rendering::raytracing::AABBs AABB;
+  this->FindAABBs(AABB);
+  this->SetAABBs(AABB);
+}
+
+void TriangleIntersector::Refit(const vtkm::cont::CoordinateSystem& coords)
+{
+  CoordsHandle = coords;
+
+  vtkm::rendering::raytracing::AABBs AABB;
+  this->FindAABBs(AABB);
+  this->RefitAABBs(AABB);
+}
+
+void TriangleIntersector::FindAABBs(AABBs& aabbs)
+{
   vtkm::worklet::DispatcherMapField<detail::FindTriangleAABBs>(detail::FindTriangleAABBs())
     .Invoke(Triangles,
-            AABB.xmins,
-            AABB.ymins,
-            AABB.zmins,
-            AABB.xmaxs,
-            AABB.ymaxs,
-            AABB.zmaxs,
+            aabbs.xmins,
+            aabbs.ymins,
+            aabbs.zmins,
+            aabbs.xmaxs,
+            aabbs.ymaxs,
+            aabbs.zmaxs,
             CoordsHandle);
-
-  this->SetAABBs(AABB);
 }
 
 vtkm::cont::ArrayHandle<vtkm::Id4> TriangleIntersector::GetTriangles()
@@ -27,6 +27,7 @@ class VTKM_RENDERING_EXPORT TriangleIntersector : public ShapeIntersector
 protected:
   vtkm::cont::ArrayHandle<vtkm::Id4> Triangles;
   bool UseWaterTight;
+  void FindAABBs(AABBs& aabbs);
 
 public:
   TriangleIntersector();
@@ -36,6 +37,12 @@ public:
   void SetData(const vtkm::cont::CoordinateSystem& coords,
                vtkm::cont::ArrayHandle<vtkm::Id4> triangles);
 
+  //
+  // Moves the triangles to new coordinates, keeping their connectivity. The BVH is refit
+  // instead of constructed, which is much faster than calling SetData again.
+  //
+  void Refit(const vtkm::cont::CoordinateSystem& coords);
+
   vtkm::cont::ArrayHandle<vtkm::Id4> GetTriangles();
   vtkm::Id GetNumberOfShapes() const override;
 
@@ -12,8 +12,10 @@
 #include <iostream>
 #include <math.h>
 #include <stdio.h>
+#include <vtkm/cont/Algorithm.h>
 #include <vtkm/cont/ArrayHandleCartesianProduct.h>
 #include <vtkm/cont/ArrayHandleCounting.h>
+#include <vtkm/cont/ArrayHandleTransform.h>
 #include <vtkm/cont/ArrayHandleUniformPointCoordinates.h>
 #include <vtkm/cont/CellSetStructured.h>
 #include <vtkm/cont/ColorTable.h>
@@ -300,6 +302,194 @@ public:
 
 }; // class UniformLocator
 
+// Cells are grouped in bricks of BrickSize^3 cells, and each brick records the range of the
+// scalars sampled in it (a min-max grid). A brick whose range only maps to fully transparent
+// colors adds nothing to a ray, so rays skip it instead of sampling it.
+constexpr vtkm::Id BrickSize = 8;
+
+class FindBrickRanges : public vtkm::worklet::WorkletMapField
+{
+private:
+  vtkm::Id3 ScalarDims;
+  vtkm::Id3 BrickDims;
+  vtkm::Id Overlap;
+
+public:
+  VTKM_CONT
+  FindBrickRanges(const vtkm::Id3& cellDims, const vtkm::Id3& brickDims, bool assocPoints)
+    : ScalarDims(cellDims)
+    , BrickDims(brickDims)
+    , Overlap(0)
+  {
+    // Samples interpolate the points of their cell, which includes the points on the far faces
+    // of the brick.
+    if (assocPoints)
+    {
+      ScalarDims = cellDims + vtkm::Id3(1, 1, 1);
+      Overlap = 1;
+    }
+  }
+
+  using ControlSignature = void(FieldOut, WholeArrayIn);
+  using ExecutionSignature = void(WorkIndex, _1, _2);
+
+  template <typename ScalarPortalType>
+  VTKM_EXEC void operator()(const vtkm::Id& brickIndex,
+                            vtkm::Vec2f_32& range,
+                            const ScalarPortalType& scalars) const
+  {
+    const vtkm::Id3 brick(brickIndex % BrickDims[0],
+                          (brickIndex / BrickDims[0]) % BrickDims[1],
+                          brickIndex / (BrickDims[0] * BrickDims[1]));
+    vtkm::Id3 start;
+    vtkm::Id3 end;
+    for (vtkm::IdComponent dim = 0; dim < 3; ++dim)
+    {
+      start[dim] = brick[dim] * BrickSize;
+      end[dim] = vtkm::Min(start[dim] + BrickSize + Overlap, ScalarDims[dim]);
+    }
+
+    range[0] = vtkm::Infinity32();
+    range[1] = vtkm::NegativeInfinity32();
+    for (vtkm::Id k = start[2]; k < end[2]; ++k)
+    {
+      for (vtkm::Id j = start[1]; j < end[1]; ++j)
+      {
+        const vtkm::Id rowStart = (k * ScalarDims[1] + j) * ScalarDims[0];
+        for (vtkm::Id i = start[0]; i < end[0]; ++i)
+        {
+          const vtkm::Float32 scalar = static_cast<vtkm::Float32>(scalars.Get(rowStart + i));
+          range[0] = vtkm::Min(range[0], scalar);
+          range[1] = vtkm::Max(range[1], scalar);
+        }
+      }
+    }
+  }
+}; //class FindBrickRanges
+
+struct IsVisibleColor
+{
+  VTKM_EXEC_CONT vtkm::Id operator()(const vtkm::Vec4f_32& color) const
+  {
+    return (color[3] > 0.f) ? 1 : 0;
+  }
+};
+
+class FindEmptyBricks : public vtkm::worklet::WorkletMapField
+{
+private:
+  vtkm::Float32 MinScalar;
+  vtkm::Float32 InverseDeltaScalar;
+  vtkm::Id ColorMapSize;
+
+  VTKM_EXEC vtkm::Id GetColorIndex(const vtkm::Float32& scalar) const
+  {
+    // Same mapping as the samplers
+    const vtkm::Float32 normalizedScalar = (scalar - MinScalar) * InverseDeltaScalar;
+    const vtkm::Id colorIndex =
+      static_cast<vtkm::Id>(normalizedScalar * static_cast<vtkm::Float32>(ColorMapSize));
+    return vtkm::Min(ColorMapSize, vtkm::Max(vtkm::Id(0), colorIndex));
+  }
+
+public:
+  VTKM_CONT
+  FindEmptyBricks(const vtkm::Float32& minScalar,
+                  const vtkm::Float32& maxScalar,
+                  const vtkm::Id& colorMapSize)
+    : MinScalar(minScalar)
+    , InverseDeltaScalar(minScalar)
+    , ColorMapSize(colorMapSize - 1)
+  {
+    if ((maxScalar - minScalar) != 0.f)
+    {
+      InverseDeltaScalar = 1.f / (maxScalar - minScalar);
+    }
+  }
+
+  using ControlSignature = void(FieldIn, FieldOut, WholeArrayIn);
+  using ExecutionSignature = void(_1, _2, _3);
+
+  template <typename CountPortalType>
+  VTKM_EXEC void operator()(const vtkm::Vec2f_32& range,
+                            vtkm::UInt8& isEmpty,
+                            const CountPortalType& visibleCounts) const
+  {
+    // Interpolation can round a sample slightly out of the range of its brick, so look one
+    // color further on each side.
+    const vtkm::Id first = vtkm::Max(GetColorIndex(range[0]) - 1, vtkm::Id(0));
+    const vtkm::Id last = vtkm::Min(GetColorIndex(range[1]) + 1, ColorMapSize);
+    const vtkm::Id visible =
+      visibleCounts.Get(last) - ((first > 0) ? visibleCounts.Get(first - 1) : vtkm::Id(0));
+    isEmpty = (visible == 0) ? 1 : 0;
+  }
+}; //class FindEmptyBricks
+
+template <typename Device>
+class BrickSkipper
+{
+private:
+  using EmptyPortal = typename vtkm::cont::ArrayHandle<vtkm::UInt8>::ReadPortalType;
+  EmptyPortal EmptyBricks;
+  vtkm::Id3 CellDims;
+  vtkm::Id3 BrickDims;
+
+public:
+  BrickSkipper(const vtkm::cont::ArrayHandle<vtkm::UInt8>& emptyBricks,
+               const vtkm::Id3& cellDims,
+               const vtkm::Id3& brickDims,
+               vtkm::cont::Token& token)
+    : EmptyBricks(emptyBricks.PrepareForInput(Device(), token))
+    , CellDims(cellDims)
+    , BrickDims(brickDims)
+  {
+  }
+
+  VTKM_EXEC
+  inline bool IsEmpty(const vtkm::Id3& cell) const
+  {
+    const vtkm::Id brickIndex =
+      ((cell[2] / BrickSize) * BrickDims[1] + cell[1] / BrickSize) * BrickDims[0] +
+      cell[0] / BrickSize;
+    return EmptyBricks.Get(brickIndex) != 0;
+  }
+
+  //
+  // Returns the distance at which a ray leaves the brick holding a cell.
+  //
+  template <typename LocatorType>
+  VTKM_EXEC inline vtkm::Float32 GetBrickExit(const LocatorType& locator,
+                                              const vtkm::Id3& cell,
+                                              const vtkm::Vec3f_32& rayOrigin,
+                                              const vtkm::Vec3f_32& rayDir) const
+  {
+    vtkm::Id3 minCorner;
+    vtkm::Id3 maxCorner;
+    for (vtkm::IdComponent dim = 0; dim < 3; ++dim)
+    {
+      minCorner[dim] = (cell[dim] / BrickSize) * BrickSize;
+      maxCorner[dim] = vtkm::Min(minCorner[dim] + BrickSize, CellDims[dim]);
+    }
+    vtkm::Vec3f_32 minPoint;
+    vtkm::Vec3f_32 maxPoint;
+    locator.GetMinPoint(minCorner, minPoint);
+    locator.GetMinPoint(maxCorner, maxPoint);
+
+    vtkm::Float32 exitDistance = vtkm::Infinity32();
+    for (vtkm::IdComponent dim = 0; dim < 3; ++dim)
+    {
+      if (rayDir[dim] > 0.f)
+      {
+        exitDistance = vtkm::Min(exitDistance, (maxPoint[dim] - rayOrigin[dim]) / rayDir[dim]);
+      }
+      else if (rayDir[dim] < 0.f)
+      {
+        exitDistance = vtkm::Min(exitDistance, (minPoint[dim] - rayOrigin[dim]) / rayDir[dim]);
+      }
+    }
+    return exitDistance;
+  }
+}; // class BrickSkipper
+
 
 } //namespace
 
@@ -316,7 +506,9 @@ private:
   vtkm::Float32 SampleDistance;
   vtkm::Float32 InverseDeltaScalar;
   LocatorType Locator;
+  BrickSkipper<DeviceAdapterTag> Skipper;
   vtkm::Float32 MeshEpsilon;
+  vtkm::Float32 TerminationOpacity;
 
 public:
   VTKM_CONT
@@ -325,14 +517,18 @@ public:
           const vtkm::Float32& maxScalar,
           const vtkm::Float32& sampleDistance,
           const LocatorType& locator,
+          const BrickSkipper<DeviceAdapterTag>& skipper,
           const vtkm::Float32& meshEpsilon,
+          const vtkm::Float32& terminationOpacity,
           vtkm::cont::Token& token)
     : ColorMap(colorMap.PrepareForInput(DeviceAdapterTag(), token))
     , MinScalar(minScalar)
     , SampleDistance(sampleDistance)
     , InverseDeltaScalar(minScalar)
     , Locator(locator)
+    , Skipper(skipper)
     , MeshEpsilon(meshEpsilon)
+    , TerminationOpacity(terminationOpacity)
   {
     ColorMapSize = colorMap.GetNumberOfValues() - 1;
     if ((maxScalar - minScalar) != 0.f)
@@ -420,6 +616,18 @@ public:
 
         vtkm::Vec<vtkm::Id, 8> cellIndices;
         Locator.LocateCell(cell, sampleLocation, invSpacing);
+        if (Skipper.IsEmpty(cell))
+        {
+          // Step over the samples of the brick the same way they would have been taken
+          const vtkm::Float32 exitDistance =
+            Skipper.GetBrickExit(Locator, cell, rayOrigin, rayDir);
+          do
+          {
+            distance += SampleDistance;
+            sampleLocation = sampleLocation + SampleDistance * rayDir;
+          } while (distance <= exitDistance && distance < maxDistance);
+          continue;
+        }
         Locator.GetCellIndices(cell, cellIndices);
         Locator.GetPoint(cellIndices[0], bottomLeft);
 
@@ -481,7 +689,7 @@ public:
       ty = (sampleLocation[1] - bottomLeft[1]) * invSpacing[1];
       tz = (sampleLocation[2] - bottomLeft[2]) * invSpacing[2];
 
-      if (color[3] >= 1.f)
+      if (color[3] >= TerminationOpacity)
         break;
     }
 
@@ -513,7 +721,9 @@ private:
   vtkm::Float32 SampleDistance;
   vtkm::Float32 InverseDeltaScalar;
   LocatorType Locator;
+  BrickSkipper<DeviceAdapterTag> Skipper;
   vtkm::Float32 MeshEpsilon;
+  vtkm::Float32 TerminationOpacity;
 
 public:
   VTKM_CONT
@@ -522,14 +732,18 @@ public:
                    const vtkm::Float32& maxScalar,
                    const vtkm::Float32& sampleDistance,
                    const LocatorType& locator,
+                   const BrickSkipper<DeviceAdapterTag>& skipper,
                    const vtkm::Float32& meshEpsilon,
+                   const vtkm::Float32& terminationOpacity,
                    vtkm::cont::Token& token)
     : ColorMap(colorMap.PrepareForInput(DeviceAdapterTag(), token))
     , MinScalar(minScalar)
     , SampleDistance(sampleDistance)
     , InverseDeltaScalar(minScalar)
     , Locator(locator)
+    , Skipper(skipper)
     , MeshEpsilon(meshEpsilon)
+    , TerminationOpacity(terminationOpacity)
   {
     ColorMapSize = colorMap.GetNumberOfValues() - 1;
     if ((maxScalar - minScalar) != 0.f)
@@ -602,6 +816,18 @@ public:
       if (newCell)
       {
         Locator.LocateCell(cell, sampleLocation, invSpacing);
+        if (Skipper.IsEmpty(cell))
+        {
+          // Step over the samples of the brick the same way they would have been taken
+          const vtkm::Float32 exitDistance =
+            Skipper.GetBrickExit(Locator, cell, rayOrigin, rayDir);
+          do
+          {
+            distance += SampleDistance;
+            sampleLocation = sampleLocation + SampleDistance * rayDir;
+          } while (distance <= exitDistance && distance < maxDistance);
+          continue;
+        }
         vtkm::Id cellId = Locator.GetCellIndex(cell);
 
         scalar0 = vtkm::Float32(scalars.Get(cellId));
@@ -630,7 +856,7 @@ public:
       distance += SampleDistance;
       sampleLocation = sampleLocation + SampleDistance * rayDir;
 
-      if (color[3] >= 1.f)
+      if (color[3] >= TerminationOpacity)
         break;
       tx = (sampleLocation[0] - bottomLeft[0]) * invSpacing[0];
       ty = (sampleLocation[1] - bottomLeft[1]) * invSpacing[1];
@@ -733,11 +959,13 @@ VolumeRendererStructured::VolumeRendererStructured()
   IsSceneDirty = false;
   IsUniformDataSet = true;
   SampleDistance = -1.f;
+  EarlyRayTerminationOpacity = 1.f;
 }
 
 void VolumeRendererStructured::SetColorMap(const vtkm::cont::ArrayHandle<vtkm::Vec4f_32>& colorMap)
 {
   ColorMap = colorMap;
+  IsSceneDirty = true;
 }
 
 void VolumeRendererStructured::SetData(const vtkm::cont::CoordinateSystem& coords,
@@ -836,9 +1064,44 @@ void VolumeRendererStructured::RenderOnDevice(vtkm::rendering::raytracing::Ray<P
   }
   const bool isAssocPoints = ScalarField->IsFieldPoint();
 
+  // Find the bricks of cells where every sample is transparent
+  const vtkm::Id3 cellDims = Cellset.GetCellDimensions();
+  vtkm::Id3 brickDims;
+  for (vtkm::IdComponent dim = 0; dim < 3; ++dim)
+  {
+    brickDims[dim] = (cellDims[dim] + BrickSize - 1) / BrickSize;
+  }
+  if (IsSceneDirty)
+  {
+    vtkm::cont::ArrayHandle<vtkm::Vec2f_32> brickRanges;
+    brickRanges.Allocate(brickDims[0] * brickDims[1] * brickDims[2]);
+    vtkm::worklet::DispatcherMapField<FindBrickRanges> rangesDispatcher(
+      FindBrickRanges(cellDims, brickDims, isAssocPoints));
+    rangesDispatcher.SetDevice(Device());
+    rangesDispatcher.Invoke(brickRanges,
+                            vtkm::rendering::raytracing::GetScalarFieldArray(*this->ScalarField));
+
+    vtkm::cont::ArrayHandle<vtkm::Id> visibleCounts;
+    vtkm::cont::Algorithm::ScanInclusive(
+      Device(), vtkm::cont::make_ArrayHandleTransform(ColorMap, IsVisibleColor{}), visibleCounts);
+
+    vtkm::worklet::DispatcherMapField<FindEmptyBricks> emptyDispatcher(
+      FindEmptyBricks(vtkm::Float32(ScalarRange.Min),
+                      vtkm::Float32(ScalarRange.Max),
+                      ColorMap.GetNumberOfValues()));
+    emptyDispatcher.SetDevice(Device());
+    emptyDispatcher.Invoke(brickRanges, EmptyBricks, visibleCounts);
+    IsSceneDirty = false;
+  }
+
+  time = timer.GetElapsedTime();
+  logger->AddLogData("find_empty_bricks", time);
+  timer.Start();
+
+  vtkm::cont::Token token;
+  BrickSkipper<Device> skipper(EmptyBricks, cellDims, brickDims, token);
   if (IsUniformDataSet)
   {
-    vtkm::cont::Token token;
     vtkm::cont::ArrayHandleUniformPointCoordinates vertices;
     vertices =
       Coordinates.GetData().AsArrayHandle<vtkm::cont::ArrayHandleUniformPointCoordinates>();
@@ -852,7 +1115,9 @@ void VolumeRendererStructured::RenderOnDevice(vtkm::rendering::raytracing::Ray<P
                                                 vtkm::Float32(ScalarRange.Max),
                                                 SampleDistance,
                                                 locator,
+                                                skipper,
                                                 meshEpsilon,
+                                                EarlyRayTerminationOpacity,
                                                 token));
       samplerDispatcher.SetDevice(Device());
       samplerDispatcher.Invoke(
@@ -871,7 +1136,9 @@ void VolumeRendererStructured::RenderOnDevice(vtkm::rendering::raytracing::Ray<P
                                                          vtkm::Float32(ScalarRange.Max),
                                                          SampleDistance,
                                                          locator,
+                                                         skipper,
                                                          meshEpsilon,
+                                                         EarlyRayTerminationOpacity,
                                                          token))
         .Invoke(rays.Dir,
                 rays.Origin,
@@ -883,7 +1150,6 @@ void VolumeRendererStructured::RenderOnDevice(vtkm::rendering::raytracing::Ray<P
   }
   else
   {
-    vtkm::cont::Token token;
     CartesianArrayHandle vertices;
     vertices = Coordinates.GetData().AsArrayHandle<CartesianArrayHandle>();
     RectilinearLocator<Device> locator(vertices, Cellset, token);
@@ -896,7 +1162,9 @@ void VolumeRendererStructured::RenderOnDevice(vtkm::rendering::raytracing::Ray<P
                                                       vtkm::Float32(ScalarRange.Max),
                                                       SampleDistance,
                                                       locator,
+                                                      skipper,
                                                       meshEpsilon,
+                                                      EarlyRayTerminationOpacity,
                                                       token));
       samplerDispatcher.SetDevice(Device());
       samplerDispatcher.Invoke(
@@ -916,7 +1184,9 @@ void VolumeRendererStructured::RenderOnDevice(vtkm::rendering::raytracing::Ray<P
                                                                vtkm::Float32(ScalarRange.Max),
                                                                SampleDistance,
                                                                locator,
+                                                               skipper,
                                                                meshEpsilon,
+                                                               EarlyRayTerminationOpacity,
                                                                token));
       rectilinearLocatorDispatcher.SetDevice(Device());
       rectilinearLocatorDispatcher.Invoke(
@@ -942,6 +1212,13 @@ void VolumeRendererStructured::SetSampleDistance(const vtkm::Float32& distance)
     throw vtkm::cont::ErrorBadValue("Sample distance must be positive.");
   SampleDistance = distance;
 }
+
+void VolumeRendererStructured::SetEarlyRayTerminationOpacity(const vtkm::Float32& opacity)
+{
+  if (opacity <= 0.f || opacity > 1.f)
+    throw vtkm::cont::ErrorBadValue("Early ray termination opacity must be in (0, 1].");
+  EarlyRayTerminationOpacity = opacity;
+}
 }
 }
 } //namespace vtkm::rendering::raytracing
@@ -57,6 +57,14 @@ public:
   VTKM_CONT
   void SetSampleDistance(const vtkm::Float32& distance);
 
+  /// \brief Opacity at which a ray stops sampling.
+  ///
+  /// Rays stop once their opacity reaches this value. The default of 1 composites every sample
+  /// up to full opacity. Samples behind a nearly opaque pixel barely change its color, so a
+  /// value such as 0.99 skips them at the cost of at most 1% of the color of each pixel.
+  VTKM_CONT
+  void SetEarlyRayTerminationOpacity(const vtkm::Float32& opacity);
+
 protected:
   template <typename Precision, typename Device>
   VTKM_CONT void RenderOnDevice(vtkm::rendering::raytracing::Ray<Precision>& rays, Device);
@@ -70,7 +78,10 @@ protected:
   vtkm::cont::CellSetStructured<3> Cellset;
   const vtkm::cont::Field* ScalarField;
   vtkm::cont::ArrayHandle<vtkm::Vec4f_32> ColorMap;
+  // Bricks of cells where every sample is transparent, found again when the scene is dirty
+  vtkm::cont::ArrayHandle<vtkm::UInt8> EmptyBricks;
   vtkm::Float32 SampleDistance;
+  vtkm::Float32 EarlyRayTerminationOpacity;
   vtkm::Range ScalarRange;
 };
 }
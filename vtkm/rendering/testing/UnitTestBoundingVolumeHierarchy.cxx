@@ -0,0 +1,281 @@
+//============================================================================
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//============================================================================
+
+#include <vtkm/VectorAnalysis.h>
+#include <vtkm/cont/ArrayCopy.h>
+#include <vtkm/cont/ArrayHandleConstant.h>
+#include <vtkm/cont/CoordinateSystem.h>
+#include <vtkm/cont/ExecutionObjectBase.h>
+#include <vtkm/cont/testing/Testing.h>
+#include <vtkm/rendering/raytracing/BVHTraverser.h>
+#include <vtkm/rendering/raytracing/BoundingVolumeHierarchy.h>
+#include <vtkm/rendering/raytracing/Ray.h>
+
+#include <cstring>
+#include <random>
+#include <vector>
+
+namespace
+{
+
+using Portal3f = vtkm::cont::ArrayHandle<vtkm::Vec3f_32>::ReadPortalType;
+
+// Distance to a box, with the arithmetic the traversal uses so that a box hit here is hit there.
+VTKM_EXEC_CONT inline bool HitBox(const vtkm::Vec3f_32& boxMin,
+                                  const vtkm::Vec3f_32& boxMax,
+                                  const vtkm::Vec3f_32& origin,
+                                  const vtkm::Vec3f_32& dir,
+                                  vtkm::Float32 minDistance,
+                                  vtkm::Float32 closestDistance,
+                                  vtkm::Float32& distance)
+{
+  vtkm::Vec3f_32 invDir;
+  for (vtkm::IdComponent i = 0; i < 3; ++i)
+  {
+    invDir[i] = 1.0f / ((vtkm::Abs(dir[i]) < 1e-8f) ? 1e-8f : dir[i]);
+  }
+  const vtkm::Vec3f_32 originDir = origin * invDir;
+  vtkm::Float32 tmin = minDistance;
+  vtkm::Float32 tmax = closestDistance;
+  for (vtkm::IdComponent i = 0; i < 3; ++i)
+  {
+    const vtkm::Float32 t0 = boxMin[i] * invDir[i] - originDir[i];
+    const vtkm::Float32 t1 = boxMax[i] * invDir[i] - originDir[i];
+    tmin = vtkm::Max(tmin, vtkm::Min(t0, t1));
+    tmax = vtkm::Min(tmax, vtkm::Max(t0, t1));
+  }
+  distance = tmin;
+  return tmax >= tmin;
+}
+
+// The primitives are the boxes themselves, so that the hierarchy is tested on its own.
+class BoxLeafIntersector
+{
+public:
+  Portal3f Mins;
+  Portal3f Maxs;
+
+  template <typename PointPortalType, typename LeafPortalType, typename Precision>
+  VTKM_EXEC void IntersectLeaf(const vtkm::Int32& currentNode,
+                               const vtkm::Vec<Precision, 3>& origin,
+                               const vtkm::Vec<Precision, 3>& dir,
+                               const PointPortalType&,
+                               vtkm::Id& hitIndex,
+                               Precision& closestDistance,
+                               Precision&,
+                               Precision&,
+                               LeafPortalType leafs,
+                               const Precision& minDistance) const
+  {
+    const vtkm::Id boxCount = leafs.Get(currentNode);
+    for (vtkm::Id i = 1; i <= boxCount; ++i)
+    {
+      const vtkm::Id boxIndex = leafs.Get(currentNode + i);
+      vtkm::Float32 distance;
+      if (HitBox(this->Mins.Get(boxIndex),
+                 this->Maxs.Get(boxIndex),
+                 origin,
+                 dir,
+                 minDistance,
+                 closestDistance,
+                 distance) &&
+          distance < closestDistance)
+      {
+        closestDistance = distance;
+        hitIndex = boxIndex;
+      }
+    }
+  }
+};
+
+class BoxLeafExecWrapper : public vtkm::cont::ExecutionObjectBase
+{
+public:
+  vtkm::cont::ArrayHandle<vtkm::Vec3f_32> Mins;
+  vtkm::cont::ArrayHandle<vtkm::Vec3f_32> Maxs;
+
+  template <typename Device>
+  VTKM_CONT BoxLeafIntersector PrepareForExecution(Device, vtkm::cont::Token& token) const
+  {
+    return BoxLeafIntersector{ this->Mins.PrepareForInput(Device(), token),
+                               this->Maxs.PrepareForInput(Device(), token) };
+  }
+};
+
+// The nearest box along a ray, found by walking the binary hierarchy the wide one collapses.
+vtkm::Id TraverseFlat(const vtkm::rendering::raytracing::LinearBVH& bvh,
+                      const BoxLeafExecWrapper& boxes,
+                      const vtkm::Vec3f_32& origin,
+                      const vtkm::Vec3f_32& dir,
+                      vtkm::Float32& closestDistance)
+{
+  auto nodes = bvh.FlatBVH.ReadPortal();
+  auto leafs = bvh.Leafs.ReadPortal();
+  auto mins = boxes.Mins.ReadPortal();
+  auto maxs = boxes.Maxs.ReadPortal();
+  vtkm::Id hitIndex = -1;
+  std::vector<vtkm::Int32> todo{ 0 };
+  while (!todo.empty())
+  {
+    const vtkm::Int32 node = todo.back();
+    todo.pop_back();
+    if (node < 0)
+    {
+      BoxLeafIntersector leafIntersector{ mins, maxs };
+      vtkm::Float32 u, v;
+      leafIntersector.IntersectLeaf(
+        -node - 1, origin, dir, 0, hitIndex, closestDistance, u, v, leafs, 0.f);
+      continue;
+    }
+    const vtkm::Vec4f_32 first4 = nodes.Get(node);
+    const vtkm::Vec4f_32 second4 = nodes.Get(node + 1);
+    const vtkm::Vec4f_32 third4 = nodes.Get(node + 2);
+    const vtkm::Vec4f_32 fourth4 = nodes.Get(node + 3);
+    const vtkm::Vec3f_32 childMins[2] = { { first4[0], first4[1], first4[2] },
+                                          { second4[2], second4[3], third4[0] } };
+    const vtkm::Vec3f_32 childMaxs[2] = { { first4[3], second4[0], second4[1] },
+                                          { third4[1], third4[2], third4[3] } };
+    vtkm::Int32 children[2];
+    memcpy(children, &fourth4[0], 8);
+    for (vtkm::IdComponent c = 0; c < 2; ++c)
+    {
+      vtkm::Float32 distance;
+      if (HitBox(childMins[c], childMaxs[c], origin, dir, 0.f, closestDistance, distance))
+      {
+        todo.push_back(children[c]);
+      }
+    }
+  }
+  return hitIndex;
+}
+
+// The Morton code of each box of the chain has a single bit set, a different one for every box,
+// so that each splits off the rest one level further down. The pile that follows, at code 0, is
+// only split by primitive index. The result is a hierarchy over 40 levels deep.
+void MakeDeepBoxes(BoxLeafExecWrapper& boxes)
+{
+  std::vector<vtkm::Vec3f_32> mins;
+  std::vector<vtkm::Vec3f_32> maxs;
+  const vtkm::Float32 bin = 1.f / 1024.f;
+  // A box at the far corner, so that the boxes span the unit cube the codes are computed in.
+  mins.push_back(vtkm::Vec3f_32(1.f - bin));
+  maxs.push_back(vtkm::Vec3f_32(1.f));
+  const vtkm::Float32 halfSize = 1e-4f;
+  for (vtkm::IdComponent bit = 9; bit >= 0; --bit)
+  {
+    for (vtkm::IdComponent axis = 2; axis >= 0; --axis)
+    {
+      vtkm::Vec3f_32 center(0.5f * bin);
+      center[axis] += vtkm::Float32(1 << bit) * bin;
+      mins.push_back(center - vtkm::Vec3f_32(halfSize));
+      maxs.push_back(center + vtkm::Vec3f_32(halfSize));
+    }
+  }
+  for (vtkm::Int32 i = 0; i < 5000; ++i)
+  {
+    mins.push_back(vtkm::Vec3f_32(0.f));
+    maxs.push_back(vtkm::Vec3f_32(bin));
+  }
+  boxes.Mins = vtkm::cont::make_ArrayHandle(mins, vtkm::CopyFlag::On);
+  boxes.Maxs = vtkm::cont::make_ArrayHandle(maxs, vtkm::CopyFlag::On);
+}
+
+void TestDeepHierarchy()
+{
+  std::cout << "Testing the wide hierarchy of a deep tree" << std::endl;
+  BoxLeafExecWrapper boxes;
+  MakeDeepBoxes(boxes);
+  const vtkm::Id numberOfBoxes = boxes.Mins.GetNumberOfValues();
+
+  vtkm::rendering::raytracing::AABBs aabbs;
+  vtkm::cont::ArrayHandle<vtkm::Float32>* bounds[6] = { &aabbs.xmins, &aabbs.ymins, &aabbs.zmins,
+                                                        &aabbs.xmaxs, &aabbs.ymaxs, &aabbs.zmaxs };
+  for (vtkm::IdComponent i = 0; i < 6; ++i)
+  {
+    bounds[i]->Allocate(numberOfBoxes);
+    auto portal = bounds[i]->WritePortal();
+    auto corners = (i < 3) ? boxes.Mins.ReadPortal() : boxes.Maxs.ReadPortal();
+    for (vtkm::Id box = 0; box < numberOfBoxes; ++box)
+    {
+      portal.Set(box, corners.Get(box)[i % 3]);
+    }
+  }
+  // The binary hierarchy is only kept with the tree.
+  vtkm::rendering::raytracing::LinearBVH bvh(aabbs);
+  bvh.SetKeepTreeForRefit(true);
+  bvh.Construct();
+  VTKM_TEST_ASSERT(bvh.FlatBVH.GetNumberOfValues() == (numberOfBoxes - 1) * 4,
+                   "Binary hierarchy was not kept");
+
+  // Rays from around the boxes towards each of them, and some that miss.
+  const vtkm::Int32 numberOfRays = 2000;
+  vtkm::rendering::raytracing::Ray<vtkm::Float32> rays;
+  rays.Resize(numberOfRays, vtkm::cont::DeviceAdapterTagSerial());
+  std::default_random_engine generator(42);
+  std::uniform_real_distribution<vtkm::Float32> around(-2.f, 3.f);
+  std::uniform_int_distribution<vtkm::Id> target(0, 31);
+  std::uniform_real_distribution<vtkm::Float32> jitter(-5e-5f, 5e-5f);
+  std::vector<vtkm::Vec3f_32> origins;
+  std::vector<vtkm::Vec3f_32> dirs;
+  {
+    auto minsPortal = boxes.Mins.ReadPortal();
+    auto maxsPortal = boxes.Maxs.ReadPortal();
+    for (vtkm::Int32 i = 0; i < numberOfRays; ++i)
+    {
+      const vtkm::Vec3f_32 origin(around(generator), around(generator), around(generator));
+      const vtkm::Id box = target(generator);
+      vtkm::Vec3f_32 towards = (minsPortal.Get(box) + maxsPortal.Get(box)) * 0.5f;
+      towards += vtkm::Vec3f_32(jitter(generator), jitter(generator), jitter(generator));
+      origins.push_back(origin);
+      dirs.push_back(vtkm::Normal(towards - origin));
+    }
+  }
+  vtkm::cont::ArrayCopy(vtkm::cont::make_ArrayHandle(origins, vtkm::CopyFlag::Off), rays.Origin);
+  vtkm::cont::ArrayCopy(vtkm::cont::make_ArrayHandle(dirs, vtkm::CopyFlag::Off), rays.Dir);
+  vtkm::cont::ArrayCopy(vtkm::cont::make_ArrayHandleConstant(0.f, numberOfRays),
+                        rays.MinDistance);
+  vtkm::cont::ArrayCopy(
+    vtkm::cont::make_ArrayHandleConstant(vtkm::Infinity32(), numberOfRays), rays.MaxDistance);
+
+  vtkm::cont::CoordinateSystem coords("coords", boxes.Mins);
+  vtkm::rendering::raytracing::BVHTraverser traverser;
+  traverser.IntersectRays(rays, bvh, boxes, coords);
+
+  auto hitPortal = rays.HitIdx.ReadPortal();
+  auto distancePortal = rays.Distance.ReadPortal();
+  vtkm::Id numberOfHits = 0;
+  for (vtkm::Int32 i = 0; i < numberOfRays; ++i)
+  {
+    vtkm::Float32 expectedDistance = vtkm::Infinity32();
+    const vtkm::Id expectedHit = TraverseFlat(bvh, boxes, origins[i], dirs[i], expectedDistance);
+    const vtkm::Id hit = hitPortal.Get(i);
+    // Boxes of the pile are hit at the same distance, so only the distances are compared.
+    VTKM_TEST_ASSERT((hit == -1) == (expectedHit == -1), "Wide and flat hierarchies disagree");
+    if (hit != -1)
+    {
+      VTKM_TEST_ASSERT(distancePortal.Get(i) == expectedDistance,
+                       "Wide and flat hierarchies hit at different distances");
+      ++numberOfHits;
+    }
+  }
+  VTKM_TEST_ASSERT(numberOfHits > numberOfRays / 2, "Too few rays hit the boxes");
+
+  vtkm::rendering::raytracing::LinearBVH wideOnly(aabbs);
+  wideOnly.Construct();
+  VTKM_TEST_ASSERT(wideOnly.FlatBVH.GetNumberOfValues() == 0, "Binary hierarchy was kept");
+  VTKM_TEST_ASSERT(wideOnly.WideBVH.GetNumberOfValues() > 0, "Wide hierarchy was not built");
+}
+
+} // anonymous namespace
+
+int UnitTestBoundingVolumeHierarchy(int argc, char* argv[])
+{
+  return vtkm::cont::testing::Testing::Run(TestDeepHierarchy, argc, argv);
+}
@@ -0,0 +1,247 @@
+//============================================================================
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//============================================================================
+
+#include <vtkm/rendering/compositing/Compositor.h>
+
+#include <vtkm/cont/EnvironmentTracker.h>
+#include <vtkm/cont/testing/Testing.h>
+
+#include <vtkm/thirdparty/diy/diy.h>
+
+#include <algorithm>
+#include <vector>
+
+namespace
+{
+
+const vtkm::Id Width = 37;
+const vtkm::Id Height = 23;
+
+// The rectangle of the frame rank `rank` renders to. The rectangles overlap.
+vtkm::RangeId2 RankRegion(int rank)
+{
+  return vtkm::RangeId2(3 * rank, Width - 2 * rank, rank, Height - 3 * rank);
+}
+
+vtkm::Float32 RankDepth(int rank, vtkm::Id x, vtkm::Id y)
+{
+  return static_cast<vtkm::Float32>(((x * 7 + y * 3 + rank * 5) % 11) * 16 + rank) / 256.f;
+}
+
+vtkm::Vec4f_32 RankColor(int rank, vtkm::Float32 alpha)
+{
+  const vtkm::Float32 value = static_cast<vtkm::Float32>(rank + 1) / 8.f;
+  return vtkm::Vec4f_32(value * alpha, (1.f - value) * alpha, 0.5f * alpha, alpha);
+}
+
+// Renders the image of a rank: opaque or semi-transparent pixels in its rectangle.
+vtkm::rendering::Canvas RenderRank(int rank, vtkm::Float32 alpha)
+{
+  vtkm::rendering::Canvas canvas(Width, Height);
+  canvas.Clear();
+  auto colorPortal = canvas.GetColorBuffer().WritePortal();
+  auto depthPortal = canvas.GetDepthBuffer().WritePortal();
+  const vtkm::RangeId2 region = RankRegion(rank);
+  for (vtkm::Id y = region.Y.Min; y < region.Y.Max; ++y)
+  {
+    for (vtkm::Id x = region.X.Min; x < region.X.Max; ++x)
+    {
+      colorPortal.Set(y * Width + x, RankColor(rank, alpha));
+      depthPortal.Set(y * Width + x, RankDepth(rank, x, y));
+    }
+  }
+  return canvas;
+}
+
+void TestImage()
+{
+  std::cout << "Testing images" << std::endl;
+  using vtkm::rendering::compositing::Image;
+  Image image = Image::FromCanvas(RenderRank(1, 1.f));
+  VTKM_TEST_ASSERT(image.GetBounds() == vtkm::RangeId2(0, Width, 0, Height), "Wrong bounds");
+  VTKM_TEST_ASSERT(image.GetActiveBounds() == RankRegion(1), "Wrong active bounds");
+  VTKM_TEST_ASSERT(image.GetColors().size() == static_cast<std::size_t>(32 * 19),
+                   "Background pixels should not be stored");
+  VTKM_TEST_ASSERT(test_equal(image.GetColor(5, 5), RankColor(1, 1.f)), "Wrong color");
+  VTKM_TEST_ASSERT(test_equal(image.GetDepth(5, 5), RankDepth(1, 5, 5)), "Wrong depth");
+  VTKM_TEST_ASSERT(test_equal(image.GetColor(0, 0), vtkm::Vec4f_32(0.f)), "Wrong background");
+
+  Image subset = image.Subset(vtkm::RangeId2(0, 10, 10, 40));
+  VTKM_TEST_ASSERT(subset.GetActiveBounds() == vtkm::RangeId2(3, 10, 10, 20),
+                   "Wrong subset bounds");
+  VTKM_TEST_ASSERT(test_equal(subset.GetDepth(4, 12), RankDepth(1, 4, 12)), "Wrong subset");
+  VTKM_TEST_ASSERT(!image.Subset(vtkm::RangeId2(0, 2, 0, 40)).GetActiveBounds().IsNonEmpty(),
+                   "Subset of background should be empty");
+}
+
+void TestZBuffer(vtkm::IdComponent radix)
+{
+  vtkmdiy::mpi::communicator comm = vtkm::cont::EnvironmentTracker::GetCommunicator();
+  std::cout << "Testing z-buffer compositing on " << comm.size() << " ranks with radix " << radix
+            << std::endl;
+
+  vtkm::rendering::compositing::Compositor compositor;
+  compositor.SetRadix(radix);
+  compositor.AddImage(RenderRank(comm.rank(), 1.f));
+  vtkm::rendering::Canvas result;
+  compositor.Composite(result);
+  if (comm.rank() != 0)
+  {
+    return;
+  }
+
+  auto colorPortal = result.GetColorBuffer().ReadPortal();
+  auto depthPortal = result.GetDepthBuffer().ReadPortal();
+  for (vtkm::Id y = 0; y < Height; ++y)
+  {
+    for (vtkm::Id x = 0; x < Width; ++x)
+    {
+      vtkm::Vec4f_32 color(0.f);
+      vtkm::Float32 depth = VTKM_DEFAULT_CANVAS_DEPTH;
+      for (int rank = 0; rank < comm.size(); ++rank)
+      {
+        if (RankRegion(rank).Contains(vtkm::Id2(x, y)) && RankDepth(rank, x, y) < depth)
+        {
+          color = RankColor(rank, 1.f);
+          depth = RankDepth(rank, x, y);
+        }
+      }
+      VTKM_TEST_ASSERT(test_equal(colorPortal.Get(y * Width + x), color), "Wrong color");
+      VTKM_TEST_ASSERT(test_equal(depthPortal.Get(y * Width + x), depth), "Wrong depth");
+    }
+  }
+}
+
+void TestVisibilityOrder()
+{
+  vtkmdiy::mpi::communicator comm = vtkm::cont::EnvironmentTracker::GetCommunicator();
+  std::cout << "Testing visibility order compositing on " << comm.size() << " ranks" << std::endl;
+
+  // The last rank is in front. Each rank adds two images, consecutive in visibility order.
+  const vtkm::Int32 order = 2 * (comm.size() - 1 - comm.rank());
+  using Compositor = vtkm::rendering::compositing::Compositor;
+  Compositor compositor;
+  compositor.SetCompositeMode(Compositor::CompositeMode::VisibilityOrder);
+  compositor.AddImage(RenderRank(comm.rank(), 0.5f), order + 1);
+  compositor.AddImage(RenderRank(comm.rank(), 0.25f), order);
+  vtkm::rendering::compositing::Image result = compositor.Composite();
+  if (comm.rank() != 0)
+  {
+    VTKM_TEST_ASSERT(!result.GetActiveBounds().IsNonEmpty(), "Only rank 0 gets the result");
+    return;
+  }
+
+  for (vtkm::Id y = 0; y < Height; ++y)
+  {
+    for (vtkm::Id x = 0; x < Width; ++x)
+    {
+      vtkm::Vec4f_32 color(0.f);
+      for (int rank = comm.size() - 1; rank >= 0; --rank)
+      {
+        if (RankRegion(rank).Contains(vtkm::Id2(x, y)))
+        {
+          color = color + RankColor(rank, 0.25f) * (1.f - color[3]);
+          color = color + RankColor(rank, 0.5f) * (1.f - color[3]);
+        }
+      }
+      VTKM_TEST_ASSERT(test_equal(result.GetColor(x, y), color), "Wrong blended color");
+    }
+  }
+}
+
+void TestPartialComposites()
+{
+  vtkmdiy::mpi::communicator comm = vtkm::cont::EnvironmentTracker::GetCommunicator();
+  std::cout << "Testing partial compositing on " << comm.size() << " ranks" << std::endl;
+
+  // Rank r traces the pixels that are not multiples of r + 2; ranks with a higher id are closer.
+  const vtkm::Id numberOfPixels = Width * Height;
+  auto traced = [](int rank, vtkm::Id pixel) { return pixel % (rank + 2) != 0; };
+  auto distance = [&](int rank, vtkm::Id pixel) {
+    return static_cast<vtkm::Float32>(comm.size() - rank) +
+      static_cast<vtkm::Float32>(pixel) * 1e-4f;
+  };
+
+  std::vector<vtkm::Id> pixelIds;
+  std::vector<vtkm::Float32> distances;
+  std::vector<vtkm::Float32> colors;
+  for (vtkm::Id pixel = numberOfPixels - 1; pixel >= 0; --pixel)
+  {
+    if (traced(comm.rank(), pixel))
+    {
+      pixelIds.push_back(pixel);
+      distances.push_back(distance(comm.rank(), pixel));
+      const vtkm::Vec4f_32 color = RankColor(comm.rank(), 0.4f);
+      colors.insert(colors.end(), { color[0], color[1], color[2], color[3] });
+    }
+  }
+  vtkm::rendering::raytracing::PartialComposite<vtkm::Float32> partial;
+  partial.PixelIds = vtkm::cont::make_ArrayHandle(pixelIds, vtkm::CopyFlag::On);
+  partial.Distances = vtkm::cont::make_ArrayHandle(distances, vtkm::CopyFlag::On);
+  partial.Buffer = vtkm::rendering::raytracing::ChannelBuffer<vtkm::Float32>(
+    4, partial.PixelIds.GetNumberOfValues());
+  partial.Buffer.Buffer = vtkm::cont::make_ArrayHandle(colors, vtkm::CopyFlag::On);
+
+  vtkm::rendering::compositing::PartialCompositor compositor;
+  auto result = compositor.Composite({ partial }, numberOfPixels);
+  if (comm.rank() != 0)
+  {
+    VTKM_TEST_ASSERT(result.PixelIds.GetNumberOfValues() == 0, "Only rank 0 gets the result");
+    return;
+  }
+
+  auto resultIds = result.PixelIds.ReadPortal();
+  auto resultDistances = result.Distances.ReadPortal();
+  auto resultColors = result.Buffer.Buffer.ReadPortal();
+  vtkm::Id index = 0;
+  for (vtkm::Id pixel = 0; pixel < numberOfPixels; ++pixel)
+  {
+    vtkm::Vec4f_32 color(0.f);
+    vtkm::Float32 end = 0.f;
+    bool hit = false;
+    for (int rank = comm.size() - 1; rank >= 0; --rank)
+    {
+      if (traced(rank, pixel))
+      {
+        color = color + RankColor(rank, 0.4f) * (1.f - color[3]);
+        end = distance(rank, pixel);
+        hit = true;
+      }
+    }
+    if (!hit)
+    {
+      continue;
+    }
+    VTKM_TEST_ASSERT(resultIds.Get(index) == pixel, "Wrong pixel id");
+    VTKM_TEST_ASSERT(test_equal(resultDistances.Get(index), end), "Wrong distance");
+    for (vtkm::IdComponent c = 0; c < 4; ++c)
+    {
+      VTKM_TEST_ASSERT(test_equal(resultColors.Get(index * 4 + c), color[c]), "Wrong color");
+    }
+    ++index;
+  }
+  VTKM_TEST_ASSERT(index == result.PixelIds.GetNumberOfValues(), "Wrong number of pixels");
+}
+
+void Run()
+{
+  TestImage();
+  TestZBuffer(2);
+  TestZBuffer(3);
+  TestVisibilityOrder();
+  TestPartialComposites();
+}
+
+} // anonymous namespace
+
+int UnitTestImageCompositing(int argc, char* argv[])
+{
+  return vtkm::cont::testing::Testing::Run(Run, argc, argv);
+}
@@ -8,6 +8,7 @@
 //  PURPOSE.  See the above copyright notice for more information.
 //============================================================================
 
+#include <vtkm/cont/ArrayCopy.h>
 #include <vtkm/cont/testing/MakeTestDataSet.h>
 #include <vtkm/cont/testing/Testing.h>
 #include <vtkm/rendering/Actor.h>
@@ -17,6 +18,7 @@
 #include <vtkm/rendering/Scene.h>
 #include <vtkm/rendering/View3D.h>
 #include <vtkm/rendering/raytracing/Logger.h>
+#include <vtkm/rendering/raytracing/MeshConnectivityCache.h>
 #include <vtkm/rendering/testing/RenderTest.h>
 
 namespace
@@ -44,9 +46,92 @@ void RenderTests()
                                        testOptions);
 }
 
+void Render(vtkm::rendering::MapperConnectivity& mapper,
+            vtkm::rendering::CanvasRayTracer& canvas,
+            const vtkm::cont::DataSet& dataSet,
+            const vtkm::rendering::Camera& camera,
+            vtkm::cont::ColorTable::Preset preset)
+{
+  canvas.Clear();
+  mapper.SetCanvas(&canvas);
+  mapper.SetActiveColorTable(vtkm::cont::ColorTable(preset));
+  mapper.RenderCells(dataSet.GetCellSet(),
+                     dataSet.GetCoordinateSystem(),
+                     dataSet.GetField("pointvar"),
+                     vtkm::cont::ColorTable{},
+                     camera,
+                     vtkm::Range(0, 200));
+}
+
+bool SameImage(const vtkm::rendering::CanvasRayTracer& canvas1,
+               const vtkm::rendering::CanvasRayTracer& canvas2)
+{
+  return test_equal_ArrayHandles(canvas1.GetColorBuffer(), canvas2.GetColorBuffer());
+}
+
+void TestMeshConnectivityCache()
+{
+  std::cout << "Testing the mesh connectivity cache" << std::endl;
+  vtkm::cont::DataSet dataSet = vtkm::cont::testing::MakeTestDataSet().Make3DExplicitDataSetZoo();
+  vtkm::cont::ArrayHandle<vtkm::Vec3f_32> points;
+  vtkm::cont::ArrayCopyShallowIfPossible(dataSet.GetCoordinateSystem().GetData(), points);
+  vtkm::cont::CoordinateSystem coords("coords", points);
+
+  vtkm::rendering::raytracing::MeshConnectivityCache cache;
+  auto first = cache.Get(dataSet.GetCellSet(), coords);
+  auto second = cache.Get(dataSet.GetCellSet(), coords);
+  VTKM_TEST_ASSERT(first == second, "Connectivity of an unchanged mesh was rebuilt");
+  VTKM_TEST_ASSERT(cache.GetNumberOfHits() == 1, "Wrong number of cache hits");
+  VTKM_TEST_ASSERT(cache.GetNumberOfBytes() == first->NumberOfBytes, "Wrong cached size");
+  VTKM_TEST_ASSERT(first->NumberOfBytes > 0, "Connectivity size not computed");
+
+  // Modifying the points invalidates the connectivity built for them.
+  points.WritePortal();
+  auto third = cache.Get(dataSet.GetCellSet(), coords);
+  VTKM_TEST_ASSERT(third != first, "Connectivity of a modified mesh was reused");
+  VTKM_TEST_ASSERT(cache.GetNumberOfEntries() == 1, "Stale connectivity kept in the cache");
+
+  cache.SetCapacity(0);
+  VTKM_TEST_ASSERT(cache.GetNumberOfEntries() == 0, "Capacity not applied");
+  VTKM_TEST_ASSERT(cache.Get(dataSet.GetCellSet(), coords) != third, "Disabled cache was used");
+}
+
+// The mapper reuses the connectivity of the mesh across frames and color maps. It must render
+// what a new mapper renders.
+void TestReuseAcrossFrames()
+{
+  std::cout << "Testing rendering again with another color map" << std::endl;
+  vtkm::cont::DataSet dataSet = vtkm::cont::testing::MakeTestDataSet().Make3DExplicitDataSetZoo();
+  vtkm::rendering::Camera camera;
+  camera.ResetToBounds(dataSet.GetCoordinateSystem().GetBounds());
+  camera.Azimuth(30.f);
+  camera.Elevation(20.f);
+
+  using Preset = vtkm::cont::ColorTable::Preset;
+  vtkm::rendering::MapperConnectivity mapper;
+  vtkm::rendering::CanvasRayTracer first(64, 64);
+  vtkm::rendering::CanvasRayTracer second(64, 64);
+  Render(mapper, first, dataSet, camera, Preset::Inferno);
+  Render(mapper, second, dataSet, camera, Preset::CoolToWarm);
+  VTKM_TEST_ASSERT(!SameImage(first, second), "Changing the color map did not change the image");
+  Render(mapper, second, dataSet, camera, Preset::Inferno);
+  VTKM_TEST_ASSERT(SameImage(first, second), "Rendering again changed the image");
+
+  vtkm::rendering::MapperConnectivity newMapper;
+  Render(newMapper, second, dataSet, camera, Preset::Inferno);
+  VTKM_TEST_ASSERT(SameImage(first, second), "Cached connectivity renders differently");
+}
+
+void Run()
+{
+  RenderTests();
+  TestMeshConnectivityCache();
+  TestReuseAcrossFrames();
+}
+
 } //namespace
 
 int UnitTestMapperConnectivity(int argc, char* argv[])
 {
-  return vtkm::cont::testing::Testing::Run(RenderTests, argc, argv);
+  return vtkm::cont::testing::Testing::Run(Run, argc, argv);
 }
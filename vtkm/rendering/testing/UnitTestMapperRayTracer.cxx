@@ -8,6 +8,8 @@
 //  PURPOSE.  See the above copyright notice for more information.
 //============================================================================
 
+#include <vtkm/cont/ArrayCopy.h>
+#include <vtkm/cont/ErrorBadValue.h>
 #include <vtkm/cont/testing/MakeTestDataSet.h>
 #include <vtkm/cont/testing/Testing.h>
 #include <vtkm/rendering/Actor.h>
@@ -15,6 +17,9 @@
 #include <vtkm/rendering/MapperRayTracer.h>
 #include <vtkm/rendering/Scene.h>
 #include <vtkm/rendering/View3D.h>
+#include <vtkm/rendering/raytracing/LevelOfDetailCache.h>
+#include <vtkm/rendering/raytracing/ShapeIntersectorCache.h>
+#include <vtkm/rendering/raytracing/TriangleIntersector.h>
 #include <vtkm/rendering/testing/RenderTest.h>
 
 namespace
@@ -48,9 +53,375 @@ void RenderTests()
     maker.Make2DUniformDataSet1(), "pointvar", "rendering/raytracer/uniform2D.png", options);
 }
 
+void Render(vtkm::rendering::MapperRayTracer& mapper,
+            vtkm::rendering::CanvasRayTracer& canvas,
+            const vtkm::cont::DataSet& dataSet,
+            const vtkm::rendering::Camera& camera)
+{
+  canvas.Clear();
+  mapper.SetCanvas(&canvas);
+  mapper.SetActiveColorTable(vtkm::cont::ColorTable(vtkm::cont::ColorTable::Preset::Inferno));
+  mapper.RenderCells(dataSet.GetCellSet(),
+                     dataSet.GetCoordinateSystem(),
+                     dataSet.GetField("pointvar"),
+                     vtkm::cont::ColorTable{},
+                     camera,
+                     vtkm::Range(10, 180));
+}
+
+bool SameImage(const vtkm::rendering::CanvasRayTracer& canvas1,
+               const vtkm::rendering::CanvasRayTracer& canvas2)
+{
+  return test_equal_ArrayHandles(canvas1.GetColorBuffer(), canvas2.GetColorBuffer());
+}
+
+// The mapper reuses the BVH it built while the mesh is unchanged, and refits it when the points
+// move. Either way it must render what a new mapper renders.
+void TestMovingMesh()
+{
+  std::cout << "Testing rendering of a mesh whose points move" << std::endl;
+  vtkm::cont::DataSet dataSet = vtkm::cont::testing::MakeTestDataSet().Make3DExplicitDataSet4();
+  vtkm::cont::ArrayHandle<vtkm::Vec3f_32> points;
+  vtkm::cont::ArrayCopyShallowIfPossible(dataSet.GetCoordinateSystem().GetData(), points);
+  dataSet.AddCoordinateSystem(vtkm::cont::CoordinateSystem("coords", points));
+
+  vtkm::rendering::Camera camera;
+  camera.ResetToBounds(dataSet.GetCoordinateSystem().GetBounds());
+  camera.Azimuth(30.f);
+  camera.Elevation(20.f);
+
+  vtkm::rendering::MapperRayTracer mapper;
+  vtkm::rendering::CanvasRayTracer first(64, 64);
+  vtkm::rendering::CanvasRayTracer second(64, 64);
+  Render(mapper, first, dataSet, camera);
+  Render(mapper, second, dataSet, camera);
+  VTKM_TEST_ASSERT(SameImage(first, second), "Rendering again changed the image");
+
+  // Shear the mesh in place.
+  {
+    auto pointsPortal = points.WritePortal();
+    for (vtkm::Id i = 0; i < pointsPortal.GetNumberOfValues(); ++i)
+    {
+      vtkm::Vec3f_32 point = pointsPortal.Get(i);
+      point[0] += 0.25f * point[2];
+      pointsPortal.Set(i, point);
+    }
+  }
+
+  Render(mapper, second, dataSet, camera);
+  VTKM_TEST_ASSERT(!SameImage(first, second), "Moving the points did not change the image");
+
+  vtkm::rendering::MapperRayTracer newMapper;
+  Render(newMapper, first, dataSet, camera);
+  VTKM_TEST_ASSERT(SameImage(first, second), "Refit BVH renders differently");
+}
+
+// Structured blocks of the same dimensions are different meshes. The intersector of one must not
+// be refit for, nor replaced by, the other.
+void TestStructuredBlocks()
+{
+  std::cout << "Testing the intersectors of structured blocks of the same size" << std::endl;
+  using MatchType = vtkm::rendering::raytracing::ShapeIntersectorCache::MatchType;
+  vtkm::cont::testing::MakeTestDataSet maker;
+  vtkm::cont::DataSet block0 = maker.Make3DUniformDataSet0();
+  vtkm::cont::DataSet block1 = maker.Make3DUniformDataSet0();
+
+  vtkm::rendering::raytracing::ShapeIntersectorCache cache;
+  auto intersector0 = std::make_shared<vtkm::rendering::raytracing::TriangleIntersector>();
+  cache.Insert(block0.GetCellSet(), block0.GetCoordinateSystem(), {}, intersector0);
+
+  MatchType match;
+  VTKM_TEST_ASSERT(cache.Find(block1.GetCellSet(), block1.GetCoordinateSystem(), {}, match) ==
+                     nullptr,
+                   "Intersector found for another block");
+  VTKM_TEST_ASSERT(match == MatchType::None, "Block of the same size matched");
+
+  auto intersector1 = std::make_shared<vtkm::rendering::raytracing::TriangleIntersector>();
+  cache.Insert(block1.GetCellSet(), block1.GetCoordinateSystem(), {}, intersector1);
+  VTKM_TEST_ASSERT(cache.GetNumberOfEntries() == 2, "Blocks of the same size evicted each other");
+  VTKM_TEST_ASSERT(cache.Find(block0.GetCellSet(), block0.GetCoordinateSystem(), {}, match) ==
+                     intersector0,
+                   "Intersector of the first block lost");
+  VTKM_TEST_ASSERT(match == MatchType::All, "First block not matched");
+}
+
+// Progressive renders trace a few pixels each and fill in the others, until every pixel is
+// traced. The complete image must be the one of a regular render.
+void TestProgressive()
+{
+  std::cout << "Testing progressive rendering" << std::endl;
+  vtkm::cont::DataSet dataSet = vtkm::cont::testing::MakeTestDataSet().Make3DExplicitDataSet4();
+
+  vtkm::rendering::Camera camera;
+  camera.ResetToBounds(dataSet.GetCoordinateSystem().GetBounds());
+  camera.Azimuth(30.f);
+  camera.Elevation(20.f);
+
+  vtkm::rendering::MapperRayTracer mapper;
+  vtkm::rendering::CanvasRayTracer expected(64, 64);
+  Render(mapper, expected, dataSet, camera);
+
+  vtkm::rendering::CanvasRayTracer canvas(64, 64);
+  canvas.SetProgressiveRendering(true);
+  canvas.SetProgressiveRayBudget(500);
+  vtkm::IdComponent numRenders = 0;
+  do
+  {
+    Render(mapper, canvas, dataSet, camera);
+    ++numRenders;
+    VTKM_TEST_ASSERT(numRenders <= 9, "Progressive rendering traced too few pixels");
+  } while (!canvas.IsProgressiveRenderingComplete());
+  VTKM_TEST_ASSERT(numRenders == 9, "Progressive rendering traced too many pixels");
+  VTKM_TEST_ASSERT(SameImage(expected, canvas), "Complete progressive image differs");
+
+  // A canceled render leaves the image of the previous one, and is retraced by the next.
+  canvas.ResetProgressiveRendering();
+  Render(mapper, canvas, dataSet, camera);
+  vtkm::cont::ArrayHandle<vtkm::Vec4f_32> coarse;
+  vtkm::cont::ArrayCopy(canvas.GetColorBuffer(), coarse);
+  VTKM_TEST_ASSERT(!test_equal_ArrayHandles(coarse, expected.GetColorBuffer()),
+                   "First progressive render is complete");
+  canvas.SetProgressiveCancelCallback([]() { return true; });
+  Render(mapper, canvas, dataSet, camera);
+  VTKM_TEST_ASSERT(test_equal_ArrayHandles(coarse, canvas.GetColorBuffer()),
+                   "Canceled render changed the image");
+  canvas.SetProgressiveCancelCallback(nullptr);
+  numRenders = 1;
+  do
+  {
+    Render(mapper, canvas, dataSet, camera);
+    ++numRenders;
+  } while (!canvas.IsProgressiveRenderingComplete());
+  VTKM_TEST_ASSERT(numRenders == 9, "Canceled render was not retraced");
+  VTKM_TEST_ASSERT(SameImage(expected, canvas), "Complete progressive image differs");
+}
+
+// Tiled renders trace the image one tile after another, and must match a render of the whole
+// image. Tiles are not a divisor of the image size, so some of them are cut at its edges.
+void TestTiled()
+{
+  std::cout << "Testing tiled rendering" << std::endl;
+  vtkm::cont::DataSet dataSet3D = vtkm::cont::testing::MakeTestDataSet().Make3DExplicitDataSet4();
+  vtkm::rendering::Camera camera3D;
+  camera3D.ResetToBounds(dataSet3D.GetCoordinateSystem().GetBounds());
+  camera3D.Azimuth(30.f);
+  camera3D.Elevation(20.f);
+
+  vtkm::cont::DataSet dataSet2D = vtkm::cont::testing::MakeTestDataSet().Make2DUniformDataSet1();
+  vtkm::rendering::Camera camera2D;
+  camera2D.SetModeTo2D();
+  camera2D.SetViewRange2D(dataSet2D.GetCoordinateSystem().GetBounds());
+
+  vtkm::rendering::MapperRayTracer mapper;
+  vtkm::rendering::CanvasRayTracer expected(64, 48);
+  vtkm::rendering::CanvasRayTracer canvas(64, 48);
+  canvas.SetTileSize(20);
+  VTKM_TEST_ASSERT(canvas.GetTileSize() == 20, "Tile size not set");
+
+  Render(mapper, expected, dataSet3D, camera3D);
+  Render(mapper, canvas, dataSet3D, camera3D);
+  VTKM_TEST_ASSERT(SameImage(expected, canvas), "Tiled 3D image differs");
+
+  Render(mapper, expected, dataSet2D, camera2D);
+  Render(mapper, canvas, dataSet2D, camera2D);
+  VTKM_TEST_ASSERT(SameImage(expected, canvas), "Tiled 2D image differs");
+}
+
+// Painting several views at once must paint each of them as painting it alone does,
+// annotations included.
+void TestMultiView()
+{
+  std::cout << "Testing rendering of several views at once" << std::endl;
+  vtkm::cont::DataSet dataSet = vtkm::cont::testing::MakeTestDataSet().Make3DExplicitDataSet4();
+  vtkm::rendering::Scene scene;
+  scene.AddActor(vtkm::rendering::Actor(dataSet.GetCellSet(),
+                                        dataSet.GetCoordinateSystem(),
+                                        dataSet.GetField("pointvar"),
+                                        vtkm::cont::ColorTable::Preset::Inferno));
+
+  vtkm::rendering::Camera camera;
+  camera.ResetToBounds(dataSet.GetCoordinateSystem().GetBounds());
+  std::vector<vtkm::rendering::Camera> cameras;
+  for (vtkm::IdComponent view = 0; view < 3; ++view)
+  {
+    cameras.push_back(camera);
+    cameras.back().Azimuth(40.f * static_cast<vtkm::Float32>(view));
+  }
+
+  vtkm::rendering::MapperRayTracer mapper;
+  vtkm::rendering::CanvasRayTracer canvas(64, 64);
+  vtkm::rendering::View3D view(
+    scene, mapper, canvas, camera, vtkm::rendering::Color(0.2f, 0.2f, 0.2f, 1.0f));
+
+  // Copies of a canvas share its buffers, so each image is constructed in place.
+  std::vector<vtkm::rendering::CanvasRayTracer> images;
+  images.reserve(cameras.size());
+  std::vector<vtkm::rendering::Canvas*> canvases;
+  for (std::size_t index = 0; index < cameras.size(); ++index)
+  {
+    images.emplace_back(64, 64);
+    canvases.push_back(&images.back());
+  }
+  view.Paint(cameras, canvases);
+  VTKM_TEST_ASSERT(!SameImage(images[0], images[1]), "Views were painted from the same camera");
+
+  for (std::size_t index = 0; index < cameras.size(); ++index)
+  {
+    view.SetCamera(cameras[index]);
+    view.Paint();
+    VTKM_TEST_ASSERT(SameImage(dynamic_cast<vtkm::rendering::CanvasRayTracer&>(view.GetCanvas()),
+                               images[index]),
+                     "Image painted with other views differs");
+  }
+}
+
+// A bumpy square of many small triangles, far more than the pixels it covers in the tests.
+vtkm::cont::DataSet MakeDenseSurface(vtkm::Id size)
+{
+  vtkm::cont::ArrayHandle<vtkm::Vec3f_32> points;
+  vtkm::cont::ArrayHandle<vtkm::Float32> pointvar;
+  points.Allocate(size * size);
+  pointvar.Allocate(size * size);
+  {
+    const vtkm::Float32 spacing = 1.f / static_cast<vtkm::Float32>(size - 1);
+    auto pointsPortal = points.WritePortal();
+    auto pointvarPortal = pointvar.WritePortal();
+    for (vtkm::Id j = 0; j < size; ++j)
+    {
+      for (vtkm::Id i = 0; i < size; ++i)
+      {
+        const vtkm::Float32 x = spacing * static_cast<vtkm::Float32>(i);
+        const vtkm::Float32 y = spacing * static_cast<vtkm::Float32>(j);
+        pointsPortal.Set(j * size + i,
+                         vtkm::Vec3f_32(x, y, 0.05f * vtkm::Sin(6.f * x) * vtkm::Cos(6.f * y)));
+        pointvarPortal.Set(j * size + i, 10.f + 170.f * x);
+      }
+    }
+  }
+
+  vtkm::cont::CellSetStructured<2> cellSet;
+  cellSet.SetPointDimensions(vtkm::Id2(size, size));
+  vtkm::cont::DataSet dataSet;
+  dataSet.SetCellSet(cellSet);
+  dataSet.AddCoordinateSystem(vtkm::cont::CoordinateSystem("coords", points));
+  dataSet.AddPointField("pointvar", pointvar);
+  return dataSet;
+}
+
+bool IsPowerOfTwo(vtkm::Id value)
+{
+  return (value > 0) && ((value & (value - 1)) == 0);
+}
+
+// Decimated meshes are picked to the resolution of the screen, cached per mesh and level, and
+// rendered close to the full resolution mesh.
+void TestLevelOfDetail()
+{
+  std::cout << "Testing level of detail rendering" << std::endl;
+  using LevelOfDetailCache = vtkm::rendering::raytracing::LevelOfDetailCache;
+  vtkm::cont::DataSet dataSet = MakeDenseSurface(200);
+  const vtkm::cont::CoordinateSystem coords = dataSet.GetCoordinateSystem();
+  const vtkm::Bounds bounds = coords.GetBounds();
+
+  vtkm::rendering::Camera camera;
+  camera.ResetToBounds(bounds);
+  camera.Elevation(-30.f);
+  const vtkm::Id nearDivisions = LevelOfDetailCache::GetDivisions(camera, 64, 64, bounds, 1.);
+  camera.SetPosition(camera.GetLookAt() + 4.f * (camera.GetPosition() - camera.GetLookAt()));
+  const vtkm::Id farDivisions = LevelOfDetailCache::GetDivisions(camera, 64, 64, bounds, 1.);
+  VTKM_TEST_ASSERT(IsPowerOfTwo(nearDivisions) && IsPowerOfTwo(farDivisions),
+                   "Divisions are not powers of two");
+  VTKM_TEST_ASSERT(farDivisions < nearDivisions, "Far meshes are not decimated more");
+  VTKM_TEST_ASSERT(LevelOfDetailCache::GetDivisions(camera, 64, 64, bounds, 4.) < farDivisions,
+                   "Larger bins do not decimate more");
+
+  vtkm::rendering::Camera inside = camera;
+  inside.SetPosition(vtkm::Vec3f_32(0.5f, 0.5f, 0.f));
+  VTKM_TEST_ASSERT(LevelOfDetailCache::GetDivisions(inside, 64, 64, bounds, 1.) == 0,
+                   "Camera inside the bounds decimates");
+  vtkm::rendering::Camera camera2D;
+  camera2D.SetModeTo2D();
+  VTKM_TEST_ASSERT(LevelOfDetailCache::GetDivisions(camera2D, 64, 64, bounds, 1.) == 0,
+                   "2D camera decimates");
+
+  LevelOfDetailCache cache;
+  auto level = cache.Get(dataSet.GetCellSet(), coords, farDivisions);
+  VTKM_TEST_ASSERT(level->Intersector != nullptr, "Dense mesh was not decimated");
+  VTKM_TEST_ASSERT(level->NumberOfInputTriangles == 2 * 199 * 199, "Wrong input triangles");
+  VTKM_TEST_ASSERT(2 * level->NumberOfTriangles < level->NumberOfInputTriangles,
+                   "Too many triangles kept");
+  VTKM_TEST_ASSERT(level->PointIds.GetNumberOfValues() < coords.GetNumberOfPoints(),
+                   "No points merged");
+  VTKM_TEST_ASSERT(cache.Get(dataSet.GetCellSet(), coords, farDivisions) == level,
+                   "Level was not reused");
+  VTKM_TEST_ASSERT(cache.GetNumberOfHits() == 1, "Wrong number of hits");
+
+  // Bins smaller than the triangles keep every triangle, which is not worth it.
+  VTKM_TEST_ASSERT(!cache.Get(dataSet.GetCellSet(), coords, 1024)->Intersector,
+                   "Mesh finer than its triangles was decimated");
+  VTKM_TEST_ASSERT(cache.GetNumberOfEntries() == 2, "Wrong number of entries");
+
+  // Levels of a mesh whose points moved are rebuilt.
+  {
+    vtkm::cont::ArrayHandle<vtkm::Vec3f_32> points;
+    coords.GetData().AsArrayHandle(points);
+    auto pointsPortal = points.WritePortal();
+    pointsPortal.Set(0, pointsPortal.Get(0) + vtkm::Vec3f_32(0.f, 0.f, 0.1f));
+  }
+  VTKM_TEST_ASSERT(cache.Get(dataSet.GetCellSet(), coords, farDivisions) != level,
+                   "Level of a modified mesh was reused");
+  VTKM_TEST_ASSERT(cache.GetNumberOfHits() == 1, "Wrong number of hits");
+  VTKM_TEST_ASSERT(cache.GetNumberOfEntries() == 1, "Levels of the old mesh were kept");
+
+  vtkm::rendering::MapperRayTracer mapper;
+  vtkm::rendering::CanvasRayTracer expected(64, 64);
+  Render(mapper, expected, dataSet, camera);
+  VTKM_TEST_ASSERT(!mapper.GetLevelOfDetailOn(), "Level of detail is on by default");
+  mapper.SetLevelOfDetailOn(true);
+  vtkm::rendering::CanvasRayTracer canvas(64, 64);
+  Render(mapper, canvas, dataSet, camera);
+
+  vtkm::Id differentPixels = 0;
+  auto expectedPortal = expected.GetColorBuffer().ReadPortal();
+  auto canvasPortal = canvas.GetColorBuffer().ReadPortal();
+  for (vtkm::Id i = 0; i < expectedPortal.GetNumberOfValues(); ++i)
+  {
+    if (!test_equal(expectedPortal.Get(i), canvasPortal.Get(i), 0.1))
+    {
+      ++differentPixels;
+    }
+  }
+  VTKM_TEST_ASSERT(differentPixels < expectedPortal.GetNumberOfValues() / 20,
+                   "Decimated mesh renders differently: ",
+                   differentPixels,
+                   " pixels");
+
+  bool caught = false;
+  try
+  {
+    mapper.SetLevelOfDetailPixelSize(0.);
+  }
+  catch (vtkm::cont::ErrorBadValue&)
+  {
+    caught = true;
+  }
+  VTKM_TEST_ASSERT(caught, "Pixel size of 0 was accepted");
+}
+
+void Run()
+{
+  RenderTests();
+  TestMovingMesh();
+  TestStructuredBlocks();
+  TestProgressive();
+  TestTiled();
+  TestMultiView();
+  TestLevelOfDetail();
+}
+
 } //namespace
 
 int UnitTestMapperRayTracer(int argc, char* argv[])
 {
-  return vtkm::cont::testing::Testing::Run(RenderTests, argc, argv);
+  return vtkm::cont::testing::Testing::Run(Run, argc, argv);
 }
@@ -56,9 +56,89 @@ void RenderTests()
     rectDS, "hardyglobal", "rendering/volume/rectilinear3D.png", options);
 }
 
+void Render(vtkm::rendering::MapperVolume& mapper,
+            vtkm::rendering::CanvasRayTracer& canvas,
+            const vtkm::cont::DataSet& dataSet,
+            const vtkm::rendering::Camera& camera)
+{
+  vtkm::cont::ColorTable colorTable = vtkm::cont::ColorTable::Preset::Inferno;
+  colorTable.AddPointAlpha(0.0, .2f);
+  colorTable.AddPointAlpha(1.0, .2f);
+
+  canvas.Clear();
+  mapper.SetCanvas(&canvas);
+  mapper.SetActiveColorTable(colorTable);
+  mapper.RenderCells(dataSet.GetCellSet(),
+                     dataSet.GetCoordinateSystem(),
+                     dataSet.GetField("pointvar"),
+                     colorTable,
+                     camera,
+                     vtkm::Range(10, 180));
+}
+
+// Once every pixel is traced, a progressive image is the one of a regular render.
+void TestProgressive()
+{
+  std::cout << "Testing progressive rendering" << std::endl;
+  vtkm::cont::DataSet dataSet = vtkm::cont::testing::MakeTestDataSet().Make3DUniformDataSet1();
+
+  vtkm::rendering::Camera camera;
+  camera.ResetToBounds(dataSet.GetCoordinateSystem().GetBounds());
+  camera.Azimuth(30.f);
+  camera.Elevation(20.f);
+
+  vtkm::rendering::MapperVolume mapper;
+  vtkm::rendering::CanvasRayTracer expected(64, 64);
+  Render(mapper, expected, dataSet, camera);
+
+  vtkm::rendering::CanvasRayTracer canvas(64, 64);
+  canvas.SetProgressiveRendering(true);
+  canvas.SetProgressiveRayBudget(1000);
+  Render(mapper, canvas, dataSet, camera);
+  VTKM_TEST_ASSERT(!test_equal_ArrayHandles(canvas.GetColorBuffer(), expected.GetColorBuffer()),
+                   "First progressive render is complete");
+  vtkm::IdComponent numRenders = 1;
+  while (!canvas.IsProgressiveRenderingComplete())
+  {
+    Render(mapper, canvas, dataSet, camera);
+    ++numRenders;
+  }
+  VTKM_TEST_ASSERT(numRenders == 5, "Wrong number of progressive renders");
+  VTKM_TEST_ASSERT(test_equal_ArrayHandles(canvas.GetColorBuffer(), expected.GetColorBuffer()),
+                   "Complete progressive image differs");
+}
+
+void TestTiled()
+{
+  std::cout << "Testing tiled rendering" << std::endl;
+  vtkm::cont::DataSet dataSet = vtkm::cont::testing::MakeTestDataSet().Make3DUniformDataSet1();
+
+  vtkm::rendering::Camera camera;
+  camera.ResetToBounds(dataSet.GetCoordinateSystem().GetBounds());
+  camera.Azimuth(30.f);
+  camera.Elevation(20.f);
+
+  vtkm::rendering::MapperVolume mapper;
+  vtkm::rendering::CanvasRayTracer expected(64, 48);
+  Render(mapper, expected, dataSet, camera);
+
+  vtkm::rendering::CanvasRayTracer canvas(64, 48);
+  canvas.SetTileSize(20);
+  Render(mapper, canvas, dataSet, camera);
+  VTKM_TEST_ASSERT(test_equal_ArrayHandles(canvas.GetColorBuffer(), expected.GetColorBuffer()),
+                   "Tiled image differs");
+}
+
+void Run()
+{
+  RenderTests();
+  TestProgressive();
+  TestTiled();
+}
+
 } //namespace
 
 int UnitTestMapperVolume(int argc, char* argv[])
 {
-  return vtkm::cont::testing::Testing::Run(RenderTests, argc, argv);
+  return vtkm::cont::testing::Testing::Run(Run, argc, argv);
 }
@@ -11,6 +11,7 @@
 #include <vtkm/cont/ArrayCopy.h>
 #include <vtkm/cont/DataSetBuilderExplicit.h>
 #include <vtkm/cont/DataSetBuilderUniform.h>
+#include <vtkm/cont/ErrorBadValue.h>
 #include <vtkm/cont/testing/MakeTestDataSet.h>
 #include <vtkm/cont/testing/Testing.h>
 #include <vtkm/rendering/CanvasRayTracer.h>
@@ -150,9 +151,125 @@ void RenderTests()
   }
 }
 
+void Render(vtkm::rendering::CanvasRayTracer& canvas,
+            const vtkm::cont::DataSet& dataSet,
+            const std::string& fieldName,
+            const vtkm::rendering::Camera& camera,
+            bool showInternalZones,
+            vtkm::Id tileSize)
+{
+  canvas.Clear();
+  vtkm::rendering::MapperWireframer mapper;
+  mapper.SetCanvas(&canvas);
+  mapper.SetShowInternalZones(showInternalZones);
+  if (tileSize > 0)
+  {
+    mapper.SetUseTiledRasterizer(true);
+    mapper.SetRasterizerTileSize(tileSize);
+  }
+  vtkm::cont::ColorTable colorTable(vtkm::cont::ColorTable::Preset::Inferno);
+  mapper.SetActiveColorTable(colorTable);
+  vtkm::Range range;
+  dataSet.GetField(fieldName).GetRange(&range);
+  mapper.RenderCells(dataSet.GetCellSet(),
+                     dataSet.GetCoordinateSystem(),
+                     dataSet.GetField(fieldName),
+                     colorTable,
+                     camera,
+                     range);
+}
+
+vtkm::Id CountDifferentPixels(const vtkm::rendering::CanvasRayTracer& canvas1,
+                              const vtkm::rendering::CanvasRayTracer& canvas2)
+{
+  auto colors1 = canvas1.GetColorBuffer().ReadPortal();
+  auto colors2 = canvas2.GetColorBuffer().ReadPortal();
+  auto depths1 = canvas1.GetDepthBuffer().ReadPortal();
+  auto depths2 = canvas2.GetDepthBuffer().ReadPortal();
+  vtkm::Id count = 0;
+  for (vtkm::Id i = 0; i < colors1.GetNumberOfValues(); ++i)
+  {
+    if (colors1.Get(i) != colors2.Get(i) || depths1.Get(i) != depths2.Get(i))
+    {
+      ++count;
+    }
+  }
+  return count;
+}
+
+// The tiled rasterizer draws the same pixels as the atomic one. Tiles do not change the order in
+// which edges are drawn to a pixel, so any tile size gives the very same image.
+void TestTiledRasterizer()
+{
+  std::cout << "Testing the tiled rasterizer" << std::endl;
+  vtkm::cont::DataSet dataSet = Make3DUniformDataSet(16);
+  const vtkm::Id width = 200, height = 150;
+
+  for (vtkm::Float32 zoom : { 0.f, 1.5f, 6.f })
+  {
+    // Zooming in moves edges off the canvas, so that they are clipped. Zoomed far in, most edges
+    // start well outside of it.
+    vtkm::rendering::Camera camera;
+    camera.ResetToBounds(dataSet.GetCoordinateSystem().GetBounds());
+    camera.Azimuth(30.f);
+    camera.Elevation(25.f);
+    camera.Zoom(zoom);
+    for (bool showInternalZones : { true, false })
+    {
+      vtkm::rendering::CanvasRayTracer atomic(width, height);
+      Render(atomic, dataSet, "pointvar", camera, showInternalZones, 0);
+      vtkm::rendering::CanvasRayTracer tiled(width, height);
+      Render(tiled, dataSet, "pointvar", camera, showInternalZones, 16);
+      // Edges sharing a pixel may blend in any order with the atomic rasterizer on parallel
+      // devices, so allow for a few pixels there. On a serial device the images are identical.
+      VTKM_TEST_ASSERT(CountDifferentPixels(atomic, tiled) <= (width * height) / 100,
+                       "Tiled rasterizer draws other pixels");
+
+      for (vtkm::Id tileSize : { 1, 7, 64, 1000 })
+      {
+        vtkm::rendering::CanvasRayTracer other(width, height);
+        Render(other, dataSet, "pointvar", camera, showInternalZones, tileSize);
+        VTKM_TEST_ASSERT(CountDifferentPixels(tiled, other) == 0,
+                         "Image depends on the tile size ",
+                         tileSize);
+      }
+    }
+  }
+
+  vtkm::rendering::Camera camera;
+  vtkm::cont::DataSet lines = Make2DExplicitDataSet();
+  camera.SetModeTo2D();
+  camera.ResetToBounds(lines.GetCoordinateSystem().GetBounds());
+  vtkm::rendering::CanvasRayTracer atomic(width, height);
+  Render(atomic, lines, "pointVar", camera, true, 0);
+  vtkm::rendering::CanvasRayTracer tiled(width, height);
+  Render(tiled, lines, "pointVar", camera, true, 16);
+  VTKM_TEST_ASSERT(CountDifferentPixels(atomic, tiled) == 0, "Tiled rasterizer draws other lines");
+
+  vtkm::rendering::MapperWireframer mapper;
+  VTKM_TEST_ASSERT(!mapper.GetUseTiledRasterizer(), "Tiled rasterizer should be off by default");
+  VTKM_TEST_ASSERT(mapper.GetRasterizerTileSize() == 32, "Wrong default tile size");
+  bool threw = false;
+  try
+  {
+    mapper.SetRasterizerTileSize(0);
+  }
+  catch (vtkm::cont::ErrorBadValue&)
+  {
+    threw = true;
+  }
+  VTKM_TEST_ASSERT(threw, "Invalid tile size accepted");
+}
+
+void Run()
+{
+  RenderTests();
+  TestTiledRasterizer();
+}
+
 } //namespace
 
 int UnitTestMapperWireframer(int argc, char* argv[])
 {
-  return vtkm::cont::testing::Testing::Run(RenderTests, argc, argv);
+  return vtkm::cont::testing::Testing::Run(Run, argc, argv);
 }
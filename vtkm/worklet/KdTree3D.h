@@ -12,6 +12,7 @@
 
 #include <vtkm/worklet/spatialstructure/KdTree3DConstruction.h>
 #include <vtkm/worklet/spatialstructure/KdTree3DNNSearch.h>
+#include <vtkm/worklet/spatialstructure/KdTree3DNeighborSearch.h>
 
 namespace vtkm
 {
@@ -67,6 +68,41 @@ public:
       coords, this->PointIds, this->SplitIds, queryPoints, nearestNeighborIds, distances, deviceId);
   }
 
+  /// \brief k nearest neighbors search using KD-Tree
+  ///
+  /// For each point in \c queryPoints, finds the \c k closest points of \c coords. The ids and
+  /// squared distances of the neighbors of query point \c i are stored, sorted by distance, at
+  /// indices `[i * k, (i + 1) * k)` of \c neighborIds and \c distances2. When fewer than \c k
+  /// points exist, the remaining entries have an id of -1.
+  template <typename CoordType, typename CoordStorageTag1, typename CoordStorageTag2>
+  void RunKNearestNeighbors(
+    const vtkm::cont::ArrayHandle<vtkm::Vec<CoordType, 3>, CoordStorageTag1>& coords,
+    const vtkm::cont::ArrayHandle<vtkm::Vec<CoordType, 3>, CoordStorageTag2>& queryPoints,
+    vtkm::Id k,
+    vtkm::cont::ArrayHandle<vtkm::Id>& neighborIds,
+    vtkm::cont::ArrayHandle<CoordType>& distances2)
+  {
+    vtkm::worklet::spatialstructure::KdTree3DNeighborSearch().RunKNearestNeighbors(
+      coords, this->PointIds, this->SplitIds, queryPoints, k, neighborIds, distances2);
+  }
+
+  /// \brief Fixed radius search using KD-Tree
+  ///
+  /// For each point in \c queryPoints, finds all points of \c coords within \c radius. The
+  /// neighbors of query point \c i are `neighborIds[offsets[i]]` to
+  /// `neighborIds[offsets[i + 1] - 1]`, in no particular order.
+  template <typename CoordType, typename CoordStorageTag1, typename CoordStorageTag2>
+  void RunPointsWithinRadius(
+    const vtkm::cont::ArrayHandle<vtkm::Vec<CoordType, 3>, CoordStorageTag1>& coords,
+    const vtkm::cont::ArrayHandle<vtkm::Vec<CoordType, 3>, CoordStorageTag2>& queryPoints,
+    CoordType radius,
+    vtkm::cont::ArrayHandle<vtkm::Id>& offsets,
+    vtkm::cont::ArrayHandle<vtkm::Id>& neighborIds)
+  {
+    vtkm::worklet::spatialstructure::KdTree3DNeighborSearch().RunPointsWithinRadius(
+      coords, this->PointIds, this->SplitIds, queryPoints, radius, offsets, neighborIds);
+  }
+
 private:
   vtkm::cont::ArrayHandle<vtkm::Id> PointIds;
   vtkm::cont::ArrayHandle<vtkm::Id> SplitIds;
@@ -446,6 +446,8 @@ VTK_M_KEYS_EXPORT(vtkm::Id2);
 VTK_M_KEYS_EXPORT(vtkm::Id3);
 using Pair_UInt8_Id2 = vtkm::Pair<vtkm::UInt8, vtkm::Id2>;
 VTK_M_KEYS_EXPORT(Pair_UInt8_Id2);
+using Pair_IdComponent_Id2 = vtkm::Pair<vtkm::IdComponent, vtkm::Id2>;
+VTK_M_KEYS_EXPORT(Pair_IdComponent_Id2);
 #ifdef VTKM_USE_64BIT_IDS
 VTK_M_KEYS_EXPORT(vtkm::IdComponent);
 #endif
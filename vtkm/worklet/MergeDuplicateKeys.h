@@ -0,0 +1,130 @@
+//============================================================================
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//============================================================================
+#ifndef vtk_m_worklet_MergeDuplicateKeys_h
+#define vtk_m_worklet_MergeDuplicateKeys_h
+
+#include <vtkm/cont/Algorithm.h>
+#include <vtkm/cont/ArrayHandle.h>
+#include <vtkm/cont/ArrayHandleIndex.h>
+#include <vtkm/cont/ConcurrentHashTable.h>
+#include <vtkm/cont/Invoker.h>
+#include <vtkm/worklet/WorkletMapField.h>
+
+namespace vtkm
+{
+namespace worklet
+{
+
+namespace detail
+{
+
+struct MergeDuplicateKeysInsert : vtkm::worklet::WorkletMapField
+{
+  using ControlSignature = void(FieldIn key,
+                                ExecObject table,
+                                AtomicArrayInOut firstOccurrence,
+                                FieldOut slot);
+  using ExecutionSignature = void(_1, _2, _3, _4, WorkIndex);
+
+  template <typename AtomicPortal>
+  VTKM_EXEC void operator()(vtkm::UInt64 key,
+                            const vtkm::exec::ConcurrentHashTable& table,
+                            const AtomicPortal& firstOccurrence,
+                            vtkm::Id& slot,
+                            vtkm::Id index) const
+  {
+    slot = table.InsertOrGet(key);
+    // Atomic minimum, so that the result does not depend on which thread inserted the key.
+    vtkm::Id current = firstOccurrence.Get(slot);
+    while ((index < current) && !firstOccurrence.CompareExchange(slot, &current, index))
+    {
+    }
+  }
+};
+
+struct MergeDuplicateKeysIsFirst : vtkm::worklet::WorkletMapField
+{
+  using ControlSignature = void(FieldIn slot, WholeArrayIn firstOccurrence, FieldOut isFirst);
+  using ExecutionSignature = void(_1, _2, _3, WorkIndex);
+
+  template <typename Portal>
+  VTKM_EXEC void operator()(vtkm::Id slot,
+                            const Portal& firstOccurrence,
+                            vtkm::Id& isFirst,
+                            vtkm::Id index) const
+  {
+    isFirst = (firstOccurrence.Get(slot) == index) ? 1 : 0;
+  }
+};
+
+struct MergeDuplicateKeysMapToUnique : vtkm::worklet::WorkletMapField
+{
+  using ControlSignature = void(FieldIn slot,
+                                WholeArrayIn firstOccurrence,
+                                WholeArrayIn uniqueIndex,
+                                FieldOut inputToUnique);
+  using ExecutionSignature = void(_1, _2, _3, _4);
+
+  template <typename FirstPortal, typename UniquePortal>
+  VTKM_EXEC void operator()(vtkm::Id slot,
+                            const FirstPortal& firstOccurrence,
+                            const UniquePortal& uniqueIndex,
+                            vtkm::Id& inputToUnique) const
+  {
+    inputToUnique = uniqueIndex.Get(firstOccurrence.Get(slot));
+  }
+};
+
+} // namespace detail
+
+/// \brief Finds the distinct values of an array of keys using a `ConcurrentHashTable`.
+///
+/// On return, `uniqueToInput` holds the index of the first occurrence of each distinct key,
+/// in the order the keys first appear in `keys`, and `inputToUnique` maps every entry of
+/// `keys` to its position in `uniqueToInput`. The result does not depend on the order in
+/// which the threads insert the keys. This takes O(N) expected time, where sorting the keys
+/// (as `vtkm::worklet::Keys` does) takes O(N log N).
+///
+/// None of the keys may be equal to `vtkm::cont::ConcurrentHashTable::EmptyKey()`.
+///
+template <typename KeyStorage>
+VTKM_CONT void MergeDuplicateKeys(
+  const vtkm::cont::ArrayHandle<vtkm::UInt64, KeyStorage>& keys,
+  vtkm::cont::ArrayHandle<vtkm::Id>& inputToUnique,
+  vtkm::cont::ArrayHandle<vtkm::Id>& uniqueToInput,
+  vtkm::cont::DeviceAdapterId device = vtkm::cont::DeviceAdapterTagAny{})
+{
+  const vtkm::Id numberOfKeys = keys.GetNumberOfValues();
+  vtkm::cont::Invoker invoke(device);
+
+  vtkm::cont::ConcurrentHashTable table(numberOfKeys);
+  vtkm::cont::ArrayHandle<vtkm::Id> firstOccurrence;
+  firstOccurrence.AllocateAndFill(table.GetCapacity(), numberOfKeys);
+  vtkm::cont::ArrayHandle<vtkm::Id> slots;
+  invoke(detail::MergeDuplicateKeysInsert{}, keys, table, firstOccurrence, slots);
+
+  vtkm::cont::ArrayHandle<vtkm::Id> isFirst;
+  invoke(detail::MergeDuplicateKeysIsFirst{}, slots, firstOccurrence, isFirst);
+  vtkm::cont::Algorithm::CopyIf(
+    device, vtkm::cont::ArrayHandleIndex(numberOfKeys), isFirst, uniqueToInput);
+
+  vtkm::cont::ArrayHandle<vtkm::Id> uniqueIndex;
+  vtkm::cont::Algorithm::ScanExclusive(device, isFirst, uniqueIndex);
+  invoke(detail::MergeDuplicateKeysMapToUnique{},
+         slots,
+         firstOccurrence,
+         uniqueIndex,
+         inputToUnique);
+}
+
+}
+} // namespace vtkm::worklet
+
+#endif //vtk_m_worklet_MergeDuplicateKeys_h
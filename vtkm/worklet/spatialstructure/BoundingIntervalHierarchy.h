@@ -28,6 +28,7 @@
 #include <vtkm/worklet/DispatcherMapField.h>
 #include <vtkm/worklet/WorkletMapField.h>
 #include <vtkm/worklet/WorkletMapTopology.h>
+#include <vtkm/worklet/spatialstructure/MortonCode.h>
 
 namespace vtkm
 {
@@ -552,6 +553,251 @@ struct TreeLevelAdder : public vtkm::worklet::WorkletMapField
   vtkm::IdComponent MaxLeafSize;
 }; // struct TreeLevelAdder
 
+// The following worklets build the hierarchy from cells sorted by the Morton code of their
+// centers. Like a radix tree, a segment of sorted cells is split where the highest bit that
+// differs between its first and last code flips, so that children are compact in space.
+// The tree is built one level at a time, but every level only touches its segments.
+struct CellMortonCodeCalculator : public vtkm::worklet::WorkletMapField
+{
+  typedef void ControlSignature(FieldIn centerXs, FieldIn centerYs, FieldIn centerZs, FieldOut);
+  typedef void ExecutionSignature(_1, _2, _3, _4);
+
+  VTKM_CONT
+  CellMortonCodeCalculator(const vtkm::Vec3f& minPoint, const vtkm::Vec3f& inverseExtent)
+    : MinPoint(minPoint)
+    , InverseExtent(inverseExtent)
+  {
+  }
+
+  VTKM_EXEC
+  void operator()(vtkm::FloatDefault centerX,
+                  vtkm::FloatDefault centerY,
+                  vtkm::FloatDefault centerZ,
+                  vtkm::UInt32& code) const
+  {
+    code = MortonCode30((vtkm::Vec3f(centerX, centerY, centerZ) - this->MinPoint) *
+                        this->InverseExtent);
+  }
+
+  vtkm::Vec3f MinPoint;
+  vtkm::Vec3f InverseExtent;
+}; // struct CellMortonCodeCalculator
+
+struct MortonSegmentSplitter : public vtkm::worklet::WorkletMapField
+{
+  typedef void ControlSignature(FieldIn segmentStarts,
+                                FieldIn segmentSizes,
+                                WholeArrayIn mortonCodes,
+                                FieldOut leftSizes,
+                                FieldOut splitFlags);
+  typedef void ExecutionSignature(_1, _2, _3, _4, _5);
+  using InputDomain = _1;
+
+  VTKM_CONT
+  MortonSegmentSplitter(vtkm::IdComponent maxLeafSize)
+    : MaxLeafSize(maxLeafSize)
+  {
+  }
+
+  template <typename CodePortal>
+  VTKM_EXEC void operator()(vtkm::Id start,
+                            vtkm::Id size,
+                            const CodePortal& codes,
+                            vtkm::Id& leftSize,
+                            vtkm::Id& splitFlag) const
+  {
+    leftSize = 0;
+    splitFlag = size > vtkm::Max(this->MaxLeafSize, vtkm::IdComponent(1));
+    if (!splitFlag)
+    {
+      return;
+    }
+
+    vtkm::UInt32 firstCode = codes.Get(start);
+    vtkm::UInt32 diff = firstCode ^ codes.Get(start + size - 1);
+    if (diff == 0)
+    {
+      // All cells have the same code. Split in the middle.
+      leftSize = size / 2;
+      return;
+    }
+
+    // Keep only the highest differing bit.
+    diff |= diff >> 1;
+    diff |= diff >> 2;
+    diff |= diff >> 4;
+    diff |= diff >> 8;
+    diff |= diff >> 16;
+    vtkm::UInt32 highestBit = diff ^ (diff >> 1);
+
+    // The codes are sorted, so the bit is 0 for the first part and 1 for the rest.
+    vtkm::Id low = 1;
+    vtkm::Id high = size - 1;
+    while (low < high)
+    {
+      vtkm::Id mid = (low + high) / 2;
+      if ((codes.Get(start + mid) & highestBit) != 0)
+      {
+        high = mid;
+      }
+      else
+      {
+        low = mid + 1;
+      }
+    }
+    leftSize = low;
+  }
+
+  vtkm::IdComponent MaxLeafSize;
+}; // struct MortonSegmentSplitter
+
+struct MortonTreeLevelAdder : public vtkm::worklet::WorkletMapField
+{
+  typedef void ControlSignature(FieldIn nodeIndices,
+                                FieldIn segmentStarts,
+                                FieldIn segmentSizes,
+                                FieldIn parentIndices,
+                                FieldIn leftSizes,
+                                FieldIn splitFlags,
+                                FieldIn runningSplitSegmentCounts,
+                                FieldOut nodes,
+                                WholeArrayOut nextSegmentStarts,
+                                WholeArrayOut nextSegmentSizes,
+                                WholeArrayOut nextParentIndices);
+  typedef void ExecutionSignature(_1, _2, _3, _4, _5, _6, _7, _8, _9, _10, _11);
+  using InputDomain = _1;
+
+  VTKM_CONT
+  MortonTreeLevelAdder(vtkm::Id nextLevelOffset)
+    : NextLevelOffset(nextLevelOffset)
+  {
+  }
+
+  template <typename NextIdPortal>
+  VTKM_EXEC void operator()(vtkm::Id index,
+                            vtkm::Id start,
+                            vtkm::Id size,
+                            vtkm::Id parentIndex,
+                            vtkm::Id leftSize,
+                            vtkm::Id splitFlag,
+                            vtkm::Id numPreviousSplits,
+                            vtkm::exec::CellLocatorBoundingIntervalHierarchyNode& node,
+                            NextIdPortal& nextStarts,
+                            NextIdPortal& nextSizes,
+                            NextIdPortal& nextParents) const
+  {
+    node.ParentIndex = parentIndex;
+    node.Dimension = 0;
+    if (splitFlag)
+    {
+      vtkm::Id left = 2 * numPreviousSplits;
+      node.ChildIndex = this->NextLevelOffset + left;
+      nextStarts.Set(left, start);
+      nextSizes.Set(left, leftSize);
+      nextParents.Set(left, index);
+      nextStarts.Set(left + 1, start + leftSize);
+      nextSizes.Set(left + 1, size - leftSize);
+      nextParents.Set(left + 1, index);
+    }
+    else
+    {
+      node.ChildIndex = -1;
+      node.Leaf.Start = start;
+      node.Leaf.Size = size;
+    }
+  }
+
+  vtkm::Id NextLevelOffset;
+}; // struct MortonTreeLevelAdder
+
+struct MortonLeafBoundsCalculator : public vtkm::worklet::WorkletMapField
+{
+  typedef void ControlSignature(FieldIn nodes,
+                                WholeArrayIn cellIds,
+                                WholeArrayIn xRanges,
+                                WholeArrayIn yRanges,
+                                WholeArrayIn zRanges,
+                                FieldOut nodeBounds);
+  typedef void ExecutionSignature(_1, _2, _3, _4, _5, _6);
+  using InputDomain = _1;
+
+  template <typename CellIdPortal, typename RangePortal>
+  VTKM_EXEC void operator()(const vtkm::exec::CellLocatorBoundingIntervalHierarchyNode& node,
+                            const CellIdPortal& cellIds,
+                            const RangePortal& xRanges,
+                            const RangePortal& yRanges,
+                            const RangePortal& zRanges,
+                            vtkm::Bounds& bounds) const
+  {
+    bounds = vtkm::Bounds();
+    if (node.ChildIndex >= 0)
+    {
+      return;
+    }
+    for (vtkm::Id i = node.Leaf.Start; i < node.Leaf.Start + node.Leaf.Size; ++i)
+    {
+      vtkm::Id cellId = cellIds.Get(i);
+      bounds.X.Include(xRanges.Get(cellId));
+      bounds.Y.Include(yRanges.Get(cellId));
+      bounds.Z.Include(zRanges.Get(cellId));
+    }
+  }
+}; // struct MortonLeafBoundsCalculator
+
+struct MortonNodeBoundsCalculator : public vtkm::worklet::WorkletMapField
+{
+  typedef void ControlSignature(FieldIn nodeIndices, WholeArrayIn nodes, WholeArrayInOut bounds);
+  typedef void ExecutionSignature(_1, _2, _3);
+  using InputDomain = _1;
+
+  template <typename NodePortal, typename BoundsPortal>
+  VTKM_EXEC void operator()(vtkm::Id index, const NodePortal& nodes, BoundsPortal& bounds) const
+  {
+    vtkm::Id child = nodes.Get(index).ChildIndex;
+    if (child >= 0)
+    {
+      bounds.Set(index, bounds.Get(child).Union(bounds.Get(child + 1)));
+    }
+  }
+}; // struct MortonNodeBoundsCalculator
+
+struct MortonSplitPlaneSelector : public vtkm::worklet::WorkletMapField
+{
+  typedef void ControlSignature(FieldInOut nodes, WholeArrayIn bounds);
+  typedef void ExecutionSignature(_1, _2);
+  using InputDomain = _1;
+
+  template <typename BoundsPortal>
+  VTKM_EXEC void operator()(vtkm::exec::CellLocatorBoundingIntervalHierarchyNode& node,
+                            const BoundsPortal& bounds) const
+  {
+    if (node.ChildIndex < 0)
+    {
+      return;
+    }
+
+    // Split along the dimension where the children are best separated.
+    const vtkm::Bounds left = bounds.Get(node.ChildIndex);
+    const vtkm::Bounds right = bounds.Get(node.ChildIndex + 1);
+    const vtkm::Range leftRanges[3] = { left.X, left.Y, left.Z };
+    const vtkm::Range rightRanges[3] = { right.X, right.Y, right.Z };
+    vtkm::IdComponent bestDimension = 0;
+    vtkm::Float64 bestGap = vtkm::NegativeInfinity64();
+    for (vtkm::IdComponent dim = 0; dim < 3; ++dim)
+    {
+      vtkm::Float64 gap = rightRanges[dim].Min - leftRanges[dim].Max;
+      if (gap > bestGap)
+      {
+        bestGap = gap;
+        bestDimension = dim;
+      }
+    }
+    node.Dimension = bestDimension;
+    node.Node.LMax = static_cast<vtkm::FloatDefault>(leftRanges[bestDimension].Max);
+    node.Node.RMin = static_cast<vtkm::FloatDefault>(rightRanges[bestDimension].Min);
+  }
+}; // struct MortonSplitPlaneSelector
+
 template <typename T, class BinaryFunctor>
 vtkm::cont::ArrayHandle<T> ReverseScanInclusiveByKey(const vtkm::cont::ArrayHandle<T>& keys,
                                                      const vtkm::cont::ArrayHandle<T>& values,
@@ -0,0 +1,409 @@
+//============================================================================
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//============================================================================
+
+#ifndef vtk_m_worklet_KdTree3DNeighborSearch_h
+#define vtk_m_worklet_KdTree3DNeighborSearch_h
+
+#include <vtkm/Math.h>
+#include <vtkm/VectorAnalysis.h>
+#include <vtkm/cont/ArrayHandle.h>
+#include <vtkm/cont/ArrayHandleView.h>
+#include <vtkm/cont/ConvertNumComponentsToOffsets.h>
+#include <vtkm/cont/Invoker.h>
+
+#include <vtkm/worklet/WorkletMapField.h>
+
+#ifdef VTKM_CUDA
+#include <vtkm/cont/cuda/internal/ScopedCudaStackSize.h>
+#endif
+
+namespace vtkm
+{
+namespace worklet
+{
+namespace spatialstructure
+{
+
+/// \brief k nearest neighbor and fixed radius searches on a KD-tree
+///
+/// Uses the tree built by `KdTree3DConstruction`. Like `KdTree3DNNSearch`, the tree is
+/// traversed recursively, pruning a subtree when the splitting plane is farther away than the
+/// current search radius (the distance to the k-th neighbor found so far, or the fixed radius).
+class VTKM_DEPRECATED(1.7, "K-D tree recursive searches are not well supported on GPU devices.")
+  KdTree3DNeighborSearch
+{
+public:
+  // The neighbors of a query are written to the output portals from index Offset on.
+  template <typename CoordType, typename IdPortalType, typename DistancePortalType>
+  struct KNearestVisitor
+  {
+    vtkm::Id K;
+    vtkm::Id NumFound;
+    vtkm::Id Offset;
+    const IdPortalType& Ids;
+    const DistancePortalType& Distances2;
+
+    VTKM_EXEC KNearestVisitor(vtkm::Id k,
+                              vtkm::Id offset,
+                              const IdPortalType& ids,
+                              const DistancePortalType& distances2)
+      : K(k)
+      , NumFound(0)
+      , Offset(offset)
+      , Ids(ids)
+      , Distances2(distances2)
+    {
+    }
+
+    VTKM_EXEC CoordType SearchRadius2() const
+    {
+      return (this->NumFound < this->K)
+        ? vtkm::Infinity<CoordType>()
+        : static_cast<CoordType>(this->Distances2.Get(this->Offset + this->K - 1));
+    }
+
+    VTKM_EXEC void operator()(vtkm::Id pointId, CoordType distance2)
+    {
+      if (distance2 >= this->SearchRadius2())
+      {
+        return;
+      }
+
+      // Insertion into the list sorted by increasing distance.
+      vtkm::Id pos = this->Offset + ((this->NumFound < this->K) ? this->NumFound++ : this->K - 1);
+      while ((pos > this->Offset) && (this->Distances2.Get(pos - 1) > distance2))
+      {
+        this->Ids.Set(pos, this->Ids.Get(pos - 1));
+        this->Distances2.Set(pos, this->Distances2.Get(pos - 1));
+        --pos;
+      }
+      this->Ids.Set(pos, pointId);
+      this->Distances2.Set(pos, distance2);
+    }
+  };
+
+  template <typename CoordType>
+  struct RadiusCountVisitor
+  {
+    CoordType Radius2;
+    vtkm::Id Count;
+
+    VTKM_EXEC RadiusCountVisitor(CoordType radius2)
+      : Radius2(radius2)
+      , Count(0)
+    {
+    }
+
+    VTKM_EXEC CoordType SearchRadius2() const { return this->Radius2; }
+
+    VTKM_EXEC void operator()(vtkm::Id, CoordType distance2)
+    {
+      if (distance2 <= this->Radius2)
+      {
+        ++this->Count;
+      }
+    }
+  };
+
+  template <typename CoordType, typename IdPortalType>
+  struct RadiusFillVisitor
+  {
+    CoordType Radius2;
+    vtkm::Id Next;
+    const IdPortalType& Ids;
+
+    VTKM_EXEC RadiusFillVisitor(CoordType radius2, vtkm::Id offset, const IdPortalType& ids)
+      : Radius2(radius2)
+      , Next(offset)
+      , Ids(ids)
+    {
+    }
+
+    VTKM_EXEC CoordType SearchRadius2() const { return this->Radius2; }
+
+    VTKM_EXEC void operator()(vtkm::Id pointId, CoordType distance2)
+    {
+      if (distance2 <= this->Radius2)
+      {
+        this->Ids.Set(this->Next++, pointId);
+      }
+    }
+  };
+
+  template <typename CoordVecT,
+            typename IdPortalT,
+            typename CoordPortalT,
+            typename Visitor>
+  VTKM_EXEC static void Search3D(const CoordVecT& qc,
+                                 vtkm::Int32 level,
+                                 vtkm::Id sIdx,
+                                 vtkm::Id tIdx,
+                                 const IdPortalT& treePortal,
+                                 const IdPortalT& splitIdPortal,
+                                 const CoordPortalT& coordPortal,
+                                 Visitor& visitor)
+  {
+    if (tIdx - sIdx == 1)
+    { ///// leaf node
+      vtkm::Id leafNodeIdx = treePortal.Get(sIdx);
+      visitor(leafNodeIdx, vtkm::MagnitudeSquared(coordPortal.Get(leafNodeIdx) - qc));
+    }
+    else
+    { //normal Node
+      vtkm::Id splitNodeLoc = (sIdx + tIdx + 1) / 2;
+      vtkm::IdComponent axis = level % 3;
+      auto diff = qc[axis] - coordPortal.Get(splitIdPortal.Get(splitNodeLoc))[axis];
+
+      vtkm::Id nearStart = sIdx, nearEnd = splitNodeLoc;
+      vtkm::Id farStart = splitNodeLoc, farEnd = tIdx;
+      if (diff > 0)
+      { //right tree first
+        nearStart = splitNodeLoc;
+        nearEnd = tIdx;
+        farStart = sIdx;
+        farEnd = splitNodeLoc;
+      }
+
+      Search3D(qc, level + 1, nearStart, nearEnd, treePortal, splitIdPortal, coordPortal, visitor);
+      if ((diff * diff) <= visitor.SearchRadius2())
+      {
+        Search3D(qc, level + 1, farStart, farEnd, treePortal, splitIdPortal, coordPortal, visitor);
+      }
+    }
+  }
+
+  class KNearestNeighborSearch3DWorklet : public vtkm::worklet::WorkletMapField
+  {
+  public:
+    using ControlSignature = void(FieldIn qcIn,
+                                  WholeArrayIn treeIdIn,
+                                  WholeArrayIn treeSplitIdIn,
+                                  WholeArrayIn treeCoordiIn,
+                                  WholeArrayOut nnIdOut,
+                                  WholeArrayOut nnDis2Out);
+    using ExecutionSignature = void(_1, _2, _3, _4, _5, _6, WorkIndex);
+
+    VTKM_CONT
+    KNearestNeighborSearch3DWorklet(vtkm::Id k)
+      : K(k)
+    {
+    }
+
+    template <typename CoordiVecType,
+              typename IdPortalType,
+              typename CoordiPortalType,
+              typename OutIdPortalType,
+              typename OutDistancePortalType>
+    VTKM_EXEC void operator()(const CoordiVecType& qc,
+                              const IdPortalType& treeIdPortal,
+                              const IdPortalType& treeSplitIdPortal,
+                              const CoordiPortalType& treeCoordiPortal,
+                              const OutIdPortalType& nnIdPortal,
+                              const OutDistancePortalType& nnDis2Portal,
+                              vtkm::Id workIndex) const
+    {
+      using CoordType = typename OutDistancePortalType::ValueType;
+
+      const vtkm::Id offset = workIndex * this->K;
+      KNearestVisitor<CoordType, OutIdPortalType, OutDistancePortalType> visitor(
+        this->K, offset, nnIdPortal, nnDis2Portal);
+      Search3D(qc,
+               0,
+               0,
+               treeIdPortal.GetNumberOfValues(),
+               treeIdPortal,
+               treeSplitIdPortal,
+               treeCoordiPortal,
+               visitor);
+      for (vtkm::Id i = visitor.NumFound; i < this->K; ++i)
+      {
+        nnIdPortal.Set(offset + i, -1);
+        nnDis2Portal.Set(offset + i, vtkm::Infinity<CoordType>());
+      }
+    }
+
+  private:
+    vtkm::Id K;
+  };
+
+  template <typename CoordType>
+  class CountWithinRadius3DWorklet : public vtkm::worklet::WorkletMapField
+  {
+  public:
+    using ControlSignature = void(FieldIn qcIn,
+                                  WholeArrayIn treeIdIn,
+                                  WholeArrayIn treeSplitIdIn,
+                                  WholeArrayIn treeCoordiIn,
+                                  FieldOut count);
+    using ExecutionSignature = void(_1, _2, _3, _4, _5);
+
+    VTKM_CONT
+    CountWithinRadius3DWorklet(CoordType radius)
+      : Radius2(radius * radius)
+    {
+    }
+
+    template <typename CoordiVecType, typename IdPortalType, typename CoordiPortalType>
+    VTKM_EXEC void operator()(const CoordiVecType& qc,
+                              const IdPortalType& treeIdPortal,
+                              const IdPortalType& treeSplitIdPortal,
+                              const CoordiPortalType& treeCoordiPortal,
+                              vtkm::Id& count) const
+    {
+      RadiusCountVisitor<CoordType> visitor(this->Radius2);
+      Search3D(qc,
+               0,
+               0,
+               treeIdPortal.GetNumberOfValues(),
+               treeIdPortal,
+               treeSplitIdPortal,
+               treeCoordiPortal,
+               visitor);
+      count = visitor.Count;
+    }
+
+  private:
+    CoordType Radius2;
+  };
+
+  template <typename CoordType>
+  class FindWithinRadius3DWorklet : public vtkm::worklet::WorkletMapField
+  {
+  public:
+    using ControlSignature = void(FieldIn qcIn,
+                                  FieldIn offset,
+                                  WholeArrayIn treeIdIn,
+                                  WholeArrayIn treeSplitIdIn,
+                                  WholeArrayIn treeCoordiIn,
+                                  WholeArrayOut neighborIds);
+    using ExecutionSignature = void(_1, _2, _3, _4, _5, _6);
+
+    VTKM_CONT
+    FindWithinRadius3DWorklet(CoordType radius)
+      : Radius2(radius * radius)
+    {
+    }
+
+    template <typename CoordiVecType,
+              typename IdPortalType,
+              typename CoordiPortalType,
+              typename OutIdPortalType>
+    VTKM_EXEC void operator()(const CoordiVecType& qc,
+                              vtkm::Id offset,
+                              const IdPortalType& treeIdPortal,
+                              const IdPortalType& treeSplitIdPortal,
+                              const CoordiPortalType& treeCoordiPortal,
+                              const OutIdPortalType& neighborIdPortal) const
+    {
+      RadiusFillVisitor<CoordType, OutIdPortalType> visitor(
+        this->Radius2, offset, neighborIdPortal);
+      Search3D(qc,
+               0,
+               0,
+               treeIdPortal.GetNumberOfValues(),
+               treeIdPortal,
+               treeSplitIdPortal,
+               treeCoordiPortal,
+               visitor);
+    }
+
+  private:
+    CoordType Radius2;
+  };
+
+  /// \brief Find the \c k nearest neighbors of each query point.
+  ///
+  /// The ids and squared distances of the neighbors of query point \c i are stored at indices
+  /// `[i * k, (i + 1) * k)` of \c nnId_Handle and \c nnDis2_Handle, sorted by increasing
+  /// distance. Missing neighbors, such as when \c k is larger than the number of points, are
+  /// marked with an id of -1 and an infinite distance.
+  template <typename CoordType, typename CoordStorageTag1, typename CoordStorageTag2>
+  void RunKNearestNeighbors(
+    const vtkm::cont::ArrayHandle<vtkm::Vec<CoordType, 3>, CoordStorageTag1>& coordi_Handle,
+    const vtkm::cont::ArrayHandle<vtkm::Id>& pointId_Handle,
+    const vtkm::cont::ArrayHandle<vtkm::Id>& splitId_Handle,
+    const vtkm::cont::ArrayHandle<vtkm::Vec<CoordType, 3>, CoordStorageTag2>& qc_Handle,
+    vtkm::Id k,
+    vtkm::cont::ArrayHandle<vtkm::Id>& nnId_Handle,
+    vtkm::cont::ArrayHandle<CoordType>& nnDis2_Handle)
+  {
+    k = vtkm::Max(k, vtkm::Id(0));
+    nnId_Handle.Allocate(qc_Handle.GetNumberOfValues() * k);
+    nnDis2_Handle.Allocate(qc_Handle.GetNumberOfValues() * k);
+    if (k == 0)
+    {
+      return;
+    }
+
+//set up stack size for cuda environment
+#ifdef VTKM_CUDA
+    vtkm::cont::cuda::internal::ScopedCudaStackSize stack(16 * 1024);
+    (void)stack;
+#endif
+
+    vtkm::cont::Invoker invoke;
+    invoke(KNearestNeighborSearch3DWorklet{ k },
+           qc_Handle,
+           pointId_Handle,
+           splitId_Handle,
+           coordi_Handle,
+           nnId_Handle,
+           nnDis2_Handle);
+  }
+
+  /// \brief Find all points within \c radius of each query point.
+  ///
+  /// The result is returned in compressed sparse row form using a count pass followed by a
+  /// fill pass: the neighbors of query point \c i are `neighborIds[offsets[i]]` through
+  /// `neighborIds[offsets[i + 1] - 1]`.
+  template <typename CoordType, typename CoordStorageTag1, typename CoordStorageTag2>
+  void RunPointsWithinRadius(
+    const vtkm::cont::ArrayHandle<vtkm::Vec<CoordType, 3>, CoordStorageTag1>& coordi_Handle,
+    const vtkm::cont::ArrayHandle<vtkm::Id>& pointId_Handle,
+    const vtkm::cont::ArrayHandle<vtkm::Id>& splitId_Handle,
+    const vtkm::cont::ArrayHandle<vtkm::Vec<CoordType, 3>, CoordStorageTag2>& qc_Handle,
+    CoordType radius,
+    vtkm::cont::ArrayHandle<vtkm::Id>& offsets,
+    vtkm::cont::ArrayHandle<vtkm::Id>& neighborIds)
+  {
+//set up stack size for cuda environment
+#ifdef VTKM_CUDA
+    vtkm::cont::cuda::internal::ScopedCudaStackSize stack(16 * 1024);
+    (void)stack;
+#endif
+
+    vtkm::cont::Invoker invoke;
+    vtkm::cont::ArrayHandle<vtkm::Id> counts;
+    invoke(CountWithinRadius3DWorklet<CoordType>{ radius },
+           qc_Handle,
+           pointId_Handle,
+           splitId_Handle,
+           coordi_Handle,
+           counts);
+
+    vtkm::Id numNeighbors;
+    vtkm::cont::ConvertNumComponentsToOffsets(counts, offsets, numNeighbors);
+    neighborIds.Allocate(numNeighbors);
+
+    auto starts = vtkm::cont::make_ArrayHandleView(offsets, 0, qc_Handle.GetNumberOfValues());
+    invoke(FindWithinRadius3DWorklet<CoordType>{ radius },
+           qc_Handle,
+           starts,
+           pointId_Handle,
+           splitId_Handle,
+           coordi_Handle,
+           neighborIds);
+  }
+};
+}
+}
+} // namespace vtkm::worklet
+
+#endif // vtk_m_worklet_KdTree3DNeighborSearch_h
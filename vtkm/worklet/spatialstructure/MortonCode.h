@@ -0,0 +1,55 @@
+//============================================================================
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//============================================================================
+
+#ifndef vtk_m_worklet_spatialstructure_MortonCode_h
+#define vtk_m_worklet_spatialstructure_MortonCode_h
+
+#include <vtkm/Math.h>
+#include <vtkm/Types.h>
+
+namespace vtkm
+{
+namespace worklet
+{
+namespace spatialstructure
+{
+
+/// \brief Spreads the 10 low bits of \c x so that two zero bits separate each of them.
+VTKM_EXEC_CONT inline vtkm::UInt32 MortonExpandBits(vtkm::UInt32 x)
+{
+  x = (x | (x << 16)) & 0x030000FF;
+  x = (x | (x << 8)) & 0x0300F00F;
+  x = (x | (x << 4)) & 0x030C30C3;
+  x = (x | (x << 2)) & 0x09249249;
+  return x;
+}
+
+/// \brief 30 bit Morton code of a point given in the unit cube.
+///
+/// Each coordinate is quantized to 10 bits, and points outside of the unit cube are clamped to
+/// it. The bits of z are the most significant of each triple.
+///
+VTKM_EXEC_CONT inline vtkm::UInt32 MortonCode30(const vtkm::Vec3f& point)
+{
+  vtkm::UInt32 bits[3];
+  for (vtkm::IdComponent i = 0; i < 3; ++i)
+  {
+    const vtkm::FloatDefault v = point[i] * vtkm::FloatDefault(1024);
+    bits[i] = MortonExpandBits(static_cast<vtkm::UInt32>(
+      vtkm::Min(vtkm::Max(v, vtkm::FloatDefault(0)), vtkm::FloatDefault(1023))));
+  }
+  return (bits[2] << 2) | (bits[1] << 1) | bits[0];
+}
+
+} // namespace spatialstructure
+} // namespace worklet
+} // namespace vtkm
+
+#endif // vtk_m_worklet_spatialstructure_MortonCode_h
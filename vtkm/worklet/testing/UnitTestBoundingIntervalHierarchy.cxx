@@ -64,7 +64,11 @@ vtkm::cont::DataSet ConstructDataSet(vtkm::Id size)
   return vtkm::cont::DataSetBuilderUniform().Create(vtkm::Id3(size, size, size));
 }
 
-void TestBoundingIntervalHierarchy(vtkm::cont::DataSet dataSet, vtkm::IdComponent numPlanes)
+void TestBoundingIntervalHierarchy(
+  vtkm::cont::DataSet dataSet,
+  vtkm::IdComponent numPlanes,
+  vtkm::cont::CellLocatorBoundingIntervalHierarchy::BuildMethod method =
+    vtkm::cont::CellLocatorBoundingIntervalHierarchy::BuildMethod::SplitPlanes)
 {
 
   vtkm::cont::UnknownCellSet cellSet = dataSet.GetCellSet();
@@ -72,6 +76,7 @@ void TestBoundingIntervalHierarchy(vtkm::cont::DataSet dataSet, vtkm::IdComponen
 
   vtkm::cont::CellLocatorBoundingIntervalHierarchy bih =
     vtkm::cont::CellLocatorBoundingIntervalHierarchy(numPlanes, 5);
+  bih.SetBuildMethod(method);
   bih.SetCellSet(cellSet);
   bih.SetCoordinates(dataSet.GetCoordinateSystem());
   bih.Update();
@@ -108,6 +113,10 @@ void RunTest()
   TestBoundingIntervalHierarchy(ConstructDataSet(8), 4);
   TestBoundingIntervalHierarchy(ConstructDataSet(8), 6);
   TestBoundingIntervalHierarchy(ConstructDataSet(8), 9);
+
+  using BuildMethod = vtkm::cont::CellLocatorBoundingIntervalHierarchy::BuildMethod;
+  TestBoundingIntervalHierarchy(ConstructDataSet(8), 4, BuildMethod::MortonCode);
+  TestBoundingIntervalHierarchy(ConstructDataSet(13), 4, BuildMethod::MortonCode);
 }
 
 } // anonymous namespace
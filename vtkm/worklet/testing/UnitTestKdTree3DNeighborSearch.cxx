@@ -0,0 +1,188 @@
+//============================================================================
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//============================================================================
+
+#include <vtkm/cont/testing/Testing.h>
+
+#include <algorithm>
+#include <random>
+#include <vector>
+
+VTKM_DEPRECATED_SUPPRESS_BEGIN
+#include <vtkm/worklet/KdTree3D.h>
+
+namespace
+{
+
+using PointsType = std::vector<vtkm::Vec3f_32>;
+
+// Random points, and a copy of a few of them so that some points are at distance 0 of others.
+PointsType MakePoints(vtkm::Id numPoints)
+{
+  std::default_random_engine dre;
+  std::uniform_real_distribution<vtkm::Float32> dr(0.0f, 10.0f);
+  PointsType points;
+  for (vtkm::Id i = 0; i < numPoints; i++)
+  {
+    points.push_back(vtkm::make_Vec(dr(dre), dr(dre), dr(dre)));
+  }
+  for (std::size_t i = 0; i < points.size(); i += 7)
+  {
+    points.push_back(points[i]);
+  }
+  return points;
+}
+
+PointsType MakeQueries(const PointsType& points)
+{
+  std::default_random_engine dre(1);
+  std::uniform_real_distribution<vtkm::Float32> dr(-1.0f, 11.0f);
+  PointsType queries;
+  for (vtkm::Id i = 0; i < 20; i++)
+  {
+    queries.push_back(vtkm::make_Vec(dr(dre), dr(dre), dr(dre)));
+  }
+  // Queries on points, some of which have duplicates.
+  queries.push_back(points[0]);
+  queries.push_back(points[1]);
+  queries.push_back(points[7]);
+  return queries;
+}
+
+std::vector<vtkm::Float32> BruteForceDistances2(const PointsType& points,
+                                                const vtkm::Vec3f_32& query)
+{
+  std::vector<vtkm::Float32> distances2;
+  for (const auto& point : points)
+  {
+    distances2.push_back(vtkm::MagnitudeSquared(point - query));
+  }
+  return distances2;
+}
+
+void TestKNearestNeighbors(const PointsType& points, vtkm::Id k)
+{
+  std::cout << "Testing " << k << " nearest neighbors of " << points.size() << " points"
+            << std::endl;
+  auto pointsHandle = vtkm::cont::make_ArrayHandle(points, vtkm::CopyFlag::Off);
+  const PointsType queries = MakeQueries(points);
+  auto queriesHandle = vtkm::cont::make_ArrayHandle(queries, vtkm::CopyFlag::Off);
+
+  vtkm::worklet::KdTree3D kdtree;
+  kdtree.Build(pointsHandle);
+  vtkm::cont::ArrayHandle<vtkm::Id> neighborIds;
+  vtkm::cont::ArrayHandle<vtkm::Float32> distances2;
+  kdtree.RunKNearestNeighbors(pointsHandle, queriesHandle, k, neighborIds, distances2);
+  VTKM_TEST_ASSERT(neighborIds.GetNumberOfValues() == static_cast<vtkm::Id>(queries.size()) * k,
+                   "Wrong number of neighbor ids");
+  VTKM_TEST_ASSERT(distances2.GetNumberOfValues() == neighborIds.GetNumberOfValues(),
+                   "Wrong number of neighbor distances");
+
+  auto idsPortal = neighborIds.ReadPortal();
+  auto distancesPortal = distances2.ReadPortal();
+  const vtkm::Id numPoints = static_cast<vtkm::Id>(points.size());
+  for (std::size_t q = 0; q < queries.size(); q++)
+  {
+    // Ties may be broken either way, so distances are compared rather than ids.
+    std::vector<vtkm::Float32> expected = BruteForceDistances2(points, queries[q]);
+    std::sort(expected.begin(), expected.end());
+    for (vtkm::Id i = 0; i < k; i++)
+    {
+      const vtkm::Id index = static_cast<vtkm::Id>(q) * k + i;
+      const vtkm::Id id = idsPortal.Get(index);
+      if (i >= numPoints)
+      {
+        VTKM_TEST_ASSERT(id == -1, "Missing neighbor not marked");
+        continue;
+      }
+      VTKM_TEST_ASSERT(id >= 0 && id < numPoints, "Invalid neighbor id");
+      const vtkm::Float32 distance2 = distancesPortal.Get(index);
+      VTKM_TEST_ASSERT(test_equal(distance2, expected[static_cast<std::size_t>(i)]),
+                       "Wrong neighbor distance");
+      VTKM_TEST_ASSERT(
+        test_equal(distance2,
+                   vtkm::MagnitudeSquared(points[static_cast<std::size_t>(id)] - queries[q])),
+        "Distance is not the one of the neighbor");
+      for (vtkm::Id j = 0; j < i; j++)
+      {
+        VTKM_TEST_ASSERT(idsPortal.Get(static_cast<vtkm::Id>(q) * k + j) != id,
+                         "Neighbor found twice");
+      }
+    }
+  }
+}
+
+void TestPointsWithinRadius(const PointsType& points, vtkm::Float32 radius)
+{
+  std::cout << "Testing points within " << radius << std::endl;
+  auto pointsHandle = vtkm::cont::make_ArrayHandle(points, vtkm::CopyFlag::Off);
+  const PointsType queries = MakeQueries(points);
+  auto queriesHandle = vtkm::cont::make_ArrayHandle(queries, vtkm::CopyFlag::Off);
+
+  vtkm::worklet::KdTree3D kdtree;
+  kdtree.Build(pointsHandle);
+  vtkm::cont::ArrayHandle<vtkm::Id> offsets;
+  vtkm::cont::ArrayHandle<vtkm::Id> neighborIds;
+  kdtree.RunPointsWithinRadius(pointsHandle, queriesHandle, radius, offsets, neighborIds);
+  VTKM_TEST_ASSERT(offsets.GetNumberOfValues() == static_cast<vtkm::Id>(queries.size()) + 1,
+                   "Wrong number of offsets");
+
+  auto offsetsPortal = offsets.ReadPortal();
+  auto idsPortal = neighborIds.ReadPortal();
+  for (std::size_t q = 0; q < queries.size(); q++)
+  {
+    std::vector<vtkm::Float32> distances2 = BruteForceDistances2(points, queries[q]);
+    std::vector<vtkm::Id> expected;
+    for (std::size_t i = 0; i < distances2.size(); i++)
+    {
+      if (distances2[i] <= radius * radius)
+      {
+        expected.push_back(static_cast<vtkm::Id>(i));
+      }
+    }
+
+    std::vector<vtkm::Id> found;
+    for (vtkm::Id i = offsetsPortal.Get(static_cast<vtkm::Id>(q));
+         i < offsetsPortal.Get(static_cast<vtkm::Id>(q) + 1);
+         i++)
+    {
+      found.push_back(idsPortal.Get(i));
+    }
+    std::sort(found.begin(), found.end());
+    VTKM_TEST_ASSERT(found == expected, "Wrong points within radius");
+    if (q >= 20)
+    {
+      VTKM_TEST_ASSERT(!found.empty(), "Query on a point does not find it");
+    }
+  }
+}
+
+void TestKdTree3DNeighborSearch()
+{
+  const PointsType points = MakePoints(200);
+  const vtkm::Id numPoints = static_cast<vtkm::Id>(points.size());
+  TestKNearestNeighbors(points, 1);
+  TestKNearestNeighbors(points, 5);
+  TestKNearestNeighbors(points, numPoints);
+  TestKNearestNeighbors(points, numPoints + 3);
+  TestKNearestNeighbors(MakePoints(2), 4);
+
+  TestPointsWithinRadius(points, 0.0f);
+  TestPointsWithinRadius(points, 1.5f);
+  TestPointsWithinRadius(points, 20.0f);
+}
+
+} // anonymous namespace
+
+VTKM_DEPRECATED_SUPPRESS_END
+
+int UnitTestKdTree3DNeighborSearch(int argc, char* argv[])
+{
+  return vtkm::cont::testing::Testing::Run(TestKdTree3DNeighborSearch, argc, argv);
+}
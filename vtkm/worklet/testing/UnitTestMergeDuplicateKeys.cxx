@@ -0,0 +1,67 @@
+//============================================================================
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//============================================================================
+#include <vtkm/worklet/MergeDuplicateKeys.h>
+
+#include <vtkm/cont/testing/Testing.h>
+
+#include <map>
+#include <vector>
+
+namespace
+{
+
+// Keys where every value appears several times, in a scrambled order. Keys that differ only
+// in their high bits are included to exercise the hash function.
+std::vector<vtkm::UInt64> MakeKeys(vtkm::Id numberOfKeys, vtkm::UInt64 numberOfDistinct)
+{
+  std::vector<vtkm::UInt64> keys;
+  for (vtkm::Id i = 0; i < numberOfKeys; ++i)
+  {
+    const vtkm::UInt64 value = (static_cast<vtkm::UInt64>(i) * 7919) % numberOfDistinct;
+    keys.push_back((value << 40) | (value & 0xff));
+  }
+  return keys;
+}
+
+void TestMergeDuplicateKeys()
+{
+  std::cout << "Testing MergeDuplicateKeys" << std::endl;
+  std::vector<vtkm::UInt64> keys = MakeKeys(5000, 777);
+  vtkm::cont::ArrayHandle<vtkm::Id> inputToUnique;
+  vtkm::cont::ArrayHandle<vtkm::Id> uniqueToInput;
+  vtkm::worklet::MergeDuplicateKeys(
+    vtkm::cont::make_ArrayHandle(keys, vtkm::CopyFlag::Off), inputToUnique, uniqueToInput);
+
+  // The expected result lists the distinct keys in order of first appearance.
+  std::map<vtkm::UInt64, vtkm::Id> firstIndex;
+  std::vector<vtkm::Id> expectedUniqueToInput;
+  std::vector<vtkm::Id> expectedInputToUnique;
+  for (std::size_t i = 0; i < keys.size(); ++i)
+  {
+    auto inserted = firstIndex.insert({ keys[i], static_cast<vtkm::Id>(firstIndex.size()) });
+    if (inserted.second)
+    {
+      expectedUniqueToInput.push_back(static_cast<vtkm::Id>(i));
+    }
+    expectedInputToUnique.push_back(inserted.first->second);
+  }
+
+  VTKM_TEST_ASSERT(test_equal_ArrayHandles(
+    uniqueToInput, vtkm::cont::make_ArrayHandle(expectedUniqueToInput, vtkm::CopyFlag::Off)));
+  VTKM_TEST_ASSERT(test_equal_ArrayHandles(
+    inputToUnique, vtkm::cont::make_ArrayHandle(expectedInputToUnique, vtkm::CopyFlag::Off)));
+}
+
+} // anonymous namespace
+
+int UnitTestMergeDuplicateKeys(int argc, char* argv[])
+{
+  return vtkm::cont::testing::Testing::Run(TestMergeDuplicateKeys, argc, argv);
+}